@@ -0,0 +1,82 @@
+// ArrayFactor.cpp - Batch power pattern of a steered uniform planar array
+#include "ArrayFactor.h"
+#include "Constants.h"
+#include "ParallelChunks.h"
+#include "SinCos4.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace {
+
+constexpr size_t kMinRowsPerChunk = 32;  // ~64 x 32 directions per worker
+
+} // namespace
+
+void ArrayFactor::configure(int columns, int rows, float columnSpacing, float rowSpacing,
+                            float steerAzimuth, float steerElevation) {
+    columns_ = std::max(columns, 1);
+    rows_ = std::max(rows, 1);
+    columnPhase_ = kTwoPiF * columnSpacing;
+    rowPhase_ = kTwoPiF * rowSpacing;
+    steerU_ = std::sin(steerAzimuth) * std::cos(steerElevation);
+    steerV_ = std::sin(steerElevation);
+}
+
+float ArrayFactor::linePower(int count, float phaseStep) {
+    // Element phases are measured from the line's centre so they stay small
+    const float centre = 0.5f * static_cast<float>(count - 1);
+    float phases[RS::kSinCosLanes];
+    float s[RS::kSinCosLanes];
+    float c[RS::kSinCosLanes];
+    float real = 0.0f;
+    float imag = 0.0f;
+    for (int first = 0; first < count; first += RS::kSinCosLanes) {
+        int lanes = std::min(RS::kSinCosLanes, count - first);
+        for (int lane = 0; lane < RS::kSinCosLanes; ++lane) {
+            phases[lane] = phaseStep * (static_cast<float>(first + lane) - centre);
+        }
+        RS::sinCos4(phases, s, c);
+        for (int lane = 0; lane < lanes; ++lane) {
+            real += c[lane];
+            imag += s[lane];
+        }
+    }
+    float n = static_cast<float>(count);
+    return (real * real + imag * imag) / (n * n);
+}
+
+float ArrayFactor::evaluate(float offAxis, float azimuth) const {
+    float sinOff = std::sin(offAxis);
+    float u = sinOff * std::cos(azimuth) - steerU_;
+    float v = sinOff * std::sin(azimuth) - steerV_;
+    return linePower(columns_, columnPhase_ * u) * linePower(rows_, rowPhase_ * v);
+}
+
+void ArrayFactor::bake(std::vector<float>& table, int azimuthBins, int offAxisBins, float halfAngle) const {
+    table.resize(static_cast<size_t>(azimuthBins) * offAxisBins);
+
+    // The azimuth terms repeat on every row
+    std::vector<float> cosAzimuth(azimuthBins);
+    std::vector<float> sinAzimuth(azimuthBins);
+    for (int col = 0; col < azimuthBins; ++col) {
+        float azimuth = kTwoPiF * (static_cast<float>(col) + 0.5f) / static_cast<float>(azimuthBins);
+        cosAzimuth[col] = std::cos(azimuth);
+        sinAzimuth[col] = std::sin(azimuth);
+    }
+
+    int chunks = RS::parallelChunkCount(static_cast<size_t>(offAxisBins), kMinRowsPerChunk);
+    RS::runChunks(chunks, static_cast<size_t>(offAxisBins), [&](int, size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            float offAxis = halfAngle * (static_cast<float>(row) + 0.5f) / static_cast<float>(offAxisBins);
+            float sinOff = std::sin(offAxis);
+            float* out = &table[row * azimuthBins];
+            for (int col = 0; col < azimuthBins; ++col) {
+                float u = sinOff * cosAzimuth[col] - steerU_;
+                float v = sinOff * sinAzimuth[col] - steerV_;
+                out[col] = linePower(columns_, columnPhase_ * u) * linePower(rows_, rowPhase_ * v);
+            }
+        }
+    });
+}
@@ -0,0 +1,37 @@
+// ArrayFactor.h - Batch power pattern of a steered uniform planar array
+#pragma once
+
+#include <vector>
+
+// Normalised |AF|^2 of a columns x rows grid of isotropic elements, spaced in
+// wavelengths and phased to steer the main lobe. Directions use the beam frame
+// of RadarBeam::getGain: offAxis from the array normal, azimuth around it from
+// the row axis. Uniform excitation makes the sum separable, AF = AFx(u) AFy(v)
+// in the direction cosines, so a direction costs columns + rows phasors rather
+// than columns x rows; each line sum runs four elements at a time with
+// RS::sinCos4. bake() spreads the table's rows over RS::runChunks workers.
+class ArrayFactor {
+public:
+    // spacing in wavelengths; steering angles in radians, azimuth toward the
+    // row axis and elevation toward the column axis
+    void configure(int columns, int rows, float columnSpacing, float rowSpacing,
+                   float steerAzimuth, float steerElevation);
+
+    // Power gain in [0, 1], 1 at the steered direction
+    float evaluate(float offAxis, float azimuth) const;
+
+    // offAxisBins rows of azimuthBins gains over [0, halfAngle], sampled at
+    // texel centres (RadarBeam::bakeGainPattern layout)
+    void bake(std::vector<float>& table, int azimuthBins, int offAxisBins, float halfAngle) const;
+
+private:
+    // |sum over count elements of exp(i * phaseStep * (n - centre))|^2 / count^2
+    static float linePower(int count, float phaseStep);
+
+    int columns_ = 1;
+    int rows_ = 1;
+    float columnPhase_ = 0.0f;  // 2 pi d_x, radians per unit direction cosine
+    float rowPhase_ = 0.0f;
+    float steerU_ = 0.0f;       // Steered direction cosines
+    float steerV_ = 0.0f;
+};
@@ -32,7 +32,8 @@ void BeamController::rebuildBeamGeometry() {
         emit beamTypeChanged(currentBeamType_);
     }
 
-    if (radarBeam_) {
+    // Only deferred uploads remain - setters and update() upload when they can
+    if (radarBeam_ && radarBeam_->isGeometryDirty()) {
         // This must run with a valid GL context (we're in paintGL)
         radarBeam_->uploadGeometryToGPU();
     }
@@ -21,7 +21,7 @@ public:
     // Initialization
     void initialize();
 
-    // Rendering
+    // Rendering - translucent, between TransparencyPass::begin() and end()
     void render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& model);
 
     // Beam management
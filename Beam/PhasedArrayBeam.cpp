@@ -27,10 +27,8 @@ PhasedArrayBeam::PhasedArrayBeam(float sphereRadius, float mainLobeWidthDegrees)
     visAlphaMin_ = kPhasedAlphaMin;
     visAlphaMax_ = kPhasedAlphaMax;
 
-    // Default pattern function (uniform)
-    patternFunction_ = [](float azimuth, float elevation) {
-        return 1.0f;  // Uniform gain
-        };
+    // No custom pattern: the gain is the array factor of the element grid
+    calculateBeamPattern();
 
     // Don't call initialize() here - it requires a valid OpenGL context
     // BeamController::createBeam() will call initialize() after construction
@@ -51,6 +49,7 @@ PhasedArrayBeam::~PhasedArrayBeam() {
 void PhasedArrayBeam::setMainLobeDirection(float azimuthOffset, float elevationOffset) {
     azimuthOffset_ = azimuthOffset;
     elevationOffset_ = elevationOffset;
+    calculateBeamPattern();
     createBeamGeometry();
     uploadGeometryToGPU();
 }
@@ -58,6 +57,7 @@ void PhasedArrayBeam::setMainLobeDirection(float azimuthOffset, float elevationO
 void PhasedArrayBeam::setElementCount(int horizontalElements, int verticalElements) {
     horizontalElements_ = horizontalElements;
     verticalElements_ = verticalElements;
+    calculateBeamPattern();
     createBeamGeometry();
     uploadGeometryToGPU();
 }
@@ -65,6 +65,7 @@ void PhasedArrayBeam::setElementCount(int horizontalElements, int verticalElemen
 void PhasedArrayBeam::setElementSpacing(float horizontalSpacing, float verticalSpacing) {
     horizontalSpacing_ = horizontalSpacing;
     verticalSpacing_ = verticalSpacing;
+    calculateBeamPattern();
     createBeamGeometry();
     uploadGeometryToGPU();
 }
@@ -83,34 +84,95 @@ void PhasedArrayBeam::setSideLobeIntensity(float intensity) {
 
 void PhasedArrayBeam::setCustomPattern(std::function<float(float, float)> patternFunc) {
     patternFunction_ = patternFunc;
+    ++patternVersion_;
     createBeamGeometry();
     uploadGeometryToGPU();
 }
 
-void PhasedArrayBeam::createBeamGeometry() {
-    // Clear previous data
-    vertices_.clear();
-    indices_.clear();
+float PhasedArrayBeam::getGain(float offAxis, float azimuth) const {
+    return patternFunction_ ? patternFunction_(azimuth, offAxis) : arrayFactor_.evaluate(offAxis, azimuth);
+}
+
+void PhasedArrayBeam::bakeGainPattern(std::vector<float>& table, int azimuthBins, int offAxisBins,
+                                      float halfAngle) const {
+    if (patternFunction_) {
+        RadarBeam::bakeGainPattern(table, azimuthBins, offAxisBins, halfAngle);
+        return;
+    }
+    arrayFactor_.bake(table, azimuthBins, offAxisBins, halfAngle);
+}
+
+void PhasedArrayBeam::setupShaders() {
+    // Procedural vertex shader over a fixed grid: aGrid.x is -1 for the apex,
+    // 0 on the rim where the cone meets the sphere and k/kBeamCapRings for the
+    // cap rings; aGrid.y is the azimuth fraction. The base fragment shader is kept.
+    beamVertexShaderSource_ = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aGrid;
+
+        uniform mat4 model;
+        uniform mat4 view;
+        uniform mat4 projection;
+
+        uniform vec3 beamApex;
+        uniform vec3 beamDir;           // Steered main lobe direction
+        uniform float beamLength;
+        uniform float horizontalRadius; // Elliptical base radii
+        uniform float verticalRadius;
+        uniform float sphereRadius;
+        uniform float normalBlend;
+
+        out vec3 FragPos;
+        out vec3 Normal;
+        out vec3 LocalPos;
+
+        void main() {
+            vec3 up = abs(beamDir.y) > 0.99 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);
+            vec3 right = normalize(cross(beamDir, up));
+            up = normalize(cross(right, beamDir));
+
+            vec3 pos = beamApex;
+            vec3 normal = beamDir;
+
+            if (aGrid.x >= 0.0) {
+                float angle = 6.28318531 * aGrid.y;
+                vec3 baseCenter = beamApex + beamDir * beamLength;
+                vec3 rim = normalize(baseCenter + right * (cos(angle) * horizontalRadius)
+                                                + up * (sin(angle) * verticalRadius)) * sphereRadius;
+
+                if (aGrid.x == 0.0) {
+                    pos = rim;
+                    normal = normalize(beamDir * normalBlend + normalize(rim - baseCenter) * (1.0 - normalBlend));
+                } else {
+                    // Spherical cap toward the antipode of the radar
+                    vec3 capCenter = -normalize(beamApex) * sphereRadius;
+                    pos = normalize(rim * (1.0 - aGrid.x) + capCenter * aGrid.x) * sphereRadius;
+                    normal = -normalize(pos);
+                }
+            }
+
+            LocalPos = pos;
+            FragPos = vec3(model * vec4(pos, 1.0));
+            Normal = mat3(transpose(inverse(model))) * normal;
+            gl_Position = projection * view * model * vec4(pos, 1.0);
+        }
+    )";
 
+    RadarBeam::setupShaders();
+}
+
+void PhasedArrayBeam::createBeamGeometry() {
     // Skip geometry creation if position hasn't been set yet
     if (currentRadarPosition_.isNull()) {
         return;
     }
 
-    // Number of segments around the base ellipse
-    const int segments = kBeamConeSegments;
-    const int capRings = kBeamCapRings;  // Number of rings for the spherical cap
-
     // Calculate beam direction
     QVector3D direction = calculateBeamDirection(currentRadarPosition_);
     QVector3D normDirection = direction.normalized();
 
     // Apply phased array offsets (convert from degrees to radians)
     if (azimuthOffset_ != 0.0f || elevationOffset_ != 0.0f) {
-        // Create rotation quaternions for azimuth and elevation offsets
-        float azRadians = azimuthOffset_ * kDegToRadF;
-        float elRadians = elevationOffset_ * kDegToRadF;
-
         // Get perpendicular vectors
         QVector3D up(0.0f, 1.0f, 0.0f);
         if (qAbs(QVector3D::dotProduct(normDirection, up)) > kGimbalLockThreshold) {
@@ -131,69 +193,40 @@ void PhasedArrayBeam::createBeamGeometry() {
         normDirection = totalRotation.rotatedVector(normDirection);
     }
 
-    // Calculate beam end point
+    // Steered direction and length are all the vertex shader needs
     QVector3D endPoint = calculateOppositePoint(currentRadarPosition_, normDirection);
+    coneDirection_ = normDirection;
+    coneLength_ = (endPoint - currentRadarPosition_).length();
 
-    // Calculate beam length
-    float beamLength = (endPoint - currentRadarPosition_).length();
-
-    // Calculate horizontal and vertical radii for the elliptical base
-    // We're using beam width for horizontal and a narrower width for vertical
-    float horizontalRadius = tan(beamWidthDegrees_ * kDegToRadF / 2.0f) * beamLength;
-    float verticalRadius = tan(beamWidthDegrees_ * 0.5f * kDegToRadF / 2.0f) * beamLength; // Half the width
-
-    // Find perpendicular vectors to create the base ellipse
-    QVector3D up(0.0f, 1.0f, 0.0f);
-    if (qAbs(QVector3D::dotProduct(normDirection, up)) > kGimbalLockThreshold) {
-        // If direction is nearly parallel to up, use a different vector
-        up = QVector3D(1.0f, 0.0f, 0.0f);
+    if (vertices_.empty()) {
+        buildConeGrid();
     }
 
-    QVector3D right = QVector3D::crossProduct(normDirection, up).normalized();
-    up = QVector3D::crossProduct(right, normDirection).normalized();
+    // Then create side lobes if enabled
+    if (showSideLobes_) {
+        createSideLobes();
+    }
+}
 
-    // Base center (conceptual center of cone base before projection)
-    QVector3D baseCenter = currentRadarPosition_ + normDirection * beamLength;
+void PhasedArrayBeam::buildConeGrid() {
+    vertices_.clear();
+    indices_.clear();
 
-    // Cap center is where the beam axis exits the sphere on the opposite side
-    // This should be the antipodal point from the radar position
-    QVector3D capCenter = -currentRadarPosition_.normalized() * sphereRadius_;
+    // Number of segments around the base ellipse
+    const int segments = kBeamConeSegments;
+    const int capRings = kBeamCapRings;  // Number of rings for the spherical cap
 
-    // Add apex vertex (with normal pointing to beam direction)
-    vertices_.push_back(currentRadarPosition_.x());
-    vertices_.push_back(currentRadarPosition_.y());
-    vertices_.push_back(currentRadarPosition_.z());
-    vertices_.push_back(normDirection.x());
-    vertices_.push_back(normDirection.y());
-    vertices_.push_back(normDirection.z());
+    // Apex
+    vertices_.push_back(-1.0f);
+    vertices_.push_back(0.0f);
 
-    // Store the outer rim vertices on the sphere (where cone meets sphere)
-    std::vector<QVector3D> outerRimPoints;
-    for (int i = 0; i < segments; i++) {
-        float angle = kTwoPiF * i / segments;
-        float cA = cos(angle);
-        float sA = sin(angle);
-
-        // Elliptical calculation
-        QVector3D circlePoint = baseCenter + right * (cA * horizontalRadius) + up * (sA * verticalRadius);
-
-        // Project point onto sphere surface
-        circlePoint = circlePoint.normalized() * sphereRadius_;
-        outerRimPoints.push_back(circlePoint);
-
-        // Calculate normal for cone surface
-        QVector3D toCircle = circlePoint - baseCenter;
-        QVector3D normal = (normDirection * kNormalBlendFactor + toCircle.normalized() * (1.0f - kNormalBlendFactor)).normalized();
-
-        // Position
-        vertices_.push_back(circlePoint.x());
-        vertices_.push_back(circlePoint.y());
-        vertices_.push_back(circlePoint.z());
-
-        // Normal
-        vertices_.push_back(normal.x());
-        vertices_.push_back(normal.y());
-        vertices_.push_back(normal.z());
+    // Outer rim (rings parameter 0) followed by the cap rings
+    for (int ring = 0; ring <= capRings; ring++) {
+        float t = (float)ring / (float)capRings;
+        for (int i = 0; i < segments; i++) {
+            vertices_.push_back(t);
+            vertices_.push_back((float)i / (float)segments);
+        }
     }
 
     // Create cone side triangles (apex to each pair of adjacent rim vertices)
@@ -204,48 +237,10 @@ void PhasedArrayBeam::createBeamGeometry() {
         indices_.push_back(next + 1);  // Next rim vertex
     }
 
-    // Add the spherical cap to fill in the "dish"
-    int capStartVertex = segments + 1;
-
-    // Add vertices for inner rings of the cap
-    for (int ring = 1; ring <= capRings; ring++) {
-        float t = (float)ring / (float)capRings;
-
-        for (int i = 0; i < segments; i++) {
-            QVector3D outerPoint = outerRimPoints[i];
-            QVector3D interpolated = (outerPoint * (1.0f - t) + capCenter * t).normalized() * sphereRadius_;
-            QVector3D normal = -interpolated.normalized();
-
-            vertices_.push_back(interpolated.x());
-            vertices_.push_back(interpolated.y());
-            vertices_.push_back(interpolated.z());
-            vertices_.push_back(normal.x());
-            vertices_.push_back(normal.y());
-            vertices_.push_back(normal.z());
-        }
-    }
-
-    // Create triangles for the cap - first ring
-    for (int i = 0; i < segments; i++) {
-        int next = (i + 1) % segments;
-        int outerCurr = i + 1;
-        int outerNext = next + 1;
-        int innerCurr = capStartVertex + i;
-        int innerNext = capStartVertex + next;
-
-        indices_.push_back(outerCurr);
-        indices_.push_back(innerCurr);
-        indices_.push_back(outerNext);
-
-        indices_.push_back(outerNext);
-        indices_.push_back(innerCurr);
-        indices_.push_back(innerNext);
-    }
-
-    // Remaining rings
-    for (int ring = 1; ring < capRings; ring++) {
-        int outerRingStart = capStartVertex + (ring - 1) * segments;
-        int innerRingStart = capStartVertex + ring * segments;
+    // Cap: connect each ring (starting at the rim) to the next one inward
+    for (int ring = 0; ring < capRings; ring++) {
+        int outerRingStart = 1 + ring * segments;
+        int innerRingStart = 1 + (ring + 1) * segments;
 
         for (int i = 0; i < segments; i++) {
             int next = (i + 1) % segments;
@@ -263,11 +258,23 @@ void PhasedArrayBeam::createBeamGeometry() {
             indices_.push_back(innerNext);
         }
     }
+}
 
-    // Then create side lobes if enabled
-    if (showSideLobes_) {
-        createSideLobes();
-    }
+void PhasedArrayBeam::uploadGeometryToGPU() {
+    uploadParametricGrid();
+}
+
+void PhasedArrayBeam::setGeometryUniforms() {
+    // Horizontal radius from the beam width, vertical from half the width
+    float horizontalRadius = tan(beamWidthDegrees_ * kDegToRadF / 2.0f) * coneLength_;
+    float verticalRadius = tan(beamWidthDegrees_ * 0.5f * kDegToRadF / 2.0f) * coneLength_;
+
+    beamShaderProgram_->setUniformValue("beamApex", currentRadarPosition_);
+    beamShaderProgram_->setUniformValue("beamDir", coneDirection_);
+    beamShaderProgram_->setUniformValue("beamLength", coneLength_);
+    beamShaderProgram_->setUniformValue("horizontalRadius", horizontalRadius);
+    beamShaderProgram_->setUniformValue("verticalRadius", verticalRadius);
+    beamShaderProgram_->setUniformValue("normalBlend", kNormalBlendFactor);
 }
 
 
@@ -282,8 +289,12 @@ void PhasedArrayBeam::createSideLobes() {
 }
 
 void PhasedArrayBeam::calculateBeamPattern() {
-    // Calculate a realistic beam pattern based on array parameters
-    // This would use array theory to generate directional gain pattern
-
-    // Placeholder for future implementation
+    // Elements along the beam frame's row (azimuth 0) and column axes; the
+    // owner rebakes the gain texture when the version moves, so steering
+    // animates the traced pattern as well as the cone
+    arrayFactor_.configure(horizontalElements_, verticalElements_, horizontalSpacing_, verticalSpacing_,
+                           azimuthOffset_ * kDegToRadF, elevationOffset_ * kDegToRadF);
+    if (!patternFunction_) {
+        ++patternVersion_;
+    }
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "RadarBeam.h"
+#include "ArrayFactor.h"
 #include <functional>
 
 // Derived class for phased array beam with full beam forming capabilities
@@ -18,9 +19,17 @@ public:
     void setSideLobeVisibility(bool visible);
     void setSideLobeIntensity(float intensity);  // 0.0 to 1.0
 
-    // Custom beam pattern using function
+    // Custom beam pattern using function: one-way power gain at azimuth around
+    // the beam axis and elevation off it, both in radians (see getGain).
+    // Replaces the array factor; an empty function restores it.
     void setCustomPattern(std::function<float(float azimuth, float elevation)> patternFunc);
 
+    // Array factor of the element grid, steered by the main lobe offsets,
+    // unless a custom pattern is set
+    float getGain(float offAxis, float azimuth) const override;
+    void bakeGainPattern(std::vector<float>& table, int azimuthBins, int offAxisBins,
+                         float halfAngle) const override;
+
 protected:
     // Phased array specific properties
     float azimuthOffset_;
@@ -31,7 +40,8 @@ protected:
     float verticalSpacing_;
     bool showSideLobes_;
     float sideLobeIntensity_;
-    std::function<float(float, float)> patternFunction_;
+    std::function<float(float, float)> patternFunction_;  // Empty for the array factor
+    ArrayFactor arrayFactor_;
 
     // Additional geometry for side lobes
     std::vector<float> sideLobeVertices_;
@@ -41,6 +51,10 @@ protected:
     QOpenGLBuffer sideLobeEBO_;
 
     virtual void createBeamGeometry() override;
+    void setupShaders() override;
+    void uploadGeometryToGPU() override;  // Static grid - uploaded once
+    void setGeometryUniforms() override;
+    void buildConeGrid();
     void createSideLobes();
     void calculateBeamPattern();
 };
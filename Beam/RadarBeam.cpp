@@ -7,6 +7,8 @@
 #include "SincBeam.h"
 #include "SingleRayBeam.h"
 #include "Constants.h"
+#include "TransparencyPass.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace RS::Constants;
@@ -85,8 +87,6 @@ RadarBeam::RadarBeam(float sphereRadius, float beamWidthDegrees)
 		uniform float alphaMin;
 		uniform float alphaMax;
 
-		out vec4 FragColor;
-
 		// Convert LOCAL position to shadow map UV coordinates
 		// Uses untransformed positions to match ray tracing coordinate system
 		vec2 worldToShadowMapUV(vec3 localPos) {
@@ -182,7 +182,7 @@ RadarBeam::RadarBeam(float sphereRadius, float beamWidthDegrees)
 			// Clamp alpha using constants
 			finalColor.a = clamp(finalColor.a, alphaMin, alphaMax);
 
-			FragColor = finalColor;
+			writeTransparent(finalColor);
 		}
 	)";
 }
@@ -209,6 +209,7 @@ void RadarBeam::cleanup() {
 		glDeleteBuffers(1, &eboId_);
 		eboId_ = 0;
 	}
+	gridUploaded_ = false;
 	beamShaderProgram_.reset();
 }
 
@@ -273,6 +274,51 @@ void RadarBeam::uploadGeometryToGPU() {
 	geometryDirty_ = false;
 }
 
+void RadarBeam::uploadParametricGrid() {
+	if (!QOpenGLContext::currentContext() || !beamVAO_.isCreated()) {
+		geometryDirty_ = true;
+		return;
+	}
+
+	if (vertices_.empty() || indices_.empty()) {
+		return;
+	}
+
+	// The grid never changes once built - placement is entirely in uniforms
+	if (gridUploaded_) {
+		geometryDirty_ = false;
+		return;
+	}
+
+	beamVAO_.bind();
+
+	if (vboId_ == 0) {
+		glGenBuffers(1, &vboId_);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, vboId_);
+	glBufferData(GL_ARRAY_BUFFER,
+		vertices_.size() * sizeof(float),
+		vertices_.data(),
+		GL_STATIC_DRAW);
+
+	// Grid coordinate attribute (location 0): x = radial parameter, y = azimuth fraction
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	if (eboId_ == 0) {
+		glGenBuffers(1, &eboId_);
+	}
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+		indices_.size() * sizeof(unsigned int),
+		indices_.data(),
+		GL_STATIC_DRAW);
+
+	beamVAO_.release();
+	gridUploaded_ = true;
+	geometryDirty_ = false;
+}
+
 void RadarBeam::initialize() {
 	// Make sure we don't initialize twice
 	if (beamVAO_.isCreated()) {
@@ -315,12 +361,14 @@ void RadarBeam::setupShaders() {
 	beamShaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
 	// Debug shader compilation
-	if (!beamShaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, beamVertexShaderSource_.data())) {
+	if (!beamShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, beamVertexShaderSource_.data())) {
 		qCritical() << "Failed to compile vertex shader:" << beamShaderProgram_->log();
 		return;
 	}
 
-	if (!beamShaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, beamFragmentShaderSource_.data())) {
+	// Every beam type is translucent, drawn inside the TransparencyPass
+	const std::string fragmentSource = TransparencyPass::fragmentShader(beamFragmentShaderSource_);
+	if (!beamShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentSource.c_str())) {
 		qCritical() << "Failed to compile fragment shader:" << beamShaderProgram_->log();
 		return;
 	}
@@ -365,23 +413,8 @@ void RadarBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projecti
 		return;
 	}
 
-	// Save current OpenGL state
-	GLboolean depthMaskPrevious;
-	glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMaskPrevious);
-	GLint blendSrcPrevious, blendDstPrevious;
-	glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcPrevious);
-	glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstPrevious);
-	GLboolean blendPrevious = glIsEnabled(GL_BLEND);
-
-	// Enable transparency with improved blending
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Enable depth testing so beam is occluded by solid objects (targets)
-	// but disable depth writing for transparent objects
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
-	glDepthMask(GL_FALSE);
+	// Blending, the depth test against solid objects (targets) and disabled
+	// depth writes all come from the enclosing TransparencyPass
 
 	// Face culling for Conical/PhasedArray (SincBeam overrides this)
 	glEnable(GL_CULL_FACE);
@@ -427,6 +460,8 @@ void RadarBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projecti
 	beamShaderProgram_->setUniformValue("alphaMin", visAlphaMin_);
 	beamShaderProgram_->setUniformValue("alphaMax", visAlphaMax_);
 
+	setGeometryUniforms();
+
 	// Bind shadow map texture if enabled
 	if (gpuShadowEnabled_ && gpuShadowMapTexture_ != 0) {
 		glActiveTexture(GL_TEXTURE0);
@@ -452,14 +487,7 @@ void RadarBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projecti
 	// Release shader program
 	beamShaderProgram_->release();
 
-	// Restore previous OpenGL state
-	glDepthMask(depthMaskPrevious);
 	glDisable(GL_CULL_FACE);
-	glDisable(GL_STENCIL_TEST);
-	if (!blendPrevious) {
-		glDisable(GL_BLEND);
-	}
-	glBlendFunc(blendSrcPrevious, blendDstPrevious);
 }
 
 void RadarBeam::setBeamWidth(float degrees) {
@@ -761,6 +789,18 @@ void RadarBeam::calculateBeamVertices(const QVector3D& apex, const QVector3D& di
 	}
 }
 
+void RadarBeam::bakeGainPattern(std::vector<float>& table, int azimuthBins, int offAxisBins, float halfAngle) const {
+	// The pattern function runs once per texel here, never per ray
+	table.resize(static_cast<size_t>(azimuthBins) * offAxisBins);
+	for (int row = 0; row < offAxisBins; ++row) {
+		float offAxis = halfAngle * (static_cast<float>(row) + 0.5f) / static_cast<float>(offAxisBins);
+		for (int col = 0; col < azimuthBins; ++col) {
+			float azimuth = 2.0f * kPiF * (static_cast<float>(col) + 0.5f) / static_cast<float>(azimuthBins);
+			table[static_cast<size_t>(row) * azimuthBins + col] = std::max(getGain(offAxis, azimuth), 0.0f);
+		}
+	}
+}
+
 std::vector<QVector3D> RadarBeam::getDiagnosticRayDirections() const {
 	std::vector<QVector3D> directions;
 
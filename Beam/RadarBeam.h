@@ -8,6 +8,7 @@
 #include <QOpenGLVertexArrayObject>
 #include <QVector3D>
 #include <QMatrix4x4>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string_view>
@@ -45,6 +46,7 @@ public:
     // Core methods
     virtual void initialize();
     virtual void update(const QVector3D& radarPosition);
+    // Translucent: draws between TransparencyPass::begin() and end()
     virtual void render(QOpenGLShaderProgram* program, const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& model);
 
     // Property setters
@@ -81,11 +83,23 @@ public:
     bool isShowShadow() const { return showShadow_; }
     float getBeamLength() const { return beamLengthFactor_; }
     const std::vector<float>& getVertices() const { return vertices_; }
+    bool isGeometryDirty() const { return geometryDirty_; }  // GPU copy is stale (upload deferred)
 
     // Bounce visualization control
     void setShowBounceVisualization(bool show) { showBounceVisualization_ = show; }
     bool showBounceVisualization() const { return showBounceVisualization_; }
 
+    // One-way power gain relative to boresight, offAxis radians from the beam
+    // axis and azimuth radians around it (the ray generation frame). Uniform
+    // by default; the RCS rays are weighted by it through bakeGainPattern().
+    virtual float getGain(float offAxis, float azimuth) const { (void)offAxis; (void)azimuth; return 1.0f; }
+    uint64_t getPatternVersion() const { return patternVersion_; }  // Changes when getGain() does
+
+    // offAxisBins rows of azimuthBins gains over [0, halfAngle] off axis,
+    // sampled at texel centres (RCSCompute::setBeamPattern layout). Calls
+    // getGain() per texel; subclasses with a batch evaluator override it.
+    virtual void bakeGainPattern(std::vector<float>& table, int azimuthBins, int offAxisBins, float halfAngle) const;
+
     // Returns ray directions for diagnostic bounce tracing
     // Default: returns center ray direction (for cone beams)
     // SingleRay: returns single ray direction
@@ -127,10 +141,19 @@ protected:
     std::vector<unsigned int> indices_;
     bool geometryDirty_ = false;  // Flag to defer GPU upload until valid context
 
+    // Procedural beams (Sinc, Phased) keep a fixed parametric grid in vertices_
+    // that is uploaded once; their vertex shader places it on the sphere from
+    // these values, so moving the radar only changes uniforms.
+    QVector3D coneDirection_;
+    float coneLength_ = 0.0f;
+    bool gridUploaded_ = false;
+
     // Shader sources (string_view for type-safe literals)
     std::string_view beamVertexShaderSource_;
     std::string_view beamFragmentShaderSource_;
 
+    uint64_t patternVersion_ = 0;  // Bumped by subclasses whose gain pattern changes shape
+
     // Visibility constants (set by derived classes, used by shader)
     float visFresnelBase_ = 0.1f;
     float visFresnelRange_ = 0.2f;
@@ -143,6 +166,8 @@ protected:
     // Helper methods
     virtual void createBeamGeometry();
     virtual void setupShaders();
+    virtual void setGeometryUniforms() {}  // Procedural placement uniforms on beamShaderProgram_
+    void uploadParametricGrid();  // vertices_ as 2 floats per vertex (grid coordinates), once
     QVector3D calculateBeamDirection(const QVector3D& radarPosition);
     QVector3D calculateOppositePoint(const QVector3D& radarPosition, const QVector3D& direction);
     void calculateBeamVertices(const QVector3D& apex, const QVector3D& direction, float length, float baseRadius);
@@ -76,7 +76,12 @@ float SincBeam::getAiryIntensity(float theta, float thetaMax) {
     return airy * airy;
 }
 
-// Legacy sinc² calculation (kept for RCS ray weighting compatibility)
+float SincBeam::getGain(float offAxis, float azimuth) const {
+    (void)azimuth;  // Circular aperture
+    return getAiryIntensity(offAxis, beamWidthDegrees_ * kDegToRadF * 0.5f);
+}
+
+// Legacy sinc² calculation (the RCS ray weights use the Airy pattern of getGain)
 float SincBeam::getSincSquaredIntensity(float theta, float thetaMax) {
     if (thetaMax <= 0.0f) return 1.0f;
 
@@ -95,27 +100,100 @@ float SincBeam::getSincSquaredIntensity(float theta, float thetaMax) {
 
 void SincBeam::setupShaders() {
     // Custom shaders with per-vertex intensity attribute
+    // Procedural vertex shader: the mesh is a fixed (radial, azimuth) grid and
+    // everything that depends on the radar position - placement on the sphere,
+    // normals and the Airy intensity - is evaluated here from uniforms
     beamVertexShaderSource_ = R"(
         #version 330 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aNormal;
-        layout (location = 2) in float aIntensity;
+        layout (location = 0) in vec2 aGrid;  // x: radial fraction (0 = apex), y: azimuth fraction
 
         uniform mat4 model;
         uniform mat4 view;
         uniform mat4 projection;
 
+        uniform vec3 beamApex;
+        uniform vec3 beamDir;
+        uniform float beamLength;
+        uniform float halfAngle;          // Main lobe half-angle (first null)
+        uniform float extentMultiplier;   // Geometry extent in main lobe radii
+        uniform float sphereRadius;
+
         out vec3 FragPos;
         out vec3 Normal;
         out vec3 LocalPos;
         out float Intensity;
 
+        // Bessel J1 - same Numerical Recipes approximation as SincBeam::besselJ1
+        float besselJ1(float x) {
+            float ax = abs(x);
+            if (ax < 0.001) {
+                return x * 0.5;
+            }
+            if (ax < 8.0) {
+                float y = x * x;
+                float ans1 = x * (72362614232.0 + y * (-7895059235.0 + y * (242396853.1
+                    + y * (-2972611.439 + y * (15704.48260 + y * (-30.16036606))))));
+                float ans2 = 144725228442.0 + y * (2300535178.0 + y * (18583304.74
+                    + y * (99447.43394 + y * (376.9991397 + y))));
+                return ans1 / ans2;
+            }
+            float z = 8.0 / ax;
+            float y = z * z;
+            float xx = ax - 2.356194491;
+            float ans1 = 1.0 + y * (0.183105e-2 + y * (-0.3516396496e-4 + y * (0.2457520174e-5
+                + y * (-0.240337019e-6))));
+            float ans2 = 0.04687499995 + y * (-0.2002690873e-3 + y * (0.8449199096e-5
+                + y * (-0.88228987e-6 + y * 0.105787412e-6)));
+            float ans = sqrt(0.636619772 / ax) * (cos(xx) * ans1 - z * sin(xx) * ans2);
+            return (x < 0.0) ? -ans : ans;
+        }
+
+        // [2 J1(x) / x]^2 with the first null at theta = halfAngle
+        float airyIntensity(float theta) {
+            float x = 3.8317 * theta / halfAngle;
+            if (abs(x) < 0.0001) {
+                return 1.0;
+            }
+            float airy = 2.0 * besselJ1(x) / x;
+            return airy * airy;
+        }
+
         void main() {
-            LocalPos = aPos;
-            FragPos = vec3(model * vec4(aPos, 1.0));
-            Normal = mat3(transpose(inverse(model))) * aNormal;
-            Intensity = aIntensity;
-            gl_Position = projection * view * model * vec4(aPos, 1.0);
+            vec3 up = abs(beamDir.y) > 0.99 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);
+            vec3 right = normalize(cross(beamDir, up));
+            up = normalize(cross(right, beamDir));
+
+            float t = aGrid.x;
+            vec3 pos = beamApex;
+            vec3 normal = beamDir;
+            float intensity = 1.0;
+
+            if (t > 0.0) {
+                float ringRadius = tan(halfAngle) * beamLength * extentMultiplier * t;
+                float theta = atan(ringRadius / beamLength);
+
+                // Edge fade over the outer 25% of the geometry
+                float edgeFade = 1.0;
+                if (t > 0.75) {
+                    edgeFade = 1.0 - (t - 0.75) / 0.25;
+                    edgeFade = edgeFade * edgeFade;
+                }
+                intensity = airyIntensity(theta) * edgeFade;
+
+                float azimuth = 6.28318531 * aGrid.y;
+                vec3 offset = right * (ringRadius * cos(azimuth)) + up * (ringRadius * sin(azimuth));
+                vec3 basePoint = beamApex + beamDir * beamLength + offset;
+
+                pos = normalize(basePoint) * sphereRadius;
+                vec3 toBase = normalize(basePoint - beamApex);
+                normal = normalize(beamDir * 0.2 + toBase * 0.8);
+            }
+
+            LocalPos = pos;
+            FragPos = vec3(model * vec4(pos, 1.0));
+            Normal = mat3(transpose(inverse(model))) * normal;
+            Intensity = intensity;
+            gl_Position = projection * view * model * vec4(pos, 1.0);
         }
     )";
 
@@ -155,8 +233,6 @@ void SincBeam::setupShaders() {
         uniform float alphaMin;
         uniform float alphaMax;
 
-        out vec4 FragColor;
-
         // Convert LOCAL position to shadow map UV coordinates
         vec2 worldToShadowMapUV(vec3 localPos) {
             vec3 toFrag = normalize(localPos - radarPos);
@@ -261,7 +337,7 @@ void SincBeam::setupShaders() {
             float finalAlpha = opacity * opacityMult * (fresnel + rim * rimStrength) * intensityAlpha;
             finalAlpha = clamp(finalAlpha + intersectionGlow * 0.4, alphaMin, alphaMax);
 
-            FragColor = vec4(intensityColor, finalAlpha);
+            writeTransparent(vec4(intensityColor, finalAlpha));
         }
     )";
 
@@ -274,96 +350,36 @@ void SincBeam::createBeamGeometry() {
         return;
     }
 
-    // Calculate beam direction and end point
-    QVector3D direction = calculateBeamDirection(currentRadarPosition_);
-    QVector3D endPoint = calculateOppositePoint(currentRadarPosition_, direction);
-
-    // Beam length from radar to sphere surface
-    float beamLength = (endPoint - currentRadarPosition_).length();
+    // Only the placement changes with the radar - the shader does the rest
+    coneDirection_ = calculateBeamDirection(currentRadarPosition_).normalized();
+    QVector3D endPoint = calculateOppositePoint(currentRadarPosition_, coneDirection_);
+    coneLength_ = (endPoint - currentRadarPosition_).length();
 
-    // Main lobe radius (at the base, for main lobe only)
-    float halfAngleRad = beamWidthDegrees_ * kDegToRadF / 2.0f;
-    float mainLobeRadius = tan(halfAngleRad) * beamLength;
-
-    generateSincBeamVertices(currentRadarPosition_, direction, beamLength, mainLobeRadius);
+    if (vertices_.empty()) {
+        buildSincGrid();
+    }
 }
 
-void SincBeam::generateSincBeamVertices(const QVector3D& apex,
-                                         const QVector3D& direction,
-                                         float length,
-                                         float mainLobeRadius) {
+void SincBeam::buildSincGrid() {
     vertices_.clear();
     indices_.clear();
 
     const int azimuthSegments = kBeamConeSegments;  // 32 segments around
     const int radialSegments = kSincBeamRadialSegments;  // 64 rings from center to edge
 
-    // Extend geometry to cover side lobes (2.5× main lobe)
-    float extendedRadius = mainLobeRadius * kSincSideLobeMultiplier;
-    float halfAngleRad = beamWidthDegrees_ * kDegToRadF / 2.0f;
+    // Vertex 0: apex
+    vertices_.push_back(0.0f);
+    vertices_.push_back(0.0f);
 
-    // Build coordinate frame
-    QVector3D normDir = direction.normalized();
-    QVector3D up(0.0f, 1.0f, 0.0f);
-    if (qAbs(QVector3D::dotProduct(normDir, up)) > kGimbalLockThreshold) {
-        up = QVector3D(1.0f, 0.0f, 0.0f);
-    }
-    QVector3D right = QVector3D::crossProduct(normDir, up).normalized();
-    up = QVector3D::crossProduct(right, normDir).normalized();
-
-    // Helper to add a vertex with 7 floats: [x, y, z, nx, ny, nz, intensity]
-    auto addVertex = [this](const QVector3D& pos, const QVector3D& normal, float intensity) {
-        vertices_.push_back(pos.x());
-        vertices_.push_back(pos.y());
-        vertices_.push_back(pos.z());
-        vertices_.push_back(normal.x());
-        vertices_.push_back(normal.y());
-        vertices_.push_back(normal.z());
-        vertices_.push_back(intensity);
-    };
-
-    // Vertex 0: Apex (radar position) with intensity = 1.0
-    addVertex(apex, normDir, 1.0f);
-
-    // Generate concentric rings from center to extended edge
+    // Concentric rings from center to the extended edge: (t, azimuth fraction)
     for (int ring = 1; ring <= radialSegments; ++ring) {
-        float t = float(ring) / float(radialSegments);  // 0 to 1 from center to edge
-        float ringRadius = extendedRadius * t;
-
-        // Calculate angle from beam axis at this radius
-        float theta = atan(ringRadius / length);
-        float airyIntensity = getAiryIntensity(theta, halfAngleRad);
-
-        // Edge fade: smooth falloff in outer 25% of geometry (3x to 4x main lobe)
-        // This prevents the hard cutoff at the geometry boundary
-        float edgeFade = 1.0f;
-        if (t > 0.75f) {
-            edgeFade = 1.0f - (t - 0.75f) / 0.25f;  // Linear fade from 1 to 0
-            edgeFade = edgeFade * edgeFade;  // Quadratic for smoother fade
-        }
-
-        float intensity = airyIntensity * edgeFade;
-
+        float t = float(ring) / float(radialSegments);
         for (int seg = 0; seg < azimuthSegments; ++seg) {
-            float azimuth = kTwoPiF * float(seg) / float(azimuthSegments);
-
-            // Point on conceptual base plane
-            QVector3D offset = right * (ringRadius * cos(azimuth))
-                             + up * (ringRadius * sin(azimuth));
-            QVector3D basePoint = apex + normDir * length + offset;
-
-            // Project onto sphere surface
-            QVector3D surfacePoint = basePoint.normalized() * sphereRadius_;
-
-            // Calculate normal (blend between direction and radial)
-            QVector3D toBase = (basePoint - apex).normalized();
-            QVector3D normal = (normDir * 0.2f + toBase * 0.8f).normalized();
-
-            addVertex(surfacePoint, normal, intensity);
+            vertices_.push_back(t);
+            vertices_.push_back(float(seg) / float(azimuthSegments));
         }
     }
 
-    // Generate indices
     // Connect apex (vertex 0) to first ring
     for (int seg = 0; seg < azimuthSegments; ++seg) {
         int next = (seg + 1) % azimuthSegments;
@@ -393,57 +409,15 @@ void SincBeam::generateSincBeamVertices(const QVector3D& apex,
 }
 
 void SincBeam::uploadGeometryToGPU() {
-    if (vertices_.empty() || indices_.empty()) {
-        return;
-    }
-
-    // Check if we have a valid GL context
-    if (!QOpenGLContext::currentContext()) {
-        geometryDirty_ = true;
-        return;
-    }
-
-    // Ensure VAO exists and bind it
-    if (!beamVAO_.isCreated()) {
-        beamVAO_.create();
-    }
-    beamVAO_.bind();
-
-    // Create VBO if needed
-    if (vboId_ == 0) {
-        glGenBuffers(1, &vboId_);
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-    glBufferData(GL_ARRAY_BUFFER,
-        vertices_.size() * sizeof(float),
-        vertices_.data(),
-        GL_DYNAMIC_DRAW);
-
-    // Setup vertex attributes with 7-float stride (pos + normal + intensity)
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Normal attribute (location 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Intensity attribute (location 2) - NEW for SincBeam
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // Create EBO if needed
-    if (eboId_ == 0) {
-        glGenBuffers(1, &eboId_);
-    }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-        indices_.size() * sizeof(unsigned int),
-        indices_.data(),
-        GL_DYNAMIC_DRAW);
+    uploadParametricGrid();
+}
 
-    beamVAO_.release();
-    geometryDirty_ = false;
+void SincBeam::setGeometryUniforms() {
+    beamShaderProgram_->setUniformValue("beamApex", currentRadarPosition_);
+    beamShaderProgram_->setUniformValue("beamDir", coneDirection_);
+    beamShaderProgram_->setUniformValue("beamLength", coneLength_);
+    beamShaderProgram_->setUniformValue("halfAngle", beamWidthDegrees_ * kDegToRadF / 2.0f);
+    beamShaderProgram_->setUniformValue("extentMultiplier", kSincSideLobeMultiplier);
 }
 
 void SincBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projection,
@@ -473,23 +447,9 @@ void SincBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projectio
         return;
     }
 
-    // Save current OpenGL state
-    GLboolean depthMaskPrevious;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMaskPrevious);
-    GLint blendSrcPrevious, blendDstPrevious;
-    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcPrevious);
-    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstPrevious);
-    GLboolean blendPrevious = glIsEnabled(GL_BLEND);
-
-    // Enable transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
+    // Blending and depth writes belong to the enclosing TransparencyPass.
     // SincBeam: disable face culling because extended geometry (2.5x for side lobes)
     // wraps around sphere, causing triangle winding to flip on front hemisphere
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glDepthMask(GL_FALSE);
     glDisable(GL_CULL_FACE);
 
     glDisable(GL_STENCIL_TEST);
@@ -546,6 +506,8 @@ void SincBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projectio
     beamShaderProgram_->setUniformValue("alphaMin", kSincAlphaMin);
     beamShaderProgram_->setUniformValue("alphaMax", kSincAlphaMax);
 
+    setGeometryUniforms();
+
     // Bind VAO and draw
     beamVAO_.bind();
     glBindBuffer(GL_ARRAY_BUFFER, vboId_);
@@ -558,12 +520,4 @@ void SincBeam::render(QOpenGLShaderProgram* program, const QMatrix4x4& projectio
         beamVAO_.release();
     }
     beamShaderProgram_->release();
-
-    // Restore previous OpenGL state
-    glDepthMask(depthMaskPrevious);
-    glDisable(GL_STENCIL_TEST);
-    if (!blendPrevious) {
-        glDisable(GL_BLEND);
-    }
-    glBlendFunc(blendSrcPrevious, blendDstPrevious);
 }
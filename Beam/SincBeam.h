@@ -23,9 +23,12 @@ public:
     // Uses polynomial approximation (Numerical Recipes)
     static float besselJ1(float x);
 
-    // Legacy sinc² calculation (kept for RCS ray weighting compatibility)
+    // Legacy sinc² calculation (the RCS ray weights use the Airy pattern of getGain)
     static float getSincSquaredIntensity(float theta, float thetaMax);
 
+    // Airy pattern with its first null at the main lobe's half-width
+    float getGain(float offAxis, float azimuth) const override;
+
     // Override render to set sideLobeColor uniform
     void render(QOpenGLShaderProgram* program, const QMatrix4x4& projection,
                 const QMatrix4x4& view, const QMatrix4x4& model) override;
@@ -34,13 +37,13 @@ protected:
     void createBeamGeometry() override;
     void setupShaders() override;
 
-    // Override for 7-float vertex format (pos + normal + intensity)
+    // Static (radial, azimuth) grid - uploaded once
     void uploadGeometryToGPU() override;
 
+    // Apex, axis, length and lobe width for the procedural vertex shader
+    void setGeometryUniforms() override;
+
 private:
-    // Generate vertices with per-vertex intensity for sinc² pattern
-    void generateSincBeamVertices(const QVector3D& apex,
-                                   const QVector3D& direction,
-                                   float length,
-                                   float mainLobeRadius);
+    // Fixed grid: apex plus kSincBeamRadialSegments rings of kBeamConeSegments
+    void buildSincGrid();
 };
@@ -44,12 +44,11 @@ void SingleRayBeam::setupShaders() {
     beamFragmentShaderSource_ = R"(
         #version 330 core
         in vec3 Color;
-        out vec4 FragColor;
 
         uniform float opacity;
 
         void main() {
-            FragColor = vec4(Color, opacity);
+            writeTransparent(vec4(Color, opacity));
         }
     )";
 
@@ -127,13 +126,8 @@ void SingleRayBeam::render(QOpenGLShaderProgram* program,
         return;
     }
 
-    // Enable depth test so ray is occluded by target
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-
-    // Enable alpha blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // The enclosing TransparencyPass depth tests the ray against the target
+    // and blends it
 
     // Set thick line width for visibility
     glLineWidth(kBounceLineWidth);
@@ -158,5 +152,4 @@ void SingleRayBeam::render(QOpenGLShaderProgram* program,
 
     // Restore state
     glLineWidth(1.0f);
-    glDisable(GL_BLEND);
 }
@@ -0,0 +1,125 @@
+// AllocationCounter.cpp - Counting replacements of the global operator new/delete
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocationBytes{0};
+
+} // namespace
+
+namespace RS {
+
+AllocationStats allocationStats() {
+    AllocationStats stats;
+    stats.allocations = allocationCount.load(std::memory_order_relaxed);
+    stats.bytes = allocationBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace RS
+
+#ifdef RS_COUNT_ALLOCATIONS
+
+namespace {
+
+void* rawAlloc(std::size_t size, std::size_t alignment) {
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size);
+    }
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+void rawFree(void* p, std::size_t alignment) {
+#ifdef _MSC_VER
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(p);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(p);
+}
+
+// As the standard library's operator new: retry through the installed
+// new-handler until the allocation succeeds or there is none left to call
+void* countedAlloc(std::size_t size, std::size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void* p = rawAlloc(size, alignment)) {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+            allocationBytes.fetch_add(size, std::memory_order_relaxed);
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* countedAllocNoThrow(std::size_t size, std::size_t alignment) noexcept {
+    try {
+        return countedAlloc(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+constexpr std::size_t kDefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size, kDefaultAlignment); }
+void* operator new[](std::size_t size) { return countedAlloc(size, kDefaultAlignment); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocNoThrow(size, kDefaultAlignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocNoThrow(size, kDefaultAlignment); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocNoThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAllocNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { rawFree(p, kDefaultAlignment); }
+void operator delete[](void* p) noexcept { rawFree(p, kDefaultAlignment); }
+void operator delete(void* p, std::size_t) noexcept { rawFree(p, kDefaultAlignment); }
+void operator delete[](void* p, std::size_t) noexcept { rawFree(p, kDefaultAlignment); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { rawFree(p, kDefaultAlignment); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { rawFree(p, kDefaultAlignment); }
+
+void operator delete(void* p, std::align_val_t alignment) noexcept { rawFree(p, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* p, std::align_val_t alignment) noexcept { rawFree(p, static_cast<std::size_t>(alignment)); }
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept {
+    rawFree(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept {
+    rawFree(p, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    rawFree(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    rawFree(p, static_cast<std::size_t>(alignment));
+}
+
+#endif // RS_COUNT_ALLOCATIONS
@@ -0,0 +1,27 @@
+// AllocationCounter.h - Process-wide heap allocation counters for the profiler
+#pragma once
+
+#include <cstdint>
+
+namespace RS {
+
+// Whether the global operator new/delete are replaced by the counting ones
+// in AllocationCounter.cpp (CMake option RADARSIM_COUNT_ALLOCATIONS, off by
+// default). Without them the counters stay at zero.
+#ifdef RS_COUNT_ALLOCATIONS
+constexpr bool kAllocationCounting = true;
+#else
+constexpr bool kAllocationCounting = false;
+#endif
+
+// Running totals since startup, across every thread. The counting operator
+// new/delete update them with relaxed atomics, so a snapshot costs two loads.
+// Frame allocations are the difference between two snapshots.
+struct AllocationStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+AllocationStats allocationStats();
+
+} // namespace RS
@@ -20,6 +20,7 @@ constexpr double kDegToRad = kPi / 180.0;
 constexpr float kDegToRadF = kPiF / 180.0f;
 constexpr double kRadToDeg = 180.0 / kPi;
 constexpr float kRadToDegF = 180.0f / kPiF;
+constexpr double kSpeedOfLight = 299792458.0;  // m/s, for wave numbers of the frequency sweep
 
 // =============================================================================
 // Compute Shader Configuration
@@ -27,6 +28,37 @@ constexpr float kRadToDegF = 180.0f / kPiF;
 constexpr int kComputeWorkgroupSize = 64;       // GPU workgroup size for compute shaders
 constexpr int kDefaultNumRays = 10000;          // Default number of rays for RCS computation
 constexpr int kRaysPerRing = 64;                // Rays per elevation ring in cone pattern
+constexpr int kReadbackSlotCount = 2;           // Hit/counter SSBO ring depth for async readback
+constexpr unsigned long long kReadbackWaitTimeoutNs = 1000000000ull; // Max blocking fence wait (1 s)
+constexpr int kMinRayCount = 100;               // Lower bound for the RCS ray count
+constexpr int kMaxRayCount = 16777216;          // Upper bound for the RCS ray count (16M)
+constexpr int kRayTileSize = 65536;             // Rays per dispatch tile (bounds ray/hit SSBO size)
+constexpr int kMaxCompactHits = 2097152;         // Hits-only readback entries per slot (2M, 64 MB)
+constexpr int kMaxLooksPerDispatch = 64;        // Radar looks traced together by RCSCompute::computeLooks
+constexpr int kPersistentTraceGroups = 256;     // Persistent trace groups when the driver reports no SM count
+constexpr int kShadowMapMaxRings = 1024;        // Max shadow map rows; extra rings share rows (nearest hit kept)
+constexpr int kShadowMapMinRings = 16;          // Min rows of the decoupled shadow map
+constexpr int kShadowMapMinWidth = 64;          // Decoupled shadow map azimuth texels, lower bound
+constexpr int kShadowMapMaxWidth = 1024;        // Decoupled shadow map azimuth texels, upper bound
+constexpr int kBeamPatternAzimuthBins = 64;     // Beam gain table columns (around the beam axis)
+constexpr int kBeamPatternOffAxisBins = 256;    // Beam gain table rows (off-axis angle)
+constexpr float kBinIntensityScale = 65536.0f;  // Fixed-point scale for GPU intensity binning
+constexpr float kBinIntensityMax = 65535.0f;    // Per-hit intensity clamp of the fixed-point sums (GPU and CPU lobes)
+constexpr float kHotspotIntensityScale = 256.0f; // Fixed-point scale for per-triangle hotspot sums
+constexpr float kFieldBinScale = 4096.0f;       // Fixed-point scale for GPU complex-field binning
+constexpr int kMaxFrequencyPoints = 64;         // Frequencies binned by one frequency-sweep pass
+constexpr int kFrequencyBlock = 8;              // Frequencies per workgroup row of the field binning pass
+constexpr int kCPUTraceChunkRays = 1024;        // Rays per work item claimed by a CPURayTracer thread
+constexpr int kProgressivePreviewRays = 1024;   // First batch of a progressive accumulation
+constexpr int kProgressiveMaxBatchRays = 262144; // Cap on a progressive batch (batches double until then)
+constexpr float kProgressiveLatticeRatio = 0.618034f; // Golden-ratio step of the progressive ray permutation
+constexpr int kSampleJitterPasses = 4;         // Rotated passes a jittered progressive accumulation adds up
+constexpr int kMaxRCSBounces = 8;              // Bounce passes per ray in the GPU trace (bounce queue header)
+constexpr float kBounceCutoffIntensity = 1.0e-3f;  // Multi-bounce return at which a path stops bouncing
+constexpr float kBounceRouletteThreshold = 0.05f;  // ... and under which it plays Russian roulette
+constexpr int kMaxBounceEffects = 8;           // BounceEffects compiled into the trace kernels' per-hit chain
+constexpr int kMaxMaterials = 65536;           // Material table entries (CompactTriangle keeps 16-bit IDs)
+constexpr int kRCSIdleDelayMs = 200;           // Quiet time after the last input before traces run unthrottled
 
 // =============================================================================
 // BVH (Bounding Volume Hierarchy) Settings
@@ -34,6 +66,20 @@ constexpr int kRaysPerRing = 64;                // Rays per elevation ring in co
 constexpr int kBVHMaxLeafSize = 4;              // Maximum triangles per leaf node
 constexpr int kBVHNumBins = 12;                 // Number of bins for SAH split finding
 constexpr int kBVHStackSize = 62;               // Stack size for iterative BVH traversal
+constexpr int kBVHParallelMinTriangles = 8192;  // Subtrees smaller than this build serially
+constexpr int kBVHParallelBinningMin = 65536;   // Nodes larger than this bin in parallel chunks
+constexpr float kBVHRefitMaxCostRatio = 1.5f;   // Rebuild once refit SAH cost exceeds build cost by this factor
+constexpr float kNormalConeMargin = 1e-3f;      // Radians added to normal cones (octahedral normal precision)
+constexpr float kNoNormalCone = 2.0f;           // Normal cone w that never culls (half-angle of 90 degrees or more)
+constexpr int kGPUBVHMaxTriangles = 1 << 23;    // GPU-built mesh limit: node indices stay exact in float w
+constexpr int kTLASMaxLeafSize = 2;             // Maximum instances per top-level leaf node
+constexpr int kTLASStackSize = 32;              // Top-level traversal stack; TLASBuilder stops splitting to fit it
+constexpr int kWideBVHWidth = 4;                // Children per collapsed (wide) BVH node
+constexpr unsigned int kWideBVHChildEmpty = 0xFFFFFFFFu;  // Unused wide child slot
+constexpr unsigned int kWideBVHLeafFlag = 0x80000000u;    // Leaf child: flag | count << 24 | firstTri
+constexpr int kWideBVHLeafCountShift = 24;
+constexpr int kWideBVHMaxLeafTriangles = 127;   // 7-bit leaf triangle count
+constexpr int kWideBVHMaxTriangles = 1 << 24;   // 24-bit leaf first triangle
 
 // =============================================================================
 // Geometry Generation - Segment/Resolution Counts
@@ -54,7 +100,8 @@ constexpr float kCameraMaxElevation = 1.5f;     // Max elevation angle (~85 degr
 constexpr float kCameraRotationSpeed = 0.005f;  // Mouse rotation sensitivity
 constexpr float kCameraZoomSpeed = 0.5f;        // Mouse wheel zoom sensitivity
 constexpr float kCameraInertiaDecay = 0.95f;    // Inertia velocity decay factor
-constexpr int kCameraInertiaTimerMs = 16;       // Inertia timer interval (~60 FPS)
+constexpr float kCameraInertiaStepMs = 16.0f;   // Frame length the inertia decay is per (~60 FPS)
+constexpr double kFrameClockMaxStepMs = 100.0;  // RS::FrameClock step cap after a stalled frame
 constexpr float kCameraInertiaScaleFactor = 0.3f; // Inertia velocity scale factor
 constexpr float kCameraVelocityThreshold = 0.001f; // Min velocity to trigger inertia
 
@@ -71,6 +118,8 @@ constexpr float kMaxRayDistanceMultiplier = 3.0f; // Max ray distance as multipl
 constexpr float kGridLineWidthNormal = 0.3f;    // Standard grid line width
 constexpr float kGridLineWidthSpecial = 2.5f;   // Major grid line width (equator, prime meridian)
 constexpr float kGridRadiusOffset = 1.005f;     // Grid radius multiplier (slightly outside sphere)
+constexpr int kGridLatitudeLines = 11;          // -75..75 degrees every 15 (matches the grid shader)
+constexpr int kGridLongitudeLines = 24;         // 0..345 degrees every 15 (matches the grid shader)
 constexpr float kRadarDotRadius = 5.0f;         // Radar position dot size
 constexpr int kRadarDotVertices = 16;           // Vertices in radar dot circle
 
@@ -138,6 +187,8 @@ constexpr int kMaxReflectionLobes = 100;        // Maximum aggregated lobe clust
 constexpr int kMaxTargets = 16;                 // Maximum simultaneous targets
 constexpr float kLobeClusterAngle = 10.0f;      // Clustering angle threshold (degrees)
 constexpr float kLobeClusterDist = 5.0f;        // Clustering spatial distance threshold
+constexpr int kLobeClusterTableSize = 4096;     // GPU cluster hash table slots (power of two)
+constexpr int kLobeClusterMaxOutput = 1024;     // Max clusters read back from the GPU per frame
 constexpr float kLobeConeLength = 15.0f;        // Length of visualization cones
 constexpr float kLobeConeRadius = 3.0f;         // Base radius of visualization cones
 constexpr int kLobeConeSegments = 12;           // Segments around cone circumference
@@ -164,16 +215,34 @@ constexpr int kHeatMapLonSegments = 64;         // Sphere mesh longitude segment
 // Bounce Visualization
 // =============================================================================
 constexpr int kMaxBounces = 50;                   // Safety limit for ray bounces
+constexpr int kDebugRayBounces = 5;               // Debug ray draws this prefix of the bounce path
 constexpr float kBounceIntensityDecay = 0.15f;    // Per-bounce intensity reduction
 constexpr float kBounceMinIntensity = 0.2f;       // Floor intensity (never dimmer than this)
 constexpr float kBounceLineWidth = 3.0f;          // Line width for bounce rays
 constexpr float kBounceHitMarkerSize = 2.0f;      // Size of hit point markers
+constexpr int kLineBatchCapacity = 1024;          // Initial overlay primitives per ring region (grows on demand)
+constexpr float kLineBatchMarkerArm = 0.2f;       // Marker cross arm half-thickness, fraction of the marker size
+
+// =============================================================================
+// Target Picking
+// =============================================================================
+constexpr float kPickVisibilityTolerance = 1.0e-3f;  // Radar ray may run this fraction past a picked point
 
 // =============================================================================
 // Polar RCS Plot Configuration
 // =============================================================================
 constexpr float kDefaultSliceThickness = 10.0f; // 10 degrees default slab thickness
 constexpr int kPolarPlotBins = 360;             // 1-degree resolution (360 bins)
+constexpr int kSphereTableAzBins = 720;         // Full-sphere cut table: 0.5-degree azimuth columns
+constexpr int kSphereTableElBins = 360;         // ... and 0.5-degree elevation rows
+constexpr int kMaxReceivers = 8;                // Bistatic receiver sites binned per trace (whole vec4 packs)
+constexpr float kReceiverAcceptanceDegrees = 5.0f;  // Half-angle of the exit-direction cone a receiver collects
+constexpr float kEdgeDiffractionMinWedge = 1e-3f;       // Exterior wedge angle / pi this close to 1 is flat, never diffracts
+constexpr float kEdgeDiffractionMinDenominator = 0.05f; // Keller coefficient pole clamp (face-normal incidence)
+constexpr float kEdgeDiffractionMinIntensity = 1e-3f;   // Weaker edge returns are not binned (keeps hit counts to real lobes)
+constexpr float kSliceTableCellDegrees = 0.5f;  // CPU sampler slice tables: slice angle resolution
+constexpr int kHitParallelMinHits = 65536;      // CPU hit consumers split work into chunks of at least this many hits
+constexpr int kMaxOverlayCuts = 4;              // Extra cuts drawn over the primary curve (multi-cut mode)
 constexpr float kPolarPlotMinDBsm = -40.0f;     // Display minimum dBsm
 constexpr float kPolarPlotMaxDBsm = 20.0f;      // Display maximum dBsm
 constexpr float kDBsmFloor = -60.0f;            // Floor for log(0) and empty bins
@@ -205,6 +274,85 @@ constexpr int kSincBeamNumSideLobes = 3;        // Number of side lobes to rende
 constexpr float kSincSideLobeMultiplier = 4.0f; // Geometry extends 4x main lobe for side lobes + edge fade
 constexpr int kSincBeamRadialSegments = 64;     // Radial resolution for intensity gradient
 
+// =============================================================================
+// Frame Profiler
+// =============================================================================
+constexpr int kProfilerQuerySets = 2;           // Timestamp query sets in flight (double-buffered)
+constexpr int kProfilerHistoryFrames = 60;      // Resolved frames averaged by the overlay
+constexpr int kProfilerLogMaxBytes = 8 * 1024 * 1024;  // Log rolls over to <path>.1 past this size
+
+// =============================================================================
+// Session Telemetry
+// =============================================================================
+constexpr int kTelemetryBuckets = 128;          // Histogram buckets per metric (16 per decade on log metrics)
+constexpr int kTelemetryWindowSlots = 6;        // Dump intervals the rolling percentiles cover
+constexpr int kTelemetryDumpIntervalMs = 10000; // telemetry.json rewrite period (window = 60 s)
+
+// =============================================================================
+// Batch RCS Sweep
+// =============================================================================
+constexpr float kSweepSliceThickness = 5.0f;    // Azimuth cut half-thickness around each radar elevation
+constexpr int kSweepBVHTimeoutMs = 60000;       // Longest wait for the background BVH build
+constexpr float kSweepFormationSpacing = 60.0f; // Default rank spacing for --formation (world units)
+constexpr int kResultChunkRows = 1024;          // Rows per .rcsc chunk (1.5 MB with the full cut column)
+constexpr int kResultWriterQueueChunks = 8;     // Chunks queued for the I/O thread before appendRow waits
+constexpr int kResultColumnNameBytes = 32;      // Fixed column name field in the .rcsc header
+constexpr int kDatasetPrefetchRadius = 2;       // Looks on each side of the shown one the viewer pages in
+constexpr int kDatasetCacheChunks = 16;         // Inflated cut chunks kept for compressed datasets
+constexpr int kSweepUnitsInFlight = 2;          // Elevation rows queued on each --workers process
+constexpr int kSweepWorkerStartMs = 30000;      // Longest wait for a worker process to start or exit
+constexpr int kResultCacheEntries = 16;         // Settled RCS results kept by RadarGLWidget (~4 MB each with sphere bins)
+constexpr float kResultCacheAngleStep = 0.05f;  // Degrees - radar azimuth/elevation and beam width quantum of a cache key
+constexpr float kResultCacheRangeStep = 0.01f;  // Scene units - radar range and receiver position quantum
+constexpr float kResultCachePoseStep = 1.0e-4f; // Instance matrix element quantum
+constexpr float kTemporalMaxAngleDegrees = 1.0f;   // Radar motion beyond which a frame keeps none of the last one's bins
+constexpr float kTemporalHistoryWeight = 0.5f;     // Share of the last frame's bins kept after a standstill-sized move
+constexpr float kTemporalRangeTolerance = 0.01f;   // Relative radar range change that still reuses history
+
+// =============================================================================
+// Trajectory Playback
+// =============================================================================
+constexpr int kTrajectoryPlaybackHz = 30;       // Fixed playback tick rate
+constexpr int kTrajectoryRingKeyframes = 64;    // Traced keyframes held ahead of the playhead
+constexpr int kTrajectoryTraceBudgetMs = 12;    // Tracing time per tick before the frame is shown
+
+// =============================================================================
+// Benchmarks (--bench)
+// =============================================================================
+constexpr int kBenchRepeats = 5;                 // Timed runs per case; the median is reported
+constexpr float kBenchRegressionPercent = 10.0f; // --compare flags cases this much worse than the baseline
+constexpr int kBenchSyntheticTriangles = 1000000; // Height-field mesh for the large BVH build case
+constexpr int kBenchOrbitRays = 100000;          // Rays per frame of the orbit (temporal reuse) cases
+constexpr int kBenchOrbitFrames = 40;            // Radar steps per orbit case, the first untimed
+constexpr float kBenchOrbitStepDegrees = 0.25f;  // Azimuth step per frame, well inside kTemporalMaxAngleDegrees
+
+// =============================================================================
+// Sphere Validation (--validate-sphere)
+// =============================================================================
+constexpr int kSphereValidationLooks = 8;                   // Aspect angles averaged per configuration
+constexpr float kSphereValidationBackscatterDegrees = 10.0f; // Half-angle of the cone counted as monostatic return
+constexpr float kSphereValidationBeamMargin = 1.1f;         // Beam half-angle over the sphere's angular radius
+
+// =============================================================================
+// Target Geometry
+// =============================================================================
+constexpr int kEdgeParallelMinTriangles = 32768;  // Smaller meshes detect crease edges on one thread
+constexpr int kSphereParallelMinFaces = 16384;    // Per chunk of a geodesic subdivision level
+constexpr float kReflectorPlateThickness = 0.01f;  // Drawn (and mesh-traced) slab of a 1 x 1 reflector plate
+
+// Display level of detail (the RCS trace always uses the full mesh)
+constexpr unsigned int kLodMinTriangles = 250000;         // Smaller meshes are always drawn in full
+constexpr unsigned int kLodCoarsestTriangles = 16384;     // Simplification stops here
+constexpr float kLodReductionRatio = 0.25f;               // Triangles kept from one level to the next
+constexpr float kLodTrianglesPerPixel = 0.5f;             // Wanted density over the target's screen area
+constexpr unsigned int kLodMaxDisplayTriangles = 2000000; // Finer levels are never drawn
+
+// =============================================================================
+// Target Cache
+// =============================================================================
+constexpr unsigned int kTargetCacheVersion = 4;  // Bump when the file layout, MeshImporter or BVHBuilder output changes
+constexpr int kTargetCacheAlignment = 64;        // Section alignment inside a cache file (bytes)
+
 // =============================================================================
 // Default Values (used when no config loaded)
 // =============================================================================
@@ -234,6 +382,20 @@ namespace Defaults {
 
     // RCS Plane
     constexpr float kRCSPlaneOffset = 0.0f;
+
+    // RCS tracing
+    constexpr int kRCSBounces = 3;  // Double and triple bounce returns
+    constexpr bool kDecoupledShadows = true;  // Beam shadow map sized from the screen, not the ray count
+    constexpr bool kBoundsFocusedRays = true; // RCS rays cover the target's bounding cone, not the whole beam
+    constexpr bool kRCSResultCache = true;    // Revisited configurations restore cached results instead of tracing
+    constexpr bool kTemporalReuse = false;    // Rays start from last frame's leaves, small moves blend last frame's bins
+    constexpr bool kEdgeDiffraction = false;  // Crease edges add their diffracted return to the bins
+    constexpr bool kTriangleHotspots = false; // Target triangles tinted by the RCS return they reflect
+    constexpr bool kHoverPicking = true;      // The cursor resting on a target is picked and labelled
+    constexpr double kRadarFrequencyHz = 10.0e9;  // X band, phase of coherent summation
+    constexpr float kRCSFrameBudgetMs = 8.0f;  // GPU time per frame for traces during interaction
+    constexpr double kGPUMemoryBudgetMB = 0.0;      // 0 = kGPUMemoryBudgetFraction of the detected VRAM (untracked limit if unknown)
+    constexpr double kGPUMemoryBudgetFraction = 0.75;  // Share of dedicated VRAM the app plans to use
 }
 
 // =============================================================================
@@ -287,6 +449,14 @@ namespace View {
     constexpr float kNearPlane = 0.1f;              // Near clipping plane
     constexpr float kFarPlane = 2000.0f;            // Far clipping plane
     constexpr float kAxisLengthMultiplier = 1.2f;   // Axis length as fraction of radius
+    constexpr int kSceneMSAASamples = 4;            // Scene target samples at full quality (SceneTarget)
+    constexpr float kRasterBudgetMs = 8.0f;         // GPU time per frame for the scene raster during interaction
+    constexpr float kMinRenderScale = 0.5f;         // Smallest scene resolution, as a fraction of the output
+    constexpr float kRenderScaleStep = 0.125f;      // Resolution change per RenderScaler adjustment
+    constexpr float kRenderScaleHeadroom = 0.6f;    // Quality is raised again under this fraction of the budget
+    constexpr int kPopOutResizeDebounceMs = 150;    // Pop-out attachments reallocate once resizing pauses
+    constexpr int kSettingsSaveDebounceMs = 1000;   // Session auto-save waits for the settings to stay unchanged this long
+    constexpr int kComponentWarmUpDelayMs = 250;    // Idle gap between deferred component initializations
 }
 
 // =============================================================================
@@ -295,6 +465,9 @@ namespace View {
 namespace UI {
     constexpr int kAxisLabelFontSize = 14;          // Font size for axis labels
     constexpr int kTextOffsetPixels = 15;           // Offset for text labels
+    constexpr int kRayCountSliderSteps = 1000;      // Positions on the logarithmic ray count slider
+    constexpr int kProfilerFontSize = 9;            // Font size for the profiler overlay
+    constexpr int kPickLabelFontSize = 9;           // Font size for the hover pick label
 }
 
 }} // namespace RS::Constants
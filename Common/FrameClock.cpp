@@ -0,0 +1,66 @@
+// FrameClock.cpp - Advances animations once per displayed frame
+#include "FrameClock.h"
+#include "Constants.h"
+#include <QOpenGLWidget>
+#include <algorithm>
+
+namespace RS {
+
+using namespace Constants;
+
+void FrameClock::attach(QOpenGLWidget* widget) {
+    widget_ = widget;
+    if (widget_) {
+        QObject::connect(widget_, &QOpenGLWidget::frameSwapped, widget_, [this]() { onFrameSwapped(); });
+    }
+}
+
+void FrameClock::start(const void* key, Animation animation) {
+    if (animations_.empty()) {
+        lastFrame_.start();  // The first step covers the wait for the next frame, not the idle time before it
+    }
+    auto it = std::find_if(animations_.begin(), animations_.end(),
+                           [key](const auto& entry) { return entry.first == key; });
+    if (it != animations_.end()) {
+        it->second = std::move(animation);
+    } else {
+        animations_.emplace_back(key, std::move(animation));
+    }
+    requestFrame();
+}
+
+void FrameClock::stop(const void* key) {
+    animations_.erase(std::remove_if(animations_.begin(), animations_.end(),
+                                     [key](const auto& entry) { return entry.first == key; }),
+                      animations_.end());
+}
+
+bool FrameClock::isRunning(const void* key) const {
+    return std::any_of(animations_.begin(), animations_.end(),
+                       [key](const auto& entry) { return entry.first == key; });
+}
+
+void FrameClock::onFrameSwapped() {
+    if (animations_.empty()) {
+        return;
+    }
+    // A stalled frame (a modal dialog, a long trace) resumes where it left
+    // off instead of jumping ahead
+    double seconds = std::min(lastFrame_.nsecsElapsed() * 1.0e-9, kFrameClockMaxStepMs * 1.0e-3);
+    lastFrame_.restart();
+
+    animations_.erase(std::remove_if(animations_.begin(), animations_.end(),
+                                     [seconds](auto& entry) { return !entry.second(seconds); }),
+                      animations_.end());
+    if (!animations_.empty()) {
+        requestFrame();
+    }
+}
+
+void FrameClock::requestFrame() {
+    if (widget_) {
+        widget_->update();
+    }
+}
+
+} // namespace RS
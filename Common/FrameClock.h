@@ -0,0 +1,49 @@
+// FrameClock.h - Advances animations once per displayed frame
+#pragma once
+
+#include <QElapsedTimer>
+#include <functional>
+#include <utility>
+#include <vector>
+
+class QOpenGLWidget;
+
+namespace RS {
+
+// Animations step from QOpenGLWidget::frameSwapped instead of their own
+// timers. Each swap hands every running animation the time since the
+// previous displayed frame, and while any is still running the clock asks
+// for the next paint. A timer ticking beside vsync repaints twice in some
+// frames and not at all in others; here an animation costs exactly the frames
+// it is shown in, and the paint it asks for only redoes work whose inputs
+// changed (RS::SceneVersions), so a camera-only animation never traces.
+class FrameClock {
+public:
+    // Advances by seconds of wall time; false once the animation has come to rest
+    using Animation = std::function<bool(double seconds)>;
+
+    FrameClock() = default;
+    FrameClock(const FrameClock&) = delete;
+    FrameClock& operator=(const FrameClock&) = delete;
+
+    // Follows widget's swaps and repaints it. The widget must outlive the clock.
+    void attach(QOpenGLWidget* widget);
+
+    // Runs animation under key (replacing any already there) from the next
+    // displayed frame on. Animations must not start or stop others from
+    // inside their step.
+    void start(const void* key, Animation animation);
+    void stop(const void* key);
+    bool isRunning(const void* key) const;
+    bool isAnimating() const { return !animations_.empty(); }
+
+private:
+    void onFrameSwapped();
+    void requestFrame();
+
+    QOpenGLWidget* widget_ = nullptr;
+    std::vector<std::pair<const void*, Animation>> animations_;
+    QElapsedTimer lastFrame_;  // Restarted by every swap that advanced, and when the first animation starts
+};
+
+} // namespace RS
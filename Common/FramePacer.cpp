@@ -0,0 +1,122 @@
+// FramePacer.cpp - Throttles RCS traces during interaction against a GPU time budget
+#include "FramePacer.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace RS {
+
+using namespace Constants;
+
+bool FramePacer::initialize() {
+    if (initialized_) {
+        return true;
+    }
+    if (!initializeOpenGLFunctions()) {
+        qWarning() << "FramePacer: failed to initialize OpenGL functions";
+        return false;
+    }
+
+    glGenQueries(kQueries, queries_.data());
+    pending_.fill(false);
+    initialized_ = true;
+    return true;
+}
+
+void FramePacer::cleanup() {
+    if (initialized_) {
+        glDeleteQueries(kQueries, queries_.data());
+    }
+    queries_.fill(0);
+    pending_.fill(false);
+    active_ = -1;
+    traceCostMs_ = -1.0;
+    creditMs_ = 0.0;
+    initialized_ = false;
+}
+
+void FramePacer::setBudgetMs(double milliseconds) {
+    budgetMs_ = std::max(milliseconds, 0.0);
+}
+
+void FramePacer::noteInput() {
+    lastInput_.restart();
+}
+
+bool FramePacer::isInteracting() const {
+    return lastInput_.isValid() && lastInput_.elapsed() < kRCSIdleDelayMs;
+}
+
+bool FramePacer::admitTrace() {
+    collect();
+
+    // Unknown cost (first trace, or no GL timing) and idle input always trace.
+    // Idle frames refill the bucket so the first change of a drag traces at once.
+    if (!isInteracting() || traceCostMs_ < 0.0 || budgetMs_ <= 0.0) {
+        creditMs_ = std::max(traceCostMs_, budgetMs_);
+        return true;
+    }
+
+    // Cap the credit so a long idle stretch can't pay for a burst of traces
+    creditMs_ = std::min(creditMs_ + budgetMs_, std::max(traceCostMs_, budgetMs_));
+    if (creditMs_ < traceCostMs_) {
+        return false;
+    }
+    creditMs_ -= traceCostMs_;
+    return true;
+}
+
+void FramePacer::beginTrace() {
+    if (!initialized_ || active_ >= 0) {
+        return;
+    }
+
+    // All queries in flight - skip this sample rather than wait for one
+    collect();
+    if (pending_[next_]) {
+        return;
+    }
+
+    active_ = next_;
+    next_ = (next_ + 1) % kQueries;
+    glBeginQuery(GL_TIME_ELAPSED, queries_[active_]);
+}
+
+void FramePacer::endTrace() {
+    if (active_ < 0) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    pending_[active_] = true;
+    active_ = -1;
+}
+
+void FramePacer::collect() {
+    if (!initialized_) {
+        return;
+    }
+
+    for (int i = 0; i < kQueries; ++i) {
+        if (!pending_[i]) {
+            continue;
+        }
+        GLuint available = 0;
+        glGetQueryObjectuiv(queries_[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(queries_[i], GL_QUERY_RESULT, &elapsedNs);
+        pending_[i] = false;
+
+        addTraceSample(static_cast<double>(elapsedNs) / 1.0e6);
+    }
+}
+
+void FramePacer::addTraceSample(double milliseconds) {
+    traceCostMs_ = traceCostMs_ < 0.0
+        ? milliseconds
+        : traceCostMs_ + kCostSmoothing * (milliseconds - traceCostMs_);
+}
+
+} // namespace RS
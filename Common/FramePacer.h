@@ -0,0 +1,71 @@
+// FramePacer.h - Throttles RCS traces during interaction against a GPU time budget
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QElapsedTimer>
+#include <array>
+
+#include "Constants.h"
+
+namespace RS {
+
+// Control drags repaint every vsync (QOpenGLWidget::update() already merges
+// the signals of one frame into one paint), but a full RCS trace per paint
+// can cost more than the frame. The pacer admits traces with a token bucket:
+// every paint earns budgetMs of credit, and a trace spends its measured GPU
+// cost. Expensive traces therefore run every few frames while the rest of the
+// scene keeps drawing. Once input has been idle for kRCSIdleDelayMs every
+// trace is admitted and progressive refinement may continue.
+// All GL calls must happen with the owning context current.
+class FramePacer : protected QOpenGLFunctions_4_5_Core {
+public:
+    FramePacer() = default;
+    ~FramePacer() = default;
+
+    // Lifecycle
+    bool initialize();
+    void cleanup();
+
+    // GPU milliseconds per frame the RCS trace may use while interacting
+    void setBudgetMs(double milliseconds);
+    double budgetMs() const { return budgetMs_; }
+
+    // Record that a trace input changed this frame
+    void noteInput();
+    bool isInteracting() const;
+
+    // Called once per paint that wants a trace. Returns false if the trace
+    // should be skipped to stay within the budget.
+    bool admitTrace();
+
+    // Bracket the trace with a GL_TIME_ELAPSED query. Results are collected
+    // on later frames, and only once the GPU has them - the pacer never stalls.
+    void beginTrace();
+    void endTrace();
+
+    // A trace cost measured elsewhere, in place of the query - for traces
+    // that run on another context (RCSComputeThread)
+    void addTraceSample(double milliseconds);
+
+    // Smoothed GPU cost of one trace (-1 until the first result arrives)
+    double traceCostMs() const { return traceCostMs_; }
+
+private:
+    void collect();
+
+    static constexpr int kQueries = 3;
+    static constexpr double kCostSmoothing = 0.25;  // EMA weight of the newest sample
+
+    bool initialized_ = false;
+    std::array<GLuint, kQueries> queries_{};
+    std::array<bool, kQueries> pending_{};
+    int next_ = 0;
+    int active_ = -1;  // Query open between beginTrace() and endTrace()
+
+    double budgetMs_ = Constants::Defaults::kRCSFrameBudgetMs;
+    double traceCostMs_ = -1.0;
+    double creditMs_ = 0.0;
+    QElapsedTimer lastInput_;
+};
+
+} // namespace RS
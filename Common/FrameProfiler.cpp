@@ -0,0 +1,363 @@
+// FrameProfiler.cpp - Per-stage CPU and GPU frame timing (GL_TIMESTAMP queries)
+#include "FrameProfiler.h"
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace RS {
+
+using namespace Constants;
+
+namespace {
+
+constexpr qint64 kNsPerMs = 1000000;
+
+bool sameStage(const StageTiming& timing, const char* name, int depth) {
+    return timing.depth == depth &&
+           (timing.name == name || std::strcmp(timing.name, name) == 0);
+}
+
+} // namespace
+
+bool FrameProfiler::initialize() {
+    if (initialized_) {
+        return true;
+    }
+    if (!initializeOpenGLFunctions()) {
+        qWarning() << "FrameProfiler: failed to initialize OpenGL functions";
+        return false;
+    }
+
+    // Timestamps are core since GL 3.3 but some drivers report 0 counter bits
+    GLint counterBits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+    if (counterBits == 0) {
+        qWarning() << "FrameProfiler: GL_TIMESTAMP not supported - GPU times disabled";
+        return false;
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+void FrameProfiler::cleanup() {
+    for (auto& set : querySets_) {
+        if (!set.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(set.queries.size()), set.queries.data());
+        }
+        set = QuerySet();
+    }
+    stageStack_.clear();
+    inFrame_ = false;
+    stopLog();
+    initialized_ = false;
+}
+
+void FrameProfiler::setEnabled(bool enabled) {
+    if (enabled_ == enabled) {
+        return;
+    }
+    enabled_ = enabled;
+    if (!enabled_) {
+        // Outstanding results are stale once profiling resumes
+        for (auto& set : querySets_) {
+            set.pending = false;
+        }
+        history_.clear();
+    }
+}
+
+void FrameProfiler::beginFrame() {
+    if (!isEnabled()) {
+        return;
+    }
+
+    currentSet_ = static_cast<int>(frameCounter_ % kProfilerQuerySets);
+    QuerySet& set = querySets_[currentSet_];
+
+    // Results from kProfilerQuerySets frames ago. If the GPU is still behind,
+    // drop them rather than wait.
+    if (set.pending && !resolve(set)) {
+        ++droppedFrames_;
+    }
+
+    set.usedQueries = 0;
+    set.stages.clear();
+    set.frameIndex = ++frameCounter_;
+    set.pending = false;
+    stageStack_.clear();
+    frameTimer_.start();
+    inFrame_ = true;
+
+    // Taken last so resolving the old set is not charged to this frame
+    set.allocations = allocationStats();
+}
+
+void FrameProfiler::endFrame() {
+    if (!inFrame_) {
+        return;
+    }
+    QuerySet& set = querySets_[currentSet_];
+
+    // Taken first so closing stages is not charged to the frame
+    AllocationStats now = allocationStats();
+    set.allocations.allocations = now.allocations - set.allocations.allocations;
+    set.allocations.bytes = now.bytes - set.allocations.bytes;
+
+    // Close anything an early return left open
+    while (!stageStack_.empty()) {
+        endStage();
+    }
+
+    set.cpuFrameNs = frameTimer_.nsecsElapsed();
+    set.pending = !set.stages.empty();
+    inFrame_ = false;
+}
+
+void FrameProfiler::beginStage(const char* name) {
+    if (!inFrame_) {
+        return;
+    }
+    QuerySet& set = querySets_[currentSet_];
+
+    StageRecord record;
+    record.name = name;
+    record.depth = static_cast<int>(stageStack_.size());
+    record.beginQuery = allocateQuery(set);
+    glQueryCounter(set.queries[record.beginQuery], GL_TIMESTAMP);
+    record.cpuBeginNs = frameTimer_.nsecsElapsed();
+
+    stageStack_.push_back(static_cast<int>(set.stages.size()));
+    set.stages.push_back(record);
+}
+
+void FrameProfiler::endStage() {
+    if (!inFrame_ || stageStack_.empty()) {
+        return;
+    }
+    QuerySet& set = querySets_[currentSet_];
+    StageRecord& record = set.stages[stageStack_.back()];
+    stageStack_.pop_back();
+
+    record.cpuEndNs = frameTimer_.nsecsElapsed();
+    record.endQuery = allocateQuery(set);
+    glQueryCounter(set.queries[record.endQuery], GL_TIMESTAMP);
+}
+
+void FrameProfiler::addCpuStage(const char* name, double milliseconds) {
+    if (!inFrame_) {
+        return;
+    }
+    StageRecord record;
+    record.name = name;
+    record.depth = static_cast<int>(stageStack_.size());
+    record.cpuOnlyMs = milliseconds;
+    querySets_[currentSet_].stages.push_back(record);
+}
+
+int FrameProfiler::allocateQuery(QuerySet& set) {
+    if (set.usedQueries == static_cast<int>(set.queries.size())) {
+        // Grow in blocks so steady-state frames never create queries
+        size_t oldSize = set.queries.size();
+        size_t newSize = std::max<size_t>(oldSize * 2, 64);
+        set.queries.resize(newSize);
+        glGenQueries(static_cast<GLsizei>(newSize - oldSize), set.queries.data() + oldSize);
+    }
+    return set.usedQueries++;
+}
+
+bool FrameProfiler::resolve(QuerySet& set) {
+    set.pending = false;
+
+    // Queries complete in order, so the last one signals the whole set
+    if (set.usedQueries > 0) {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(set.queries[set.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+
+    FrameTiming frame;
+    frame.frameIndex = set.frameIndex;
+    frame.cpuMs = static_cast<double>(set.cpuFrameNs) / kNsPerMs;
+    frame.allocations = set.allocations.allocations;
+    frame.allocatedBytes = set.allocations.bytes;
+
+    GLuint64 frameBegin = 0;
+    GLuint64 frameEnd = 0;
+    for (const StageRecord& record : set.stages) {
+        double cpuMs = record.cpuOnlyMs;
+        double gpuMs = -1.0;
+        if (record.beginQuery >= 0 && record.endQuery >= 0) {
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(set.queries[record.beginQuery], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(set.queries[record.endQuery], GL_QUERY_RESULT, &end);
+            gpuMs = static_cast<double>(end - begin) / kNsPerMs;
+            cpuMs = static_cast<double>(record.cpuEndNs - record.cpuBeginNs) / kNsPerMs;
+            if (record.depth == 0) {
+                frameBegin = frameBegin == 0 ? begin : std::min(frameBegin, begin);
+                frameEnd = std::max(frameEnd, end);
+            }
+        }
+
+        // Merge repeated calls (per-tile dispatches) into one entry
+        auto it = std::find_if(frame.stages.begin(), frame.stages.end(),
+            [&record](const StageTiming& t) { return sameStage(t, record.name, record.depth); });
+        if (it == frame.stages.end()) {
+            StageTiming timing;
+            timing.name = record.name;
+            timing.depth = record.depth;
+            frame.stages.push_back(timing);
+            it = frame.stages.end() - 1;
+        }
+        it->calls += 1;
+        it->cpuMs += std::max(cpuMs, 0.0);
+        if (gpuMs >= 0.0) {
+            it->gpuMs = std::max(it->gpuMs, 0.0) + gpuMs;
+        }
+    }
+    frame.gpuMs = static_cast<double>(frameEnd - frameBegin) / kNsPerMs;
+
+    if (isLogging()) {
+        writeLog(frame);
+    }
+    history_.push_back(std::move(frame));
+    while (static_cast<int>(history_.size()) > kProfilerHistoryFrames) {
+        history_.pop_front();
+    }
+    return true;
+}
+
+std::vector<StageTiming> FrameProfiler::getAveragedStages() const {
+    std::vector<StageTiming> averaged;
+    if (history_.empty()) {
+        return averaged;
+    }
+
+    // Stage order follows the newest frame; stages missing from older frames
+    // (e.g. the BVH build) count as zero there
+    for (const StageTiming& stage : history_.back().stages) {
+        StageTiming sum;
+        sum.name = stage.name;
+        sum.depth = stage.depth;
+        bool hasGpu = false;
+        double gpuSum = 0.0;
+        for (const FrameTiming& frame : history_) {
+            for (const StageTiming& t : frame.stages) {
+                if (sameStage(t, stage.name, stage.depth)) {
+                    sum.calls += t.calls;
+                    sum.cpuMs += t.cpuMs;
+                    if (t.gpuMs >= 0.0) {
+                        gpuSum += t.gpuMs;
+                        hasGpu = true;
+                    }
+                    break;
+                }
+            }
+        }
+        double n = static_cast<double>(history_.size());
+        sum.calls = static_cast<int>(sum.calls / n + 0.5);
+        sum.cpuMs /= n;
+        sum.gpuMs = hasGpu ? gpuSum / n : -1.0;
+        averaged.push_back(sum);
+    }
+    return averaged;
+}
+
+AllocationStats FrameProfiler::getAveragedAllocations() const {
+    AllocationStats averaged;
+    if (history_.empty()) {
+        return averaged;
+    }
+    for (const FrameTiming& frame : history_) {
+        averaged.allocations += frame.allocations;
+        averaged.bytes += frame.allocatedBytes;
+    }
+    averaged.allocations /= history_.size();
+    averaged.bytes /= history_.size();
+    return averaged;
+}
+
+bool FrameProfiler::startLog(const QString& path) {
+    stopLog();
+
+    QString suffix = QFileInfo(path).suffix().toLower();
+    logJson_ = suffix == "json" || suffix == "jsonl";
+
+    logFile_.setFileName(path);
+    if (!logFile_.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "FrameProfiler: cannot open log" << path << ":" << logFile_.errorString();
+        return false;
+    }
+    if (!logJson_) {
+        logFile_.write("frame,stage,depth,calls,cpu_ms,gpu_ms\n");
+    }
+    return true;
+}
+
+void FrameProfiler::stopLog() {
+    if (logFile_.isOpen()) {
+        logFile_.close();
+    }
+}
+
+void FrameProfiler::writeLog(const FrameTiming& frame) {
+    QString text;
+    QTextStream out(&text);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(4);
+
+    if (logJson_) {
+        out << "{\"frame\":" << frame.frameIndex
+            << ",\"cpuMs\":" << frame.cpuMs
+            << ",\"gpuMs\":" << frame.gpuMs;
+        if (kAllocationCounting) {
+            out << ",\"allocs\":" << frame.allocations
+                << ",\"allocBytes\":" << frame.allocatedBytes;
+        }
+        out << ",\"stages\":[";
+        for (size_t i = 0; i < frame.stages.size(); ++i) {
+            const StageTiming& s = frame.stages[i];
+            out << (i > 0 ? "," : "")
+                << "{\"name\":\"" << s.name << "\",\"depth\":" << s.depth
+                << ",\"calls\":" << s.calls << ",\"cpuMs\":" << s.cpuMs;
+            if (s.gpuMs >= 0.0) {
+                out << ",\"gpuMs\":" << s.gpuMs;
+            }
+            out << "}";
+        }
+        out << "]}\n";
+    } else {
+        out << frame.frameIndex << ",frame,0,1," << frame.cpuMs << "," << frame.gpuMs << "\n";
+        for (const StageTiming& s : frame.stages) {
+            out << frame.frameIndex << "," << s.name << "," << s.depth << "," << s.calls
+                << "," << s.cpuMs << ",";
+            if (s.gpuMs >= 0.0) {
+                out << s.gpuMs;
+            }
+            out << "\n";
+        }
+    }
+    out.flush();
+
+    logFile_.write(text.toUtf8());
+    if (logFile_.size() > kProfilerLogMaxBytes) {
+        rollLog();
+    }
+}
+
+void FrameProfiler::rollLog() {
+    // Keep one previous file: <path> -> <path>.1, then start <path> afresh
+    QString path = logFile_.fileName();
+    QString previous = path + ".1";
+    logFile_.close();
+    QFile::remove(previous);
+    QFile::rename(path, previous);
+    startLog(path);
+}
+
+} // namespace RS
@@ -0,0 +1,135 @@
+// FrameProfiler.h - Per-stage CPU and GPU frame timing (GL_TIMESTAMP queries)
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <array>
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+#include "Constants.h"
+#include "AllocationCounter.h"
+
+namespace RS {
+
+// Timing for one named stage, merged over every call in the frame (e.g. one
+// dispatch per ray tile). Depth is the nesting level of the first call.
+struct StageTiming {
+    const char* name = nullptr;
+    int depth = 0;
+    int calls = 0;
+    double cpuMs = 0.0;
+    double gpuMs = -1.0;  // -1 = CPU-only stage (no GPU work was timed)
+};
+
+struct FrameTiming {
+    uint64_t frameIndex = 0;
+    double cpuMs = 0.0;
+    double gpuMs = 0.0;
+    uint64_t allocations = 0;     // Heap allocations between beginFrame and endFrame
+    uint64_t allocatedBytes = 0;
+    std::vector<StageTiming> stages;
+};
+
+// Wraps frame stages in pairs of GL_TIMESTAMP queries. Query sets are
+// double-buffered: a frame's results are read kProfilerQuerySets frames later,
+// and only if the GPU has already finished them - the profiler never stalls.
+// All GL calls must happen with the owning context current.
+class FrameProfiler : protected QOpenGLFunctions_4_5_Core {
+public:
+    FrameProfiler() = default;
+    ~FrameProfiler() = default;
+
+    // Lifecycle
+    bool initialize();
+    void cleanup();
+
+    // Disabled profilers record nothing; stage calls are a single branch
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_ && initialized_; }
+
+    // Frame bracketing - resolves the oldest query set before reusing it
+    void beginFrame();
+    void endFrame();
+
+    // Stage names must be string literals (pointers are kept until resolved)
+    void beginStage(const char* name);
+    void endStage();
+
+    // Work timed elsewhere, e.g. the background BVH build
+    void addCpuStage(const char* name, double milliseconds);
+
+    // RAII stage guard; accepts a null profiler
+    class Scope {
+    public:
+        Scope(FrameProfiler* profiler, const char* name)
+            : profiler_(profiler && profiler->isEnabled() ? profiler : nullptr) {
+            if (profiler_) profiler_->beginStage(name);
+        }
+        ~Scope() { if (profiler_) profiler_->endStage(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        FrameProfiler* profiler_;
+    };
+
+    // Resolved results
+    const std::deque<FrameTiming>& getHistory() const { return history_; }
+    std::vector<StageTiming> getAveragedStages() const;  // Mean over the history window
+    int getDroppedFrames() const { return droppedFrames_; }
+    AllocationStats getAveragedAllocations() const;  // Per frame, mean over the history window
+
+    // Rolling log - one record per resolved frame. ".json"/".jsonl" paths are
+    // written as JSON lines, anything else as CSV. Files roll over to <path>.1
+    // once they pass kProfilerLogMaxBytes.
+    bool startLog(const QString& path);
+    void stopLog();
+    bool isLogging() const { return logFile_.isOpen(); }
+
+private:
+    struct StageRecord {
+        const char* name = nullptr;
+        int depth = 0;
+        qint64 cpuBeginNs = 0;
+        qint64 cpuEndNs = 0;
+        int beginQuery = -1;  // Index into QuerySet::queries (-1 = CPU only)
+        int endQuery = -1;
+        double cpuOnlyMs = -1.0;
+    };
+
+    struct QuerySet {
+        std::vector<GLuint> queries;  // Grows on demand, never shrinks
+        int usedQueries = 0;
+        std::vector<StageRecord> stages;
+        uint64_t frameIndex = 0;
+        qint64 cpuFrameNs = 0;
+        AllocationStats allocations;  // Snapshot at beginFrame, delta after endFrame
+        bool pending = false;         // Holds queries not yet resolved
+    };
+
+    int allocateQuery(QuerySet& set);
+    bool resolve(QuerySet& set);
+    void writeLog(const FrameTiming& frame);
+    void rollLog();
+
+    bool initialized_ = false;
+    bool enabled_ = false;
+    bool inFrame_ = false;
+
+    std::array<QuerySet, Constants::kProfilerQuerySets> querySets_;
+    int currentSet_ = 0;
+    uint64_t frameCounter_ = 0;
+    std::vector<int> stageStack_;     // Open stage indices in the current set
+    QElapsedTimer frameTimer_;
+
+    std::deque<FrameTiming> history_;
+    int droppedFrames_ = 0;
+
+    QFile logFile_;
+    bool logJson_ = false;
+};
+
+} // namespace RS
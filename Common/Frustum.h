@@ -0,0 +1,54 @@
+// Frustum.h - View frustum planes for culling bounding spheres before drawing
+#pragma once
+
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+#include <algorithm>
+#include <cmath>
+
+namespace RS {
+
+// The six clip planes of a projection * view (* model) matrix, normalized so
+// a plane's dot product with a point is its signed distance, positive inside.
+// Tests are conservative: a sphere near a frustum corner may pass though it
+// is outside, never the other way round.
+class Frustum {
+public:
+    explicit Frustum(const QMatrix4x4& clipFromSpace) {
+        const QVector4D rows[4] = {clipFromSpace.row(0), clipFromSpace.row(1),
+                                   clipFromSpace.row(2), clipFromSpace.row(3)};
+        for (int axis = 0; axis < 3; axis++) {
+            planes_[axis * 2] = normalized(rows[3] + rows[axis]);
+            planes_[axis * 2 + 1] = normalized(rows[3] - rows[axis]);
+        }
+    }
+
+    bool intersectsSphere(const QVector3D& center, float radius) const {
+        for (const QVector4D& plane : planes_) {
+            if (QVector3D::dotProduct(plane.toVector3D(), center) + plane.w() < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // A local-space bounding sphere placed by model, which may scale
+    bool intersectsSphere(const QMatrix4x4& model, const QVector3D& center, float radius) const {
+        float scale = 0.0f;
+        for (int i = 0; i < 3; i++) {
+            scale = std::max(scale, model.column(i).toVector3D().length());
+        }
+        return intersectsSphere(model.map(center), radius * scale);
+    }
+
+private:
+    static QVector4D normalized(const QVector4D& plane) {
+        float length = plane.toVector3D().length();
+        return length > 0.0f ? plane * (1.0f / length) : plane;
+    }
+
+    QVector4D planes_[6];
+};
+
+} // namespace RS
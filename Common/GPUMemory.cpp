@@ -0,0 +1,126 @@
+// GPUMemory.cpp - Process-wide accounting of GPU memory against a budget
+#include "GPUMemory.h"
+#include "Constants.h"
+#include "GLUtils.h"
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QDebug>
+#include <array>
+#include <atomic>
+
+namespace {
+
+constexpr int kPools = static_cast<int>(RS::GPUMemoryPool::Count);
+
+std::array<std::atomic<uint64_t>, kPools> poolBytes{};
+std::atomic<uint64_t> totalBytes{0};
+std::atomic<uint64_t> budget{0};
+
+// Extension enums, not in the core headers
+constexpr GLenum kGpuMemoryInfoDedicatedVidmemNVX = 0x9047;  // KB
+constexpr GLenum kTextureFreeMemoryATI = 0x87FC;             // KB, four values
+
+double megabytes(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+namespace RS {
+
+const char* gpuMemoryPoolName(GPUMemoryPool pool) {
+    switch (pool) {
+    case GPUMemoryPool::RCSRays:       return "RCS rays";
+    case GPUMemoryPool::RCSScene:      return "RCS scene";
+    case GPUMemoryPool::RCSResults:    return "RCS results";
+    case GPUMemoryPool::RCSTextures:   return "RCS textures";
+    case GPUMemoryPool::TargetMeshes:  return "Target meshes";
+    case GPUMemoryPool::Overlays:      return "Overlays";
+    case GPUMemoryPool::RenderTargets: return "Render targets";
+    case GPUMemoryPool::Count:         break;
+    }
+    return "Unknown";
+}
+
+namespace GPUMemory {
+
+uint64_t usedBytes() {
+    return totalBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t usedBytes(GPUMemoryPool pool) {
+    return poolBytes[static_cast<int>(pool)].load(std::memory_order_relaxed);
+}
+
+void setBudgetBytes(uint64_t bytes) {
+    budget.store(bytes, std::memory_order_relaxed);
+}
+
+uint64_t budgetBytes() {
+    return budget.load(std::memory_order_relaxed);
+}
+
+uint64_t detectBudgetBytes() {
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context) {
+        return 0;
+    }
+
+    GLint kilobytes[4] = {0, 0, 0, 0};
+    if (context->hasExtension("GL_NVX_gpu_memory_info")) {
+        context->functions()->glGetIntegerv(kGpuMemoryInfoDedicatedVidmemNVX, kilobytes);
+    } else if (context->hasExtension("GL_ATI_meminfo")) {
+        // Free texture memory at startup - the closest ATI_meminfo has to a total
+        context->functions()->glGetIntegerv(kTextureFreeMemoryATI, kilobytes);
+    }
+    if (kilobytes[0] <= 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(kilobytes[0] * 1024.0 * Constants::Defaults::kGPUMemoryBudgetFraction);
+}
+
+bool isOverBudget() {
+    uint64_t limit = budgetBytes();
+    return limit > 0 && usedBytes() > limit;
+}
+
+bool fits(uint64_t additionalBytes) {
+    uint64_t limit = budgetBytes();
+    return limit == 0 || usedBytes() + additionalBytes <= limit;
+}
+
+bool checkAllocation(const char* what) {
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context) {
+        return false;
+    }
+
+    bool failed = false;
+    for (GLenum error = context->functions()->glGetError(); error != GL_NO_ERROR;
+         error = context->functions()->glGetError()) {
+        if (error == GL_OUT_OF_MEMORY) {
+            qCritical().nospace() << "GPU out of memory allocating " << what << " ("
+                                  << megabytes(usedBytes()) << " MB tracked, budget "
+                                  << megabytes(budgetBytes()) << " MB)";
+        } else {
+            qWarning() << "OpenGL error allocating" << what << ":" << GLUtils::glErrorString(error);
+        }
+        failed = true;
+    }
+    return failed;
+}
+
+} // namespace GPUMemory
+
+void GPUAllocation::resize(uint64_t bytes) {
+    if (bytes == bytes_) {
+        return;
+    }
+    // Unsigned wrap-around makes the add a subtract when shrinking
+    uint64_t delta = bytes - bytes_;
+    poolBytes[static_cast<int>(pool_)].fetch_add(delta, std::memory_order_relaxed);
+    totalBytes.fetch_add(delta, std::memory_order_relaxed);
+    bytes_ = bytes;
+}
+
+} // namespace RS
@@ -0,0 +1,68 @@
+// GPUMemory.h - Process-wide accounting of GPU memory against a budget
+#pragma once
+
+#include <cstdint>
+
+namespace RS {
+
+// Components that report their GPU allocations
+enum class GPUMemoryPool {
+    RCSRays,        // Ray, hit-tile and bounce-queue buffers (one tile each)
+    RCSScene,       // BLAS nodes and triangles, TLAS, instances, materials, primitives
+    RCSResults,     // Readback ring, binning and clustering buffers
+    RCSTextures,    // Shadow map and beam pattern table
+    TargetMeshes,   // Target vertex, index (with LODs), edge and instance buffers
+    Overlays,       // Heat map and lobe geometry
+    RenderTargets,  // Scene, transparency and pop-out framebuffers
+    Count
+};
+
+const char* gpuMemoryPoolName(GPUMemoryPool pool);
+
+// Totals are kept with relaxed atomics, so owners on any thread (the RCS
+// compute thread included) report with GPUAllocation and the overlay reads a
+// snapshot without locking. The budget is advisory: nothing fails to
+// allocate, but owners of caches ask isOverBudget() or fits() at their own
+// safe points (with their context current) and drop what they can rebuild -
+// RCSCompute then packs only instanced BLASes, WireframeTarget drops its LODs.
+namespace GPUMemory {
+    uint64_t usedBytes();
+    uint64_t usedBytes(GPUMemoryPool pool);
+
+    // 0 = no limit
+    void setBudgetBytes(uint64_t bytes);
+    uint64_t budgetBytes();
+
+    // kGPUMemoryBudgetFraction of the dedicated VRAM reported by
+    // GL_NVX_gpu_memory_info or GL_ATI_meminfo; 0 if neither is available.
+    // Needs a current context.
+    uint64_t detectBudgetBytes();
+
+    bool isOverBudget();
+    // Whether growing by additionalBytes keeps the total within the budget
+    bool fits(uint64_t additionalBytes);
+
+    // Drains the GL error queue after an allocation; GL_OUT_OF_MEMORY is
+    // reported with the current usage. Returns true if an error was pending.
+    bool checkAllocation(const char* what);
+}
+
+// One owner's share of a pool. resize() replaces the recorded size; the
+// destructor (or release()) returns it.
+class GPUAllocation {
+public:
+    explicit GPUAllocation(GPUMemoryPool pool) : pool_(pool) {}
+    ~GPUAllocation() { release(); }
+    GPUAllocation(const GPUAllocation&) = delete;
+    GPUAllocation& operator=(const GPUAllocation&) = delete;
+
+    void resize(uint64_t bytes);
+    void release() { resize(0); }
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    GPUMemoryPool pool_;
+    uint64_t bytes_ = 0;
+};
+
+} // namespace RS
@@ -0,0 +1,39 @@
+// ParallelChunks.h - Split a range into contiguous chunks run on std::async workers
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace RS {
+
+// One chunk per hardware thread, but none smaller than minPerChunk items,
+// so small inputs stay on the calling thread
+inline int parallelChunkCount(size_t count, size_t minPerChunk) {
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t byWork = count / std::max<size_t>(minPerChunk, 1);
+    return static_cast<int>(std::max<size_t>(1, std::min(threads, byWork)));
+}
+
+// Runs body(chunk, begin, end) over [0, count) in chunks contiguous ranges.
+// Chunk 0 runs on the calling thread; returns once all are done. Callers
+// give each chunk its own partial output and merge them afterwards.
+template <typename Body>
+void runChunks(int chunks, size_t count, const Body& body) {
+    chunks = std::max(chunks, 1);
+    auto range = [&](int c) {
+        body(c, count * c / chunks, count * (c + 1) / chunks);
+    };
+    std::vector<std::future<void>> tasks;
+    for (int c = 1; c < chunks; ++c) {
+        tasks.push_back(std::async(std::launch::async, range, c));
+    }
+    range(0);
+    for (auto& task : tasks) {
+        task.get();
+    }
+}
+
+} // namespace RS
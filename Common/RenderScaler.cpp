@@ -0,0 +1,154 @@
+// RenderScaler.cpp - Trades scene resolution and MSAA for GPU time during interaction
+#include "RenderScaler.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace RS {
+
+using namespace Constants;
+
+bool RenderScaler::initialize() {
+    if (initialized_) {
+        return true;
+    }
+    if (!initializeOpenGLFunctions()) {
+        qWarning() << "RenderScaler: failed to initialize OpenGL functions";
+        return false;
+    }
+
+    GLint counterBits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+    if (counterBits == 0) {
+        qWarning() << "RenderScaler: GL_TIMESTAMP not supported - render scaling disabled";
+        return false;
+    }
+
+    for (Sample& sample : samples_) {
+        glGenQueries(1, &sample.begin);
+        glGenQueries(1, &sample.end);
+        sample.pending = false;
+    }
+    initialized_ = true;
+    return true;
+}
+
+void RenderScaler::cleanup() {
+    if (initialized_) {
+        for (Sample& sample : samples_) {
+            glDeleteQueries(1, &sample.begin);
+            glDeleteQueries(1, &sample.end);
+        }
+    }
+    samples_.fill(Sample());
+    active_ = -1;
+    scale_ = 1.0f;
+    multisample_ = true;
+    rasterCostMs_ = -1.0;
+    initialized_ = false;
+}
+
+void RenderScaler::noteInput() {
+    lastInput_.restart();
+}
+
+bool RenderScaler::isInteracting() const {
+    return lastInput_.isValid() && lastInput_.elapsed() < kRCSIdleDelayMs;
+}
+
+void RenderScaler::update() {
+    collect();
+
+    if (!initialized_ || !isInteracting()) {
+        setQuality(1.0f, true);
+        return;
+    }
+
+    // Wait for a measurement of the current setting before the next step
+    if (rasterCostMs_ < 0.0) {
+        return;
+    }
+
+    if (rasterCostMs_ > View::kRasterBudgetMs) {
+        if (multisample_) {
+            setQuality(scale_, false);
+        } else if (scale_ > View::kMinRenderScale) {
+            setQuality(std::max(scale_ - View::kRenderScaleStep, View::kMinRenderScale), false);
+        }
+    } else if (rasterCostMs_ < View::kRasterBudgetMs * View::kRenderScaleHeadroom) {
+        if (scale_ < 1.0f) {
+            setQuality(std::min(scale_ + View::kRenderScaleStep, 1.0f), false);
+        } else if (!multisample_) {
+            setQuality(1.0f, true);
+        }
+    }
+}
+
+void RenderScaler::setQuality(float scale, bool multisample) {
+    if (scale == scale_ && multisample == multisample_) {
+        return;
+    }
+    scale_ = scale;
+    multisample_ = multisample;
+
+    // Frames still in flight measured the old setting
+    generation_++;
+    rasterCostMs_ = -1.0;
+}
+
+void RenderScaler::beginFrame() {
+    if (!initialized_ || active_ >= 0) {
+        return;
+    }
+
+    // All queries in flight - skip this sample rather than wait for one
+    if (samples_[next_].pending) {
+        return;
+    }
+
+    active_ = next_;
+    next_ = (next_ + 1) % kQueries;
+    samples_[active_].generation = generation_;
+    glQueryCounter(samples_[active_].begin, GL_TIMESTAMP);
+}
+
+void RenderScaler::endFrame() {
+    if (active_ < 0) {
+        return;
+    }
+    glQueryCounter(samples_[active_].end, GL_TIMESTAMP);
+    samples_[active_].pending = true;
+    active_ = -1;
+}
+
+void RenderScaler::collect() {
+    if (!initialized_) {
+        return;
+    }
+
+    for (Sample& sample : samples_) {
+        if (!sample.pending) {
+            continue;
+        }
+        GLuint available = 0;
+        glGetQueryObjectuiv(sample.end, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+
+        GLuint64 beginNs = 0;
+        GLuint64 endNs = 0;
+        glGetQueryObjectui64v(sample.begin, GL_QUERY_RESULT, &beginNs);
+        glGetQueryObjectui64v(sample.end, GL_QUERY_RESULT, &endNs);
+        sample.pending = false;
+        if (sample.generation != generation_ || endNs < beginNs) {
+            continue;
+        }
+
+        double milliseconds = static_cast<double>(endNs - beginNs) / 1.0e6;
+        rasterCostMs_ = rasterCostMs_ < 0.0
+            ? milliseconds
+            : rasterCostMs_ + kCostSmoothing * (milliseconds - rasterCostMs_);
+    }
+}
+
+} // namespace RS
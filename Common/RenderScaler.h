@@ -0,0 +1,76 @@
+// RenderScaler.h - Trades scene resolution and MSAA for GPU time during interaction
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QElapsedTimer>
+#include <array>
+
+#include "Constants.h"
+
+namespace RS {
+
+// While the camera or a control is dragged, a large canvas with 4x MSAA can
+// cost more GPU time than the frame has. The scaler measures the scene raster
+// (SceneTarget bind to present) with GL_TIMESTAMP pairs and steps quality
+// down while the smoothed cost is over kRasterBudgetMs: multisampling goes
+// first, then the resolution drops in kRenderScaleStep steps down to
+// kMinRenderScale. Under kRenderScaleHeadroom of the budget it steps back up
+// in the opposite order. Once input has been idle for kRCSIdleDelayMs the
+// next frame draws at full quality, so a settled view is never degraded.
+// All GL calls must happen with the owning context current.
+class RenderScaler : protected QOpenGLFunctions_4_5_Core {
+public:
+    RenderScaler() = default;
+    ~RenderScaler() = default;
+
+    // Lifecycle. Without GPU timestamps the scaler stays at full quality.
+    bool initialize();
+    void cleanup();
+
+    // Record that the view or a scene input changed this frame
+    void noteInput();
+    bool isInteracting() const;
+
+    // Called once per paint before the scene is bound; picks this frame's
+    // scale() and multisample() from the results collected so far
+    void update();
+
+    float scale() const { return scale_; }
+    bool multisample() const { return multisample_; }
+
+    // Bracket the scene raster. Results are collected on later frames, and
+    // only once the GPU has them - the scaler never stalls.
+    void beginFrame();
+    void endFrame();
+
+    // Smoothed GPU cost of the scene at the current quality (-1 until the
+    // first result since the last change arrives)
+    double rasterCostMs() const { return rasterCostMs_; }
+
+private:
+    void collect();
+    void setQuality(float scale, bool multisample);
+
+    struct Sample {
+        GLuint begin = 0;
+        GLuint end = 0;
+        bool pending = false;
+        int generation = 0;  // Quality setting the frame was drawn with
+    };
+
+    static constexpr int kQueries = 3;
+    static constexpr double kCostSmoothing = 0.25;  // EMA weight of the newest sample
+
+    bool initialized_ = false;
+    std::array<Sample, kQueries> samples_{};
+    int next_ = 0;
+    int active_ = -1;  // Sample open between beginFrame() and endFrame()
+
+    float scale_ = 1.0f;
+    bool multisample_ = true;
+    int generation_ = 0;
+    double rasterCostMs_ = -1.0;
+    QElapsedTimer lastInput_;
+};
+
+} // namespace RS
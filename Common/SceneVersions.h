@@ -0,0 +1,115 @@
+// SceneVersions.h - Per-input scene versions and the stage stamps keyed on them
+#pragma once
+
+#include <array>
+#include <initializer_list>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace RS {
+
+// Inputs a pipeline stage's output can depend on. The camera is deliberately
+// not one of them - a pure view change never invalidates a stage.
+enum class SceneInput {
+    RadarPosition,
+    BeamParams,       // Beam type and width
+    TargetGeometry,   // Mesh contents and its BVH
+    TargetTransform,  // Instance matrices
+    RayCount,
+    CutParams,        // Polar/heat map slices and which results are requested
+    Receivers,        // Bistatic receiver sites
+    Count
+};
+
+// One monotonically increasing version per input. Inputs are either bumped
+// explicitly or observed: observe() hashes the value and bumps the version
+// only when it differs from the last observed value, so callers can feed the
+// current state every frame without tracking changes themselves.
+class SceneVersions {
+public:
+    void bump(SceneInput input) { ++entry(input).version; }
+
+    uint64_t version(SceneInput input) const {
+        return entries_[static_cast<size_t>(input)].version;
+    }
+
+    // Returns true if the input changed (and its version was bumped)
+    bool observe(SceneInput input, const void* data, size_t bytes) {
+        Entry& e = entry(input);
+        uint64_t hash = hashBytes(data, bytes);
+        if (e.observed && e.hash == hash) {
+            return false;
+        }
+        e.hash = hash;
+        e.observed = true;
+        ++e.version;
+        return true;
+    }
+
+    template<typename T>
+    bool observe(SceneInput input, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "observe() hashes the object representation");
+        return observe(input, &value, sizeof(T));
+    }
+
+private:
+    struct Entry {
+        uint64_t version = 0;
+        uint64_t hash = 0;
+        bool observed = false;
+    };
+
+    Entry& entry(SceneInput input) { return entries_[static_cast<size_t>(input)]; }
+
+    // FNV-1a
+    static uint64_t hashBytes(const void* data, size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < bytes; ++i) {
+            hash = (hash ^ p[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::array<Entry, static_cast<size_t>(SceneInput::Count)> entries_{};
+};
+
+// The input versions a stage's cached output was produced from. A stage
+// reruns only when !isCurrent() and calls update() once its output is valid.
+class StageStamp {
+public:
+    StageStamp(std::initializer_list<SceneInput> dependencies) {
+        for (SceneInput input : dependencies) {
+            mask_ |= 1u << static_cast<unsigned>(input);
+        }
+    }
+
+    bool isCurrent(const SceneVersions& scene) const {
+        if (!valid_) {
+            return false;
+        }
+        for (size_t i = 0; i < seen_.size(); ++i) {
+            if ((mask_ & (1u << i)) && seen_[i] != scene.version(static_cast<SceneInput>(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void update(const SceneVersions& scene) {
+        for (size_t i = 0; i < seen_.size(); ++i) {
+            seen_[i] = scene.version(static_cast<SceneInput>(i));
+        }
+        valid_ = true;
+    }
+
+    void invalidate() { valid_ = false; }
+
+private:
+    unsigned mask_ = 0;
+    std::array<uint64_t, static_cast<size_t>(SceneInput::Count)> seen_{};
+    bool valid_ = false;
+};
+
+} // namespace RS
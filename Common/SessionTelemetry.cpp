@@ -0,0 +1,174 @@
+// SessionTelemetry.cpp - Rolling frame and pipeline-stage percentiles for long sessions
+#include "SessionTelemetry.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace RS {
+
+using namespace Constants;
+
+namespace {
+
+struct MetricInfo {
+    const char* name;
+    double minValue;
+    double maxValue;
+    bool logScale;
+};
+
+// Indexed by TelemetryMetric
+constexpr MetricInfo kMetrics[] = {
+    {"frame_ms", 1.0e-3, 1.0e5, true},
+    {"compute_ms", 1.0e-3, 1.0e5, true},
+    {"readback_ms", 1.0e-3, 1.0e5, true},
+    {"hit_count", 1.0, 1.0e8, true},
+    {"occlusion_ratio", 0.0, 1.0, false},
+};
+static_assert(sizeof(kMetrics) / sizeof(kMetrics[0]) == static_cast<size_t>(TelemetryMetric::Count),
+              "kMetrics must list every TelemetryMetric");
+
+} // namespace
+
+void TelemetryHistogram::configure(double minValue, double maxValue, bool logScale) {
+    logScale_ = logScale;
+    minValue_ = logScale ? std::log10(minValue) : minValue;
+    maxValue_ = logScale ? std::log10(maxValue) : maxValue;
+    bucketsPerUnit_ = kTelemetryBuckets / (maxValue_ - minValue_);
+    reset();
+}
+
+void TelemetryHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int TelemetryHistogram::bucketFor(double value) const {
+    if (logScale_) {
+        // Zero and below share the first bucket with the smallest values
+        value = value > 0.0 ? std::log10(value) : minValue_;
+    }
+    double position = (value - minValue_) * bucketsPerUnit_;
+    if (!(position > 0.0)) {
+        return 0;  // Also catches NaN
+    }
+    return std::min(static_cast<int>(position), kTelemetryBuckets - 1);
+}
+
+double TelemetryHistogram::bucketValue(int bucket) const {
+    double centre = minValue_ + (bucket + 0.5) / bucketsPerUnit_;
+    return logScale_ ? std::pow(10.0, centre) : centre;
+}
+
+void TelemetryHistogram::accumulate(std::array<uint64_t, kTelemetryBuckets>& counts) const {
+    for (int i = 0; i < kTelemetryBuckets; ++i) {
+        counts[i] += buckets_[i].load(std::memory_order_relaxed);
+    }
+}
+
+SessionTelemetry::SessionTelemetry() {
+    for (Slot& slot : slots_) {
+        for (int metric = 0; metric < kMetricCount; ++metric) {
+            slot[metric].configure(kMetrics[metric].minValue, kMetrics[metric].maxValue, kMetrics[metric].logScale);
+        }
+    }
+    sessionTimer_.start();
+}
+
+void SessionTelemetry::record(TelemetryMetric metric, double value) {
+    int index = static_cast<int>(metric);
+    slots_[currentSlot_.load(std::memory_order_relaxed)][index].record(value);
+    sessionSamples_[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void SessionTelemetry::advanceWindow() {
+    // The slot being cleared is the oldest; a writer still holding the index it
+    // read before the switch writes into the previous slot, which stays in the window
+    int next = (currentSlot_.load(std::memory_order_relaxed) + 1) % kTelemetryWindowSlots;
+    for (TelemetryHistogram& histogram : slots_[next]) {
+        histogram.reset();
+    }
+    currentSlot_.store(next, std::memory_order_relaxed);
+}
+
+TelemetrySummary SessionTelemetry::summarize(TelemetryMetric metric) const {
+    int index = static_cast<int>(metric);
+    std::array<uint64_t, kTelemetryBuckets> counts{};
+    for (const Slot& slot : slots_) {
+        slot[index].accumulate(counts);
+    }
+
+    TelemetrySummary summary;
+    for (uint64_t count : counts) {
+        summary.samples += count;
+    }
+    if (summary.samples == 0) {
+        return summary;
+    }
+
+    // Smallest bucket whose cumulative count reaches each rank
+    const double fractions[3] = {0.50, 0.95, 0.99};
+    double* values[3] = {&summary.p50, &summary.p95, &summary.p99};
+    const TelemetryHistogram& layout = slots_[0][index];
+    uint64_t cumulative = 0;
+    int next = 0;
+    for (int bucket = 0; bucket < kTelemetryBuckets && next < 3; ++bucket) {
+        cumulative += counts[bucket];
+        while (next < 3 && cumulative >= static_cast<uint64_t>(std::ceil(fractions[next] * summary.samples))) {
+            *values[next++] = layout.bucketValue(bucket);
+        }
+    }
+    return summary;
+}
+
+uint64_t SessionTelemetry::sessionSamples(TelemetryMetric metric) const {
+    return sessionSamples_[static_cast<int>(metric)].load(std::memory_order_relaxed);
+}
+
+bool SessionTelemetry::writeJson(const QString& path) const {
+    QJsonObject metrics;
+    for (int metric = 0; metric < kMetricCount; ++metric) {
+        TelemetrySummary summary = summarize(static_cast<TelemetryMetric>(metric));
+        QJsonObject entry;
+        entry["samples"] = static_cast<qint64>(summary.samples);
+        entry["sessionSamples"] = static_cast<qint64>(sessionSamples(static_cast<TelemetryMetric>(metric)));
+        entry["p50"] = summary.p50;
+        entry["p95"] = summary.p95;
+        entry["p99"] = summary.p99;
+        metrics[kMetrics[metric].name] = entry;
+    }
+
+    QJsonObject root;
+    root["format"] = 1;
+    root["written"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["sessionSeconds"] = sessionTimer_.elapsed() / 1000.0;
+    root["windowSeconds"] = kTelemetryWindowSlots * kTelemetryDumpIntervalMs / 1000.0;
+    root["metrics"] = metrics;
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "SessionTelemetry: Cannot open" << path << ":" << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qWarning() << "SessionTelemetry: Cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QString SessionTelemetry::defaultPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/telemetry.json";
+}
+
+} // namespace RS
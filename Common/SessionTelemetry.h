@@ -0,0 +1,91 @@
+// SessionTelemetry.h - Rolling frame and pipeline-stage percentiles for long sessions
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "Constants.h"
+
+namespace RS {
+
+enum class TelemetryMetric {
+    FrameMs,         // CPU time of one paintGL
+    ComputeMs,       // RCSCompute::compute without its readback
+    ReadbackMs,      // Readback wait and hit copy of a traced frame
+    HitCount,        // Rays that hit the target per trace
+    OcclusionRatio,  // Hit fraction of the traced rays
+    Count
+};
+
+struct TelemetrySummary {
+    uint64_t samples = 0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+};
+
+// Fixed-bucket histogram over [minValue, maxValue], log- or linearly spaced;
+// values outside land in the first or last bucket. record() is one relaxed
+// atomic increment, so any thread may call it without a lock. Percentiles are
+// reported at the bucket centre: with kTelemetryBuckets log buckets over eight
+// decades that is within about 7% of the exact value.
+class TelemetryHistogram {
+public:
+    void configure(double minValue, double maxValue, bool logScale);
+
+    void record(double value) {
+        buckets_[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+    void reset();
+
+    // Adds the bucket counts to counts
+    void accumulate(std::array<uint64_t, Constants::kTelemetryBuckets>& counts) const;
+    double bucketValue(int bucket) const;
+
+private:
+    int bucketFor(double value) const;
+
+    std::array<std::atomic<uint64_t>, Constants::kTelemetryBuckets> buckets_{};
+    double minValue_ = 0.0;
+    double maxValue_ = 1.0;
+    double bucketsPerUnit_ = 1.0;  // Per log10 unit when logScale_
+    bool logScale_ = false;
+};
+
+// Percentiles of the last kTelemetryWindowSlots dump intervals. Each metric
+// has one histogram per slot; advanceWindow() clears the oldest slot and makes
+// it current, so the window rolls without copying or locking. Recording is
+// cheap enough to stay on for every frame of a session.
+class SessionTelemetry {
+public:
+    SessionTelemetry();
+
+    void record(TelemetryMetric metric, double value);
+
+    // Starts the next slot, dropping the oldest one from the window
+    void advanceWindow();
+
+    TelemetrySummary summarize(TelemetryMetric metric) const;
+    uint64_t sessionSamples(TelemetryMetric metric) const;
+
+    // Writes the window summaries as JSON. The file is replaced atomically,
+    // so a tool polling it never reads half a dump.
+    bool writeJson(const QString& path) const;
+
+    // telemetry.json in the application data directory, next to last_session.json
+    static QString defaultPath();
+
+private:
+    static constexpr int kMetricCount = static_cast<int>(TelemetryMetric::Count);
+    using Slot = std::array<TelemetryHistogram, kMetricCount>;
+
+    std::array<Slot, Constants::kTelemetryWindowSlots> slots_;
+    std::atomic<int> currentSlot_{0};
+    std::array<std::atomic<uint64_t>, kMetricCount> sessionSamples_{};
+    QElapsedTimer sessionTimer_;
+};
+
+} // namespace RS
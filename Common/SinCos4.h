@@ -0,0 +1,74 @@
+// SinCos4.h - Four float sin/cos pairs at once with SSE2, for phasor sums
+#pragma once
+
+#include <cmath>
+
+// SSE2 is the x86-64 baseline, so this needs no extra compiler flags there
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RS_SINCOS4_SSE 1
+#endif
+
+namespace RS {
+
+namespace SinCos4Detail {
+// Taylor terms on [-pi/4, pi/4], accurate to float precision
+constexpr float kSin3 = -1.0f / 6.0f;
+constexpr float kSin5 = 1.0f / 120.0f;
+constexpr float kSin7 = -1.0f / 5040.0f;
+constexpr float kCos2 = -0.5f;
+constexpr float kCos4 = 1.0f / 24.0f;
+constexpr float kCos6 = -1.0f / 720.0f;
+constexpr float kCos8 = 1.0f / 40320.0f;
+constexpr float kTwoOverPi = 0.636619772f;
+constexpr float kHalfPiHi = 1.5703125f;          // pi/2 split for exact reduction
+constexpr float kHalfPiLo = 4.83826794896e-4f;
+} // namespace SinCos4Detail
+
+constexpr int kSinCosLanes = 4;
+
+// Four sin/cos pairs: quadrant reduction, then the polynomials on the
+// remainder. Keep |x| within a few thousand radians; past that the float
+// reduction loses the phase.
+#ifdef RS_SINCOS4_SSE
+inline void sinCos4(const float* x, float* s, float* c) {
+    using namespace SinCos4Detail;
+    __m128 v = _mm_loadu_ps(x);
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(kTwoOverPi)));
+    __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 r = _mm_sub_ps(_mm_sub_ps(v, _mm_mul_ps(q, _mm_set1_ps(kHalfPiHi))),
+                          _mm_mul_ps(q, _mm_set1_ps(kHalfPiLo)));
+    __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 sinR = _mm_add_ps(_mm_set1_ps(kSin5), _mm_mul_ps(r2, _mm_set1_ps(kSin7)));
+    sinR = _mm_add_ps(_mm_set1_ps(kSin3), _mm_mul_ps(r2, sinR));
+    sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), sinR));
+
+    __m128 cosR = _mm_add_ps(_mm_set1_ps(kCos6), _mm_mul_ps(r2, _mm_set1_ps(kCos8)));
+    cosR = _mm_add_ps(_mm_set1_ps(kCos4), _mm_mul_ps(r2, cosR));
+    cosR = _mm_add_ps(_mm_set1_ps(kCos2), _mm_mul_ps(r2, cosR));
+    cosR = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, cosR));
+
+    // Odd quadrants swap sin and cos; quadrants 1, 2 negate cos and 2, 3 negate sin
+    __m128i q1 = _mm_and_si128(quadrant, _mm_set1_epi32(1));
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(q1, _mm_set1_epi32(1)));
+    __m128 sinV = _mm_or_ps(_mm_and_ps(swap, cosR), _mm_andnot_ps(swap, sinR));
+    __m128 cosV = _mm_or_ps(_mm_and_ps(swap, sinR), _mm_andnot_ps(swap, cosR));
+
+    __m128i q2 = _mm_and_si128(quadrant, _mm_set1_epi32(2));
+    __m128i q12 = _mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2));
+    __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(q2, 30));   // Bit 1 -> sign bit
+    __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(q12, 30));
+    _mm_storeu_ps(s, _mm_xor_ps(sinV, sinSign));
+    _mm_storeu_ps(c, _mm_xor_ps(cosV, cosSign));
+}
+#else
+inline void sinCos4(const float* x, float* s, float* c) {
+    for (int i = 0; i < kSinCosLanes; ++i) {
+        s[i] = std::sin(x[i]);
+        c[i] = std::cos(x[i]);
+    }
+}
+#endif
+
+} // namespace RS
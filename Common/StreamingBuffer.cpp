@@ -0,0 +1,129 @@
+// StreamingBuffer.cpp - Persistent-mapped ring for per-frame dynamic vertex and index data
+#include "StreamingBuffer.h"
+#include "GLUtils.h"
+#include "Constants.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+
+using namespace RS::Constants;
+
+namespace RS {
+
+bool StreamingBuffer::initialize(const char* name, size_t regionBytes) {
+    if (initialized_) {
+        return true;
+    }
+    name_ = name;
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << name_ << "- No OpenGL context for the stream buffer";
+        return false;
+    }
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << name_ << "- Failed to initialize OpenGL functions for the stream buffer";
+        return false;
+    }
+
+    initialized_ = createBuffer(std::max<size_t>(regionBytes, 256));
+    return initialized_;
+}
+
+void StreamingBuffer::cleanup() {
+    if (initialized_ && QOpenGLContext::currentContext()) {
+        destroyBuffer();
+    }
+    initialized_ = false;
+}
+
+bool StreamingBuffer::createBuffer(size_t regionBytes) {
+    // Regions start on 256 bytes so every allocation alignment up to that holds
+    regionBytes = (regionBytes + 255) & ~static_cast<size_t>(255);
+    const GLsizeiptr totalBytes = static_cast<GLsizeiptr>(regionBytes * kRegions);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, flags);
+    mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalBytes, flags));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (!mapped_) {
+        qWarning() << name_ << "- Failed to map stream buffer of" << totalBytes << "bytes";
+        destroyBuffer();
+        return false;
+    }
+    regionCapacity_ = regionBytes;
+    regionUsed_ = 0;
+    region_ = 0;
+    gpuMemory_.resize(static_cast<uint64_t>(totalBytes));
+    return true;
+}
+
+void StreamingBuffer::destroyBuffer() {
+    for (auto& fence : fences_) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (buffer_ != 0) {
+        glDeleteBuffers(1, &buffer_);  // Implicitly unmaps; draws in flight keep their storage
+        buffer_ = 0;
+    }
+    mapped_ = nullptr;
+    regionCapacity_ = 0;
+    regionUsed_ = 0;
+    gpuMemory_.release();
+}
+
+bool StreamingBuffer::beginRegion(size_t bytes) {
+    if (!initialized_) {
+        return false;
+    }
+
+    // Grow geometrically; the old storage is released once its draws retire
+    if (bytes > regionCapacity_ || !mapped_) {
+        size_t capacity = std::max(bytes, regionCapacity_ * 2);
+        destroyBuffer();
+        if (!createBuffer(capacity)) {
+            return false;
+        }
+    }
+
+    // Move to the next region and make sure the GPU is done reading it
+    region_ = (region_ + 1) % kRegions;
+    GLsync& fence = fences_[region_];
+    if (fence) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kReadbackWaitTimeoutNs);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+    regionUsed_ = 0;
+    return true;
+}
+
+StreamingBuffer::Allocation StreamingBuffer::allocate(size_t bytes, size_t alignment) {
+    Allocation allocation;
+    size_t start = (regionUsed_ + alignment - 1) & ~(alignment - 1);
+    if (!mapped_ || start + bytes > regionCapacity_) {
+        return allocation;
+    }
+    regionUsed_ = start + bytes;
+    allocation.offset = static_cast<GLintptr>(static_cast<size_t>(region_) * regionCapacity_ + start);
+    allocation.data = mapped_ + allocation.offset;
+    return allocation;
+}
+
+void StreamingBuffer::fence() {
+    if (!mapped_) {
+        return;
+    }
+    GLsync& fence = fences_[region_];
+    if (fence) {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+} // namespace RS
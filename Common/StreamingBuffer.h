@@ -0,0 +1,72 @@
+// StreamingBuffer.h - Persistent-mapped ring for per-frame dynamic vertex and index data
+//
+// One GL buffer split into kRegions equal regions, mapped once for the life of
+// the buffer. Each upload starts the next region, waits on the fence left by
+// the draws that last read it, and sub-allocates as many blocks from it as the
+// frame needs (vertices and indices side by side, say). Steady-state frames
+// never reallocate or orphan, so the driver has nothing to copy or sync
+// behind the frame; a region only grows when a frame outgrows it.
+//
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <array>
+#include <cstddef>
+
+#include "GPUMemory.h"
+
+namespace RS {
+
+class StreamingBuffer : protected QOpenGLFunctions_4_5_Core {
+public:
+    static constexpr int kRegions = 3;  // Frames in flight
+
+    struct Allocation {
+        void* data = nullptr;  // Write-only, coherent
+        GLintptr offset = 0;   // Into buffer(), for attribute pointers and draw offsets
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    StreamingBuffer() = default;
+    ~StreamingBuffer() = default;  // cleanup() with the context current releases the buffer
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    // name prefixes warnings. regionBytes is the initial size of each region.
+    bool initialize(const char* name, size_t regionBytes);
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Moves to the next region with room for at least bytes, waiting until the
+    // GPU is done with it. A larger request replaces the buffer: buffer()
+    // changes and earlier offsets are void. False if the buffer cannot be mapped.
+    bool beginRegion(size_t bytes);
+
+    // Carves bytes out of the current region; alignment must be a power of two.
+    // Empty when the region is full.
+    Allocation allocate(size_t bytes, size_t alignment = 16);
+
+    // Fences the current region after the draws that read it. Call after
+    // every draw from the region; the newest fence replaces the older one.
+    void fence();
+
+    GLuint buffer() const { return buffer_; }
+    size_t regionCapacity() const { return regionCapacity_; }
+
+private:
+    bool createBuffer(size_t regionBytes);
+    void destroyBuffer();
+
+    const char* name_ = "StreamingBuffer";
+    bool initialized_ = false;
+    GLuint buffer_ = 0;
+    unsigned char* mapped_ = nullptr;
+    size_t regionCapacity_ = 0;  // Bytes per region
+    size_t regionUsed_ = 0;      // Bytes allocated from the current region
+    int region_ = 0;             // Region the last beginRegion() started
+    std::array<GLsync, kRegions> fences_{};
+    GPUAllocation gpuMemory_{GPUMemoryPool::Overlays};  // Every stream feeds an overlay
+};
+
+} // namespace RS
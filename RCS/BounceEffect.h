@@ -3,8 +3,10 @@
 // This interface allows different physics effects to be applied to ray bounces.
 // Each effect is a separate class that can be added/removed/tested independently.
 //
+// Effects with a shaderSource() also run on the GPU: RCSCompute compiles the
+// enabled ones, in pipeline order, into the trace kernels' per-hit chain.
+//
 // Future effects can include:
-// - MaterialReflectivity: Intensity loss based on material properties
 // - AtmosphericAttenuation: Distance-based intensity decay
 // - TurbulenceScatter: Random perturbation of reflection direction
 // - TemperatureGradient: Ray bending due to temperature variations
@@ -12,11 +14,7 @@
 #pragma once
 
 #include "RayTraceTypes.h"
-
-// Forward declare HitResult from RCSTypes.h
-namespace RCS {
-struct HitResult;
-}
+#include <vector>
 
 namespace RCS {
 
@@ -30,9 +28,21 @@ public:
     // @param hit: The hit result that triggered this bounce
     virtual void apply(BounceState& state, const HitResult& hit) = 0;
 
+    // Apply this effect to every ray of a batch - one virtual call per batch.
+    // The default forwards each element to apply(); effects override it with
+    // a loop over the arrays they touch.
+    virtual void applyBatch(BounceBatch& batch);
+
     // Get the name of this effect (for debugging/UI)
     virtual const char* name() const = 0;
 
+    // GPU port: one line of GLSL run per hit with `inout float weight` (the
+    // path weight), `HitResult hit`, `Material material`, `uint bounce` (0 for
+    // the primary hit) and this effect's `vec4 params` in scope. No newlines
+    // or // comments - it is spliced into a #define. Null: CPU only.
+    virtual const char* shaderSource() const { return nullptr; }
+    virtual void shaderParameters(float params[4]) const { (void)params; }
+
     // Enable/disable this effect
     void setEnabled(bool enabled) { enabled_ = enabled; }
     bool isEnabled() const { return enabled_; }
@@ -49,14 +59,47 @@ public:
         : decayFactor_(decayFactor), minIntensity_(minIntensity) {}
 
     void apply(BounceState& state, const HitResult& hit) override;
+    void applyBatch(BounceBatch& batch) override;
     const char* name() const override { return "Intensity Decay"; }
 
+    // The GPU path seeds its weight from the beam pattern, so the decay
+    // starts with the first further bounce
+    const char* shaderSource() const override {
+        return "if (bounce > 0u) weight = max(weight * (1.0 - params.x), params.y);";
+    }
+    void shaderParameters(float params[4]) const override {
+        params[0] = decayFactor_;
+        params[1] = minIntensity_;
+    }
+
     void setDecayFactor(float factor) { decayFactor_ = factor; }
     void setMinIntensity(float min) { minIntensity_ = min; }
+    float getDecayFactor() const { return decayFactor_; }
+    float getMinIntensity() const { return minIntensity_; }
 
 private:
     float decayFactor_;   // How much intensity is lost per bounce (0-1)
     float minIntensity_;  // Floor intensity (never goes below this)
 };
 
+// Material reflectivity and radar-absorbent coating of the surface hit. The
+// GPU reads the material from RCSCompute's table; the CPU side uses its own
+// copy of the same table (setMaterials). Unknown IDs use the default material.
+class MaterialEffect : public BounceEffect {
+public:
+    void apply(BounceState& state, const HitResult& hit) override;
+    void applyBatch(BounceBatch& batch) override;
+    const char* name() const override { return "Material"; }
+
+    const char* shaderSource() const override {
+        return "weight *= material.reflectivity * (1.0 - material.absorption);";
+    }
+
+    void setMaterials(const std::vector<Material>& materials) { materials_ = materials; }
+    const std::vector<Material>& getMaterials() const { return materials_; }
+
+private:
+    std::vector<Material> materials_;
+};
+
 } // namespace RCS
@@ -1,5 +1,6 @@
 // BounceEffectPipeline.cpp - Implementation
 #include "BounceEffectPipeline.h"
+#include <algorithm>
 #include <cstring>
 
 // Include full HitResult definition
@@ -7,16 +8,63 @@
 
 namespace RCS {
 
+// BounceEffect implementation
+void BounceEffect::applyBatch(BounceBatch& batch) {
+    for (size_t i = 0; i < batch.count; ++i) {
+        BounceState state = batch.state(i);
+        apply(state, batch.hits[i]);
+        batch.setState(i, state);
+    }
+}
+
 // IntensityDecayEffect implementation
 void IntensityDecayEffect::apply(BounceState& state, const HitResult& /*hit*/) {
     if (!enabled_) return;
     state.applyBounceDecay(decayFactor_, minIntensity_);
 }
 
+void IntensityDecayEffect::applyBatch(BounceBatch& batch) {
+    if (!enabled_) return;
+    // Branch-free per element (applyBounceDecay), so the loops vectorize
+    const float keep = 1.0f - decayFactor_;
+    float* intensity = batch.intensity;
+    int* bounceCount = batch.bounceCount;
+    for (size_t i = 0; i < batch.count; ++i) {
+        intensity[i] = std::max(intensity[i] * keep, minIntensity_);
+    }
+    for (size_t i = 0; i < batch.count; ++i) {
+        ++bounceCount[i];
+    }
+}
+
+// MaterialEffect implementation
+void MaterialEffect::apply(BounceState& state, const HitResult& hit) {
+    if (!enabled_) return;
+    uint32_t id = static_cast<uint32_t>(hit.normal.w());
+    Material material = id < materials_.size() ? materials_[id] : Material();
+    state.intensity *= material.reflectivity * (1.0f - material.absorption);
+    state.materialId = id;
+}
+
+void MaterialEffect::applyBatch(BounceBatch& batch) {
+    if (!enabled_) return;
+    // Per-material factor looked up once, not per hit
+    std::vector<float> factors(materials_.size());
+    for (size_t m = 0; m < materials_.size(); ++m) {
+        factors[m] = materials_[m].reflectivity * (1.0f - materials_[m].absorption);
+    }
+    for (size_t i = 0; i < batch.count; ++i) {
+        uint32_t id = static_cast<uint32_t>(batch.hits[i].normal.w());
+        batch.intensity[i] *= id < factors.size() ? factors[id] : 1.0f;
+        batch.materialId[i] = id;
+    }
+}
+
 // BounceEffectPipeline implementation
 BounceEffectPipeline::BounceEffectPipeline() {
-    // Add default intensity decay effect
+    // Add default intensity decay and material effects
     addEffect(std::make_unique<IntensityDecayEffect>());
+    addEffect(std::make_unique<MaterialEffect>());
 }
 
 BounceEffectPipeline::~BounceEffectPipeline() = default;
@@ -40,6 +88,15 @@ BounceEffect* BounceEffectPipeline::getEffect(const char* name) {
     return nullptr;
 }
 
+const BounceEffect* BounceEffectPipeline::getEffect(const char* name) const {
+    for (const auto& effect : effects_) {
+        if (std::strcmp(effect->name(), name) == 0) {
+            return effect.get();
+        }
+    }
+    return nullptr;
+}
+
 void BounceEffectPipeline::apply(BounceState& state, const HitResult& hit) {
     // In Path mode, don't apply any effects (uniform intensity)
     if (mode_ == RayTraceMode::Path) {
@@ -71,4 +128,19 @@ void BounceEffectPipeline::applyToSequence(std::vector<BounceState>& states,
     }
 }
 
+void BounceEffectPipeline::applyBatch(BounceBatch& batch) {
+    if (mode_ == RayTraceMode::Path) {
+        for (size_t i = 0; i < batch.count; ++i) {
+            ++batch.bounceCount[i];
+        }
+        return;
+    }
+
+    for (auto& effect : effects_) {
+        if (effect->isEnabled()) {
+            effect->applyBatch(batch);
+        }
+    }
+}
+
 } // namespace RCS
@@ -33,6 +33,7 @@ public:
 
     // Get effect by name (for configuration)
     BounceEffect* getEffect(const char* name);
+    const BounceEffect* getEffect(const char* name) const;
 
     // Apply all enabled effects to the bounce state
     // In Path mode, this does nothing (uniform intensity)
@@ -43,9 +44,19 @@ public:
     void applyToSequence(std::vector<BounceState>& states,
                          const std::vector<HitResult>& hits);
 
+    // apply() for one bounce of many rays: each enabled effect sees the whole
+    // batch through a single applyBatch() call. Same result as apply() per
+    // element; the single-hit API stays for the debug ray.
+    void applyBatch(BounceBatch& batch);
+
     // Get number of effects
     size_t effectCount() const { return effects_.size(); }
 
+    // Effect by position, in application order (null past the end)
+    const BounceEffect* effectAt(size_t index) const {
+        return index < effects_.size() ? effects_[index].get() : nullptr;
+    }
+
 private:
     RayTraceMode mode_ = RayTraceMode::PhysicsAccurate;
     std::vector<std::unique_ptr<BounceEffect>> effects_;
@@ -1,16 +1,53 @@
 // RayTraceTypes.h - Ray tracing mode and bounce state types
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace RCS {
 
+struct HitResult;
+
 // Ray tracing modes for bounce visualization
 enum class RayTraceMode {
     Path,           // Show all ray paths at uniform brightness (no intensity losses)
     PhysicsAccurate // Apply full physics effects (intensity losses per bounce)
 };
 
+// Surface material, indexed by the per-triangle material ID (Triangle::materialId,
+// HitResult::normal.w). Same std430 layout as the trace shader's material table.
+// The defaults reproduce the shader's original fixed BRDF.
+struct Material {
+    float reflectivity = 1.0f;  // Fraction of the shaded return the surface reflects
+    float roughness = 0.3f;     // Diffuse share of the BRDF; the specular lobe takes the rest
+    float shininess = 32.0f;    // Specular exponent
+    float absorption = 0.0f;    // Radar-absorbent coating: fraction absorbed per hit
+};
+static_assert(sizeof(Material) == 16, "Material must match the GLSL std430 layout");
+
+// Named materials for the UI, --materials and automation set_trace
+struct MaterialPreset {
+    const char* name;
+    Material material;
+};
+inline constexpr MaterialPreset kMaterialPresets[] = {
+    {"pec", {1.0f, 0.3f, 32.0f, 0.0f}},          // Bare metal, the default
+    {"ram", {1.0f, 0.3f, 32.0f, 0.9f}},          // Absorbent coating, -10 dB per hit
+    {"dielectric", {0.2f, 0.3f, 32.0f, 0.0f}},   // Composite/radome skin
+    {"rough", {1.0f, 0.8f, 8.0f, 0.0f}},         // Mostly diffuse metal
+};
+
+// nullptr if there is no preset of that name
+inline const MaterialPreset* findMaterialPreset(const char* name) {
+    for (const MaterialPreset& preset : kMaterialPresets) {
+        if (std::strcmp(preset.name, name) == 0) {
+            return &preset;
+        }
+    }
+    return nullptr;
+}
+
 // State tracking for ray bounces during tracing
 // This struct accumulates effects as a ray bounces through the scene
 struct BounceState {
@@ -42,4 +79,32 @@ struct BounceState {
     }
 };
 
+// BounceState for many rays at once, one array per field (structure of
+// arrays), so a batched effect runs a plain loop over each field it touches.
+// Element i is ray i's state and hits[i] the hit it is bouncing off. The
+// arrays belong to the caller.
+struct BounceBatch {
+    float* intensity = nullptr;
+    float* pathLength = nullptr;
+    uint32_t* materialId = nullptr;
+    int* bounceCount = nullptr;
+    const HitResult* hits = nullptr;
+    size_t count = 0;
+
+    BounceState state(size_t i) const {
+        BounceState s;
+        s.intensity = intensity[i];
+        s.pathLength = pathLength[i];
+        s.materialId = materialId[i];
+        s.bounceCount = bounceCount[i];
+        return s;
+    }
+    void setState(size_t i, const BounceState& s) {
+        intensity[i] = s.intensity;
+        pathLength[i] = s.pathLength;
+        materialId[i] = s.materialId;
+        bounceCount[i] = s.bounceCount;
+    }
+};
+
 } // namespace RCS
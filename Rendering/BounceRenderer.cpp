@@ -1,10 +1,7 @@
 // BounceRenderer.cpp - Implementation of bounce path visualization
 #include "BounceRenderer.h"
-#include "../Common/GLUtils.h"
 #include "../Common/Constants.h"
 #include "../UI/MainWindow/RCSPane/Compute/RCSTypes.h"
-#include <QOpenGLContext>
-#include <QDebug>
 #include <cmath>
 
 using namespace RS::Constants;
@@ -15,108 +12,6 @@ BounceRenderer::BounceRenderer(QObject* parent)
                  Colors::kBounceBaseColor[1],
                  Colors::kBounceBaseColor[2])
 {
-    // Simple vertex shader for colored lines
-    vertexShaderSource_ = R"(
-        #version 430 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aColor;
-
-        uniform mat4 view;
-        uniform mat4 projection;
-
-        out vec3 Color;
-
-        void main() {
-            Color = aColor;
-            gl_Position = projection * view * vec4(aPos, 1.0);
-        }
-    )";
-
-    // Simple fragment shader - pass through color
-    fragmentShaderSource_ = R"(
-        #version 430 core
-        in vec3 Color;
-        out vec4 FragColor;
-
-        void main() {
-            FragColor = vec4(Color, 1.0);
-        }
-    )";
-}
-
-BounceRenderer::~BounceRenderer() {
-    // OpenGL cleanup should be done via cleanup() before context destruction
-}
-
-bool BounceRenderer::initialize() {
-    if (initialized_) {
-        return true;
-    }
-
-    if (!QOpenGLContext::currentContext()) {
-        qWarning() << "BounceRenderer::initialize - No OpenGL context available";
-        return false;
-    }
-
-    if (!initializeOpenGLFunctions()) {
-        qCritical() << "BounceRenderer: Failed to initialize OpenGL functions!";
-        return false;
-    }
-
-    GLUtils::clearGLErrors();
-
-    setupShaders();
-
-    vao_.create();
-    vao_.bind();
-    vao_.release();
-
-    GLUtils::checkGLError("BounceRenderer::initialize");
-
-    initialized_ = true;
-    return true;
-}
-
-void BounceRenderer::cleanup() {
-    QOpenGLContext* ctx = QOpenGLContext::currentContext();
-    if (!ctx) {
-        shaderProgram_.reset();
-        return;
-    }
-
-    if (vao_.isCreated()) {
-        vao_.destroy();
-    }
-    if (vboId_ != 0) {
-        glDeleteBuffers(1, &vboId_);
-        vboId_ = 0;
-    }
-    shaderProgram_.reset();
-    initialized_ = false;
-}
-
-void BounceRenderer::setupShaders() {
-    if (vertexShaderSource_.empty() || fragmentShaderSource_.empty()) {
-        qCritical() << "BounceRenderer: Shader sources not initialized!";
-        return;
-    }
-
-    shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
-
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
-        qCritical() << "BounceRenderer: Failed to compile vertex shader:" << shaderProgram_->log();
-        return;
-    }
-
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
-        qCritical() << "BounceRenderer: Failed to compile fragment shader:" << shaderProgram_->log();
-        return;
-    }
-
-    if (!shaderProgram_->link()) {
-        qCritical() << "BounceRenderer: Failed to link shader program:" << shaderProgram_->log();
-        return;
-    }
 }
 
 QVector3D BounceRenderer::getBounceHitPoint(int index) const {
@@ -169,14 +64,18 @@ bool BounceRenderer::raySphereIntersect(const QVector3D& origin, const QVector3D
 void BounceRenderer::setBounceData(const QVector3D& radarPos,
                                     const std::vector<RCS::HitResult>& bounces,
                                     const std::vector<RCS::BounceState>& states,
-                                    float sphereRadius) {
+                                    float sphereRadius, uint64_t pathRevision) {
+    if (isPathCurrent(radarPos, sphereRadius, pathRevision)) {
+        return;
+    }
+    pathRevision_ = pathRevision;
     radarPos_ = radarPos;
     sphereRadius_ = sphereRadius;
     bounceHitPoints_.clear();
     bounceIntensities_.clear();
     totalPathLength_ = 0.0f;
-    vertices_.clear();
     lineSegments_.clear();
+    markers_.clear();
 
     if (bounces.empty()) {
         // No hits - draw miss ray toward center
@@ -186,8 +85,6 @@ void BounceRenderer::setBounceData(const QVector3D& radarPos,
         QVector3D missDir = -radarPos.normalized();  // Toward origin
         QVector3D missEnd = radarPos + missDir * sphereRadius * 2.0f;
         addLineSegment(radarPos, missEnd, missColor);
-        vertexCount_ = static_cast<int>(vertices_.size() / 6);
-        geometryDirty_ = true;
         return;
     }
 
@@ -248,14 +145,15 @@ void BounceRenderer::setBounceData(const QVector3D& radarPos,
         QVector3D extendedEnd = lastHitPos + lastReflection * 50.0f;
         addLineSegment(lastHitPos, extendedEnd, finalColor);
     }
-
-    vertexCount_ = static_cast<int>(vertices_.size() / 6);
-    geometryDirty_ = true;
 }
 
 void BounceRenderer::setBounceData(const QVector3D& radarPos,
                                     const std::vector<RCS::HitResult>& bounces,
-                                    float sphereRadius) {
+                                    float sphereRadius, uint64_t pathRevision) {
+    if (isPathCurrent(radarPos, sphereRadius, pathRevision)) {
+        return;
+    }
+
     // Create default states with decay
     std::vector<RCS::BounceState> states;
     states.reserve(bounces.size());
@@ -275,135 +173,44 @@ void BounceRenderer::setBounceData(const QVector3D& radarPos,
         states.push_back(state);
     }
 
-    setBounceData(radarPos, bounces, states, sphereRadius);
+    setBounceData(radarPos, bounces, states, sphereRadius, pathRevision);
+}
+
+bool BounceRenderer::isPathCurrent(const QVector3D& radarPos, float sphereRadius,
+                                   uint64_t pathRevision) const {
+    return pathRevision != 0 && pathRevision == pathRevision_ &&
+           radarPos == radarPos_ && sphereRadius == sphereRadius_;
 }
 
 void BounceRenderer::clearBounceData() {
-    vertices_.clear();
+    pathRevision_ = 0;
     lineSegments_.clear();
-    vertexCount_ = 0;
+    markers_.clear();
     bounceHitPoints_.clear();
     bounceIntensities_.clear();
     totalPathLength_ = 0.0f;
-    geometryDirty_ = true;
 }
 
 void BounceRenderer::addLineSegment(const QVector3D& start, const QVector3D& end,
                                      const QVector3D& color) {
-    // Add line vertices directly (position + color)
-    vertices_.push_back(start.x());
-    vertices_.push_back(start.y());
-    vertices_.push_back(start.z());
-    vertices_.push_back(color.x());
-    vertices_.push_back(color.y());
-    vertices_.push_back(color.z());
-
-    vertices_.push_back(end.x());
-    vertices_.push_back(end.y());
-    vertices_.push_back(end.z());
-    vertices_.push_back(color.x());
-    vertices_.push_back(color.y());
-    vertices_.push_back(color.z());
+    lineSegments_.push_back({start, end, color});
 }
 
 void BounceRenderer::addHitMarker(const QVector3D& position, float size,
                                    const QVector3D& color) {
-    // Draw a 3D cross at the hit point
-    float halfSize = size * 0.5f;
-
-    // X axis line
-    addLineSegment(position - QVector3D(halfSize, 0, 0),
-                   position + QVector3D(halfSize, 0, 0), color);
-
-    // Y axis line
-    addLineSegment(position - QVector3D(0, halfSize, 0),
-                   position + QVector3D(0, halfSize, 0), color);
-
-    // Z axis line
-    addLineSegment(position - QVector3D(0, 0, halfSize),
-                   position + QVector3D(0, 0, halfSize), color);
-}
-
-void BounceRenderer::generateGeometry() {
-    // Geometry is generated in setBounceData
-    // This method is kept for consistency with the interface
-}
-
-void BounceRenderer::uploadGeometry() {
-    if (!QOpenGLContext::currentContext() || !vao_.isCreated()) {
-        geometryDirty_ = true;
-        return;
-    }
-
-    if (vertices_.empty()) {
-        vertexCount_ = 0;
-        return;
-    }
-
-    vao_.bind();
-
-    // VBO
-    if (vboId_ == 0) {
-        glGenBuffers(1, &vboId_);
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-    glBufferData(GL_ARRAY_BUFFER,
-                 vertices_.size() * sizeof(float),
-                 vertices_.data(),
-                 GL_DYNAMIC_DRAW);
-
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Color attribute (location 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    vao_.release();
-    geometryDirty_ = false;
+    // Expanded to a camera-facing cross by the line batcher
+    markers_.push_back({position, size, color});
 }
 
-void BounceRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view,
-                            const QVector3D& cameraPos) {
-    (void)cameraPos;  // Not used in GL_LINES mode
-
-    if (!visible_ || vertices_.empty() || !shaderProgram_) {
-        return;
-    }
-
-    if (!vao_.isCreated()) {
+void BounceRenderer::submit(LineBatcher& batch) const {
+    if (!visible_) {
         return;
     }
 
-    if (geometryDirty_) {
-        uploadGeometry();
+    for (const LineSegment& segment : lineSegments_) {
+        batch.addLine(segment.start, segment.end, segment.color, kBounceLineWidth);
     }
-
-    if (vboId_ == 0 || vertexCount_ == 0) {
-        return;
+    for (const Marker& marker : markers_) {
+        batch.addMarker(marker.position, marker.size, marker.color);
     }
-
-    // Enable depth test so rays are occluded by solid geometry (target)
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-
-    // Set line width for visibility
-    glLineWidth(kBounceLineWidth);
-
-    shaderProgram_->bind();
-    shaderProgram_->setUniformValue("projection", projection);
-    shaderProgram_->setUniformValue("view", view);
-
-    vao_.bind();
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-
-    // Draw lines
-    glDrawArrays(GL_LINES, 0, vertexCount_);
-
-    vao_.release();
-    shaderProgram_->release();
-
-    // Restore state
-    glLineWidth(1.0f);
 }
@@ -2,59 +2,51 @@
 //
 // Renders multi-bounce ray paths with intensity-based coloring.
 // Shared by all beam types when bounce visualization is enabled.
+// Drawn through the shared LineBatcher with the other overlays.
 //
 #pragma once
 
 #include <QObject>
-#include <QOpenGLFunctions_4_5_Core>
-#include <QOpenGLShaderProgram>
-#include <QOpenGLVertexArrayObject>
-#include <QMatrix4x4>
 #include <QVector3D>
-#include <memory>
 #include <vector>
-#include <string_view>
+#include <cstdint>
 
 #include "../RCS/RayTraceTypes.h"
+#include "LineBatcher.h"
 
 // Forward declarations
 namespace RCS {
 struct HitResult;
 }
 
-class BounceRenderer : public QObject, protected QOpenGLFunctions_4_5_Core {
+class BounceRenderer : public QObject {
     Q_OBJECT
 
 public:
     explicit BounceRenderer(QObject* parent = nullptr);
-    ~BounceRenderer() override;
-
-    // Lifecycle
-    bool initialize();
-    void cleanup();
-    bool isInitialized() const { return initialized_; }
 
     // Set bounce data for rendering
     // @param radarPos: Starting position of the ray
     // @param bounces: Vector of hit results from multi-bounce trace
     // @param states: Vector of bounce states with intensity info (must match bounces size)
     // @param sphereRadius: Radius for extending final ray to sphere surface
+    // @param pathRevision: Identifies the traced path; a repeated non-zero revision
+    //                      with the same radar position and radius keeps the geometry
     void setBounceData(const QVector3D& radarPos,
                        const std::vector<RCS::HitResult>& bounces,
                        const std::vector<RCS::BounceState>& states,
-                       float sphereRadius);
+                       float sphereRadius, uint64_t pathRevision = 0);
 
     // Simplified version using a single state (intensity applied uniformly)
     void setBounceData(const QVector3D& radarPos,
                        const std::vector<RCS::HitResult>& bounces,
-                       float sphereRadius);
+                       float sphereRadius, uint64_t pathRevision = 0);
 
     // Clear all bounce data
     void clearBounceData();
 
-    // Rendering (cameraPos needed for view-aligned quad generation)
-    void render(const QMatrix4x4& projection, const QMatrix4x4& view,
-                const QVector3D& cameraPos);
+    // Queue the path's lines and hit markers for this frame
+    void submit(LineBatcher& batch) const;
 
     // Configuration
     void setVisible(bool visible) { visible_ = visible; }
@@ -63,7 +55,10 @@ public:
     void setBaseColor(const QVector3D& color) { baseColor_ = color; }
     QVector3D getBaseColor() const { return baseColor_; }
 
-    void setRayTraceMode(RCS::RayTraceMode mode) { rayTraceMode_ = mode; }
+    void setRayTraceMode(RCS::RayTraceMode mode) {
+        if (mode != rayTraceMode_) pathRevision_ = 0;  // Intensities depend on the mode
+        rayTraceMode_ = mode;
+    }
     RCS::RayTraceMode getRayTraceMode() const { return rayTraceMode_; }
 
     // Data accessors (for overlay text)
@@ -76,9 +71,7 @@ public:
     QVector3D getBounceColor(int bounceIndex, float intensity) const;
 
 private:
-    bool initialized_ = false;
     bool visible_ = false;
-    bool geometryDirty_ = false;
 
     // Configuration
     QVector3D baseColor_;
@@ -87,42 +80,30 @@ private:
     // Ray data
     QVector3D radarPos_;
     float sphereRadius_ = 100.0f;
+    uint64_t pathRevision_ = 0;     // Revision the geometry was built from (0 = none)
 
     // Bounce data
     std::vector<QVector3D> bounceHitPoints_;
     std::vector<float> bounceIntensities_;
     float totalPathLength_ = 0.0f;
 
-    // OpenGL resources
-    std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
-    QOpenGLVertexArrayObject vao_;
-    GLuint vboId_ = 0;
-
-    // Geometry data (position + color per vertex)
-    std::vector<float> vertices_;
-    int vertexCount_ = 0;
-
-    // Shader sources
-    std::string_view vertexShaderSource_;
-    std::string_view fragmentShaderSource_;
-
-    // Line segment data (stored before quad generation)
+    // Path geometry, rebuilt only when the bounce data changes
     struct LineSegment {
         QVector3D start;
         QVector3D end;
         QVector3D color;
     };
+    struct Marker {
+        QVector3D position;
+        float size;
+        QVector3D color;
+    };
     std::vector<LineSegment> lineSegments_;
+    std::vector<Marker> markers_;
 
-    // Helper methods
-    void setupShaders();
-    void generateGeometry();
-    void uploadGeometry();
-
-    // Generate quad geometry from stored line segments (requires camera position)
-    void generateQuadGeometry(const QVector3D& cameraPos, float lineWidth);
+    // True if the geometry was already built from this path
+    bool isPathCurrent(const QVector3D& radarPos, float sphereRadius, uint64_t pathRevision) const;
 
-    // Store line segment for later quad generation
     void addLineSegment(const QVector3D& start, const QVector3D& end,
                         const QVector3D& color);
     void addHitMarker(const QVector3D& position, float size,
@@ -0,0 +1,240 @@
+// LineBatcher.cpp - Implementation of the batched overlay line renderer
+#include "LineBatcher.h"
+#include "../Common/GLUtils.h"
+#include "../Common/Constants.h"
+#include <QOpenGLContext>
+#include <QVector2D>
+#include <QDebug>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+using namespace RS::Constants;
+
+namespace {
+    // Four strip corners per instance; gl_VertexID picks the corner
+    const char* kVertexShaderSource = R"(
+        #version 430 core
+        layout (location = 0) in vec4 aStart;  // xyz, width (px) or marker size (world)
+        layout (location = 1) in vec4 aEnd;    // xyz, kind (0 = line, 1 = marker)
+        layout (location = 2) in vec4 aColor;
+
+        uniform mat4 view;
+        uniform mat4 projection;
+        uniform vec2 viewport;
+
+        out vec3 Color;
+        out vec2 MarkerUV;
+        flat out int Kind;
+
+        const float kNearW = 1e-4;
+
+        void main() {
+            vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+            Color = aColor.rgb;
+
+            if (aEnd.w > 0.5) {
+                // Marker: camera-facing quad, the cross itself is cut out per fragment
+                Kind = 1;
+                MarkerUV = corner * 2.0 - 1.0;
+                vec4 center = view * vec4(aStart.xyz, 1.0);
+                gl_Position = projection * (center + vec4(MarkerUV * 0.5 * aStart.w, 0.0, 0.0));
+                return;
+            }
+
+            Kind = 0;
+            MarkerUV = vec2(0.0);
+            mat4 viewProj = projection * view;
+            vec4 p0 = viewProj * vec4(aStart.xyz, 1.0);
+            vec4 p1 = viewProj * vec4(aEnd.xyz, 1.0);
+
+            // Clip against the near plane so the screen direction stays defined
+            if (p0.w < kNearW && p1.w < kNearW) {
+                gl_Position = vec4(0.0, 0.0, 2.0, 1.0);  // Outside the depth range
+                return;
+            }
+            if (p0.w < kNearW) p0 = mix(p0, p1, (kNearW - p0.w) / (p1.w - p0.w));
+            if (p1.w < kNearW) p1 = mix(p1, p0, (kNearW - p1.w) / (p0.w - p1.w));
+
+            // Screen-space quad aStart.w pixels wide
+            vec2 s0 = p0.xy / p0.w * viewport;
+            vec2 s1 = p1.xy / p1.w * viewport;
+            vec2 dir = s1 - s0;
+            dir = dot(dir, dir) > 1e-8 ? normalize(dir) : vec2(1.0, 0.0);
+            vec2 normal = vec2(-dir.y, dir.x);
+
+            vec4 p = corner.x < 0.5 ? p0 : p1;
+            p.xy += normal * (corner.y * 2.0 - 1.0) * aStart.w / viewport * p.w;
+            gl_Position = p;
+        }
+    )";
+
+    const char* kFragmentShaderSource = R"(
+        #version 430 core
+        in vec3 Color;
+        in vec2 MarkerUV;
+        flat in int Kind;
+        out vec4 FragColor;
+
+        uniform float markerArm;  // Half-thickness of the cross arms in quad units
+
+        void main() {
+            if (Kind == 1 && min(abs(MarkerUV.x), abs(MarkerUV.y)) > markerArm) {
+                discard;
+            }
+            FragColor = vec4(Color, 1.0);
+        }
+    )";
+}
+
+LineBatcher::~LineBatcher() {
+    // OpenGL cleanup should be done via cleanup() before context destruction
+}
+
+bool LineBatcher::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << "LineBatcher::initialize - No OpenGL context available";
+        return false;
+    }
+
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "LineBatcher: Failed to initialize OpenGL functions!";
+        return false;
+    }
+
+    GLUtils::clearGLErrors();
+
+    createShaders();
+    if (!shaderProgram_) {
+        return false;
+    }
+
+    glGenVertexArrays(1, &vao_);
+    if (!stream_.initialize("LineBatcher", static_cast<size_t>(kLineBatchCapacity) * sizeof(Primitive))) {
+        return false;
+    }
+    glBindVertexArray(vao_);
+    for (GLuint i = 0; i < 3; ++i) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+    glBindVertexArray(0);
+
+    GLUtils::checkGLError("LineBatcher::initialize");
+
+    initialized_ = true;
+    return true;
+}
+
+void LineBatcher::cleanup() {
+    if (!QOpenGLContext::currentContext()) {
+        shaderProgram_.reset();
+        return;
+    }
+
+    stream_.cleanup();
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    shaderProgram_.reset();
+    queue_.clear();
+    initialized_ = false;
+}
+
+void LineBatcher::createShaders() {
+    shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
+
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShaderSource)) {
+        qCritical() << "LineBatcher: Failed to compile vertex shader:" << shaderProgram_->log();
+        shaderProgram_.reset();
+        return;
+    }
+
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, kFragmentShaderSource)) {
+        qCritical() << "LineBatcher: Failed to compile fragment shader:" << shaderProgram_->log();
+        shaderProgram_.reset();
+        return;
+    }
+
+    if (!shaderProgram_->link()) {
+        qCritical() << "LineBatcher: Failed to link shader program:" << shaderProgram_->log();
+        shaderProgram_.reset();
+        return;
+    }
+}
+
+void LineBatcher::bindAttributes(GLintptr offset) {
+    // Per-instance attributes of the region this flush wrote; the stream
+    // buffer may have been replaced since the last flush
+    glBindBuffer(GL_ARRAY_BUFFER, stream_.buffer());
+    const GLsizei stride = sizeof(Primitive);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(Primitive, start)));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(Primitive, end)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + offsetof(Primitive, color)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void LineBatcher::addLine(const QVector3D& start, const QVector3D& end,
+                          const QVector3D& color, float width) {
+    queue_.push_back({{start.x(), start.y(), start.z(), width},
+                      {end.x(), end.y(), end.z(), 0.0f},
+                      {color.x(), color.y(), color.z(), 1.0f}});
+}
+
+void LineBatcher::addMarker(const QVector3D& position, float size, const QVector3D& color) {
+    queue_.push_back({{position.x(), position.y(), position.z(), size},
+                      {position.x(), position.y(), position.z(), 1.0f},
+                      {color.x(), color.y(), color.z(), 1.0f}});
+}
+
+void LineBatcher::flush(const QMatrix4x4& projection, const QMatrix4x4& view) {
+    if (queue_.empty()) {
+        return;
+    }
+    const size_t bytes = queue_.size() * sizeof(Primitive);
+    RS::StreamingBuffer::Allocation primitives;
+    if (initialized_ && stream_.beginRegion(bytes)) {
+        primitives = stream_.allocate(bytes);
+    }
+    if (!primitives) {
+        queue_.clear();
+        return;
+    }
+    std::memcpy(primitives.data, queue_.data(), bytes);
+
+    // Half the viewport in pixels - NDC to pixel scale for the line expansion
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    QVector2D halfViewport(std::max(viewport[2], 1) * 0.5f, std::max(viewport[3], 1) * 0.5f);
+
+    // Depth tested so the target occludes rays; no writes, it is an overlay
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_CULL_FACE);
+
+    shaderProgram_->bind();
+    shaderProgram_->setUniformValue("projection", projection);
+    shaderProgram_->setUniformValue("view", view);
+    shaderProgram_->setUniformValue("viewport", halfViewport);
+    shaderProgram_->setUniformValue("markerArm", kLineBatchMarkerArm);
+
+    glBindVertexArray(vao_);
+    bindAttributes(primitives.offset);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(queue_.size()));
+    glBindVertexArray(0);
+
+    stream_.fence();
+
+    shaderProgram_->release();
+
+    // Restore state
+    glDepthMask(GL_TRUE);
+
+    queue_.clear();
+}
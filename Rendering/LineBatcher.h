@@ -0,0 +1,58 @@
+// LineBatcher.h - Immediate-mode batch of overlay lines and markers
+//
+// Debug rays, bounce paths and slicing-plane outlines queue their primitives
+// here each frame; flush() draws them all with one instanced call. Lines are
+// expanded to screen-space quads and markers to camera-facing crosses in the
+// vertex shader, so the CPU only writes one record per primitive.
+//
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QOpenGLShaderProgram>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <memory>
+#include <vector>
+
+#include "StreamingBuffer.h"
+
+class LineBatcher : protected QOpenGLFunctions_4_5_Core {
+public:
+    LineBatcher() = default;
+    ~LineBatcher();
+
+    // Lifecycle
+    bool initialize();
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Queue primitives for the next flush(). Line widths are in pixels,
+    // marker sizes in world units (the full arm length of the cross).
+    void addLine(const QVector3D& start, const QVector3D& end, const QVector3D& color, float width);
+    void addMarker(const QVector3D& position, float size, const QVector3D& color);
+
+    bool isEmpty() const { return queue_.empty(); }
+    size_t primitiveCount() const { return queue_.size(); }
+
+    // Draw everything queued since the last flush in one call and clear the
+    // queue. Depth tested against the scene, no depth writes.
+    void flush(const QMatrix4x4& projection, const QMatrix4x4& view);
+
+private:
+    // One instance: matches the per-instance attributes of the vertex shader
+    struct Primitive {
+        float start[4];  // xyz, line width (px) or marker size (world)
+        float end[4];    // xyz, kind (0 = line, 1 = marker)
+        float color[4];
+    };
+
+    void createShaders();
+    void bindAttributes(GLintptr offset);
+
+    bool initialized_ = false;
+    std::vector<Primitive> queue_;
+
+    std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
+    GLuint vao_ = 0;
+    RS::StreamingBuffer stream_;  // One region of primitives per flush
+};
@@ -0,0 +1,165 @@
+// SceneTarget.cpp - Implementation of the scaled offscreen scene buffers
+#include "SceneTarget.h"
+#include "../Common/GLUtils.h"
+#include "../Common/Constants.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+SceneTarget::~SceneTarget() {
+    // OpenGL cleanup should be done via cleanup() before context destruction
+}
+
+bool SceneTarget::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << "SceneTarget::initialize - No OpenGL context available";
+        return false;
+    }
+
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "SceneTarget: Failed to initialize OpenGL functions!";
+        return false;
+    }
+
+    glGenFramebuffers(1, &multisampleFbo_);
+    glGenFramebuffers(1, &fbo_);
+    GLUtils::checkGLError("SceneTarget::initialize");
+
+    initialized_ = true;
+    return true;
+}
+
+void SceneTarget::cleanup() {
+    if (!initialized_ || !QOpenGLContext::currentContext()) {
+        initialized_ = false;
+        return;
+    }
+
+    deleteBuffers();
+    glDeleteFramebuffers(1, &multisampleFbo_);
+    glDeleteFramebuffers(1, &fbo_);
+    multisampleFbo_ = 0;
+    fbo_ = 0;
+    initialized_ = false;
+}
+
+bool SceneTarget::bind(int outputWidth, int outputHeight, float scale, bool multisample) {
+    if (!initialized_ || outputWidth <= 0 || outputHeight <= 0) {
+        return false;
+    }
+    if ((outputWidth != allocatedWidth_ || outputHeight != allocatedHeight_) &&
+        !createBuffers(outputWidth, outputHeight)) {
+        return false;
+    }
+
+    scale = std::clamp(scale, View::kMinRenderScale, 1.0f);
+    sceneWidth_ = std::max(1, static_cast<int>(std::lround(outputWidth * scale)));
+    sceneHeight_ = std::max(1, static_cast<int>(std::lround(outputHeight * scale)));
+    multisample_ = multisample && samples_ > 0;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, multisample_ ? multisampleFbo_ : fbo_);
+    glViewport(0, 0, sceneWidth_, sceneHeight_);
+    return true;
+}
+
+void SceneTarget::present(GLuint framebuffer, int width, int height) {
+    if (!initialized_ || sceneWidth_ == 0) {
+        return;
+    }
+
+    // Same-size MSAA resolve first; a multisampled blit cannot scale
+    if (multisample_) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, multisampleFbo_);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
+        glBlitFramebuffer(0, 0, sceneWidth_, sceneHeight_, 0, 0, sceneWidth_, sceneHeight_,
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+
+    const bool scaled = sceneWidth_ != width || sceneHeight_ != height;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    glBlitFramebuffer(0, 0, sceneWidth_, sceneHeight_, 0, 0, width, height,
+                      GL_COLOR_BUFFER_BIT, scaled ? GL_LINEAR : GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+bool SceneTarget::createBuffers(int width, int height) {
+    deleteBuffers();
+
+    GLint maxSamples = 0;
+    glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    samples_ = std::min(View::kSceneMSAASamples, static_cast<int>(maxSamples));
+
+    // Formats match the window's, so TransparencyPass can blit the depth
+    glGenRenderbuffers(1, &color_);
+    glBindRenderbuffer(GL_RENDERBUFFER, color_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &depth_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth_);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        qWarning() << "SceneTarget::createBuffers - Framebuffer is not complete, status:" << status;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        deleteBuffers();
+        return false;
+    }
+
+    if (samples_ > 1) {
+        glGenRenderbuffers(1, &multisampleColor_);
+        glBindRenderbuffer(GL_RENDERBUFFER, multisampleColor_);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples_, GL_RGBA8, width, height);
+        glGenRenderbuffers(1, &multisampleDepth_);
+        glBindRenderbuffer(GL_RENDERBUFFER, multisampleDepth_);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples_, GL_DEPTH24_STENCIL8, width, height);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, multisampleFbo_);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, multisampleColor_);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, multisampleDepth_);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            qWarning() << "SceneTarget::createBuffers - Multisampled framebuffer is not complete, drawing without MSAA";
+            samples_ = 0;
+        }
+    } else {
+        samples_ = 0;
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    allocatedWidth_ = width;
+    allocatedHeight_ = height;
+    // RGBA8 color and DEPTH24_STENCIL8, once per sample plus the resolve target
+    gpuMemory_.resize(static_cast<uint64_t>(width) * height * 8 * (1 + samples_));
+    RS::GPUMemory::checkAllocation("SceneTarget buffers");
+    return true;
+}
+
+void SceneTarget::deleteBuffers() {
+    GLuint renderbuffers[4] = {color_, depth_, multisampleColor_, multisampleDepth_};
+    for (GLuint& renderbuffer : renderbuffers) {
+        if (renderbuffer != 0) {
+            glDeleteRenderbuffers(1, &renderbuffer);
+        }
+    }
+    color_ = depth_ = multisampleColor_ = multisampleDepth_ = 0;
+    samples_ = 0;
+    allocatedWidth_ = 0;
+    allocatedHeight_ = 0;
+    sceneWidth_ = 0;
+    sceneHeight_ = 0;
+    gpuMemory_.release();
+}
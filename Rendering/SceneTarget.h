@@ -0,0 +1,62 @@
+// SceneTarget.h - Offscreen 3D scene buffers with a variable resolution and MSAA
+//
+// RadarGLWidget draws the scene here rather than into the widget (or pop-out)
+// framebuffer, so RenderScaler can trade resolution and multisampling for GPU
+// time while the user interacts. Both buffers are allocated at the output
+// size: a multisampled one and a single-sampled one, which is the resolve
+// target when multisampling and the scene itself when not. A reduced scale
+// only draws into their lower-left corner, so changing the scale or toggling
+// MSAA never reallocates. present() resolves and then upscales, filtered,
+// into the output.
+//
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+
+#include "GPUMemory.h"
+
+class SceneTarget : protected QOpenGLFunctions_4_5_Core {
+public:
+    SceneTarget() = default;
+    ~SceneTarget();
+
+    // Lifecycle
+    bool initialize();
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Binds the buffer for an output of outputWidth x outputHeight device
+    // pixels drawn at scale, and sets the viewport to the scaled size.
+    // Reallocates only when the output size changes. Returns false if no
+    // buffer is available; the caller then draws straight to the output.
+    bool bind(int outputWidth, int outputHeight, float scale, bool multisample);
+
+    // Resolves the scene and blits it over all of framebuffer (width x height)
+    void present(GLuint framebuffer, int width, int height);
+
+    // Scene size of the last bind()
+    int width() const { return sceneWidth_; }
+    int height() const { return sceneHeight_; }
+    int samples() const { return multisample_ ? samples_ : 0; }
+
+private:
+    bool createBuffers(int width, int height);
+    void deleteBuffers();
+
+    bool initialized_ = false;
+
+    GLuint multisampleFbo_ = 0;
+    GLuint multisampleColor_ = 0;
+    GLuint multisampleDepth_ = 0;
+    GLuint fbo_ = 0;                 // Single-sampled scene, or the resolve target
+    GLuint color_ = 0;
+    GLuint depth_ = 0;
+    int samples_ = 0;                // 0 if multisampled buffers are unavailable
+
+    int allocatedWidth_ = 0;
+    int allocatedHeight_ = 0;
+    int sceneWidth_ = 0;
+    int sceneHeight_ = 0;
+    bool multisample_ = false;
+    RS::GPUAllocation gpuMemory_{RS::GPUMemoryPool::RenderTargets};
+};
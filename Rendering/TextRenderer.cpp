@@ -0,0 +1,362 @@
+// TextRenderer.cpp - Implementation of the glyph atlas text renderer
+#include "TextRenderer.h"
+#include "../Common/GLUtils.h"
+#include <QOpenGLContext>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainter>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+    constexpr int kFirstGlyph = 0x20;                        // Printable ASCII...
+    constexpr int kLastGlyph = 0x7E;
+    constexpr int kDegreeGlyph = kLastGlyph - kFirstGlyph + 1;  // ...plus U+00B0
+    constexpr int kGlyphCount = kDegreeGlyph + 1;
+    constexpr int kAtlasWidth = 512;                        // Device pixels
+    constexpr float kGlyphPadding = 1.0f;                   // Logical pixels around each cell
+
+    // Four strip corners per glyph instance; gl_VertexID picks the corner
+    const char* kVertexShaderSource = R"(
+        #version 430 core
+        layout (location = 0) in vec4 aRect;   // x, y, width, height
+        layout (location = 1) in vec4 aUV;     // u0, v0, u1, v1
+        layout (location = 2) in vec4 aColor;
+
+        uniform mat4 projection;
+
+        out vec2 UV;
+        out vec4 Color;
+
+        void main() {
+            vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+            UV = mix(aUV.xy, aUV.zw, corner);
+            Color = aColor;
+            gl_Position = projection * vec4(aRect.xy + corner * aRect.zw, 0.0, 1.0);
+        }
+    )";
+
+    const char* kFragmentShaderSource = R"(
+        #version 430 core
+        in vec2 UV;
+        in vec4 Color;
+        out vec4 FragColor;
+
+        uniform sampler2D atlas;  // Coverage in the red channel
+
+        void main() {
+            float coverage = texture(atlas, UV).r;
+            if (coverage <= 0.0) {
+                discard;
+            }
+            FragColor = vec4(Color.rgb, Color.a * coverage);
+        }
+    )";
+}
+
+TextRenderer::~TextRenderer() {
+    // OpenGL cleanup should be done via cleanup() before context destruction
+}
+
+bool TextRenderer::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << "TextRenderer::initialize - No OpenGL context available";
+        return false;
+    }
+
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "TextRenderer: Failed to initialize OpenGL functions!";
+        return false;
+    }
+
+    GLUtils::clearGLErrors();
+
+    createShaders();
+    if (!shaderProgram_) {
+        return false;
+    }
+
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glGenTextures(1, &atlasTexture_);
+
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    const GLsizei stride = sizeof(GlyphQuad);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphQuad, rect));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphQuad, uv));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphQuad, color));
+    for (GLuint i = 0; i < 3; ++i) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLUtils::checkGLError("TextRenderer::initialize");
+
+    vboCapacity_ = 0;
+    atlasDirty_ = !atlasPixels_.empty();
+    glyphsDirty_ = !glyphs_.empty();
+    initialized_ = true;
+    return true;
+}
+
+void TextRenderer::cleanup() {
+    if (!QOpenGLContext::currentContext()) {
+        shaderProgram_.reset();
+        return;
+    }
+
+    if (vbo_ != 0) {
+        glDeleteBuffers(1, &vbo_);
+        vbo_ = 0;
+    }
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    if (atlasTexture_ != 0) {
+        glDeleteTextures(1, &atlasTexture_);
+        atlasTexture_ = 0;
+    }
+    shaderProgram_.reset();
+    vboCapacity_ = 0;
+    initialized_ = false;
+}
+
+void TextRenderer::createShaders() {
+    shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
+
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShaderSource)) {
+        qCritical() << "TextRenderer: Failed to compile vertex shader:" << shaderProgram_->log();
+        shaderProgram_.reset();
+        return;
+    }
+
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, kFragmentShaderSource)) {
+        qCritical() << "TextRenderer: Failed to compile fragment shader:" << shaderProgram_->log();
+        shaderProgram_.reset();
+        return;
+    }
+
+    if (!shaderProgram_->link()) {
+        qCritical() << "TextRenderer: Failed to link shader program:" << shaderProgram_->log();
+        shaderProgram_.reset();
+        return;
+    }
+}
+
+int TextRenderer::glyphIndex(QChar c) {
+    ushort code = c.unicode();
+    if (code >= kFirstGlyph && code <= kLastGlyph) {
+        return code - kFirstGlyph;
+    }
+    return code == 0x00B0 ? kDegreeGlyph : -1;
+}
+
+int TextRenderer::addFont(const QFont& font) {
+    Font entry;
+    entry.font = font;
+    fonts_.push_back(entry);
+    buildAtlas();
+    return static_cast<int>(fonts_.size()) - 1;
+}
+
+void TextRenderer::setDevicePixelRatio(qreal ratio) {
+    if (ratio <= 0.0 || ratio == devicePixelRatio_) {
+        return;
+    }
+    devicePixelRatio_ = ratio;
+    buildAtlas();
+}
+
+void TextRenderer::buildAtlas() {
+    // Shelf-pack every font's cells in device pixels; one row per shelf
+    const float ratio = static_cast<float>(devicePixelRatio_);
+    struct Cell { int x, y, width; };
+    std::vector<Cell> cells(fonts_.size() * kGlyphCount);
+    std::vector<int> rowHeights(fonts_.size());
+    int x = 0;
+    int y = 0;
+    for (size_t f = 0; f < fonts_.size(); ++f) {
+        Font& font = fonts_[f];
+        QFontMetricsF metrics(font.font);
+        font.ascent = static_cast<float>(metrics.ascent());
+        font.descent = static_cast<float>(metrics.descent());
+        font.glyphs.assign(kGlyphCount, Glyph());
+        float cellHeight = font.ascent + font.descent + 2.0f * kGlyphPadding;
+        int rowHeight = static_cast<int>(std::ceil(cellHeight * ratio));
+        rowHeights[f] = rowHeight;
+        if (x > 0) {
+            x = 0;
+            y += rowHeights[f - 1];  // Fonts start on a shelf of their own
+        }
+        for (int g = 0; g < kGlyphCount; ++g) {
+            QChar c = g == kDegreeGlyph ? QChar(0x00B0) : QChar(kFirstGlyph + g);
+            Glyph& glyph = font.glyphs[g];
+            glyph.advance = static_cast<float>(metrics.horizontalAdvance(c));
+            int width = static_cast<int>(std::ceil((glyph.advance + 2.0f * kGlyphPadding) * ratio));
+            if (x + width > kAtlasWidth) {
+                x = 0;
+                y += rowHeight;
+            }
+            cells[f * kGlyphCount + g] = {x, y, width};
+            glyph.width = static_cast<float>(width) / ratio;
+            glyph.height = static_cast<float>(rowHeight) / ratio;
+            x += width;
+        }
+    }
+    if (!fonts_.empty()) {
+        y += rowHeights.back();
+    }
+    atlasWidth_ = kAtlasWidth;
+    atlasHeight_ = std::max(y, 1);
+
+    // Rasterize with QPainter into a CPU image; only the coverage is kept
+    QImage image(atlasWidth_, atlasHeight_, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    image.setDevicePixelRatio(devicePixelRatio_);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setPen(Qt::white);
+    for (size_t f = 0; f < fonts_.size(); ++f) {
+        Font& font = fonts_[f];
+        painter.setFont(font.font);
+        for (int g = 0; g < kGlyphCount; ++g) {
+            const Cell& cell = cells[f * kGlyphCount + g];
+            QChar c = g == kDegreeGlyph ? QChar(0x00B0) : QChar(kFirstGlyph + g);
+            painter.drawText(QPointF(cell.x / ratio + kGlyphPadding, cell.y / ratio + kGlyphPadding + font.ascent),
+                             QString(c));
+
+            Glyph& glyph = font.glyphs[g];
+            glyph.uv[0] = static_cast<float>(cell.x) / atlasWidth_;
+            glyph.uv[1] = static_cast<float>(cell.y) / atlasHeight_;
+            glyph.uv[2] = static_cast<float>(cell.x + cell.width) / atlasWidth_;
+            glyph.uv[3] = static_cast<float>(cell.y + rowHeights[f]) / atlasHeight_;
+        }
+    }
+    painter.end();
+
+    QImage coverage = image.convertToFormat(QImage::Format_Alpha8);
+    atlasPixels_.resize(static_cast<size_t>(atlasWidth_) * atlasHeight_);
+    for (int row = 0; row < atlasHeight_; ++row) {
+        std::memcpy(&atlasPixels_[static_cast<size_t>(row) * atlasWidth_], coverage.constScanLine(row), atlasWidth_);
+    }
+    atlasDirty_ = true;
+
+    // Queued text refers to the old cells
+    clear();
+}
+
+void TextRenderer::addText(int font, const QRectF& rect, int alignment, const QString& text, const QColor& color) {
+    if (font < 0 || font >= static_cast<int>(fonts_.size())) {
+        qWarning() << "TextRenderer::addText - Unknown font" << font;
+        return;
+    }
+    const Font& entry = fonts_[font];
+    const int space = glyphIndex(QChar(' '));
+
+    float width = 0.0f;
+    for (QChar c : text) {
+        int g = glyphIndex(c);
+        width += entry.glyphs[g < 0 ? space : g].advance;
+    }
+    float height = entry.ascent + entry.descent;
+
+    float x = static_cast<float>(rect.left());
+    if (alignment & Qt::AlignRight) {
+        x = static_cast<float>(rect.right()) - width;
+    } else if (alignment & Qt::AlignHCenter) {
+        x = static_cast<float>(rect.center().x()) - 0.5f * width;
+    }
+    float top = static_cast<float>(rect.top());
+    if (alignment & Qt::AlignBottom) {
+        top = static_cast<float>(rect.bottom()) - height;
+    } else if (alignment & Qt::AlignVCenter) {
+        top = static_cast<float>(rect.center().y()) - 0.5f * height;
+    }
+
+    const float rgba[4] = {static_cast<float>(color.redF()), static_cast<float>(color.greenF()),
+                           static_cast<float>(color.blueF()), static_cast<float>(color.alphaF())};
+    for (QChar c : text) {
+        int g = glyphIndex(c);
+        const Glyph& glyph = entry.glyphs[g < 0 ? space : g];
+        if (g >= 0 && c != QChar(' ')) {
+            glyphs_.push_back({{x - kGlyphPadding, top - kGlyphPadding, glyph.width, glyph.height},
+                               {glyph.uv[0], glyph.uv[1], glyph.uv[2], glyph.uv[3]},
+                               {rgba[0], rgba[1], rgba[2], rgba[3]}});
+        }
+        x += glyph.advance;
+    }
+    glyphsDirty_ = true;
+}
+
+void TextRenderer::clear() {
+    glyphs_.clear();
+    glyphsDirty_ = true;
+}
+
+void TextRenderer::draw(const QMatrix4x4& projection) {
+    if (!initialized_ || glyphs_.empty()) {
+        return;
+    }
+
+    if (atlasDirty_) {
+        glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlasWidth_, atlasHeight_, 0, GL_RED, GL_UNSIGNED_BYTE,
+                     atlasPixels_.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        atlasDirty_ = false;
+    }
+
+    // The layout only changes with the caller's labels; reuse the buffer otherwise
+    if (glyphsDirty_) {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        const GLsizeiptr bytes = static_cast<GLsizeiptr>(glyphs_.size() * sizeof(GlyphQuad));
+        if (glyphs_.size() > vboCapacity_) {
+            glBufferData(GL_ARRAY_BUFFER, bytes, glyphs_.data(), GL_STATIC_DRAW);
+            vboCapacity_ = glyphs_.size();
+        } else {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, glyphs_.data());
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glyphsDirty_ = false;
+    }
+
+    GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    shaderProgram_->bind();
+    shaderProgram_->setUniformValue("projection", projection);
+    shaderProgram_->setUniformValue("atlas", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+
+    glBindVertexArray(vao_);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(glyphs_.size()));
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    shaderProgram_->release();
+    if (!blendWasEnabled) {
+        glDisable(GL_BLEND);
+    }
+}
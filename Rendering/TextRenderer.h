@@ -0,0 +1,92 @@
+// TextRenderer.h - Screen-space text from a glyph atlas
+//
+// Each font's printable ASCII glyphs (plus the degree sign) are rasterized
+// once into a single-channel atlas texture. Text is laid out on the CPU into
+// one instanced quad per glyph and kept in a buffer until clear(), so a
+// widget only rebuilds its labels when their layout changes and redraws
+// them with one call otherwise - no QPainter pass over the GL surface.
+//
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QOpenGLShaderProgram>
+#include <QMatrix4x4>
+#include <QColor>
+#include <QFont>
+#include <QRectF>
+#include <QString>
+#include <memory>
+#include <vector>
+
+class TextRenderer : protected QOpenGLFunctions_4_5_Core {
+public:
+    TextRenderer() = default;
+    ~TextRenderer();
+
+    // Lifecycle
+    bool initialize();
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Registers a font and returns its index for addText(). Rebuilds the
+    // atlas, so register every font up front.
+    int addFont(const QFont& font);
+    // Glyphs are rasterized at this many device pixels per logical pixel
+    void setDevicePixelRatio(qreal ratio);
+    qreal getDevicePixelRatio() const { return devicePixelRatio_; }
+
+    // Queues text in logical pixels, aligned within rect like
+    // QPainter::drawText (Qt::AlignLeft/Right/HCenter, Top/Bottom/VCenter).
+    // Queued text stays until clear().
+    void addText(int font, const QRectF& rect, int alignment, const QString& text, const QColor& color);
+    void clear();
+    bool isEmpty() const { return glyphs_.empty(); }
+
+    // Alpha-blends the queued text; projection maps logical pixels to clip space
+    void draw(const QMatrix4x4& projection);
+
+private:
+    // One instance: matches the per-instance attributes of the vertex shader
+    struct GlyphQuad {
+        float rect[4];  // x, y, width, height (logical pixels)
+        float uv[4];    // u0, v0, u1, v1
+        float color[4];
+    };
+
+    // Atlas cell of one character
+    struct Glyph {
+        float advance = 0.0f;  // Logical pixels
+        float uv[4] = {};
+        float width = 0.0f;    // Cell size in logical pixels, padding included
+        float height = 0.0f;
+    };
+
+    struct Font {
+        QFont font;
+        float ascent = 0.0f;
+        float descent = 0.0f;
+        std::vector<Glyph> glyphs;  // kGlyphCount, indexed by glyphIndex()
+    };
+
+    static int glyphIndex(QChar c);  // -1 outside the atlas character set
+    void buildAtlas();
+    void createShaders();
+
+    bool initialized_ = false;
+    qreal devicePixelRatio_ = 1.0;
+    std::vector<Font> fonts_;
+    std::vector<GlyphQuad> glyphs_;
+
+    // Built on the CPU whenever a font or the ratio changes, uploaded by draw()
+    std::vector<unsigned char> atlasPixels_;
+    int atlasWidth_ = 0;
+    int atlasHeight_ = 0;
+    bool atlasDirty_ = false;
+    bool glyphsDirty_ = false;
+
+    std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+    GLuint atlasTexture_ = 0;
+    size_t vboCapacity_ = 0;  // Glyph quads the buffer holds
+};
@@ -0,0 +1,283 @@
+// TransparencyPass.cpp - Implementation of the weighted blended OIT pass
+#include "TransparencyPass.h"
+#include "../Common/GLUtils.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+    // Inserted into every translucent fragment shader. The weight (McGuire and
+    // Bavoil, equation 10) favours near, opaque fragments, so the front layer
+    // dominates the average where several overlap.
+    const char* kOutputSource = R"(
+        layout (location = 0) out vec4 oitAccum;
+        layout (location = 1) out float oitRevealage;
+
+        void writeTransparent(vec4 color) {
+            float a = clamp(color.a, 0.0, 1.0);
+            float depth = 1.0 - gl_FragCoord.z * 0.9;
+            float weight = clamp(pow(min(1.0, a * 10.0) + 0.01, 3.0) * 1e8 * depth * depth * depth, 1e-2, 3e3);
+            oitAccum = vec4(color.rgb * a, a) * weight;
+            oitRevealage = a;
+        }
+    )";
+
+    // One triangle covering the viewport
+    const char* kCompositeVertexSource = R"(
+        #version 430 core
+        void main() {
+            vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    const char* kCompositeFragmentSource = R"(
+        #version 430 core
+        uniform sampler2D accumTexture;
+        uniform sampler2D revealageTexture;
+        out vec4 FragColor;
+
+        void main() {
+            ivec2 texel = ivec2(gl_FragCoord.xy);
+            float revealage = texelFetch(revealageTexture, texel, 0).r;
+            if (revealage >= 1.0) {
+                discard;  // No translucent fragment here
+            }
+            vec4 accum = texelFetch(accumTexture, texel, 0);
+            // Half floats can overflow under many bright layers
+            if (isinf(max(max(abs(accum.r), abs(accum.g)), abs(accum.b)))) {
+                accum.rgb = vec3(accum.a);
+            }
+            FragColor = vec4(accum.rgb / max(accum.a, 1e-5), 1.0 - revealage);
+        }
+    )";
+}
+
+TransparencyPass::~TransparencyPass() {
+    // OpenGL cleanup should be done via cleanup() before context destruction
+}
+
+bool TransparencyPass::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << "TransparencyPass::initialize - No OpenGL context available";
+        return false;
+    }
+
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "TransparencyPass: Failed to initialize OpenGL functions!";
+        return false;
+    }
+
+    GLUtils::clearGLErrors();
+
+    createShaders();
+    if (!compositeProgram_) {
+        return false;
+    }
+
+    glGenVertexArrays(1, &vao_);
+    glGenFramebuffers(1, &fbo_);
+
+    GLUtils::checkGLError("TransparencyPass::initialize");
+
+    initialized_ = true;
+    return true;
+}
+
+void TransparencyPass::cleanup() {
+    if (!QOpenGLContext::currentContext()) {
+        compositeProgram_.reset();
+        return;
+    }
+
+    deleteTargets();
+    if (fbo_ != 0) {
+        glDeleteFramebuffers(1, &fbo_);
+        fbo_ = 0;
+    }
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    compositeProgram_.reset();
+    active_ = false;
+    initialized_ = false;
+}
+
+std::string TransparencyPass::fragmentShader(std::string_view source) {
+    std::string shader(source);
+    size_t version = shader.find("#version");
+    size_t lineEnd = version == std::string::npos ? std::string::npos : shader.find('\n', version);
+    if (lineEnd == std::string::npos) {
+        qWarning() << "TransparencyPass::fragmentShader - Source has no #version line";
+        return shader;
+    }
+    shader.insert(lineEnd + 1, kOutputSource);
+    return shader;
+}
+
+void TransparencyPass::createShaders() {
+    compositeProgram_ = std::make_unique<QOpenGLShaderProgram>();
+
+    if (!compositeProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, kCompositeVertexSource)) {
+        qCritical() << "TransparencyPass: Failed to compile vertex shader:" << compositeProgram_->log();
+        compositeProgram_.reset();
+        return;
+    }
+
+    if (!compositeProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, kCompositeFragmentSource)) {
+        qCritical() << "TransparencyPass: Failed to compile fragment shader:" << compositeProgram_->log();
+        compositeProgram_.reset();
+        return;
+    }
+
+    if (!compositeProgram_->link()) {
+        qCritical() << "TransparencyPass: Failed to link shader program:" << compositeProgram_->log();
+        compositeProgram_.reset();
+        return;
+    }
+
+    compositeProgram_->bind();
+    compositeProgram_->setUniformValue("accumTexture", 0);
+    compositeProgram_->setUniformValue("revealageTexture", 1);
+    compositeProgram_->release();
+}
+
+// Single-sampled targets; the depth copy matches SceneTarget's DEPTH24_STENCIL8,
+// which glBlitFramebuffer requires
+bool TransparencyPass::createTargets(int width, int height) {
+    deleteTargets();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    auto createTexture = [this, width, height](GLuint& texture, GLenum format) {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    };
+    createTexture(accumTexture_, GL_RGBA16F);
+    createTexture(revealageTexture_, GL_R16F);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &depthRbo_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRbo_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumTexture_, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, revealageTexture_, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRbo_);
+    const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFbo_);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        qWarning() << "TransparencyPass::createTargets - Framebuffer is not complete, status:" << status;
+        deleteTargets();
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    // RGBA16F + R16F + DEPTH24_STENCIL8 per pixel
+    gpuMemory_.resize(static_cast<uint64_t>(width) * height * (8 + 2 + 4));
+    return true;
+}
+
+void TransparencyPass::deleteTargets() {
+    if (accumTexture_ != 0) {
+        glDeleteTextures(1, &accumTexture_);
+        accumTexture_ = 0;
+    }
+    if (revealageTexture_ != 0) {
+        glDeleteTextures(1, &revealageTexture_);
+        revealageTexture_ = 0;
+    }
+    if (depthRbo_ != 0) {
+        glDeleteRenderbuffers(1, &depthRbo_);
+        depthRbo_ = 0;
+    }
+    width_ = 0;
+    height_ = 0;
+    gpuMemory_.release();
+}
+
+bool TransparencyPass::begin() {
+    if (!initialized_) {
+        return false;
+    }
+
+    // The targets cover the viewport, which is the lower-left corner of the
+    // scene buffer when RenderScaler lowers the resolution; they only grow,
+    // so scale changes under load never reallocate
+    GLint viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &sceneFbo_);
+    if ((viewport[2] > width_ || viewport[3] > height_) &&
+        !createTargets(std::max<int>(viewport[2], width_), std::max<int>(viewport[3], height_))) {
+        return false;
+    }
+
+    // Opaque depth so far, resolved from the multisampled scene
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFbo_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_);
+    glBlitFramebuffer(0, 0, viewport[2], viewport[3], 0, 0, viewport[2], viewport[3],
+                      GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+
+    const GLfloat noColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    const GLfloat fullyRevealed[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    glClearBufferfv(GL_COLOR, 0, noColor);
+    glClearBufferfv(GL_COLOR, 1, fullyRevealed);
+
+    // Sums into the accumulation target, products into the revealage target
+    glEnable(GL_BLEND);
+    glBlendFunci(0, GL_ONE, GL_ONE);
+    glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_FALSE);
+
+    active_ = true;
+    return true;
+}
+
+void TransparencyPass::end() {
+    if (!active_) {
+        return;
+    }
+    active_ = false;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFbo_);
+
+    // color * (1 - revealage) over the scene
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    compositeProgram_->bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, accumTexture_);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, revealageTexture_);
+    glBindVertexArray(vao_);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    compositeProgram_->release();
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+}
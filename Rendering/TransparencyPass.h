@@ -0,0 +1,61 @@
+// TransparencyPass.h - Weighted blended order-independent transparency
+//
+// The heat map, slicing plane fill, beam and lobes draw between begin() and
+// end() in any order. Their fragment shaders call writeTransparent(color)
+// (see fragmentShader()), which adds each fragment, weighted by alpha and
+// depth, to an RGBA16F accumulation target and multiplies its coverage into
+// a revealage target, both with fixed blend functions. end() resolves the
+// weighted average over the scene in one full-screen draw. Depth tests use a
+// copy of the scene's depth buffer, so opaque geometry still hides them.
+//
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QOpenGLShaderProgram>
+#include "GPUMemory.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+class TransparencyPass : protected QOpenGLFunctions_4_5_Core {
+public:
+    TransparencyPass() = default;
+    ~TransparencyPass();
+
+    // Lifecycle
+    bool initialize();
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Redirects drawing to the accumulation targets, sized to the viewport
+    // and holding the bound framebuffer's depth. Blending and depth writes
+    // belong to the pass until end(); translucent renderers leave them alone.
+    // Returns false (and changes nothing) if the targets are unavailable.
+    bool begin();
+    // Composites onto the framebuffer bound at begin() and restores the usual
+    // alpha-blend state (blending off, depth writes on)
+    void end();
+
+    // A translucent fragment shader with the pass outputs and
+    // writeTransparent(vec4) inserted after its #version line
+    static std::string fragmentShader(std::string_view source);
+
+private:
+    void createShaders();
+    bool createTargets(int width, int height);
+    void deleteTargets();
+
+    bool initialized_ = false;
+    bool active_ = false;
+
+    std::unique_ptr<QOpenGLShaderProgram> compositeProgram_;
+    GLuint vao_ = 0;                  // Empty; the full-screen triangle comes from gl_VertexID
+    GLuint fbo_ = 0;
+    GLuint accumTexture_ = 0;         // RGBA16F: sum of weighted premultiplied color, weighted alpha
+    GLuint revealageTexture_ = 0;     // R16F: product of (1 - alpha)
+    GLuint depthRbo_ = 0;             // Copy of the scene depth
+    GLint sceneFbo_ = 0;              // Framebuffer bound at begin()
+    int width_ = 0;
+    int height_ = 0;
+    RS::GPUAllocation gpuMemory_{RS::GPUMemoryPool::RenderTargets};
+};
@@ -0,0 +1,1009 @@
+// MeshImporter.cpp - OBJ/STL/glTF mesh import (no GL, any thread)
+#include "MeshImporter.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMatrix4x4>
+#include <QQuaternion>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// Hash shards for welding. Fixed rather than per-thread so the vertex order
+// (and everything built from it) does not depend on the machine.
+constexpr int kWeldShards = 64;
+constexpr int kChunksPerThread = 4;       // Parse chunks per thread, for load balance and progress
+constexpr size_t kMinChunkBytes = 1 << 20;
+constexpr size_t kMinChunkItems = 16384;  // Vertices or triangles per chunk for the binary passes
+constexpr int kGLTFMaxNodeDepth = 64;     // Guards against cyclic node graphs
+
+// Runs body(i) for i in [0, count) on up to `threads` threads
+template <typename Body>
+void parallelFor(int count, int threads, Body body) {
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next++; i < count; i = next++) {
+            body(i);
+        }
+    };
+    std::vector<std::future<void>> tasks;
+    for (int t = 1; t < std::min(threads, count); ++t) {
+        tasks.push_back(std::async(std::launch::async, worker));
+    }
+    worker();
+    for (auto& task : tasks) {
+        task.get();
+    }
+}
+
+// [begin, end) of chunk i when `items` are split into `chunks` even ranges
+std::pair<size_t, size_t> chunkRange(size_t items, int chunks, int i) {
+    return {items * i / chunks, items * (i + 1) / chunks};
+}
+
+int chunkCountFor(size_t items, size_t minItems, int threads) {
+    size_t byLimit = std::max<size_t>(1, items / minItems);
+    return static_cast<int>(std::min<size_t>(byLimit, static_cast<size_t>(threads) * kChunksPerThread));
+}
+
+// Splits text into up to `count` ranges that each end after a line break
+std::vector<std::pair<size_t, size_t>> lineChunks(const char* data, size_t size, int count) {
+    std::vector<std::pair<size_t, size_t>> chunks;
+    size_t begin = 0;
+    for (int i = 1; i <= count && begin < size; ++i) {
+        size_t end = i == count ? size : std::max(begin + 1, size * i / count);
+        while (end < size && data[end - 1] != '\n') {
+            ++end;
+        }
+        chunks.push_back({begin, std::min(end, size)});
+        begin = end;
+    }
+    return chunks;
+}
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline void skipBlanks(const char*& p, const char* end) {
+    while (p < end && isBlank(*p)) {
+        ++p;
+    }
+}
+
+inline const char* nextLine(const char* p, const char* end) {
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return newline ? newline + 1 : end;
+}
+
+inline bool startsWithWord(const char* p, const char* end, const char* word, size_t length) {
+    return static_cast<size_t>(end - p) > length && std::memcmp(p, word, length) == 0 && isBlank(p[length]);
+}
+
+// Decimal float with optional sign, fraction and exponent. Independent of the
+// C locale and several times faster than strtof for mesh-sized inputs.
+bool parseFloat(const char*& p, const char* end, float& out) {
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        ++s;
+    }
+
+    double value = 0.0;
+    bool digits = false;
+    while (s < end && *s >= '0' && *s <= '9') {
+        value = value * 10.0 + (*s - '0');
+        ++s;
+        digits = true;
+    }
+    if (s < end && *s == '.') {
+        ++s;
+        double scale = 0.1;
+        while (s < end && *s >= '0' && *s <= '9') {
+            value += (*s - '0') * scale;
+            scale *= 0.1;
+            ++s;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        const char* e = s + 1;
+        bool negativeExponent = false;
+        if (e < end && (*e == '-' || *e == '+')) {
+            negativeExponent = *e == '-';
+            ++e;
+        }
+        int exponent = 0;
+        bool exponentDigits = false;
+        while (e < end && *e >= '0' && *e <= '9') {
+            exponent = std::min(exponent * 10 + (*e - '0'), 400);
+            ++e;
+            exponentDigits = true;
+        }
+        if (exponentDigits) {
+            value *= std::pow(10.0, negativeExponent ? -exponent : exponent);
+            s = e;
+        }
+    }
+
+    out = static_cast<float>(negative ? -value : value);
+    p = s;
+    return true;
+}
+
+bool parseInt(const char*& p, const char* end, int64_t& out) {
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        ++s;
+    }
+    int64_t value = 0;
+    const char* first = s;
+    while (s < end && *s >= '0' && *s <= '9' && value < (int64_t(1) << 40)) {
+        value = value * 10 + (*s - '0');
+        ++s;
+    }
+    if (s == first) {
+        return false;
+    }
+    out = negative ? -value : value;
+    p = s;
+    return true;
+}
+
+// Bit pattern of a position, with -0 folded into +0 so both weld together
+struct PositionKey {
+    uint32_t x, y, z;
+
+    bool operator==(const PositionKey& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+inline uint32_t floatKey(float f) {
+    uint32_t bits;
+    f = f == 0.0f ? 0.0f : f;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+inline uint64_t hashKey(const PositionKey& key) {
+    uint64_t h = key.x * 0x9E3779B97F4A7C15ull;
+    h ^= key.y * 0xC2B2AE3D27D4EB4Full;
+    h ^= key.z * 0x165667B19E3779F9ull;
+    return h ^ (h >> 29);
+}
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const { return static_cast<size_t>(hashKey(key)); }
+};
+
+inline PositionKey positionKey(const std::vector<float>& positions, size_t vertex) {
+    return {floatKey(positions[vertex * 3]), floatKey(positions[vertex * 3 + 1]), floatKey(positions[vertex * 3 + 2])};
+}
+
+// Shard from the top bits; the per-shard hash maps bucket on the low ones
+inline int shardOf(const PositionKey& key) {
+    return static_cast<int>(hashKey(key) >> 58) & (kWeldShards - 1);
+}
+
+// One glTF accessor resolved to raw bytes
+struct GLTFAccessor {
+    const char* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    int componentType = 0;
+    int components = 0;
+};
+
+int gltfComponentSize(int componentType) {
+    switch (componentType) {
+    case 5120: case 5121: return 1;  // BYTE, UNSIGNED_BYTE
+    case 5122: case 5123: return 2;  // SHORT, UNSIGNED_SHORT
+    case 5125: case 5126: return 4;  // UNSIGNED_INT, FLOAT
+    default: return 0;
+    }
+}
+
+int gltfComponentCount(const QString& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    return 0;
+}
+
+bool resolveAccessor(const QJsonObject& root, const std::vector<QByteArray>& buffers, int index,
+                     GLTFAccessor& out, QString& error) {
+    QJsonObject accessor = root["accessors"].toArray().at(index).toObject();
+    if (accessor.isEmpty()) {
+        error = QString("glTF accessor %1 does not exist").arg(index);
+        return false;
+    }
+    if (accessor.contains("sparse") || !accessor.contains("bufferView")) {
+        error = QString("glTF accessor %1 is sparse or has no buffer view (unsupported)").arg(index);
+        return false;
+    }
+
+    QJsonObject view = root["bufferViews"].toArray().at(accessor["bufferView"].toInt()).toObject();
+    int bufferIndex = view["buffer"].toInt(-1);
+    if (bufferIndex < 0 || bufferIndex >= static_cast<int>(buffers.size())) {
+        error = QString("glTF accessor %1 references a missing buffer").arg(index);
+        return false;
+    }
+
+    out.componentType = accessor["componentType"].toInt();
+    out.components = gltfComponentCount(accessor["type"].toString());
+    int componentSize = gltfComponentSize(out.componentType);
+    if (out.components == 0 || componentSize == 0) {
+        error = QString("glTF accessor %1 has an unsupported type").arg(index);
+        return false;
+    }
+
+    size_t elementSize = static_cast<size_t>(out.components) * componentSize;
+    size_t offset = static_cast<size_t>(view["byteOffset"].toDouble()) +
+                    static_cast<size_t>(accessor["byteOffset"].toDouble());
+    out.count = static_cast<size_t>(accessor["count"].toDouble());
+    out.stride = view.contains("byteStride") ? static_cast<size_t>(view["byteStride"].toInt()) : elementSize;
+
+    const QByteArray& buffer = buffers[bufferIndex];
+    if (out.count > 0 && offset + out.stride * (out.count - 1) + elementSize > static_cast<size_t>(buffer.size())) {
+        error = QString("glTF accessor %1 runs past the end of its buffer").arg(index);
+        return false;
+    }
+    out.data = buffer.constData() + offset;
+    return true;
+}
+
+QMatrix4x4 gltfNodeMatrix(const QJsonObject& node) {
+    QMatrix4x4 matrix;
+    QJsonArray values = node["matrix"].toArray();
+    if (values.size() == 16) {
+        // Column-major in the file
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                matrix(row, column) = static_cast<float>(values[column * 4 + row].toDouble());
+            }
+        }
+        return matrix;
+    }
+
+    QJsonArray t = node["translation"].toArray();
+    QJsonArray r = node["rotation"].toArray();
+    QJsonArray s = node["scale"].toArray();
+    if (t.size() == 3) {
+        matrix.translate(t[0].toDouble(), t[1].toDouble(), t[2].toDouble());
+    }
+    if (r.size() == 4) {
+        // glTF quaternions are x, y, z, w
+        matrix.rotate(QQuaternion(r[3].toDouble(), r[0].toDouble(), r[1].toDouble(), r[2].toDouble()));
+    }
+    if (s.size() == 3) {
+        matrix.scale(s[0].toDouble(), s[1].toDouble(), s[2].toDouble());
+    }
+    return matrix;
+}
+
+// Collects (mesh, world matrix) for a node and its children
+void collectGLTFMeshes(const QJsonArray& nodes, int index, const QMatrix4x4& parent, int depth,
+                       std::vector<std::pair<int, QMatrix4x4>>& out) {
+    if (index < 0 || index >= nodes.size() || depth > kGLTFMaxNodeDepth) {
+        return;
+    }
+    QJsonObject node = nodes[index].toObject();
+    QMatrix4x4 world = parent * gltfNodeMatrix(node);
+    if (node.contains("mesh")) {
+        out.push_back({node["mesh"].toInt(), world});
+    }
+    for (const QJsonValue& child : node["children"].toArray()) {
+        collectGLTFMeshes(nodes, child.toInt(), world, depth + 1, out);
+    }
+}
+
+} // namespace
+
+bool MeshImporter::isSupportedFile(const QString& path) {
+    QString suffix = QFileInfo(path).suffix().toLower();
+    return suffix == "stl" || suffix == "obj" || suffix == "gltf" || suffix == "glb";
+}
+
+int MeshImporter::threadCount() const {
+    if (threadCount_ > 0) {
+        return threadCount_;
+    }
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+void MeshImporter::reportProgress(int percent) {
+    std::lock_guard<std::mutex> lock(progressMutex_);
+    if (progress_ && percent > lastPercent_) {
+        lastPercent_ = percent;
+        progress_(percent);
+    }
+}
+
+bool MeshImporter::fail(const QString& message) {
+    error_ = message;
+    return false;
+}
+
+bool MeshImporter::load(const QString& path, ImportedMesh& mesh, const ProgressCallback& progress) {
+    error_.clear();
+    progress_ = progress;
+    lastPercent_ = -1;
+
+    QString suffix = QFileInfo(path).suffix().toLower();
+    if (!isSupportedFile(path)) {
+        return fail(QString("Unsupported mesh format: .%1").arg(suffix));
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(QString("Cannot open %1: %2").arg(path, file.errorString()));
+    }
+    qint64 fileSize = file.size();
+    if (fileSize <= 0) {
+        return fail(QString("%1 is empty").arg(path));
+    }
+
+    // Map the whole file; read it instead where the file system cannot map
+    QByteArray contents;
+    uchar* mapped = file.map(0, fileSize);
+    const char* data = reinterpret_cast<const char*>(mapped);
+    size_t size = static_cast<size_t>(fileSize);
+    if (!mapped) {
+        contents = file.readAll();
+        data = contents.constData();
+        size = static_cast<size_t>(contents.size());
+    }
+    reportProgress(0);
+
+    RawMesh raw;
+    bool parsed = false;
+    if (suffix == "stl") {
+        parsed = parseSTL(data, size, raw);
+    } else if (suffix == "obj") {
+        parsed = parseOBJ(data, size, raw);
+    } else {
+        parsed = parseGLTF(path, data, size, raw);
+    }
+
+    // raw holds copies, the mapping is no longer needed
+    if (mapped) {
+        file.unmap(mapped);
+    }
+    file.close();
+
+    if (!parsed || !buildMesh(raw, mesh)) {
+        return false;
+    }
+    for (size_t id = 0; id < mesh.materialNames.size(); ++id) {
+        qDebug() << "MeshImporter: Material" << id << "=" << mesh.materialNames[id];
+    }
+    reportProgress(100);
+    return true;
+}
+
+bool MeshImporter::parseSTL(const char* data, size_t size, RawMesh& raw) {
+    // A binary file's size follows from its triangle count. Check that first:
+    // some binary exporters also begin their header with "solid".
+    if (size >= 84) {
+        uint32_t triangles = 0;
+        std::memcpy(&triangles, data + 80, sizeof(triangles));
+        if (84 + 50ull * triangles == size) {
+            return parseBinarySTL(data, size, raw);
+        }
+    }
+    if (size >= 5 && std::memcmp(data, "solid", 5) == 0) {
+        return parseAsciiSTL(data, size, raw);
+    }
+    return fail("Not an STL file (binary size does not match its triangle count)");
+}
+
+bool MeshImporter::parseBinarySTL(const char* data, size_t size, RawMesh& raw) {
+    uint32_t triangles = 0;
+    std::memcpy(&triangles, data + 80, sizeof(triangles));
+    if (triangles == 0) {
+        return fail("STL file contains no triangles");
+    }
+
+    // 50-byte records: normal, three vertices, attribute word. Little-endian,
+    // like every platform this builds for. The stored normal is ignored.
+    raw.positions.resize(static_cast<size_t>(triangles) * 9);
+    const int threads = threadCount();
+    const int chunks = chunkCountFor(triangles, kMinChunkItems, threads);
+    std::atomic<int> done{0};
+    parallelFor(chunks, threads, [&](int c) {
+        auto [begin, end] = chunkRange(triangles, chunks, c);
+        for (size_t t = begin; t < end; ++t) {
+            std::memcpy(&raw.positions[t * 9], data + 84 + t * 50 + 12, 9 * sizeof(float));
+        }
+        reportProgress(60 * ++done / chunks);
+    });
+    return true;
+}
+
+bool MeshImporter::parseAsciiSTL(const char* data, size_t size, RawMesh& raw) {
+    const int threads = threadCount();
+    const int chunkCount = static_cast<int>(std::min<size_t>(std::max<size_t>(1, size / kMinChunkBytes),
+                                                             static_cast<size_t>(threads) * kChunksPerThread));
+    auto chunks = lineChunks(data, size, chunkCount);
+
+    // Only "vertex x y z" lines matter; facets always have three, so chunks
+    // concatenated in order are still a triangle soup
+    std::vector<std::vector<float>> parts(chunks.size());
+    std::atomic<bool> malformed{false};
+    std::atomic<int> done{0};
+    parallelFor(static_cast<int>(chunks.size()), threads, [&](int c) {
+        const char* p = data + chunks[c].first;
+        const char* end = data + chunks[c].second;
+        std::vector<float>& out = parts[c];
+        out.reserve((end - p) / 20);
+        while (p < end) {
+            skipBlanks(p, end);
+            if (startsWithWord(p, end, "vertex", 6)) {
+                p += 6;
+                for (int k = 0; k < 3; ++k) {
+                    float value = 0.0f;
+                    skipBlanks(p, end);
+                    if (!parseFloat(p, end, value)) {
+                        malformed = true;
+                    }
+                    out.push_back(value);
+                }
+            }
+            p = nextLine(p, end);
+        }
+        reportProgress(60 * ++done / static_cast<int>(chunks.size()));
+    });
+
+    if (malformed) {
+        return fail("Malformed vertex line in ASCII STL");
+    }
+    size_t total = 0;
+    for (const auto& part : parts) {
+        total += part.size();
+    }
+    if (total == 0 || total % 9 != 0) {
+        return fail("ASCII STL facets must have exactly three vertices");
+    }
+    raw.positions.reserve(total);
+    for (const auto& part : parts) {
+        raw.positions.insert(raw.positions.end(), part.begin(), part.end());
+    }
+    return true;
+}
+
+bool MeshImporter::parseOBJ(const char* data, size_t size, RawMesh& raw) {
+    const int threads = threadCount();
+    const int chunkCount = static_cast<int>(std::min<size_t>(std::max<size_t>(1, size / kMinChunkBytes),
+                                                             static_cast<size_t>(threads) * kChunksPerThread));
+    auto chunks = lineChunks(data, size, chunkCount);
+
+    // Face corners are 0-based; negative (relative) indices can only be resolved
+    // once the vertex count of the chunks before is known, so they are kept
+    // chunk-relative and listed for a fixup pass
+    // Material switches work the same way: a chunk numbers the usemtl names it
+    // sees, and its triangles before the first one inherit the previous
+    // chunk's last material (kInherit)
+    constexpr int32_t kInherit = -1;
+    struct ObjChunk {
+        std::vector<float> positions;
+        std::vector<int64_t> corners;
+        std::vector<size_t> relativeCorners;
+        std::vector<std::string> materialNames;
+        std::vector<int32_t> triangleMaterials;  // Chunk-local name index per triangle
+        bool malformed = false;
+    };
+    std::vector<ObjChunk> parts(chunks.size());
+    std::atomic<int> done{0};
+    parallelFor(static_cast<int>(chunks.size()), threads, [&](int c) {
+        const char* p = data + chunks[c].first;
+        const char* end = data + chunks[c].second;
+        ObjChunk& out = parts[c];
+        std::vector<int64_t> polygon;
+        std::vector<bool> relative;
+        int32_t material = kInherit;
+
+        while (p < end) {
+            skipBlanks(p, end);
+            if (startsWithWord(p, end, "usemtl", 6)) {
+                p += 6;
+                skipBlanks(p, end);
+                const char* nameEnd = p;
+                while (nameEnd < end && *nameEnd != '\n' && *nameEnd != '\r') {
+                    ++nameEnd;
+                }
+                while (nameEnd > p && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t')) {
+                    --nameEnd;
+                }
+                std::string name(p, nameEnd);
+                auto known = std::find(out.materialNames.begin(), out.materialNames.end(), name);
+                material = static_cast<int32_t>(known - out.materialNames.begin());
+                if (known == out.materialNames.end()) {
+                    out.materialNames.push_back(std::move(name));
+                }
+            } else if (startsWithWord(p, end, "v", 1)) {
+                ++p;
+                for (int k = 0; k < 3; ++k) {
+                    float value = 0.0f;
+                    skipBlanks(p, end);
+                    if (!parseFloat(p, end, value)) {
+                        out.malformed = true;
+                    }
+                    out.positions.push_back(value);
+                }
+            } else if (startsWithWord(p, end, "f", 1)) {
+                ++p;
+                polygon.clear();
+                relative.clear();
+                int64_t localVertices = static_cast<int64_t>(out.positions.size() / 3);
+                for (;;) {
+                    skipBlanks(p, end);
+                    if (p >= end || *p == '\n' || *p == '#') {
+                        break;
+                    }
+                    int64_t index = 0;
+                    if (!parseInt(p, end, index) || index == 0) {
+                        out.malformed = true;
+                        break;
+                    }
+                    // Position index only - skip "/texcoord/normal"
+                    while (p < end && !isBlank(*p) && *p != '\n') {
+                        ++p;
+                    }
+                    polygon.push_back(index > 0 ? index - 1 : localVertices + index);
+                    relative.push_back(index < 0);
+                }
+
+                // Fan triangulation (faces are convex in practice)
+                for (size_t k = 2; k < polygon.size(); ++k) {
+                    const size_t corner[3] = {0, k - 1, k};
+                    for (size_t i : corner) {
+                        if (relative[i]) {
+                            out.relativeCorners.push_back(out.corners.size());
+                        }
+                        out.corners.push_back(polygon[i]);
+                    }
+                    out.triangleMaterials.push_back(material);
+                }
+            }
+            p = nextLine(p, end);
+        }
+        reportProgress(50 * ++done / static_cast<int>(chunks.size()));
+    });
+
+    size_t totalPositions = 0;
+    size_t totalCorners = 0;
+    std::vector<size_t> positionBase(parts.size());
+    std::vector<size_t> cornerBase(parts.size());
+    for (size_t c = 0; c < parts.size(); ++c) {
+        if (parts[c].malformed) {
+            return fail("Malformed vertex or face line in OBJ");
+        }
+        positionBase[c] = totalPositions;
+        cornerBase[c] = totalCorners;
+        totalPositions += parts[c].positions.size() / 3;
+        totalCorners += parts[c].corners.size();
+    }
+    if (totalCorners == 0) {
+        return fail("OBJ file contains no faces");
+    }
+    if (totalPositions >= std::numeric_limits<uint32_t>::max()) {
+        return fail("OBJ file has too many vertices");
+    }
+
+    raw.positions.resize(totalPositions * 3);
+    raw.indices.resize(totalCorners);
+    std::atomic<bool> outOfRange{false};
+    parallelFor(static_cast<int>(parts.size()), threads, [&](int c) {
+        ObjChunk& part = parts[c];
+        for (size_t corner : part.relativeCorners) {
+            part.corners[corner] += static_cast<int64_t>(positionBase[c]);
+        }
+        std::copy(part.positions.begin(), part.positions.end(), raw.positions.begin() + positionBase[c] * 3);
+        for (size_t i = 0; i < part.corners.size(); ++i) {
+            int64_t index = part.corners[i];
+            if (index < 0 || index >= static_cast<int64_t>(totalPositions)) {
+                outOfRange = true;
+                index = 0;
+            }
+            raw.indices[cornerBase[c] + i] = static_cast<uint32_t>(index);
+        }
+        std::vector<float>().swap(part.positions);
+        std::vector<int64_t>().swap(part.corners);
+    });
+    if (outOfRange) {
+        return fail("OBJ face references a vertex that does not exist");
+    }
+
+    // Chunk-local material names -> file-wide IDs in first-use order. Faces
+    // before any usemtl get their own "(default)" material if there is one.
+    bool anyMaterial = std::any_of(parts.begin(), parts.end(),
+                                   [](const ObjChunk& part) { return !part.materialNames.empty(); });
+    if (anyMaterial) {
+        std::unordered_map<std::string, uint32_t> ids;
+        auto idOf = [&](const std::string& name) {
+            auto inserted = ids.try_emplace(name, static_cast<uint32_t>(raw.materialNames.size()));
+            if (inserted.second) {
+                raw.materialNames.push_back(QString::fromStdString(name));
+            }
+            return inserted.first->second;
+        };
+        raw.materials.reserve(totalCorners / 3);
+        std::string current = "(default)";
+        for (ObjChunk& part : parts) {
+            for (int32_t local : part.triangleMaterials) {
+                if (local != kInherit) {
+                    current = part.materialNames[local];
+                }
+                raw.materials.push_back(idOf(current));
+            }
+        }
+    }
+    reportProgress(60);
+    return true;
+}
+
+bool MeshImporter::parseGLTF(const QString& path, const char* data, size_t size, RawMesh& raw) {
+    // .glb: 12-byte header, then a JSON chunk and an optional binary chunk
+    QByteArray json;
+    QByteArray binaryChunk;
+    if (size >= 12 && std::memcmp(data, "glTF", 4) == 0) {
+        uint32_t version = 0;
+        std::memcpy(&version, data + 4, sizeof(version));
+        if (version != 2) {
+            return fail(QString("Unsupported glTF version %1").arg(version));
+        }
+        size_t offset = 12;
+        while (offset + 8 <= size) {
+            uint32_t length = 0;
+            uint32_t type = 0;
+            std::memcpy(&length, data + offset, sizeof(length));
+            std::memcpy(&type, data + offset + 4, sizeof(type));
+            offset += 8;
+            if (offset + length > size) {
+                return fail("Truncated GLB chunk");
+            }
+            if (type == 0x4E4F534Au && json.isEmpty()) {         // "JSON"
+                json = QByteArray(data + offset, static_cast<int>(length));
+            } else if (type == 0x004E4942u && binaryChunk.isEmpty()) {  // "BIN\0"
+                binaryChunk = QByteArray::fromRawData(data + offset, static_cast<int>(length));
+            }
+            offset += (length + 3u) & ~3u;
+        }
+    } else {
+        json = QByteArray::fromRawData(data, static_cast<int>(size));
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    if (!document.isObject()) {
+        return fail(QString("Invalid glTF JSON: %1").arg(parseError.errorString()));
+    }
+    QJsonObject root = document.object();
+
+    // Buffers: the GLB binary chunk, base64 data URIs or files next to the model
+    std::vector<QByteArray> buffers;
+    for (const QJsonValue& value : root["buffers"].toArray()) {
+        QString uri = value.toObject()["uri"].toString();
+        if (uri.isEmpty()) {
+            buffers.push_back(binaryChunk);
+        } else if (uri.startsWith("data:")) {
+            buffers.push_back(QByteArray::fromBase64(uri.mid(uri.indexOf(',') + 1).toLatin1()));
+        } else {
+            QFile bufferFile(QFileInfo(path).dir().filePath(QUrl::fromPercentEncoding(uri.toUtf8())));
+            if (!bufferFile.open(QIODevice::ReadOnly)) {
+                return fail(QString("Cannot open glTF buffer %1").arg(uri));
+            }
+            buffers.push_back(bufferFile.readAll());
+        }
+    }
+
+    // Meshes placed by the default scene's node tree; files without scenes
+    // get every mesh untransformed
+    std::vector<std::pair<int, QMatrix4x4>> placements;
+    QJsonArray nodes = root["nodes"].toArray();
+    QJsonArray scenes = root["scenes"].toArray();
+    if (!scenes.isEmpty()) {
+        QJsonObject scene = scenes.at(root["scene"].toInt(0)).toObject();
+        for (const QJsonValue& node : scene["nodes"].toArray()) {
+            collectGLTFMeshes(nodes, node.toInt(), QMatrix4x4(), 0, placements);
+        }
+    } else {
+        for (int m = 0; m < root["meshes"].toArray().size(); ++m) {
+            placements.push_back({m, QMatrix4x4()});
+        }
+    }
+
+    // glTF material indices -> IDs in first-use order; primitives without one
+    // share a "(default)" material. Recorded per triangle once any primitive
+    // names a material.
+    QJsonArray gltfMaterials = root["materials"].toArray();
+    std::unordered_map<int, uint32_t> materialIds;
+    std::vector<uint32_t> primitiveMaterials;  // Per triangle, filled for every primitive
+    bool anyMaterial = false;
+    auto materialIdOf = [&](int index) {
+        auto inserted = materialIds.try_emplace(index, static_cast<uint32_t>(raw.materialNames.size()));
+        if (inserted.second) {
+            QString name = index < 0 ? QString("(default)")
+                                     : gltfMaterials.at(index).toObject()["name"].toString(QString("material %1").arg(index));
+            raw.materialNames.push_back(name);
+        }
+        return inserted.first->second;
+    };
+
+    QJsonArray meshes = root["meshes"].toArray();
+    int skippedPrimitives = 0;
+    for (size_t placement = 0; placement < placements.size(); ++placement) {
+        const QMatrix4x4& matrix = placements[placement].second;
+        for (const QJsonValue& value : meshes.at(placements[placement].first).toObject()["primitives"].toArray()) {
+            QJsonObject primitive = value.toObject();
+            if (primitive["mode"].toInt(4) != 4) {  // TRIANGLES only
+                ++skippedPrimitives;
+                continue;
+            }
+
+            GLTFAccessor positions;
+            QString error;
+            if (!resolveAccessor(root, buffers, primitive["attributes"].toObject()["POSITION"].toInt(-1), positions, error)) {
+                return fail(error);
+            }
+            if (positions.componentType != 5126 || positions.components != 3) {
+                return fail("glTF POSITION must be float VEC3");
+            }
+
+            size_t base = raw.positions.size() / 3;
+            if (base + positions.count >= std::numeric_limits<uint32_t>::max()) {
+                return fail("glTF file has too many vertices");
+            }
+            int materialIndex = primitive["material"].toInt(-1);
+            anyMaterial = anyMaterial || materialIndex >= 0;
+            uint32_t material = materialIdOf(materialIndex);
+            for (size_t i = 0; i < positions.count; ++i) {
+                float p[3];
+                std::memcpy(p, positions.data + i * positions.stride, sizeof(p));
+                QVector3D world = matrix.map(QVector3D(p[0], p[1], p[2]));
+                raw.positions.push_back(world.x());
+                raw.positions.push_back(world.y());
+                raw.positions.push_back(world.z());
+            }
+
+            if (!primitive.contains("indices")) {
+                for (size_t i = 0; i + 2 < positions.count; i += 3) {
+                    raw.indices.push_back(static_cast<uint32_t>(base + i));
+                    raw.indices.push_back(static_cast<uint32_t>(base + i + 1));
+                    raw.indices.push_back(static_cast<uint32_t>(base + i + 2));
+                }
+                primitiveMaterials.resize(raw.indices.size() / 3, material);
+                continue;
+            }
+
+            GLTFAccessor indices;
+            if (!resolveAccessor(root, buffers, primitive["indices"].toInt(), indices, error)) {
+                return fail(error);
+            }
+            if (indices.components != 1 || (indices.componentType != 5121 && indices.componentType != 5123 &&
+                                             indices.componentType != 5125)) {
+                return fail("glTF indices must be unsigned SCALAR");
+            }
+            for (size_t i = 0; i + 2 < indices.count; i += 3) {
+                for (size_t k = 0; k < 3; ++k) {
+                    const char* element = indices.data + (i + k) * indices.stride;
+                    uint32_t index = 0;
+                    if (indices.componentType == 5121) {
+                        index = static_cast<uint8_t>(*element);
+                    } else if (indices.componentType == 5123) {
+                        uint16_t value16;
+                        std::memcpy(&value16, element, sizeof(value16));
+                        index = value16;
+                    } else {
+                        std::memcpy(&index, element, sizeof(index));
+                    }
+                    if (index >= positions.count) {
+                        return fail("glTF index references a vertex that does not exist");
+                    }
+                    raw.indices.push_back(static_cast<uint32_t>(base + index));
+                }
+            }
+            primitiveMaterials.resize(raw.indices.size() / 3, material);
+        }
+        reportProgress(static_cast<int>(60 * (placement + 1) / placements.size()));
+    }
+
+    if (skippedPrimitives > 0) {
+        qWarning() << "MeshImporter: Skipped" << skippedPrimitives << "non-triangle glTF primitives in" << path;
+    }
+    if (raw.indices.empty()) {
+        return fail("glTF file contains no triangle meshes");
+    }
+    if (anyMaterial) {
+        raw.materials = std::move(primitiveMaterials);
+    } else {
+        raw.materialNames.clear();
+    }
+    return true;
+}
+
+bool MeshImporter::buildMesh(const RawMesh& raw, ImportedMesh& mesh) {
+    const size_t vertexCount = raw.positions.size() / 3;
+    const size_t cornerCount = raw.indices.empty() ? vertexCount : raw.indices.size();
+    if (cornerCount < 3) {
+        return fail("File contains no triangles");
+    }
+    if (vertexCount >= std::numeric_limits<uint32_t>::max()) {
+        return fail("Mesh has too many vertices");
+    }
+
+    const int threads = threadCount();
+    const int chunks = chunkCountFor(vertexCount, kMinChunkItems, threads);
+
+    // 1. Hash every position into a shard, counting shard sizes per chunk
+    std::vector<uint8_t> shards(vertexCount);
+    std::vector<std::array<size_t, kWeldShards>> chunkCounts(chunks);
+    parallelFor(chunks, threads, [&](int c) {
+        chunkCounts[c].fill(0);
+        auto [begin, end] = chunkRange(vertexCount, chunks, c);
+        for (size_t v = begin; v < end; ++v) {
+            int shard = shardOf(positionKey(raw.positions, v));
+            shards[v] = static_cast<uint8_t>(shard);
+            ++chunkCounts[c][shard];
+        }
+    });
+
+    // 2. Bucket vertex ids by shard, in vertex order within each shard
+    std::vector<size_t> shardStart(kWeldShards + 1, 0);
+    std::vector<std::array<size_t, kWeldShards>> chunkOffsets(chunks);
+    for (int s = 0; s < kWeldShards; ++s) {
+        size_t offset = shardStart[s];
+        for (int c = 0; c < chunks; ++c) {
+            chunkOffsets[c][s] = offset;
+            offset += chunkCounts[c][s];
+        }
+        shardStart[s + 1] = offset;
+    }
+    std::vector<uint32_t> members(vertexCount);
+    parallelFor(chunks, threads, [&](int c) {
+        auto [begin, end] = chunkRange(vertexCount, chunks, c);
+        std::array<size_t, kWeldShards>& offsets = chunkOffsets[c];
+        for (size_t v = begin; v < end; ++v) {
+            members[offsets[shards[v]]++] = static_cast<uint32_t>(v);
+        }
+    });
+    reportProgress(70);
+
+    // 3. Weld each shard on its own; ids are shard-local for now
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<std::vector<uint32_t>> shardUnique(kWeldShards);  // First source vertex of each welded vertex
+    parallelFor(kWeldShards, threads, [&](int s) {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> welded;
+        welded.reserve(shardStart[s + 1] - shardStart[s]);
+        for (size_t m = shardStart[s]; m < shardStart[s + 1]; ++m) {
+            uint32_t v = members[m];
+            auto inserted = welded.try_emplace(positionKey(raw.positions, v), static_cast<uint32_t>(shardUnique[s].size()));
+            if (inserted.second) {
+                shardUnique[s].push_back(v);
+            }
+            remap[v] = inserted.first->second;
+        }
+    });
+    reportProgress(80);
+
+    // 4. Shard-local ids -> (shard-ordered) global ids
+    std::vector<uint32_t> uniqueBase(kWeldShards + 1, 0);
+    for (int s = 0; s < kWeldShards; ++s) {
+        uniqueBase[s + 1] = uniqueBase[s] + static_cast<uint32_t>(shardUnique[s].size());
+    }
+    const size_t weldedCount = uniqueBase[kWeldShards];
+    parallelFor(chunks, threads, [&](int c) {
+        auto [begin, end] = chunkRange(vertexCount, chunks, c);
+        for (size_t v = begin; v < end; ++v) {
+            remap[v] += uniqueBase[shards[v]];
+        }
+    });
+    std::vector<uint32_t> weldedSource(weldedCount);
+    parallelFor(kWeldShards, threads, [&](int s) {
+        std::copy(shardUnique[s].begin(), shardUnique[s].end(), weldedSource.begin() + uniqueBase[s]);
+    });
+
+    // 5. Remap triangles, dropping those that welding collapsed, and number
+    // vertices by first use so they follow the index stream (shard order is
+    // effectively random) and unreferenced vertices are dropped
+    constexpr uint32_t kUnused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> finalId(weldedCount, kUnused);
+    std::vector<uint32_t> order;  // final id -> welded id
+    order.reserve(weldedCount);
+    mesh.indices.clear();
+    mesh.indices.reserve(cornerCount);
+    mesh.materialIds.clear();
+    mesh.materialNames = raw.materialNames;
+    const bool hasMaterials = raw.materials.size() == cornerCount / 3;
+    for (size_t corner = 0; corner + 2 < cornerCount; corner += 3) {
+        uint32_t tri[3];
+        for (int k = 0; k < 3; ++k) {
+            tri[k] = remap[raw.indices.empty() ? corner + k : raw.indices[corner + k]];
+        }
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+            continue;
+        }
+        for (uint32_t& v : tri) {
+            if (finalId[v] == kUnused) {
+                finalId[v] = static_cast<uint32_t>(order.size());
+                order.push_back(v);
+            }
+            v = finalId[v];
+        }
+        mesh.indices.insert(mesh.indices.end(), tri, tri + 3);
+        if (hasMaterials) {
+            mesh.materialIds.push_back(raw.materials[corner / 3]);
+        }
+    }
+    if (!hasMaterials) {
+        mesh.materialNames.clear();
+    }
+    if (mesh.indices.empty()) {
+        return fail("Every triangle is degenerate");
+    }
+
+    const size_t uniqueCount = order.size();
+    mesh.vertices.assign(uniqueCount * 6, 0.0f);
+    const int copyChunks = chunkCountFor(uniqueCount, kMinChunkItems, threads);
+    parallelFor(copyChunks, threads, [&](int c) {
+        auto [begin, end] = chunkRange(uniqueCount, copyChunks, c);
+        for (size_t v = begin; v < end; ++v) {
+            const float* src = &raw.positions[static_cast<size_t>(weldedSource[order[v]]) * 3];
+            std::copy(src, src + 3, &mesh.vertices[v * 6]);
+        }
+    });
+    reportProgress(90);
+
+    // 6. Area-weighted vertex normals and bounds
+    std::vector<QVector3D> normals(uniqueCount);
+    auto position = [&mesh](uint32_t v) {
+        return QVector3D(mesh.vertices[v * 6], mesh.vertices[v * 6 + 1], mesh.vertices[v * 6 + 2]);
+    };
+    for (size_t corner = 0; corner < mesh.indices.size(); corner += 3) {
+        uint32_t a = mesh.indices[corner];
+        uint32_t b = mesh.indices[corner + 1];
+        uint32_t c = mesh.indices[corner + 2];
+        QVector3D faceNormal = QVector3D::crossProduct(position(b) - position(a), position(c) - position(a));
+        normals[a] += faceNormal;
+        normals[b] += faceNormal;
+        normals[c] += faceNormal;
+    }
+
+    const float inf = std::numeric_limits<float>::infinity();
+    mesh.boundsMin = QVector3D(inf, inf, inf);
+    mesh.boundsMax = QVector3D(-inf, -inf, -inf);
+    for (size_t v = 0; v < uniqueCount; ++v) {
+        QVector3D n = normals[v].isNull() ? QVector3D(0.0f, 0.0f, 1.0f) : normals[v].normalized();
+        mesh.vertices[v * 6 + 3] = n.x();
+        mesh.vertices[v * 6 + 4] = n.y();
+        mesh.vertices[v * 6 + 5] = n.z();
+        for (int axis = 0; axis < 3; ++axis) {
+            mesh.boundsMin[axis] = std::min(mesh.boundsMin[axis], mesh.vertices[v * 6 + axis]);
+            mesh.boundsMax[axis] = std::max(mesh.boundsMax[axis], mesh.vertices[v * 6 + axis]);
+        }
+    }
+    mesh.sourceVertexCount = vertexCount;
+    return true;
+}
@@ -0,0 +1,80 @@
+// MeshImporter.h - OBJ/STL/glTF mesh import (no GL, any thread)
+#pragma once
+
+#include <QString>
+#include <QVector3D>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+// A loaded mesh in the layout BVHBuilder::build and WireframeTarget use:
+// interleaved [x,y,z,nx,ny,nz] vertices and three indices per triangle.
+// Positions are welded, so triangles share vertices and normals are smooth.
+struct ImportedMesh {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    // Material table index per triangle (OBJ usemtl, glTF primitive material),
+    // numbered by first use; empty = one material. materialNames[id] names it.
+    std::vector<uint32_t> materialIds;
+    std::vector<QString> materialNames;
+    QVector3D boundsMin;
+    QVector3D boundsMax;
+    size_t sourceVertexCount = 0;  // Vertices referenced by the file, before welding
+
+    size_t triangleCount() const { return indices.size() / 3; }
+};
+
+using ImportedMeshPtr = std::shared_ptr<const ImportedMesh>;
+
+// Loads binary/ASCII STL, Wavefront OBJ and glTF 2.0 (.gltf/.glb). The file
+// is memory-mapped; STL and OBJ text is parsed in line-aligned chunks on
+// worker threads, then identical positions are welded in parallel hash
+// shards. load() blocks, so callers off the GL thread run it on a worker
+// (ModelManager::loadModel) and receive progress through the callback.
+class MeshImporter {
+public:
+    // Percent complete (0-100). May be called from worker threads, never concurrently.
+    using ProgressCallback = std::function<void(int percent)>;
+
+    MeshImporter() = default;
+
+    // True for the extensions load() understands
+    static bool isSupportedFile(const QString& path);
+
+    // Returns false on failure; errorString() says why
+    bool load(const QString& path, ImportedMesh& mesh, const ProgressCallback& progress = ProgressCallback());
+    const QString& errorString() const { return error_; }
+
+    // Parsing/welding threads (0 = one per hardware thread)
+    void setThreadCount(int threads) { threadCount_ = threads; }
+
+private:
+    // Unwelded triangle soup or indexed mesh straight from the file
+    struct RawMesh {
+        std::vector<float> positions;   // xyz per source vertex
+        std::vector<uint32_t> indices;  // Empty = every three positions form a triangle
+        std::vector<uint32_t> materials;  // Per triangle, empty = one material
+        std::vector<QString> materialNames;
+    };
+
+    bool parseSTL(const char* data, size_t size, RawMesh& raw);
+    bool parseBinarySTL(const char* data, size_t size, RawMesh& raw);
+    bool parseAsciiSTL(const char* data, size_t size, RawMesh& raw);
+    bool parseOBJ(const char* data, size_t size, RawMesh& raw);
+    bool parseGLTF(const QString& path, const char* data, size_t size, RawMesh& raw);
+
+    // Welds positions, drops degenerate triangles and builds area-weighted normals
+    bool buildMesh(const RawMesh& raw, ImportedMesh& mesh);
+
+    int threadCount() const;
+    void reportProgress(int percent);
+    bool fail(const QString& message);
+
+    QString error_;
+    int threadCount_ = 0;
+    ProgressCallback progress_;
+    std::mutex progressMutex_;
+    int lastPercent_ = -1;  // Progress is reported monotonically
+};
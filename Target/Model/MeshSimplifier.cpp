@@ -0,0 +1,340 @@
+// MeshSimplifier.cpp - Quadric edge-collapse simplification for display LODs (no GL, any thread)
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Round r accepts collapses costing up to kBaseThreshold * (r + 3)^kAggressiveness,
+// in a mesh scaled to a unit box. Cheap (flat) collapses go first, and the
+// threshold outgrows any cost well before kMaxRounds.
+constexpr double kBaseThreshold = 1e-9;
+constexpr double kAggressiveness = 7.0;
+constexpr int kMaxRounds = 100;
+constexpr int kCompactInterval = 5;       // Rounds between dropping deleted triangles
+constexpr float kFlipMinCos = 0.2f;       // A neighbour may turn by at most ~78 degrees
+constexpr float kCollinearCos = 0.999f;   // Rejects collapses that leave sliver triangles
+constexpr double kMinLevelReduction = 0.9;  // A level must drop at least 10% of the previous one
+
+QVector3D faceNormal(const QVector3D& p0, const QVector3D& p1, const QVector3D& p2) {
+    return QVector3D::crossProduct(p1 - p0, p2 - p0);
+}
+
+} // namespace
+
+void MeshSimplifier::Quadric::addPlane(double a, double b, double c, double d) {
+    m[0] += a * a; m[1] += a * b; m[2] += a * c; m[3] += a * d;
+    m[4] += b * b; m[5] += b * c; m[6] += b * d;
+    m[7] += c * c; m[8] += c * d;
+    m[9] += d * d;
+}
+
+MeshSimplifier::Quadric& MeshSimplifier::Quadric::operator+=(const Quadric& other) {
+    for (int i = 0; i < 10; ++i) {
+        m[i] += other.m[i];
+    }
+    return *this;
+}
+
+double MeshSimplifier::Quadric::error(const QVector3D& p) const {
+    double x = p.x(), y = p.y(), z = p.z();
+    return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x
+         + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y
+         + m[7] * z * z + 2 * m[8] * z
+         + m[9];
+}
+
+MeshSimplifier::MeshSimplifier(const float* vertices, size_t vertexCount, size_t stride,
+                               const uint32_t* indices, size_t indexCount)
+{
+    positions_.resize(vertexCount);
+    verts_.resize(vertexCount);
+
+    QVector3D lo(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    QVector3D hi = -lo;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* v = vertices + i * stride;
+        positions_[i] = QVector3D(v[0], v[1], v[2]);
+        lo = QVector3D(std::min(lo.x(), v[0]), std::min(lo.y(), v[1]), std::min(lo.z(), v[2]));
+        hi = QVector3D(std::max(hi.x(), v[0]), std::max(hi.y(), v[1]), std::max(hi.z(), v[2]));
+        verts_[i].origin = static_cast<uint32_t>(i);
+    }
+    if (vertexCount > 0) {
+        QVector3D extent = hi - lo;
+        float size = std::max({extent.x(), extent.y(), extent.z()});
+        float scale = size > 0.0f ? 1.0f / size : 1.0f;
+        QVector3D center = (lo + hi) * 0.5f;
+        for (auto& p : positions_) {
+            p = (p - center) * scale;
+        }
+    }
+
+    tris_.reserve(indexCount / 3);
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        if (a >= vertexCount || b >= vertexCount || c >= vertexCount || a == b || b == c || a == c) {
+            continue;
+        }
+
+        Triangle t;
+        t.v[0] = a;
+        t.v[1] = b;
+        t.v[2] = c;
+        QVector3D n = faceNormal(positions_[a], positions_[b], positions_[c]);
+        if (n.lengthSquared() > 0.0f) {
+            n.normalize();
+            double d = -QVector3D::dotProduct(n, positions_[a]);
+            Quadric q;
+            q.addPlane(n.x(), n.y(), n.z(), d);
+            verts_[a].q += q;
+            verts_[b].q += q;
+            verts_[c].q += q;
+        }
+        t.normal = n;
+        tris_.push_back(t);
+    }
+    liveTriangles_ = tris_.size();
+
+    rebuildRefs(false);
+    markBorders();
+    for (auto& t : tris_) {
+        updateErrors(t);
+    }
+}
+
+void MeshSimplifier::rebuildRefs(bool compact) {
+    if (compact) {
+        tris_.erase(std::remove_if(tris_.begin(), tris_.end(), [](const Triangle& t) { return t.deleted; }),
+                    tris_.end());
+    }
+
+    for (auto& v : verts_) {
+        v.refCount = 0;
+    }
+    for (const auto& t : tris_) {
+        for (uint32_t k = 0; k < 3; ++k) {
+            verts_[t.v[k]].refCount++;
+        }
+    }
+    uint32_t start = 0;
+    for (auto& v : verts_) {
+        v.refStart = start;
+        start += v.refCount;
+        v.refCount = 0;
+    }
+    refs_.resize(start);
+    for (size_t i = 0; i < tris_.size(); ++i) {
+        for (uint32_t k = 0; k < 3; ++k) {
+            Vertex& v = verts_[tris_[i].v[k]];
+            refs_[v.refStart + v.refCount++] = {static_cast<uint32_t>(i), k};
+        }
+    }
+}
+
+// A vertex is on a border if one of its edges belongs to a single triangle
+void MeshSimplifier::markBorders() {
+    std::vector<uint32_t> neighbours;
+    for (auto& v : verts_) {
+        neighbours.clear();
+        for (uint32_t k = 0; k < v.refCount; ++k) {
+            const Triangle& t = tris_[refs_[v.refStart + k].triangle];
+            uint32_t corner = refs_[v.refStart + k].corner;
+            neighbours.push_back(t.v[(corner + 1) % 3]);
+            neighbours.push_back(t.v[(corner + 2) % 3]);
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        for (size_t i = 0; i < neighbours.size() && !v.border;) {
+            size_t j = i + 1;
+            while (j < neighbours.size() && neighbours[j] == neighbours[i]) {
+                ++j;
+            }
+            v.border = (j - i) == 1;
+            i = j;
+        }
+    }
+}
+
+// Cost of collapsing edge (a, b) onto whichever endpoint is cheaper
+float MeshSimplifier::edgeError(uint32_t a, uint32_t b, bool& keepB) const {
+    Quadric q = verts_[a].q;
+    q += verts_[b].q;
+    double errorA = q.error(positions_[a]);
+    double errorB = q.error(positions_[b]);
+    keepB = errorB < errorA;
+    return static_cast<float>(std::max(0.0, std::min(errorA, errorB)));
+}
+
+void MeshSimplifier::updateErrors(Triangle& t) {
+    bool keepB;
+    for (int j = 0; j < 3; ++j) {
+        t.err[j] = edgeError(t.v[j], t.v[(j + 1) % 3], keepB);
+    }
+    t.minErr = std::min({t.err[0], t.err[1], t.err[2]});
+}
+
+// True if moving `vertex` to p would fold or degenerate one of its triangles.
+// Marks the triangles that also use `other` (they disappear in the collapse).
+bool MeshSimplifier::flips(uint32_t vertex, uint32_t other, const QVector3D& p, std::vector<char>& removed) const {
+    const Vertex& v = verts_[vertex];
+    for (uint32_t k = 0; k < v.refCount; ++k) {
+        const TriangleRef& r = refs_[v.refStart + k];
+        const Triangle& t = tris_[r.triangle];
+        if (t.deleted) {
+            continue;
+        }
+
+        uint32_t id1 = t.v[(r.corner + 1) % 3];
+        uint32_t id2 = t.v[(r.corner + 2) % 3];
+        if (id1 == other || id2 == other) {
+            removed[k] = 1;
+            continue;
+        }
+        removed[k] = 0;
+
+        QVector3D d1 = (positions_[id1] - p).normalized();
+        QVector3D d2 = (positions_[id2] - p).normalized();
+        if (std::fabs(QVector3D::dotProduct(d1, d2)) > kCollinearCos) {
+            return true;
+        }
+        QVector3D n = QVector3D::crossProduct(d1, d2).normalized();
+        if (QVector3D::dotProduct(n, t.normal) < kFlipMinCos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Points the live triangles of `vertex` at `survivor` and appends their refs
+void MeshSimplifier::retarget(uint32_t survivor, uint32_t vertex, const std::vector<char>& removed) {
+    const Vertex& v = verts_[vertex];
+    for (uint32_t k = 0; k < v.refCount; ++k) {
+        TriangleRef r = refs_[v.refStart + k];
+        Triangle& t = tris_[r.triangle];
+        if (t.deleted) {
+            continue;
+        }
+        if (removed[k]) {
+            t.deleted = true;
+            liveTriangles_--;
+            continue;
+        }
+
+        t.v[r.corner] = survivor;
+        t.dirty = true;
+        QVector3D n = faceNormal(positions_[t.v[0]], positions_[t.v[1]], positions_[t.v[2]]);
+        if (n.lengthSquared() > 0.0f) {
+            t.normal = n.normalized();
+        }
+        updateErrors(t);
+        refs_.push_back(r);
+    }
+}
+
+bool MeshSimplifier::simplify(size_t targetTriangles, const std::atomic<bool>* cancel) {
+    std::vector<char> removedA, removedB;
+
+    for (int round = 0; round < kMaxRounds && liveTriangles_ > targetTriangles; ++round) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (round % kCompactInterval == 0) {
+            rebuildRefs(true);
+        }
+        for (auto& t : tris_) {
+            t.dirty = false;
+        }
+
+        // Triangles touched this round wait for the next one, so each round
+        // sees a consistent neighbourhood
+        const float threshold = static_cast<float>(kBaseThreshold * std::pow(round + 3.0, kAggressiveness));
+        for (size_t i = 0; i < tris_.size() && liveTriangles_ > targetTriangles; ++i) {
+            Triangle& t = tris_[i];
+            if (t.deleted || t.dirty || t.minErr > threshold) {
+                continue;
+            }
+
+            for (int j = 0; j < 3; ++j) {
+                if (t.err[j] > threshold) {
+                    continue;
+                }
+                uint32_t a = t.v[j];
+                uint32_t b = t.v[(j + 1) % 3];
+                if (verts_[a].border != verts_[b].border) {
+                    continue;
+                }
+
+                bool keepB;
+                edgeError(a, b, keepB);
+                const QVector3D p = keepB ? positions_[b] : positions_[a];
+
+                removedA.resize(verts_[a].refCount);
+                removedB.resize(verts_[b].refCount);
+                if (flips(a, b, p, removedA) || flips(b, a, p, removedB)) {
+                    continue;
+                }
+
+                // a survives, holding the kept endpoint's position and source vertex
+                positions_[a] = p;
+                if (keepB) {
+                    verts_[a].origin = verts_[b].origin;
+                }
+                verts_[a].q += verts_[b].q;
+
+                size_t start = refs_.size();
+                retarget(a, a, removedA);
+                retarget(a, b, removedB);
+                size_t count = refs_.size() - start;
+                if (count <= verts_[a].refCount) {
+                    std::copy(refs_.begin() + start, refs_.end(), refs_.begin() + verts_[a].refStart);
+                    refs_.resize(start);
+                } else {
+                    verts_[a].refStart = static_cast<uint32_t>(start);
+                }
+                verts_[a].refCount = static_cast<uint32_t>(count);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void MeshSimplifier::appendIndices(std::vector<uint32_t>& out) const {
+    out.reserve(out.size() + liveTriangles_ * 3);
+    for (const auto& t : tris_) {
+        if (!t.deleted) {
+            out.push_back(verts_[t.v[0]].origin);
+            out.push_back(verts_[t.v[1]].origin);
+            out.push_back(verts_[t.v[2]].origin);
+        }
+    }
+}
+
+bool MeshSimplifier::buildLodChain(const float* vertices, size_t vertexCount, size_t stride,
+                                   const uint32_t* indices, size_t indexCount,
+                                   float ratio, size_t minTriangles, MeshLodChain& chain,
+                                   const std::atomic<bool>* cancel)
+{
+    chain.indices.clear();
+    chain.levels.clear();
+
+    MeshSimplifier simplifier(vertices, vertexCount, stride, indices, indexCount);
+    size_t current = simplifier.triangleCount();
+    while (current > minTriangles) {
+        size_t target = std::max(minTriangles, static_cast<size_t>(current * ratio));
+        if (!simplifier.simplify(target, cancel)) {
+            return false;
+        }
+        if (simplifier.triangleCount() > current * kMinLevelReduction) {
+            break;  // Nothing left that collapses without folding the surface
+        }
+
+        MeshLodLevel level;
+        level.indexOffset = chain.indices.size();
+        simplifier.appendIndices(chain.indices);
+        level.indexCount = chain.indices.size() - level.indexOffset;
+        chain.levels.push_back(level);
+        current = simplifier.triangleCount();
+    }
+    return true;
+}
@@ -0,0 +1,96 @@
+// MeshSimplifier.h - Quadric edge-collapse simplification for display LODs (no GL, any thread)
+#pragma once
+
+#include <QVector3D>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+// One level of a chain: a range of MeshLodChain::indices
+struct MeshLodLevel {
+    size_t indexOffset = 0;
+    size_t indexCount = 0;
+
+    size_t triangleCount() const { return indexCount / 3; }
+};
+
+// Progressively coarser index buffers over the source vertex array, finest
+// first. Every index refers to an original vertex, so all levels draw from
+// the source VBO and can share a single EBO.
+struct MeshLodChain {
+    std::vector<uint32_t> indices;
+    std::vector<MeshLodLevel> levels;
+};
+
+// Garland-Heckbert quadric error simplification with collapse onto the
+// cheaper endpoint (no new vertices). Collapses run in rounds with a rising
+// error threshold instead of a priority queue, which keeps the state flat
+// and the cost linear per round. simplify() may be called again with a lower
+// target to continue from the current result.
+class MeshSimplifier {
+public:
+    // vertices: `stride` floats per vertex, position first
+    MeshSimplifier(const float* vertices, size_t vertexCount, size_t stride,
+                   const uint32_t* indices, size_t indexCount);
+
+    // Collapses edges until at most targetTriangles remain or no collapse is
+    // acceptable. Returns false if cancel was raised.
+    bool simplify(size_t targetTriangles, const std::atomic<bool>* cancel = nullptr);
+
+    size_t triangleCount() const { return liveTriangles_; }
+
+    // Appends the current triangles as original vertex indices
+    void appendIndices(std::vector<uint32_t>& out) const;
+
+    // Levels reduced by `ratio` each step while they stay above minTriangles.
+    // Level 0 is not included (it is the source mesh). Returns false if cancelled.
+    static bool buildLodChain(const float* vertices, size_t vertexCount, size_t stride,
+                              const uint32_t* indices, size_t indexCount,
+                              float ratio, size_t minTriangles, MeshLodChain& chain,
+                              const std::atomic<bool>* cancel = nullptr);
+
+private:
+    // Symmetric 4x4 plane quadric, upper triangle
+    struct Quadric {
+        double m[10] = {};
+
+        void addPlane(double a, double b, double c, double d);
+        Quadric& operator+=(const Quadric& other);
+        double error(const QVector3D& p) const;
+    };
+
+    struct Triangle {
+        uint32_t v[3];
+        float err[3];       // Collapse cost of edge (v[i], v[i+1])
+        float minErr;
+        QVector3D normal;
+        bool deleted = false;
+        bool dirty = false;
+    };
+
+    struct Vertex {
+        Quadric q;
+        uint32_t refStart = 0;
+        uint32_t refCount = 0;
+        uint32_t origin = 0;  // Source vertex whose position this one holds
+        bool border = false;
+    };
+
+    struct TriangleRef {
+        uint32_t triangle;
+        uint32_t corner;
+    };
+
+    void rebuildRefs(bool compact);
+    void markBorders();
+    float edgeError(uint32_t a, uint32_t b, bool& keepB) const;
+    void updateErrors(Triangle& t);
+    bool flips(uint32_t vertex, uint32_t other, const QVector3D& p, std::vector<char>& removed) const;
+    void retarget(uint32_t survivor, uint32_t vertex, const std::vector<char>& removed);
+
+    std::vector<QVector3D> positions_;  // Normalized to a unit box so thresholds are scale-free
+    std::vector<Vertex> verts_;
+    std::vector<Triangle> tris_;
+    std::vector<TriangleRef> refs_;
+    size_t liveTriangles_ = 0;
+};
@@ -1,19 +1,84 @@
 // ModelManager.cpp
 #include "ModelManager.h"
+#include "TargetCache.h"
 #include <QDebug>
 #include <QQuaternion>
+#include <QFileInfo>
+#include <QOpenGLContext>
 
 // We'll need to define the Model class later
 class Model {
 public:
     virtual ~Model() {}
     virtual void render(QOpenGLFunctions_4_5_Core* gl, QOpenGLShaderProgram* program) = 0;
+    // Frees GL objects; called with the context current
+    virtual void releaseGL(QOpenGLFunctions_4_5_Core* gl) { (void)gl; }
+    virtual ImportedMeshPtr mesh() const { return nullptr; }
 
     QVector3D position = QVector3D(0, 0, 0);
     QVector3D rotation = QVector3D(0, 0, 0);
     float scale = 1.0f;
 };
 
+// Model imported by MeshImporter. Buffers are created on the first render, so
+// the import itself never needs the GL thread.
+class MeshModel : public Model {
+public:
+    explicit MeshModel(ImportedMeshPtr mesh) : mesh_(std::move(mesh)) {}
+
+    void render(QOpenGLFunctions_4_5_Core* gl, QOpenGLShaderProgram* program) override {
+        if (vao_ == 0) {
+            upload(gl);
+        }
+        program->setUniformValue("useTexture", false);
+        program->setUniformValue("objectColor", QVector3D(0.7f, 0.7f, 0.75f));
+        gl->glBindVertexArray(vao_);
+        gl->glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh_->indices.size()), GL_UNSIGNED_INT, nullptr);
+        gl->glBindVertexArray(0);
+    }
+
+    void releaseGL(QOpenGLFunctions_4_5_Core* gl) override {
+        if (vao_ != 0) {
+            gl->glDeleteVertexArrays(1, &vao_);
+            gl->glDeleteBuffers(1, &vbo_);
+            gl->glDeleteBuffers(1, &ebo_);
+            vao_ = vbo_ = ebo_ = 0;
+        }
+    }
+
+    ImportedMeshPtr mesh() const override { return mesh_; }
+
+private:
+    void upload(QOpenGLFunctions_4_5_Core* gl) {
+        gl->glGenVertexArrays(1, &vao_);
+        gl->glGenBuffers(1, &vbo_);
+        gl->glGenBuffers(1, &ebo_);
+        gl->glBindVertexArray(vao_);
+
+        gl->glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        gl->glBufferData(GL_ARRAY_BUFFER, mesh_->vertices.size() * sizeof(float),
+                         mesh_->vertices.data(), GL_STATIC_DRAW);
+        gl->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+        gl->glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh_->indices.size() * sizeof(uint32_t),
+                         mesh_->indices.data(), GL_STATIC_DRAW);
+
+        // Position (location 0) and normal (location 1); no texture coordinates
+        gl->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+        gl->glEnableVertexAttribArray(0);
+        gl->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
+                                  reinterpret_cast<void*>(3 * sizeof(float)));
+        gl->glEnableVertexAttribArray(1);
+        gl->glVertexAttrib2f(2, 0.0f, 0.0f);
+
+        gl->glBindVertexArray(0);
+    }
+
+    ImportedMeshPtr mesh_;
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+    GLuint ebo_ = 0;
+};
+
 ModelManager::ModelManager(QObject* parent)
     : QObject(parent)
 {
@@ -81,7 +146,15 @@ ModelManager::ModelManager(QObject* parent)
 }
 
 ModelManager::~ModelManager() {
+    // Imports cannot be interrupted; wait for them so no worker outlives us
+    for (auto& loader : loaders_) {
+        loader.second.join();
+    }
+
     // Clean up OpenGL resources
+    if (QOpenGLContext::currentContext()) {
+        releaseModels();
+    }
     modelShaderProgram_.reset();
 
     // Clear models
@@ -107,14 +180,98 @@ bool ModelManager::initialize() {
 }
 
 bool ModelManager::loadModel(const std::string& filename, const QVector3D& position) {
-    // We'll implement actual model loading in a future step
-    // For now, return false to indicate failure
-    return false;
+    QString path = QString::fromStdString(filename);
+    if (!MeshImporter::isSupportedFile(path)) {
+        qWarning() << "ModelManager: Unsupported model format:" << path;
+        return false;
+    }
+    if (!QFileInfo(path).exists()) {
+        qWarning() << "ModelManager: Model file not found:" << path;
+        return false;
+    }
+
+    // Parse on a worker; progress and the result come back as queued calls so
+    // every signal is emitted on the manager's (GL) thread
+    int loadId = nextLoadId_++;
+    loaders_[loadId] = std::thread([this, loadId, path, position]() {
+        auto progress = [this, path](int percent) {
+            QMetaObject::invokeMethod(this, [this, path, percent]() {
+                emit modelLoadProgress(path, percent);
+            }, Qt::QueuedConnection);
+        };
+
+        // A file seen before is read back from the target cache instead of parsed
+        RCS::TargetCache cache;
+        RCS::CachedTarget cached;
+        ImportedMeshPtr result;
+        QString error;
+        if (cache.load(path, cached)) {
+            result = cached.mesh;
+            progress(100);
+        } else {
+            MeshImporter importer;
+            auto mesh = std::make_shared<ImportedMesh>();
+            if (importer.load(path, *mesh, progress)) {
+                // Mesh only; a sweep over the model adds the BVH and edges
+                if (!cache.store(path, *mesh, nullptr, {})) {
+                    qWarning() << "ModelManager: Could not cache" << path << "-" << cache.errorString();
+                }
+                result = std::move(mesh);
+            }
+            error = importer.errorString();
+        }
+        QMetaObject::invokeMethod(this, [this, loadId, path, position, result, error]() {
+            finishLoad(loadId, path, position, result, error);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void ModelManager::finishLoad(int loadId, const QString& filename, const QVector3D& position,
+                              ImportedMeshPtr mesh, const QString& error) {
+    auto loader = loaders_.find(loadId);
+    if (loader != loaders_.end()) {
+        loader->second.join();  // The worker's last act was posting this call
+        loaders_.erase(loader);
+    }
+
+    if (!mesh) {
+        qWarning() << "ModelManager: Failed to load" << filename << "-" << error;
+        emit modelLoadFailed(filename, error);
+        return;
+    }
+
+    qDebug() << "ModelManager: Loaded" << filename << "-" << mesh->triangleCount() << "triangles,"
+             << mesh->vertices.size() / 6 << "vertices";
+    auto model = std::make_shared<MeshModel>(std::move(mesh));
+    model->position = position;
+    models_.push_back(model);
+    emit modelAdded(static_cast<int>(models_.size()) - 1);
+    emit modelCountChanged(static_cast<int>(models_.size()));
+}
+
+void ModelManager::releaseModels() {
+    for (const auto& model : models_) {
+        model->releaseGL(this);
+    }
+    for (const auto& model : retiredModels_) {
+        model->releaseGL(this);
+    }
+    retiredModels_.clear();
+}
+
+ImportedMeshPtr ModelManager::getModelMesh(int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= models_.size()) {
+        return nullptr;
+    }
+    return models_[index]->mesh();
 }
 
 void ModelManager::removeModel(int index) {
     if (index < 0) return;
     if (static_cast<size_t>(index) < models_.size()) {
+        // GL objects are freed on the next render(), when the context is current
+        retiredModels_.push_back(models_[index]);
         models_.erase(models_.begin() + index);
         emit modelRemoved(index);
         emit modelCountChanged(static_cast<int>(models_.size()));
@@ -122,6 +279,7 @@ void ModelManager::removeModel(int index) {
 }
 
 void ModelManager::clearAllModels() {
+    retiredModels_.insert(retiredModels_.end(), models_.begin(), models_.end());
     models_.clear();
     emit modelCountChanged(0);
 }
@@ -148,6 +306,11 @@ void ModelManager::setModelScale(int index, float scale) {
 }
 
 void ModelManager::render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& model) {
+    for (const auto& retired : retiredModels_) {
+        retired->releaseGL(this);
+    }
+    retiredModels_.clear();
+
     if (models_.empty() || !modelShaderProgram_) {
         return;
     }
@@ -197,13 +360,13 @@ bool ModelManager::setupShaders() {
 
     modelShaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
-    if (!modelShaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
+    if (!modelShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
         qCritical() << "ModelManager: Failed to compile vertex shader:" << modelShaderProgram_->log();
         modelShaderProgram_.reset();
         return false;
     }
 
-    if (!modelShaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+    if (!modelShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
         qCritical() << "ModelManager: Failed to compile fragment shader:" << modelShaderProgram_->log();
         modelShaderProgram_.reset();
         return false;
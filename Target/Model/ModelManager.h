@@ -12,6 +12,10 @@
 #include <string>
 #include <string_view>
 #include <memory>
+#include <map>
+#include <thread>
+
+#include "MeshImporter.h"
 
 // Forward declaration for model class
 class Model;
@@ -27,7 +31,12 @@ public:
     bool initialize();
 
     // Model management
+    // Starts importing an STL/OBJ/glTF file on a worker thread and returns
+    // immediately (false if the file cannot be loaded at all). Progress arrives
+    // through modelLoadProgress; the model is added, with modelAdded, on the
+    // thread that owns the manager once parsing finishes.
     bool loadModel(const std::string& filename, const QVector3D& position = QVector3D(0, 0, 0));
+    bool isLoading() const { return !loaders_.empty(); }
     void removeModel(int index);
     void clearAllModels();
 
@@ -36,6 +45,11 @@ public:
     void setModelRotation(int index, const QVector3D& eulerAngles);
     void setModelScale(int index, float scale);
 
+    // Imported geometry of a model (shared, immutable), e.g. for MeshWireframe
+    // targets or RCS ray tracing. Null for out-of-range indices.
+    ImportedMeshPtr getModelMesh(int index) const;
+    int getModelCount() const { return static_cast<int>(models_.size()); }
+
     // Rendering
     void render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& model);
 
@@ -47,6 +61,8 @@ signals:
     void modelAdded(int index);
     void modelRemoved(int index);
     void modelCountChanged(int count);
+    void modelLoadProgress(const QString& filename, int percent);
+    void modelLoadFailed(const QString& filename, const QString& error);
 
 private:
     // Shader for models
@@ -54,11 +70,19 @@ private:
 
     // Collection of models
     std::vector<std::shared_ptr<Model>> models_;
+    std::vector<std::shared_ptr<Model>> retiredModels_;  // Removed, GL objects not yet freed
 
     // Shader sources (string_view for type-safe literals)
     std::string_view vertexShaderSource_;
     std::string_view fragmentShaderSource_;
 
+    // Import threads by load id; joined once their result has been delivered
+    std::map<int, std::thread> loaders_;
+    int nextLoadId_ = 0;
+
     // Helper methods
     bool setupShaders();
+    void finishLoad(int loadId, const QString& filename, const QVector3D& position,
+                    ImportedMeshPtr mesh, const QString& error);
+    void releaseModels();
 };
\ No newline at end of file
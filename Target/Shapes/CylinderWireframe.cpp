@@ -11,6 +11,13 @@ CylinderWireframe::CylinderWireframe()
 {
 }
 
+std::vector<AnalyticShape> CylinderWireframe::getAnalyticShapes() const {
+    AnalyticShape shape;
+    shape.type = AnalyticShapeType::Cylinder;
+    shape.transform.scale(0.5f);
+    return {shape};
+}
+
 void CylinderWireframe::generateGeometry() {
     clearGeometry();
 
@@ -10,6 +10,9 @@ public:
 
     WireframeType getType() const override { return WireframeType::Cylinder; }
 
+    // The capped cylinder the mesh approximates (radius 0.5, height 1)
+    std::vector<AnalyticShape> getAnalyticShapes() const override;
+
 protected:
     void generateGeometry() override;
 };
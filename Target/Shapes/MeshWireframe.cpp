@@ -0,0 +1,28 @@
+// MeshWireframe.cpp
+
+#include "MeshWireframe.h"
+
+MeshWireframe::MeshWireframe(ImportedMeshPtr mesh, std::vector<GeometricEdge> edges)
+    : WireframeTarget(),
+      mesh_(std::move(mesh)),
+      cachedEdges_(std::move(edges))
+{
+}
+
+void MeshWireframe::generateGeometry() {
+    clearGeometry();
+    if (!mesh_) {
+        return;
+    }
+
+    // Already welded, in the [x,y,z,nx,ny,nz] layout with smooth normals
+    vertices_ = mesh_->vertices;
+    indices_.assign(mesh_->indices.begin(), mesh_->indices.end());
+
+    if (cachedEdges_.empty()) {
+        detectEdges();
+    } else {
+        edges_ = cachedEdges_;
+    }
+    generateEdgeGeometry();
+}
@@ -0,0 +1,28 @@
+// MeshWireframe.h
+// Target built from an imported model file (MeshImporter)
+#pragma once
+
+#include "WireframeTarget.h"
+#include "MeshImporter.h"
+
+class MeshWireframe : public WireframeTarget {
+public:
+    // edges: crease edges saved from an earlier detectEdges() on the same mesh
+    // (TargetCache); empty = detect them when the geometry is generated
+    explicit MeshWireframe(ImportedMeshPtr mesh, std::vector<GeometricEdge> edges = {});
+    ~MeshWireframe() override = default;
+
+    WireframeType getType() const override { return WireframeType::Mesh; }
+
+    const ImportedMeshPtr& getMesh() const { return mesh_; }
+    std::vector<uint32_t> getMaterialIds() const override {
+        return mesh_ ? mesh_->materialIds : std::vector<uint32_t>{};
+    }
+
+protected:
+    void generateGeometry() override;
+
+private:
+    ImportedMeshPtr mesh_;  // Shared with ModelManager/other targets of the same file
+    std::vector<GeometricEdge> cachedEdges_;
+};
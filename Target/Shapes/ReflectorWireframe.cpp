@@ -0,0 +1,92 @@
+// ReflectorWireframe.cpp
+
+#include "ReflectorWireframe.h"
+#include "Constants.h"
+
+using namespace RS::Constants;
+
+ReflectorWireframe::ReflectorWireframe(WireframeType type)
+    : WireframeTarget(),
+      type_(type == WireframeType::Dihedral || type == WireframeType::Trihedral ? type : WireframeType::Plate)
+{
+}
+
+std::vector<QMatrix4x4> ReflectorWireframe::plateTransforms() const {
+    // Each plate is the unit plate scaled to 1 x 1, turned into its plane and
+    // moved to its place. Rotating 90 about Y puts the unit normal on +X,
+    // -90 about X puts it on +Y.
+    auto plate = [](const QVector3D& center, float angle, const QVector3D& axis) {
+        QMatrix4x4 m;
+        m.translate(center);
+        if (angle != 0.0f) {
+            m.rotate(angle, axis);
+        }
+        m.scale(0.5f);
+        return m;
+    };
+
+    const QVector3D xAxis(1, 0, 0);
+    const QVector3D yAxis(0, 1, 0);
+    switch (type_) {
+    case WireframeType::Dihedral:
+        return {plate(QVector3D(0.5f, 0.0f, 0.0f), -90.0f, xAxis),   // y = 0, x in [0, 1]
+                plate(QVector3D(0.0f, 0.5f, 0.0f), 90.0f, yAxis)};   // x = 0, y in [0, 1]
+    case WireframeType::Trihedral:
+        return {plate(QVector3D(0.5f, 0.5f, 0.0f), 0.0f, xAxis),     // z = 0
+                plate(QVector3D(0.5f, 0.0f, 0.5f), -90.0f, xAxis),   // y = 0
+                plate(QVector3D(0.0f, 0.5f, 0.5f), 90.0f, yAxis)};   // x = 0
+    default:
+        return {plate(QVector3D(0.0f, 0.0f, 0.0f), 90.0f, yAxis)};   // x = 0, facing +X
+    }
+}
+
+std::vector<AnalyticShape> ReflectorWireframe::getAnalyticShapes() const {
+    std::vector<AnalyticShape> shapes;
+    for (const QMatrix4x4& transform : plateTransforms()) {
+        shapes.push_back(AnalyticShape{AnalyticShapeType::Plate, transform});
+    }
+    return shapes;
+}
+
+void ReflectorWireframe::generateGeometry() {
+    clearGeometry();
+
+    for (const QMatrix4x4& transform : plateTransforms()) {
+        addPlate(transform);
+    }
+
+    // Detect crease edges for rendering (slab outlines, not quad diagonals)
+    detectEdges();
+    generateEdgeGeometry();
+}
+
+void ReflectorWireframe::addPlate(const QMatrix4x4& transform) {
+    // Slab around the unit plate: half-extents in unit plate space, where the
+    // transform's 0.5 scale halves the thickness as well
+    const float extent[3] = {1.0f, 1.0f, kReflectorPlateThickness};
+
+    // Six faces: outward normal along +-axis a, spanned by the next two axes
+    // (u x v = a), corners counter-clockwise seen from outside
+    for (int a = 0; a < 3; a++) {
+        int u = (a + 1) % 3;
+        int v = (a + 2) % 3;
+        for (float sign : {1.0f, -1.0f}) {
+            QVector3D localNormal;
+            localNormal[a] = sign;
+            QVector3D normal = transform.mapVector(localNormal).normalized();  // Rotation and uniform scale only
+
+            const float corners[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+            GLuint baseIdx = getVertexCount();
+            for (int c = 0; c < 4; c++) {
+                // Reversed order on the negative side keeps the winding outward
+                int k = sign > 0.0f ? c : 3 - c;
+                QVector3D local;
+                local[a] = sign * extent[a];
+                local[u] = corners[k][0] * extent[u];
+                local[v] = corners[k][1] * extent[v];
+                addVertex(transform.map(local), normal);
+            }
+            addQuad(baseIdx, baseIdx + 1, baseIdx + 2, baseIdx + 3);
+        }
+    }
+}
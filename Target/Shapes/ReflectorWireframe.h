@@ -0,0 +1,31 @@
+// ReflectorWireframe.h
+// Canonical reflectors for RCS verification: flat plate, dihedral and trihedral
+#pragma once
+
+#include "WireframeTarget.h"
+
+// Square 1 x 1 plates. The plate stands in the x = 0 plane facing +X; the
+// dihedral's plates meet along the Z axis and open toward azimuth 45; the
+// trihedral's three plates fill the corner of the positive octant. Plates are
+// drawn as thin slabs, while getAnalyticShapes() gives the exact zero-thickness
+// plates for the analytic trace.
+class ReflectorWireframe : public WireframeTarget {
+public:
+    // type: Plate, Dihedral or Trihedral (anything else is a plate)
+    explicit ReflectorWireframe(WireframeType type);
+    ~ReflectorWireframe() override = default;
+
+    WireframeType getType() const override { return type_; }
+
+    std::vector<AnalyticShape> getAnalyticShapes() const override;
+
+protected:
+    void generateGeometry() override;
+
+private:
+    WireframeType type_;
+
+    // Unit plate (x, y in [-1, 1] at z = 0) -> object space, one per plate
+    std::vector<QMatrix4x4> plateTransforms() const;
+    void addPlate(const QMatrix4x4& transform);
+};
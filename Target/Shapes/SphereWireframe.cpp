@@ -2,9 +2,14 @@
 // Geodesic sphere using icosahedron subdivision
 
 #include "SphereWireframe.h"
+#include "Constants.h"
+#include "ParallelChunks.h"
+#include <algorithm>
 #include <cmath>
 #include <map>
 
+using namespace RS::Constants;
+
 SphereWireframe::SphereWireframe(int subdivisions)
     : WireframeTarget(),
       subdivisions_(subdivisions)
@@ -19,6 +24,10 @@ void SphereWireframe::setSubdivisions(int level) {
     }
 }
 
+std::vector<AnalyticShape> SphereWireframe::getAnalyticShapes() const {
+    return {AnalyticShape{AnalyticShapeType::Sphere, QMatrix4x4()}};
+}
+
 void SphereWireframe::generateGeometry() {
     clearGeometry();
     createIcosahedron();
@@ -93,66 +102,117 @@ QVector3D SphereWireframe::getMidpoint(const QVector3D& v1, const QVector3D& v2)
     return ((v1 + v2) * 0.5f).normalized();
 }
 
+// Every level splits each edge at its midpoint and each face into four.
+// Instead of a midpoint cache, the mesh carries an edge table: faceEdges
+// holds, for face f, the edges from corner k to corner k+1. With E edges and
+// V vertices, edge e gets the new vertex V + e and splits into edges 2e and
+// 2e + 1; face f adds the inner edges 2E + 3f .. 2E + 3f + 2 and the faces
+// 4f .. 4f + 3. All indices follow from e and f alone, so edges and faces are
+// split in parallel chunks, and the mesh is the same for any thread count.
 void SphereWireframe::subdivide(int levels) {
     if (levels <= 0) {
         return;
     }
 
+    // Edge table of the base mesh (the icosahedron's 30 edges)
+    std::vector<EdgeEnds> edges;
+    std::vector<GLuint> faceEdges(indices_.size());
+    std::map<std::pair<GLuint, GLuint>, GLuint> edgeIds;
+    for (size_t i = 0; i < indices_.size(); ++i) {
+        GLuint a = indices_[i];
+        GLuint b = indices_[i - i % 3 + (i + 1) % 3];
+        auto key = std::minmax(a, b);
+        auto it = edgeIds.find(key);
+        if (it == edgeIds.end()) {
+            it = edgeIds.emplace(key, static_cast<GLuint>(edges.size())).first;
+            edges.push_back({a, b});
+        }
+        faceEdges[i] = it->second;
+    }
+
     for (int level = 0; level < levels; ++level) {
-        // Store current triangles
-        std::vector<GLuint> oldIndices = indices_;
-        indices_.clear();
-
-        // Cache for midpoint vertices to avoid duplicates
-        // Key: pair of vertex indices (smaller first), Value: new vertex index
-        std::map<std::pair<GLuint, GLuint>, GLuint> midpointCache;
-
-        auto getOrCreateMidpoint = [&](GLuint i1, GLuint i2) -> GLuint {
-            // Ensure consistent ordering for cache key
-            if (i1 > i2) std::swap(i1, i2);
-            auto key = std::make_pair(i1, i2);
-
-            auto it = midpointCache.find(key);
-            if (it != midpointCache.end()) {
-                return it->second;
+        const size_t vertexCount = getVertexCount();
+        const size_t edgeCount = edges.size();
+        const size_t faceCount = indices_.size() / 3;
+        const bool lastLevel = level == levels - 1;  // Its edge table is not needed
+
+        std::vector<GLuint> newIndices(faceCount * 12);
+        std::vector<EdgeEnds> newEdges(lastLevel ? 0 : edgeCount * 2 + faceCount * 3);
+        std::vector<GLuint> newFaceEdges(lastLevel ? 0 : faceCount * 12);
+        vertices_.resize((vertexCount + edgeCount) * 6);
+
+        // Midpoint vertex and the two halves of every edge
+        RS::runChunks(RS::parallelChunkCount(edgeCount, kSphereParallelMinFaces), edgeCount,
+                      [&](int, size_t begin, size_t end) {
+            for (size_t e = begin; e < end; ++e) {
+                const EdgeEnds& edge = edges[e];
+                QVector3D v1(vertices_[edge.a * 6], vertices_[edge.a * 6 + 1], vertices_[edge.a * 6 + 2]);
+                QVector3D v2(vertices_[edge.b * 6], vertices_[edge.b * 6 + 1], vertices_[edge.b * 6 + 2]);
+                QVector3D mid = getMidpoint(v1, v2);
+
+                // Position = normal for sphere
+                float* out = &vertices_[(vertexCount + e) * 6];
+                out[0] = out[3] = mid.x();
+                out[1] = out[4] = mid.y();
+                out[2] = out[5] = mid.z();
+
+                if (!lastLevel) {
+                    GLuint m = static_cast<GLuint>(vertexCount + e);
+                    newEdges[e * 2] = {edge.a, m};
+                    newEdges[e * 2 + 1] = {m, edge.b};
+                }
             }
+        });
+
+        // Four faces, and their edges, for every face
+        RS::runChunks(RS::parallelChunkCount(faceCount, kSphereParallelMinFaces), faceCount,
+                      [&](int, size_t begin, size_t end) {
+            for (size_t f = begin; f < end; ++f) {
+                GLuint v0 = indices_[f * 3];
+                GLuint v1 = indices_[f * 3 + 1];
+                GLuint v2 = indices_[f * 3 + 2];
+                GLuint e01 = faceEdges[f * 3];
+                GLuint e12 = faceEdges[f * 3 + 1];
+                GLuint e20 = faceEdges[f * 3 + 2];
+                GLuint m01 = static_cast<GLuint>(vertexCount + e01);
+                GLuint m12 = static_cast<GLuint>(vertexCount + e12);
+                GLuint m20 = static_cast<GLuint>(vertexCount + e20);
+
+                // Create 4 new triangles from the original
+                //       v0
+                //      /  \
+                //    m01--m20
+                //    / \  / \
+                //  v1--m12--v2
+                const GLuint faces[12] = {v0, m01, m20,
+                                          m01, v1, m12,
+                                          m20, m12, v2,
+                                          m01, m12, m20};
+                std::copy(faces, faces + 12, newIndices.begin() + f * 12);
+
+                if (lastLevel) {
+                    continue;
+                }
+
+                // Half of edge e at vertex v
+                auto half = [&](GLuint e, GLuint v) {
+                    return edges[e].a == v ? e * 2 : e * 2 + 1;
+                };
+                GLuint inner = static_cast<GLuint>(edgeCount * 2 + f * 3);
+                newEdges[inner] = {m01, m20};
+                newEdges[inner + 1] = {m01, m12};
+                newEdges[inner + 2] = {m12, m20};
+
+                const GLuint childEdges[12] = {half(e01, v0), inner, half(e20, v0),
+                                               half(e01, v1), half(e12, v1), inner + 1,
+                                               inner + 2, half(e12, v2), half(e20, v2),
+                                               inner + 1, inner + 2, inner};
+                std::copy(childEdges, childEdges + 12, newFaceEdges.begin() + f * 12);
+            }
+        });
 
-            // Get vertex positions from vertices_ array (6 floats per vertex)
-            QVector3D v1(vertices_[i1 * 6], vertices_[i1 * 6 + 1], vertices_[i1 * 6 + 2]);
-            QVector3D v2(vertices_[i2 * 6], vertices_[i2 * 6 + 1], vertices_[i2 * 6 + 2]);
-
-            // Create midpoint on sphere surface
-            QVector3D mid = getMidpoint(v1, v2);
-
-            // Add new vertex (position = normal for sphere)
-            GLuint newIdx = getVertexCount();
-            addVertex(mid, mid);
-
-            midpointCache[key] = newIdx;
-            return newIdx;
-        };
-
-        // Process each triangle
-        for (size_t i = 0; i < oldIndices.size(); i += 3) {
-            GLuint v0 = oldIndices[i];
-            GLuint v1 = oldIndices[i + 1];
-            GLuint v2 = oldIndices[i + 2];
-
-            // Get midpoints of each edge
-            GLuint m01 = getOrCreateMidpoint(v0, v1);
-            GLuint m12 = getOrCreateMidpoint(v1, v2);
-            GLuint m20 = getOrCreateMidpoint(v2, v0);
-
-            // Create 4 new triangles from the original
-            //       v0
-            //      /  \
-            //    m01--m20
-            //    / \  / \
-            //  v1--m12--v2
-            addTriangle(v0, m01, m20);
-            addTriangle(m01, v1, m12);
-            addTriangle(m20, m12, v2);
-            addTriangle(m01, m12, m20);
-        }
+        indices_.swap(newIndices);
+        edges.swap(newEdges);
+        faceEdges.swap(newFaceEdges);
     }
 }
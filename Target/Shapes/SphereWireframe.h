@@ -17,14 +17,23 @@ public:
     // Set subdivision level and regenerate geometry
     void setSubdivisions(int level);
 
+    // The unit sphere the mesh approximates
+    std::vector<AnalyticShape> getAnalyticShapes() const override;
+
 protected:
     void generateGeometry() override;
 
 private:
     int subdivisions_;  // Number of recursive subdivisions (0-4 typical)
 
+    // Ends of one edge; a split edge's child 2e keeps a, child 2e+1 keeps b
+    struct EdgeEnds {
+        GLuint a;
+        GLuint b;
+    };
+
     // Helper methods for icosahedron subdivision
     void createIcosahedron();
     void subdivide(int levels);
-    QVector3D getMidpoint(const QVector3D& v1, const QVector3D& v2);
+    static QVector3D getMidpoint(const QVector3D& v1, const QVector3D& v2);
 };
@@ -1,9 +1,31 @@
 // WireframeShapes.h
 #pragma once
 
+#include <QMatrix4x4>
+#include <cstdint>
+
 enum class WireframeType {
     Cube,
     Cylinder,
     Aircraft,
-    Sphere  // Geodesic sphere for RCS verification (theoretical RCS = pi*r^2)
+    Sphere,  // Geodesic sphere for RCS verification (theoretical RCS = pi*r^2)
+    Mesh,    // Imported model (MeshWireframe) - not creatable by type alone
+    Plate,      // Square flat plate (ReflectorWireframe)
+    Dihedral,   // Two square plates at a right angle
+    Trihedral   // Three square plates meeting at a corner
+};
+
+// Unit primitives the RCS trace intersects in closed form (exact surface and
+// normal, no triangles or BVH). Values match the trace kernel's shape codes.
+enum class AnalyticShapeType : uint32_t {
+    Sphere = 0,    // Radius 1 about the origin
+    Cylinder = 1,  // Radius 1 about the Z axis, z in [-1, 1], both ends capped
+    Plate = 2      // Square x, y in [-1, 1] at z = 0, reflecting on both sides
+};
+
+// One unit primitive placed in a target's object space. The transform may
+// scale non-uniformly; normals go through its inverse transpose.
+struct AnalyticShape {
+    AnalyticShapeType type = AnalyticShapeType::Sphere;
+    QMatrix4x4 transform;  // Unit primitive -> object space
 };
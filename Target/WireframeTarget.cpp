@@ -6,15 +6,26 @@
 #include "CylinderWireframe.h"
 #include "AircraftWireframe.h"
 #include "SphereWireframe.h"
+#include "ReflectorWireframe.h"
 #include "Constants.h"
+#include "Frustum.h"
 #include <QDebug>
 #include <QOpenGLContext>
 #include <cmath>
-#include <map>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <memory>
+#include <thread>
 
 using namespace RS::Constants;
 
+// Source of geometry versions - global so a freshly created target never
+// reuses the version of the target it replaced
+static uint64_t sGeometryVersionCounter = 0;
+
 WireframeTarget::WireframeTarget()
     : position_(0.0f, 0.0f, 0.0f),
       rotation_(),
@@ -24,34 +35,45 @@ WireframeTarget::WireframeTarget()
 {
     // Vertex shader for solid surface rendering
     vertexShaderSource_ = R"(
-        #version 330 core
+        #version 430 core
         layout (location = 0) in vec3 aPos;
         layout (location = 1) in vec3 aNormal;
+        layout (location = 2) in mat4 aModel;   // Per instance (locations 2-5)
+        layout (location = 6) in vec3 aColor;   // Per instance
 
-        uniform mat4 model;
         uniform mat4 view;
         uniform mat4 projection;
+        uniform float colorScale;
 
         out vec3 FragPos;
         out vec3 Normal;
+        flat out vec3 ObjectColor;
 
         void main() {
-            FragPos = vec3(model * vec4(aPos, 1.0));
-            Normal = mat3(transpose(inverse(model))) * aNormal;
-            gl_Position = projection * view * model * vec4(aPos, 1.0);
+            FragPos = vec3(aModel * vec4(aPos, 1.0));
+            Normal = mat3(transpose(inverse(aModel))) * aNormal;
+            ObjectColor = aColor * colorScale;
+            gl_Position = projection * view * aModel * vec4(aPos, 1.0);
         }
     )";
 
-    // Fragment shader with diffuse + ambient lighting + radar angle-based edge darkening
+    // Fragment shader with diffuse + ambient lighting + radar angle-based edge
+    // darkening, tinted by the RCS hotspot sums when they are bound
     fragmentShaderSource_ = R"(
-        #version 330 core
+        #version 430 core
         in vec3 FragPos;
         in vec3 Normal;
+        flat in vec3 ObjectColor;
 
-        uniform vec3 objectColor;
         uniform vec3 lightPos;
         uniform vec3 radarPos;
 
+        // RCSCompute per-triangle sums: [0] = largest, then one per triangle
+        // from hotspotOffset in index-buffer order (full-resolution draws only)
+        layout(std430, binding = 0) readonly buffer HotspotBuffer { uint hotspots[]; };
+        uniform bool hotspotsEnabled;
+        uniform int hotspotOffset;
+
         out vec4 FragColor;
 
         void main() {
@@ -72,7 +94,18 @@ WireframeTarget::WireframeTarget()
             float edgeDarken = smoothstep(0.0, 0.4, radarDot);
 
             // Result with edge darkening
-            vec3 result = (ambient + diffuse) * objectColor * (0.6 + 0.4 * edgeDarken);
+            vec3 result = (ambient + diffuse) * ObjectColor * (0.6 + 0.4 * edgeDarken);
+
+            // Hotspots: blue -> yellow -> red over the share of the largest sum,
+            // fading in so unlit triangles keep the target color
+            if (hotspotsEnabled) {
+                uint index = 1u + uint(hotspotOffset + gl_PrimitiveID);
+                float peak = float(max(hotspots[0], 1u));
+                float t = index < uint(hotspots.length()) ? clamp(float(hotspots[index]) / peak, 0.0, 1.0) : 0.0;
+                vec3 heat = t < 0.5 ? mix(vec3(0.0, 0.0, 1.0), vec3(1.0, 1.0, 0.0), t * 2.0)
+                                    : mix(vec3(1.0, 1.0, 0.0), vec3(1.0, 0.0, 0.0), t * 2.0 - 1.0);
+                result = mix(result, heat * (ambient + diffuse), smoothstep(0.0, 0.05, t));
+            }
             FragColor = vec4(result, 1.0);
         }
     )";
@@ -80,6 +113,10 @@ WireframeTarget::WireframeTarget()
 
 // Clean up OpenGL resources - must be called with valid GL context
 void WireframeTarget::cleanup() {
+    cancelLodBuild();
+    lodLevels_.clear();
+    currentLod_ = 0;
+
     // Check for valid OpenGL context
     QOpenGLContext* ctx = QOpenGLContext::currentContext();
     if (!ctx) {
@@ -105,6 +142,16 @@ void WireframeTarget::cleanup() {
         glDeleteBuffers(1, &edgeVboId_);
         edgeVboId_ = 0;
     }
+    if (edgeVao_.isCreated()) {
+        edgeVao_.destroy();
+    }
+    if (instanceVboId_ != 0) {
+        glDeleteBuffers(1, &instanceVboId_);
+        instanceVboId_ = 0;
+    }
+    instanceData_.clear();
+    instanceCount_ = 0;
+    gpuMemory_.release();
     shaderProgram_.reset();
 }
 
@@ -112,6 +159,7 @@ WireframeTarget::~WireframeTarget() {
     // OpenGL resources should already be cleaned up via cleanup() called from
     // RadarGLWidget::cleanupGL() before context destruction.
     // Note: shaderProgram_ should be nullptr at this point
+    cancelLodBuild();
 }
 
 void WireframeTarget::initialize() {
@@ -129,9 +177,16 @@ void WireframeTarget::initialize() {
 
     setupShaders();
 
+    // Per-instance model matrices and colors, shared by the surface and edge VAOs
+    glGenBuffers(1, &instanceVboId_);
     vao_.create();
     vao_.bind();
+    setupInstanceAttributes();
     vao_.release();
+    edgeVao_.create();
+    edgeVao_.bind();
+    setupInstanceAttributes();
+    edgeVao_.release();
 
     // Generate and upload initial geometry
     generateGeometry();
@@ -149,12 +204,12 @@ void WireframeTarget::setupShaders() {
 
     shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
         qCritical() << "WireframeTarget: Failed to compile vertex shader:" << shaderProgram_->log();
         return;
     }
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
         qCritical() << "WireframeTarget: Failed to compile fragment shader:" << shaderProgram_->log();
         return;
     }
@@ -217,10 +272,32 @@ void WireframeTarget::uploadGeometryToGPU() {
     vertexCount_ = static_cast<int>(vertices_.size() / 6);
     indexCount_ = static_cast<int>(indices_.size());
     geometryDirty_ = false;
+
+    updateBounds();
+    uploadEdgeGeometry();
+
+    // The EBO now holds only the full mesh; coarser levels follow when built
+    lodLevels_.clear();
+    currentLod_ = 0;
+    accountMemory();
+    RS::GPUMemory::checkAllocation("target mesh buffers");
+    if (indices_.size() / 3 >= kLodMinTriangles) {
+        startLodBuild();
+    }
 }
 
 void WireframeTarget::render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& sceneModel) {
-    if (!visible_ || indices_.empty()) {
+    static const std::vector<QMatrix4x4> kSingleInstance(1);
+    render(projection, view, sceneModel, kSingleInstance);
+}
+
+// All instances go in one instanced draw for the surface and one for the crease
+// edges, so submission cost does not grow with the formation. Instances whose
+// bounding sphere is outside the view frustum are left out of the upload.
+void WireframeTarget::render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& sceneModel,
+                             const std::vector<QMatrix4x4>& instanceOffsets,
+                             const std::vector<QVector3D>& instanceColors) {
+    if (!visible_ || indices_.empty() || instanceOffsets.empty()) {
         return;
     }
 
@@ -237,9 +314,46 @@ void WireframeTarget::render(const QMatrix4x4& projection, const QMatrix4x4& vie
         return;
     }
 
-    // Build combined model matrix: scene transform * local transform
+    uploadLodLevels();
+    if (lodLevels_.size() > 1 && RS::GPUMemory::isOverBudget()) {
+        qWarning() << "WireframeTarget: Over the GPU memory budget, dropping" << lodLevels_.size() - 1 << "LOD levels";
+        releaseLodLevels();
+    }
+
+    // Instance model = scene transform * world-space offset * local transform
+    const RS::Frustum frustum(projection * view);
     QMatrix4x4 localModel = buildModelMatrix();
-    QMatrix4x4 combinedModel = sceneModel * localModel;
+    std::vector<QMatrix4x4> instanceModels;
+    std::vector<QVector3D> visibleColors;
+    instanceModels.reserve(instanceOffsets.size());
+    for (size_t i = 0; i < instanceOffsets.size(); i++) {
+        QMatrix4x4 model = sceneModel * instanceOffsets[i] * localModel;
+        if (!frustum.intersectsSphere(model, boundsCenter_, boundsRadius_)) {
+            continue;
+        }
+        instanceModels.push_back(model);
+        visibleColors.push_back(i < instanceColors.size() ? instanceColors[i] : color_);
+    }
+    if (instanceModels.empty()) {
+        return;
+    }
+    uploadInstances(instanceModels, visibleColors);
+
+    // One level for every drawn instance - the finest any of them needs. The
+    // hotspot overlay is indexed by full-resolution triangle, so it pins level 0.
+    GLint viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    currentLod_ = hotspotBuffer_ != 0 ? 0 : static_cast<int>(lodLevels_.size()) - 1;
+    for (size_t i = 0; i < instanceModels.size() && currentLod_ > 0; i++) {
+        currentLod_ = std::min(currentLod_, selectLod(projection, view * instanceModels[i], viewport[3]));
+    }
+    currentLod_ = std::max(currentLod_, 0);
+    size_t drawOffset = 0;
+    size_t drawCount = static_cast<size_t>(indexCount_);
+    if (currentLod_ > 0) {
+        drawOffset = lodLevels_[currentLod_].indexOffset;
+        drawCount = lodLevels_[currentLod_].indexCount;
+    }
 
     // Render visible surface with color
     glEnable(GL_DEPTH_TEST);
@@ -252,18 +366,23 @@ void WireframeTarget::render(const QMatrix4x4& projection, const QMatrix4x4& vie
     shaderProgram_->bind();
     shaderProgram_->setUniformValue("projection", projection);
     shaderProgram_->setUniformValue("view", view);
-    shaderProgram_->setUniformValue("model", combinedModel);
-    shaderProgram_->setUniformValue("objectColor", color_);
+    shaderProgram_->setUniformValue("colorScale", 1.0f);
     shaderProgram_->setUniformValue("lightPos", QVector3D(Lighting::kTargetLightPosition[0], Lighting::kTargetLightPosition[1], Lighting::kTargetLightPosition[2]));
     shaderProgram_->setUniformValue("radarPos", radarPos_);
+    shaderProgram_->setUniformValue("hotspotsEnabled", hotspotBuffer_ != 0);
+    shaderProgram_->setUniformValue("hotspotOffset", hotspotOffset_);
+    if (hotspotBuffer_ != 0) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, hotspotBuffer_);
+    }
 
     vao_.bind();
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
-
-    glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr);
-
+    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(drawCount), GL_UNSIGNED_INT,
+                            reinterpret_cast<const void*>(drawOffset * sizeof(GLuint)), instanceCount_);
     vao_.release();
+    if (hotspotBuffer_ != 0) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+        shaderProgram_->setUniformValue("hotspotsEnabled", false);  // Edge lines keep their color
+    }
 
     // Second pass: draw only crease edges (not internal triangle diagonals)
     // This gives clean edge definition without showing internal triangulation
@@ -274,22 +393,16 @@ void WireframeTarget::render(const QMatrix4x4& projection, const QMatrix4x4& vie
         glLineWidth(1.5f);
 
         // Darker edge color (30% of original brightness)
-        QVector3D edgeColor = color_ * 0.3f;
-        shaderProgram_->setUniformValue("objectColor", edgeColor);
-        // Set a neutral normal for edge lines (lighting less important for edges)
+        shaderProgram_->setUniformValue("colorScale", 0.3f);
+        // Set a neutral light for edge lines (lighting less important for edges)
         shaderProgram_->setUniformValue("lightPos", QVector3D(0, 100, 100));
 
-        // Bind edge VBO and set up vertex attribute
-        glBindBuffer(GL_ARRAY_BUFFER, edgeVboId_);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-        glEnableVertexAttribArray(0);
-        // Disable normal attribute for edge lines (not needed)
-        glDisableVertexAttribArray(1);
-
-        glDrawArrays(GL_LINES, 0, edgeVertexCount_);
+        // Edge lines carry no normals - use a constant one for every vertex
+        edgeVao_.bind();
+        glVertexAttrib3f(1, 0.0f, 0.0f, 1.0f);
+        glDrawArraysInstanced(GL_LINES, 0, edgeVertexCount_, instanceCount_);
+        edgeVao_.release();
 
-        // Restore state
-        glEnableVertexAttribArray(1);  // Re-enable normal attribute
         glDisable(GL_POLYGON_OFFSET_LINE);
         glLineWidth(1.0f);
     }
@@ -299,6 +412,52 @@ void WireframeTarget::render(const QMatrix4x4& projection, const QMatrix4x4& vie
     glDisable(GL_CULL_FACE);
 }
 
+// Instance attributes of the currently bound VAO: aModel (2-5) and aColor (6),
+// advancing once per instance. 80 bytes per instance, see uploadInstances().
+void WireframeTarget::setupInstanceAttributes() {
+    constexpr GLsizei kStride = 20 * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVboId_);
+    for (int column = 0; column < 4; column++) {
+        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, kStride,
+                              reinterpret_cast<const void*>(column * 4 * sizeof(float)));
+        glEnableVertexAttribArray(2 + column);
+        glVertexAttribDivisor(2 + column, 1);
+    }
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, kStride, reinterpret_cast<const void*>(16 * sizeof(float)));
+    glEnableVertexAttribArray(6);
+    glVertexAttribDivisor(6, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Packs column-major model matrices and colors; uploads only when they change
+void WireframeTarget::uploadInstances(const std::vector<QMatrix4x4>& models, const std::vector<QVector3D>& colors) {
+    std::vector<float> data;
+    data.reserve(models.size() * 20);
+    for (size_t i = 0; i < models.size(); i++) {
+        data.insert(data.end(), models[i].constData(), models[i].constData() + 16);
+        const QVector3D& color = i < colors.size() ? colors[i] : color_;
+        data.push_back(color.x());
+        data.push_back(color.y());
+        data.push_back(color.z());
+        data.push_back(0.0f);
+    }
+
+    instanceCount_ = static_cast<GLsizei>(models.size());
+    if (data == instanceData_) {
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVboId_);
+    if (data.size() == instanceData_.size()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, data.size() * sizeof(float), data.data());
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_DYNAMIC_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    instanceData_ = std::move(data);
+    accountMemory();
+}
+
 QMatrix4x4 WireframeTarget::buildModelMatrix() const {
     QMatrix4x4 model;
     model.setToIdentity();
@@ -330,10 +489,167 @@ void WireframeTarget::addQuad(GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
 }
 
 void WireframeTarget::clearGeometry() {
+    cancelLodBuild();
+    lodLevels_.clear();
+    currentLod_ = 0;
     vertices_.clear();
     indices_.clear();
     vertexCount_ = 0;
     indexCount_ = 0;
+    geometryVersion_ = ++sGeometryVersionCounter;
+}
+
+// Level of detail - the worker owns copies of the mesh, so the target can be
+// regenerated or destroyed while it runs (cancelLodBuild() waits at most one
+// simplification round)
+void WireframeTarget::startLodBuild() {
+    cancelLodBuild();
+
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    lodCancel_ = cancel;
+    std::vector<float> vertices = vertices_;
+    std::vector<uint32_t> indices(indices_.begin(), indices_.end());
+    const uint64_t version = geometryVersion_;
+
+    lodJob_ = std::async(std::launch::async, [vertices = std::move(vertices), indices = std::move(indices), version, cancel]() {
+        LodBuild build;
+        build.geometryVersion = version;
+
+        const size_t vertexCount = vertices.size() / 6;
+        if (!MeshSimplifier::buildLodChain(vertices.data(), vertexCount, 6, indices.data(), indices.size(),
+                                           kLodReductionRatio, kLodCoarsestTriangles, build.chain, cancel.get())) {
+            build.chain.levels.clear();
+        }
+        return build;
+    });
+}
+
+void WireframeTarget::cancelLodBuild() {
+    if (lodCancel_) {
+        lodCancel_->store(true);
+    }
+    if (lodJob_.valid()) {
+        lodJob_.wait();
+        lodJob_ = std::future<LodBuild>();
+    }
+    lodCancel_.reset();
+}
+
+void WireframeTarget::uploadLodLevels() {
+    if (!lodJob_.valid() || lodJob_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    LodBuild build = lodJob_.get();
+    lodCancel_.reset();
+
+    if (build.geometryVersion != geometryVersion_ || build.chain.levels.empty() || eboId_ == 0) {
+        return;
+    }
+
+    // Levels only save raster time; without room for them the full mesh draws
+    if (!RS::GPUMemory::fits(build.chain.indices.size() * sizeof(GLuint))) {
+        qWarning() << "WireframeTarget: LOD levels would exceed the GPU memory budget, drawing the full mesh";
+        return;
+    }
+
+    // Full mesh first, then every coarser level, in the one EBO
+    const size_t baseCount = indices_.size();
+    vao_.bind();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 (baseCount + build.chain.indices.size()) * sizeof(GLuint),
+                 nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, baseCount * sizeof(GLuint), indices_.data());
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, baseCount * sizeof(GLuint),
+                    build.chain.indices.size() * sizeof(GLuint), build.chain.indices.data());
+    vao_.release();
+
+    lodLevels_.clear();
+    lodLevels_.push_back({0, baseCount});
+    for (const auto& level : build.chain.levels) {
+        lodLevels_.push_back({baseCount + level.indexOffset, level.indexCount});
+    }
+
+    accountMemory();
+    RS::GPUMemory::checkAllocation("target LOD levels");
+}
+
+void WireframeTarget::releaseLodLevels() {
+    lodLevels_.clear();
+    currentLod_ = 0;
+    if (eboId_ == 0) {
+        return;
+    }
+
+    vao_.bind();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(GLuint), indices_.data(), GL_DYNAMIC_DRAW);
+    vao_.release();
+    accountMemory();
+}
+
+void WireframeTarget::accountMemory() {
+    size_t eboIndices = lodLevels_.empty() ? indices_.size()
+                                           : lodLevels_.back().indexOffset + lodLevels_.back().indexCount;
+    size_t bytes = vertices_.size() * sizeof(float) + eboIndices * sizeof(GLuint) +
+                   edgeVertices_.size() * sizeof(float) + instanceData_.size() * sizeof(float);
+    gpuMemory_.resize(vboId_ != 0 ? bytes : 0);
+}
+
+// Coarsest level that still gives kLodTrianglesPerPixel over the target's
+// projected disc, never finer than kLodMaxDisplayTriangles allows
+int WireframeTarget::selectLod(const QMatrix4x4& projection, const QMatrix4x4& modelView, int viewportHeight) {
+    if (lodLevels_.size() < 2 || boundsRadius_ <= 0.0f) {
+        return 0;
+    }
+
+    float scale = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        scale = std::max(scale, modelView.column(i).toVector3D().length());
+    }
+    const float radius = boundsRadius_ * scale;
+
+    const float pixelsPerUnit = projection(1, 1) * viewportHeight * 0.5f;
+
+    double wantedTriangles = std::numeric_limits<double>::max();
+    const bool orthographic = projection(3, 3) == 1.0f;
+    const float depth = -modelView.map(boundsCenter_).z();
+    if (orthographic || depth > radius) {
+        float radiusPixels = orthographic ? radius * pixelsPerUnit : radius / depth * pixelsPerUnit;
+        wantedTriangles = M_PI * radiusPixels * radiusPixels * kLodTrianglesPerPixel;
+    }
+
+    int level = static_cast<int>(lodLevels_.size()) - 1;
+    while (level > 0 && lodLevels_[level].triangleCount() < wantedTriangles &&
+           lodLevels_[level - 1].triangleCount() <= kLodMaxDisplayTriangles) {
+        level--;
+    }
+    return level;
+}
+
+// Box center and the farthest vertex from it - not minimal, but one pass
+void WireframeTarget::updateBounds() {
+    const size_t vertexCount = vertices_.size() / 6;
+    if (vertexCount == 0) {
+        boundsCenter_ = QVector3D();
+        boundsRadius_ = 0.0f;
+        return;
+    }
+    QVector3D lo(vertices_[0], vertices_[1], vertices_[2]);
+    QVector3D hi = lo;
+    for (size_t i = 1; i < vertexCount; i++) {
+        const float* v = &vertices_[i * 6];
+        lo = QVector3D(std::min(lo.x(), v[0]), std::min(lo.y(), v[1]), std::min(lo.z(), v[2]));
+        hi = QVector3D(std::max(hi.x(), v[0]), std::max(hi.y(), v[1]), std::max(hi.z(), v[2]));
+    }
+    boundsCenter_ = (lo + hi) * 0.5f;
+    float radiusSq = 0.0f;
+    for (size_t i = 0; i < vertexCount; i++) {
+        const float* v = &vertices_[i * 6];
+        radiusSq = std::max(radiusSq, (QVector3D(v[0], v[1], v[2]) - boundsCenter_).lengthSquared());
+    }
+    boundsRadius_ = std::sqrt(radiusSq);
 }
 
 // Transform setters
@@ -389,12 +705,19 @@ std::unique_ptr<WireframeTarget> WireframeTarget::createTarget(WireframeType typ
         return std::make_unique<AircraftWireframe>();
     case WireframeType::Sphere:
         return std::make_unique<SphereWireframe>(3);  // 3 subdivisions = 1280 faces
+    case WireframeType::Plate:
+    case WireframeType::Dihedral:
+    case WireframeType::Trihedral:
+        return std::make_unique<ReflectorWireframe>(type);
     default:
         return std::make_unique<CubeWireframe>();
     }
 }
 
-// Edge detection - find crease edges where adjacent face normals differ significantly
+// Edge detection - find crease edges where adjacent face normals differ significantly.
+// Edges are bucketed by their lower vertex in flat arrays (count, prefix sum,
+// scatter), so there is no per-edge allocation and every pass splits across
+// threads. Output order is (v0, v1) ascending whatever the thread count.
 void WireframeTarget::detectEdges() {
     edges_.clear();
 
@@ -402,51 +725,128 @@ void WireframeTarget::detectEdges() {
         return;
     }
 
-    // Build edge-to-triangle adjacency map
-    // Key: ordered vertex pair (min, max), Value: list of triangle indices
-    std::map<std::pair<uint32_t, uint32_t>, std::vector<int>> edgeTriangles;
+    const size_t triangleCount = indices_.size() / 3;
+    const size_t vertexSlots = static_cast<size_t>(*std::max_element(indices_.begin(), indices_.end())) + 1;
+
+    // Chunks over triangles, and over vertex buckets for the per-edge passes
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    int numChunks = triangleCount >= static_cast<size_t>(kEdgeParallelMinTriangles)
+                        ? static_cast<int>(std::min<size_t>(threads, triangleCount / (kEdgeParallelMinTriangles / 4)))
+                        : 1;
+    auto runChunks = [numChunks](size_t count, const auto& body) {
+        auto range = [&](int c) {
+            body(c, count * c / numChunks, count * (c + 1) / numChunks);
+        };
+        std::vector<std::future<void>> tasks;
+        for (int c = 1; c < numChunks; c++) {
+            tasks.push_back(std::async(std::launch::async, range, c));
+        }
+        range(0);
+        for (auto& task : tasks) {
+            task.get();
+        }
+    };
 
-    for (size_t i = 0; i < indices_.size(); i += 3) {
-        int triIdx = static_cast<int>(i / 3);
-        uint32_t v0 = indices_[i], v1 = indices_[i + 1], v2 = indices_[i + 2];
+    // Face normals once per triangle instead of once per shared edge
+    std::vector<QVector3D> faceNormals(triangleCount);
+    runChunks(triangleCount, [&](int, size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            faceNormals[t] = getTriangleNormal(static_cast<int>(t));
+        }
+    });
 
-        // Add each edge of this triangle (ordered so min vertex first)
-        auto addEdge = [&](uint32_t a, uint32_t b) {
-            auto key = std::make_pair(std::min(a, b), std::max(a, b));
-            edgeTriangles[key].push_back(triIdx);
-        };
-        addEdge(v0, v1);
-        addEdge(v1, v2);
-        addEdge(v2, v0);
+    // Bucket sizes per lower vertex, then bucket offsets
+    std::unique_ptr<std::atomic<uint32_t>[]> cursors(new std::atomic<uint32_t>[vertexSlots]);
+    for (size_t v = 0; v < vertexSlots; v++) {
+        cursors[v].store(0, std::memory_order_relaxed);
+    }
+    runChunks(triangleCount, [&](int, size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t a = indices_[t * 3 + k];
+                uint32_t b = indices_[t * 3 + (k + 1) % 3];
+                cursors[std::min(a, b)].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    std::vector<uint32_t> bucketStart(vertexSlots + 1, 0);
+    for (size_t v = 0; v < vertexSlots; v++) {
+        uint32_t size = cursors[v].load(std::memory_order_relaxed);
+        cursors[v].store(bucketStart[v], std::memory_order_relaxed);
+        bucketStart[v + 1] = bucketStart[v] + size;
     }
 
+    // Scatter (upper vertex, triangle) into the buckets
+    struct EdgeRef {
+        uint32_t other;
+        uint32_t triangle;
+    };
+    std::vector<EdgeRef> refs(triangleCount * 3);
+    runChunks(triangleCount, [&](int, size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t a = indices_[t * 3 + k];
+                uint32_t b = indices_[t * 3 + (k + 1) % 3];
+                uint32_t slot = cursors[std::min(a, b)].fetch_add(1, std::memory_order_relaxed);
+                refs[slot] = {std::max(a, b), static_cast<uint32_t>(t)};
+            }
+        }
+    });
+    cursors.reset();
+
     // Crease threshold: cos(10°) ≈ 0.985
     // Edges where adjacent faces differ by more than ~10° are "creases"
     constexpr float kCreaseThreshold = 0.985f;
 
-    for (const auto& [edge, tris] : edgeTriangles) {
-        GeometricEdge ge;
-        ge.v0 = edge.first;
-        ge.v1 = edge.second;
-
-        if (tris.size() == 1) {
-            // Boundary edge (only one face) - always draw
-            ge.isCrease = true;
-            ge.creaseAngle = static_cast<float>(M_PI);  // 180° for boundary
-        } else if (tris.size() == 2) {
-            // Compare normals of adjacent triangles
-            QVector3D n0 = getTriangleNormal(tris[0]);
-            QVector3D n1 = getTriangleNormal(tris[1]);
-            float dot = QVector3D::dotProduct(n0, n1);
-            ge.creaseAngle = std::acos(std::clamp(dot, -1.0f, 1.0f));
-            ge.isCrease = (dot < kCreaseThreshold);
-        } else {
-            // Non-manifold edge (3+ faces) - draw it as a warning
-            ge.isCrease = true;
-            ge.creaseAngle = 0.0f;
+    // Sort each (small) bucket so equal edges are adjacent and in triangle
+    // order, then classify every run of equal edges
+    std::vector<std::vector<GeometricEdge>> chunkEdges(numChunks);
+    runChunks(vertexSlots, [&](int c, size_t begin, size_t end) {
+        std::vector<GeometricEdge>& out = chunkEdges[c];
+        out.reserve((bucketStart[end] - bucketStart[begin]) / 2 + 1);
+        for (size_t v = begin; v < end; v++) {
+            EdgeRef* first = refs.data() + bucketStart[v];
+            EdgeRef* last = refs.data() + bucketStart[v + 1];
+            std::sort(first, last, [](const EdgeRef& x, const EdgeRef& y) {
+                return x.other != y.other ? x.other < y.other : x.triangle < y.triangle;
+            });
+
+            for (EdgeRef* run = first; run != last;) {
+                EdgeRef* runEnd = run + 1;
+                while (runEnd != last && runEnd->other == run->other) {
+                    ++runEnd;
+                }
+
+                GeometricEdge ge;
+                ge.v0 = static_cast<uint32_t>(v);
+                ge.v1 = run->other;
+                if (runEnd - run == 1) {
+                    // Boundary edge (only one face) - always draw
+                    ge.isCrease = true;
+                    ge.creaseAngle = static_cast<float>(M_PI);  // 180° for boundary
+                } else if (runEnd - run == 2) {
+                    // Compare normals of adjacent triangles
+                    float dot = QVector3D::dotProduct(faceNormals[run[0].triangle], faceNormals[run[1].triangle]);
+                    ge.creaseAngle = std::acos(std::clamp(dot, -1.0f, 1.0f));
+                    ge.isCrease = (dot < kCreaseThreshold);
+                } else {
+                    // Non-manifold edge (3+ faces) - draw it as a warning
+                    ge.isCrease = true;
+                    ge.creaseAngle = 0.0f;
+                }
+                out.push_back(ge);
+                run = runEnd;
+            }
         }
+    });
 
-        edges_.push_back(ge);
+    size_t edgeCount = 0;
+    for (const auto& chunk : chunkEdges) {
+        edgeCount += chunk.size();
+    }
+    edges_.reserve(edgeCount);
+    for (const auto& chunk : chunkEdges) {
+        edges_.insert(edges_.end(), chunk.begin(), chunk.end());
     }
 }
 
@@ -528,5 +928,11 @@ void WireframeTarget::uploadEdgeGeometry() {
                  edgeVertices_.size() * sizeof(float),
                  edgeVertices_.data(),
                  GL_STATIC_DRAW);
+
+    // Position only (location 0); normal comes from a constant attribute
+    edgeVao_.bind();
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+    edgeVao_.release();
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -7,11 +7,16 @@
 #include <QVector3D>
 #include <QMatrix4x4>
 #include <QQuaternion>
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <string_view>
+#include <atomic>
+#include <future>
 
 #include "WireframeShapes.h"
+#include "MeshSimplifier.h"
+#include "GPUMemory.h"
 
 // Edge structure for rendering and physics (edge diffraction)
 struct GeometricEdge {
@@ -30,7 +35,16 @@ public:
 
     // Core lifecycle
     virtual void initialize();
+    // Builds the mesh (and its edges) without touching GL - for headless users
+    // such as the CPU sweep backend. initialize() does this itself.
+    void generateMesh() { generateGeometry(); }
     virtual void render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& sceneModel);
+    // Draws one copy per offset (applied in world space, before sceneModel) with
+    // a single instanced draw each for surfaces and edges. Missing colors use
+    // the target color.
+    void render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& sceneModel,
+                const std::vector<QMatrix4x4>& instanceOffsets,
+                const std::vector<QVector3D>& instanceColors = {});
     void uploadGeometryToGPU();
 
     // Type identification
@@ -61,10 +75,32 @@ public:
     // Radar position for angle-based edge shading
     void setRadarPosition(const QVector3D& pos) { radarPos_ = pos; }
 
+    // RCS hotspot overlay - a shared RCSCompute::getHotspotBuffer(), read in
+    // the fragment shader by triangle, and this mesh's triangleOffset in it
+    // (RCSCompute::getMeshHotspotOffset). 0 = off. The caller orders the
+    // draw after the buffer's writes.
+    void setHotspotBuffer(GLuint buffer, int triangleOffset) {
+        hotspotBuffer_ = triangleOffset >= 0 ? buffer : 0;
+        hotspotOffset_ = std::max(triangleOffset, 0);
+    }
+    GLuint getHotspotBuffer() const { return hotspotBuffer_; }
+
     // Geometry accessors (for RCS ray tracing)
     const std::vector<float>& getVertices() const { return vertices_; }
     const std::vector<GLuint>& getIndices() const { return indices_; }
     QMatrix4x4 getModelMatrix() const { return buildModelMatrix(); }
+    const std::vector<GeometricEdge>& getEdges() const { return edges_; }
+    uint64_t getGeometryVersion() const { return geometryVersion_; }  // Changes whenever the mesh is regenerated
+    // Material table index per triangle of getIndices(); empty = all material 0
+    virtual std::vector<uint32_t> getMaterialIds() const { return {}; }
+    // Exact surfaces (object space) the RCS trace can use instead of the mesh;
+    // empty for targets that only exist as triangles
+    virtual std::vector<AnalyticShape> getAnalyticShapes() const { return {}; }
+
+    // Display level of detail. Levels are built in the background for meshes of
+    // kLodMinTriangles or more; getIndices() always stays full resolution.
+    int getLodLevelCount() const { return static_cast<int>(lodLevels_.size()); }
+    int getCurrentLod() const { return currentLod_; }
 
     // Factory method
     static std::unique_ptr<WireframeTarget> createTarget(WireframeType type);
@@ -83,12 +119,37 @@ protected:
     int vertexCount_ = 0;
     int indexCount_ = 0;
     bool geometryDirty_ = false;
+    uint64_t geometryVersion_ = 0;  // Unique across targets; bumped by clearGeometry()
 
     // Edge data for rendering and physics
     std::vector<GeometricEdge> edges_;     // All detected edges with crease info
     std::vector<float> edgeVertices_;      // Edge line vertices for rendering (x,y,z pairs)
     GLuint edgeVboId_ = 0;                 // Separate VBO for edge lines
     int edgeVertexCount_ = 0;
+    QOpenGLVertexArrayObject edgeVao_;
+
+    // Instanced drawing - per-instance model matrix + color (20 floats each)
+    GLuint instanceVboId_ = 0;
+    std::vector<float> instanceData_;      // Last upload, to skip unchanged frames
+    GLsizei instanceCount_ = 0;
+
+    // Vertex, index, edge and instance buffers, reported to RS::GPUMemory
+    RS::GPUAllocation gpuMemory_{RS::GPUMemoryPool::TargetMeshes};
+
+    // Level of detail: index ranges into eboId_, finest (indices_ itself) first.
+    // Every level indexes vboId_, so switching levels is only a different range.
+    struct LodBuild {
+        MeshLodChain chain;
+        uint64_t geometryVersion = 0;
+    };
+    std::vector<MeshLodLevel> lodLevels_;
+    std::future<LodBuild> lodJob_;
+    std::shared_ptr<std::atomic<bool>> lodCancel_;
+    int currentLod_ = 0;
+
+    // Object-space bounding sphere, for frustum culling and LOD selection
+    QVector3D boundsCenter_;
+    float boundsRadius_ = 0.0f;
 
     // Transform state
     QVector3D position_ = QVector3D(0.0f, 0.0f, 0.0f);
@@ -102,6 +163,10 @@ protected:
     // Radar position for angle-based shading
     QVector3D radarPos_ = QVector3D(0.0f, 0.0f, 100.0f);
 
+    // RCS hotspot overlay (not owned)
+    GLuint hotspotBuffer_ = 0;
+    int hotspotOffset_ = 0;
+
     // Shader sources (string_view for type-safe literals)
     std::string_view vertexShaderSource_;
     std::string_view fragmentShaderSource_;
@@ -125,4 +190,17 @@ protected:
     void generateEdgeGeometry();      // Build edge line vertices for rendering
     void uploadEdgeGeometry();        // Upload edge lines to GPU
     QVector3D getTriangleNormal(int triIdx) const;  // Compute face normal for edge detection
+
+    // Level of detail helpers
+    void startLodBuild();             // Simplify a copy of the mesh on a worker
+    void cancelLodBuild();            // Stop and discard any running build
+    void uploadLodLevels();           // Append finished levels to the EBO (GL thread)
+    void releaseLodLevels();          // Shrink the EBO back to the full mesh (over budget)
+    int selectLod(const QMatrix4x4& projection, const QMatrix4x4& modelView, int viewportHeight);
+    void updateBounds();              // Bounding sphere of vertices_
+    void accountMemory();             // Report the buffer sizes to gpuMemory_
+
+    // Instancing helpers
+    void setupInstanceAttributes();   // Instance attribute layout of the bound VAO
+    void uploadInstances(const std::vector<QMatrix4x4>& models, const std::vector<QVector3D>& colors);
 };
@@ -15,7 +15,8 @@ WireframeTargetController::WireframeTargetController(QObject* parent)
       rotation_(0.0f, 0.0f, 0.0f),
       scale_(Defaults::kTargetScale),
       color_(Colors::kTargetGreen[0], Colors::kTargetGreen[1], Colors::kTargetGreen[2]),
-      showTarget_(true)
+      showTarget_(true),
+      instanceOffsets_(1)
 {
 }
 
@@ -35,7 +36,7 @@ void WireframeTargetController::render(const QMatrix4x4& projection, const QMatr
     if (!showTarget_ || !target_) {
         return;
     }
-    target_->render(projection, view, model);
+    target_->render(projection, view, model, instanceOffsets_);
 }
 
 void WireframeTargetController::rebuildGeometry() {
@@ -154,6 +155,40 @@ void WireframeTargetController::setRadarPosition(const QVector3D& pos) {
     }
 }
 
+void WireframeTargetController::setFormation(const std::vector<QMatrix4x4>& offsets) {
+    formationOffsets_ = offsets;
+    instanceOffsets_.assign(1, QMatrix4x4());
+    instanceOffsets_.insert(instanceOffsets_.end(), offsets.begin(), offsets.end());
+}
+
+void WireframeTargetController::setFormation(int count, float spacing) {
+    setFormation(makeVFormation(count, spacing));
+}
+
+void WireframeTargetController::getInstanceModelMatrices(std::vector<QMatrix4x4>& matrices) const {
+    matrices.clear();
+    if (!target_) {
+        return;
+    }
+    QMatrix4x4 lead = target_->getModelMatrix();
+    matrices.push_back(lead);
+    for (const QMatrix4x4& offset : formationOffsets_) {
+        matrices.push_back(offset * lead);
+    }
+}
+
+std::vector<QMatrix4x4> WireframeTargetController::makeVFormation(int count, float spacing) {
+    std::vector<QMatrix4x4> offsets;
+    for (int i = 1; i < count; ++i) {
+        int rank = (i + 1) / 2;
+        float side = (i % 2 == 1) ? 1.0f : -1.0f;
+        QMatrix4x4 offset;
+        offset.translate(-rank * spacing, side * rank * spacing, 0.0f);
+        offsets.push_back(offset);
+    }
+    return offsets;
+}
+
 void WireframeTargetController::createTarget() {
     // Create new target using factory (unique_ptr automatically deletes old target)
     target_ = WireframeTarget::createTarget(currentType_);
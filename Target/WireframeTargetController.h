@@ -5,6 +5,7 @@
 #include <QVector3D>
 #include <QMatrix4x4>
 #include <memory>
+#include <vector>
 
 #include "WireframeTarget.h"
 #include "WireframeShapes.h"
@@ -51,6 +52,18 @@ public:
     // Radar position for angle-based edge shading
     void setRadarPosition(const QVector3D& pos);
 
+    // Formation - extra copies of the target that share its mesh. Each offset is
+    // applied in world space on top of the lead target's transform.
+    void setFormation(const std::vector<QMatrix4x4>& offsets);
+    void setFormation(int count, float spacing);  // V formation of count targets, lead included
+    int getInstanceCount() const { return 1 + static_cast<int>(formationOffsets_.size()); }
+    // Lead first. Fills matrices in place so per-frame callers keep its capacity.
+    void getInstanceModelMatrices(std::vector<QMatrix4x4>& matrices) const;
+
+    // Offsets for a V of count targets (lead excluded): wingmen trail along -X,
+    // alternating +Y/-Y, spacing world units apart per rank
+    static std::vector<QMatrix4x4> makeVFormation(int count, float spacing);
+
     // Access to underlying target
     WireframeTarget* getTarget() const { return target_.get(); }
 
@@ -74,6 +87,8 @@ private:
     float scale_ = 20.0f;  // Default scale for visibility
     QVector3D color_ = QVector3D(0.0f, 1.0f, 0.0f);
     bool showTarget_ = true;
+    std::vector<QMatrix4x4> formationOffsets_;
+    std::vector<QMatrix4x4> instanceOffsets_;  // Identity (lead) + formationOffsets_, drawn instanced
 
     void createTarget();
 };
@@ -3,11 +3,13 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
-#include <QJsonDocument>
 #include <QJsonObject>
 #include <QStandardPaths>
+#include <QTimer>
 #include <QDebug>
 
+#include "Constants.h"
+
 namespace RSConfig {
 
 AppSettings::AppSettings(QObject* parent)
@@ -16,6 +18,14 @@ AppSettings::AppSettings(QObject* parent)
     // Ensure config directories exist
     QDir().mkpath(configDir());
     QDir().mkpath(profilesDir());
+
+    sessionSaveTimer_ = new QTimer(this);
+    sessionSaveTimer_->setSingleShot(true);
+    sessionSaveTimer_->setInterval(RS::Constants::View::kSettingsSaveDebounceMs);
+    connect(sessionSaveTimer_, &QTimer::timeout, this, [this]() {
+        emit aboutToSaveSession();
+        saveLastSession();
+    });
 }
 
 QString AppSettings::configDir() const
@@ -31,30 +41,41 @@ QString AppSettings::profilesDir() const
 
 QString AppSettings::profilePath(const QString& name) const
 {
-    return profilesDir() + "/" + name + ".json";
+    return profilesDir() + "/" + name;
 }
 
 QString AppSettings::lastSessionPath() const
 {
-    return configDir() + "/last_session.json";
+    return configDir() + "/last_session";
 }
 
-bool AppSettings::saveToFile(const QString& path) const
+QString AppSettings::extension(SettingsFormat format)
 {
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "AppSettings: Failed to open file for writing:" << path;
-        return false;
-    }
+    return format == SettingsFormat::Cbor ? ".cbor" : ".json";
+}
 
-    QJsonDocument doc(toJson());
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
-    return true;
+SettingsFormat AppSettings::otherFormat(SettingsFormat format)
+{
+    return format == SettingsFormat::Cbor ? SettingsFormat::Json : SettingsFormat::Cbor;
 }
 
-bool AppSettings::loadFromFile(const QString& path)
+void AppSettings::saveToFile(const QString& basePath)
 {
+    // toJson() is the snapshot; everything after it runs on the writer's thread
+    writer_.write(basePath + extension(format_), toJson(), format_,
+                  basePath + extension(otherFormat(format_)));
+}
+
+bool AppSettings::loadFromFile(const QString& basePath)
+{
+    QString path = basePath + extension(format_);
+    if (!QFile::exists(path) && !writer_.isPending(path)) {
+        path = basePath + extension(otherFormat(format_));
+    }
+    if (writer_.isPending(path)) {
+        writer_.flush();  // Read back what was last saved, not what is on disk
+    }
+
     QFile file(path);
     if (!file.exists()) {
         return false;
@@ -68,19 +89,14 @@ bool AppSettings::loadFromFile(const QString& path)
     QByteArray data = file.readAll();
     file.close();
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
-    if (parseError.error != QJsonParseError::NoError) {
-        qWarning() << "AppSettings: JSON parse error:" << parseError.errorString();
-        return false;
-    }
-
-    if (!doc.isObject()) {
-        qWarning() << "AppSettings: Invalid JSON structure";
+    QJsonObject obj;
+    QString error;
+    if (!SettingsWriter::decode(data, obj, error)) {
+        qWarning() << "AppSettings:" << error << "in" << path;
         return false;
     }
 
-    loadFromJson(doc.object());
+    loadFromJson(obj);
     return true;
 }
 
@@ -125,13 +141,10 @@ bool AppSettings::saveProfile(const QString& name)
         return false;
     }
 
-    QString path = profilePath(name);
-    if (saveToFile(path)) {
-        currentProfile_ = name;
-        emit profilesChanged();
-        return true;
-    }
-    return false;
+    saveToFile(profilePath(name));
+    currentProfile_ = name;
+    emit profilesChanged();
+    return true;
 }
 
 bool AppSettings::loadProfile(const QString& name)
@@ -141,8 +154,7 @@ bool AppSettings::loadProfile(const QString& name)
         return false;
     }
 
-    QString path = profilePath(name);
-    if (loadFromFile(path)) {
+    if (loadFromFile(profilePath(name))) {
         currentProfile_ = name;
         return true;
     }
@@ -155,9 +167,15 @@ bool AppSettings::deleteProfile(const QString& name)
         return false;
     }
 
-    QString path = profilePath(name);
-    QFile file(path);
-    if (file.exists() && file.remove()) {
+    // Both formats; a queued save would otherwise bring the profile back
+    bool removed = false;
+    for (SettingsFormat format : {SettingsFormat::Json, SettingsFormat::Cbor}) {
+        QString path = profilePath(name) + extension(format);
+        removed = writer_.discard(path) || removed;
+        QFile file(path);
+        removed = (file.exists() && file.remove()) || removed;
+    }
+    if (removed) {
         if (currentProfile_ == name) {
             currentProfile_.clear();
         }
@@ -171,22 +189,43 @@ QStringList AppSettings::availableProfiles() const
 {
     QDir dir(profilesDir());
     QStringList filters;
-    filters << "*.json";
+    filters << "*.json" << "*.cbor";
     QStringList files = dir.entryList(filters, QDir::Files, QDir::Name);
 
-    // Remove .json extension
+    // Profiles saved but not yet written count too
+    QString prefix = profilesDir() + "/";
+    for (const QString& path : writer_.pendingPaths()) {
+        if (path.startsWith(prefix)) {
+            files << path.mid(prefix.length());
+        }
+    }
+
+    // Remove the extension (both have five characters)
     QStringList profiles;
     for (const QString& file : files) {
         profiles << file.left(file.length() - 5);
     }
+    profiles.removeDuplicates();
+    profiles.sort();
     return profiles;
 }
 
 void AppSettings::saveLastSession()
 {
+    sessionSaveTimer_->stop();
     saveToFile(lastSessionPath());
 }
 
+void AppSettings::scheduleLastSessionSave()
+{
+    sessionSaveTimer_->start();  // Restarts while changes keep coming
+}
+
+void AppSettings::flush()
+{
+    writer_.flush();
+}
+
 bool AppSettings::restoreLastSession()
 {
     if (loadFromFile(lastSessionPath())) {
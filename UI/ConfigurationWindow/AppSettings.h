@@ -4,19 +4,27 @@
 #include <QString>
 #include <QStringList>
 
+#include "SettingsWriter.h"
 #include "BeamConfig.h"
 #include "CameraConfig.h"
 #include "TargetConfig.h"
 #include "SceneConfig.h"
 
+class QTimer;
+
 namespace RSConfig {
 
+// Profiles and the last session are written by a SettingsWriter: saves take
+// a snapshot on the calling thread and return, the encoding, write and
+// atomic rename happen on its I/O thread. scheduleLastSessionSave() further
+// coalesces a burst of UI changes into one save once the settings go quiet.
+
 class AppSettings : public QObject {
     Q_OBJECT
 
 public:
     explicit AppSettings(QObject* parent = nullptr);
-    ~AppSettings() override = default;
+    ~AppSettings() override = default;  // The writer finishes queued saves
 
     // Configuration data
     BeamConfig beam;
@@ -24,7 +32,8 @@ public:
     TargetConfig target;
     SceneConfig scene;
 
-    // Profile management
+    // Profile management. saveProfile() queues the write and returns true
+    // once queued; write errors are reported by the writer.
     bool saveProfile(const QString& name);
     bool loadProfile(const QString& name);
     bool deleteProfile(const QString& name);
@@ -34,6 +43,17 @@ public:
     // Session persistence (auto-save/restore)
     void saveLastSession();
     bool restoreLastSession();
+    // Saves the session once no further call has come for
+    // View::kSettingsSaveDebounceMs; emits aboutToSaveSession() first
+    void scheduleLastSessionSave();
+
+    // Encoding of files written from now on. Files of either format load;
+    // saving a profile or session removes its copy in the other format.
+    void setStorageFormat(SettingsFormat format) { format_ = format; }
+    SettingsFormat getStorageFormat() const { return format_; }
+
+    // Blocks until every queued save is on disk
+    void flush();
 
     // Reset to defaults
     void resetToDefaults();
@@ -44,17 +64,28 @@ public:
 
 signals:
     void profilesChanged();
+    // A debounced session save is about to snapshot the settings; connect
+    // with a direct connection to copy live state into them first
+    void aboutToSaveSession();
 
 private:
     QString configDir() const;
     QString profilesDir() const;
+    // File paths without the format's extension
     QString profilePath(const QString& name) const;
     QString lastSessionPath() const;
+    static QString extension(SettingsFormat format);
+    static SettingsFormat otherFormat(SettingsFormat format);
 
-    bool saveToFile(const QString& path) const;
-    bool loadFromFile(const QString& path);
+    // Queues a snapshot for basePath + the current format's extension
+    void saveToFile(const QString& basePath);
+    // Loads basePath in the current format, else in the other one
+    bool loadFromFile(const QString& basePath);
 
     QString currentProfile_;
+    SettingsFormat format_ = SettingsFormat::Json;
+    SettingsWriter writer_;
+    QTimer* sessionSaveTimer_ = nullptr;
     static constexpr int kConfigVersion = 1;
 };
 
@@ -1,7 +1,33 @@
 // ConfigurationWindow.cpp - Floating configuration window implementation
 
 #include "ConfigurationWindow.h"
+#include "SceneConfig.h"
+#include "Constants.h"
 #include <QFormLayout>
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace {
+
+// Ray count slider is logarithmic so 100 rays and 16M rays are both reachable
+int sliderPositionToRayCount(int position)
+{
+    double t = static_cast<double>(position) / UI::kRayCountSliderSteps;
+    double ratio = static_cast<double>(kMaxRayCount) / kMinRayCount;
+    return static_cast<int>(std::lround(kMinRayCount * std::pow(ratio, t)));
+}
+
+int rayCountToSliderPosition(int count)
+{
+    count = qBound(kMinRayCount, count, kMaxRayCount);
+    double ratio = static_cast<double>(kMaxRayCount) / kMinRayCount;
+    double t = std::log(static_cast<double>(count) / kMinRayCount) / std::log(ratio);
+    return static_cast<int>(std::lround(t * UI::kRayCountSliderSteps));
+}
+
+} // namespace
 
 ConfigurationWindow::ConfigurationWindow(QWidget* parent)
     : QWidget(parent, Qt::Window)  // Qt::Window makes it a separate top-level window
@@ -22,6 +48,7 @@ void ConfigurationWindow::setupUI()
     mainLayout->addWidget(createBeamGroup());
     mainLayout->addWidget(createVisualizationGroup());
     mainLayout->addWidget(createTargetGroup());
+    mainLayout->addWidget(createTracingGroup());
     mainLayout->addStretch();
 
     // Set a reasonable default size
@@ -191,13 +218,14 @@ QGroupBox* ConfigurationWindow::createVisualizationGroup()
     rayCountLayout->setContentsMargins(0, 0, 0, 0);
     rayCountLayout->addWidget(new QLabel("Ray Count:", rayCountWidget_));
     rayCountSlider_ = new QSlider(Qt::Horizontal, rayCountWidget_);
-    rayCountSlider_->setRange(100, 10000);
-    rayCountSlider_->setValue(10000);
-    rayCountSlider_->setSingleStep(100);
-    rayCountSlider_->setPageStep(1000);
-    rayCountSlider_->setToolTip("Number of rays for RCS computation (100-10000)");
-    rayCountLabel_ = new QLabel("10000", rayCountWidget_);
-    rayCountLabel_->setMinimumWidth(40);
+    rayCountSlider_->setRange(0, UI::kRayCountSliderSteps);
+    rayCountSlider_->setValue(rayCountToSliderPosition(kDefaultNumRays));
+    rayCountSlider_->setSingleStep(1);
+    rayCountSlider_->setPageStep(UI::kRayCountSliderSteps / 20);
+    rayCountSlider_->setToolTip(QString("Number of rays for RCS computation (%1-%2, logarithmic)")
+                                    .arg(kMinRayCount).arg(kMaxRayCount));
+    rayCountLabel_ = new QLabel(QString::number(kDefaultNumRays), rayCountWidget_);
+    rayCountLabel_->setMinimumWidth(60);
     rayCountLayout->addWidget(rayCountSlider_);
     rayCountLayout->addWidget(rayCountLabel_);
     layout->addWidget(rayCountWidget_);
@@ -206,8 +234,9 @@ QGroupBox* ConfigurationWindow::createVisualizationGroup()
     connect(showReflectionLobesCheckBox_, &QCheckBox::toggled, this, &ConfigurationWindow::reflectionLobesChanged);
     connect(showHeatMapCheckBox_, &QCheckBox::toggled, this, &ConfigurationWindow::heatMapChanged);
     connect(rayCountSlider_, &QSlider::valueChanged, this, [this](int value) {
-        rayCountLabel_->setText(QString::number(value));
-        emit rayCountChanged(value);
+        int count = sliderPositionToRayCount(value);
+        rayCountLabel_->setText(QString::number(count));
+        emit rayCountChanged(count);
     });
 
     return group;
@@ -231,6 +260,9 @@ QGroupBox* ConfigurationWindow::createTargetGroup()
     targetTypeComboBox_->addItem("Cylinder", static_cast<int>(WireframeType::Cylinder));
     targetTypeComboBox_->addItem("Aircraft", static_cast<int>(WireframeType::Aircraft));
     targetTypeComboBox_->addItem("Sphere", static_cast<int>(WireframeType::Sphere));
+    targetTypeComboBox_->addItem("Flat Plate", static_cast<int>(WireframeType::Plate));
+    targetTypeComboBox_->addItem("Dihedral", static_cast<int>(WireframeType::Dihedral));
+    targetTypeComboBox_->addItem("Trihedral", static_cast<int>(WireframeType::Trihedral));
     typeLayout->addWidget(targetTypeComboBox_);
     layout->addLayout(typeLayout);
 
@@ -245,6 +277,119 @@ QGroupBox* ConfigurationWindow::createTargetGroup()
     return group;
 }
 
+QGroupBox* ConfigurationWindow::createTracingGroup()
+{
+    QGroupBox* group = new QGroupBox("RCS Tracing", this);
+    QVBoxLayout* layout = new QVBoxLayout(group);
+    layout->setSpacing(4);
+
+    temporalReuseCheckBox_ = new QCheckBox("Temporal Reuse", group);
+    temporalReuseCheckBox_->setChecked(Defaults::kTemporalReuse);
+    temporalReuseCheckBox_->setToolTip("Start rays from the surfaces they hit last frame and blend small "
+                                       "radar moves with the last frame's result");
+    layout->addWidget(temporalReuseCheckBox_);
+
+    decoupledShadowsCheckBox_ = new QCheckBox("Decoupled Shadows", group);
+    decoupledShadowsCheckBox_->setChecked(Defaults::kDecoupledShadows);
+    decoupledShadowsCheckBox_->setToolTip("Trace the beam shadow at the footprint's screen resolution instead of the RCS ray count");
+    layout->addWidget(decoupledShadowsCheckBox_);
+
+    resultCachingCheckBox_ = new QCheckBox("Result Caching", group);
+    resultCachingCheckBox_->setChecked(Defaults::kRCSResultCache);
+    resultCachingCheckBox_->setToolTip("Keep settled results and restore them when a configuration is revisited, without tracing");
+    layout->addWidget(resultCachingCheckBox_);
+
+    // Multi-bounce paths and their termination
+    QHBoxLayout* bouncesLayout = new QHBoxLayout();
+    bouncesLayout->addWidget(new QLabel("Bounces:", group));
+    bouncesSpinBox_ = new QSpinBox(group);
+    bouncesSpinBox_->setRange(1, kMaxRCSBounces);
+    bouncesSpinBox_->setValue(Defaults::kRCSBounces);
+    bouncesSpinBox_->setToolTip("Reflections traced per beam ray (1 = single bounce)");
+    bouncesLayout->addWidget(bouncesSpinBox_);
+    layout->addLayout(bouncesLayout);
+
+    QHBoxLayout* cutoffLayout = new QHBoxLayout();
+    cutoffLayout->addWidget(new QLabel("Bounce Cutoff:", group));
+    bounceCutoffSpinBox_ = new QDoubleSpinBox(group);
+    bounceCutoffSpinBox_->setDecimals(4);
+    bounceCutoffSpinBox_->setRange(0.0, 0.1);
+    bounceCutoffSpinBox_->setSingleStep(0.0005);
+    bounceCutoffSpinBox_->setValue(kBounceCutoffIntensity);
+    bounceCutoffSpinBox_->setToolTip("Return intensity at which a multi-bounce path stops (0 = never)");
+    cutoffLayout->addWidget(bounceCutoffSpinBox_);
+    layout->addLayout(cutoffLayout);
+
+    QHBoxLayout* rouletteLayout = new QHBoxLayout();
+    rouletteLayout->addWidget(new QLabel("Roulette Below:", group));
+    rouletteSpinBox_ = new QDoubleSpinBox(group);
+    rouletteSpinBox_->setDecimals(3);
+    rouletteSpinBox_->setRange(0.0, 1.0);
+    rouletteSpinBox_->setSingleStep(0.01);
+    rouletteSpinBox_->setValue(kBounceRouletteThreshold);
+    rouletteSpinBox_->setToolTip("Return intensity under which a path continues by Russian roulette (0 = never)");
+    rouletteLayout->addWidget(rouletteSpinBox_);
+    layout->addLayout(rouletteLayout);
+
+    // Material table entry every triangle of the target is shaded with
+    QHBoxLayout* materialLayout = new QHBoxLayout();
+    materialLayout->addWidget(new QLabel("Target Material:", group));
+    materialComboBox_ = new QComboBox(group);
+    for (const RCS::MaterialPreset& preset : RCS::kMaterialPresets) {
+        materialComboBox_->addItem(QString(preset.name).toUpper(), QString(preset.name));
+    }
+    materialComboBox_->setToolTip("Surface of the whole target: bare metal (PEC), absorbent coating (RAM), "
+                                  "dielectric skin or rough metal");
+    materialLayout->addWidget(materialComboBox_);
+    layout->addLayout(materialLayout);
+
+    // Trace pacing while a control is dragged
+    QHBoxLayout* budgetLayout = new QHBoxLayout();
+    budgetLayout->addWidget(new QLabel("Trace Budget:", group));
+    frameBudgetSpinBox_ = new QDoubleSpinBox(group);
+    frameBudgetSpinBox_->setDecimals(1);
+    frameBudgetSpinBox_->setRange(1.0, 100.0);
+    frameBudgetSpinBox_->setSingleStep(1.0);
+    frameBudgetSpinBox_->setSuffix(" ms");
+    frameBudgetSpinBox_->setValue(Defaults::kRCSFrameBudgetMs);
+    frameBudgetSpinBox_->setToolTip("GPU time per frame the RCS trace may use while a control is being dragged");
+    budgetLayout->addWidget(frameBudgetSpinBox_);
+    layout->addLayout(budgetLayout);
+
+    QHBoxLayout* memoryLayout = new QHBoxLayout();
+    memoryLayout->addWidget(new QLabel("GPU Memory:", group));
+    gpuMemorySpinBox_ = new QSpinBox(group);
+    gpuMemorySpinBox_->setRange(0, 65536);
+    gpuMemorySpinBox_->setSingleStep(256);
+    gpuMemorySpinBox_->setSuffix(" MB");
+    gpuMemorySpinBox_->setSpecialValueText("Auto");
+    gpuMemorySpinBox_->setValue(static_cast<int>(Defaults::kGPUMemoryBudgetMB));
+    gpuMemorySpinBox_->setToolTip("GPU memory the renderers and RCS buffers plan within; "
+                                  "Auto uses a share of the detected VRAM");
+    memoryLayout->addWidget(gpuMemorySpinBox_);
+    layout->addLayout(memoryLayout);
+
+    // Connect signals
+    connect(temporalReuseCheckBox_, &QCheckBox::toggled, this, &ConfigurationWindow::temporalReuseChanged);
+    connect(decoupledShadowsCheckBox_, &QCheckBox::toggled, this, &ConfigurationWindow::decoupledShadowsChanged);
+    connect(resultCachingCheckBox_, &QCheckBox::toggled, this, &ConfigurationWindow::resultCachingChanged);
+    connect(bouncesSpinBox_, QOverload<int>::of(&QSpinBox::valueChanged), this, &ConfigurationWindow::bouncesChanged);
+    auto emitTermination = [this]() {
+        emit bounceTerminationChanged(static_cast<float>(bounceCutoffSpinBox_->value()),
+                                      static_cast<float>(rouletteSpinBox_->value()));
+    };
+    connect(bounceCutoffSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, emitTermination);
+    connect(rouletteSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, emitTermination);
+    connect(materialComboBox_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            [this](int index) { emit targetMaterialChanged(materialComboBox_->itemData(index).toString()); });
+    connect(frameBudgetSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &ConfigurationWindow::frameBudgetChanged);
+    connect(gpuMemorySpinBox_, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &ConfigurationWindow::gpuMemoryBudgetChanged);
+
+    return group;
+}
+
 void ConfigurationWindow::setProfiles(const QStringList& profiles)
 {
     profileComboBox_->blockSignals(true);
@@ -297,7 +442,7 @@ void ConfigurationWindow::syncStateFromScene(bool axesVisible, bool sphereVisibl
     showBouncesCheckBox_->setChecked(showBounces);
     pathModeRadio_->setChecked(rayTraceMode == RCS::RayTraceMode::Path);
     physicsModeRadio_->setChecked(rayTraceMode == RCS::RayTraceMode::PhysicsAccurate);
-    rayCountSlider_->setValue(rayCount);
+    rayCountSlider_->setValue(rayCountToSliderPosition(rayCount));
     rayCountLabel_->setText(QString::number(rayCount));
     showBeamCheckBox_->setChecked(beamVisible);
     showShadowCheckBox_->setChecked(shadowVisible);
@@ -331,3 +476,47 @@ void ConfigurationWindow::syncStateFromScene(bool axesVisible, bool sphereVisibl
     showTargetCheckBox_->blockSignals(false);
     targetTypeComboBox_->blockSignals(false);
 }
+
+void ConfigurationWindow::readTraceSettings(RSConfig::SceneConfig& config) const
+{
+    config.rcsTemporalReuse = temporalReuseCheckBox_->isChecked();
+    config.rcsDecoupledShadows = decoupledShadowsCheckBox_->isChecked();
+    config.rcsResultCaching = resultCachingCheckBox_->isChecked();
+    config.rcsBounces = bouncesSpinBox_->value();
+    config.rcsBounceCutoff = static_cast<float>(bounceCutoffSpinBox_->value());
+    config.rcsRouletteThreshold = static_cast<float>(rouletteSpinBox_->value());
+    config.rcsMaterial = materialComboBox_->currentData().toString();
+    config.rcsFrameBudgetMs = static_cast<float>(frameBudgetSpinBox_->value());
+    config.gpuMemoryBudgetMB = gpuMemorySpinBox_->value();
+}
+
+void ConfigurationWindow::applyTraceSettings(const RSConfig::SceneConfig& config)
+{
+    temporalReuseCheckBox_->blockSignals(true);
+    temporalReuseCheckBox_->setChecked(config.rcsTemporalReuse);
+    temporalReuseCheckBox_->blockSignals(false);
+    decoupledShadowsCheckBox_->blockSignals(true);
+    decoupledShadowsCheckBox_->setChecked(config.rcsDecoupledShadows);
+    decoupledShadowsCheckBox_->blockSignals(false);
+    resultCachingCheckBox_->blockSignals(true);
+    resultCachingCheckBox_->setChecked(config.rcsResultCaching);
+    resultCachingCheckBox_->blockSignals(false);
+    bouncesSpinBox_->blockSignals(true);
+    bouncesSpinBox_->setValue(config.rcsBounces);
+    bouncesSpinBox_->blockSignals(false);
+    bounceCutoffSpinBox_->blockSignals(true);
+    bounceCutoffSpinBox_->setValue(config.rcsBounceCutoff);
+    bounceCutoffSpinBox_->blockSignals(false);
+    rouletteSpinBox_->blockSignals(true);
+    rouletteSpinBox_->setValue(config.rcsRouletteThreshold);
+    rouletteSpinBox_->blockSignals(false);
+    materialComboBox_->blockSignals(true);
+    materialComboBox_->setCurrentIndex(std::max(materialComboBox_->findData(config.rcsMaterial), 0));
+    materialComboBox_->blockSignals(false);
+    frameBudgetSpinBox_->blockSignals(true);
+    frameBudgetSpinBox_->setValue(config.rcsFrameBudgetMs);
+    frameBudgetSpinBox_->blockSignals(false);
+    gpuMemorySpinBox_->blockSignals(true);
+    gpuMemorySpinBox_->setValue(config.gpuMemoryBudgetMB);
+    gpuMemorySpinBox_->blockSignals(false);
+}
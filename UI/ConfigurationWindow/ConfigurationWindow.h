@@ -11,10 +11,16 @@
 #include <QLabel>
 #include <QSlider>
 #include <QRadioButton>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
 #include "BeamController.h"
 #include "WireframeShapes.h"
 #include "../RCS/RayTraceTypes.h"
 
+namespace RSConfig {
+    struct SceneConfig;
+}
+
 class ConfigurationWindow : public QWidget {
     Q_OBJECT
 
@@ -35,6 +41,10 @@ public:
                            bool targetVisible, WireframeType targetType,
                            RCS::RayTraceMode rayTraceMode = RCS::RayTraceMode::PhysicsAccurate);
 
+    // RCS tracing settings persistence
+    void readTraceSettings(RSConfig::SceneConfig& config) const;
+    void applyTraceSettings(const RSConfig::SceneConfig& config);
+
 signals:
     // Profile signals
     void profileSelected(int index);
@@ -64,6 +74,16 @@ signals:
     void rayTraceModeChanged(RCS::RayTraceMode mode);
     void rayCountChanged(int count);
 
+    // RCS tracing signals
+    void temporalReuseChanged(bool enabled);
+    void decoupledShadowsChanged(bool enabled);
+    void resultCachingChanged(bool enabled);
+    void bouncesChanged(int bounces);
+    void bounceTerminationChanged(float cutoff, float rouletteThreshold);
+    void targetMaterialChanged(const QString& preset);  // RCS::kMaterialPresets name
+    void frameBudgetChanged(double milliseconds);
+    void gpuMemoryBudgetChanged(int megabytes);
+
 private:
     void setupUI();
     QGroupBox* createProfileGroup();
@@ -71,6 +91,7 @@ private:
     QGroupBox* createBeamGroup();
     QGroupBox* createVisualizationGroup();
     QGroupBox* createTargetGroup();
+    QGroupBox* createTracingGroup();
 
     // Profile controls
     QComboBox* profileComboBox_ = nullptr;
@@ -102,4 +123,15 @@ private:
     // Target controls
     QCheckBox* showTargetCheckBox_ = nullptr;
     QComboBox* targetTypeComboBox_ = nullptr;
+
+    // RCS tracing controls
+    QCheckBox* temporalReuseCheckBox_ = nullptr;
+    QCheckBox* decoupledShadowsCheckBox_ = nullptr;
+    QCheckBox* resultCachingCheckBox_ = nullptr;
+    QSpinBox* bouncesSpinBox_ = nullptr;
+    QDoubleSpinBox* bounceCutoffSpinBox_ = nullptr;
+    QDoubleSpinBox* rouletteSpinBox_ = nullptr;
+    QComboBox* materialComboBox_ = nullptr;
+    QDoubleSpinBox* frameBudgetSpinBox_ = nullptr;
+    QSpinBox* gpuMemorySpinBox_ = nullptr;
 };
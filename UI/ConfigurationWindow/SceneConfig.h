@@ -13,11 +13,29 @@ struct SceneConfig {
     bool showAxes = true;
     bool showShadow = true;  // Show beam projection (shadow) on sphere
 
+    // Bistatic receiver site (RadarControlsWidget); the radar stays the transmitter
+    bool bistaticReceiver = false;
+    float receiverTheta = 225.0f;  // Azimuth angle in degrees
+    float receiverPhi = 45.0f;     // Elevation angle in degrees
+
     // RCS slicing plane settings
     int rcsCutType = 0;          // 0 = Azimuth, 1 = Elevation
     float rcsPlaneOffset = 0.0f; // Offset angle in degrees
     float rcsSliceThickness = 10.0f; // ±degrees (updated default)
     bool rcsPlaneShowFill = true;  // Show translucent fill in slicing plane
+    bool rcsCoherent = false;      // Sum complex fields per bin instead of intensities
+    bool rcsOverlayCut = false;    // Also plot the other cut type through the same trace
+
+    // RCS tracing settings (ConfigurationWindow)
+    bool rcsTemporalReuse = false;        // Seed rays and blend small moves from the last frame
+    int rcsBounces = 3;                   // Reflections traced per beam ray (1 = single bounce)
+    float rcsBounceCutoff = 1.0e-3f;      // Multi-bounce return at which a path stops
+    float rcsRouletteThreshold = 0.05f;   // ... and under which it plays Russian roulette (0 = never)
+    float rcsFrameBudgetMs = 8.0f;        // GPU time per frame for traces during interaction
+    int gpuMemoryBudgetMB = 0;            // GPU memory renderers plan within (0 = share of detected VRAM)
+    bool rcsDecoupledShadows = true;      // Beam shadow map sized from the screen, not the ray count
+    bool rcsResultCaching = true;         // Restore revisited configurations from RCSResultCache
+    QString rcsMaterial = "pec";          // RCS::kMaterialPresets entry of the whole target
 
     void loadFromJson(const QJsonObject& obj) {
         sphereRadius = static_cast<float>(obj.value("sphereRadius").toDouble(sphereRadius));
@@ -27,12 +45,28 @@ struct SceneConfig {
         showGrid = obj.value("showGrid").toBool(showGrid);
         showAxes = obj.value("showAxes").toBool(showAxes);
         showShadow = obj.value("showShadow").toBool(showShadow);
+        bistaticReceiver = obj.value("bistaticReceiver").toBool(bistaticReceiver);
+        receiverTheta = static_cast<float>(obj.value("receiverTheta").toDouble(receiverTheta));
+        receiverPhi = static_cast<float>(obj.value("receiverPhi").toDouble(receiverPhi));
 
         // RCS plane settings
         rcsCutType = obj.value("rcsCutType").toInt(rcsCutType);
         rcsPlaneOffset = static_cast<float>(obj.value("rcsPlaneOffset").toDouble(rcsPlaneOffset));
         rcsSliceThickness = static_cast<float>(obj.value("rcsSliceThickness").toDouble(rcsSliceThickness));
         rcsPlaneShowFill = obj.value("rcsPlaneShowFill").toBool(rcsPlaneShowFill);
+        rcsCoherent = obj.value("rcsCoherent").toBool(rcsCoherent);
+        rcsOverlayCut = obj.value("rcsOverlayCut").toBool(rcsOverlayCut);
+
+        // RCS tracing settings
+        rcsTemporalReuse = obj.value("rcsTemporalReuse").toBool(rcsTemporalReuse);
+        rcsBounces = obj.value("rcsBounces").toInt(rcsBounces);
+        rcsBounceCutoff = static_cast<float>(obj.value("rcsBounceCutoff").toDouble(rcsBounceCutoff));
+        rcsRouletteThreshold = static_cast<float>(obj.value("rcsRouletteThreshold").toDouble(rcsRouletteThreshold));
+        rcsFrameBudgetMs = static_cast<float>(obj.value("rcsFrameBudgetMs").toDouble(rcsFrameBudgetMs));
+        gpuMemoryBudgetMB = obj.value("gpuMemoryBudgetMB").toInt(gpuMemoryBudgetMB);
+        rcsDecoupledShadows = obj.value("rcsDecoupledShadows").toBool(rcsDecoupledShadows);
+        rcsResultCaching = obj.value("rcsResultCaching").toBool(rcsResultCaching);
+        rcsMaterial = obj.value("rcsMaterial").toString(rcsMaterial);
     }
 
     QJsonObject toJson() const {
@@ -44,12 +78,28 @@ struct SceneConfig {
         obj["showGrid"] = showGrid;
         obj["showAxes"] = showAxes;
         obj["showShadow"] = showShadow;
+        obj["bistaticReceiver"] = bistaticReceiver;
+        obj["receiverTheta"] = static_cast<double>(receiverTheta);
+        obj["receiverPhi"] = static_cast<double>(receiverPhi);
 
         // RCS plane settings
         obj["rcsCutType"] = rcsCutType;
         obj["rcsPlaneOffset"] = static_cast<double>(rcsPlaneOffset);
         obj["rcsSliceThickness"] = static_cast<double>(rcsSliceThickness);
         obj["rcsPlaneShowFill"] = rcsPlaneShowFill;
+        obj["rcsCoherent"] = rcsCoherent;
+        obj["rcsOverlayCut"] = rcsOverlayCut;
+
+        // RCS tracing settings
+        obj["rcsTemporalReuse"] = rcsTemporalReuse;
+        obj["rcsBounces"] = rcsBounces;
+        obj["rcsBounceCutoff"] = static_cast<double>(rcsBounceCutoff);
+        obj["rcsRouletteThreshold"] = static_cast<double>(rcsRouletteThreshold);
+        obj["rcsFrameBudgetMs"] = static_cast<double>(rcsFrameBudgetMs);
+        obj["gpuMemoryBudgetMB"] = gpuMemoryBudgetMB;
+        obj["rcsDecoupledShadows"] = rcsDecoupledShadows;
+        obj["rcsResultCaching"] = rcsResultCaching;
+        obj["rcsMaterial"] = rcsMaterial;
         return obj;
     }
 };
@@ -0,0 +1,172 @@
+#include "SettingsWriter.h"
+
+#include <QCborMap>
+#include <QCborValue>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QDebug>
+
+#include <algorithm>
+
+namespace RSConfig {
+
+SettingsWriter::SettingsWriter()
+{
+    ioThread_ = std::thread(&SettingsWriter::ioLoop, this);
+}
+
+SettingsWriter::~SettingsWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    queueChanged_.notify_all();
+    if (ioThread_.joinable()) {
+        ioThread_.join();
+    }
+}
+
+void SettingsWriter::write(const QString& path, const QJsonObject& snapshot, SettingsFormat format,
+                           const QString& obsoletePath)
+{
+    Job job{path, snapshot, format, obsoletePath};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto queued = std::find_if(queue_.begin(), queue_.end(),
+                               [&path](const Job& other) { return other.path == path; });
+    if (queued != queue_.end()) {
+        *queued = std::move(job);  // Keeps its place in line; only the newest snapshot is written
+    } else {
+        queue_.push_back(std::move(job));
+    }
+    queueChanged_.notify_all();
+}
+
+bool SettingsWriter::discard(const QString& path)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto queued = std::find_if(queue_.begin(), queue_.end(),
+                               [&path](const Job& job) { return job.path == path; });
+    bool dropped = queued != queue_.end();
+    if (dropped) {
+        queue_.erase(queued);
+    }
+    queueChanged_.wait(lock, [this, &path]() { return writing_ != path; });
+    return dropped;
+}
+
+void SettingsWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    queueChanged_.wait(lock, [this]() { return queue_.empty() && writing_.isEmpty(); });
+}
+
+bool SettingsWriter::isPending(const QString& path) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (writing_ == path) {
+        return true;
+    }
+    return std::any_of(queue_.begin(), queue_.end(),
+                       [&path](const Job& job) { return job.path == path; });
+}
+
+QStringList SettingsWriter::pendingPaths() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    QStringList paths;
+    if (!writing_.isEmpty()) {
+        paths << writing_;
+    }
+    for (const Job& job : queue_) {
+        paths << job.path;
+    }
+    return paths;
+}
+
+QByteArray SettingsWriter::encode(const QJsonObject& snapshot, SettingsFormat format)
+{
+    if (format == SettingsFormat::Cbor) {
+        return QCborMap::fromJsonObject(snapshot).toCborValue().toCbor();
+    }
+    return QJsonDocument(snapshot).toJson(QJsonDocument::Indented);
+}
+
+bool SettingsWriter::decode(const QByteArray& data, QJsonObject& object, QString& error)
+{
+    auto firstByte = std::find_if(data.begin(), data.end(),
+                                  [](char c) { return c != ' ' && c != '\t' && c != '\r' && c != '\n'; });
+    if (firstByte != data.end() && *firstByte == '{') {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            error = "JSON parse error: " + parseError.errorString();
+            return false;
+        }
+        if (!doc.isObject()) {
+            error = "Invalid JSON structure";
+            return false;
+        }
+        object = doc.object();
+        return true;
+    }
+
+    QCborParserError parseError;
+    QCborValue value = QCborValue::fromCbor(data, &parseError);
+    if (parseError.error != QCborError::NoError) {
+        error = "CBOR parse error: " + parseError.errorString();
+        return false;
+    }
+    if (!value.isMap()) {
+        error = "Invalid CBOR structure";
+        return false;
+    }
+    object = value.toMap().toJsonObject();
+    return true;
+}
+
+void SettingsWriter::ioLoop()
+{
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queueChanged_.wait(lock, [this]() { return !queue_.empty() || closing_; });
+            if (queue_.empty()) {
+                return;  // Closing and drained
+            }
+            job = std::move(queue_.front());
+            queue_.pop_front();
+            writing_ = job.path;
+        }
+
+        writeJob(job);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_.clear();
+        queueChanged_.notify_all();
+    }
+}
+
+void SettingsWriter::writeJob(const Job& job)
+{
+    // QSaveFile writes a temporary and renames it on commit
+    QSaveFile file(job.path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "AppSettings: Failed to open file for writing:" << job.path;
+        return;
+    }
+    QByteArray data = encode(job.snapshot, job.format);
+    if (file.write(data) != data.size() || !file.commit()) {
+        qWarning() << "AppSettings: Failed to write" << job.path << "-" << file.errorString();
+        return;
+    }
+
+    if (!job.obsoletePath.isEmpty() && QFile::exists(job.obsoletePath) && !QFile::remove(job.obsoletePath)) {
+        qWarning() << "AppSettings: Failed to remove" << job.obsoletePath;
+    }
+}
+
+} // namespace RSConfig
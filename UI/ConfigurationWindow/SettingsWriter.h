@@ -0,0 +1,72 @@
+// SettingsWriter.h - Settings files written on an I/O thread, atomically
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace RSConfig {
+
+// On-disk encoding of a settings file. Json is the indented, hand-editable
+// form; Cbor is the same object tree in compact binary, for settings that
+// carry large embedded data.
+enum class SettingsFormat {
+    Json,
+    Cbor
+};
+
+// Writes settings snapshots off the GUI thread. write() only queues the
+// snapshot (a shallow QJsonObject copy); the I/O thread encodes it and
+// replaces the file through QSaveFile, so a crash or a reader never sees
+// half a file. A snapshot still queued for the same path is replaced rather
+// than written twice, so bursts of saves cost one write. Failures are
+// reported with qWarning, as synchronous saves did.
+class SettingsWriter {
+public:
+    SettingsWriter();
+    ~SettingsWriter();  // Writes whatever is still queued
+
+    // Queues snapshot for path. obsoletePath, if set, is removed once the
+    // new file is in place (the same settings saved in the other format).
+    void write(const QString& path, const QJsonObject& snapshot, SettingsFormat format,
+               const QString& obsoletePath = QString());
+
+    // Drops a queued write of path and waits out one in progress, so the
+    // caller can delete the file without it coming back. Returns true if a
+    // queued write was dropped.
+    bool discard(const QString& path);
+
+    // Blocks until everything queued so far is on disk
+    void flush();
+
+    bool isPending(const QString& path) const;
+    QStringList pendingPaths() const;
+
+    static QByteArray encode(const QJsonObject& snapshot, SettingsFormat format);
+    // Accepts either format; JSON is recognized by its opening brace
+    static bool decode(const QByteArray& data, QJsonObject& object, QString& error);
+
+private:
+    struct Job {
+        QString path;
+        QJsonObject snapshot;
+        SettingsFormat format = SettingsFormat::Json;
+        QString obsoletePath;
+    };
+
+    void ioLoop();
+    static void writeJob(const Job& job);
+
+    mutable std::mutex mutex_;
+    std::condition_variable queueChanged_;
+    std::deque<Job> queue_;  // At most one job per path
+    QString writing_;        // Path the I/O thread is writing, empty while idle
+    bool closing_ = false;
+    std::thread ioThread_;
+};
+
+} // namespace RSConfig
@@ -13,11 +13,15 @@ struct TargetConfig {
     float scale = 20.0f;
     QVector3D color{0.0f, 1.0f, 0.0f};
     bool visible = true;
+    int formationCount = 1;        // Targets in the V formation, lead included
+    float formationSpacing = 60.0f; // World units between ranks
 
     void loadFromJson(const QJsonObject& obj) {
         targetType = obj.value("type").toInt(targetType);
         scale = static_cast<float>(obj.value("scale").toDouble(scale));
         visible = obj.value("visible").toBool(visible);
+        formationCount = obj.value("formationCount").toInt(formationCount);
+        formationSpacing = static_cast<float>(obj.value("formationSpacing").toDouble(formationSpacing));
 
         if (obj.contains("position")) {
             QJsonArray arr = obj.value("position").toArray();
@@ -58,6 +62,8 @@ struct TargetConfig {
         obj["type"] = targetType;
         obj["scale"] = static_cast<double>(scale);
         obj["visible"] = visible;
+        obj["formationCount"] = formationCount;
+        obj["formationSpacing"] = static_cast<double>(formationSpacing);
         obj["position"] = QJsonArray{
             static_cast<double>(position.x()),
             static_cast<double>(position.y()),
@@ -101,6 +101,16 @@ void RCSPlaneControlsWidget::setupUI() {
     showFillCheckBox_->setChecked(true);
     controlsLayout->addWidget(showFillCheckBox_);
 
+    // Coherent summation checkbox (complex field with path-length phase)
+    coherentCheckBox_ = new QCheckBox("Coherent Summation", controlsGroup);
+    coherentCheckBox_->setChecked(false);
+    controlsLayout->addWidget(coherentCheckBox_);
+
+    // Overlay checkbox (the other cut type through the center, same trace)
+    overlayCutCheckBox_ = new QCheckBox("Overlay Other Cut", controlsGroup);
+    overlayCutCheckBox_->setChecked(false);
+    controlsLayout->addWidget(overlayCutCheckBox_);
+
     // Install event filters for double-click reset
     planeOffsetSlider_->installEventFilter(this);
     sliceThicknessSlider_->installEventFilter(this);
@@ -117,6 +127,10 @@ void RCSPlaneControlsWidget::connectSignals() {
             this, &RCSPlaneControlsWidget::onSliceThicknessSliderChanged);
     connect(showFillCheckBox_, &QCheckBox::toggled,
             this, &RCSPlaneControlsWidget::onShowFillChanged);
+    connect(coherentCheckBox_, &QCheckBox::toggled,
+            this, &RCSPlaneControlsWidget::onCoherentChanged);
+    connect(overlayCutCheckBox_, &QCheckBox::toggled,
+            this, &RCSPlaneControlsWidget::onOverlayCutChanged);
 }
 
 // Getters
@@ -137,6 +151,14 @@ bool RCSPlaneControlsWidget::isShowFillEnabled() const {
     return showFillCheckBox_->isChecked();
 }
 
+bool RCSPlaneControlsWidget::isCoherentEnabled() const {
+    return coherentCheckBox_->isChecked();
+}
+
+bool RCSPlaneControlsWidget::isOverlayCutEnabled() const {
+    return overlayCutCheckBox_->isChecked();
+}
+
 // Public slots
 void RCSPlaneControlsWidget::setCutType(CutType type) {
     cutTypeComboBox_->blockSignals(true);
@@ -171,12 +193,26 @@ void RCSPlaneControlsWidget::setShowFill(bool show) {
     showFillCheckBox_->blockSignals(false);
 }
 
+void RCSPlaneControlsWidget::setCoherent(bool coherent) {
+    coherentCheckBox_->blockSignals(true);
+    coherentCheckBox_->setChecked(coherent);
+    coherentCheckBox_->blockSignals(false);
+}
+
+void RCSPlaneControlsWidget::setOverlayCut(bool overlay) {
+    overlayCutCheckBox_->blockSignals(true);
+    overlayCutCheckBox_->setChecked(overlay);
+    overlayCutCheckBox_->blockSignals(false);
+}
+
 // Settings persistence
 void RCSPlaneControlsWidget::readSettings(RSConfig::SceneConfig& config) const {
     config.rcsCutType = static_cast<int>(getCutType());
     config.rcsPlaneOffset = static_cast<float>(getPlaneOffset());
     config.rcsSliceThickness = getSliceThickness();
     config.rcsPlaneShowFill = isShowFillEnabled();
+    config.rcsCoherent = isCoherentEnabled();
+    config.rcsOverlayCut = isOverlayCutEnabled();
 }
 
 void RCSPlaneControlsWidget::applySettings(const RSConfig::SceneConfig& config) {
@@ -184,6 +220,8 @@ void RCSPlaneControlsWidget::applySettings(const RSConfig::SceneConfig& config)
     setPlaneOffset(static_cast<int>(config.rcsPlaneOffset));
     setSliceThickness(config.rcsSliceThickness);
     setShowFill(config.rcsPlaneShowFill);
+    setCoherent(config.rcsCoherent);
+    setOverlayCut(config.rcsOverlayCut);
 }
 
 // Private slots
@@ -217,6 +255,14 @@ void RCSPlaneControlsWidget::onShowFillChanged(bool checked) {
     emit showFillChanged(checked);
 }
 
+void RCSPlaneControlsWidget::onCoherentChanged(bool checked) {
+    emit coherentChanged(checked);
+}
+
+void RCSPlaneControlsWidget::onOverlayCutChanged(bool checked) {
+    emit overlayCutChanged(checked);
+}
+
 // Event filter for double-click reset
 bool RCSPlaneControlsWidget::eventFilter(QObject* obj, QEvent* event) {
     using namespace RS::Constants::Defaults;
@@ -31,18 +31,24 @@ public:
     int getPlaneOffset() const;
     float getSliceThickness() const;
     bool isShowFillEnabled() const;
+    bool isCoherentEnabled() const;
+    bool isOverlayCutEnabled() const;
 
 signals:
     void cutTypeChanged(CutType type);
     void planeOffsetChanged(float degrees);
     void sliceThicknessChanged(float degrees);
     void showFillChanged(bool show);
+    void coherentChanged(bool coherent);
+    void overlayCutChanged(bool overlay);
 
 public slots:
     void setCutType(CutType type);
     void setPlaneOffset(int degrees);
     void setSliceThickness(float degrees);
     void setShowFill(bool show);
+    void setCoherent(bool coherent);
+    void setOverlayCut(bool overlay);
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
@@ -53,6 +59,8 @@ private slots:
     void onPlaneOffsetSpinBoxChanged(int value);
     void onSliceThicknessSliderChanged(int index);
     void onShowFillChanged(bool checked);
+    void onCoherentChanged(bool checked);
+    void onOverlayCutChanged(bool checked);
 
 private:
     void setupUI();
@@ -65,4 +73,6 @@ private:
     QSlider* sliceThicknessSlider_ = nullptr;
     QDoubleSpinBox* sliceThicknessSpinBox_ = nullptr;
     QCheckBox* showFillCheckBox_ = nullptr;
+    QCheckBox* coherentCheckBox_ = nullptr;
+    QCheckBox* overlayCutCheckBox_ = nullptr;
 };
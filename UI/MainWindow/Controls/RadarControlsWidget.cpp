@@ -90,6 +90,37 @@ void RadarControlsWidget::setupUI() {
     phiLayout->addWidget(phiSpinBox_);
     controlsLayout->addLayout(phiLayout);
 
+    // Bistatic receiver: a second site on the sphere collecting the radar's returns
+    receiverCheckBox_ = new QCheckBox("Bistatic Receiver (\316\270, \317\206)", controlsGroup);
+    receiverCheckBox_->setToolTip("Also collect the returns leaving the target towards a receiver site");
+    controlsLayout->addWidget(receiverCheckBox_);
+
+    QHBoxLayout* receiverLayout = new QHBoxLayout();
+    receiverLayout->setContentsMargins(0, 0, 0, 0);
+    receiverThetaSpinBox_ = new QDoubleSpinBox(controlsGroup);
+    receiverThetaSpinBox_->setRange(0.0, 359.0);
+    receiverThetaSpinBox_->setSingleStep(0.5);
+    receiverThetaSpinBox_->setDecimals(1);
+    receiverThetaSpinBox_->setValue(225.0);
+    receiverThetaSpinBox_->setMinimumWidth(60);
+    receiverThetaSpinBox_->setEnabled(false);
+
+    receiverPhiSpinBox_ = new QDoubleSpinBox(controlsGroup);
+    receiverPhiSpinBox_->setRange(-90.0, 90.0);
+    receiverPhiSpinBox_->setSingleStep(0.5);
+    receiverPhiSpinBox_->setDecimals(1);
+    receiverPhiSpinBox_->setValue(45.0);
+    receiverPhiSpinBox_->setMinimumWidth(60);
+    receiverPhiSpinBox_->setEnabled(false);
+
+    bistaticLabel_ = new QLabel("--", controlsGroup);
+    bistaticLabel_->setMinimumWidth(80);
+
+    receiverLayout->addWidget(receiverThetaSpinBox_);
+    receiverLayout->addWidget(receiverPhiSpinBox_);
+    receiverLayout->addWidget(bistaticLabel_);
+    controlsLayout->addLayout(receiverLayout);
+
     // Install event filters for double-click reset
     radiusSlider_->installEventFilter(this);
     thetaSlider_->installEventFilter(this);
@@ -108,6 +139,19 @@ void RadarControlsWidget::connectSignals() {
     // Connect phi (elevation) slider and spin box
     connect(phiSlider_, &QSlider::valueChanged, this, &RadarControlsWidget::onPhiSliderChanged);
     connect(phiSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &RadarControlsWidget::onPhiSpinBoxChanged);
+
+    // Connect bistatic receiver controls
+    auto emitReceiver = [this]() {
+        receiverThetaSpinBox_->setEnabled(isReceiverEnabled());
+        receiverPhiSpinBox_->setEnabled(isReceiverEnabled());
+        if (!isReceiverEnabled()) {
+            bistaticLabel_->setText("--");
+        }
+        emit receiverChanged(isReceiverEnabled(), getReceiverTheta(), getReceiverPhi());
+    };
+    connect(receiverCheckBox_, &QCheckBox::toggled, this, emitReceiver);
+    connect(receiverThetaSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, emitReceiver);
+    connect(receiverPhiSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, emitReceiver);
 }
 
 // Getters
@@ -123,6 +167,18 @@ float RadarControlsWidget::getPhi() const {
     return static_cast<float>(phiSpinBox_->value());
 }
 
+bool RadarControlsWidget::isReceiverEnabled() const {
+    return receiverCheckBox_->isChecked();
+}
+
+float RadarControlsWidget::getReceiverTheta() const {
+    return static_cast<float>(receiverThetaSpinBox_->value());
+}
+
+float RadarControlsWidget::getReceiverPhi() const {
+    return static_cast<float>(receiverPhiSpinBox_->value());
+}
+
 // Public slots
 void RadarControlsWidget::setRadius(int radius) {
     radiusSlider_->blockSignals(true);
@@ -151,16 +207,45 @@ void RadarControlsWidget::setAngles(float theta, float phi) {
     phiSpinBox_->blockSignals(false);
 }
 
+void RadarControlsWidget::setReceiver(bool enabled, float theta, float phi) {
+    receiverCheckBox_->blockSignals(true);
+    receiverThetaSpinBox_->blockSignals(true);
+    receiverPhiSpinBox_->blockSignals(true);
+    receiverCheckBox_->setChecked(enabled);
+    receiverThetaSpinBox_->setValue(static_cast<double>(theta));
+    receiverPhiSpinBox_->setValue(static_cast<double>(phi));
+    receiverThetaSpinBox_->setEnabled(enabled);
+    receiverPhiSpinBox_->setEnabled(enabled);
+    receiverCheckBox_->blockSignals(false);
+    receiverThetaSpinBox_->blockSignals(false);
+    receiverPhiSpinBox_->blockSignals(false);
+    if (!enabled) {
+        bistaticLabel_->setText("--");
+    }
+}
+
+void RadarControlsWidget::setBistaticRCS(const std::vector<float>& dBsm) {
+    if (!isReceiverEnabled() || dBsm.empty()) {
+        bistaticLabel_->setText("--");
+        return;
+    }
+    bistaticLabel_->setText(QString("%1 dBsm").arg(dBsm.front(), 0, 'f', 1));
+}
+
 // Settings persistence
 void RadarControlsWidget::readSettings(RSConfig::SceneConfig& config) const {
     config.sphereRadius = static_cast<float>(radiusSpinBox_->value());
     config.radarTheta = static_cast<float>(thetaSpinBox_->value());
     config.radarPhi = static_cast<float>(phiSpinBox_->value());
+    config.bistaticReceiver = isReceiverEnabled();
+    config.receiverTheta = getReceiverTheta();
+    config.receiverPhi = getReceiverPhi();
 }
 
 void RadarControlsWidget::applySettings(const RSConfig::SceneConfig& config) {
     setRadius(static_cast<int>(config.sphereRadius));
     setAngles(config.radarTheta, config.radarPhi);
+    setReceiver(config.bistaticReceiver, config.receiverTheta, config.receiverPhi);
 }
 
 // Private slots
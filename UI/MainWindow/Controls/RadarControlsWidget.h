@@ -5,6 +5,9 @@
 #include <QSlider>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
+#include <QLabel>
+#include <vector>
 
 namespace RSConfig {
     struct SceneConfig;
@@ -26,13 +29,22 @@ public:
     float getTheta() const;
     float getPhi() const;
 
+    // Bistatic receiver site, separate from the radar (the transmitter)
+    bool isReceiverEnabled() const;
+    float getReceiverTheta() const;
+    float getReceiverPhi() const;
+
 signals:
     void radiusChanged(int radius);
     void anglesChanged(float theta, float phi);
+    void receiverChanged(bool enabled, float theta, float phi);
 
 public slots:
     void setRadius(int radius);
     void setAngles(float theta, float phi);
+    void setReceiver(bool enabled, float theta, float phi);
+    // Shows the receiver's return (RadarGLWidget::bistaticRCSReady, one per site)
+    void setBistaticRCS(const std::vector<float>& dBsm);
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
@@ -56,4 +68,8 @@ private:
     QDoubleSpinBox* thetaSpinBox_ = nullptr;
     QSlider* phiSlider_ = nullptr;
     QDoubleSpinBox* phiSpinBox_ = nullptr;
+    QCheckBox* receiverCheckBox_ = nullptr;
+    QDoubleSpinBox* receiverThetaSpinBox_ = nullptr;
+    QDoubleSpinBox* receiverPhiSpinBox_ = nullptr;
+    QLabel* bistaticLabel_ = nullptr;
 };
@@ -175,6 +175,28 @@ void TargetControlsWidget::setupUI() {
     scaleLayout->addWidget(scaleSpinBox_);
     controlsLayout->addLayout(scaleLayout);
 
+    // Formation: copies of the target in a V behind the lead, sharing its mesh
+    QLabel* formationLabel = new QLabel("Formation (targets, spacing)", controlsGroup);
+    controlsLayout->addWidget(formationLabel);
+
+    QHBoxLayout* formationLayout = new QHBoxLayout();
+    formationLayout->setContentsMargins(0, 0, 0, 0);
+    formationCountSpinBox_ = new QSpinBox(controlsGroup);
+    formationCountSpinBox_->setRange(1, 16);
+    formationCountSpinBox_->setValue(1);
+    formationCountSpinBox_->setMinimumWidth(60);
+
+    formationSpacingSpinBox_ = new QDoubleSpinBox(controlsGroup);
+    formationSpacingSpinBox_->setRange(1.0, 500.0);
+    formationSpacingSpinBox_->setSingleStep(5.0);
+    formationSpacingSpinBox_->setDecimals(1);
+    formationSpacingSpinBox_->setValue(RS::Constants::kSweepFormationSpacing);
+    formationSpacingSpinBox_->setMinimumWidth(60);
+
+    formationLayout->addWidget(formationCountSpinBox_);
+    formationLayout->addWidget(formationSpacingSpinBox_);
+    controlsLayout->addLayout(formationLayout);
+
     // Install event filters for double-click reset
     posXSlider_->installEventFilter(this);
     posYSlider_->installEventFilter(this);
@@ -205,6 +227,11 @@ void TargetControlsWidget::connectSignals() {
     // Scale control
     connect(scaleSlider_, &QSlider::valueChanged, this, &TargetControlsWidget::onScaleSliderChanged);
     connect(scaleSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &TargetControlsWidget::onScaleSpinBoxChanged);
+
+    // Formation controls
+    auto emitFormation = [this]() { emit formationChanged(getFormationCount(), getFormationSpacing()); };
+    connect(formationCountSpinBox_, QOverload<int>::of(&QSpinBox::valueChanged), this, emitFormation);
+    connect(formationSpacingSpinBox_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, emitFormation);
 }
 
 // Getters
@@ -228,6 +255,14 @@ float TargetControlsWidget::getScale() const {
     return static_cast<float>(scaleSpinBox_->value());
 }
 
+int TargetControlsWidget::getFormationCount() const {
+    return formationCountSpinBox_->value();
+}
+
+float TargetControlsWidget::getFormationSpacing() const {
+    return static_cast<float>(formationSpacingSpinBox_->value());
+}
+
 // Public slots
 void TargetControlsWidget::setPosition(float x, float y, float z) {
     posXSlider_->blockSignals(true);
@@ -284,17 +319,29 @@ void TargetControlsWidget::setScale(float scale) {
     scaleSpinBox_->blockSignals(false);
 }
 
+void TargetControlsWidget::setFormation(int count, float spacing) {
+    formationCountSpinBox_->blockSignals(true);
+    formationSpacingSpinBox_->blockSignals(true);
+    formationCountSpinBox_->setValue(count);
+    formationSpacingSpinBox_->setValue(static_cast<double>(spacing));
+    formationCountSpinBox_->blockSignals(false);
+    formationSpacingSpinBox_->blockSignals(false);
+}
+
 // Settings persistence
 void TargetControlsWidget::readSettings(RSConfig::TargetConfig& config) const {
     config.position = getPosition();
     config.rotation = getRotation();
     config.scale = getScale();
+    config.formationCount = getFormationCount();
+    config.formationSpacing = getFormationSpacing();
 }
 
 void TargetControlsWidget::applySettings(const RSConfig::TargetConfig& config) {
     setPosition(config.position.x(), config.position.y(), config.position.z());
     setRotation(config.rotation.x(), config.rotation.y(), config.rotation.z());
     setScale(config.scale);
+    setFormation(config.formationCount, config.formationSpacing);
 }
 
 // Private slots - Position
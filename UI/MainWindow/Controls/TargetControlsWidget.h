@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QSlider>
 #include <QDoubleSpinBox>
+#include <QSpinBox>
 #include <QVector3D>
 
 namespace RSConfig {
@@ -25,16 +26,20 @@ public:
     QVector3D getPosition() const;
     QVector3D getRotation() const;
     float getScale() const;
+    int getFormationCount() const;
+    float getFormationSpacing() const;
 
 signals:
     void positionChanged(float x, float y, float z);
     void rotationChanged(float pitch, float yaw, float roll);
     void scaleChanged(float scale);
+    void formationChanged(int count, float spacing);
 
 public slots:
     void setPosition(float x, float y, float z);
     void setRotation(float pitch, float yaw, float roll);
     void setScale(float scale);
+    void setFormation(int count, float spacing);
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
@@ -81,4 +86,8 @@ private:
     // Scale control
     QSlider* scaleSlider_ = nullptr;
     QDoubleSpinBox* scaleSpinBox_ = nullptr;
+
+    // Formation controls (WireframeTargetController::setFormation)
+    QSpinBox* formationCountSpinBox_ = nullptr;
+    QDoubleSpinBox* formationSpacingSpinBox_ = nullptr;
 };
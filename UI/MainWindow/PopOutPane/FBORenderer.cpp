@@ -1,12 +1,24 @@
 // ---- FBORenderer.cpp ----
 
 #include "FBORenderer.h"
+#include "Constants.h"
 #include <QOpenGLContext>
 #include <QDebug>
+#include <algorithm>
+
+using namespace RS::Constants;
 
 FBORenderer::FBORenderer(QObject* parent)
     : QObject(parent)
 {
+    // Reallocating attachments on every step of a window drag stalls the
+    // pipeline; wait until the size settles and keep the old frames meanwhile
+    resizeTimer_.setSingleShot(true);
+    resizeTimer_.setInterval(View::kPopOutResizeDebounceMs);
+    connect(&resizeTimer_, &QTimer::timeout, this, [this]() {
+        resizeDue_ = true;
+        emit resizeReady();
+    });
 }
 
 FBORenderer::~FBORenderer()
@@ -34,26 +46,12 @@ bool FBORenderer::initialize(int width, int height)
         glFunctionsInitialized_ = true;
     }
 
-    width_ = width;
-    height_ = height;
-
-    // Create framebuffer object
-    glGenFramebuffers(1, &fbo_);
-    if (fbo_ == 0) {
-        qWarning() << "FBORenderer::initialize() - Failed to create FBO";
-        return false;
-    }
-
-    // Create attachments (texture and depth buffer)
-    createAttachments();
-
-    // Check framebuffer completeness
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
-    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    width_ = pendingWidth_ = width;
+    height_ = pendingHeight_ = height;
 
-    if (status != GL_FRAMEBUFFER_COMPLETE) {
-        qWarning() << "FBORenderer::initialize() - Framebuffer is not complete, status:" << status;
+    // Create the swap-chain textures
+    if (!createAttachments()) {
+        qWarning() << "FBORenderer::initialize() - Failed to create the swap-chain framebuffers";
         cleanup();
         return false;
     }
@@ -65,112 +63,187 @@ bool FBORenderer::initialize(int width, int height)
 
 void FBORenderer::resize(int width, int height)
 {
-    if (width == width_ && height == height_) {
+    if (width <= 0 || height <= 0) {
         return;
     }
 
-    if (!initialized_ || !QOpenGLContext::currentContext()) {
+    pendingWidth_ = width;
+    pendingHeight_ = height;
+
+    if (!initialized_) {
         width_ = width;
         height_ = height;
         return;
     }
 
-    width_ = width;
-    height_ = height;
+    if (width == width_ && height == height_) {
+        // Back to the allocated size - nothing to reallocate
+        resizeTimer_.stop();
+        resizeDue_ = false;
+        return;
+    }
 
-    // Recreate attachments with new size
-    deleteAttachments();
-    createAttachments();
+    resizeTimer_.start();
+}
 
-    // Verify framebuffer is still complete
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
-    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+void FBORenderer::prepareFrame()
+{
+    if (!initialized_) {
+        return;
+    }
 
-    if (status != GL_FRAMEBUFFER_COMPLETE) {
-        qWarning() << "FBORenderer::resize() - Framebuffer is not complete after resize";
+    // Apply a debounced resize now that the context is current
+    if (resizeDue_) {
+        resizeDue_ = false;
+        if (pendingWidth_ != width_ || pendingHeight_ != height_) {
+            width_ = pendingWidth_;
+            height_ = pendingHeight_;
+
+            deleteAttachments();
+            if (!createAttachments()) {
+                qWarning() << "FBORenderer::prepareFrame() - Framebuffer is not complete after resize";
+            }
+        }
     }
 }
 
-void FBORenderer::bind()
+GLuint FBORenderer::beginPresent()
 {
-    if (!initialized_ || fbo_ == 0) {
-        return;
+    if (!isValid()) {
+        return 0;
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
-    glViewport(0, 0, width_, height_);
+    int back = (front_ + 1) % kSlots;
+
+    // The consumer may still be sampling this texture from its last frame
+    GLsync& readFence = readFences_[back];
+    if (readFence) {
+        glWaitSync(readFence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(readFence);
+        readFence = nullptr;
+    }
+    return resolveFbos_[back];
 }
 
-void FBORenderer::release()
+void FBORenderer::endPresent()
 {
-    if (!initialized_) {
+    if (!isValid()) {
         return;
     }
 
+    int back = (front_ + 1) % kSlots;
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    GLsync& readyFence = readyFences_[back];
+    if (readyFence) {
+        glDeleteSync(readyFence);
+    }
+    readyFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();  // Make the fence visible to the consumer's context
+
+    front_ = back;
     emit textureUpdated();
 }
 
+FBORenderer::Frame FBORenderer::frontFrame() const
+{
+    Frame frame;
+    if (initialized_ && front_ >= 0) {
+        frame.slot = front_;
+        frame.texture = resolveTextures_[front_];
+        frame.ready = readyFences_[front_];
+    }
+    return frame;
+}
+
+GLsync FBORenderer::exchangeReadFence(int slot, GLsync fence)
+{
+    if (slot < 0 || slot >= kSlots) {
+        return fence;
+    }
+    std::swap(readFences_[slot], fence);
+    return fence;
+}
+
 void FBORenderer::cleanup()
 {
+    resizeTimer_.stop();
+
     if (!glFunctionsInitialized_ || !QOpenGLContext::currentContext()) {
         // Can't clean up GL resources without context
-        fbo_ = 0;
-        colorTexture_ = 0;
-        depthRbo_ = 0;
+        std::fill(std::begin(resolveFbos_), std::end(resolveFbos_), 0u);
+        std::fill(std::begin(resolveTextures_), std::end(resolveTextures_), 0u);
+        std::fill(std::begin(readyFences_), std::end(readyFences_), nullptr);
+        std::fill(std::begin(readFences_), std::end(readFences_), nullptr);
+        front_ = -1;
         initialized_ = false;
         return;
     }
 
     deleteAttachments();
-
-    if (fbo_ != 0) {
-        glDeleteFramebuffers(1, &fbo_);
-        fbo_ = 0;
-    }
-
     initialized_ = false;
 }
 
-void FBORenderer::createAttachments()
+bool FBORenderer::createAttachments()
 {
     if (width_ <= 0 || height_ <= 0) {
-        return;
+        return false;
     }
 
-    // Create color texture
-    glGenTextures(1, &colorTexture_);
-    glBindTexture(GL_TEXTURE_2D, colorTexture_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // Single-sampled present targets, one per swap-chain slot
+    bool complete = true;
+    glGenTextures(kSlots, resolveTextures_);
+    glGenFramebuffers(kSlots, resolveFbos_);
+    for (int i = 0; i < kSlots; ++i) {
+        glBindTexture(GL_TEXTURE_2D, resolveTextures_[i]);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width_, height_);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, resolveFbos_[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, resolveTextures_[i], 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            qWarning() << "FBORenderer::createAttachments() - Resolve framebuffer" << i << "is not complete";
+            complete = false;
+        }
+    }
     glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Create depth renderbuffer
-    glGenRenderbuffers(1, &depthRbo_);
-    glBindRenderbuffer(GL_RENDERBUFFER, depthRbo_);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width_, height_);
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
-
-    // Attach to FBO
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture_, 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRbo_);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    front_ = -1;
+    gpuMemory_.resize(static_cast<uint64_t>(kSlots) * width_ * height_ * 4);
+    return complete;
+}
+
+void FBORenderer::deleteFences()
+{
+    for (int i = 0; i < kSlots; ++i) {
+        if (readyFences_[i]) {
+            glDeleteSync(readyFences_[i]);
+            readyFences_[i] = nullptr;
+        }
+        if (readFences_[i]) {
+            glDeleteSync(readFences_[i]);
+            readFences_[i] = nullptr;
+        }
+    }
 }
 
 void FBORenderer::deleteAttachments()
 {
-    if (colorTexture_ != 0) {
-        glDeleteTextures(1, &colorTexture_);
-        colorTexture_ = 0;
+    // Deletion of textures the consumer is still sampling is deferred by GL
+    deleteFences();
+    front_ = -1;
+
+    if (resolveFbos_[0] != 0) {
+        glDeleteFramebuffers(kSlots, resolveFbos_);
+        std::fill(std::begin(resolveFbos_), std::end(resolveFbos_), 0u);
     }
 
-    if (depthRbo_ != 0) {
-        glDeleteRenderbuffers(1, &depthRbo_);
-        depthRbo_ = 0;
+    if (resolveTextures_[0] != 0) {
+        glDeleteTextures(kSlots, resolveTextures_);
+        std::fill(std::begin(resolveTextures_), std::end(resolveTextures_), 0u);
     }
+    gpuMemory_.release();
 }
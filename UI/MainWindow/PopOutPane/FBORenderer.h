@@ -1,56 +1,106 @@
 // ---- FBORenderer.h ----
 // Framebuffer Object wrapper for offscreen rendering
 // Used to render the scene to a texture that can be displayed in a pop-out window
+//
+// The scene renders into RadarGLWidget's SceneTarget at this size, which is
+// resolved and scaled once per frame, with glBlitFramebuffer, into one of two
+// textures. The two textures work like a swap chain. The blit widget samples
+// the last completed one behind its ready fence, and hands back a read fence.
+// The producer waits on that fence on the GPU before it presents into that
+// texture again. Both waits are on the GPU (glWaitSync), so neither context
+// stalls the CPU.
 
 #pragma once
 
 #include <QObject>
 #include <QOpenGLFunctions_4_5_Core>
+#include <QTimer>
+
+#include "GPUMemory.h"
 
 class FBORenderer : public QObject, protected QOpenGLFunctions_4_5_Core {
     Q_OBJECT
 public:
+    // A completed frame as seen by the consumer
+    struct Frame {
+        int slot = -1;
+        GLuint texture = 0;
+        GLsync ready = nullptr;  // Signaled when the resolve into texture is done
+    };
+
     explicit FBORenderer(QObject* parent = nullptr);
     ~FBORenderer();
 
     // Initialize FBO with given dimensions (must be called with valid GL context)
     bool initialize(int width, int height);
 
-    // Resize FBO attachments (recreates texture and renderbuffer)
+    // Request new attachment dimensions. Reallocation is debounced: it happens
+    // in the first prepareFrame() after requests stop for kPopOutResizeDebounceMs.
+    // Until then frames keep their current size.
     void resize(int width, int height);
 
-    // Bind FBO for rendering (call before rendering scene)
-    void bind();
+    // Size the next reallocation will use (the current size if none is pending)
+    int pendingWidth() const { return pendingWidth_; }
+    int pendingHeight() const { return pendingHeight_; }
+
+    // Apply a due resize (call before rendering the scene, which uses width() x height())
+    void prepareFrame();
 
-    // Release FBO and emit textureUpdated signal (call after rendering scene)
-    void release();
+    // Framebuffer of the back texture to present the frame into, once the
+    // consumer is done sampling it (a GPU wait); 0 if not valid
+    GLuint beginPresent();
+
+    // Publish the back texture and emit textureUpdated (call after presenting)
+    void endPresent();
 
     // Cleanup GL resources (call with valid GL context)
     void cleanup();
 
-    // Get the color texture ID for display in another widget
-    GLuint getTexture() const { return colorTexture_; }
+    // Last completed frame; slot is -1 until the first endPresent()
+    Frame frontFrame() const;
+
+    // Consumer: store the fence placed after sampling a frame's texture.
+    // Returns the fence it replaces, which the caller deletes.
+    GLsync exchangeReadFence(int slot, GLsync fence);
+
+    // Get the most recently completed color texture
+    GLuint getTexture() const { return front_ >= 0 ? resolveTextures_[front_] : 0; }
 
     // Get FBO dimensions
     int width() const { return width_; }
     int height() const { return height_; }
 
     // Check if FBO is initialized and valid
-    bool isValid() const { return initialized_ && fbo_ != 0; }
+    bool isValid() const { return initialized_ && resolveFbos_[0] != 0; }
 
 signals:
-    // Emitted after release() to notify that the texture has been updated
+    // Emitted after endPresent() to notify that the texture has been updated
     void textureUpdated();
 
+    // Emitted when a debounced resize is ready to be applied by the next prepareFrame()
+    void resizeReady();
+
 private:
-    void createAttachments();
+    bool createAttachments();
     void deleteAttachments();
+    void deleteFences();
+
+    static constexpr int kSlots = 2;
+
+    GLuint resolveFbos_[kSlots] = {};
+    GLuint resolveTextures_[kSlots] = {};
+    GLsync readyFences_[kSlots] = {};       // Producer: present finished
+    GLsync readFences_[kSlots] = {};        // Consumer: sampling finished
+    int front_ = -1;                        // Last completed slot
+    RS::GPUAllocation gpuMemory_{RS::GPUMemoryPool::RenderTargets};
 
-    GLuint fbo_ = 0;
-    GLuint colorTexture_ = 0;
-    GLuint depthRbo_ = 0;
     int width_ = 0;
     int height_ = 0;
+    int pendingWidth_ = 0;
+    int pendingHeight_ = 0;
+    bool resizeDue_ = false;
+    QTimer resizeTimer_;
+
     bool initialized_ = false;
     bool glFunctionsInitialized_ = false;
 };
@@ -82,6 +82,8 @@ void PopOutWindow::setSourcePolarPlot(PolarRCSPlot* source, RadarSceneWidget* da
     if (dataSource_) {
         connect(dataSource_, &RadarSceneWidget::polarPlotDataReady,
                 polarPlot_, &PolarRCSPlot::setData);
+        connect(dataSource_, &RadarSceneWidget::overlayCutsReady,
+                polarPlot_, &PolarRCSPlot::setOverlayData);
     }
 }
 
@@ -105,11 +105,11 @@ void TextureBlitWidget::initializeGL()
 
     // Create shader program
     blitShader_ = std::make_unique<QOpenGLShaderProgram>();
-    if (!blitShader_->addShaderFromSourceCode(QOpenGLShader::Vertex, kBlitVertexShader)) {
+    if (!blitShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, kBlitVertexShader)) {
         qWarning() << "TextureBlitWidget: Vertex shader error:" << blitShader_->log();
         return;
     }
-    if (!blitShader_->addShaderFromSourceCode(QOpenGLShader::Fragment, kBlitFragmentShader)) {
+    if (!blitShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, kBlitFragmentShader)) {
         qWarning() << "TextureBlitWidget: Fragment shader error:" << blitShader_->log();
         return;
     }
@@ -162,6 +162,19 @@ void TextureBlitWidget::paintGL()
         return;
     }
 
+    // Last completed frame; nothing published yet means nothing to show
+    FBORenderer::Frame frame = fbo->frontFrame();
+    if (frame.slot < 0) {
+        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        return;
+    }
+
+    // Order the sampling after the source's resolve on the GPU, not the CPU
+    if (frame.ready) {
+        glWaitSync(frame.ready, 0, GL_TIMEOUT_IGNORED);
+    }
+
     // Clear and disable depth test for 2D blit
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -170,7 +183,7 @@ void TextureBlitWidget::paintGL()
     // Bind shader and texture
     blitShader_->bind();
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, fbo->getTexture());
+    glBindTexture(GL_TEXTURE_2D, frame.texture);
     blitShader_->setUniformValue("uTexture", 0);
 
     // Draw fullscreen quad
@@ -179,6 +192,13 @@ void TextureBlitWidget::paintGL()
     glBindVertexArray(0);
 
     blitShader_->release();
+
+    // Tell the source when it may resolve into this texture again
+    GLsync readFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();  // Make the fence visible to the source context
+    if (GLsync previous = fbo->exchangeReadFence(frame.slot, readFence)) {
+        glDeleteSync(previous);
+    }
 }
 
 void TextureBlitWidget::resizeGL(int w, int h)
@@ -2,21 +2,66 @@
 #include "BVHBuilder.h"
 #include "Constants.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <future>
+#include <thread>
 #include <QDebug>
 
 using namespace RS::Constants;
 
 namespace RCS {
 
+namespace {
+
+// Unit axis and half-angle in radians; a negative angle is the empty cone
+struct NormalCone {
+    QVector3D axis;
+    float angle = -1.0f;
+};
+
+// Smallest cone holding both: it spans the two cones' far edges in the plane
+// of their axes, unless one already contains the other
+NormalCone mergeCones(const NormalCone& a, const NormalCone& b) {
+    if (a.angle < 0.0f) return b;
+    if (b.angle < 0.0f) return a;
+    float between = std::acos(std::clamp(QVector3D::dotProduct(a.axis, b.axis), -1.0f, 1.0f));
+    if (between + b.angle <= a.angle) return a;
+    if (between + a.angle <= b.angle) return b;
+
+    NormalCone merged;
+    merged.angle = 0.5f * (a.angle + between + b.angle);
+    float sinBetween = std::sin(between);
+    if (merged.angle >= kPiF || sinBetween < 1e-6f) {
+        // Everything, or axes too close to interpolate: widen a around itself
+        merged.axis = a.axis;
+        merged.angle = std::min(std::max(a.angle, b.angle) + between, kPiF);
+        return merged;
+    }
+    float turn = merged.angle - a.angle;  // From a's axis toward b's
+    merged.axis = ((a.axis * std::sin(between - turn) + b.axis * std::sin(turn)) / sinBetween).normalized();
+    return merged;
+}
+
+} // namespace
+
 void BVHBuilder::build(const std::vector<float>& vertices,
                        const std::vector<uint32_t>& indices,
                        const QMatrix4x4& transform) {
     nodes_.clear();
     triangles_.clear();
+    skipLinks_.clear();
+    normalCones_.clear();
+    wideNodes_.clear();
+    wideChildSources_.clear();
+    wideMaxDepth_ = 0;
     triangleBounds_.clear();
     triangleCentroids_.clear();
+    triangleOrder_.clear();
     maxDepth_ = 0;
+    sourceIndices_ = indices;
+    transform_ = transform;
+    buildSAHCost_ = sahCost_ = 0.0f;
 
     if (indices.empty()) {
         return;
@@ -44,10 +89,9 @@ void BVHBuilder::build(const std::vector<float>& vertices,
         v2 = transform.map(v2);
 
         // Store triangle
-        Triangle tri;
-        tri.v0 = QVector4D(v0, 0.0f);
-        tri.v1 = QVector4D(v1, 0.0f);
-        tri.v2 = QVector4D(v2, 0.0f);
+        Triangle tri = {};
+        tri.setVertices(v0, v1, v2);
+        tri.sourceIndex = static_cast<uint32_t>(t);
         triangles_.push_back(tri);
 
         // Compute bounds
@@ -70,8 +114,18 @@ void BVHBuilder::build(const std::vector<float>& vertices,
     // Reserve space for nodes (worst case: 2N-1 for N triangles)
     nodes_.reserve(2 * numTriangles);
 
-    // Build recursively
-    buildRecursive(triIndices, 0, numTriangles, 0);
+    // Build recursively - fork subtrees onto worker threads for large meshes
+    unsigned int threads = std::thread::hardware_concurrency();
+    if (parallelBuild_ && threads > 1 && numTriangles >= kBVHParallelMinTriangles) {
+        // Enough task levels to give every core at least one subtree
+        int taskDepth = 1;
+        while ((1u << taskDepth) < threads * 2u) {
+            taskDepth++;
+        }
+        buildParallel(nodes_, triIndices, 0, numTriangles, 0, taskDepth, maxDepth_);
+    } else {
+        buildRecursive(nodes_, triIndices, 0, numTriangles, 0, maxDepth_);
+    }
 
     // IMPORTANT: Reorder triangles to match the BVH's sorted order
     // The BVH leaf nodes store indices into triIndices (which got partitioned/sorted)
@@ -84,29 +138,311 @@ void BVHBuilder::build(const std::vector<float>& vertices,
     }
     triangles_ = std::move(sortedTriangles);
     triangleBounds_ = std::move(sortedBounds);
+    triangleOrder_ = std::move(triIndices);
+
+    computeSkipLinks();
+    computeNormalCones();
+    buildWide();
+    buildSAHCost_ = sahCost_ = computeSAHCost();
 }
 
-int BVHBuilder::buildRecursive(std::vector<int>& triIndices, int start, int end, int depth) {
-    maxDepth_ = std::max(maxDepth_, depth);
-    int nodeIndex = static_cast<int>(nodes_.size());
-    nodes_.push_back(BVHNode());
+void BVHBuilder::computeSkipLinks() {
+    // Parents precede their children, so one forward sweep can hand each node's
+    // link down: the left child skips to its sibling, the right child inherits
+    // the parent's link
+    skipLinks_.assign(nodes_.size(), -1);
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        const BVHNode& node = nodes_[i];
+        if (node.boundsMin.w() < 0.0f) {
+            continue;
+        }
+        int leftChild = static_cast<int>(i) + 1;
+        int rightChild = static_cast<int>(node.boundsMax.w());
+        skipLinks_[leftChild] = rightChild;
+        skipLinks_[rightChild] = skipLinks_[i];
+    }
+}
 
-    AABB bounds = computeBounds(triIndices, start, end);
-    int count = end - start;
+void BVHBuilder::computeNormalCones() {
+    // Same reverse sweep as refit(): children are merged before their parent
+    std::vector<NormalCone> cones(nodes_.size());
+    for (int i = static_cast<int>(nodes_.size()) - 1; i >= 0; i--) {
+        const BVHNode& node = nodes_[i];
+        int leftInfo = static_cast<int>(node.boundsMin.w());
+        NormalCone cone;
+        if (leftInfo < 0) {
+            int firstTri = -leftInfo - 1;
+            int triCount = static_cast<int>(node.boundsMax.w());
+            for (int k = firstTri; k < firstTri + triCount; k++) {
+                const Triangle& tri = triangles_[k];
+                QVector3D normal = QVector3D::crossProduct(tri.edge1(), tri.edge2());
+                if (normal.lengthSquared() > 0.0f) {  // Degenerate triangles are never hit
+                    cone = mergeCones(cone, NormalCone{normal.normalized(), 0.0f});
+                }
+            }
+        } else {
+            cone = mergeCones(cones[i + 1], cones[static_cast<int>(node.boundsMax.w())]);
+        }
+        cones[i] = cone;
+    }
 
-    // Leaf node threshold
-    const int maxLeafSize = kBVHMaxLeafSize;
+    normalCones_.resize(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        float angle = cones[i].angle + kNormalConeMargin;
+        bool bounded = cones[i].angle >= 0.0f && angle < 0.5f * kPiF;
+        normalCones_[i] = QVector4D(cones[i].axis, bounded ? std::sin(angle) : kNoNormalCone);
+    }
+}
 
-    if (count <= maxLeafSize) {
-        // Create leaf node
-        // Store negative index to indicate leaf, and triangle count
-        nodes_[nodeIndex].boundsMin = QVector4D(bounds.min, static_cast<float>(-(start + 1)));
-        nodes_[nodeIndex].boundsMax = QVector4D(bounds.max, static_cast<float>(count));
-        return nodeIndex;
+void BVHBuilder::buildWide() {
+    wideNodes_.clear();
+    wideChildSources_.clear();
+    wideMaxDepth_ = 0;
+    if (nodes_.empty() || triangles_.size() >= static_cast<size_t>(kWideBVHMaxTriangles)) {
+        return;
+    }
+    for (const BVHNode& node : nodes_) {
+        if (node.boundsMin.w() < 0.0f && node.boundsMax.w() > kWideBVHMaxLeafTriangles) {
+            return;
+        }
+    }
+
+    wideNodes_.reserve(nodes_.size() / 2 + 1);
+    wideChildSources_.reserve(nodes_.size() / 2 + 1);
+    collapseWide(0, 0);
+    quantizeWide();
+}
+
+int BVHBuilder::collapseWide(int binaryIndex, int depth) {
+    wideMaxDepth_ = std::max(wideMaxDepth_, depth);
+    int wideIndex = static_cast<int>(wideNodes_.size());
+    wideNodes_.push_back(WideBVHNode());
+    wideChildSources_.push_back({-1, -1, -1, -1});
+
+    auto isLeaf = [this](int index) { return nodes_[index].boundsMin.w() < 0.0f; };
+    auto area = [this](int index) {
+        AABB bounds;
+        bounds.expand(nodes_[index].boundsMin.toVector3D());
+        bounds.expand(nodes_[index].boundsMax.toVector3D());
+        return bounds.surfaceArea();
+    };
+
+    // Open the largest internal slot until the node is full. A leaf root ends
+    // up as the only child of a one-slot node.
+    std::array<int, 4> picks = {binaryIndex, -1, -1, -1};
+    int count = 1;
+    while (count < kWideBVHWidth) {
+        int open = -1;
+        float openArea = -1.0f;
+        for (int i = 0; i < count; i++) {
+            if (!isLeaf(picks[i]) && area(picks[i]) > openArea) {
+                open = i;
+                openArea = area(picks[i]);
+            }
+        }
+        if (open < 0) break;
+
+        const BVHNode& node = nodes_[picks[open]];
+        int leftChild = picks[open] + 1;
+        picks[count++] = static_cast<int>(node.boundsMax.w());
+        picks[open] = leftChild;
+    }
+    wideChildSources_[wideIndex] = picks;
+
+    // Recursion appends to wideNodes_, so index it afresh for each child
+    for (int i = 0; i < kWideBVHWidth; i++) {
+        uint32_t child = kWideBVHChildEmpty;
+        if (i < count) {
+            const BVHNode& node = nodes_[picks[i]];
+            if (isLeaf(picks[i])) {
+                uint32_t firstTri = static_cast<uint32_t>(-static_cast<int>(node.boundsMin.w()) - 1);
+                uint32_t triCount = static_cast<uint32_t>(node.boundsMax.w());
+                child = kWideBVHLeafFlag | (triCount << kWideBVHLeafCountShift) | firstTri;
+            } else {
+                child = static_cast<uint32_t>(collapseWide(picks[i], depth + 1));
+            }
+        }
+        wideNodes_[wideIndex].children[i] = child;
+    }
+    return wideIndex;
+}
+
+void BVHBuilder::quantizeWide() {
+    for (size_t w = 0; w < wideNodes_.size(); w++) {
+        const std::array<int, 4>& sources = wideChildSources_[w];
+        WideBVHNode& node = wideNodes_[w];
+
+        AABB bounds;
+        for (int source : sources) {
+            if (source >= 0) {
+                bounds.expand(nodes_[source].boundsMin.toVector3D());
+                bounds.expand(nodes_[source].boundsMax.toVector3D());
+            }
+        }
+
+        // Per axis, the smallest power-of-two step that spans the extent in 255 steps
+        float step[3];
+        node.exponents = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = bounds.max[axis] - bounds.min[axis];
+            int exponent = -126;
+            if (extent > 0.0f) {
+                std::frexp(extent / 255.0f, &exponent);
+            }
+            exponent = std::clamp(exponent, -126, 127);
+            step[axis] = std::ldexp(1.0f, exponent);
+            node.origin[axis] = bounds.min[axis];
+            node.exponents |= static_cast<uint32_t>(exponent + 127) << (8 * axis);
+            node.quantLo[axis] = 0;
+            node.quantHi[axis] = 0;
+        }
+
+        for (int i = 0; i < kWideBVHWidth; i++) {
+            if (sources[i] < 0) continue;
+            QVector3D childMin = nodes_[sources[i]].boundsMin.toVector3D();
+            QVector3D childMax = nodes_[sources[i]].boundsMax.toVector3D();
+
+            for (int axis = 0; axis < 3; axis++) {
+                float origin = node.origin[axis];
+                int lo = std::clamp(static_cast<int>(std::floor((childMin[axis] - origin) / step[axis])), 0, 255);
+                int hi = std::clamp(static_cast<int>(std::ceil((childMax[axis] - origin) / step[axis])), 0, 255);
+                // The shader decodes origin + q * step in float - step past any rounding
+                while (lo > 0 && origin + lo * step[axis] > childMin[axis]) lo--;
+                while (hi < 255 && origin + hi * step[axis] < childMax[axis]) hi++;
+                node.quantLo[axis] |= static_cast<uint32_t>(lo) << (8 * i);
+                node.quantHi[axis] |= static_cast<uint32_t>(hi) << (8 * i);
+            }
+        }
+    }
+}
+
+bool BVHBuilder::hasSameTopology(const std::vector<uint32_t>& indices) const {
+    return !nodes_.empty() && indices == sourceIndices_;
+}
+
+void BVHBuilder::setTriangleMaterials(const std::vector<uint32_t>& materialIds) {
+    if (triangleOrder_.size() != triangles_.size()) {
+        return;
+    }
+    // CompactTriangle keeps 16 bits of the ID
+    const uint32_t maxId = static_cast<uint32_t>(RS::Constants::kMaxMaterials - 1);
+    for (size_t slot = 0; slot < triangles_.size(); slot++) {
+        size_t t = static_cast<size_t>(triangleOrder_[slot]);
+        triangles_[slot].materialId = t < materialIds.size() ? std::min(materialIds[t], maxId) : 0u;
+    }
+}
+
+bool BVHBuilder::refit(const std::vector<float>& vertices) {
+    if (nodes_.empty() || triangleOrder_.size() != triangles_.size()) {
+        return false;
+    }
+
+    // Every index must still address a vertex
+    uint32_t maxIndex = *std::max_element(sourceIndices_.begin(), sourceIndices_.end());
+    if (static_cast<size_t>(maxIndex) * 6 + 2 >= vertices.size()) {
+        return false;
+    }
+
+    // Update triangle positions in BVH (sorted) order
+    int numTriangles = static_cast<int>(triangles_.size());
+    for (int slot = 0; slot < numTriangles; slot++) {
+        int t = triangleOrder_[slot];
+        uint32_t i0 = sourceIndices_[t * 3 + 0];
+        uint32_t i1 = sourceIndices_[t * 3 + 1];
+        uint32_t i2 = sourceIndices_[t * 3 + 2];
+
+        QVector3D v0 = transform_.map(QVector3D(vertices[i0 * 6 + 0], vertices[i0 * 6 + 1], vertices[i0 * 6 + 2]));
+        QVector3D v1 = transform_.map(QVector3D(vertices[i1 * 6 + 0], vertices[i1 * 6 + 1], vertices[i1 * 6 + 2]));
+        QVector3D v2 = transform_.map(QVector3D(vertices[i2 * 6 + 0], vertices[i2 * 6 + 1], vertices[i2 * 6 + 2]));
+
+        triangles_[slot].setVertices(v0, v1, v2);
+
+        AABB bounds;
+        bounds.expand(v0);
+        bounds.expand(v1);
+        bounds.expand(v2);
+        triangleBounds_[slot] = bounds;
+    }
+
+    // Children always have larger indices than their parent (depth-first layout),
+    // so a reverse sweep visits every node after both of its children
+    for (int i = static_cast<int>(nodes_.size()) - 1; i >= 0; i--) {
+        BVHNode& node = nodes_[i];
+        int leftInfo = static_cast<int>(node.boundsMin.w());
+        AABB bounds;
+
+        if (leftInfo < 0) {
+            int firstTri = -leftInfo - 1;
+            int triCount = static_cast<int>(node.boundsMax.w());
+            for (int k = firstTri; k < firstTri + triCount; k++) {
+                bounds.expand(triangleBounds_[k]);
+            }
+        } else {
+            int rightChild = static_cast<int>(node.boundsMax.w());
+            const BVHNode& left = nodes_[i + 1];
+            const BVHNode& right = nodes_[rightChild];
+            bounds.expand(left.boundsMin.toVector3D());
+            bounds.expand(left.boundsMax.toVector3D());
+            bounds.expand(right.boundsMin.toVector3D());
+            bounds.expand(right.boundsMax.toVector3D());
+        }
+
+        node.boundsMin = QVector4D(bounds.min, node.boundsMin.w());
+        node.boundsMax = QVector4D(bounds.max, node.boundsMax.w());
     }
+    computeNormalCones();
+    quantizeWide();
+
+    // Refit trees degrade as geometry moves away from the original partition
+    sahCost_ = computeSAHCost();
+    return buildSAHCost_ <= 0.0f || sahCost_ <= buildSAHCost_ * kBVHRefitMaxCostRatio;
+}
+
+float BVHBuilder::computeSAHCost() const {
+    if (nodes_.empty()) return 0.0f;
+
+    // Same cost model as findBestSplit: traversal = 1, intersection = 1 per triangle
+    auto area = [](const BVHNode& node) {
+        QVector3D d = node.boundsMax.toVector3D() - node.boundsMin.toVector3D();
+        return 2.0f * (d.x() * d.y() + d.y() * d.z() + d.z() * d.x());
+    };
 
+    float rootArea = area(nodes_[0]);
+    if (rootArea <= 0.0f) return 0.0f;
+
+    float cost = 0.0f;
+    for (const BVHNode& node : nodes_) {
+        if (node.boundsMin.w() < 0.0f) {
+            cost += area(node) * node.boundsMax.w();
+        } else {
+            cost += area(node);
+        }
+    }
+    return cost / rootArea;
+}
+
+std::shared_ptr<const BVHSnapshot> BVHBuilder::takeSnapshot(uint32_t meshId, uint64_t geometryVersion,
+                                                            bool refit, double buildTimeMs) const {
+    auto snapshot = std::make_shared<BVHSnapshot>();
+    snapshot->nodes = nodes_;
+    snapshot->triangles = triangles_;
+    snapshot->skipLinks = skipLinks_;
+    snapshot->normalCones = normalCones_;
+    snapshot->wideNodes = wideNodes_;
+    snapshot->wideMaxDepth = wideMaxDepth_;
+    snapshot->meshId = meshId;
+    snapshot->geometryVersion = geometryVersion;
+    snapshot->maxDepth = maxDepth_;
+    snapshot->refit = refit;
+    snapshot->buildTimeMs = buildTimeMs;
+    return snapshot;
+}
+
+int BVHBuilder::partitionRange(std::vector<int>& triIndices, int start, int end,
+                               const AABB& bounds, int& axis) const {
     // Find best split using SAH
     SplitResult split = findBestSplit(triIndices, start, end, bounds);
+    axis = split.axis;
 
     // Partition triangles
     auto midIt = std::partition(triIndices.begin() + start, triIndices.begin() + end,
@@ -119,19 +455,99 @@ int BVHBuilder::buildRecursive(std::vector<int>& triIndices, int start, int end,
     if (mid == start || mid == end) {
         mid = (start + end) / 2;
     }
+    return mid;
+}
+
+int BVHBuilder::buildRecursive(std::vector<BVHNode>& nodes, std::vector<int>& triIndices,
+                               int start, int end, int depth, int& maxDepth) const {
+    maxDepth = std::max(maxDepth, depth);
+    int nodeIndex = static_cast<int>(nodes.size());
+    nodes.push_back(BVHNode());
+
+    AABB bounds = computeBounds(triIndices, start, end);
+    int count = end - start;
+
+    // Leaf node threshold
+    const int maxLeafSize = kBVHMaxLeafSize;
+
+    if (count <= maxLeafSize) {
+        // Create leaf node
+        // Store negative index to indicate leaf, and triangle count
+        nodes[nodeIndex].boundsMin = QVector4D(bounds.min, static_cast<float>(-(start + 1)));
+        nodes[nodeIndex].boundsMax = QVector4D(bounds.max, static_cast<float>(count));
+        return nodeIndex;
+    }
 
-    // Build children
-    int leftChild = buildRecursive(triIndices, start, mid, depth + 1);
-    int rightChild = buildRecursive(triIndices, mid, end, depth + 1);
+    int axis = 0;
+    int mid = partitionRange(triIndices, start, end, bounds, axis);
+
+    // Build children - the left subtree starts right after this node
+    buildRecursive(nodes, triIndices, start, mid, depth + 1, maxDepth);
+    int rightChild = buildRecursive(nodes, triIndices, mid, end, depth + 1, maxDepth);
 
     // Store internal node
-    nodes_[nodeIndex].boundsMin = QVector4D(bounds.min, static_cast<float>(leftChild));
-    nodes_[nodeIndex].boundsMax = QVector4D(bounds.max, static_cast<float>(rightChild));
+    nodes[nodeIndex].boundsMin = QVector4D(bounds.min, static_cast<float>(axis));
+    nodes[nodeIndex].boundsMax = QVector4D(bounds.max, static_cast<float>(rightChild));
 
     return nodeIndex;
 }
 
-AABB BVHBuilder::computeBounds(const std::vector<int>& triIndices, int start, int end) {
+// Append a subtree built into its own vector, rebasing right child indices
+// (left children are implicit). Leaf triangle ranges are already global
+// (all tasks share triIndices).
+static int appendSubtree(std::vector<BVHNode>& nodes, const std::vector<BVHNode>& subtree) {
+    int base = static_cast<int>(nodes.size());
+    nodes.reserve(nodes.size() + subtree.size());
+    for (const BVHNode& src : subtree) {
+        BVHNode node = src;
+        if (node.boundsMin.w() >= 0.0f) {
+            node.boundsMax.setW(node.boundsMax.w() + static_cast<float>(base));
+        }
+        nodes.push_back(node);
+    }
+    return base;
+}
+
+int BVHBuilder::buildParallel(std::vector<BVHNode>& nodes, std::vector<int>& triIndices,
+                              int start, int end, int depth, int taskDepth, int& maxDepth) const {
+    int count = end - start;
+    if (taskDepth <= 0 || count < kBVHParallelMinTriangles) {
+        return buildRecursive(nodes, triIndices, start, end, depth, maxDepth);
+    }
+
+    maxDepth = std::max(maxDepth, depth);
+    int nodeIndex = static_cast<int>(nodes.size());
+    nodes.push_back(BVHNode());
+
+    AABB bounds = computeBounds(triIndices, start, end);
+    int axis = 0;
+    int mid = partitionRange(triIndices, start, end, bounds, axis);
+
+    // Right subtree on another thread, left subtree on this one. Each writes
+    // its own node vector; the disjoint triIndices ranges make this race-free.
+    std::vector<BVHNode> rightNodes;
+    int rightDepth = 0;
+    auto rightTask = std::async(std::launch::async, [&, mid, end, depth, taskDepth]() {
+        buildParallel(rightNodes, triIndices, mid, end, depth + 1, taskDepth - 1, rightDepth);
+    });
+
+    std::vector<BVHNode> leftNodes;
+    int leftDepth = 0;
+    buildParallel(leftNodes, triIndices, start, mid, depth + 1, taskDepth - 1, leftDepth);
+    rightTask.get();
+
+    // Splice in serial order: node, left subtree, right subtree
+    appendSubtree(nodes, leftNodes);
+    int rightChild = appendSubtree(nodes, rightNodes);
+    maxDepth = std::max(maxDepth, std::max(leftDepth, rightDepth));
+
+    nodes[nodeIndex].boundsMin = QVector4D(bounds.min, static_cast<float>(axis));
+    nodes[nodeIndex].boundsMax = QVector4D(bounds.max, static_cast<float>(rightChild));
+
+    return nodeIndex;
+}
+
+AABB BVHBuilder::computeBounds(const std::vector<int>& triIndices, int start, int end) const {
     AABB bounds;
     for (int i = start; i < end; i++) {
         bounds.expand(triangleBounds_[triIndices[i]]);
@@ -139,9 +555,31 @@ AABB BVHBuilder::computeBounds(const std::vector<int>& triIndices, int start, in
     return bounds;
 }
 
+void BVHBuilder::binRange(const std::vector<int>& triIndices, int start, int end,
+                          const AABB& bounds, AxisBins& bins) const {
+    const int numBins = kBVHNumBins;
+
+    for (int axis = 0; axis < 3; axis++) {
+        float axisMin = bounds.min[axis];
+        float axisMax = bounds.max[axis];
+        if (axisMax - axisMin < 1e-6f) continue;
+
+        float scale = static_cast<float>(numBins) / (axisMax - axisMin);
+        auto& axisBins = bins[axis];
+
+        for (int i = start; i < end; i++) {
+            int triIdx = triIndices[i];
+            float centroid = triangleCentroids_[triIdx][axis];
+            int binIdx = std::min(static_cast<int>((centroid - axisMin) * scale), numBins - 1);
+            axisBins[binIdx].bounds.expand(triangleBounds_[triIdx]);
+            axisBins[binIdx].count++;
+        }
+    }
+}
+
 BVHBuilder::SplitResult BVHBuilder::findBestSplit(const std::vector<int>& triIndices,
                                                    int start, int end,
-                                                   const AABB& bounds) {
+                                                   const AABB& bounds) const {
     SplitResult best;
     best.cost = std::numeric_limits<float>::max();
     best.axis = 0;
@@ -150,45 +588,62 @@ BVHBuilder::SplitResult BVHBuilder::findBestSplit(const std::vector<int>& triInd
     const int numBins = kBVHNumBins;
     float parentArea = bounds.surfaceArea();
 
+    // Binning - very large nodes (top of the tree) bin in parallel chunks
+    AxisBins bins{};
+    int count = end - start;
+    unsigned int threads = std::thread::hardware_concurrency();
+    if (parallelBuild_ && threads > 1 && count >= kBVHParallelBinningMin) {
+        int numChunks = static_cast<int>(std::min<unsigned int>(threads, static_cast<unsigned int>(count / (kBVHParallelBinningMin / 4))));
+        std::vector<AxisBins> chunkBins(numChunks);
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(numChunks);
+        for (int c = 0; c < numChunks; c++) {
+            int chunkStart = start + static_cast<int>(static_cast<int64_t>(count) * c / numChunks);
+            int chunkEnd = start + static_cast<int>(static_cast<int64_t>(count) * (c + 1) / numChunks);
+            tasks.push_back(std::async(std::launch::async, [&, c, chunkStart, chunkEnd]() {
+                binRange(triIndices, chunkStart, chunkEnd, bounds, chunkBins[c]);
+            }));
+        }
+        for (auto& task : tasks) {
+            task.get();
+        }
+        // Merge in chunk order (min/max merge is order-independent anyway)
+        for (const AxisBins& chunk : chunkBins) {
+            for (int axis = 0; axis < 3; axis++) {
+                for (int b = 0; b < numBins; b++) {
+                    bins[axis][b].bounds.expand(chunk[axis][b].bounds);
+                    bins[axis][b].count += chunk[axis][b].count;
+                }
+            }
+        }
+    } else {
+        binRange(triIndices, start, end, bounds, bins);
+    }
+
     for (int axis = 0; axis < 3; axis++) {
         float axisMin = bounds.min[axis];
         float axisMax = bounds.max[axis];
         if (axisMax - axisMin < 1e-6f) continue;
 
-        // Binning
-        struct Bin {
-            AABB bounds;
-            int count = 0;
-        };
-        std::vector<Bin> bins(numBins);
-
-        float scale = static_cast<float>(numBins) / (axisMax - axisMin);
-
-        for (int i = start; i < end; i++) {
-            int triIdx = triIndices[i];
-            float centroid = triangleCentroids_[triIdx][axis];
-            int binIdx = std::min(static_cast<int>((centroid - axisMin) * scale), numBins - 1);
-            bins[binIdx].bounds.expand(triangleBounds_[triIdx]);
-            bins[binIdx].count++;
-        }
+        const auto& axisBins = bins[axis];
 
         // Sweep from left to right, accumulating bounds and counts
-        std::vector<float> leftArea(numBins), rightArea(numBins);
-        std::vector<int> leftCount(numBins), rightCount(numBins);
+        std::array<float, kBVHNumBins> leftArea, rightArea;
+        std::array<int, kBVHNumBins> leftCount, rightCount;
 
         AABB leftBounds, rightBounds;
         int leftN = 0, rightN = 0;
 
         for (int i = 0; i < numBins; i++) {
-            leftN += bins[i].count;
+            leftN += axisBins[i].count;
             leftCount[i] = leftN;
-            leftBounds.expand(bins[i].bounds);
+            leftBounds.expand(axisBins[i].bounds);
             leftArea[i] = leftBounds.surfaceArea();
 
             int j = numBins - 1 - i;
-            rightN += bins[j].count;
+            rightN += axisBins[j].count;
             rightCount[j] = rightN;
-            rightBounds.expand(bins[j].bounds);
+            rightBounds.expand(axisBins[j].bounds);
             rightArea[j] = rightBounds.surfaceArea();
         }
 
@@ -2,13 +2,31 @@
 #pragma once
 
 #include "RCSTypes.h"
+#include "Constants.h"
 #include <QVector3D>
 #include <QMatrix4x4>
 #include <vector>
+#include <array>
+#include <memory>
 #include <cstdint>
 
 namespace RCS {
 
+// Immutable result of a BVH build - shared between the build thread and the GL thread
+struct BVHSnapshot {
+    std::vector<BVHNode> nodes;
+    std::vector<Triangle> triangles;
+    std::vector<int32_t> skipLinks;  // Per node: next node in depth-first order once its subtree is done (-1 = end)
+    std::vector<QVector4D> normalCones;  // Per node: xyz = axis, w = sin(half-angle) of its triangle normals
+    std::vector<WideBVHNode> wideNodes;  // Same tree collapsed four-wide (empty if it does not fit the encoding)
+    int wideMaxDepth = 0;
+    uint32_t meshId = 0;  // Scene mesh this tree belongs to (RCSCompute::setMeshGeometry)
+    uint64_t geometryVersion = 0;
+    int maxDepth = 0;
+    bool refit = false;  // Same tree layout as the previous snapshot, only bounds/positions moved
+    double buildTimeMs = 0.0;  // Worker-thread build or refit time (profiling)
+};
+
 class BVHBuilder {
 public:
     BVHBuilder() = default;
@@ -28,21 +46,111 @@ public:
     int getNodeCount() const { return static_cast<int>(nodes_.size()); }
     int getTriangleCount() const { return static_cast<int>(triangles_.size()); }
 
+    // Skip (escape) links for stackless traversal. Nodes are stored depth-first,
+    // so a hit internal node continues at its left child and a miss or finished
+    // leaf jumps to its skip link. Unchanged by refit().
+    const std::vector<int32_t>& getSkipLinks() const { return skipLinks_; }
+
+    // Normal cone of each node's triangles, for back-face culling of whole
+    // subtrees: xyz = unit axis, w = sine of the half-angle, or kNoNormalCone
+    // when the normals spread over a hemisphere or more. A ray with
+    // dot(axis, dir) >= w can only reach back faces below the node. Refit
+    // recomputes them.
+    const std::vector<QVector4D>& getNormalCones() const { return normalCones_; }
+
+    // The binary tree collapsed into four-wide nodes with quantized child bounds.
+    // Child slots map onto binary nodes, so refit() only re-quantizes them and
+    // the layout (node count, leaf ranges) never changes. Empty when a leaf or
+    // the triangle count exceeds the child encoding.
+    const std::vector<WideBVHNode>& getWideNodes() const { return wideNodes_; }
+    int getWideMaxDepth() const { return wideMaxDepth_; }
+
     // Debug info
     int getMaxDepth() const { return maxDepth_; }
 
+    // Refit the existing tree to new vertex positions (same indices as the last build).
+    // Recomputes AABBs bottom-up without changing the node layout.
+    // Returns false if there is no compatible tree or the SAH cost has drifted past
+    // kBVHRefitMaxCostRatio - the caller should then do a full build().
+    bool refit(const std::vector<float>& vertices);
+    bool hasSameTopology(const std::vector<uint32_t>& indices) const;
+
+    // Material table indices, one per source triangle of the last build (in
+    // index order); empty or short puts the rest on material 0. Slots are
+    // mapped through the build's triangle order, so no rebuild is needed.
+    void setTriangleMaterials(const std::vector<uint32_t>& materialIds);
+
+    // Tree quality (normalized SAH cost) - at build time and now
+    float getSAHCost() const { return sahCost_; }
+    float getBuildSAHCost() const { return buildSAHCost_; }
+
+    // Copy the built nodes/triangles into an immutable snapshot.
+    // The builder keeps its state so the tree can be refit later.
+    std::shared_ptr<const BVHSnapshot> takeSnapshot(uint32_t meshId, uint64_t geometryVersion,
+                                                    bool refit = false, double buildTimeMs = 0.0) const;
+
+    // Parallel build: large subtrees are built as tasks on worker threads.
+    // Output is identical to the serial build (same depth-first node order).
+    void setParallelBuild(bool enabled) { parallelBuild_ = enabled; }
+    bool isParallelBuild() const { return parallelBuild_; }
+
 private:
     std::vector<BVHNode> nodes_;
     std::vector<Triangle> triangles_;
+    std::vector<int32_t> skipLinks_;
+    std::vector<QVector4D> normalCones_;
+    std::vector<WideBVHNode> wideNodes_;
+    std::vector<std::array<int, 4>> wideChildSources_;  // Binary node behind each wide child slot (-1 = empty)
+    int wideMaxDepth_ = 0;
     std::vector<AABB> triangleBounds_;
     std::vector<QVector3D> triangleCentroids_;
     int maxDepth_ = 0;
+    bool parallelBuild_ = true;
+
+    // Kept from the last build for refit()
+    std::vector<uint32_t> sourceIndices_;
+    std::vector<int> triangleOrder_;  // Sorted slot -> source triangle index
+    QMatrix4x4 transform_;
+    float buildSAHCost_ = 0.0f;
+    float sahCost_ = 0.0f;
+
+    float computeSAHCost() const;
+    void computeSkipLinks();
+    void computeNormalCones();  // Bottom-up over the current triangles
+
+    // Wide tree: collapse picks each node's children greedily (open the binary
+    // child with the largest surface area until four slots are used);
+    // quantizeWide() encodes their bounds and runs again after every refit
+    void buildWide();
+    int collapseWide(int binaryIndex, int depth);
+    void quantizeWide();
 
-    // Recursive build using SAH (Surface Area Heuristic)
-    int buildRecursive(std::vector<int>& triIndices, int start, int end, int depth);
+    // Recursive build using SAH (Surface Area Heuristic).
+    // Appends the subtree for [start, end) to `nodes` in depth-first order
+    // (node, left subtree, right subtree) and returns its root index.
+    int buildRecursive(std::vector<BVHNode>& nodes, std::vector<int>& triIndices,
+                       int start, int end, int depth, int& maxDepth) const;
+
+    // Same layout as buildRecursive, but forks subtrees into tasks while
+    // taskDepth > 0 and the range is large; children are spliced back in order
+    int buildParallel(std::vector<BVHNode>& nodes, std::vector<int>& triIndices,
+                      int start, int end, int depth, int taskDepth, int& maxDepth) const;
+
+    // Choose a split and partition [start, end). Returns the partition point
+    // and the split axis.
+    int partitionRange(std::vector<int>& triIndices, int start, int end, const AABB& bounds, int& axis) const;
 
     // Compute AABB for a range of triangles
-    AABB computeBounds(const std::vector<int>& triIndices, int start, int end);
+    AABB computeBounds(const std::vector<int>& triIndices, int start, int end) const;
+
+    // SAH bins - fixed size, lives on the stack
+    struct Bin {
+        AABB bounds;
+        int count = 0;
+    };
+    using AxisBins = std::array<std::array<Bin, RS::Constants::kBVHNumBins>, 3>;
+    void binRange(const std::vector<int>& triIndices, int start, int end,
+                  const AABB& bounds, AxisBins& bins) const;
 
     // Find best split using SAH
     struct SplitResult {
@@ -50,7 +158,7 @@ private:
         float position;
         float cost;
     };
-    SplitResult findBestSplit(const std::vector<int>& triIndices, int start, int end, const AABB& bounds);
+    SplitResult findBestSplit(const std::vector<int>& triIndices, int start, int end, const AABB& bounds) const;
 };
 
 } // namespace RCS
@@ -0,0 +1,328 @@
+// BVHTraversal.h - CPU BVH traversal shared by CPURayTracer and the debug rays
+//
+// traverse<NodeLayout, HitPolicy>() walks one mesh's object-space tree for a
+// ray type. The node layout and hit policy are template parameters, so each
+// combination compiles to its own loop with no per-node layout or policy
+// checks. A ray type supplies the lane-wise primitives:
+//
+//   using Hit = ...;                        // Closest hit per lane, carries t
+//   int lanes() const;                      // Bits of the lanes holding a ray
+//   int enterBox(lo, hi, const Hit&, float& tEnter) const;  // Lanes entering the box
+//                                           // before their hit; tEnter orders wide children
+//   int hitTriangle(tri, triIndex, instance, Hit&) const;  // Records closer hits, returns their lanes
+//   bool negativeDir(int axis) const;       // Direction sign picking the near binary child
+//
+// ScalarRay below is the single-ray type; CPURayTracer's four-ray SSE packet
+// implements the same interface. Both follow the trace kernel's conventions:
+// tmin 0.001, t is the distance along the (unnormalized) object-space direction.
+#pragma once
+
+#include "BVHBuilder.h"
+#include "RCSTypes.h"
+#include "Constants.h"
+#include <QVector3D>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace RCS {
+namespace Traversal {
+
+constexpr float kRayTMin = 0.001f;  // Same tmin as the ray generation kernel
+
+// Hit policies
+struct ClosestHit {
+    static constexpr bool kAnyHit = false;
+};
+struct AnyHit {
+    static constexpr bool kAnyHit = true;  // Done once every lane has a hit (occlusion queries)
+};
+
+// Node layouts
+struct BinaryNodes {};  // BVHSnapshot::nodes - near child first, explicit stack
+struct WideNodes {};    // BVHSnapshot::wideNodes - four quantized children per fetch
+
+// One ray. Mirrors intersectAABB/intersectTriangle of the trace kernel.
+struct ScalarRay {
+    struct Hit {
+        float t = 0.0f;
+        int instance = -1;
+        int triangle = -1;
+    };
+
+    float origin[3];
+    float dir[3];
+    float invDir[3];
+    float tMin = kRayTMin;
+
+    ScalarRay(const QVector3D& o, const QVector3D& d, float minT = kRayTMin) : tMin(minT) {
+        for (int axis = 0; axis < 3; ++axis) {
+            origin[axis] = o[axis];
+            dir[axis] = d[axis];
+            // No inf * 0 in the slab test
+            invDir[axis] = std::abs(d[axis]) > 1e-6f ? 1.0f / d[axis] : 1e30f;
+        }
+    }
+
+    int lanes() const { return 1; }
+    bool negativeDir(int axis) const { return dir[axis] < 0.0f; }
+
+    int enterBox(const float lo[3], const float hi[3], const Hit& hit, float& tEnter) const {
+        tEnter = -1e30f;
+        float tExit = 1e30f;
+        for (int axis = 0; axis < 3; ++axis) {
+            float t1 = (lo[axis] - origin[axis]) * invDir[axis];
+            float t2 = (hi[axis] - origin[axis]) * invDir[axis];
+            tEnter = std::max(tEnter, std::min(t1, t2));
+            tExit = std::min(tExit, std::max(t1, t2));
+        }
+        return tEnter <= tExit && tExit >= 0.0f && tEnter < hit.t ? 1 : 0;
+    }
+
+    int hitTriangle(const Triangle& tri, int triIndex, int instance, Hit& hit) const {
+        float h[3] = {dir[1] * tri.e2[2] - dir[2] * tri.e2[1],
+                      dir[2] * tri.e2[0] - dir[0] * tri.e2[2],
+                      dir[0] * tri.e2[1] - dir[1] * tri.e2[0]};
+        float a = tri.e1[0] * h[0] + tri.e1[1] * h[1] + tri.e1[2] * h[2];
+        if (std::abs(a) < 1e-8f) return 0;
+
+        float f = 1.0f / a;
+        float s[3] = {origin[0] - tri.v0[0], origin[1] - tri.v0[1], origin[2] - tri.v0[2]};
+        float u = f * (s[0] * h[0] + s[1] * h[1] + s[2] * h[2]);
+        if (u < 0.0f || u > 1.0f) return 0;
+
+        float q[3] = {s[1] * tri.e1[2] - s[2] * tri.e1[1],
+                      s[2] * tri.e1[0] - s[0] * tri.e1[2],
+                      s[0] * tri.e1[1] - s[1] * tri.e1[0]};
+        float v = f * (dir[0] * q[0] + dir[1] * q[1] + dir[2] * q[2]);
+        if (v < 0.0f || u + v > 1.0f) return 0;
+
+        float t = f * (tri.e2[0] * q[0] + tri.e2[1] * q[1] + tri.e2[2] * q[2]);
+        if (t < tMin || t >= hit.t) return 0;
+        hit.t = t;
+        hit.instance = instance;
+        hit.triangle = triIndex;
+        return 1;
+    }
+};
+
+namespace detail {
+
+// Tests a leaf's triangles. Returns true when the any-hit policy is satisfied.
+template <typename HitPolicy, typename RayT>
+bool testLeaf(const std::vector<Triangle>& triangles, int firstTri, int count, int instanceIndex,
+              const RayT& ray, typename RayT::Hit& hit, int& hitLanes) {
+    for (int i = 0; i < count; ++i) {
+        hitLanes |= ray.hitTriangle(triangles[firstTri + i], firstTri + i, instanceIndex, hit);
+        if (HitPolicy::kAnyHit && hitLanes == ray.lanes()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename HitPolicy, typename RayT>
+int traverseBinary(const BVHSnapshot& bvh, const RayT& ray, int instanceIndex,
+                   typename RayT::Hit& hit, std::vector<int>& stack) {
+    const std::vector<BVHNode>& nodes = bvh.nodes;
+    const int nodeCount = static_cast<int>(nodes.size());
+    int hitLanes = 0;
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        int nodeIdx = stack.back();
+        stack.pop_back();
+        if (nodeIdx < 0 || nodeIdx >= nodeCount) {
+            continue;
+        }
+
+        const BVHNode& node = nodes[nodeIdx];
+        const float lo[3] = {node.boundsMin.x(), node.boundsMin.y(), node.boundsMin.z()};
+        const float hi[3] = {node.boundsMax.x(), node.boundsMax.y(), node.boundsMax.z()};
+        float tEnter;
+        if (ray.enterBox(lo, hi, hit, tEnter) == 0) {
+            continue;
+        }
+
+        int leftInfo = static_cast<int>(node.boundsMin.w());
+        int rightOrCount = static_cast<int>(node.boundsMax.w());
+        if (leftInfo < 0) {
+            if (testLeaf<HitPolicy>(bvh.triangles, -leftInfo - 1, rightOrCount, instanceIndex,
+                                    ray, hit, hitLanes)) {
+                break;
+            }
+        } else {
+            // Far child first so the near one is popped next
+            bool rightFirst = ray.negativeDir(leftInfo);
+            stack.push_back(rightFirst ? nodeIdx + 1 : rightOrCount);
+            stack.push_back(rightFirst ? rightOrCount : nodeIdx + 1);
+        }
+    }
+    return hitLanes;
+}
+
+template <typename HitPolicy, typename RayT>
+int traverseWide(const BVHSnapshot& bvh, const RayT& ray, int instanceIndex,
+                 typename RayT::Hit& hit, std::vector<int>& stack) {
+    using namespace RS::Constants;
+    const std::vector<WideBVHNode>& nodes = bvh.wideNodes;
+    const int nodeCount = static_cast<int>(nodes.size());
+    int hitLanes = 0;
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        int nodeIdx = stack.back();
+        stack.pop_back();
+        if (nodeIdx < 0 || nodeIdx >= nodeCount) {
+            continue;
+        }
+        const WideBVHNode& node = nodes[nodeIdx];
+
+        float step[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            int biased = static_cast<int>((node.exponents >> (8 * axis)) & 0xFFu);
+            step[axis] = std::ldexp(1.0f, biased - 127);
+        }
+
+        // Child boxes exactly as slabAxis() in the WIDE_BVH kernel decodes them
+        int inner[kWideBVHWidth];
+        float innerKey[kWideBVHWidth];
+        int innerCount = 0;
+        bool done = false;
+        for (int i = 0; i < kWideBVHWidth && !done; ++i) {
+            uint32_t child = node.children[i];
+            if (child == kWideBVHChildEmpty) {
+                continue;
+            }
+            float lo[3];
+            float hi[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                lo[axis] = node.origin[axis] + static_cast<float>((node.quantLo[axis] >> (8 * i)) & 0xFFu) * step[axis];
+                hi[axis] = node.origin[axis] + static_cast<float>((node.quantHi[axis] >> (8 * i)) & 0xFFu) * step[axis];
+            }
+            float tEnter;
+            if (ray.enterBox(lo, hi, hit, tEnter) == 0) {
+                continue;
+            }
+
+            if (child & kWideBVHLeafFlag) {
+                int firstTri = static_cast<int>(child & 0xFFFFFFu);
+                int count = static_cast<int>((child >> kWideBVHLeafCountShift) & 0x7Fu);
+                done = testLeaf<HitPolicy>(bvh.triangles, firstTri, count, instanceIndex, ray, hit, hitLanes);
+            } else {
+                // Farthest first, as in the kernel, so the nearest pops next
+                int slot = innerCount++;
+                while (slot > 0 && innerKey[slot - 1] < tEnter) {
+                    inner[slot] = inner[slot - 1];
+                    innerKey[slot] = innerKey[slot - 1];
+                    --slot;
+                }
+                inner[slot] = static_cast<int>(child);
+                innerKey[slot] = tEnter;
+            }
+        }
+        if (done) {
+            break;
+        }
+        for (int i = 0; i < innerCount; ++i) {
+            stack.push_back(inner[i]);
+        }
+    }
+    return hitLanes;
+}
+
+} // namespace detail
+
+// Closed-form test of a unit analytic primitive (intersectPrimitive in the
+// trace kernel). origin and dir are in primitive space, dir unnormalized, so
+// t is the same distance as along the world ray. On a closer hit in
+// [tMin, tMax) sets t and the primitive-space normal, which for the two-sided
+// plate faces the ray.
+inline bool intersectPrimitive(AnalyticShapeType shape, const QVector3D& origin, const QVector3D& dir,
+                               float tMin, float tMax, float& t, QVector3D& normal) {
+    switch (shape) {
+    case AnalyticShapeType::Sphere: {
+        // Chord about the point nearest the centre - no cancellation for a
+        // far-away radar
+        float a = QVector3D::dotProduct(dir, dir);
+        float tc = -QVector3D::dotProduct(origin, dir) / a;
+        QVector3D closest = origin + dir * tc;
+        float h2 = 1.0f - QVector3D::dotProduct(closest, closest);
+        if (h2 < 0.0f) return false;
+        float dt = std::sqrt(h2 / a);
+        float hitT = tc - dt >= tMin ? tc - dt : tc + dt;
+        if (hitT < tMin || hitT >= tMax) return false;
+        t = hitT;
+        normal = origin + dir * hitT;
+        return true;
+    }
+    case AnalyticShapeType::Cylinder: {
+        bool found = false;
+        float best = tMax;
+        // Side, as the sphere in the XY plane
+        float a = dir.x() * dir.x() + dir.y() * dir.y();
+        if (a > 1e-12f) {
+            float tc = -(origin.x() * dir.x() + origin.y() * dir.y()) / a;
+            float cx = origin.x() + dir.x() * tc;
+            float cy = origin.y() + dir.y() * tc;
+            float h2 = 1.0f - cx * cx - cy * cy;
+            if (h2 >= 0.0f) {
+                float dt = std::sqrt(h2 / a);
+                for (float side : {tc - dt, tc + dt}) {
+                    QVector3D p = origin + dir * side;
+                    if (side >= tMin && side < best && std::abs(p.z()) <= 1.0f) {
+                        best = side;
+                        normal = QVector3D(p.x(), p.y(), 0.0f);
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        // Caps
+        if (std::abs(dir.z()) > 1e-12f) {
+            for (float z : {1.0f, -1.0f}) {
+                float capT = (z - origin.z()) / dir.z();
+                QVector3D p = origin + dir * capT;
+                if (capT >= tMin && capT < best && p.x() * p.x() + p.y() * p.y() <= 1.0f) {
+                    best = capT;
+                    normal = QVector3D(0.0f, 0.0f, z);
+                    found = true;
+                }
+            }
+        }
+        if (found) t = best;
+        return found;
+    }
+    case AnalyticShapeType::Plate: {
+        if (std::abs(dir.z()) < 1e-12f) return false;
+        float hitT = -origin.z() / dir.z();
+        if (hitT < tMin || hitT >= tMax) return false;
+        QVector3D p = origin + dir * hitT;
+        if (std::abs(p.x()) > 1.0f || std::abs(p.y()) > 1.0f) return false;
+        t = hitT;
+        normal = QVector3D(0.0f, 0.0f, dir.z() < 0.0f ? 1.0f : -1.0f);
+        return true;
+    }
+    }
+    return false;
+}
+
+// Walks bvh for ray, updating hit with closer hits in instanceIndex. Returns
+// the lanes that found a hit in this tree. stack is scratch, kept by the
+// caller so repeated calls do not allocate.
+template <typename NodeLayout, typename HitPolicy, typename RayT>
+int traverse(const BVHSnapshot& bvh, const RayT& ray, int instanceIndex,
+             typename RayT::Hit& hit, std::vector<int>& stack) {
+    if constexpr (std::is_same_v<NodeLayout, WideNodes>) {
+        return detail::traverseWide<HitPolicy>(bvh, ray, instanceIndex, hit, stack);
+    } else {
+        return detail::traverseBinary<HitPolicy>(bvh, ray, instanceIndex, hit, stack);
+    }
+}
+
+} // namespace Traversal
+} // namespace RCS
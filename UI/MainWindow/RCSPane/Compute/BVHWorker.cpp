@@ -0,0 +1,64 @@
+// BVHWorker.cpp - Background BVH construction off the GUI thread
+#include "BVHWorker.h"
+#include <QMatrix4x4>
+#include <QElapsedTimer>
+
+namespace RCS {
+
+BVHWorker::BVHWorker(QObject* parent)
+    : QObject(parent)
+{
+}
+
+void BVHWorker::setLatestRequestedVersion(uint32_t meshId, uint64_t version) {
+    std::lock_guard<std::mutex> lock(versionMutex_);
+    latestRequestedVersions_[meshId] = version;
+}
+
+void BVHWorker::forgetMesh(uint32_t meshId) {
+    std::lock_guard<std::mutex> lock(versionMutex_);
+    latestRequestedVersions_.erase(meshId);
+}
+
+bool BVHWorker::isLatestVersion(uint32_t meshId, uint64_t version) const {
+    std::lock_guard<std::mutex> lock(versionMutex_);
+    auto it = latestRequestedVersions_.find(meshId);
+    return it != latestRequestedVersions_.end() && it->second == version;
+}
+
+void BVHWorker::releaseMesh(uint32_t meshId) {
+    builders_.erase(meshId);
+}
+
+void BVHWorker::build(RCS::BVHBuildRequestPtr request) {
+    if (!request) return;
+
+    // A newer mesh was requested while this one waited - don't waste the build
+    if (!isLatestVersion(request->meshId, request->geometryVersion)) {
+        return;
+    }
+
+    BVHBuilder& builder = builders_[request->meshId];
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Same indices as the last build (deformation, moving parts) - refit in place
+    // unless tree quality has drifted too far
+    bool refitted = false;
+    if (builder.hasSameTopology(request->indices)) {
+        refitted = builder.refit(request->vertices);
+    }
+
+    // Object-space build; instance transforms are applied at trace time
+    if (!refitted) {
+        builder.build(request->vertices, request->indices, QMatrix4x4());
+    }
+    builder.setTriangleMaterials(request->materialIds);
+    double buildMs = static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+    BVHSnapshotPtr snapshot = builder.takeSnapshot(request->meshId, request->geometryVersion,
+                                                   refitted, buildMs);
+    emit bvhReady(snapshot);
+}
+
+} // namespace RCS
@@ -0,0 +1,61 @@
+// BVHWorker.h - Background BVH construction off the GUI thread
+#pragma once
+
+#include <QObject>
+#include <QMetaType>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "BVHBuilder.h"
+
+namespace RCS {
+
+// Mesh copy handed to the build thread (object space, 6-float interleaved vertices)
+struct BVHBuildRequest {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> materialIds;  // Per source triangle, empty = all material 0
+    uint32_t meshId = 0;
+    uint64_t geometryVersion = 0;
+};
+
+using BVHBuildRequestPtr = std::shared_ptr<const BVHBuildRequest>;
+using BVHSnapshotPtr = std::shared_ptr<const BVHSnapshot>;
+
+// Lives on its own QThread. Requests arrive through a queued connection and
+// results leave through bvhReady(); no GL calls are made here. Each scene mesh
+// keeps its own builder so it can be refit independently of the others.
+class BVHWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BVHWorker(QObject* parent = nullptr);
+
+    // Called from the GUI thread before queuing a request, so the worker can
+    // skip builds that were superseded while they sat in the queue
+    void setLatestRequestedVersion(uint32_t meshId, uint64_t version);
+    void forgetMesh(uint32_t meshId);  // GUI thread - queued builds for the mesh are skipped
+
+public slots:
+    void build(RCS::BVHBuildRequestPtr request);
+    void releaseMesh(uint32_t meshId);  // Drops the mesh's builder (and its refit state)
+
+signals:
+    void bvhReady(RCS::BVHSnapshotPtr snapshot);
+
+private:
+    bool isLatestVersion(uint32_t meshId, uint64_t version) const;
+
+    std::unordered_map<uint32_t, BVHBuilder> builders_;  // Worker thread only
+
+    mutable std::mutex versionMutex_;
+    std::unordered_map<uint32_t, uint64_t> latestRequestedVersions_;
+};
+
+} // namespace RCS
+
+Q_DECLARE_METATYPE(RCS::BVHBuildRequestPtr)
+Q_DECLARE_METATYPE(RCS::BVHSnapshotPtr)
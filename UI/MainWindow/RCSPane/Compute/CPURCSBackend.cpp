@@ -0,0 +1,72 @@
+// CPURCSBackend.cpp - CPURayTracer behind the RCSBackend interface
+#include "CPURCSBackend.h"
+#include <QDebug>
+
+namespace RCS {
+
+void CPURCSBackend::setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                                    const std::vector<uint32_t>& indices, uint64_t geometryVersion,
+                                    const std::vector<uint32_t>& materialIds) {
+    // A tree from setMeshBVH() of this version already describes the geometry
+    std::shared_ptr<const BVHSnapshot> current = tracer_.getMeshBVH(meshId);
+    if (current && current->geometryVersion == geometryVersion) {
+        return;
+    }
+    tracer_.setMeshGeometry(meshId, vertices, indices, materialIds);
+}
+
+void CPURCSBackend::setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh) {
+    tracer_.setMeshBVH(meshId, std::move(bvh));
+}
+
+std::shared_ptr<const BVHSnapshot> CPURCSBackend::getMeshBVH(uint32_t meshId) const {
+    return tracer_.getMeshBVH(meshId);
+}
+
+void CPURCSBackend::setInstances(const std::vector<TargetInstance>& instances) {
+    tracer_.setInstances(instances);
+}
+
+void CPURCSBackend::setPrimitives(const std::vector<ScenePrimitive>& primitives) {
+    tracer_.setPrimitives(primitives);
+}
+
+void CPURCSBackend::applySettings(const TraceSettings& settings) {
+    tracer_.setSphereRadius(settings.sphereRadius);
+    tracer_.setBeamWidth(settings.beamWidthDegrees);
+    tracer_.setNumRays(settings.numRays);
+    tracer_.setRaySampling(settings.sampling);
+    tracer_.setBVHLayout(settings.bvhLayout);
+    tracer_.setThreadCount(settings.threads);
+    if (settings.maxBounces > 1) {
+        qWarning() << "CPURCSBackend: Traces single bounces only, ignoring maxBounces";
+    }
+    if (!settings.materials.empty()) {
+        qWarning() << "CPURCSBackend: Has no material shading, ignoring the material table";
+    }
+    if (settings.bvhBuild == BVHBuild::GPU) {
+        qWarning() << "CPURCSBackend: Builds BVHs on the CPU only, ignoring bvhBuild";
+    }
+}
+
+bool CPURCSBackend::traceLooks(const std::vector<RadarLook>& looks, std::vector<LookCut>& cuts) {
+    cuts.resize(looks.size());
+    for (size_t i = 0; i < looks.size(); ++i) {
+        const RadarLook& look = looks[i];
+        if (look.slice.cutType != static_cast<int>(CutType::Azimuth)) {
+            qWarning() << "CPURCSBackend: Only azimuth cuts are supported";
+            return false;
+        }
+        tracer_.setRadarPosition(look.radarPosition);
+        tracer_.setBeamDirection(look.beamDirection);
+        tracer_.compute();
+
+        sampler_.setThickness(look.slice.thicknessDegrees);
+        sampler_.setOffset(look.slice.offsetDegrees);
+        sampler_.sample(tracer_.getHitResults(), cuts[i].cut);
+        cuts[i].hitCount = tracer_.getHitCount();
+    }
+    return true;
+}
+
+} // namespace RCS
@@ -0,0 +1,42 @@
+// CPURCSBackend.h - CPURayTracer behind the RCSBackend interface
+#pragma once
+
+#include "RCSBackend.h"
+#include "CPURayTracer.h"
+#include "AzimuthCutSampler.h"
+
+namespace RCS {
+
+// Traces looks one at a time, each spread over the tracer's worker threads,
+// and bins the hits with AzimuthCutSampler::sample(). Needs no GL, so it runs
+// on machines without GL 4.3. Single bounce only, azimuth cuts only.
+class CPURCSBackend : public RCSBackend {
+public:
+    CPURCSBackend() = default;
+    ~CPURCSBackend() override = default;
+
+    bool initialize() override { return true; }
+    void cleanup() override {}
+
+    void setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                         const std::vector<uint32_t>& indices, uint64_t geometryVersion,
+                         const std::vector<uint32_t>& materialIds = {}) override;
+    void setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh) override;
+    std::shared_ptr<const BVHSnapshot> getMeshBVH(uint32_t meshId) const override;
+    void setInstances(const std::vector<TargetInstance>& instances) override;
+    void setPrimitives(const std::vector<ScenePrimitive>& primitives) override;
+    bool waitForScene() override { return true; }  // setMeshGeometry() builds synchronously
+
+    void applySettings(const TraceSettings& settings) override;
+    int getNumRays() const override { return tracer_.getNumRays(); }
+
+    bool traceLooks(const std::vector<RadarLook>& looks, std::vector<LookCut>& cuts) override;
+
+    QString describe() const override { return "cpu"; }
+
+private:
+    CPURayTracer tracer_;
+    AzimuthCutSampler sampler_;
+};
+
+} // namespace RCS
@@ -0,0 +1,524 @@
+// CPURayTracer.cpp - Multithreaded packet ray tracer over the RCS BVHs (no GL)
+#include "CPURayTracer.h"
+#include "BVHTraversal.h"
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <thread>
+
+// SSE2 is the x86-64 baseline, so this needs no extra compiler flags there
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RCS_CPU_TRACER_SSE 1
+#endif
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr int kPacketSize = 4;
+
+// Four lanes of floats and lane masks - one lane per ray of a packet
+#ifdef RCS_CPU_TRACER_SSE
+struct Float4 {
+    __m128 v;
+    Float4() = default;
+    Float4(__m128 m) : v(m) {}
+    explicit Float4(float f) : v(_mm_set1_ps(f)) {}
+    static Float4 load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+struct Mask4 {
+    __m128 v;
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.v, b.v); }
+inline Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.v, b.v); }
+inline Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.v, b.v); }
+inline Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.v, b.v); }
+inline Float4 vmin(Float4 a, Float4 b) { return _mm_min_ps(a.v, b.v); }
+inline Float4 vmax(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+inline Float4 vabs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+inline Mask4 operator<(Float4 a, Float4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask4 operator<=(Float4 a, Float4 b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mask4 operator>=(Float4 a, Float4 b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return {_mm_and_ps(a.v, b.v)}; }
+inline Float4 select(Mask4 m, Float4 a, Float4 b) {
+    return _mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v));
+}
+inline int laneBits(Mask4 m) { return _mm_movemask_ps(m.v); }
+inline Mask4 laneMask(int bits) {
+    return {_mm_castsi128_ps(_mm_set_epi32(bits & 8 ? -1 : 0, bits & 4 ? -1 : 0,
+                                           bits & 2 ? -1 : 0, bits & 1 ? -1 : 0))};
+}
+#else
+struct Float4 {
+    float v[kPacketSize];
+    Float4() = default;
+    explicit Float4(float f) : v{f, f, f, f} {}
+    static Float4 load(const float* p) { return Float4::from(p[0], p[1], p[2], p[3]); }
+    static Float4 from(float a, float b, float c, float d) { Float4 r; r.v[0] = a; r.v[1] = b; r.v[2] = c; r.v[3] = d; return r; }
+    void store(float* p) const { std::copy(v, v + kPacketSize, p); }
+};
+struct Mask4 {
+    bool v[kPacketSize];
+};
+
+template <typename Op>
+inline Float4 lanewise(Float4 a, Float4 b, Op op) {
+    return Float4::from(op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]));
+}
+template <typename Op>
+inline Mask4 compare(Float4 a, Float4 b, Op op) {
+    return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+}
+
+inline Float4 operator+(Float4 a, Float4 b) { return lanewise(a, b, [](float x, float y) { return x + y; }); }
+inline Float4 operator-(Float4 a, Float4 b) { return lanewise(a, b, [](float x, float y) { return x - y; }); }
+inline Float4 operator*(Float4 a, Float4 b) { return lanewise(a, b, [](float x, float y) { return x * y; }); }
+inline Float4 operator/(Float4 a, Float4 b) { return lanewise(a, b, [](float x, float y) { return x / y; }); }
+inline Float4 vmin(Float4 a, Float4 b) { return lanewise(a, b, [](float x, float y) { return y < x ? y : x; }); }
+inline Float4 vmax(Float4 a, Float4 b) { return lanewise(a, b, [](float x, float y) { return y > x ? y : x; }); }
+inline Float4 vabs(Float4 a) { return lanewise(a, a, [](float x, float) { return std::abs(x); }); }
+inline Mask4 operator<(Float4 a, Float4 b) { return compare(a, b, [](float x, float y) { return x < y; }); }
+inline Mask4 operator<=(Float4 a, Float4 b) { return compare(a, b, [](float x, float y) { return x <= y; }); }
+inline Mask4 operator>=(Float4 a, Float4 b) { return compare(a, b, [](float x, float y) { return x >= y; }); }
+inline Mask4 operator&(Mask4 a, Mask4 b) { return {{a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3]}}; }
+inline Float4 select(Mask4 m, Float4 a, Float4 b) {
+    return Float4::from(m.v[0] ? a.v[0] : b.v[0], m.v[1] ? a.v[1] : b.v[1],
+                        m.v[2] ? a.v[2] : b.v[2], m.v[3] ? a.v[3] : b.v[3]);
+}
+inline int laneBits(Mask4 m) { return (m.v[0] ? 1 : 0) | (m.v[1] ? 2 : 0) | (m.v[2] ? 4 : 0) | (m.v[3] ? 8 : 0); }
+inline Mask4 laneMask(int bits) { return {{(bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0, (bits & 8) != 0}}; }
+#endif
+
+// Three components for each of four rays (structure of arrays)
+struct Vec3x4 {
+    Float4 x, y, z;
+};
+
+inline Vec3x4 splat(const float* v) { return {Float4(v[0]), Float4(v[1]), Float4(v[2])}; }
+inline Vec3x4 operator-(const Vec3x4& a, const Vec3x4& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline Float4 dot(const Vec3x4& a, const Vec3x4& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3x4 cross(const Vec3x4& a, const Vec3x4& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+// Closest hit so far per lane
+struct PacketHit {
+    Float4 t;
+    int instance[kPacketSize];
+    int triangle[kPacketSize];
+};
+
+// Up to four rays in one space (world or an instance's object space). Implements
+// the ray interface of Traversal::traverse() with the trace kernel's tests.
+struct RayPacket {
+    using Hit = PacketHit;
+
+    Vec3x4 origin;
+    Vec3x4 dir;
+    Vec3x4 invDir;
+    Mask4 active;          // Lanes holding a ray - the last packet of a range may be partial
+    int activeBits = 0;
+    bool negative[3];      // Lane 0's direction sign per axis, picks the near child
+
+    int lanes() const { return activeBits; }
+    bool negativeDir(int axis) const { return negative[axis]; }
+
+    // Lanes whose ray enters the box before their closest hit (intersectAABB in
+    // the trace kernel); tNear is the earliest entry among them
+    int enterBox(const float lo[3], const float hi[3], const Hit& hit, float& tNear) const {
+        Float4 t1x = (Float4(lo[0]) - origin.x) * invDir.x;
+        Float4 t2x = (Float4(hi[0]) - origin.x) * invDir.x;
+        Float4 t1y = (Float4(lo[1]) - origin.y) * invDir.y;
+        Float4 t2y = (Float4(hi[1]) - origin.y) * invDir.y;
+        Float4 t1z = (Float4(lo[2]) - origin.z) * invDir.z;
+        Float4 t2z = (Float4(hi[2]) - origin.z) * invDir.z;
+        Float4 tEnter = vmax(vmax(vmin(t1x, t2x), vmin(t1y, t2y)), vmin(t1z, t2z));
+        Float4 tExit = vmin(vmin(vmax(t1x, t2x), vmax(t1y, t2y)), vmax(t1z, t2z));
+        int bits = laneBits(active & (tEnter <= tExit) & (tExit >= Float4(0.0f)) & (tEnter < hit.t));
+
+        float enter[kPacketSize];
+        tEnter.store(enter);
+        tNear = 1e30f;
+        for (int lane = 0; lane < kPacketSize; ++lane) {
+            if (bits & (1 << lane)) {
+                tNear = std::min(tNear, enter[lane]);
+            }
+        }
+        return bits;
+    }
+
+    // Moller-Trumbore on the precomputed edges for all four rays (intersectTriangle
+    // in the kernel). Records the lanes it brings closer and returns them.
+    int hitTriangle(const Triangle& tri, int triIndex, int instance, Hit& hit) const {
+        Vec3x4 e1 = splat(tri.e1);
+        Vec3x4 e2 = splat(tri.e2);
+        Vec3x4 h = cross(dir, e2);
+        Float4 a = dot(e1, h);
+        Float4 f = Float4(1.0f) / a;
+        Vec3x4 s = origin - splat(tri.v0);
+        Float4 u = f * dot(s, h);
+        Vec3x4 q = cross(s, e1);
+        Float4 v = f * dot(dir, q);
+        Float4 t = f * dot(e2, q);
+        Mask4 closer = active & (Float4(1e-8f) <= vabs(a)) & (Float4(0.0f) <= u) & (u <= Float4(1.0f)) &
+                       (Float4(0.0f) <= v) & (u + v <= Float4(1.0f)) & (Float4(Traversal::kRayTMin) <= t) &
+                       (t < hit.t);
+        int bits = laneBits(closer);
+        if (bits == 0) {
+            return 0;
+        }
+        hit.t = select(closer, t, hit.t);
+        for (int lane = 0; lane < kPacketSize; ++lane) {
+            if (bits & (1 << lane)) {
+                hit.instance[lane] = instance;
+                hit.triangle[lane] = triIndex;
+            }
+        }
+        return bits;
+    }
+};
+
+RayPacket makePacket(const QVector3D* origins, const QVector3D* dirs, int activeBits) {
+    float o[3][kPacketSize];
+    float d[3][kPacketSize];
+    float inv[3][kPacketSize];
+    for (int lane = 0; lane < kPacketSize; ++lane) {
+        for (int axis = 0; axis < 3; ++axis) {
+            o[axis][lane] = origins[lane][axis];
+            d[axis][lane] = dirs[lane][axis];
+            // Same guard as Traversal::ScalarRay - no inf * 0 in the slab test
+            inv[axis][lane] = std::abs(dirs[lane][axis]) > 1e-6f ? 1.0f / dirs[lane][axis] : 1e30f;
+        }
+    }
+
+    RayPacket packet;
+    packet.origin = {Float4::load(o[0]), Float4::load(o[1]), Float4::load(o[2])};
+    packet.dir = {Float4::load(d[0]), Float4::load(d[1]), Float4::load(d[2])};
+    packet.invDir = {Float4::load(inv[0]), Float4::load(inv[1]), Float4::load(inv[2])};
+    packet.active = laneMask(activeBits);
+    packet.activeBits = activeBits;
+    for (int axis = 0; axis < 3; ++axis) {
+        packet.negative[axis] = dirs[0][axis] < 0.0f;
+    }
+    return packet;
+}
+
+// Unit-square point of an area-uniform pattern, as samplePoint() in the ray
+// generation kernel (no rotation - the CPU tracer always runs a single pass)
+void samplePoint(RaySampling sampling, uint32_t rayId, int numRays, float& u, float& v) {
+    constexpr float kInv32 = 2.3283064e-10f;  // 2^-32
+    if (sampling == RaySampling::Fibonacci) {
+        u = (static_cast<float>(rayId) + 0.5f) / static_cast<float>(numRays);
+        v = static_cast<float>(rayId * 2654435769u) * kInv32;
+        return;
+    }
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t dir = 0x80000000u;
+    for (uint32_t i = rayId, bit = 0x80000000u; i != 0; i >>= 1, bit >>= 1, dir ^= dir >> 1) {
+        if (i & 1u) {
+            x |= bit;
+            y ^= dir;
+        }
+    }
+    u = static_cast<float>(x) * kInv32;
+    v = static_cast<float>(y) * kInv32;
+}
+
+} // namespace
+
+void CPURayTracer::setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                                   const std::vector<uint32_t>& indices,
+                                   const std::vector<uint32_t>& materialIds) {
+    if (vertices.empty() || indices.size() < 3) {
+        removeMesh(meshId);
+        return;
+    }
+
+    // Object-space tree, as RCSCompute builds it - instances carry the placement
+    BVHBuilder builder;
+    builder.build(vertices, indices, QMatrix4x4());
+    builder.setTriangleMaterials(materialIds);
+    meshes_[meshId] = builder.takeSnapshot(meshId, 0);
+    instancesDirty_ = true;
+}
+
+void CPURayTracer::setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh) {
+    if (!bvh || bvh->nodes.empty()) {
+        removeMesh(meshId);
+        return;
+    }
+    meshes_[meshId] = std::move(bvh);
+    instancesDirty_ = true;
+}
+
+std::shared_ptr<const BVHSnapshot> CPURayTracer::getMeshBVH(uint32_t meshId) const {
+    auto it = meshes_.find(meshId);
+    return it != meshes_.end() ? it->second : nullptr;
+}
+
+void CPURayTracer::removeMesh(uint32_t meshId) {
+    if (meshes_.erase(meshId) > 0) {
+        instancesDirty_ = true;
+    }
+}
+
+void CPURayTracer::setInstances(const std::vector<TargetInstance>& instances) {
+    instances_ = instances;
+    instancesDirty_ = true;
+}
+
+void CPURayTracer::setPrimitives(const std::vector<ScenePrimitive>& primitives) {
+    primitives_.clear();
+    primitives_.reserve(primitives.size());
+    for (const ScenePrimitive& primitive : primitives) {
+        Primitive state;
+        state.shape = primitive.shape;
+        bool invertible = false;
+        state.invModelMatrix = primitive.modelMatrix.inverted(&invertible);
+        if (!invertible) {
+            qWarning() << "CPURayTracer: Singular transform for primitive" << primitives_.size() << ", skipped";
+            continue;
+        }
+        state.normalTransform = state.invModelMatrix.transposed();
+        state.targetId = primitive.targetId;
+        state.materialId = primitive.materialId;
+        primitives_.push_back(state);
+    }
+}
+
+void CPURayTracer::setNumRays(int numRays) {
+    numRays_ = std::clamp(numRays, 1, kMaxRayCount);
+}
+
+int CPURayTracer::getThreadCount() const {
+    if (threadCount_ > 0) {
+        return threadCount_;
+    }
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+bool CPURayTracer::isSimdEnabled() {
+#ifdef RCS_CPU_TRACER_SSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CPURayTracer::compute() {
+    if (instancesDirty_) {
+        // One state per instance, in setInstances() order so indices are targetIds
+        instanceStates_.clear();
+        instanceStates_.reserve(instances_.size());
+        for (const TargetInstance& instance : instances_) {
+            Instance state;
+            auto it = meshes_.find(instance.meshId);
+            if (it != meshes_.end()) {
+                state.bvh = it->second;
+            }
+            bool invertible = false;
+            state.invModelMatrix = instance.modelMatrix.inverted(&invertible);
+            if (!invertible) {
+                qWarning() << "CPURayTracer: Singular model matrix for instance"
+                           << instanceStates_.size() << ", using identity";
+                state.invModelMatrix.setToIdentity();
+            }
+            state.normalTransform = state.invModelMatrix.transposed();
+            instanceStates_.push_back(state);
+        }
+        instancesDirty_ = false;
+    }
+
+    hitResults_.resize(numRays_);
+
+    // Beam frame, exactly as the ray generation kernel derives it
+    Beam beam;
+    beam.forward = beamDirection_.normalized();
+    QVector3D up = std::abs(beam.forward.z()) < 0.99f ? QVector3D(0, 0, 1) : QVector3D(1, 0, 0);
+    beam.right = QVector3D::crossProduct(beam.forward, up).normalized();
+    beam.up = QVector3D::crossProduct(beam.right, beam.forward).normalized();
+    beam.halfAngle = beamWidthDegrees_ * kDegToRadF * 0.5f;
+    beam.numRings = (numRays_ + kRaysPerRing - 1) / kRaysPerRing;
+    float halfSin = std::sin(beam.halfAngle * 0.5f);
+    beam.sampling = raySampling_;
+    beam.capOneMinusCos = 2.0f * halfSin * halfSin;
+    beam.maxDistance = sphereRadius_ * kMaxRayDistanceMultiplier;
+
+    // Threads claim fixed chunks of consecutive rays until none are left
+    int chunkCount = (numRays_ + kCPUTraceChunkRays - 1) / kCPUTraceChunkRays;
+    int threads = std::min(getThreadCount(), chunkCount);
+    std::atomic<int> nextChunk{0};
+    auto worker = [this, &beam, &nextChunk]() {
+        std::vector<int> stack;
+        stack.reserve(2 * kBVHStackSize);
+        int hits = 0;
+        for (;;) {
+            int first = nextChunk.fetch_add(1) * kCPUTraceChunkRays;
+            if (first >= numRays_) {
+                break;
+            }
+            hits += traceRange(beam, first, std::min(first + kCPUTraceChunkRays, numRays_), stack);
+        }
+        return hits;
+    };
+
+    std::vector<std::future<int>> tasks;
+    for (int i = 1; i < threads; ++i) {
+        tasks.push_back(std::async(std::launch::async, worker));
+    }
+    int hits = worker();
+    for (auto& task : tasks) {
+        hits += task.get();
+    }
+    hitCount_ = hits;
+}
+
+int CPURayTracer::traceRange(const Beam& beam, int first, int last, std::vector<int>& stack) {
+    int hits = 0;
+
+    for (int packetStart = first; packetStart < last; packetStart += kPacketSize) {
+        int laneCount = std::min(kPacketSize, last - packetStart);
+
+        // Ray generation kernel: rings are interleaved, so consecutive rays share
+        // an azimuth on neighbouring rings and make a coherent packet (the
+        // low-discrepancy patterns spread them instead)
+        QVector3D origins[kPacketSize];
+        QVector3D dirs[kPacketSize];
+        for (int lane = 0; lane < kPacketSize; ++lane) {
+            int rayId = packetStart + std::min(lane, laneCount - 1);
+            float sinAngle;
+            float cosAngle;
+            float azimuth;
+            if (beam.sampling == RaySampling::Rings) {
+                int ring = rayId % beam.numRings;
+                int posInRing = rayId / beam.numRings;
+                float ringAngle = beam.halfAngle * static_cast<float>(ring + 1) / static_cast<float>(beam.numRings);
+                sinAngle = std::sin(ringAngle);
+                cosAngle = std::cos(ringAngle);
+                azimuth = 2.0f * 3.14159265f * static_cast<float>(posInRing) / static_cast<float>(kRaysPerRing);
+            } else {
+                float u;
+                float v;
+                samplePoint(beam.sampling, static_cast<uint32_t>(rayId), numRays_, u, v);
+                float oneMinusCos = u * beam.capOneMinusCos;
+                sinAngle = std::sqrt(oneMinusCos * (2.0f - oneMinusCos));
+                cosAngle = 1.0f - oneMinusCos;
+                azimuth = 2.0f * 3.14159265f * v;
+            }
+            QVector3D worldDir = sinAngle * std::cos(azimuth) * beam.right +
+                                 sinAngle * std::sin(azimuth) * beam.up +
+                                 cosAngle * beam.forward;
+            origins[lane] = radarPosition_;
+            dirs[lane] = worldDir.normalized();
+        }
+        int activeBits = (1 << laneCount) - 1;
+
+        PacketHit hit;
+        hit.t = Float4(beam.maxDistance);
+        std::fill(hit.instance, hit.instance + kPacketSize, -1);
+        std::fill(hit.triangle, hit.triangle + kPacketSize, -1);
+
+        // Each mesh root box rejects packets that miss the instance, so instances
+        // are simply tested in turn (as in traceSceneCPU). t stays a world-space
+        // distance because directions are mapped without renormalizing.
+        for (size_t instanceIdx = 0; instanceIdx < instanceStates_.size(); ++instanceIdx) {
+            const Instance& instance = instanceStates_[instanceIdx];
+            if (!instance.bvh || instance.bvh->nodes.empty() || instance.bvh->triangles.empty()) {
+                continue;
+            }
+            QVector3D localOrigins[kPacketSize];
+            QVector3D localDirs[kPacketSize];
+            for (int lane = 0; lane < kPacketSize; ++lane) {
+                localOrigins[lane] = instance.invModelMatrix.map(origins[lane]);
+                localDirs[lane] = instance.invModelMatrix.mapVector(dirs[lane]);
+            }
+            RayPacket packet = makePacket(localOrigins, localDirs, activeBits);
+            if (bvhLayout_ == BVHLayout::Wide4 && !instance.bvh->wideNodes.empty()) {
+                Traversal::traverse<Traversal::WideNodes, Traversal::ClosestHit>(
+                    *instance.bvh, packet, static_cast<int>(instanceIdx), hit, stack);
+            } else {
+                Traversal::traverse<Traversal::BinaryNodes, Traversal::ClosestHit>(
+                    *instance.bvh, packet, static_cast<int>(instanceIdx), hit, stack);
+            }
+        }
+
+        // Analytic primitives one lane at a time after the meshes, as
+        // tracePrimitives in the kernel. A primitive hit is recorded as
+        // instance instanceCount + primitive index.
+        float closestT[kPacketSize];
+        hit.t.store(closestT);
+        const int instanceCount = static_cast<int>(instanceStates_.size());
+        QVector3D primitiveNormals[kPacketSize];
+        for (size_t p = 0; p < primitives_.size(); ++p) {
+            const Primitive& primitive = primitives_[p];
+            for (int lane = 0; lane < laneCount; ++lane) {
+                float t;
+                QVector3D n;
+                if (Traversal::intersectPrimitive(primitive.shape, primitive.invModelMatrix.map(origins[lane]),
+                                                  primitive.invModelMatrix.mapVector(dirs[lane]),
+                                                  Traversal::kRayTMin, closestT[lane], t, n)) {
+                    closestT[lane] = t;
+                    hit.instance[lane] = instanceCount + static_cast<int>(p);
+                    primitiveNormals[lane] = n;
+                }
+            }
+        }
+
+        // Shade each lane like the end of the trace kernel
+        for (int lane = 0; lane < laneCount; ++lane) {
+            HitResult& result = hitResults_[packetStart + lane];
+            result.hitPoint = QVector4D(0, 0, 0, -1.0f);  // -1 = no hit
+            result.normal = QVector4D(0, 0, 0, 0);
+            result.reflection = QVector4D(0, 0, 0, 0);
+            result.triangleId = 0xFFFFFFFFu;
+            result.rayId = static_cast<uint32_t>(packetStart + lane);
+            result.targetId = 0;
+            result.rcsContribution = 2.0f * 3.14159265f * beam.capOneMinusCos / static_cast<float>(numRays_);
+            if (hit.instance[lane] < 0) {
+                continue;
+            }
+
+            float t = closestT[lane];
+            QVector3D incident = dirs[lane];
+            QVector3D hitPos = origins[lane] + incident * t;
+            QVector3D n;
+            if (hit.instance[lane] >= instanceCount) {
+                int p = hit.instance[lane] - instanceCount;
+                const Primitive& primitive = primitives_[p];
+                n = primitive.normalTransform.mapVector(primitiveNormals[lane]).normalized();
+                result.normal = QVector4D(n, static_cast<float>(primitive.materialId));
+                result.triangleId = static_cast<uint32_t>(p);
+                result.targetId = primitive.targetId;
+            } else {
+                const Instance& instance = instanceStates_[hit.instance[lane]];
+                const Triangle& tri = instance.bvh->triangles[hit.triangle[lane]];
+                n = instance.normalTransform.mapVector(tri.normal()).normalized();
+                result.normal = QVector4D(n, static_cast<float>(tri.materialId));
+                result.triangleId = static_cast<uint32_t>(hit.triangle[lane]);
+                result.targetId = static_cast<uint32_t>(hit.instance[lane]);
+            }
+            result.hitPoint = QVector4D(hitPos, t);
+
+            // Front-facing surfaces reflect with the kernel's diffuse + specular BRDF
+            float facing = QVector3D::dotProduct(n, -incident);
+            if (facing > 0.0f) {
+                QVector3D reflectDir = incident - 2.0f * QVector3D::dotProduct(n, incident) * n;
+                float intensity = std::clamp(0.3f * facing + 0.7f * std::pow(facing, 32.0f), 0.0f, 1.0f);
+                result.reflection = QVector4D(reflectDir, intensity);
+            }
+            ++hits;
+        }
+    }
+
+    return hits;
+}
+
+} // namespace RCS
@@ -0,0 +1,120 @@
+// CPURayTracer.h - Multithreaded packet ray tracer over the RCS BVHs (no GL)
+#pragma once
+
+#include "RCSTypes.h"
+#include "BVHBuilder.h"
+#include "Constants.h"
+#include <QVector3D>
+#include <QMatrix4x4>
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace RCS {
+
+// CPU counterpart of RCSCompute's ray generation and trace kernels. Meshes are
+// built with the same BVHBuilder and rays come from the same cone pattern, so
+// getHitResults() follows compute()'s contract: one HitResult per ray in rayId
+// order, misses with hitPoint.w = -1, reflection and intensity from the same
+// BRDF. Rays are traced four at a time (SSE where available, scalar lanes
+// otherwise) by a pool of worker threads. Used for headless sweeps on machines
+// without GL 4.3 and as a reference when checking the GPU kernels.
+class CPURayTracer {
+public:
+    CPURayTracer() = default;
+    ~CPURayTracer() = default;
+
+    // Scene - same mesh/instance model as RCSCompute. Builds run synchronously.
+    // vertices: interleaved [x,y,z,nx,ny,nz] per vertex (object space)
+    // materialIds: per triangle, reported in HitResult::normal.w
+    void setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                         const std::vector<uint32_t>& indices,
+                         const std::vector<uint32_t>& materialIds = {});
+    // Uses an existing object-space tree (BVHWorker, TargetCache) instead of building one
+    void setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh);
+    std::shared_ptr<const BVHSnapshot> getMeshBVH(uint32_t meshId) const;
+    void removeMesh(uint32_t meshId);
+    void setInstances(const std::vector<TargetInstance>& instances);
+    // Analytic primitives traced after the instances (RCSCompute::setPrimitives)
+    void setPrimitives(const std::vector<ScenePrimitive>& primitives);
+
+    // Radar configuration (RCSCompute semantics)
+    void setRadarPosition(const QVector3D& position) { radarPosition_ = position; }
+    void setBeamDirection(const QVector3D& direction) { beamDirection_ = direction; }
+    void setBeamWidth(float degrees) { beamWidthDegrees_ = degrees; }
+    void setSphereRadius(float radius) { sphereRadius_ = radius; }
+    void setNumRays(int numRays);
+    int getNumRays() const { return numRays_; }
+    // Same patterns as RCSCompute::setRaySampling, always unrotated
+    void setRaySampling(RaySampling sampling) { raySampling_ = sampling; }
+    RaySampling getRaySampling() const { return raySampling_; }
+    // Node layout walked per mesh. Wide4 falls back to binary for trees without
+    // a wide encoding; both give the same hits.
+    void setBVHLayout(BVHLayout layout) { bvhLayout_ = layout; }
+    BVHLayout getBVHLayout() const { return bvhLayout_; }
+
+    // Worker threads for compute() (0 = one per hardware thread)
+    void setThreadCount(int threads) { threadCount_ = threads; }
+    int getThreadCount() const;
+
+    // Generates and traces every ray; blocks until all threads are done
+    void compute();
+
+    int getHitCount() const { return hitCount_; }
+    const std::vector<HitResult>& getHitResults() const { return hitResults_; }
+
+    // True when packets use SSE; false for the portable scalar build
+    static bool isSimdEnabled();
+
+private:
+    struct Instance {
+        std::shared_ptr<const BVHSnapshot> bvh;
+        QMatrix4x4 invModelMatrix;   // Rays are mapped into object space for traversal
+        QMatrix4x4 normalTransform;  // transpose(inverse) for normals
+    };
+
+    struct Primitive {
+        AnalyticShapeType shape = AnalyticShapeType::Sphere;
+        QMatrix4x4 invModelMatrix;
+        QMatrix4x4 normalTransform;
+        uint32_t targetId = 0;
+        uint32_t materialId = 0;
+    };
+
+    // Ray generation frame shared by every ray of a compute()
+    struct Beam {
+        QVector3D forward;
+        QVector3D right;
+        QVector3D up;
+        float halfAngle = 0.0f;
+        int numRings = 1;
+        RaySampling sampling = RaySampling::Rings;
+        float capOneMinusCos = 0.0f;  // 1 - cos(halfAngle), area-uniform patterns
+        float maxDistance = 0.0f;
+    };
+
+    // Generates and traces rays [first, last) into hitResults_, returns their
+    // hit count. stack is the calling thread's traversal stack.
+    int traceRange(const Beam& beam, int first, int last, std::vector<int>& stack);
+
+    std::map<uint32_t, std::shared_ptr<const BVHSnapshot>> meshes_;
+    std::vector<TargetInstance> instances_;
+    std::vector<Instance> instanceStates_;
+    bool instancesDirty_ = false;
+    std::vector<Primitive> primitives_;
+
+    QVector3D radarPosition_;
+    QVector3D beamDirection_{0.0f, 0.0f, -1.0f};
+    float beamWidthDegrees_ = RS::Constants::Defaults::kBeamWidth;
+    float sphereRadius_ = RS::Constants::Defaults::kSphereRadius;
+    int numRays_ = RS::Constants::kDefaultNumRays;
+    RaySampling raySampling_ = RaySampling::Rings;
+    BVHLayout bvhLayout_ = BVHLayout::Binary;
+    int threadCount_ = 0;
+
+    std::vector<HitResult> hitResults_;
+    int hitCount_ = 0;
+};
+
+} // namespace RCS
@@ -0,0 +1,100 @@
+// CompactTriangles.cpp - Leaf-relative 16-bit triangle encoding (TrianglePrecision::Compact)
+#include "CompactTriangles.h"
+#include "Constants.h"
+#include "ParallelChunks.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+// One axis of a vertex as an offset from the box minimum. The shader decodes
+// lo + q * step; step is a power of two, so the product is exact and the sum
+// rounds once, just as here. Stepping q back until that sum is <= hi keeps the
+// decoded vertex inside the box.
+uint16_t quantizeAxis(float value, float lo, float hi) {
+    float step = std::ldexp(1.0f, compactStepExponent(hi - lo));
+    long q = std::lround((value - lo) / step);
+    q = std::clamp(q, 0L, 65535L);
+    while (q > 0 && lo + static_cast<float>(q) * step > hi) {
+        q--;
+    }
+    return static_cast<uint16_t>(q);
+}
+
+void encodeLeaf(const std::vector<Triangle>& triangles, int firstTri, int count,
+                const float lo[3], const float hi[3], std::vector<CompactTriangle>& out) {
+    int end = std::min(firstTri + count, static_cast<int>(triangles.size()));
+    for (int t = std::max(firstTri, 0); t < end; t++) {
+        const Triangle& tri = triangles[t];
+        QVector3D vertices[3] = {tri.vertex0(), tri.vertex0() + tri.edge1(), tri.vertex0() + tri.edge2()};
+
+        CompactTriangle& compact = out[t];
+        for (int v = 0; v < 3; v++) {
+            for (int axis = 0; axis < 3; axis++) {
+                compact.q[v * 3 + axis] = quantizeAxis(vertices[v][axis], lo[axis], hi[axis]);
+            }
+        }
+        compact.materialId = static_cast<uint16_t>(std::min<uint32_t>(tri.materialId, 0xFFFFu));
+        compact.normalOct = tri.normalOct;
+    }
+}
+
+} // namespace
+
+void encodeCompactTriangles(const BVHSnapshot& bvh, bool wideLayout, std::vector<CompactTriangle>& out) {
+    out.assign(bvh.triangles.size(), CompactTriangle());
+
+    // Leaves own disjoint triangle ranges, so node chunks write disjoint entries
+    if (wideLayout) {
+        const auto& nodes = bvh.wideNodes;
+        int chunks = RS::parallelChunkCount(nodes.size(), kBVHParallelMinTriangles);
+        RS::runChunks(chunks, nodes.size(), [&](int, size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) {
+                const WideBVHNode& node = nodes[n];
+                float step[3];
+                for (int axis = 0; axis < 3; axis++) {
+                    int biased = static_cast<int>((node.exponents >> (8 * axis)) & 0xFFu);
+                    step[axis] = std::ldexp(1.0f, biased - 127);
+                }
+                for (int i = 0; i < kWideBVHWidth; i++) {
+                    uint32_t child = node.children[i];
+                    if (child == kWideBVHChildEmpty || (child & kWideBVHLeafFlag) == 0) continue;
+
+                    // The child box exactly as slabAxis() decodes it
+                    float lo[3];
+                    float hi[3];
+                    for (int axis = 0; axis < 3; axis++) {
+                        float qLo = static_cast<float>((node.quantLo[axis] >> (8 * i)) & 0xFFu);
+                        float qHi = static_cast<float>((node.quantHi[axis] >> (8 * i)) & 0xFFu);
+                        lo[axis] = node.origin[axis] + qLo * step[axis];
+                        hi[axis] = node.origin[axis] + qHi * step[axis];
+                    }
+                    int firstTri = static_cast<int>(child & 0xFFFFFFu);
+                    int count = static_cast<int>((child >> kWideBVHLeafCountShift) & 0x7Fu);
+                    encodeLeaf(bvh.triangles, firstTri, count, lo, hi, out);
+                }
+            }
+        });
+        return;
+    }
+
+    const auto& nodes = bvh.nodes;
+    int chunks = RS::parallelChunkCount(nodes.size(), kBVHParallelMinTriangles);
+    RS::runChunks(chunks, nodes.size(), [&](int, size_t begin, size_t end) {
+        for (size_t n = begin; n < end; n++) {
+            const BVHNode& node = nodes[n];
+            if (node.boundsMin.w() >= 0.0f) continue;
+
+            const float lo[3] = {node.boundsMin.x(), node.boundsMin.y(), node.boundsMin.z()};
+            const float hi[3] = {node.boundsMax.x(), node.boundsMax.y(), node.boundsMax.z()};
+            int firstTri = -static_cast<int>(node.boundsMin.w()) - 1;
+            encodeLeaf(bvh.triangles, firstTri, static_cast<int>(node.boundsMax.w()), lo, hi, out);
+        }
+    });
+}
+
+} // namespace RCS
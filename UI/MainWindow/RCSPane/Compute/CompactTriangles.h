@@ -0,0 +1,16 @@
+// CompactTriangles.h - Leaf-relative 16-bit triangle encoding (TrianglePrecision::Compact)
+#pragma once
+
+#include "RCSTypes.h"
+#include "BVHBuilder.h"
+#include <vector>
+
+namespace RCS {
+
+// Encodes a mesh's triangles (BVH order) against the leaf boxes of the layout
+// the trace kernel walks: node bounds for the binary tree, the decoded
+// quantized child boxes for the wide one. The two give different offsets, so
+// the triangles are encoded again whenever the active layout changes.
+void encodeCompactTriangles(const BVHSnapshot& bvh, bool wideLayout, std::vector<CompactTriangle>& out);
+
+} // namespace RCS
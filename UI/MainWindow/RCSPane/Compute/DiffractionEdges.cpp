@@ -0,0 +1,134 @@
+// DiffractionEdges.cpp - Crease edges as wedges for the edge diffraction pass
+#include "DiffractionEdges.h"
+#include "Constants.h"
+#include <QVector3D>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+}
+
+QVector3D vertexAt(const std::vector<float>& vertices, uint32_t index) {
+    size_t offset = static_cast<size_t>(index) * 6;
+    return QVector3D(vertices[offset], vertices[offset + 1], vertices[offset + 2]);
+}
+
+} // namespace
+
+std::vector<DiffractionEdge> buildDiffractionEdges(const std::vector<float>& vertices,
+                                                   const std::vector<uint32_t>& indices,
+                                                   const std::vector<GeometricEdge>& edges) {
+    std::vector<DiffractionEdge> result;
+    const size_t vertexCount = vertices.size() / 6;
+
+    // Faces of every crease edge, from one pass over the triangles
+    struct Faces {
+        uint32_t triangle[2];
+        int count = 0;
+    };
+    std::unordered_map<uint64_t, Faces> faces;
+    for (const GeometricEdge& edge : edges) {
+        if (edge.isCrease && edge.v0 < vertexCount && edge.v1 < vertexCount && edge.v0 != edge.v1) {
+            faces.emplace(edgeKey(edge.v0, edge.v1), Faces());
+        }
+    }
+    if (faces.empty()) {
+        return result;
+    }
+    const size_t triangleCount = indices.size() / 3;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            auto it = faces.find(edgeKey(indices[t * 3 + k], indices[t * 3 + (k + 1) % 3]));
+            if (it == faces.end()) continue;
+            Faces& entry = it->second;
+            if (entry.count < 2) {
+                entry.triangle[entry.count] = static_cast<uint32_t>(t);
+            }
+            ++entry.count;
+        }
+    }
+
+    // Outward normal and in-face direction (away from the edge, perpendicular
+    // to it) of a triangle on the edge
+    auto faceFrame = [&](uint32_t triangle, const QVector3D& start, const QVector3D& tangent,
+                         QVector3D& normal, QVector3D& inward) {
+        QVector3D p[3];
+        QVector3D apex;
+        float apexDistance = -1.0f;
+        for (int k = 0; k < 3; ++k) {
+            p[k] = vertexAt(vertices, indices[triangle * 3 + k]);
+            QVector3D offset = p[k] - start;
+            QVector3D across = offset - tangent * QVector3D::dotProduct(offset, tangent);
+            if (across.length() > apexDistance) {
+                apexDistance = across.length();
+                apex = across;
+            }
+        }
+        normal = QVector3D::crossProduct(p[1] - p[0], p[2] - p[0]);
+        if (normal.length() <= 0.0f || apexDistance <= 0.0f) {
+            return false;
+        }
+        normal.normalize();
+        inward = apex / apexDistance;
+        return true;
+    };
+
+    result.reserve(faces.size());
+    for (const GeometricEdge& edge : edges) {
+        auto it = faces.find(edgeKey(edge.v0, edge.v1));
+        if (it == faces.end() || it->second.count < 1 || it->second.count > 2) {
+            continue;  // Not a crease, or non-manifold
+        }
+        const Faces& entry = it->second;
+
+        QVector3D start = vertexAt(vertices, edge.v0);
+        QVector3D span = vertexAt(vertices, edge.v1) - start;
+        float length = span.length();
+        if (length <= 0.0f) continue;
+        QVector3D tangent = span / length;
+
+        QVector3D n0, b0;
+        if (!faceFrame(entry.triangle[0], start, tangent, n0, b0)) continue;
+
+        // Exterior angle: from face 0 through the side its normal faces to face 1
+        float wedge = 2.0f;
+        if (entry.count == 2) {
+            QVector3D n1, b1;
+            if (!faceFrame(entry.triangle[1], start, tangent, n1, b1)) continue;
+            float angle = std::atan2(QVector3D::dotProduct(b1, n0), QVector3D::dotProduct(b1, b0));
+            if (angle < 0.0f) angle += kTwoPiF;
+            wedge = angle / kPiF;
+            if (std::abs(wedge - 1.0f) < kEdgeDiffractionMinWedge) continue;  // Coplanar faces
+        }
+
+        DiffractionEdge out;
+        out.origin[0] = start.x();
+        out.origin[1] = start.y();
+        out.origin[2] = start.z();
+        out.origin[3] = length;
+        out.tangent[0] = tangent.x();
+        out.tangent[1] = tangent.y();
+        out.tangent[2] = tangent.z();
+        out.tangent[3] = wedge;
+        out.normal0[0] = n0.x();
+        out.normal0[1] = n0.y();
+        out.normal0[2] = n0.z();
+        out.normal0[3] = 0.0f;
+        out.face0[0] = b0.x();
+        out.face0[1] = b0.y();
+        out.face0[2] = b0.z();
+        out.face0[3] = 0.0f;
+        result.push_back(out);
+    }
+    return result;
+}
+
+} // namespace RCS
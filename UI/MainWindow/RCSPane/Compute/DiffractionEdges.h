@@ -0,0 +1,29 @@
+// DiffractionEdges.h - Crease edges as wedges for the edge diffraction pass
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "WireframeTarget.h"
+
+namespace RCS {
+
+// One crease edge as the binning kernel's EDGE_DIFFRACTION variant reads it
+// (std430, 64 bytes). Object space; each instance's matrices place it.
+struct alignas(16) DiffractionEdge {
+    float origin[4];   // xyz = first vertex, w = length
+    float tangent[4];  // xyz = unit direction v0 -> v1, w = exterior wedge angle / pi
+    float normal0[4];  // xyz = outward normal of face 0
+    float face0[4];    // xyz = unit direction from the edge into face 0, perpendicular to the edge
+};
+static_assert(sizeof(DiffractionEdge) == 64, "DiffractionEdge is read as-is by the binning kernel");
+
+// Wedges for the crease edges (GeometricEdge::isCrease) of a [x,y,z,nx,ny,nz]
+// mesh, with face normals from the triangle winding. An edge with one face is
+// a half-plane (exterior angle 2 pi). Non-manifold and degenerate edges, and
+// wedges too flat to diffract, are dropped.
+std::vector<DiffractionEdge> buildDiffractionEdges(const std::vector<float>& vertices,
+                                                   const std::vector<uint32_t>& indices,
+                                                   const std::vector<GeometricEdge>& edges);
+
+} // namespace RCS
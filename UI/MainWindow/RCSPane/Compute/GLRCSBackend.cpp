@@ -0,0 +1,257 @@
+// GLRCSBackend.cpp - RCSCompute on an offscreen GL 4.3 context of its own
+#include "GLRCSBackend.h"
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOffscreenSurface>
+#include <QSurfaceFormat>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+GLRCSBackend::GLRCSBackend() = default;
+
+GLRCSBackend::~GLRCSBackend() {
+    cleanup();
+}
+
+bool GLRCSBackend::initialize() {
+    if (compute_) {
+        return true;
+    }
+
+    // Compute shaders need GL 4.3; ask for the same version the app uses
+    QSurfaceFormat format;
+    format.setVersion(4, 6);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+
+    context_ = std::make_unique<QOpenGLContext>();
+    context_->setFormat(format);
+    if (!context_->create()) {
+        qCritical() << "GLRCSBackend: Failed to create OpenGL context";
+        context_.reset();
+        return false;
+    }
+
+    QSurfaceFormat actual = context_->format();
+    if (actual.majorVersion() < 4 || (actual.majorVersion() == 4 && actual.minorVersion() < 3)) {
+        qCritical() << "GLRCSBackend: OpenGL 4.3 required, got"
+                    << actual.majorVersion() << "." << actual.minorVersion();
+        context_.reset();
+        return false;
+    }
+
+    surface_ = std::make_unique<QOffscreenSurface>();
+    surface_->setFormat(actual);
+    surface_->create();
+    if (!surface_->isValid() || !makeCurrent()) {
+        qCritical() << "GLRCSBackend: Failed to make offscreen context current";
+        cleanup();
+        return false;
+    }
+
+    compute_ = std::make_unique<RCSCompute>();
+    if (!compute_->initialize()) {
+        qCritical() << "GLRCSBackend: RCSCompute initialization failed";
+        compute_.reset();
+        cleanup();
+        return false;
+    }
+
+    // Looks go through computeLooks(), which only bins polar cuts
+    compute_->setHitPayload(HitPayload::None);
+    return true;
+}
+
+void GLRCSBackend::cleanup() {
+    if (compute_ && makeCurrent()) {
+        compute_->cleanup();
+        while (!gpuMeshes_.empty()) {
+            releaseGPUMesh(gpuMeshes_.begin()->first);
+        }
+        context_->doneCurrent();
+    }
+    gpuMeshes_.clear();
+    compute_.reset();
+    surface_.reset();
+    context_.reset();
+}
+
+bool GLRCSBackend::makeCurrent() {
+    return context_ && surface_ && context_->makeCurrent(surface_.get());
+}
+
+void GLRCSBackend::setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                                   const std::vector<uint32_t>& indices, uint64_t geometryVersion,
+                                   const std::vector<uint32_t>& materialIds) {
+    const size_t triangleCount = indices.size() / 3;
+    bool gpuBuild = bvhBuild_ == BVHBuild::GPU && triangleCount > 0;
+    if (gpuBuild && triangleCount > static_cast<size_t>(kGPUBVHMaxTriangles)) {
+        qWarning() << "GLRCSBackend:" << triangleCount << "triangles exceed the GPU BVH build limit,"
+                   << "building on the CPU";
+        gpuBuild = false;
+    }
+    auto existing = gpuMeshes_.find(meshId);
+    if (!gpuBuild) {
+        compute_->setMeshGeometry(meshId, vertices, indices, geometryVersion, materialIds);
+        // RCSCompute keeps a GPU tree of the same version, and with it the buffers
+        if (existing != gpuMeshes_.end() && existing->second.geometryVersion != geometryVersion && makeCurrent()) {
+            releaseGPUMesh(meshId);
+        }
+        return;
+    }
+    if (existing != gpuMeshes_.end() && existing->second.geometryVersion == geometryVersion) {
+        return;
+    }
+    if (!materialIds.empty()) {
+        qWarning() << "GLRCSBackend: GPU-built meshes use material 0, ignoring the material IDs";
+    }
+    if (!makeCurrent()) {
+        qCritical() << "GLRCSBackend: Lost the offscreen context";
+        return;
+    }
+
+    // New buffers: the old ones stay bound to the tree until RCSCompute takes these
+    QOpenGLFunctions* gl = context_->functions();
+    GPUMesh mesh;
+    mesh.geometryVersion = geometryVersion;
+    gl->glGenBuffers(1, &mesh.vertexBuffer);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+    gl->glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)),
+                     vertices.data(), GL_STATIC_DRAW);
+    gl->glGenBuffers(1, &mesh.indexBuffer);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, mesh.indexBuffer);
+    gl->glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(triangleCount * 3 * sizeof(uint32_t)),
+                     indices.data(), GL_STATIC_DRAW);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Known bounds put the mesh in the TLAS before the build's stats come back
+    AABB bounds;
+    for (size_t i = 0; i + 5 < vertices.size(); i += 6) {
+        bounds.expand(QVector3D(vertices[i], vertices[i + 1], vertices[i + 2]));
+    }
+    compute_->setMeshGPUGeometry(meshId, mesh.vertexBuffer, mesh.indexBuffer, static_cast<int>(triangleCount),
+                                 geometryVersion, bounds);
+    if (existing != gpuMeshes_.end()) {
+        releaseGPUMesh(meshId);
+    }
+    gpuMeshes_[meshId] = mesh;
+}
+
+void GLRCSBackend::releaseGPUMesh(uint32_t meshId) {
+    auto it = gpuMeshes_.find(meshId);
+    if (it == gpuMeshes_.end()) {
+        return;
+    }
+    QOpenGLFunctions* gl = context_->functions();
+    gl->glDeleteBuffers(1, &it->second.vertexBuffer);
+    gl->glDeleteBuffers(1, &it->second.indexBuffer);
+    gpuMeshes_.erase(it);
+}
+
+void GLRCSBackend::setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh) {
+    compute_->setMeshBVH(meshId, std::move(bvh));
+}
+
+std::shared_ptr<const BVHSnapshot> GLRCSBackend::getMeshBVH(uint32_t meshId) const {
+    return compute_->getMeshBVH(meshId);
+}
+
+void GLRCSBackend::setInstances(const std::vector<TargetInstance>& instances) {
+    compute_->setInstances(instances);
+}
+
+void GLRCSBackend::setPrimitives(const std::vector<ScenePrimitive>& primitives) {
+    compute_->setPrimitives(primitives);
+}
+
+bool GLRCSBackend::waitForScene() {
+    if (!compute_->isBVHBuildPending()) {
+        return true;
+    }
+
+    // The build runs on the BVH worker thread and reports back through a queued
+    // connection, so spin an event loop until it lands
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(compute_.get(), &RCSCompute::bvhUpdated, &loop, &QEventLoop::quit);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timeout.start(kSweepBVHTimeoutMs);
+    while (compute_->isBVHBuildPending() && timeout.isActive()) {
+        loop.exec();
+    }
+
+    if (compute_->isBVHBuildPending()) {
+        qCritical() << "GLRCSBackend: Timed out waiting for BVH build";
+        return false;
+    }
+    return makeCurrent();
+}
+
+void GLRCSBackend::applySettings(const TraceSettings& settings) {
+    compute_->setSphereRadius(settings.sphereRadius);
+    compute_->setBeamWidth(settings.beamWidthDegrees);
+    compute_->setNumRays(settings.numRays);
+    compute_->setRaySampling(settings.sampling);
+    compute_->setMaxBounces(settings.maxBounces);
+    compute_->setBounceTermination(settings.bounceCutoff, settings.rouletteThreshold);
+    compute_->setTraversalMode(settings.traversal);
+    compute_->setBVHLayout(settings.bvhLayout);
+    compute_->setTrianglePrecision(settings.trianglePrecision);
+    compute_->setRayReordering(settings.rayReordering);
+    compute_->setPersistentThreads(settings.persistentThreads);
+    compute_->setNormalConeCulling(settings.normalConeCulling);
+    compute_->setTemporalReuse(settings.temporalReuse);
+    setBVHBuild(settings.bvhBuild);
+    if (!settings.materials.empty()) {
+        compute_->setMaterials(settings.materials);
+    }
+}
+
+int GLRCSBackend::getNumRays() const {
+    return compute_->getNumRays();
+}
+
+bool GLRCSBackend::traceLooks(const std::vector<RadarLook>& looks, std::vector<LookCut>& cuts) {
+    if (!makeCurrent()) {
+        qCritical() << "GLRCSBackend: Lost the offscreen context";
+        return false;
+    }
+
+    cuts.resize(looks.size());
+    for (size_t first = 0; first < looks.size(); first += kMaxLooksPerDispatch) {
+        size_t count = std::min(looks.size() - first, static_cast<size_t>(kMaxLooksPerDispatch));
+        batch_.assign(looks.begin() + first, looks.begin() + first + count);
+        if (!compute_->computeLooks(batch_, results_)) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            sampler_.setThickness(batch_[i].slice.thicknessDegrees);
+            sampler_.setOffset(batch_[i].slice.offsetDegrees);
+            sampler_.sampleBins(results_[i].polarBins, cuts[first + i].cut);
+            cuts[first + i].hitCount = results_[i].hitCount;
+        }
+    }
+    return true;
+}
+
+QString GLRCSBackend::describe() const {
+    if (!compute_) {
+        return "gpu";
+    }
+    const char* traversal = compute_->isWideBVHActive() ? "wide"
+                          : compute_->isStacklessTraversalActive() ? "stackless" : "stack";
+    bool compact = compute_->getTrianglePrecision() == TrianglePrecision::Compact;
+    return QString("gpu, %1 traversal, %2 MB BLAS%3%4")
+        .arg(traversal)
+        .arg(compute_->getGeometryBytes() / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(compact ? " (compact triangles)" : "")
+        .arg(gpuMeshes_.empty() ? "" : " (GPU-built)");
+}
+
+} // namespace RCS
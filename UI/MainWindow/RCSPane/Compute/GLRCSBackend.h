@@ -0,0 +1,73 @@
+// GLRCSBackend.h - RCSCompute on an offscreen GL 4.3 context of its own
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "RCSBackend.h"
+#include "RCSCompute.h"
+#include "AzimuthCutSampler.h"
+
+class QOpenGLContext;
+class QOffscreenSurface;
+
+namespace RCS {
+
+// Creates its own context (shared with nothing), so its dispatches queue
+// independently of the display context. Looks go through
+// RCSCompute::computeLooks in batches of kMaxLooksPerDispatch. Must be created
+// and used on the GUI thread: the BVH worker reports back through queued
+// signals and waitForScene() spins an event loop for them. With
+// TraceSettings::bvhBuild GPU, setMeshGeometry() uploads the mesh to buffers of
+// its own and has RCSCompute build the tree there (setMeshGPUGeometry).
+// Switching the build for a mesh needs a new geometryVersion.
+class GLRCSBackend : public RCSBackend {
+public:
+    GLRCSBackend();
+    ~GLRCSBackend() override;
+
+    bool initialize() override;
+    void cleanup() override;
+
+    void setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                         const std::vector<uint32_t>& indices, uint64_t geometryVersion,
+                         const std::vector<uint32_t>& materialIds = {}) override;
+    void setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh) override;
+    std::shared_ptr<const BVHSnapshot> getMeshBVH(uint32_t meshId) const override;
+    void setInstances(const std::vector<TargetInstance>& instances) override;
+    void setPrimitives(const std::vector<ScenePrimitive>& primitives) override;
+    bool waitForScene() override;
+
+    void applySettings(const TraceSettings& settings) override;
+    int getNumRays() const override;
+
+    bool traceLooks(const std::vector<RadarLook>& looks, std::vector<LookCut>& cuts) override;
+
+    QString describe() const override;
+
+    RCSCompute* compute() const { return compute_.get(); }
+    // TraceSettings::bvhBuild on its own, for meshes set after this call
+    void setBVHBuild(BVHBuild build) { bvhBuild_ = build; }
+
+private:
+    bool makeCurrent();
+    void releaseGPUMesh(uint32_t meshId);
+
+    // Geometry of meshes built by GPUBVHBuilder; RCSCompute rebuilds from it on a repack
+    struct GPUMesh {
+        GLuint vertexBuffer = 0;
+        GLuint indexBuffer = 0;
+        uint64_t geometryVersion = 0;
+    };
+
+    std::unique_ptr<QOpenGLContext> context_;
+    std::unique_ptr<QOffscreenSurface> surface_;
+    std::unique_ptr<RCSCompute> compute_;
+    AzimuthCutSampler sampler_;        // Turns GPU polar bins into dBsm cuts
+    std::vector<RadarLook> batch_;
+    std::vector<LookResult> results_;
+    BVHBuild bvhBuild_ = BVHBuild::CPU;
+    std::map<uint32_t, GPUMesh> gpuMeshes_;
+};
+
+} // namespace RCS
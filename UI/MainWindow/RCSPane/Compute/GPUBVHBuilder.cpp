@@ -0,0 +1,511 @@
+// GPUBVHBuilder.cpp - Linear BVH construction in compute shaders
+#include "GPUBVHBuilder.h"
+#include "GLUtils.h"
+#include "Constants.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+#include <string>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr int kGroupSize = 256;  // Threads per group of the per-element kernels
+constexpr int kMortonBits = 30;
+
+// Shared by every kernel. Blocks a kernel does not touch are inactive, so each
+// one only counts the storage blocks it uses.
+const char* kCommonSource = R"(
+#version 430 core
+
+layout(std430, binding = 0) readonly buffer VertexBuffer { float vertices[]; };  // x, y, z, nx, ny, nz
+layout(std430, binding = 1) readonly buffer IndexBuffer { uint indices[]; };
+layout(std430, binding = 2) buffer CentroidBounds { uint centroidBounds[6]; };  // Ordered bits: min xyz, max xyz
+layout(std430, binding = 3) buffer SortKeys { uint keysIn[]; };      // GPURadixSort's buffers
+layout(std430, binding = 4) buffer SortValues { uint valuesIn[]; };
+layout(std430, binding = 8) buffer Children { uvec2 children[]; };
+layout(std430, binding = 9) buffer Parents { uint parents[]; };
+layout(std430, binding = 10) coherent buffer NodeBounds { vec4 nodeBounds[]; };  // min, max per node
+layout(std430, binding = 11) coherent buffer SubtreeSizes { uint subtreeSizes[]; };
+layout(std430, binding = 12) buffer Visits { uint visits[]; };
+
+struct BVHNode {
+    vec4 boundsMin;  // w = split axis (leaf: -firstTri-1)
+    vec4 boundsMax;  // w = right child (leaf: triangle count)
+};
+layout(std430, binding = 13) writeonly buffer NodeBuffer { BVHNode nodes[]; };
+layout(std430, binding = 14) writeonly buffer SkipBuffer { int skipLinks[]; };
+layout(std430, binding = 15) writeonly buffer TriangleBuffer { vec4 triangles[]; };  // 3 vec4s per RCS::Triangle
+layout(std430, binding = 16) buffer Stats {
+    vec4 rootMin;
+    vec4 rootMax;
+    uint maxDepth;
+};
+
+uniform uint triangleCount;
+
+const uint kNoParent = 0xFFFFFFFFu;
+
+vec3 vertexPosition(uint index) {
+    uint base = index * 6u;
+    return vec3(vertices[base], vertices[base + 1u], vertices[base + 2u]);
+}
+
+void trianglePositions(uint triangle, out vec3 a, out vec3 b, out vec3 c) {
+    a = vertexPosition(indices[triangle * 3u]);
+    b = vertexPosition(indices[triangle * 3u + 1u]);
+    c = vertexPosition(indices[triangle * 3u + 2u]);
+}
+
+// Float bits whose unsigned order is the float order, for atomicMin/Max
+uint orderedBits(float value) {
+    uint bits = floatBitsToUint(value);
+    return (bits & 0x80000000u) != 0u ? ~bits : bits | 0x80000000u;
+}
+
+float orderedFloat(uint bits) {
+    return uintBitsToFloat((bits & 0x80000000u) != 0u ? bits & 0x7FFFFFFFu : ~bits);
+}
+
+// Leaves follow the n - 1 internal nodes
+uint leafNode(uint sortedIndex) {
+    return triangleCount - 1u + sortedIndex;
+}
+)";
+
+// 1. Centroid bounds, reduced per group, then one atomic per group and axis
+const char* kBoundsSource = R"(
+layout(local_size_x = 256) in;
+
+shared vec3 sMin[256];
+shared vec3 sMax[256];
+
+void main() {
+    uint lane = gl_LocalInvocationID.x;
+    uint triangle = gl_GlobalInvocationID.x;
+    vec3 lo = vec3(3.4e38);
+    vec3 hi = vec3(-3.4e38);
+    if (triangle < triangleCount) {
+        vec3 a, b, c;
+        trianglePositions(triangle, a, b, c);
+        lo = hi = (a + b + c) * (1.0 / 3.0);
+    }
+    sMin[lane] = lo;
+    sMax[lane] = hi;
+    barrier();
+    for (uint stride = 128u; stride > 0u; stride >>= 1u) {
+        if (lane < stride) {
+            sMin[lane] = min(sMin[lane], sMin[lane + stride]);
+            sMax[lane] = max(sMax[lane], sMax[lane + stride]);
+        }
+        barrier();
+    }
+    if (lane == 0u) {
+        for (int axis = 0; axis < 3; axis++) {
+            atomicMin(centroidBounds[axis], orderedBits(sMin[0][axis]));
+            atomicMax(centroidBounds[axis + 3], orderedBits(sMax[0][axis]));
+        }
+    }
+}
+)";
+
+// 2. 30-bit Morton code of each centroid within the centroid bounds
+const char* kMortonSource = R"(
+layout(local_size_x = 256) in;
+
+// Spreads the low 10 bits two apart
+uint expandBits(uint v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+void main() {
+    uint triangle = gl_GlobalInvocationID.x;
+    if (triangle >= triangleCount) return;
+
+    vec3 lo = vec3(orderedFloat(centroidBounds[0]), orderedFloat(centroidBounds[1]), orderedFloat(centroidBounds[2]));
+    vec3 hi = vec3(orderedFloat(centroidBounds[3]), orderedFloat(centroidBounds[4]), orderedFloat(centroidBounds[5]));
+    vec3 a, b, c;
+    trianglePositions(triangle, a, b, c);
+    vec3 unit = clamp(((a + b + c) * (1.0 / 3.0) - lo) / max(hi - lo, vec3(1e-30)), 0.0, 1.0);
+    uvec3 cell = uvec3(min(unit * 1024.0, vec3(1023.0)));
+
+    keysIn[triangle] = (expandBits(cell.x) << 2) | (expandBits(cell.y) << 1) | expandBits(cell.z);
+    valuesIn[triangle] = triangle;
+}
+)";
+
+// 4. Internal node i covers the range of sorted keys sharing the longest
+// prefix with key i; its split is where that prefix grows. Equal codes fall
+// back to their indices, so every key is distinct.
+const char* kHierarchySource = R"(
+layout(local_size_x = 256) in;
+
+int commonPrefix(int i, int j) {
+    if (j < 0 || j >= int(triangleCount)) return -1;
+    uint a = keysIn[i];
+    uint b = keysIn[j];
+    if (a == b) return 32 + 31 - findMSB(uint(i ^ j));
+    return 31 - findMSB(a ^ b);
+}
+
+void main() {
+    int i = int(gl_GlobalInvocationID.x);
+    if (i >= int(triangleCount) - 1) return;
+
+    // Direction of the range and its far end
+    int d = commonPrefix(i, i + 1) - commonPrefix(i, i - 1) >= 0 ? 1 : -1;
+    int minPrefix = commonPrefix(i, i - d);
+    int spanBound = 2;
+    while (commonPrefix(i, i + spanBound * d) > minPrefix) {
+        spanBound *= 2;
+    }
+    int span = 0;
+    for (int stride = spanBound / 2; stride >= 1; stride /= 2) {
+        if (commonPrefix(i, i + (span + stride) * d) > minPrefix) {
+            span += stride;
+        }
+    }
+    int j = i + span * d;
+
+    // Split: the last key that still shares the node's prefix with key i
+    int nodePrefix = commonPrefix(i, j);
+    int split = 0;
+    int stride = span;
+    do {
+        stride = (stride + 1) / 2;
+        if (commonPrefix(i, i + (split + stride) * d) > nodePrefix) {
+            split += stride;
+        }
+    } while (stride > 1);
+    int gamma = i + split * d + min(d, 0);
+
+    uint left = min(i, j) == gamma ? leafNode(uint(gamma)) : uint(gamma);
+    uint right = max(i, j) == gamma + 1 ? leafNode(uint(gamma + 1)) : uint(gamma + 1);
+    children[i] = uvec2(left, right);
+    parents[left] = uint(i);
+    parents[right] = uint(i);
+}
+)";
+
+// 5. Leaf bounds and triangles in sorted order, then up the tree. The first
+// thread to reach a node stops; the second has both children and goes on.
+const char* kRefitSource = R"(
+layout(local_size_x = 256) in;
+
+uniform uint triangleOffset;
+
+// Octahedral encoding, as RCS::octEncodeUnit (zero vector -> +Z)
+uint octEncode(vec3 n) {
+    float s = abs(n.x) + abs(n.y) + abs(n.z);
+    if (s == 0.0) return packSnorm2x16(vec2(0.0));
+    n /= s;
+    vec2 e = n.xy;
+    if (n.z < 0.0) {
+        e = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return packSnorm2x16(e);
+}
+
+void main() {
+    uint sortedIndex = gl_GlobalInvocationID.x;
+    if (sortedIndex >= triangleCount) return;
+
+    vec3 a, b, c;
+    trianglePositions(valuesIn[sortedIndex], a, b, c);
+    vec3 e1 = b - a;
+    vec3 e2 = c - a;
+    uint base = (triangleOffset + sortedIndex) * 3u;
+    triangles[base] = vec4(a, uintBitsToFloat(octEncode(cross(e1, e2))));
+    triangles[base + 1u] = vec4(e1, uintBitsToFloat(0u));  // Material 0
+    triangles[base + 2u] = vec4(e2, uintBitsToFloat(valuesIn[sortedIndex]));  // Source triangle
+
+    uint node = leafNode(sortedIndex);
+    nodeBounds[node * 2u] = vec4(min(a, min(b, c)), 0.0);
+    nodeBounds[node * 2u + 1u] = vec4(max(a, max(b, c)), 0.0);
+    subtreeSizes[node] = 1u;
+    memoryBarrierBuffer();
+
+    for (uint parent = parents[node]; parent != kNoParent; parent = parents[parent]) {
+        if (atomicAdd(visits[parent], 1u) == 0u) return;  // Sibling not done yet
+        memoryBarrierBuffer();
+
+        uvec2 child = children[parent];
+        nodeBounds[parent * 2u] = min(nodeBounds[child.x * 2u], nodeBounds[child.y * 2u]);
+        nodeBounds[parent * 2u + 1u] = max(nodeBounds[child.x * 2u + 1u], nodeBounds[child.y * 2u + 1u]);
+        subtreeSizes[parent] = 1u + subtreeSizes[child.x] + subtreeSizes[child.y];
+        memoryBarrierBuffer();
+    }
+}
+)";
+
+// 6. Depth-first index of each node: one for every ancestor, plus the left
+// sibling's subtree whenever the path turns right
+const char* kEmitSource = R"(
+layout(local_size_x = 256) in;
+
+uniform uint nodeOffset;
+
+void main() {
+    uint node = gl_GlobalInvocationID.x;
+    uint total = 2u * triangleCount - 1u;
+    if (node >= total) return;
+
+    uint index = 0u;
+    uint depth = 0u;
+    uint child = node;
+    for (uint parent = parents[node]; parent != kNoParent; parent = parents[parent]) {
+        uvec2 siblings = children[parent];
+        index += 1u + (siblings.y == child ? subtreeSizes[siblings.x] : 0u);
+        depth++;
+        child = parent;
+    }
+
+    vec3 lo = nodeBounds[node * 2u].xyz;
+    vec3 hi = nodeBounds[node * 2u + 1u].xyz;
+    BVHNode result;
+    if (node >= triangleCount - 1u) {
+        result.boundsMin = vec4(lo, -float(node - (triangleCount - 1u)) - 1.0);
+        result.boundsMax = vec4(hi, 1.0);
+        atomicMax(maxDepth, depth);
+    } else {
+        // Split axis: the one the child centers are furthest apart on
+        uvec2 pair = children[node];
+        vec3 gap = abs((nodeBounds[pair.y * 2u].xyz + nodeBounds[pair.y * 2u + 1u].xyz) -
+                       (nodeBounds[pair.x * 2u].xyz + nodeBounds[pair.x * 2u + 1u].xyz));
+        float axis = gap.x >= gap.y && gap.x >= gap.z ? 0.0 : (gap.y >= gap.z ? 1.0 : 2.0);
+        result.boundsMin = vec4(lo, axis);
+        result.boundsMax = vec4(hi, float(index + 1u + subtreeSizes[pair.x]));
+    }
+    nodes[nodeOffset + index] = result;
+
+    uint next = index + subtreeSizes[node];
+    skipLinks[nodeOffset + index] = next < total ? int(next) : -1;
+
+    if (node == 0u) {
+        rootMin = vec4(lo, 0.0);
+        rootMax = vec4(hi, 0.0);
+    }
+}
+)";
+
+} // namespace
+
+GPUBVHBuilder::~GPUBVHBuilder() {
+    // OpenGL cleanup should be done via cleanup() before context destruction
+}
+
+bool GPUBVHBuilder::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << "GPUBVHBuilder::initialize - No OpenGL context available";
+        return false;
+    }
+
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "GPUBVHBuilder: Failed to initialize OpenGL functions!";
+        return false;
+    }
+
+    if (!compileKernel(boundsKernel_, "bounds", kBoundsSource) ||
+        !compileKernel(mortonKernel_, "Morton code", kMortonSource) ||
+        !compileKernel(hierarchyKernel_, "hierarchy", kHierarchySource) ||
+        !compileKernel(refitKernel_, "refit", kRefitSource) ||
+        !compileKernel(emitKernel_, "emit", kEmitSource) ||
+        !sort_.initialize()) {
+        return false;
+    }
+
+    glGenBuffers(1, &centroidBoundsBuffer_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, centroidBoundsBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, 6 * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    GLUtils::checkGLError("GPUBVHBuilder::initialize");
+
+    initialized_ = true;
+    return true;
+}
+
+void GPUBVHBuilder::cleanup() {
+    if (!QOpenGLContext::currentContext()) {
+        initialized_ = false;
+        return;
+    }
+
+    deleteScratch();
+    sort_.cleanup();
+    if (centroidBoundsBuffer_) {
+        glDeleteBuffers(1, &centroidBoundsBuffer_);
+        centroidBoundsBuffer_ = 0;
+    }
+    boundsKernel_.reset();
+    mortonKernel_.reset();
+    hierarchyKernel_.reset();
+    refitKernel_.reset();
+    emitKernel_.reset();
+    initialized_ = false;
+}
+
+bool GPUBVHBuilder::compileKernel(std::unique_ptr<QOpenGLShaderProgram>& program,
+                                  const char* name, const char* source) {
+    const std::string code = std::string(kCommonSource) + source;
+    program = std::make_unique<QOpenGLShaderProgram>();
+    if (!program->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, code.c_str())) {
+        qWarning() << "GPUBVHBuilder: Failed to compile" << name << "kernel:" << program->log();
+        program.reset();
+        return false;
+    }
+    if (!program->link()) {
+        qWarning() << "GPUBVHBuilder: Failed to link" << name << "kernel:" << program->log();
+        program.reset();
+        return false;
+    }
+    return true;
+}
+
+bool GPUBVHBuilder::reserveScratch(int triangleCount) {
+    if (triangleCount <= scratchTriangles_) {
+        return true;
+    }
+    deleteScratch();
+
+    const GLsizeiptr n = triangleCount;
+    const GLsizeiptr nodes = nodeCount(triangleCount);
+    auto create = [this](GLuint& buffer, GLsizeiptr bytes) {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<GLsizeiptr>(bytes, 16), nullptr, GL_DYNAMIC_DRAW);
+    };
+    create(childBuffer_, (n - 1) * 2 * sizeof(GLuint));
+    create(parentBuffer_, nodes * sizeof(GLuint));
+    create(nodeBoundsBuffer_, nodes * 8 * sizeof(GLfloat));
+    create(subtreeSizeBuffer_, nodes * sizeof(GLuint));
+    create(visitBuffer_, (n - 1) * sizeof(GLuint));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    if (RS::GPUMemory::checkAllocation("GPUBVHBuilder scratch buffers") || !sort_.reserve(triangleCount)) {
+        deleteScratch();
+        return false;
+    }
+    scratchTriangles_ = triangleCount;
+    scratchMemory_.resize(static_cast<uint64_t>(n - 1) * 3 * sizeof(GLuint) +
+                          static_cast<uint64_t>(nodes) * (2 + 8) * sizeof(GLuint));
+    return true;
+}
+
+void GPUBVHBuilder::deleteScratch() {
+    GLuint* buffers[] = {&childBuffer_, &parentBuffer_, &nodeBoundsBuffer_, &subtreeSizeBuffer_,
+                         &visitBuffer_};
+    for (GLuint* buffer : buffers) {
+        if (*buffer) {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    scratchTriangles_ = 0;
+    scratchMemory_.release();
+}
+
+bool GPUBVHBuilder::build(GLuint vertexBuffer, GLuint indexBuffer, int triangleCount,
+                          GLuint nodeBuffer, GLuint skipBuffer, int nodeOffset,
+                          GLuint triangleBuffer, int triangleOffset, GLuint statsBuffer) {
+    if (!initialized_ || triangleCount <= 0) {
+        return false;
+    }
+    if (triangleCount > kGPUBVHMaxTriangles) {
+        qWarning() << "GPUBVHBuilder::build -" << triangleCount << "triangles exceeds kGPUBVHMaxTriangles ("
+                   << kGPUBVHMaxTriangles << ")";
+        return false;
+    }
+    if (!reserveScratch(triangleCount)) {
+        return false;
+    }
+
+    const GLuint n = static_cast<GLuint>(triangleCount);
+    auto setCount = [n](QOpenGLShaderProgram* kernel) {
+        kernel->bind();
+        kernel->setUniformValue("triangleCount", n);
+    };
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, indexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, centroidBoundsBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, childBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, parentBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, nodeBoundsBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, subtreeSizeBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 12, visitBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 13, nodeBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 14, skipBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 15, triangleBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 16, statsBuffer);
+
+    // Empty centroid bounds, no visits, no parent above the root, depth 0
+    const GLuint emptyBounds[6] = {0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0u, 0u, 0u};
+    const GLuint noParent = 0xFFFFFFFFu;
+    const GLuint zero = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, centroidBoundsBuffer_);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyBounds), emptyBounds);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, visitBuffer_);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, parentBuffer_);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, sizeof(GLuint),
+                         GL_RED_INTEGER, GL_UNSIGNED_INT, &noParent);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, statsBuffer);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 8 * sizeof(GLfloat), sizeof(GLuint),
+                         GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    // 1-2. Centroid bounds, then Morton codes into the sort's buffers
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, sort_.keyBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, sort_.valueBuffer());
+    setCount(boundsKernel_.get());
+    glDispatchCompute(groups(triangleCount, kGroupSize), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    setCount(mortonKernel_.get());
+    glDispatchCompute(groups(triangleCount, kGroupSize), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // 3. Sort, which borrows bindings 0-4; put the build's back
+    sort_.sort(triangleCount, kMortonBits);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, indexBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, sort_.keyBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, sort_.valueBuffer());
+
+    // 4-5. Hierarchy, then bounds and sizes bottom-up (a lone triangle is the root leaf)
+    if (triangleCount > 1) {
+        setCount(hierarchyKernel_.get());
+        glDispatchCompute(groups(triangleCount - 1, kGroupSize), 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+    setCount(refitKernel_.get());
+    refitKernel_->setUniformValue("triangleOffset", static_cast<GLuint>(triangleOffset));
+    glDispatchCompute(groups(triangleCount, kGroupSize), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // 6. Depth-first placement into the shared buffers
+    setCount(emitKernel_.get());
+    emitKernel_->setUniformValue("nodeOffset", static_cast<GLuint>(nodeOffset));
+    glDispatchCompute(groups(nodeCount(triangleCount), kGroupSize), 1, 1);
+    emitKernel_->release();
+
+    for (GLuint binding = 0; binding <= 16; ++binding) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+    }
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+    GLUtils::checkGLError("GPUBVHBuilder::build");
+    return true;
+}
+
+} // namespace RCS
@@ -0,0 +1,82 @@
+// GPUBVHBuilder.h - Linear BVH construction in compute shaders
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QOpenGLShaderProgram>
+#include <memory>
+
+#include "GPUMemory.h"
+#include "GPURadixSort.h"
+
+namespace RCS {
+
+// Builds a bottom-level BVH from geometry that is already in GPU buffers,
+// without reading anything back (Karras, "Maximizing Parallelism in the
+// Construction of BVHs, Octrees, and k-d Trees"):
+//
+//   1. Reduce the triangle centroids to their bounds
+//   2. Give each triangle the 30-bit Morton code of its centroid
+//   3. Radix sort the codes (GPURadixSort)
+//   4. Emit every internal node independently from the sorted codes
+//   5. Walk up from the leaves, merging child bounds and subtree sizes; the
+//      second thread to reach a node finishes it
+//   6. Place every node at its depth-first index and write BVHNode, skip
+//      link and triangle data straight into RCSCompute's shared buffers
+//
+// The output is the binary layout BVHBuilder produces (left child next,
+// right child and split axis in w), so traversal does not change. Leaves hold
+// one triangle each and splits follow the Morton order rather than SAH, so the
+// tree traces slower than BVHBuilder's but builds in milliseconds. It runs on
+// the GL thread that owns the buffers.
+class GPUBVHBuilder : protected QOpenGLFunctions_4_5_Core {
+public:
+    GPUBVHBuilder() = default;
+    ~GPUBVHBuilder();
+
+    // Compiles the kernels; call with the context current
+    bool initialize();
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Nodes (and skip links) a build of triangleCount triangles writes
+    static int nodeCount(int triangleCount) { return triangleCount > 0 ? 2 * triangleCount - 1 : 0; }
+
+    // vertexBuffer: [x,y,z,nx,ny,nz] per vertex, as RCSCompute::setMeshGeometry
+    // takes; indexBuffer: three uint indices per triangle. Writes nodeCount()
+    // BVHNodes and skip links from nodeOffset and triangleCount Triangles
+    // (material 0) from triangleOffset; links and leaf ranges are relative to
+    // those offsets like an uploaded BVHSnapshot. statsBuffer receives the
+    // root bounds (two vec4s) and the maximum leaf depth (a uint after them).
+    // Returns false if the kernels are unavailable or the mesh is too large
+    // for the node encoding; nothing is written then.
+    bool build(GLuint vertexBuffer, GLuint indexBuffer, int triangleCount,
+               GLuint nodeBuffer, GLuint skipBuffer, int nodeOffset,
+               GLuint triangleBuffer, int triangleOffset, GLuint statsBuffer);
+
+private:
+    bool compileKernel(std::unique_ptr<QOpenGLShaderProgram>& program, const char* name, const char* source);
+    bool reserveScratch(int triangleCount);
+    void deleteScratch();
+    static GLuint groups(int count, int groupSize) { return static_cast<GLuint>((count + groupSize - 1) / groupSize); }
+
+    bool initialized_ = false;
+
+    std::unique_ptr<QOpenGLShaderProgram> boundsKernel_;
+    std::unique_ptr<QOpenGLShaderProgram> mortonKernel_;
+    std::unique_ptr<QOpenGLShaderProgram> hierarchyKernel_;
+    std::unique_ptr<QOpenGLShaderProgram> refitKernel_;
+    std::unique_ptr<QOpenGLShaderProgram> emitKernel_;
+
+    // Scratch, grown to the largest mesh built so far
+    GLuint centroidBoundsBuffer_ = 0;
+    GPURadixSort sort_{RS::GPUMemoryPool::RCSScene};  // Morton code, triangle index pairs
+    GLuint childBuffer_ = 0;                       // uvec2 per internal node
+    GLuint parentBuffer_ = 0;                      // Per node, ~0u at the root
+    GLuint nodeBoundsBuffer_ = 0;                  // vec4 min, vec4 max per node
+    GLuint subtreeSizeBuffer_ = 0;                 // Nodes under each node, itself included
+    GLuint visitBuffer_ = 0;                       // Per internal node: children finished
+    int scratchTriangles_ = 0;
+    RS::GPUAllocation scratchMemory_{RS::GPUMemoryPool::RCSScene};
+};
+
+} // namespace RCS
@@ -0,0 +1,273 @@
+// GPURadixSort.cpp - Stable key/value radix sort in compute shaders
+#include "GPURadixSort.h"
+#include "GLUtils.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+#include <string>
+
+namespace RCS {
+
+namespace {
+
+constexpr int kBlockSize = 128;  // Keys per block; ranks fit a byte per digit
+constexpr int kRadixBits = 4;
+constexpr int kRadixDigits = 1 << kRadixBits;
+
+const char* kCommonSource = R"(
+#version 430 core
+
+layout(std430, binding = 0) buffer KeysIn { uint keysIn[]; };
+layout(std430, binding = 1) buffer ValuesIn { uint valuesIn[]; };
+layout(std430, binding = 2) buffer KeysOut { uint keysOut[]; };
+layout(std430, binding = 3) buffer ValuesOut { uint valuesOut[]; };
+layout(std430, binding = 4) buffer Histogram { uint histogram[]; };
+
+uniform uint keyCount;
+)";
+
+// Digit histogram of each block of 128 keys, stored digit-major so one
+// exclusive scan turns it into every block's scatter base per digit
+const char* kCountSource = R"(
+layout(local_size_x = 128) in;
+
+uniform uint shift;
+
+shared uint sCounts[16];
+
+void main() {
+    uint lane = gl_LocalInvocationID.x;
+    if (lane < 16u) sCounts[lane] = 0u;
+    barrier();
+    uint index = gl_GlobalInvocationID.x;
+    if (index < keyCount) {
+        atomicAdd(sCounts[(keysIn[index] >> shift) & 15u], 1u);
+    }
+    barrier();
+    if (lane < 16u) {
+        histogram[lane * gl_NumWorkGroups.x + gl_WorkGroupID.x] = sCounts[lane];
+    }
+}
+)";
+
+// In-place exclusive scan of the histogram, one group walking it in chunks
+const char* kScanSource = R"(
+layout(local_size_x = 1024) in;
+
+uniform uint scanCount;
+
+shared uint sScan[1024];
+
+void main() {
+    uint lane = gl_LocalInvocationID.x;
+    uint carry = 0u;
+    for (uint base = 0u; base < scanCount; base += 1024u) {
+        uint index = base + lane;
+        uint value = index < scanCount ? histogram[index] : 0u;
+        sScan[lane] = value;
+        barrier();
+        for (uint offset = 1u; offset < 1024u; offset <<= 1u) {
+            uint add = lane >= offset ? sScan[lane - offset] : 0u;
+            barrier();
+            sScan[lane] += add;
+            barrier();
+        }
+        if (index < scanCount) {
+            histogram[index] = carry + sScan[lane] - value;
+        }
+        carry += sScan[1023];
+        barrier();
+    }
+}
+)";
+
+// Stable scatter. Each key's rank among equal digits in its block comes from
+// one scan of packed counters: a byte per digit, four digits per lane of a
+// uvec4, which cannot carry with 128 keys per block.
+const char* kScatterSource = R"(
+layout(local_size_x = 128) in;
+
+uniform uint shift;
+
+shared uvec4 sRanks[128];
+
+void main() {
+    uint lane = gl_LocalInvocationID.x;
+    uint index = gl_GlobalInvocationID.x;
+    bool valid = index < keyCount;
+    uint key = valid ? keysIn[index] : 0u;
+    uint digit = (key >> shift) & 15u;
+    uint byteShift = (digit & 3u) * 8u;
+
+    uvec4 counter = uvec4(0u);
+    if (valid) counter[digit >> 2] = 1u << byteShift;
+    sRanks[lane] = counter;
+    barrier();
+    for (uint offset = 1u; offset < 128u; offset <<= 1u) {
+        uvec4 add = lane >= offset ? sRanks[lane - offset] : uvec4(0u);
+        barrier();
+        sRanks[lane] += add;
+        barrier();
+    }
+
+    if (valid) {
+        uint rank = ((sRanks[lane][digit >> 2] >> byteShift) & 0xFFu) - 1u;
+        uint target = histogram[digit * gl_NumWorkGroups.x + gl_WorkGroupID.x] + rank;
+        keysOut[target] = key;
+        valuesOut[target] = valuesIn[index];
+    }
+}
+)";
+
+GLuint blocks(int count) {
+    return static_cast<GLuint>((count + kBlockSize - 1) / kBlockSize);
+}
+
+} // namespace
+
+GPURadixSort::~GPURadixSort() {
+    // OpenGL cleanup should be done via cleanup() before context destruction
+}
+
+bool GPURadixSort::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    if (!QOpenGLContext::currentContext()) {
+        qWarning() << "GPURadixSort::initialize - No OpenGL context available";
+        return false;
+    }
+
+    if (!initializeOpenGLFunctions()) {
+        qCritical() << "GPURadixSort: Failed to initialize OpenGL functions!";
+        return false;
+    }
+
+    if (!compileKernel(countKernel_, "count", kCountSource) ||
+        !compileKernel(scanKernel_, "scan", kScanSource) ||
+        !compileKernel(scatterKernel_, "scatter", kScatterSource)) {
+        return false;
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+void GPURadixSort::cleanup() {
+    if (!QOpenGLContext::currentContext()) {
+        initialized_ = false;
+        return;
+    }
+
+    deleteBuffers();
+    countKernel_.reset();
+    scanKernel_.reset();
+    scatterKernel_.reset();
+    initialized_ = false;
+}
+
+bool GPURadixSort::compileKernel(std::unique_ptr<QOpenGLShaderProgram>& program,
+                                 const char* name, const char* source) {
+    const std::string code = std::string(kCommonSource) + source;
+    program = std::make_unique<QOpenGLShaderProgram>();
+    if (!program->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, code.c_str())) {
+        qWarning() << "GPURadixSort: Failed to compile" << name << "kernel:" << program->log();
+        program.reset();
+        return false;
+    }
+    if (!program->link()) {
+        qWarning() << "GPURadixSort: Failed to link" << name << "kernel:" << program->log();
+        program.reset();
+        return false;
+    }
+    return true;
+}
+
+bool GPURadixSort::reserve(int count) {
+    if (count <= capacity_) {
+        return true;
+    }
+    deleteBuffers();
+
+    const GLsizeiptr n = count;
+    const GLsizeiptr histogram = static_cast<GLsizeiptr>(blocks(count)) * kRadixDigits;
+    auto create = [this](GLuint& buffer, GLsizeiptr bytes) {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<GLsizeiptr>(bytes, 16), nullptr, GL_DYNAMIC_DRAW);
+    };
+    for (int i = 0; i < 2; ++i) {
+        create(keyBuffers_[i], n * sizeof(GLuint));
+        create(valueBuffers_[i], n * sizeof(GLuint));
+    }
+    create(histogramBuffer_, histogram * sizeof(GLuint));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    if (RS::GPUMemory::checkAllocation("GPURadixSort buffers")) {
+        deleteBuffers();
+        return false;
+    }
+    capacity_ = count;
+    scratchMemory_.resize(static_cast<uint64_t>(n * 4 + histogram) * sizeof(GLuint));
+    return true;
+}
+
+void GPURadixSort::deleteBuffers() {
+    GLuint* buffers[] = {&keyBuffers_[0], &keyBuffers_[1], &valueBuffers_[0], &valueBuffers_[1],
+                         &histogramBuffer_};
+    for (GLuint* buffer : buffers) {
+        if (*buffer) {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    capacity_ = 0;
+    scratchMemory_.release();
+}
+
+void GPURadixSort::sort(int count, int keyBits) {
+    if (!initialized_ || count <= 1 || count > capacity_ || keyBits <= 0) {
+        return;
+    }
+
+    const GLuint n = static_cast<GLuint>(count);
+    const GLuint sortBlocks = blocks(count);
+    int passes = (std::min(keyBits, 32) + kRadixBits - 1) / kRadixBits;
+    passes += passes % 2;
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, histogramBuffer_);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    for (int pass = 0; pass < passes; ++pass) {
+        const int in = pass % 2;
+        const GLuint shift = static_cast<GLuint>(pass * kRadixBits);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, keyBuffers_[in]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, valueBuffers_[in]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, keyBuffers_[1 - in]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, valueBuffers_[1 - in]);
+
+        countKernel_->bind();
+        countKernel_->setUniformValue("keyCount", n);
+        countKernel_->setUniformValue("shift", shift);
+        glDispatchCompute(sortBlocks, 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        scanKernel_->bind();
+        scanKernel_->setUniformValue("scanCount", sortBlocks * kRadixDigits);
+        glDispatchCompute(1, 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+        scatterKernel_->bind();
+        scatterKernel_->setUniformValue("keyCount", n);
+        scatterKernel_->setUniformValue("shift", shift);
+        glDispatchCompute(sortBlocks, 1, 1);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+    scatterKernel_->release();
+
+    for (GLuint binding = 0; binding <= 4; ++binding) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+    }
+}
+
+} // namespace RCS
@@ -0,0 +1,57 @@
+// GPURadixSort.h - Stable key/value radix sort in compute shaders
+#pragma once
+
+#include <QOpenGLFunctions_4_5_Core>
+#include <QOpenGLShaderProgram>
+#include <array>
+#include <memory>
+
+#include "GPUMemory.h"
+
+namespace RCS {
+
+// Sorts uint keys with a uint value each, four bits per pass: a digit
+// histogram per block of 128 keys, one exclusive scan of all histograms, then
+// a stable scatter. Shared by GPUBVHBuilder (Morton codes) and RCSCompute's
+// ray reordering. Callers write the pairs into keyBuffer()/valueBuffer(),
+// which hold the sorted result afterwards.
+class GPURadixSort : protected QOpenGLFunctions_4_5_Core {
+public:
+    explicit GPURadixSort(RS::GPUMemoryPool pool) : scratchMemory_(pool) {}
+    ~GPURadixSort();
+
+    // Compiles the kernels; call with the context current
+    bool initialize();
+    void cleanup();
+    bool isInitialized() const { return initialized_; }
+
+    // Grows the buffers to hold count pairs. Contents are lost when they grow.
+    bool reserve(int count);
+    int capacity() const { return capacity_; }
+
+    GLuint keyBuffer() const { return keyBuffers_[0]; }
+    GLuint valueBuffer() const { return valueBuffers_[0]; }
+
+    // Sorts the first count pairs by the low keyBits bits of their keys. The
+    // pass count is rounded up to even so the result lands back in the first
+    // buffers, visible to shader storage reads. Leaves bindings 0-4 unbound.
+    void sort(int count, int keyBits);
+
+private:
+    bool compileKernel(std::unique_ptr<QOpenGLShaderProgram>& program, const char* name, const char* source);
+    void deleteBuffers();
+
+    bool initialized_ = false;
+
+    std::unique_ptr<QOpenGLShaderProgram> countKernel_;
+    std::unique_ptr<QOpenGLShaderProgram> scanKernel_;
+    std::unique_ptr<QOpenGLShaderProgram> scatterKernel_;
+
+    std::array<GLuint, 2> keyBuffers_ = {0, 0};    // Ping-ponged between passes
+    std::array<GLuint, 2> valueBuffers_ = {0, 0};
+    GLuint histogramBuffer_ = 0;                   // 16 digit counts per block, digit-major
+    int capacity_ = 0;
+    RS::GPUAllocation scratchMemory_;
+};
+
+} // namespace RCS
@@ -0,0 +1,516 @@
+// RCSAutomationServer.cpp - Line-delimited JSON control of headless RCS jobs over stdio
+#include "RCSAutomationServer.h"
+#include "MeshImporter.h"
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+// [x, y, z]; false on anything else
+bool readVector(const QJsonValue& value, QVector3D& vector) {
+    QJsonArray array = value.toArray();
+    if (array.size() != 3 || !array[0].isDouble() || !array[1].isDouble() || !array[2].isDouble()) {
+        return false;
+    }
+    vector = QVector3D(array[0].toDouble(), array[1].toDouble(), array[2].toDouble());
+    return true;
+}
+
+// [start, end, step] with a positive step, as --azimuth/--elevation
+bool readRange(const QJsonValue& value, float& start, float& end, float& step) {
+    QVector3D range;
+    if (!readVector(value, range) || range.z() <= 0.0f) {
+        return false;
+    }
+    start = range.x();
+    end = range.y();
+    step = range.z();
+    return true;
+}
+
+QJsonArray cutToJson(const std::vector<RCSDataPoint>& cut) {
+    QJsonArray array;
+    for (const RCSDataPoint& point : cut) {
+        array.append(point.dBsm);
+    }
+    return array;
+}
+
+// Names set_target accepts
+const char* targetTypeName(WireframeType type) {
+    switch (type) {
+    case WireframeType::Cylinder: return "cylinder";
+    case WireframeType::Aircraft: return "aircraft";
+    case WireframeType::Sphere: return "sphere";
+    case WireframeType::Plate: return "plate";
+    case WireframeType::Dihedral: return "dihedral";
+    case WireframeType::Trihedral: return "trihedral";
+    default: return "cube";
+    }
+}
+
+} // namespace
+
+RCSAutomationServer::RCSAutomationServer(QObject* parent)
+    : QObject(parent)
+{
+}
+
+RCSAutomationServer::~RCSAutomationServer() {
+    if (reader_.joinable()) {
+        // A reader still blocked on stdin cannot be woken; the process is exiting
+        if (readerDone_) {
+            reader_.join();
+        } else {
+            reader_.detach();
+        }
+    }
+}
+
+bool RCSAutomationServer::initialize(SweepBackend backend) {
+    return runner_.initialize(backend);
+}
+
+void RCSAutomationServer::start() {
+    if (reader_.joinable()) {
+        return;
+    }
+    reader_ = std::thread(&RCSAutomationServer::readLoop, this);
+}
+
+void RCSAutomationServer::readLoop() {
+    std::string text;
+    while (std::getline(std::cin, text)) {
+        QByteArray line = QByteArray::fromStdString(text).trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        // cancel cannot wait behind the sweep it is meant to stop. Every
+        // request carries the cancel generation it was read in, so a cancel
+        // also stops sweeps read before it that have not started yet.
+        QString method = QJsonDocument::fromJson(line).object().value("method").toString();
+        uint64_t generation = runner_.cancelGeneration();
+        if (method == "cancel") {
+            runner_.cancel();
+        }
+        QMetaObject::invokeMethod(this, [this, line, generation]() {
+            requestGeneration_ = generation;
+            handleLine(line);
+        }, Qt::QueuedConnection);
+        if (method == "shutdown") {
+            readerDone_ = true;
+            return;
+        }
+    }
+
+    // End of input: finish what is queued, then quit
+    QMetaObject::invokeMethod(this, []() { QCoreApplication::quit(); }, Qt::QueuedConnection);
+    readerDone_ = true;
+}
+
+void RCSAutomationServer::handleLine(const QByteArray& line) {
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        reply(QJsonValue(), QJsonValue(), "Request is not a JSON object: " + parseError.errorString());
+        return;
+    }
+
+    QJsonObject request = doc.object();
+    QString method = request.value("method").toString();
+    QString error;
+    QJsonValue result = dispatch(method, request.value("params").toObject(), error);
+    reply(request.value("id"), result, error);
+
+    if (method == "shutdown") {
+        QCoreApplication::quit();
+    }
+}
+
+QJsonValue RCSAutomationServer::dispatch(const QString& method, const QJsonObject& params, QString& error) {
+    if (method == "set_radar") {
+        return setRadar(params, error) ? QJsonValue(state()) : QJsonValue();
+    }
+    if (method == "set_target") {
+        return setTarget(params, error) ? QJsonValue(state()) : QJsonValue();
+    }
+    if (method == "set_beam") {
+        return setBeam(params, error) ? QJsonValue(state()) : QJsonValue();
+    }
+    if (method == "set_trace") {
+        return setTrace(params, error) ? QJsonValue(state()) : QJsonValue();
+    }
+    if (method == "trace") {
+        return trace(error);
+    }
+    if (method == "sweep") {
+        return sweep(params, error);
+    }
+    if (method == "get_state") {
+        return state();
+    }
+    if (method == "cancel" || method == "shutdown") {
+        return QJsonObject();  // cancel already acted on when it was read
+    }
+    error = "Unknown method: " + method;
+    return QJsonValue();
+}
+
+bool RCSAutomationServer::setRadar(const QJsonObject& params, QString& error) {
+    if (params.contains("radius")) {
+        float radius = static_cast<float>(params.value("radius").toDouble());
+        if (radius <= 0.0f) {
+            error = "radius must be positive";
+            return false;
+        }
+        config_.sphereRadius = radius;
+    }
+    if (params.contains("azimuth")) {
+        radarAzimuth_ = static_cast<float>(params.value("azimuth").toDouble());
+    }
+    if (params.contains("elevation")) {
+        radarElevation_ = std::clamp(static_cast<float>(params.value("elevation").toDouble()), -90.0f, 90.0f);
+    }
+    return true;
+}
+
+bool RCSAutomationServer::setTarget(const QJsonObject& params, QString& error) {
+    // Validate everything before changing anything
+    SweepConfig next = config_;
+    if (params.contains("type")) {
+        QString type = params.value("type").toString();
+        QString name = type.toLower();
+        next.meshPath.clear();
+        if (MeshImporter::isSupportedFile(name)) {
+            next.meshPath = type;
+        } else if (name == "cube") {
+            next.targetType = WireframeType::Cube;
+        } else if (name == "cylinder") {
+            next.targetType = WireframeType::Cylinder;
+        } else if (name == "aircraft") {
+            next.targetType = WireframeType::Aircraft;
+        } else if (name == "sphere") {
+            next.targetType = WireframeType::Sphere;
+        } else if (name == "plate") {
+            next.targetType = WireframeType::Plate;
+        } else if (name == "dihedral") {
+            next.targetType = WireframeType::Dihedral;
+        } else if (name == "trihedral") {
+            next.targetType = WireframeType::Trihedral;
+        } else {
+            error = "Unknown target type: " + type;
+            return false;
+        }
+    }
+    if (params.contains("position") && !readVector(params.value("position"), next.targetPosition)) {
+        error = "position must be [x, y, z]";
+        return false;
+    }
+    if (params.contains("rotation") && !readVector(params.value("rotation"), next.targetRotation)) {
+        error = "rotation must be [pitch, yaw, roll]";
+        return false;
+    }
+    if (params.contains("scale")) {
+        next.targetScale = static_cast<float>(params.value("scale").toDouble());
+        if (next.targetScale <= 0.0f) {
+            error = "scale must be positive";
+            return false;
+        }
+    }
+    if (params.contains("formation")) {
+        next.formationCount = params.value("formation").toInt();
+        if (next.formationCount < 1) {
+            error = "formation must be at least 1";
+            return false;
+        }
+    }
+    if (params.contains("formationSpacing")) {
+        next.formationSpacing = static_cast<float>(params.value("formationSpacing").toDouble());
+    }
+    if (params.contains("cache")) {
+        next.useTargetCache = params.value("cache").toBool();
+    }
+    if (params.contains("analytic")) {
+        next.analytic = params.value("analytic").toBool();
+    }
+    config_ = next;
+    return true;
+}
+
+bool RCSAutomationServer::setBeam(const QJsonObject& params, QString& error) {
+    // The backends trace a uniform cone; the other beam types only change
+    // how the interactive view draws the beam
+    if (params.contains("type") && params.value("type").toString().toLower() != "conical") {
+        error = "Only the conical beam is traced headless";
+        return false;
+    }
+    if (params.contains("width")) {
+        float width = static_cast<float>(params.value("width").toDouble());
+        if (width <= 0.0f || width >= 180.0f) {
+            error = "width must be between 0 and 180 degrees";
+            return false;
+        }
+        config_.beamWidthDegrees = width;
+    }
+    return true;
+}
+
+bool RCSAutomationServer::setTrace(const QJsonObject& params, QString& error) {
+    SweepConfig next = config_;
+    if (params.contains("rays")) {
+        next.numRays = params.value("rays").toInt();
+        if (next.numRays < 1) {
+            error = "rays must be at least 1";
+            return false;
+        }
+    }
+    if (params.contains("bounces")) {
+        next.maxBounces = params.value("bounces").toInt();
+        if (next.maxBounces < 1) {
+            error = "bounces must be at least 1";
+            return false;
+        }
+    }
+    if (params.contains("bounceCutoff")) {
+        next.bounceCutoff = static_cast<float>(params.value("bounceCutoff").toDouble());
+        if (next.bounceCutoff < 0.0f) {
+            error = "bounceCutoff must not be negative";
+            return false;
+        }
+    }
+    if (params.contains("roulette")) {
+        next.rouletteThreshold = static_cast<float>(params.value("roulette").toDouble());
+        if (next.rouletteThreshold < 0.0f) {
+            error = "roulette must not be negative";
+            return false;
+        }
+    }
+    if (params.contains("sampling")) {
+        QString sampling = params.value("sampling").toString().toLower();
+        if (sampling == "rings") {
+            next.sampling = RaySampling::Rings;
+        } else if (sampling == "fibonacci") {
+            next.sampling = RaySampling::Fibonacci;
+        } else if (sampling == "sobol") {
+            next.sampling = RaySampling::Sobol;
+        } else {
+            error = "Unknown ray sampling: " + sampling;
+            return false;
+        }
+    }
+    if (params.contains("sliceThickness")) {
+        next.sliceThicknessDegrees = static_cast<float>(params.value("sliceThickness").toDouble());
+        if (next.sliceThicknessDegrees <= 0.0f) {
+            error = "sliceThickness must be positive";
+            return false;
+        }
+    }
+    if (params.contains("traversal")) {
+        QString traversal = params.value("traversal").toString().toLower();
+        if (traversal == "stack") {
+            next.traversal = TraversalMode::Stack;
+        } else if (traversal == "stackless") {
+            next.traversal = TraversalMode::Stackless;
+        } else {
+            error = "Unknown traversal mode: " + traversal;
+            return false;
+        }
+    }
+    if (params.contains("bvh")) {
+        QString layout = params.value("bvh").toString().toLower();
+        if (layout == "binary") {
+            next.bvhLayout = BVHLayout::Binary;
+        } else if (layout == "wide4") {
+            next.bvhLayout = BVHLayout::Wide4;
+        } else {
+            error = "Unknown BVH layout: " + layout;
+            return false;
+        }
+    }
+    if (params.contains("bvhBuild")) {
+        QString build = params.value("bvhBuild").toString().toLower();
+        if (build == "cpu") {
+            next.bvhBuild = BVHBuild::CPU;
+        } else if (build == "gpu") {
+            next.bvhBuild = BVHBuild::GPU;
+        } else {
+            error = "Unknown BVH build: " + build;
+            return false;
+        }
+    }
+    if (params.contains("triangles")) {
+        QString precision = params.value("triangles").toString().toLower();
+        if (precision == "full") {
+            next.trianglePrecision = TrianglePrecision::Full;
+        } else if (precision == "compact") {
+            next.trianglePrecision = TrianglePrecision::Compact;
+        } else {
+            error = "Unknown triangle precision: " + precision;
+            return false;
+        }
+    }
+    if (params.contains("reorder")) {
+        next.rayReordering = params.value("reorder").toBool();
+    }
+    if (params.contains("persistentThreads")) {
+        next.persistentThreads = params.value("persistentThreads").toBool();
+    }
+    if (params.contains("normalCones")) {
+        next.normalConeCulling = params.value("normalCones").toBool();
+    }
+    if (params.contains("temporalReuse")) {
+        next.temporalReuse = params.value("temporalReuse").toBool();
+    }
+    if (params.contains("threads")) {
+        next.cpuThreads = std::max(params.value("threads").toInt(), 0);
+    }
+    if (params.contains("materials")) {
+        next.materials.clear();
+        for (const QJsonValue& value : params.value("materials").toArray()) {
+            QString name = value.toString().toLower();
+            if (!findMaterialPreset(name.toUtf8().constData())) {
+                error = "Unknown material: " + name;
+                return false;
+            }
+            next.materials << name;
+        }
+    }
+    config_ = next;
+    return true;
+}
+
+QJsonValue RCSAutomationServer::trace(QString& error) {
+    // A sweep of one look
+    SweepConfig look = config_;
+    look.azimuthStart = look.azimuthEnd = radarAzimuth_;
+    look.elevationStart = look.elevationEnd = radarElevation_;
+
+    QJsonObject result;
+    bool ok = runner_.run(look, [&result](float azimuth, float elevation, const LookCut& cut) {
+        result["azimuth"] = azimuth;
+        result["elevation"] = elevation;
+        result["hits"] = cut.hitCount;
+        result["monostatic"] = cut.cut[RCSSweepRunner::monostaticBin(azimuth)].dBsm;
+        result["cut"] = cutToJson(cut.cut);
+    }, requestGeneration_);
+    if (!ok) {
+        error = "Trace failed or was cancelled";
+        return QJsonValue();
+    }
+    result["rays"] = runner_.getRaysPerLook();
+    return result;
+}
+
+QJsonValue RCSAutomationServer::sweep(const QJsonObject& params, QString& error) {
+    SweepConfig sweep = config_;
+    if (params.contains("azimuth") &&
+        !readRange(params.value("azimuth"), sweep.azimuthStart, sweep.azimuthEnd, sweep.azimuthStep)) {
+        error = "azimuth must be [start, end, step] with a positive step";
+        return QJsonValue();
+    }
+    if (params.contains("elevation") &&
+        !readRange(params.value("elevation"), sweep.elevationStart, sweep.elevationEnd, sweep.elevationStep)) {
+        error = "elevation must be [start, end, step] with a positive step";
+        return QJsonValue();
+    }
+    sweep.writeFullCut = params.value("fullCut").toBool(false);
+
+    QJsonObject result;
+    sweep.outputPath = params.value("output").toString();
+    if (!sweep.outputPath.isEmpty()) {
+        sweep.compressOutput = params.value("compress").toBool(false);
+        if (!runner_.run(sweep, requestGeneration_)) {
+            error = "Sweep to " + sweep.outputPath + " failed or was cancelled";
+            return QJsonValue();
+        }
+        result["output"] = sweep.outputPath;
+        result["looks"] = RCSSweepRunner::azimuthCount(sweep) * RCSSweepRunner::elevationCount(sweep);
+    } else {
+        QJsonArray looks;
+        bool ok = runner_.run(sweep, [&looks, &sweep](float azimuth, float elevation, const LookCut& cut) {
+            QJsonObject look;
+            look["azimuth"] = azimuth;
+            look["elevation"] = elevation;
+            look["hits"] = cut.hitCount;
+            look["monostatic"] = cut.cut[RCSSweepRunner::monostaticBin(azimuth)].dBsm;
+            if (sweep.writeFullCut) {
+                look["cut"] = cutToJson(cut.cut);
+            }
+            looks.append(look);
+        }, requestGeneration_);
+        if (!ok) {
+            error = "Sweep failed or was cancelled";
+            return QJsonValue();
+        }
+        result["looks"] = looks;
+    }
+    result["rays"] = runner_.getRaysPerLook();
+    return result;
+}
+
+QJsonObject RCSAutomationServer::state() const {
+    QJsonObject radar;
+    radar["azimuth"] = radarAzimuth_;
+    radar["elevation"] = radarElevation_;
+    radar["radius"] = config_.sphereRadius;
+
+    QJsonObject target;
+    target["type"] = config_.meshPath.isEmpty() ? QString(targetTypeName(config_.targetType)) : config_.meshPath;
+    target["position"] = QJsonArray{config_.targetPosition.x(), config_.targetPosition.y(), config_.targetPosition.z()};
+    target["rotation"] = QJsonArray{config_.targetRotation.x(), config_.targetRotation.y(), config_.targetRotation.z()};
+    target["scale"] = config_.targetScale;
+    target["formation"] = config_.formationCount;
+    target["formationSpacing"] = config_.formationSpacing;
+    target["analytic"] = config_.analytic;
+
+    QJsonObject trace;
+    trace["beamWidth"] = config_.beamWidthDegrees;
+    trace["rays"] = config_.numRays;
+    trace["bounces"] = config_.maxBounces;
+    trace["bounceCutoff"] = config_.bounceCutoff;
+    trace["roulette"] = config_.rouletteThreshold;
+    trace["sliceThickness"] = config_.sliceThicknessDegrees;
+    trace["reorder"] = config_.rayReordering;
+    trace["persistentThreads"] = config_.persistentThreads;
+    trace["normalCones"] = config_.normalConeCulling;
+    trace["temporalReuse"] = config_.temporalReuse;
+    trace["bvhBuild"] = config_.bvhBuild == BVHBuild::GPU ? "gpu" : "cpu";
+    trace["materials"] = QJsonArray::fromStringList(config_.materials);
+
+    QJsonObject state;
+    state["radar"] = radar;
+    state["target"] = target;
+    state["trace"] = trace;
+    return state;
+}
+
+void RCSAutomationServer::reply(const QJsonValue& id, const QJsonValue& result, const QString& error) {
+    QJsonObject response;
+    response["id"] = id;
+    if (error.isEmpty()) {
+        response["result"] = result;
+    } else {
+        response["error"] = error;
+        qWarning() << "RCSAutomationServer:" << error;
+    }
+
+    // One line per response; logging goes to stderr, so stdout carries nothing else
+    QByteArray line = QJsonDocument(response).toJson(QJsonDocument::Compact);
+    line.append('\n');
+    std::fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stdout);
+    std::fflush(stdout);
+}
+
+} // namespace RCS
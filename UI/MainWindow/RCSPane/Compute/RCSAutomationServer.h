@@ -0,0 +1,76 @@
+// RCSAutomationServer.h - Line-delimited JSON control of headless RCS jobs over stdio
+#pragma once
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <thread>
+
+#include "RCSSweepRunner.h"
+
+namespace RCS {
+
+// Serves RadarSim --serve. Each line on stdin is one request,
+//   {"id": 7, "method": "sweep", "params": {...}}
+// and each answer is one line on stdout, in request order:
+//   {"id": 7, "result": {...}}  or  {"id": 7, "error": "message"}
+// Methods:
+//   set_radar   azimuth, elevation, radius
+//   set_target  type (cube, cylinder, aircraft, sphere, plate, dihedral,
+//               trihedral or a model file), position [x,y,z],
+//               rotation [pitch,yaw,roll], scale, formation, formationSpacing,
+//               cache (use the TargetCache), analytic (exact surfaces)
+//   set_beam    width (degrees); type must be "conical", the traced pattern
+//   set_trace   rays, bounces, sampling (rings, fibonacci, sobol), sliceThickness,
+//               traversal, bvh, triangles, threads (as the --sweep options)
+//   trace       one look at the radar position: hits, rays, monostatic, cut
+//   sweep       azimuth and elevation [start, end, step]; with output the
+//               rows go to that file (CSV or .rcsc), otherwise into the
+//               result, fullCut adding each look's cut
+//   get_state   the settings the next trace uses
+//   cancel      stops the sweep in progress and those queued before it
+//   shutdown    answers, then exits
+// Settings persist between requests and the runner keeps its backend and the
+// target's BVH, so a client can pipeline thousands of jobs into one process.
+// A reader thread only splits stdin into lines (and acts on cancel at once);
+// every request runs queued on the thread that owns the backend.
+class RCSAutomationServer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit RCSAutomationServer(QObject* parent = nullptr);
+    ~RCSAutomationServer() override;
+
+    bool initialize(SweepBackend backend);
+    // Starts reading stdin; the application quits at shutdown or end of input
+    void start();
+
+private:
+    void readLoop();
+    void handleLine(const QByteArray& line);
+    QJsonValue dispatch(const QString& method, const QJsonObject& params, QString& error);
+
+    bool setRadar(const QJsonObject& params, QString& error);
+    bool setTarget(const QJsonObject& params, QString& error);
+    bool setBeam(const QJsonObject& params, QString& error);
+    bool setTrace(const QJsonObject& params, QString& error);
+    QJsonValue trace(QString& error);
+    QJsonValue sweep(const QJsonObject& params, QString& error);
+    QJsonObject state() const;
+
+    void reply(const QJsonValue& id, const QJsonValue& result, const QString& error);
+
+    RCSSweepRunner runner_;
+    SweepConfig config_;  // Target and trace settings; ranges are set per request
+    float radarAzimuth_ = RS::Constants::Defaults::kRadarTheta;
+    float radarElevation_ = RS::Constants::Defaults::kRadarPhi;
+    // RCSSweepRunner::cancelGeneration() when the running request was read
+    uint64_t requestGeneration_ = RCSSweepRunner::kCurrentCancelGeneration;
+
+    std::thread reader_;
+    std::atomic<bool> readerDone_{false};
+};
+
+} // namespace RCS
@@ -0,0 +1,84 @@
+// RCSBackend.h - Tracer interface for batch RCS work (headless sweeps)
+#pragma once
+
+#include <QString>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "RCSTypes.h"
+#include "RayTraceTypes.h"
+#include "BVHBuilder.h"
+#include "RCSSampler.h"
+#include "Constants.h"
+
+namespace RCS {
+
+// Trace parameters a backend applies before tracing. Options a backend has no
+// counterpart for are ignored (with a warning where results would differ).
+struct TraceSettings {
+    float sphereRadius = RS::Constants::Defaults::kSphereRadius;
+    float beamWidthDegrees = RS::Constants::Defaults::kBeamWidth;
+    int numRays = RS::Constants::kDefaultNumRays;
+    RaySampling sampling = RaySampling::Rings;
+    int maxBounces = 1;
+    float bounceCutoff = RS::Constants::kBounceCutoffIntensity;         // GPU, RCSCompute::setBounceTermination
+    float rouletteThreshold = RS::Constants::kBounceRouletteThreshold;  // GPU, 0 = no roulette
+    TraversalMode traversal = TraversalMode::Stack;                 // GPU
+    BVHLayout bvhLayout = BVHLayout::Binary;
+    BVHBuild bvhBuild = BVHBuild::CPU;                              // GPU, for later setMeshGeometry() calls
+    TrianglePrecision trianglePrecision = TrianglePrecision::Full;  // GPU
+    bool rayReordering = false;                                     // GPU, RCSCompute::setRayReordering
+    bool persistentThreads = false;                                 // GPU, RCSCompute::setPersistentThreads
+    bool normalConeCulling = false;                                 // GPU, closed meshes only
+    bool temporalReuse = false;                                     // GPU, seeds rays from neighbouring looks
+    int threads = 0;                                                // CPU, 0 = one per hardware thread
+    std::vector<Material> materials;  // GPU, indexed by material ID; empty = keep the current table
+};
+
+// One traced look reduced to its azimuth cut
+struct LookCut {
+    std::vector<RCSDataPoint> cut;  // kPolarPlotBins entries, dBsm per degree
+    int hitCount = 0;
+};
+
+// A place RCS looks can be traced: the GL compute pipeline on a context of its
+// own (GLRCSBackend) or the CPU packet tracer (CPURCSBackend). Backends own
+// their tracer, context and threads, so a sweep never touches the display
+// context. Only batch work goes through here. The interactive view keeps
+// using RCSCompute on the widget's context for its shadow map, heat map and
+// hit buffers, which the renderers read in place. Looks are monostatic: the
+// bistatic receivers of RCSCompute::setReceivers have no backend counterpart.
+class RCSBackend {
+public:
+    virtual ~RCSBackend() = default;
+
+    // Lifecycle. initialize() returns false when the backend cannot run here.
+    virtual bool initialize() = 0;
+    virtual void cleanup() = 0;
+
+    // Scene - same mesh/instance model as RCSCompute. A BVH installed with
+    // setMeshBVH() (TargetCache) is kept by setMeshGeometry() of that version.
+    // materialIds: material table index per triangle, empty = all material 0.
+    virtual void setMeshGeometry(uint32_t meshId, const std::vector<float>& vertices,
+                                 const std::vector<uint32_t>& indices, uint64_t geometryVersion,
+                                 const std::vector<uint32_t>& materialIds = {}) = 0;
+    virtual void setMeshBVH(uint32_t meshId, std::shared_ptr<const BVHSnapshot> bvh) = 0;
+    virtual std::shared_ptr<const BVHSnapshot> getMeshBVH(uint32_t meshId) const = 0;
+    virtual void setInstances(const std::vector<TargetInstance>& instances) = 0;
+    // Analytic primitives traced alongside the instances (RCSCompute::setPrimitives)
+    virtual void setPrimitives(const std::vector<ScenePrimitive>& primitives) = 0;
+    virtual bool waitForScene() = 0;  // Blocks until every mesh has its BVH; false on timeout or failure
+
+    virtual void applySettings(const TraceSettings& settings) = 0;
+    virtual int getNumRays() const = 0;
+
+    // Traces every look and bins it into its azimuth cut. cuts[i] belongs to
+    // looks[i]. Returns false if the backend failed; cuts are then undefined.
+    virtual bool traceLooks(const std::vector<RadarLook>& looks, std::vector<LookCut>& cuts) = 0;
+
+    // Short description for logs, e.g. "gpu, wide traversal"
+    virtual QString describe() const = 0;
+};
+
+} // namespace RCS
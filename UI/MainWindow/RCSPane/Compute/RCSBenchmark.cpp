@@ -0,0 +1,516 @@
+// RCSBenchmark.cpp - Timing suite over the real RCS classes (--bench CLI)
+#include "RCSBenchmark.h"
+#include "BVHBuilder.h"
+#include "CPURayTracer.h"
+#include "GLRCSBackend.h"
+#include "GPUBVHBuilder.h"
+#include "AzimuthCutSampler.h"
+#include "HeatMapRenderer.h"
+#include "ReflectionRenderer.h"
+#include "WireframeTarget.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr int kBenchFormat = 1;  // Bump when case names or units change meaning
+constexpr int kRayCounts[] = {10000, 100000, 1000000};
+constexpr int kHitCounts[] = {10000, 100000, 1000000};
+constexpr int kOptionRayCount = 1000000;  // GPU trace option cases, next to gpu_rays_per_s at this count
+
+const std::pair<WireframeType, const char*> kShapes[] = {
+    {WireframeType::Cube, "cube"},
+    {WireframeType::Cylinder, "cylinder"},
+    {WireframeType::Aircraft, "aircraft"},
+    {WireframeType::Sphere, "sphere"},
+};
+
+// Median wall time of repeats calls of fn, after one untimed warm-up call
+// (first-use allocations, shader variants, BVH upload)
+template <typename Fn>
+double medianMs(int repeats, Fn&& fn) {
+    fn();
+    std::vector<double> times;
+    times.reserve(repeats);
+    for (int i = 0; i < repeats; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        fn();
+        times.push_back(timer.nsecsElapsed() * 1.0e-6);
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return std::max(times[times.size() / 2], 1.0e-6);
+}
+
+// Gently rolling height field of about `triangles` triangles, interleaved
+// [x,y,z,nx,ny,nz] like WireframeTarget meshes. Large and regular, so build
+// time scales like an imported model's.
+void makeHeightField(int triangles, std::vector<float>& vertices, std::vector<uint32_t>& indices) {
+    const int quads = static_cast<int>(std::sqrt(triangles / 2.0));
+    const int side = quads + 1;
+    const float spacing = 1.0f / static_cast<float>(quads);
+
+    vertices.clear();
+    vertices.reserve(static_cast<size_t>(side) * side * 6);
+    for (int y = 0; y < side; ++y) {
+        for (int x = 0; x < side; ++x) {
+            float px = x * spacing - 0.5f;
+            float py = y * spacing - 0.5f;
+            float pz = 0.05f * std::sin(12.0f * px) * std::cos(9.0f * py);
+            vertices.insert(vertices.end(), {px, py, pz, 0.0f, 0.0f, 1.0f});
+        }
+    }
+
+    indices.clear();
+    indices.reserve(static_cast<size_t>(quads) * quads * 6);
+    for (int y = 0; y < quads; ++y) {
+        for (int x = 0; x < quads; ++x) {
+            uint32_t i = static_cast<uint32_t>(y * side + x);
+            uint32_t up = i + static_cast<uint32_t>(side);
+            indices.insert(indices.end(), {i, i + 1, up + 1, i, up + 1, up});
+        }
+    }
+}
+
+// Radar at the default scene angles, looking at the target at the origin
+QVector3D radarPosition() {
+    float az = Defaults::kRadarTheta * kDegToRadF;
+    float el = Defaults::kRadarPhi * kDegToRadF;
+    return Defaults::kSphereRadius * QVector3D(std::cos(el) * std::cos(az),
+                                               std::cos(el) * std::sin(az),
+                                               std::sin(el));
+}
+
+QString countLabel(int count) {
+    return count >= 1000000 ? QString("%1M").arg(count / 1000000) : QString("%1k").arg(count / 1000);
+}
+
+} // namespace
+
+bool RCSBenchmark::run(const BenchmarkConfig& config) {
+    config_ = config;
+    config_.repeats = std::max(1, config.repeats);
+    results_.clear();
+    hitPool_.clear();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    benchBVHBuilds();
+    if (loadTraceTarget()) {
+        if (config_.gpu) {
+            benchGPUTrace();
+        }
+        benchCPUTrace();
+        benchHitConsumers();
+    }
+
+    QString error;
+    if (!writeJson(config_.outputPath, results_, error)) {
+        qCritical() << "RCSBenchmark: Cannot write" << config_.outputPath << ":" << error;
+        return false;
+    }
+    qDebug() << "RCSBenchmark:" << results_.size() << "cases in" << timer.elapsed() << "ms ->" << config_.outputPath;
+
+    if (config_.baselinePath.isEmpty()) {
+        return true;
+    }
+    std::vector<BenchmarkResult> baseline;
+    if (!readJson(config_.baselinePath, baseline, error)) {
+        qCritical() << "RCSBenchmark: Cannot read baseline" << config_.baselinePath << ":" << error;
+        return false;
+    }
+    std::vector<BenchmarkRegression> regressions = findRegressions(baseline, results_, config_.regressionPercent);
+    for (const BenchmarkRegression& regression : regressions) {
+        qWarning().noquote() << "RCSBenchmark: Regression" << regression.name << "-" << regression.baseline
+                             << "->" << regression.current << QString("(%1% worse)").arg(regression.percentWorse, 0, 'f', 1);
+    }
+    qDebug() << "RCSBenchmark:" << regressions.size() << "regressions beyond" << config_.regressionPercent
+             << "% against" << config_.baselinePath;
+    return regressions.empty();
+}
+
+void RCSBenchmark::add(const QString& name, double value, const QString& unit, bool higherIsBetter) {
+    qDebug().noquote() << "RCSBenchmark:" << name << "=" << value << unit;
+    results_.push_back({name, value, unit, higherIsBetter});
+}
+
+bool RCSBenchmark::loadTraceTarget() {
+    // The ray cases trace the aircraft at the default scale, as the view shows it
+    std::unique_ptr<WireframeTarget> target = WireframeTarget::createTarget(WireframeType::Aircraft);
+    if (!target) {
+        return false;
+    }
+    target->generateMesh();
+    target->setScale(Defaults::kTargetScale);
+    targetVertices_ = target->getVertices();
+    targetIndices_.assign(target->getIndices().begin(), target->getIndices().end());
+    targetVersion_ = target->getGeometryVersion();
+    targetModel_ = target->getModelMatrix();
+    if (targetIndices_.empty()) {
+        qCritical() << "RCSBenchmark: Aircraft target produced no geometry";
+        return false;
+    }
+    return true;
+}
+
+void RCSBenchmark::benchBVHBuilds() {
+    auto benchBuild = [this](const QString& label, const std::vector<float>& vertices,
+                             const std::vector<uint32_t>& indices) {
+        BVHBuilder builder;
+        double ms = medianMs(config_.repeats, [&]() { builder.build(vertices, indices, QMatrix4x4()); });
+        add("bvh_build_ms/" + label, ms, "ms", false);
+        add("bvh_sah_cost/" + label, builder.getSAHCost(), "cost", false);
+    };
+
+    for (const auto& shape : kShapes) {
+        std::unique_ptr<WireframeTarget> target = WireframeTarget::createTarget(shape.first);
+        if (!target) {
+            continue;
+        }
+        target->generateMesh();
+        std::vector<uint32_t> indices(target->getIndices().begin(), target->getIndices().end());
+        benchBuild(shape.second, target->getVertices(), indices);
+    }
+
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    makeHeightField(kBenchSyntheticTriangles, vertices, indices);
+    benchBuild("synthetic_" + countLabel(kBenchSyntheticTriangles), vertices, indices);
+}
+
+void RCSBenchmark::benchGPUTrace() {
+    GLRCSBackend backend;
+    if (!backend.initialize()) {
+        qWarning() << "RCSBenchmark: No OpenGL 4.3 offscreen context, skipping the GPU cases";
+        return;
+    }
+
+    TargetInstance instance;
+    instance.modelMatrix = targetModel_;
+    backend.setMeshGeometry(0, targetVertices_, targetIndices_, targetVersion_);
+    backend.setInstances({instance});
+    if (!backend.waitForScene()) {  // Leaves the backend's context current
+        backend.cleanup();
+        return;
+    }
+
+    // Blocking readback, so each compute() covers its dispatch and copy
+    RCSCompute* compute = backend.compute();
+    compute->setAsyncReadback(false);
+    compute->setRadarPosition(radarPosition());
+    compute->setBeamDirection(-radarPosition().normalized());
+    for (int rays : kRayCounts) {
+        compute->setNumRays(rays);
+        double ms = medianMs(config_.repeats, [compute]() { compute->compute(); });
+        add("gpu_rays_per_s/" + countLabel(rays), rays * 1000.0 / ms, "rays/s", true);
+        add("gpu_hits/" + countLabel(rays), compute->getHitCount(), "hits", true);
+    }
+
+    // Each trace option on its own, against the default path at the same count.
+    // The hit count shows an option that changes results (the aircraft is closed,
+    // so none should).
+    const QString optionLabel = countLabel(kOptionRayCount);
+    compute->setNumRays(kOptionRayCount);
+    auto benchOption = [&](const char* option, auto&& enable) {
+        enable(true);
+        double ms = medianMs(config_.repeats, [compute]() { compute->compute(); });
+        add(QString("gpu_rays_per_s/%1_%2").arg(optionLabel, option), kOptionRayCount * 1000.0 / ms, "rays/s", true);
+        add(QString("gpu_hits/%1_%2").arg(optionLabel, option), compute->getHitCount(), "hits", true);
+        enable(false);
+    };
+    benchOption("reorder", [compute](bool on) { compute->setRayReordering(on); });
+    benchOption("persistent", [compute](bool on) { compute->setPersistentThreads(on); });
+    benchOption("normal_cones", [compute](bool on) { compute->setNormalConeCulling(on); });
+    benchOrbit(*compute);
+
+    // The same mesh under a GPUBVHBuilder tree (Morton splits, one triangle per
+    // leaf). A new version makes the backend rebuild it on the GPU.
+    backend.setBVHBuild(BVHBuild::GPU);
+    backend.setMeshGeometry(0, targetVertices_, targetIndices_, targetVersion_ + 1);
+    if (backend.waitForScene()) {
+        compute->setNumRays(kOptionRayCount);
+        compute->compute();  // Builds the tree; its depth arrives for the timed traces
+        double ms = medianMs(config_.repeats, [compute]() { compute->compute(); });
+        add(QString("gpu_rays_per_s/%1_gpu_bvh").arg(optionLabel), kOptionRayCount * 1000.0 / ms, "rays/s", true);
+        add(QString("gpu_hits/%1_gpu_bvh").arg(optionLabel), compute->getHitCount(), "hits", true);
+    }
+    benchGPUBVHBuilds();
+    backend.cleanup();
+}
+
+void RCSBenchmark::benchGPUBVHBuilds() {
+    // Runs on the GPU trace's context; glFinish makes each build's time wall time
+    QOpenGLFunctions* gl = QOpenGLContext::currentContext()->functions();
+    GPUBVHBuilder builder;
+    if (!builder.initialize()) {
+        qWarning() << "RCSBenchmark: GPU BVH builder unavailable, skipping gpu_bvh_build_ms";
+        return;
+    }
+
+    auto benchBuild = [&](const QString& label, const std::vector<float>& vertices,
+                          const std::vector<uint32_t>& indices) {
+        const int triangles = static_cast<int>(indices.size() / 3);
+        const int nodes = GPUBVHBuilder::nodeCount(triangles);
+        const GLsizeiptr sizes[6] = {
+            static_cast<GLsizeiptr>(vertices.size() * sizeof(float)),
+            static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)),
+            static_cast<GLsizeiptr>(nodes * sizeof(BVHNode)),
+            static_cast<GLsizeiptr>(nodes * sizeof(int32_t)),
+            static_cast<GLsizeiptr>(triangles * sizeof(Triangle)),
+            static_cast<GLsizeiptr>(8 * sizeof(GLfloat) + sizeof(GLuint)),
+        };
+        const void* data[6] = {vertices.data(), indices.data(), nullptr, nullptr, nullptr, nullptr};
+        GLuint buffers[6];
+        gl->glGenBuffers(6, buffers);
+        for (int i = 0; i < 6; ++i) {
+            gl->glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+            gl->glBufferData(GL_ARRAY_BUFFER, sizes[i], data[i], GL_STATIC_DRAW);
+        }
+        gl->glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        bool built = true;
+        double ms = medianMs(config_.repeats, [&]() {
+            built = builder.build(buffers[0], buffers[1], triangles, buffers[2], buffers[3], 0,
+                                  buffers[4], 0, buffers[5]) && built;
+            gl->glFinish();
+        });
+        if (built) {
+            add("gpu_bvh_build_ms/" + label, ms, "ms", false);
+        }
+        gl->glDeleteBuffers(6, buffers);
+    };
+
+    for (const auto& shape : kShapes) {
+        std::unique_ptr<WireframeTarget> target = WireframeTarget::createTarget(shape.first);
+        if (!target) {
+            continue;
+        }
+        target->generateMesh();
+        std::vector<uint32_t> indices(target->getIndices().begin(), target->getIndices().end());
+        benchBuild(shape.second, target->getVertices(), indices);
+    }
+
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    makeHeightField(kBenchSyntheticTriangles, vertices, indices);
+    benchBuild("synthetic_" + countLabel(kBenchSyntheticTriangles), vertices, indices);
+    builder.cleanup();
+}
+
+void RCSBenchmark::benchOrbit(RCSCompute& compute) {
+    BinningSlice slice;
+    slice.offsetDegrees = Defaults::kRadarPhi;
+    slice.thicknessDegrees = kSweepSliceThickness;
+    compute.setPolarBinning(true, slice);
+    compute.setNumRays(kBenchOrbitRays);
+
+    AzimuthCutSampler sampler;
+    sampler.setThickness(kSweepSliceThickness);
+    sampler.setOffset(Defaults::kRadarPhi);
+
+    auto moveTo = [&compute](int frame) {
+        float az = (Defaults::kRadarTheta + frame * kBenchOrbitStepDegrees) * kDegToRadF;
+        float el = Defaults::kRadarPhi * kDegToRadF;
+        QVector3D position = Defaults::kSphereRadius * QVector3D(std::cos(el) * std::cos(az),
+                                                                 std::cos(el) * std::sin(az),
+                                                                 std::sin(el));
+        compute.setRadarPosition(position);
+        compute.setBeamDirection(-position.normalized());
+    };
+    auto traceCut = [&]() {
+        std::vector<RCSDataPoint> cut(kPolarPlotBins);
+        sampler.sampleBins(compute.getLatestPolarBins(), cut);
+        return cut;
+    };
+
+    // Full-trace cut at every orbit position
+    std::vector<std::vector<RCSDataPoint>> reference;
+    for (int frame = 0; frame < kBenchOrbitFrames; ++frame) {
+        moveTo(frame);
+        compute.compute();
+        reference.push_back(traceCut());
+    }
+
+    // One compute() per frame, as the view gets while the radar is dragged.
+    // Frame 0 warms up; the time and dB error cover the frames after it.
+    compute.setProgressive(true);
+    auto orbit = [&](const char* mode, bool temporal) {
+        compute.setTemporalReuse(temporal);
+        moveTo(0);
+        compute.compute();
+        double totalMs = 0.0;
+        double squaredError = 0.0;
+        int binCount = 0;
+        for (int frame = 1; frame < kBenchOrbitFrames; ++frame) {
+            moveTo(frame);
+            QElapsedTimer timer;
+            timer.start();
+            compute.compute();
+            totalMs += timer.nsecsElapsed() * 1.0e-6;
+            std::vector<RCSDataPoint> cut = traceCut();
+            for (size_t bin = 0; bin < cut.size(); ++bin) {
+                double error = cut[bin].dBsm - reference[frame][bin].dBsm;
+                squaredError += error * error;
+                ++binCount;
+            }
+        }
+        add(QString("orbit_frame_ms/%1").arg(mode), std::max(totalMs / (kBenchOrbitFrames - 1), 1.0e-6), "ms", false);
+        add(QString("orbit_error_db/%1").arg(mode), std::sqrt(squaredError / std::max(binCount, 1)), "dB", false);
+    };
+    orbit("progressive", false);
+    orbit("temporal", true);
+
+    compute.setTemporalReuse(false);
+    compute.setProgressive(false);
+    compute.setPolarBinning(false, slice);
+    moveTo(0);
+}
+
+void RCSBenchmark::benchCPUTrace() {
+    CPURayTracer tracer;
+    TargetInstance instance;
+    instance.modelMatrix = targetModel_;
+    tracer.setMeshGeometry(0, targetVertices_, targetIndices_);
+    tracer.setInstances({instance});
+    tracer.setThreadCount(config_.cpuThreads);
+    tracer.setRadarPosition(radarPosition());
+    tracer.setBeamDirection(-radarPosition().normalized());
+
+    for (int rays : kRayCounts) {
+        tracer.setNumRays(rays);
+        double ms = medianMs(config_.repeats, [&tracer]() { tracer.compute(); });
+        add("cpu_rays_per_s/" + countLabel(rays), rays * 1000.0 / ms, "rays/s", true);
+    }
+
+    // The last (largest) trace feeds the hit consumers
+    hitPool_.clear();
+    for (const HitResult& hit : tracer.getHitResults()) {
+        if (hit.hitPoint.w() >= 0.0f) {
+            hitPool_.push_back(hit);
+        }
+    }
+}
+
+void RCSBenchmark::benchHitConsumers() {
+    if (hitPool_.empty()) {
+        qWarning() << "RCSBenchmark: The CPU trace hit nothing, skipping the hit consumer cases";
+        return;
+    }
+
+    AzimuthCutSampler sampler;
+    sampler.setThickness(kSweepSliceThickness);
+    sampler.setOffset(Defaults::kRadarPhi);
+    std::vector<RCSDataPoint> cut(kPolarPlotBins);
+    ReflectionRenderer lobes;     // CPU clustering only, no GL needed until render()
+    HeatMapRenderer heatMap;
+
+    std::vector<HitResult> hits;
+    for (int count : kHitCounts) {
+        // Cycle through the traced hits to reach the count
+        hits.resize(count);
+        for (int i = 0; i < count; ++i) {
+            hits[i] = hitPool_[i % hitPool_.size()];
+        }
+        QString label = countLabel(count);
+
+        sampler.prepare(hits.size());
+        double ms = medianMs(config_.repeats, [&]() { sampler.sample(hits, cut); });
+        add("sampler_hits_per_s/" + label, count * 1000.0 / ms, "hits/s", true);
+
+        add("cluster_ms/" + label, medianMs(config_.repeats, [&]() { lobes.updateLobes(hits); }), "ms", false);
+
+        add("heatmap_ms/" + label,
+            medianMs(config_.repeats, [&]() { heatMap.updateFromHits(hits, Defaults::kSphereRadius); }),
+            "ms", false);
+    }
+}
+
+bool RCSBenchmark::writeJson(const QString& path, const std::vector<BenchmarkResult>& results, QString& error) {
+    QJsonArray cases;
+    for (const BenchmarkResult& result : results) {
+        QJsonObject entry;
+        entry["name"] = result.name;
+        entry["value"] = result.value;
+        entry["unit"] = result.unit;
+        entry["higherIsBetter"] = result.higherIsBetter;
+        cases.append(entry);
+    }
+    QJsonObject root;
+    root["format"] = kBenchFormat;
+    root["simd"] = CPURayTracer::isSimdEnabled();
+    root["results"] = cases;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (file.error() != QFileDevice::NoError) {
+        error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool RCSBenchmark::readJson(const QString& path, std::vector<BenchmarkResult>& results, QString& error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        error = parseError.errorString();
+        return false;
+    }
+    QJsonObject root = doc.object();
+    if (root["format"].toInt() != kBenchFormat) {
+        error = QString("Format %1, expected %2").arg(root["format"].toInt()).arg(kBenchFormat);
+        return false;
+    }
+
+    results.clear();
+    for (const QJsonValue& value : root["results"].toArray()) {
+        QJsonObject entry = value.toObject();
+        results.push_back({entry["name"].toString(), entry["value"].toDouble(),
+                           entry["unit"].toString(), entry["higherIsBetter"].toBool()});
+    }
+    return true;
+}
+
+std::vector<BenchmarkRegression> RCSBenchmark::findRegressions(const std::vector<BenchmarkResult>& baseline,
+                                                               const std::vector<BenchmarkResult>& current,
+                                                               float percent) {
+    std::vector<BenchmarkRegression> regressions;
+    for (const BenchmarkResult& result : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+                               [&result](const BenchmarkResult& entry) { return entry.name == result.name; });
+        if (it == baseline.end() || it->value <= 0.0) {
+            continue;
+        }
+        double change = (result.value - it->value) / it->value * 100.0;
+        double worse = result.higherIsBetter ? -change : change;
+        if (worse > percent) {
+            regressions.push_back({result.name, it->value, result.value, worse});
+        }
+    }
+    return regressions;
+}
+
+} // namespace RCS
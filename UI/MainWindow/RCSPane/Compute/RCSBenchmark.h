@@ -0,0 +1,99 @@
+// RCSBenchmark.h - Timing suite over the real RCS classes (--bench CLI)
+#pragma once
+
+#include <QMatrix4x4>
+#include <QString>
+#include <vector>
+
+#include "RCSTypes.h"
+#include "Constants.h"
+
+namespace RCS {
+
+class RCSCompute;
+
+// One --bench run. Results go to outputPath as JSON; with a baseline the run
+// fails when any case is worse than it by more than regressionPercent.
+struct BenchmarkConfig {
+    QString outputPath;
+    QString baselinePath;  // Earlier --bench output to compare against (empty = none)
+    float regressionPercent = RS::Constants::kBenchRegressionPercent;
+    int repeats = RS::Constants::kBenchRepeats;
+    bool gpu = true;       // Time RCSCompute::compute on an offscreen GL context
+    int cpuThreads = 0;    // CPURayTracer worker threads (0 = one per hardware thread)
+};
+
+// One measured case. Names are stable across runs ("bvh_build_ms/aircraft"),
+// they are the key --compare matches on.
+struct BenchmarkResult {
+    QString name;
+    double value = 0.0;
+    QString unit;
+    bool higherIsBetter = false;
+};
+
+// A case that got worse than its baseline entry
+struct BenchmarkRegression {
+    QString name;
+    double baseline = 0.0;
+    double current = 0.0;
+    double percentWorse = 0.0;
+};
+
+// Canonical cases, each the median of config.repeats runs after one warm-up:
+//   bvh_build_ms / bvh_sah_cost  per Target/Shapes type and a synthetic
+//                                kBenchSyntheticTriangles height field
+//   gpu_rays_per_s / cpu_rays_per_s  RCSCompute::compute (blocking readback)
+//                                and CPURayTracer::compute at 10k/100k/1M rays
+//   gpu_hits                     hits of each GPU trace
+//   gpu_rays_per_s/1M_<option>   the GPU trace at 1M rays with one option on
+//   gpu_hits/1M_<option>         (reorder, persistent, normal_cones, gpu_bvh:
+//                                traced over a GPUBVHBuilder tree), against
+//                                gpu_rays_per_s/1M and gpu_hits/1M
+//   gpu_bvh_build_ms             GPUBVHBuilder::build of the bvh_build_ms meshes
+//   orbit_frame_ms / orbit_error_db  one compute() per kBenchOrbitStepDegrees
+//                                radar step with progressive refinement, without
+//                                and with temporal reuse; RMS dB error of the
+//                                azimuth cut against a full trace at each step
+//   sampler_hits_per_s           AzimuthCutSampler::sample
+//   cluster_ms                   ReflectionRenderer lobe clustering
+//   heatmap_ms                   HeatMapRenderer::updateFromHits
+// The hit consumers run at 10k/100k/1M hits taken from the CPU trace. No
+// widget is created; the GPU cases need a GUI application for the context.
+class RCSBenchmark {
+public:
+    // Runs every case, writes the JSON and compares against the baseline.
+    // Returns false if the output cannot be written or a case regressed.
+    bool run(const BenchmarkConfig& config);
+
+    const std::vector<BenchmarkResult>& results() const { return results_; }
+
+    static bool writeJson(const QString& path, const std::vector<BenchmarkResult>& results, QString& error);
+    static bool readJson(const QString& path, std::vector<BenchmarkResult>& results, QString& error);
+
+    // Current cases worse than their baseline entry by more than percent.
+    // Cases missing from either side are not compared.
+    static std::vector<BenchmarkRegression> findRegressions(const std::vector<BenchmarkResult>& baseline,
+                                                            const std::vector<BenchmarkResult>& current,
+                                                            float percent);
+
+private:
+    bool loadTraceTarget();
+    void benchBVHBuilds();
+    void benchGPUTrace();
+    void benchOrbit(RCSCompute& compute);
+    void benchGPUBVHBuilds();
+    void benchCPUTrace();
+    void benchHitConsumers();
+    void add(const QString& name, double value, const QString& unit, bool higherIsBetter);
+
+    BenchmarkConfig config_;
+    std::vector<BenchmarkResult> results_;
+    std::vector<float> targetVertices_;    // Aircraft mesh traced by the ray cases
+    std::vector<uint32_t> targetIndices_;
+    uint64_t targetVersion_ = 0;
+    QMatrix4x4 targetModel_;
+    std::vector<HitResult> hitPool_;       // Hits of the largest CPU trace, feeds the consumers
+};
+
+} // namespace RCS
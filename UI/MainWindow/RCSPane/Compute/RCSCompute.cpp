@@ -2,22 +2,149 @@
 #include "RCSCompute.h"
 #include "GLUtils.h"
 #include "Constants.h"
+#include "CompactTriangles.h"
+#include "BVHTraversal.h"
+#include "../../../../RCS/BounceEffectPipeline.h"
 #include <QOpenGLContext>
+#include <QElapsedTimer>
 #include <QDebug>
 #include <cmath>
 #include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
 
 using namespace RS::Constants;
 
 namespace RCS {
 
+namespace {
+
+// Bytes per readback entry for a payload (None keeps a minimal buffer bound)
+GLsizeiptr payloadStride(HitPayload payload) {
+    switch (payload) {
+    case HitPayload::Full: return sizeof(HitResult);
+    case HitPayload::Compact:
+    case HitPayload::CompactHitsOnly: return sizeof(CompactHit);
+    case HitPayload::Columns: return kHitColumnCount * sizeof(float);
+    case HitPayload::None: break;
+    }
+    return 0;
+}
+
+float halfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    uint32_t exponent = (h >> 10) & 0x1Fu;
+    uint32_t mantissa = h & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Subnormal - normalize
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) { mantissa <<= 1; --exponent; }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    } else if (exponent == 0x1F) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// std430 layout of a batched look (see Look in the ray generation shader)
+struct GPULook {
+    float radarPosition[4];
+    float beamDirection[4];
+    float slice[4];  // cutType, offset, thickness, minIntensity
+};
+static_assert(sizeof(GPULook) == 48, "GPULook must match the shader's std430 layout");
+
+// World-space AABB of an object-space box under a model matrix (all 8 corners)
+AABB transformBounds(const QVector3D& boundsMin, const QVector3D& boundsMax, const QMatrix4x4& model) {
+    AABB bounds;
+    for (int corner = 0; corner < 8; ++corner) {
+        QVector3D p((corner & 1) ? boundsMax.x() : boundsMin.x(),
+                    (corner & 2) ? boundsMax.y() : boundsMin.y(),
+                    (corner & 4) ? boundsMax.z() : boundsMin.z());
+        bounds.expand(model.map(p));
+    }
+    return bounds;
+}
+
+// Shader source with a #define inserted after its #version line (kernel variants)
+QByteArray withDefine(const char* source, const char* define) {
+    QByteArray result(source);
+    result.replace("#version 430 core\n", QByteArray("#version 430 core\n#define ") + define + "\n");
+    return result;
+}
+
+// Prepends a block of #define lines ("NAME" or "NAME VALUE" each) to a shader
+QByteArray withDefines(const char* source, const std::vector<QByteArray>& defines) {
+    QByteArray header("#version 430 core\n");
+    for (const QByteArray& define : defines) {
+        header += "#define ";
+        header += define;
+        header += '\n';
+    }
+    QByteArray result(source);
+    result.replace("#version 430 core\n", header);
+    return result;
+}
+
+HitResult decodeCompactHit(const CompactHit& c, uint32_t rayId, float distance) {
+    HitResult hit;
+    float intensity = halfToFloat(static_cast<uint16_t>(c.intensityTarget & 0xFFFFu));
+    QVector3D reflectDir = intensity > 0.0f ? octDecodeUnit(c.reflectionOct) : QVector3D();  // Back-facing = zero
+    hit.hitPoint = QVector4D(c.position[0], c.position[1], c.position[2], distance);
+    hit.normal = QVector4D(distance >= 0.0f ? octDecodeUnit(c.normalOct) : QVector3D(), 0.0f);
+    hit.reflection = QVector4D(reflectDir, intensity);
+    hit.triangleId = c.triangleId;
+    hit.rayId = rayId;
+    hit.targetId = c.intensityTarget >> 16;
+    hit.rcsContribution = 0.0f;
+    return hit;
+}
+
+bool sameSlice(const BinningSlice& a, const BinningSlice& b) {
+    return a.cutType == b.cutType && a.offsetDegrees == b.offsetDegrees &&
+           a.thicknessDegrees == b.thicknessDegrees && a.minIntensity == b.minIntensity;
+}
+
+// Replaces history with the newest bins, or with weight of it kept. Sums and
+// hit counts blend alike, so the averages the samplers take stay consistent.
+void blendBins(std::vector<PolarBin>& history, const PolarBin* latest, size_t count, float weight) {
+    if (weight <= 0.0f || history.size() != count) {
+        history.assign(latest, latest + count);
+        return;
+    }
+    const double keep = weight;
+    for (size_t i = 0; i < count; ++i) {
+        PolarBin& bin = history[i];
+        uint64_t previous = (static_cast<uint64_t>(bin.intensityHi) << 32) | bin.intensityLo;
+        uint64_t current = (static_cast<uint64_t>(latest[i].intensityHi) << 32) | latest[i].intensityLo;
+        uint64_t blended = static_cast<uint64_t>(std::llround(current + (static_cast<double>(previous) - current) * keep));
+        bin.intensityLo = static_cast<uint32_t>(blended & 0xFFFFFFFFu);
+        bin.intensityHi = static_cast<uint32_t>(blended >> 32);
+        bin.hitCount = static_cast<uint32_t>(std::lround(latest[i].hitCount +
+                                             (static_cast<double>(bin.hitCount) - latest[i].hitCount) * keep));
+    }
+}
+
+} // namespace
+
 // Compute shader source: Ray Generation
 static const char* rayGenShaderSource = R"(
 #version 430 core
 layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
 
 struct Ray {
-    vec4 origin;      // xyz = origin, w = tmin
+    vec4 origin;      // xyz = origin, w = two-way beam pattern weight
     vec4 direction;   // xyz = direction, w = tmax
 };
 
@@ -25,30 +152,105 @@ layout(std430, binding = 0) buffer RayBuffer {
     Ray rays[];
 };
 
+// Batched looks (see RCS::RadarLook) - one per gl_GlobalInvocationID.y
+struct Look {
+    vec4 radarPosition;
+    vec4 beamDirection;
+    vec4 slice;  // cutType, offset, thickness, minIntensity
+};
+layout(std430, binding = 11) readonly buffer LookBuffer { Look looks[]; };
+
 uniform vec3 radarPosition;
 uniform vec3 beamDirection;
 uniform float beamWidthRad;
 uniform float maxDistance;
-uniform int numRays;
+uniform int numRays;      // Rays in this tile (per look)
+uniform int rayOffset;    // Global index of the tile's first ray
 uniform int raysPerRing;
 uniform int numRings;
+uniform int numLooks;     // 0 = single look from the uniforms above
+uniform uint rayStride;   // Progressive order: ray = (index * rayStride) mod totalRays (<= 1 = identity)
+uniform int totalRays;
+uniform int sampling;         // RaySampling: 0 = rings, 1 = Fibonacci, 2 = Sobol
+uniform vec2 sampleRotation;  // Cranley-Patterson rotation of the first pass (0 = none)
+uniform vec3 focusDirection;  // Axis of the target's bounding cone
+uniform float focusHalfAngle; // > 0: rays cover that cone instead of the beam
+uniform sampler2D beamPattern;   // One-way gain: x = azimuth around the beam axis / 2 pi, y = off-axis / half-angle
+uniform bool beamPatternEnabled;
+
+// Rank-1 lattice permutation of the ray index, so every prefix of a progressive
+// accumulation is a stratified subset. Byte-wise Horner keeps products in 32 bits.
+uint progressiveRayId(uint index) {
+    if (rayStride <= 1u) return index;
+    uint total = uint(totalRays);
+    uint r = 0u;
+    for (int shift = 16; shift >= 0; shift -= 8) {
+        uint digit = (rayStride >> uint(shift)) & 0xFFu;
+        r = ((r * 256u) % total + (index * digit) % total) % total;
+    }
+    return r;
+}
 
-void main() {
-    uint rayId = gl_GlobalInvocationID.x;
-    if (rayId >= numRays) return;
-
-    // Calculate ring and position within ring
-    uint ring = rayId / raysPerRing;
-    uint posInRing = rayId % raysPerRing;
+// Unit-square point of a ray for the area-uniform patterns
+vec2 samplePoint(uint rayId) {
+    if (sampling == 1) {
+        // Fibonacci lattice - radial strata, golden-ratio azimuth in 0.32 fixed point
+        return vec2((float(rayId) + 0.5) / float(totalRays), float(rayId * 2654435769u) * 2.3283064e-10);
+    }
+    // Sobol - van der Corput radical inverse and the second Sobol dimension
+    uint y = 0u;
+    for (uint i = rayId, v = 0x80000000u; i != 0u; i >>= 1u, v ^= v >> 1u) {
+        if ((i & 1u) != 0u) y ^= v;
+    }
+    return vec2(float(bitfieldReverse(rayId)), float(y)) * 2.3283064e-10;
+}
 
-    // Angle within beam cone (0 = center, beamWidthRad/2 = edge)
-    // beamWidthRad is the full cone angle, so half-angle is the max from center
-    float halfAngle = beamWidthRad * 0.5;
-    float ringAngle = halfAngle * float(ring + 1) / float(numRings);
-    float azimuth = 2.0 * 3.14159265 * float(posInRing) / float(raysPerRing);
+void main() {
+    uint localId = gl_GlobalInvocationID.x;
+    if (localId >= numRays) return;
+
+    // Indices past totalRays are further passes over the same rays, each under
+    // a new rotation (R2 sequence step) so they land between the earlier ones
+    uint index = uint(rayOffset) + localId;
+    uint passIndex = index / uint(totalRays);
+    uint rayId = progressiveRayId(index - passIndex * uint(totalRays));
+    vec2 rotation = fract(sampleRotation + float(passIndex) * vec2(0.7548776662, 0.5698402910));
+
+    // Each look owns a contiguous numRays block of the ray buffer
+    uint look = gl_GlobalInvocationID.y;
+    uint outIndex = look * uint(numRays) + localId;
+    vec3 origin = numLooks > 0 ? looks[look].radarPosition.xyz : radarPosition;
+    vec3 beamDir = numLooks > 0 ? looks[look].beamDirection.xyz : beamDirection;
+
+    // beamWidthRad is the full cone angle, so half-angle is the max from center.
+    // A focused look samples the target's bounding cone in its place.
+    bool focused = numLooks == 0 && focusHalfAngle > 0.0;
+    float halfAngle = focused ? focusHalfAngle : beamWidthRad * 0.5;
+    float sinAngle;
+    float cosAngle;
+    float azimuth;
+    if (sampling == 0) {
+        // Calculate ring and position within ring. Rings are interleaved so any
+        // contiguous tile of rays is a uniform subsample of the whole beam.
+        // The rotation shifts a ray within its ring spacing and azimuth step.
+        uint ring = rayId % uint(numRings);
+        uint posInRing = rayId / uint(numRings);
+        float ringAngle = halfAngle * (float(ring + 1) - rotation.x) / float(numRings);
+        sinAngle = sin(ringAngle);
+        cosAngle = cos(ringAngle);
+        azimuth = 2.0 * 3.14159265 * (float(posInRing) + rotation.y) / float(raysPerRing);
+    } else {
+        // Area-uniform over the cap: 1 - cos(angle) uniform on [0, 1 - cos(halfAngle)]
+        vec2 uv = fract(samplePoint(rayId) + rotation);
+        float s = sin(halfAngle * 0.5);
+        float oneMinusCos = uv.x * 2.0 * s * s;
+        sinAngle = sqrt(oneMinusCos * (2.0 - oneMinusCos));
+        cosAngle = 1.0 - oneMinusCos;
+        azimuth = 2.0 * 3.14159265 * uv.y;
+    }
 
     // Calculate ray direction using beam coordinate system
-    vec3 forward = normalize(beamDirection);
+    vec3 forward = normalize(focused ? focusDirection : beamDir);
 
     // Choose up vector avoiding gimbal lock
     vec3 up = abs(forward.z) < 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
@@ -56,9 +258,6 @@ void main() {
     up = normalize(cross(right, forward));
 
     // Cone sampling
-    float sinAngle = sin(ringAngle);
-    float cosAngle = cos(ringAngle);
-
     vec3 localDir = vec3(
         sinAngle * cos(azimuth),
         sinAngle * sin(azimuth),
@@ -67,8 +266,32 @@ void main() {
 
     vec3 worldDir = localDir.x * right + localDir.y * up + localDir.z * forward;
 
-    rays[rayId].origin = vec4(radarPosition, 0.001);      // tmin = 0.001
-    rays[rayId].direction = vec4(normalize(worldDir), maxDistance);  // tmax
+    // Focused rays outside the beam are traced as misses (tmax 0) rather than
+    // redrawn, so every ray keeps the same solid-angle share
+    float tmax = maxDistance;
+    if (focused && dot(normalize(worldDir), normalize(beamDir)) < cos(beamWidthRad * 0.5)) {
+        tmax = 0.0;
+    }
+
+    // Antenna gain toward the ray, squared for transmit and receive, so side
+    // lobe returns count for what the pattern gives them. Measured in the beam's
+    // own frame, which a focused look does not share.
+    float weight = 1.0;
+    if (beamPatternEnabled) {
+        vec3 axis = normalize(beamDir);
+        vec3 beamUp = abs(axis.z) < 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+        vec3 beamRight = normalize(cross(axis, beamUp));
+        beamUp = normalize(cross(beamRight, axis));
+        vec3 dir = normalize(worldDir);
+        float offAxis = acos(clamp(dot(dir, axis), -1.0, 1.0));
+        float around = atan(dot(dir, beamUp), dot(dir, beamRight));
+        if (around < 0.0) around += 2.0 * 3.14159265;
+        float gain = textureLod(beamPattern, vec2(around / (2.0 * 3.14159265), offAxis / (beamWidthRad * 0.5)), 0.0).r;
+        weight = gain * gain;
+    }
+
+    rays[outIndex].origin = vec4(origin, weight);  // tmin is the kernel's fixed 0.001
+    rays[outIndex].direction = vec4(normalize(worldDir), tmax);
 }
 )";
 
@@ -78,8 +301,8 @@ static const char* traceShaderSource = R"(
 layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
 
 struct Ray {
-    vec4 origin;
-    vec4 direction;
+    vec4 origin;     // xyz = origin, w = two-way beam pattern weight
+    vec4 direction;  // xyz = direction, w = tmax
 };
 
 struct BVHNode {
@@ -97,14 +320,285 @@ struct HitResult {
     float rcsContribution;
 };
 
+// Two-level BVH: every mesh's bottom-level tree lives back to back in the node and
+// triangle buffers; instances place a mesh in the scene and the top-level tree
+// is built over instance bounds
+struct Instance {
+    mat4 invModel;      // World -> object space
+    mat3 normalMatrix;  // Object -> world space for normals
+    uint nodeOffset;
+    uint nodeCount;
+    uint triangleOffset;
+    uint targetId;
+};
+
 layout(std430, binding = 0) readonly buffer RayBuffer { Ray rays[]; };
+#ifdef WIDE_BVH
+// Four-wide node with quantized child boxes (see RCS::WideBVHNode)
+struct WideNode {
+    vec3 origin;
+    uint exponents;   // Biased power-of-two step per axis, one byte each
+    uvec4 children;   // Node index, leaf (0x80000000 | count << 24 | firstTri) or 0xFFFFFFFF
+    uvec4 quantLo;    // xyz: per axis, byte i = child i
+    uvec4 quantHi;
+};
+layout(std430, binding = 1) readonly buffer BVHBuffer { WideNode wideNodes[]; };
+#else
 layout(std430, binding = 1) readonly buffer BVHBuffer { BVHNode nodes[]; };
+#endif
+#ifdef COMPACT_TRIANGLES
+layout(std430, binding = 2) readonly buffer TriBuffer { uvec2 compactTriangles[]; };  // 3 uvec2s per triangle
+#else
 layout(std430, binding = 2) readonly buffer TriBuffer { vec4 triangles[]; };  // 3 vec4s per triangle
+#endif
+layout(std430, binding = 12) readonly buffer InstanceBuffer { Instance instances[]; };  // TLAS leaf order
+layout(std430, binding = 13) readonly buffer TLASBuffer { BVHNode tlasNodes[]; };
+layout(std430, binding = 14) readonly buffer SkipBuffer { int skipLinks[]; };  // Parallel to nodes[]
+
+#ifdef NORMAL_CONE_CULLING
+// Per node: axis and sin(half-angle) of its triangles' normals (RCS::BVHBuilder::getNormalCones)
+layout(std430, binding = 23) readonly buffer NormalConeBuffer { vec4 normalCones[]; };  // Parallel to nodes[]
+
+// Every triangle under the node faces away from the ray or is edge-on. On a
+// closed mesh the closest hit is a front face, so none of them can be it.
+bool facesAway(int node, vec3 dir, float dirLength) {
+    vec4 cone = normalCones[node];
+    return dot(cone.xyz, dir) >= cone.w * dirLength;
+}
+#endif
+
+#ifdef TEMPORAL_REUSE
+// Per primary ray ID: the instance and the leaf (node index within its tree)
+// the ray's previous trace hit, 0xFFFFFFFF = none (RCSCompute::setTemporalReuse)
+layout(std430, binding = 24) buffer TemporalSeeds { uvec2 temporalSeeds[]; };
+uniform bool seedRays;     // Primary passes; batched looks share one seed per ray ID across looks
+uniform uint seedCapacity;
+uvec2 hitLeaf;             // Leaf of the closest hit so far, set by the traversal
+#endif
+
+#ifdef TRIANGLE_HOTSPOTS
+// [0] = largest per-triangle sum so far, then one fixed-point intensity sum per
+// packed triangle in source order within each mesh (RCSCompute::setTriangleHotspots)
+layout(std430, binding = 26) buffer HotspotBuffer { uint hotspots[]; };
+uniform bool hotspotRays;     // Interactive primary pass; batched looks add nothing
+uniform float hotspotScale;
+uint hitSource;               // Packed source triangle of the closest hit, set by testLeaf
+#endif
+
+// Analytic primitives (RCS::PrimitiveData), tested after the instances
+struct Primitive {
+    mat4 invModel;      // World -> unit primitive space
+    mat3 normalMatrix;  // Primitive -> world space for normals
+    uint shape;         // 0 = sphere, 1 = cylinder, 2 = plate (RCS::AnalyticShapeType)
+    uint targetId;
+    uint materialId;
+    uint reserved;
+};
+layout(std430, binding = 20) readonly buffer PrimitiveBuffer { Primitive primitives[]; };
+// Compact 32-byte readback payload (see RCS::CompactHit)
+struct CompactHit {
+    vec3 position;
+    uint distanceOrRayId;  // Dense: float distance (-1 = miss). Hits-only: rayId
+    uint normalOct;        // Octahedral normal, snorm 2x16
+    uint reflectionOct;    // Octahedral reflection direction, snorm 2x16
+    uint intensityTarget;  // Low 16: half-float intensity, high 16: targetId
+    uint triangleId;
+};
+
 layout(std430, binding = 3) buffer HitBuffer { HitResult hits[]; };
-layout(std430, binding = 4) buffer CounterBuffer { uint hitCounter; };
+layout(std430, binding = 4) buffer CounterBuffer { uint hitCounter[]; };  // One per look
+layout(std430, binding = 8) writeonly buffer CompactHitBuffer { CompactHit compactHits[]; };
+// Same binding, HitPayload::Columns: 8 arrays of compactCapacity floats (see RCS::HitColumns)
+layout(std430, binding = 8) writeonly buffer HitColumnBuffer { float hitColumns[]; };
+
+uniform int numRays;    // Rays in this tile (per look)
+uniform int rayOffset;  // Global index of the tile's first ray
+uniform int numTlasNodes;     // 0 = no mesh instances
+uniform int numPrimitives;    // 0 = no analytic primitives
+uniform uint compactCapacity; // Entries in CompactHitBuffer
+uniform int payloadOffset;    // rayOffset of the tile the dense payload holds
+uniform float raySolidAngle;  // Steradians each primary ray stands for (HitResult::rcsContribution)
+
+// Specialized per variant (RCSCompute::traceProgram), so the payload branches
+// below fold to the one format this kernel writes
+const int hitPayload = HIT_PAYLOAD;  // RCS::HitPayload
+
+// Multi-bounce wavefront. Pass 0 traces the primary rays and appends every
+// reflecting hit to the bounce queue; pass k traces the rays queued by pass k-1
+// and replaces the primary ray's hit with the newest reflecting one, so the
+// binning passes see the direction each path finally leaves the target in.
+#define MAX_BOUNCE_PASSES 8  // kMaxRCSBounces
+
+struct BounceRay {
+    vec4 origin;     // xyz = origin, w = path length so far
+    vec4 direction;  // xyz = direction, w = path weight (BounceState::intensity)
+    uint primary;       // Index of the primary ray's hit in the hit buffer
+    uint payloadIndex;  // Its CompactHitBuffer entry, 0xFFFFFFFF = none
+    uint bounce;
+    uint padding;
+};
+
+layout(std430, binding = 15) buffer BounceQueue {
+    uvec4 bounceArgs[MAX_BOUNCE_PASSES];  // Per pass: indirect groups, 1, 1, queued rays
+    BounceRay bounceRays[];               // Two halves of bounceCapacity rays, ping-ponged by pass
+};
+
+#ifdef MULTI_BOUNCE
+uniform int bouncePass;         // 0 = primary rays from the ray buffer
+uniform int maxBounces;
+#else
+const int bouncePass = 0;       // Single-bounce variant: no queue, no bounce passes
+const int maxBounces = 1;
+#endif
+uniform uint bounceCapacity;
+uniform float bounceMaxDistance;
+uniform float bounceCutoff;       // Return below which a path ends (RCSCompute::setBounceTermination)
+uniform float rouletteThreshold;  // Return below which a path plays Russian roulette, 0 = never
+uniform uint rouletteSeed;        // Per compute(), so progressive batches draw afresh
+
+// Ray reordering (RCSCompute::setRayReordering): invocation i traces entry
+// rayOrder[i], a primary ray's index in the tile or, in a bounce pass, a queue
+// index. Results still go to that ray's own slots.
+layout(std430, binding = 21) readonly buffer RayOrder { uint rayOrder[]; };
+uniform bool raysSorted;
+
+// Persistent threads (RCSCompute::setPersistentThreads): one work counter per
+// batched look for the primary pass, then one per bounce pass
+#define MAX_LOOKS 64  // kMaxLooksPerDispatch
+layout(std430, binding = 22) buffer WorkCounters { uint workCounters[]; };
+uniform uint persistentGroups;  // Groups a bounce pass dispatches at most
+
+// Surface materials (RCS::Material), indexed by the triangle's material ID in
+// HitResult::normal.w. IDs past the table use its last entry; an empty table
+// means the default material everywhere.
+struct Material {
+    float reflectivity;
+    float roughness;   // Diffuse share of the BRDF
+    float shininess;   // Specular exponent
+    float absorption;
+};
+layout(std430, binding = 19) readonly buffer MaterialBuffer { Material materials[]; };
+uniform int numMaterials;
+
+Material hitMaterial(HitResult hit) {
+    if (numMaterials == 0) return Material(1.0, 0.3, 32.0, 0.0);
+    return materials[min(uint(hit.normal.w), uint(numMaterials - 1))];
+}
+
+// Enabled BounceEffects with a shader port, spliced in pipeline order by
+// RCSCompute::setBounceEffects (BounceEffect::shaderSource). Each runs on the
+// path weight at every hit, bounce 0 being the primary hit.
+#define MAX_BOUNCE_EFFECTS 8  // kMaxBounceEffects
+#ifndef BOUNCE_EFFECT_CHAIN
+#define BOUNCE_EFFECT_CHAIN
+#endif
+uniform vec4 effectParams[MAX_BOUNCE_EFFECTS];  // BounceEffect::shaderParameters, chain order
+
+float applyBounceEffects(float weight, HitResult hit, Material material, uint bounce) {
+    vec4 params;
+    BOUNCE_EFFECT_CHAIN
+    return weight;
+}
+
+// Shadow map, written by the primary pass as each ray resolves, so the beam's
+// occlusion needs no pass of its own over the hit buffer. Texels follow the ray
+// generation layout (raysPerRing x shadowRings); batched looks leave it alone.
+// The R32F texture is bound as r32ui: non-negative float distances order like
+// their bits, and the -1 miss has the sign bit set, so imageAtomicMin keeps the
+// nearest hit of every ray sharing a texel.
+layout(r32ui, binding = 0) uniform uimage2D shadowMap;
+uniform bool shadowMapEnabled;
+uniform int raysPerRing;
+uniform int numRings;
+uniform int shadowRings;          // Shadow map rows (<= numRings)
+uniform uint rayStride;           // Same progressive order as ray generation
+uniform int totalRays;
+uniform bool scatterByDirection;  // Rays are off the ring grid (other patterns or jitter)
+uniform vec3 beamDirection;
+uniform float beamWidthRad;
+uniform vec3 radarPosition;       // Decoupled shadow pass only
+uniform float maxDistance;
+
+uint progressiveRayId(uint index) {
+    if (rayStride <= 1u) return index;
+    uint total = uint(totalRays);
+    uint r = 0u;
+    for (int shift = 16; shift >= 0; shift -= 8) {
+        uint digit = (rayStride >> uint(shift)) & 0xFFu;
+        r = ((r * 256u) % total + (index * digit) % total) % total;
+    }
+    return r;
+}
 
-uniform int numRays;
-uniform int numNodes;
+// Ray (ring, posInRing) -> texel (posInRing, row); when there are more rings
+// than rows, neighbouring rings share a row
+ivec2 ringTexel(uint rayId) {
+    uint ring = rayId % uint(numRings);
+    return ivec2(int(rayId / uint(numRings)), int((ring * uint(shadowRings)) / uint(numRings)));
+}
+
+// Folds a primary ray's hit distance into its texel. The map is cleared to the
+// -1 miss value before each frame, so misses store nothing.
+void storeShadowTexel(uint index, vec3 worldDir, float hitDistance) {
+    if (hitDistance < 0.0) return;
+    ivec2 texSize = imageSize(shadowMap);
+    ivec2 texel;
+    if (!scatterByDirection) {
+        texel = ringTexel(progressiveRayId(index));
+    } else {
+        // Off-grid rays go to the texel the beam shader's lookup reads for their
+        // direction (RadarBeam worldToShadowMapUV); the nearest ray in a texel wins
+        vec3 forward = normalize(beamDirection);
+        vec3 up = abs(forward.z) < 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+        vec3 right = normalize(cross(forward, up));
+        up = normalize(cross(right, forward));
+        vec3 dir = normalize(worldDir);
+        float elevNorm = acos(clamp(dot(dir, forward), -1.0, 1.0)) / (beamWidthRad * 0.5);
+        float azimuth = atan(dot(dir, up), dot(dir, right));
+        if (azimuth < 0.0) azimuth += 2.0 * 3.14159265;
+        texel.x = clamp(int(azimuth / (2.0 * 3.14159265) * float(texSize.x)), 0, texSize.x - 1);
+        texel.y = clamp(int(floor(elevNorm * float(shadowRings) - 0.5)), 0, shadowRings - 1);
+    }
+    if (texel.x >= texSize.x || texel.y >= texSize.y) return;
+
+    // The beam's fragment shader compares its own distance against this
+    imageAtomicMin(shadowMap, texel, floatBitsToUint(hitDistance));
+}
+
+// Octahedral encoding of a unit vector (zero vector -> +Z)
+uint octEncode(vec3 n) {
+    float s = abs(n.x) + abs(n.y) + abs(n.z);
+    if (s == 0.0) return packSnorm2x16(vec2(0.0));
+    n /= s;
+    vec2 e = n.xy;
+    if (n.z < 0.0) {
+        e = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return packSnorm2x16(e);
+}
+
+CompactHit packHit(HitResult hit, uint distanceOrRayId) {
+    CompactHit c;
+    c.position = hit.hitPoint.xyz;
+    c.distanceOrRayId = distanceOrRayId;
+    c.normalOct = octEncode(hit.normal.xyz);
+    c.reflectionOct = octEncode(hit.reflection.xyz);
+    c.intensityTarget = (packHalf2x16(vec2(hit.reflection.w, 0.0)) & 0xFFFFu) | (hit.targetId << 16);
+    c.triangleId = hit.triangleId;
+    return c;
+}
+
+// Structure-of-arrays payload entry: one float per column, columns compactCapacity apart
+void writeColumns(uint index, HitResult hit) {
+    hitColumns[index] = hit.hitPoint.w;
+    hitColumns[compactCapacity + index] = hit.reflection.x;
+    hitColumns[2u * compactCapacity + index] = hit.reflection.y;
+    hitColumns[3u * compactCapacity + index] = hit.reflection.z;
+    hitColumns[4u * compactCapacity + index] = hit.reflection.w;
+    hitColumns[5u * compactCapacity + index] = hit.hitPoint.x;
+    hitColumns[6u * compactCapacity + index] = hit.hitPoint.y;
+    hitColumns[7u * compactCapacity + index] = hit.hitPoint.z;
+}
 
 // Ray-AABB intersection
 bool intersectAABB(vec3 origin, vec3 invDir, vec3 bmin, vec3 bmax, float tmax) {
@@ -117,11 +611,8 @@ bool intersectAABB(vec3 origin, vec3 invDir, vec3 bmin, vec3 bmax, float tmax) {
     return tenter <= texit && texit >= 0.0 && tenter < tmax;
 }
 
-// Ray-triangle intersection (Moller-Trumbore)
-bool intersectTriangle(vec3 origin, vec3 dir, vec3 v0, vec3 v1, vec3 v2,
-                       out float t, out vec3 normal) {
-    vec3 e1 = v1 - v0;
-    vec3 e2 = v2 - v0;
+// Ray-triangle intersection (Moller-Trumbore) on precomputed edges
+bool intersectTriangle(vec3 origin, vec3 dir, vec3 v0, vec3 e1, vec3 e2, out float t) {
     vec3 h = cross(dir, e2);
     float a = dot(e1, h);
     if (abs(a) < 1e-8) return false;
@@ -136,50 +627,205 @@ bool intersectTriangle(vec3 origin, vec3 dir, vec3 v0, vec3 v1, vec3 v2,
     if (v < 0.0 || u + v > 1.0) return false;
 
     t = f * dot(e2, q);
-    if (t < 0.001) return false;
+    return t >= 0.001;
+}
 
-    normal = normalize(cross(e1, e2));
-    return true;
+// Inverse of octEncode
+vec3 octDecode(uint packed) {
+    vec2 e = unpackSnorm2x16(packed);
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
 }
 
-void main() {
-    uint rayId = gl_GlobalInvocationID.x;
-    if (rayId >= numRays) return;
+// Test a leaf's triangles (object space) and keep the closest hit. Triangles are
+// (v0, normal), (e1, material), (e2, source index) - see RCS::Triangle. Compact
+// triangles are decoded against the leaf box [leafMin, leafMax] the traversal
+// just tested - see RCS::CompactTriangle.
+void testLeaf(int firstTri, int numTris, vec3 leafMin, vec3 leafMax, uint instanceIndex, vec3 origin, vec3 dir,
+              vec3 worldOrigin, vec3 worldDir, inout float closestT, inout HitResult hit) {
+    int triangleOffset = int(instances[instanceIndex].triangleOffset);
+#ifdef COMPACT_TRIANGLES
+    // Power-of-two step per axis: the extent spans fewer than 2^16 steps (RCS::compactStepExponent)
+    ivec3 exponent;
+    frexp(leafMax - leafMin, exponent);
+    vec3 step = ldexp(vec3(1.0), max(exponent - 16, ivec3(-126)));
+#endif
+
+    for (int i = 0; i < numTris; i++) {
+#ifdef COMPACT_TRIANGLES
+        int triIdx = (triangleOffset + firstTri + i) * 3;  // 3 uvec2s per triangle
+        uvec2 w0 = compactTriangles[triIdx + 0];
+        uvec2 w1 = compactTriangles[triIdx + 1];
+        uvec2 w2 = compactTriangles[triIdx + 2];
+        vec3 p0 = leafMin + vec3(w0.x & 0xFFFFu, w0.x >> 16u, w0.y & 0xFFFFu) * step;
+        vec3 p1 = leafMin + vec3(w0.y >> 16u, w1.x & 0xFFFFu, w1.x >> 16u) * step;
+        vec3 p2 = leafMin + vec3(w1.y & 0xFFFFu, w1.y >> 16u, w2.x & 0xFFFFu) * step;
+        vec4 v0 = vec4(p0, uintBitsToFloat(w2.y));
+        vec4 e1 = vec4(p1 - p0, uintBitsToFloat(w2.x >> 16u));
+        vec3 e2 = p2 - p0;
+#else
+        int triIdx = (triangleOffset + firstTri + i) * 3;  // 3 vec4s per triangle
+        vec4 v0 = triangles[triIdx + 0];
+        vec4 e1 = triangles[triIdx + 1];
+        vec4 e2w = triangles[triIdx + 2];
+        vec3 e2 = e2w.xyz;
+#endif
+
+        float t;
+        if (intersectTriangle(origin, dir, v0.xyz, e1.xyz, e2, t) && t < closestT) {
+            closestT = t;
+            vec3 n = octDecode(floatBitsToUint(v0.w));
+            hit.hitPoint = vec4(worldOrigin + worldDir * t, t);
+            hit.normal = vec4(normalize(instances[instanceIndex].normalMatrix * n), float(floatBitsToUint(e1.w)));
+            hit.triangleId = uint(firstTri + i);
+            hit.targetId = instances[instanceIndex].targetId;
+#if defined(TRIANGLE_HOTSPOTS) && !defined(COMPACT_TRIANGLES)
+            hitSource = uint(triangleOffset) + floatBitsToUint(e2w.w);  // RCS::Triangle::sourceIndex
+#endif
+        }
+    }
+}
 
-    Ray ray = rays[rayId];
-    vec3 origin = ray.origin.xyz;
-    vec3 dir = ray.direction.xyz;
+#ifdef WIDE_BVH
+// Slab test along one axis for all four children of a wide node
+void slabAxis(uint quantLo, uint quantHi, float nodeOrigin, float step, float rayOrigin, float invDir,
+              inout vec4 tEnter, inout vec4 tExit) {
+    const uvec4 shifts = uvec4(0u, 8u, 16u, 24u);
+    vec4 lo = nodeOrigin + vec4((uvec4(quantLo) >> shifts) & 0xFFu) * step;
+    vec4 hi = nodeOrigin + vec4((uvec4(quantHi) >> shifts) & 0xFFu) * step;
+    vec4 t1 = (lo - rayOrigin) * invDir;
+    vec4 t2 = (hi - rayOrigin) * invDir;
+    tEnter = max(tEnter, min(t1, t2));
+    tExit = min(tExit, max(t1, t2));
+}
+#endif
+
+// Closest hit in one instance's bottom-level BVH. Traversal runs in object
+// space; the direction is not renormalized, so t stays a world-space distance
+// and closestT carries over between instances unchanged.
+void traceInstance(uint instanceIndex, vec3 worldOrigin, vec3 worldDir,
+                   inout float closestT, inout HitResult hit) {
+    mat4 invModel = instances[instanceIndex].invModel;
+    int nodeOffset = int(instances[instanceIndex].nodeOffset);
+    int numNodes = int(instances[instanceIndex].nodeCount);
+
+    vec3 origin = (invModel * vec4(worldOrigin, 1.0)).xyz;
+    vec3 dir = mat3(invModel) * worldDir;
     vec3 invDir = 1.0 / dir;
-    float tmax = ray.direction.w;
+#ifdef NORMAL_CONE_CULLING
+    float dirLength = length(dir);  // Object-space direction is not unit length
+#endif
+
+#if defined(WIDE_BVH)
+    // Four children per node fetch, their boxes slab-tested together. Leaves are
+    // tested on the spot; internal hits are pushed farthest first so the nearest
+    // pops next. RCSCompute only picks this kernel when 3 * depth + 1 fits the stack.
+    int stack[64];
+    int stackPtr = 0;
+    stack[stackPtr++] = 0;  // Start at root
 
-    // Initialize hit result
-    HitResult hit;
-    hit.hitPoint = vec4(0.0, 0.0, 0.0, -1.0);  // -1 = no hit
-    hit.normal = vec4(0.0);
-    hit.reflection = vec4(0.0);
-    hit.triangleId = 0xFFFFFFFF;
-    hit.rayId = rayId;
-    hit.targetId = 0u;  // Single target for now
-    hit.rcsContribution = 0.0;
+    while (stackPtr > 0) {
+        int nodeIdx = stack[--stackPtr];
+        if (nodeIdx < 0 || nodeIdx >= numNodes) continue;
 
-    if (numNodes == 0) {
-        hits[rayId] = hit;
-        return;
+        WideNode node = wideNodes[nodeOffset + nodeIdx];
+        vec3 step = uintBitsToFloat(((uvec3(node.exponents) >> uvec3(0u, 8u, 16u)) & 0xFFu) << 23u);
+
+        vec4 tEnter = vec4(-1e30);
+        vec4 tExit = vec4(1e30);
+        slabAxis(node.quantLo.x, node.quantHi.x, node.origin.x, step.x, origin.x, invDir.x, tEnter, tExit);
+        slabAxis(node.quantLo.y, node.quantHi.y, node.origin.y, step.y, origin.y, invDir.y, tEnter, tExit);
+        slabAxis(node.quantLo.z, node.quantHi.z, node.origin.z, step.z, origin.z, invDir.z, tEnter, tExit);
+
+        int hitNodes[4];
+        float hitT[4];
+        int numHits = 0;
+        for (int i = 0; i < 4; i++) {
+            uint child = node.children[i];
+            if (child == 0xFFFFFFFFu) continue;
+            if (tEnter[i] > tExit[i] || tExit[i] < 0.0 || tEnter[i] >= closestT) continue;
+
+            if ((child & 0x80000000u) != 0u) {
+                // The child box as slabAxis decoded it
+                uint shift = 8u * uint(i);
+                vec3 leafMin = node.origin + vec3((node.quantLo.xyz >> shift) & 0xFFu) * step;
+                vec3 leafMax = node.origin + vec3((node.quantHi.xyz >> shift) & 0xFFu) * step;
+                testLeaf(int(child & 0xFFFFFFu), int((child >> 24u) & 0x7Fu), leafMin, leafMax, instanceIndex,
+                         origin, dir, worldOrigin, worldDir, closestT, hit);
+            } else {
+                // Keep hitT descending (farthest first)
+                int j = numHits++;
+                while (j > 0 && hitT[j - 1] < tEnter[i]) {
+                    hitNodes[j] = hitNodes[j - 1];
+                    hitT[j] = hitT[j - 1];
+                    j--;
+                }
+                hitNodes[j] = int(child);
+                hitT[j] = tEnter[i];
+            }
+        }
+        for (int j = 0; j < numHits; j++) {
+            if (stackPtr < 64) {
+                stack[stackPtr++] = hitNodes[j];
+            }
+        }
     }
+#elif defined(STACKLESS_TRAVERSAL)
+    // Stackless traversal over the depth-first layout: descend into the left
+    // child on a hit, otherwise follow the skip link. No per-invocation stack,
+    // and every node is visited at most once whatever the tree depth.
+    int nodeIdx = 0;
+    while (nodeIdx >= 0 && nodeIdx < numNodes) {
+        BVHNode node = nodes[nodeOffset + nodeIdx];
+        int skip = skipLinks[nodeOffset + nodeIdx];
+
+#ifdef NORMAL_CONE_CULLING
+        if (facesAway(nodeOffset + nodeIdx, dir, dirLength)) {
+            nodeIdx = skip;
+            continue;
+        }
+#endif
+        if (!intersectAABB(origin, invDir, node.boundsMin.xyz, node.boundsMax.xyz, closestT)) {
+            nodeIdx = skip;
+            continue;
+        }
 
-    // Stack-based BVH traversal
+        int leftInfo = int(node.boundsMin.w);
+        if (leftInfo < 0) {
+#ifdef TEMPORAL_REUSE
+            float leafT = closestT;
+#endif
+            testLeaf(-leftInfo - 1, int(node.boundsMax.w), node.boundsMin.xyz, node.boundsMax.xyz,
+                     instanceIndex, origin, dir, worldOrigin, worldDir, closestT, hit);
+#ifdef TEMPORAL_REUSE
+            if (closestT < leafT) hitLeaf = uvec2(instanceIndex, uint(nodeIdx));
+#endif
+            nodeIdx = skip;
+        } else {
+            nodeIdx++;  // Left child
+        }
+    }
+#else
+    // Stack-based BVH traversal. RCSCompute switches to the stackless kernel for
+    // trees deeper than the stack, so the overflow guard never drops a subtree.
     int stack[64];
     int stackPtr = 0;
     stack[stackPtr++] = 0;  // Start at root
 
-    float closestT = tmax;
-
     while (stackPtr > 0) {
         int nodeIdx = stack[--stackPtr];
         if (nodeIdx < 0 || nodeIdx >= numNodes) continue;
 
-        BVHNode node = nodes[nodeIdx];
+        BVHNode node = nodes[nodeOffset + nodeIdx];
 
+#ifdef NORMAL_CONE_CULLING
+        if (facesAway(nodeOffset + nodeIdx, dir, dirLength)) {
+            continue;
+        }
+#endif
         if (!intersectAABB(origin, invDir, node.boundsMin.xyz, node.boundsMax.xyz, closestT)) {
             continue;
         }
@@ -188,77 +834,486 @@ void main() {
 
         if (leftInfo < 0) {
             // Leaf node - test triangles
-            int firstTri = -leftInfo - 1;
-            int numTris = int(node.boundsMax.w);
-
-            for (int i = 0; i < numTris; i++) {
-                int triIdx = (firstTri + i) * 3;  // 3 vec4s per triangle
-                vec3 v0 = triangles[triIdx + 0].xyz;
-                vec3 v1 = triangles[triIdx + 1].xyz;
-                vec3 v2 = triangles[triIdx + 2].xyz;
-
-                float t;
-                vec3 n;
-                if (intersectTriangle(origin, dir, v0, v1, v2, t, n) && t < closestT) {
-                    closestT = t;
-                    hit.hitPoint = vec4(origin + dir * t, t);
-                    hit.normal = vec4(n, 0.0);
-                    hit.triangleId = uint(firstTri + i);
-                }
-            }
+#ifdef TEMPORAL_REUSE
+            float leafT = closestT;
+#endif
+            testLeaf(-leftInfo - 1, int(node.boundsMax.w), node.boundsMin.xyz, node.boundsMax.xyz,
+                     instanceIndex, origin, dir, worldOrigin, worldDir, closestT, hit);
+#ifdef TEMPORAL_REUSE
+            if (closestT < leafT) hitLeaf = uvec2(instanceIndex, uint(nodeIdx));
+#endif
         } else {
-            // Internal node - push children
+            // Internal node - w is the split axis and the left child (the low
+            // side) is the next node. Visit the side the ray enters first.
+            int leftChild = nodeIdx + 1;
             int rightChild = int(node.boundsMax.w);
+            bool rightFirst = dir[leftInfo] < 0.0;
             if (stackPtr < 62) {
-                stack[stackPtr++] = rightChild;
-                stack[stackPtr++] = leftInfo;  // Left child (process first)
+                stack[stackPtr++] = rightFirst ? leftChild : rightChild;
+                stack[stackPtr++] = rightFirst ? rightChild : leftChild;  // Near child (process first)
             }
         }
     }
+#endif
+}
 
-    // Calculate reflection and intensity if we hit something
-    if (hit.hitPoint.w > 0.0) {
-        vec3 incident = normalize(dir);
-        vec3 n = normalize(hit.normal.xyz);
+// Closed-form test of a unit primitive (RCS::Traversal::intersectPrimitive):
+// sphere of radius 1, capped cylinder of radius 1 over z in [-1, 1], or the
+// two-sided square x, y in [-1, 1] at z = 0. Same t convention as the meshes.
+bool intersectPrimitive(uint shape, vec3 origin, vec3 dir, float tmax, out float t, out vec3 n) {
+    t = tmax;
+    n = vec3(0.0, 0.0, 1.0);
+    if (shape == 0u) {
+        // Chord about the point nearest the centre, stable for a far radar
+        float a = dot(dir, dir);
+        float tc = -dot(origin, dir) / a;
+        vec3 closest = origin + dir * tc;
+        float h2 = 1.0 - dot(closest, closest);
+        if (h2 < 0.0) return false;
+        float dt = sqrt(h2 / a);
+        float hitT = tc - dt >= 0.001 ? tc - dt : tc + dt;
+        if (hitT < 0.001 || hitT >= tmax) return false;
+        t = hitT;
+        n = origin + dir * hitT;
+        return true;
+    }
+    if (shape == 1u) {
+        bool found = false;
+        float a = dot(dir.xy, dir.xy);
+        if (a > 1e-12) {
+            float tc = -dot(origin.xy, dir.xy) / a;
+            vec2 closest = origin.xy + dir.xy * tc;
+            float h2 = 1.0 - dot(closest, closest);
+            if (h2 >= 0.0) {
+                float dt = sqrt(h2 / a);
+                for (int k = 0; k < 2; k++) {
+                    // Near side first; the far one counts where the near is past an end
+                    float sideT = k == 0 ? tc - dt : tc + dt;
+                    vec3 p = origin + dir * sideT;
+                    if (sideT >= 0.001 && sideT < t && abs(p.z) <= 1.0) {
+                        t = sideT;
+                        n = vec3(p.xy, 0.0);
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (abs(dir.z) > 1e-12) {
+            for (int i = 0; i < 2; i++) {
+                float z = i == 0 ? 1.0 : -1.0;
+                float capT = (z - origin.z) / dir.z;
+                vec3 p = origin + dir * capT;
+                if (capT >= 0.001 && capT < t && dot(p.xy, p.xy) <= 1.0) {
+                    t = capT;
+                    n = vec3(0.0, 0.0, z);
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+    if (abs(dir.z) < 1e-12) return false;
+    float hitT = -origin.z / dir.z;
+    if (hitT < 0.001 || hitT >= tmax) return false;
+    vec2 p = origin.xy + dir.xy * hitT;
+    if (abs(p.x) > 1.0 || abs(p.y) > 1.0) return false;
+    t = hitT;
+    n = vec3(0.0, 0.0, dir.z < 0.0 ? 1.0 : -1.0);  // Facing the ray
+    return true;
+}
+
+// Closest hit among the analytic primitives. No acceleration structure: a
+// reference target is a handful of primitives, fewer tests than the top of a
+// tessellated mesh's tree.
+void tracePrimitives(vec3 worldOrigin, vec3 worldDir, inout float closestT, inout HitResult hit) {
+    for (int i = 0; i < numPrimitives; i++) {
+        mat4 invModel = primitives[i].invModel;
+        vec3 origin = (invModel * vec4(worldOrigin, 1.0)).xyz;
+        vec3 dir = mat3(invModel) * worldDir;
+        float t;
+        vec3 n;
+        if (intersectPrimitive(primitives[i].shape, origin, dir, closestT, t, n)) {
+            closestT = t;
+            hit.hitPoint = vec4(worldOrigin + worldDir * t, t);
+            hit.normal = vec4(normalize(primitives[i].normalMatrix * n), float(primitives[i].materialId));
+            hit.triangleId = uint(i);
+            hit.targetId = primitives[i].targetId;
+#ifdef TEMPORAL_REUSE
+            hitLeaf = uvec2(0xFFFFFFFFu);  // Primitives are not seeded
+#endif
+#ifdef TRIANGLE_HOTSPOTS
+            hitSource = 0xFFFFFFFFu;  // Primitives have no triangles
+#endif
+        }
+    }
+}
+
+#define TLAS_STACK_SIZE 32  // kTLASStackSize
+
+// Closest hit over the whole scene. The top level is walked in world space;
+// only instances whose bounds the ray reaches (before the closest hit so far)
+// descend into their mesh's tree, then the analytic primitives are tested.
+// hit.hitPoint.w stays -1 on a miss.
+void traceScene(vec3 worldOrigin, vec3 worldDir, float tmax, inout HitResult hit) {
+    vec3 worldInvDir = 1.0 / worldDir;
+    float closestT = tmax;
+
+    int tlasStack[TLAS_STACK_SIZE];  // TLASBuilder keeps the depth within it
+    int tlasPtr = 0;
+    tlasStack[tlasPtr++] = 0;
+
+    while (tlasPtr > 0) {
+        int nodeIdx = tlasStack[--tlasPtr];
+        if (nodeIdx < 0 || nodeIdx >= numTlasNodes) continue;
+
+        BVHNode node = tlasNodes[nodeIdx];
+        if (!intersectAABB(worldOrigin, worldInvDir, node.boundsMin.xyz, node.boundsMax.xyz, closestT)) {
+            continue;
+        }
+
+        int leftInfo = int(node.boundsMin.w);
+        if (leftInfo < 0) {
+            int firstInstance = -leftInfo - 1;
+            int numInstances = int(node.boundsMax.w);
+            for (int i = 0; i < numInstances; i++) {
+                traceInstance(uint(firstInstance + i), worldOrigin, worldDir, closestT, hit);
+            }
+        } else if (tlasPtr + 2 <= TLAS_STACK_SIZE) {
+            // Near child on top, as in traceInstance
+            bool rightFirst = worldDir[leftInfo] < 0.0;
+            tlasStack[tlasPtr++] = rightFirst ? nodeIdx + 1 : int(node.boundsMax.w);
+            tlasStack[tlasPtr++] = rightFirst ? int(node.boundsMax.w) : nodeIdx + 1;
+        }
+    }
 
-        // Check if surface is facing the radar (front-facing)
-        // dot(n, -incident) > 0 means normal points toward radar
-        float facing = dot(n, -incident);
+    tracePrimitives(worldOrigin, worldDir, closestT, hit);
+}
+
+#ifdef TEMPORAL_REUSE
+// Re-tests the leaf a ray's previous trace hit. Whatever it finds is a hit on
+// the current scene, so it can only bound the full traversal that follows:
+// boxes behind it are skipped, and the closest hit stays exact.
+void testSeedLeaf(uvec2 seed, vec3 worldOrigin, vec3 worldDir, inout float closestT, inout HitResult hit) {
+    if (seed.x >= uint(instances.length()) || seed.y >= instances[seed.x].nodeCount) return;
+    BVHNode node = nodes[instances[seed.x].nodeOffset + seed.y];
+    int leftInfo = int(node.boundsMin.w);
+    if (leftInfo >= 0) return;  // The tree changed under the seed
+
+    mat4 invModel = instances[seed.x].invModel;
+    vec3 origin = (invModel * vec4(worldOrigin, 1.0)).xyz;
+    vec3 dir = mat3(invModel) * worldDir;
+    float leafT = closestT;
+    testLeaf(-leftInfo - 1, int(node.boundsMax.w), node.boundsMin.xyz, node.boundsMax.xyz,
+             seed.x, origin, dir, worldOrigin, worldDir, closestT, hit);
+    if (closestT < leafT) hitLeaf = seed;
+}
+#endif
+
+// Reflection and intensity of a hit
+void shadeHit(vec3 worldDir, Material material, inout HitResult hit) {
+    vec3 incident = normalize(worldDir);
+    vec3 n = normalize(hit.normal.xyz);
+
+    // Check if surface is facing the radar (front-facing)
+    // dot(n, -incident) > 0 means normal points toward radar
+    float facing = dot(n, -incident);
+
+    if (facing > 0.0) {
+        // Front-facing surface - calculate reflection
+        vec3 reflectDir = reflect(incident, n);
+
+        // BRDF-based intensity calculation
+        float k_d = material.roughness;        // Diffuse coefficient
+        float k_s = 1.0 - material.roughness;  // Specular coefficient
+        float shininess = material.shininess;
+
+        float cosTheta = facing;  // Already computed above
+        float diffuse = k_d * cosTheta;
+        float specular = k_s * pow(cosTheta, shininess);
+        float intensity = clamp(diffuse + specular, 0.0, 1.0);
+
+        hit.reflection = vec4(reflectDir, intensity);
+    } else {
+        // Back-facing surface - no reflection (intensity = 0)
+        hit.reflection = vec4(0.0, 0.0, 0.0, 0.0);
+    }
+}
 
-        if (facing > 0.0) {
-            // Front-facing surface - calculate reflection
-            vec3 reflectDir = reflect(incident, n);
+// Whether a reflecting hit's path goes on to the next bounce. A return at or
+// under bounceCutoff just ends the path here. Under rouletteThreshold the path
+// survives with probability return / rouletteThreshold; a survivor's weight
+// and the hit's own return are both divided by that, since the hit stays the
+// path's exit when the next bounce misses. A path that loses returns nothing,
+// so the expected return is unchanged and late bounces stop occupying lanes.
+bool continuePath(inout HitResult hit, inout float weight, uint bounce) {
+    float energy = hit.reflection.w;
+    if (energy <= bounceCutoff) return false;
+    if (energy >= rouletteThreshold) return true;
+
+    float survival = energy / rouletteThreshold;
+    uint h = (hit.rayId * 0x9E3779B9u) ^ (bounce * 0x85EBCA6Bu) ^ rouletteSeed;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    if (float(h >> 8) * (1.0 / 16777216.0) < survival) {
+        weight /= survival;
+        hit.reflection.w /= survival;
+        return true;
+    }
+    hit.reflection.w = 0.0;
+    return false;
+}
 
-            // BRDF-based intensity calculation
-            float k_d = 0.3;  // Diffuse coefficient
-            float k_s = 0.7;  // Specular coefficient
-            float shininess = 32.0;
+// Queues the reflected ray of a hit for the next pass, carrying the path
+// weight the effect chain left at this hit. Only surviving paths are
+// appended, so the next pass's dispatch is already compacted to them.
+void enqueueBounce(HitResult hit, uint primary, uint payloadIndex, uint bounce, float pathLength, float weight) {
+    uint index = atomicAdd(bounceArgs[bounce].w, 1u);
+    if (index >= bounceCapacity) return;
+#ifdef PERSISTENT_THREADS
+    atomicMax(bounceArgs[bounce].x, min(index / 64u + 1u, persistentGroups));
+#else
+    atomicMax(bounceArgs[bounce].x, index / 64u + 1u);
+#endif
+
+    BounceRay ray;
+    ray.origin = vec4(hit.hitPoint.xyz + hit.normal.xyz * 0.01, pathLength);  // traceDebugRayMultiBounce epsilon
+    ray.direction = vec4(hit.reflection.xyz, weight);
+    ray.primary = primary;
+    ray.payloadIndex = payloadIndex;
+    ray.bounce = bounce;
+    ray.padding = 0u;
+    bounceRays[(bounce & 1u) * bounceCapacity + index] = ray;
+}
 
-            float cosTheta = facing;  // Already computed above
-            float diffuse = k_d * cosTheta;
-            float specular = k_s * pow(cosTheta, shininess);
-            float intensity = clamp(diffuse + specular, 0.0, 1.0);
+// Pass k > 0: one queued reflection. A miss leaves the previous hit as the
+// path's exit; a back face blocks the path (intensity 0).
+void traceBounce(uint queueIndex) {
+    uint bounce = uint(bouncePass);
+    if (queueIndex >= min(bounceArgs[bounce].w, bounceCapacity)) return;
+    if (raysSorted) {
+        queueIndex = rayOrder[queueIndex];  // Queued rays sort ahead of the unused entries
+    }
+    BounceRay ray = bounceRays[(bounce & 1u) * bounceCapacity + queueIndex];
 
-            hit.reflection = vec4(reflectDir, intensity);
+    HitResult hit;
+    hit.hitPoint = vec4(0.0, 0.0, 0.0, -1.0);
+    hit.normal = vec4(0.0);
+    hit.reflection = vec4(0.0);
+    hit.triangleId = 0xFFFFFFFF;
+    hit.rayId = hits[ray.primary].rayId;
+    hit.targetId = 0u;
+    hit.rcsContribution = hits[ray.primary].rcsContribution;
+
+    traceScene(ray.origin.xyz, ray.direction.xyz, bounceMaxDistance, hit);
+    if (hit.hitPoint.w < 0.0) return;
+
+    Material material = hitMaterial(hit);
+    shadeHit(ray.direction.xyz, material, hit);
+    float weight = applyBounceEffects(ray.direction.w, hit, material, bounce);
+    float pathLength = ray.origin.w + hit.hitPoint.w;
+    hit.hitPoint.w = pathLength;  // Distance along the whole path
+    hit.reflection.w *= weight;
+    bool next = hit.reflection.w > 0.0 && int(bounce) + 1 < maxBounces && continuePath(hit, weight, bounce);
+    hits[ray.primary] = hit;
+    if (ray.payloadIndex != 0xFFFFFFFFu) {
+        if (hitPayload == 4) {
+            writeColumns(ray.payloadIndex, hit);
         } else {
-            // Back-facing surface - no reflection (intensity = 0)
-            hit.reflection = vec4(0.0, 0.0, 0.0, 0.0);
+            compactHits[ray.payloadIndex] = packHit(hit, hitPayload == 2 ? hit.rayId : floatBitsToUint(pathLength));
+        }
+    }
+
+    if (next) {
+        enqueueBounce(hit, ray.primary, ray.payloadIndex, bounce + 1u, pathLength, weight);
+    }
+}
+
+// Decoupled shadow pass (RCSCompute::setShadowResolution): one ray per texel of
+// the map's own ring grid, occlusion only - no shading, counters or payloads.
+// Texel (x, y) is ring y at azimuth step x, where the beam shader looks it up.
+void traceShadowTexel(uint texelIndex) {
+    ivec2 texSize = imageSize(shadowMap);
+    if (texelIndex >= uint(texSize.x * texSize.y)) return;
+    ivec2 texel = ivec2(int(texelIndex % uint(texSize.x)), int(texelIndex / uint(texSize.x)));
+
+    float ringAngle = beamWidthRad * 0.5 * float(texel.y + 1) / float(texSize.y);
+    float azimuth = 2.0 * 3.14159265 * float(texel.x) / float(texSize.x);
+    vec3 forward = normalize(beamDirection);
+    vec3 up = abs(forward.z) < 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 right = normalize(cross(forward, up));
+    up = normalize(cross(right, forward));
+    vec3 dir = sin(ringAngle) * (cos(azimuth) * right + sin(azimuth) * up) + cos(ringAngle) * forward;
+
+    HitResult hit;
+    hit.hitPoint = vec4(0.0, 0.0, 0.0, -1.0);
+    hit.normal = vec4(0.0);
+    hit.reflection = vec4(0.0);
+    hit.triangleId = 0xFFFFFFFF;
+    hit.rayId = texelIndex;
+    hit.targetId = 0u;
+    hit.rcsContribution = 0.0;
+    if (numTlasNodes > 0 || numPrimitives > 0) {
+        traceScene(radarPosition, normalize(dir), maxDistance, hit);
+    }
+    imageStore(shadowMap, texel, uvec4(floatBitsToUint(hit.hitPoint.w), 0u, 0u, 0u));
+}
+
+// Pass 0: primary ray localId of a tile. Batched looks trace
+// gl_GlobalInvocationID.y blocks of numRays rays.
+void tracePrimary(uint localId, uint look) {
+    if (localId >= numRays) return;
+    if (raysSorted) {
+        // Trace in sorted order; everything below is keyed by the original ray
+        localId = rayOrder[localId];
+    }
+    uint rayIndex = look * uint(numRays) + localId;
+
+    Ray ray = rays[rayIndex];
+    vec3 worldOrigin = ray.origin.xyz;
+    vec3 worldDir = ray.direction.xyz;
+    float tmax = ray.direction.w;
+
+    // Initialize hit result
+    HitResult hit;
+    hit.hitPoint = vec4(0.0, 0.0, 0.0, -1.0);  // -1 = no hit
+    hit.normal = vec4(0.0);
+    hit.reflection = vec4(0.0);
+    hit.triangleId = 0xFFFFFFFF;
+    hit.rayId = uint(rayOffset) + localId;
+    hit.targetId = 0u;
+    hit.rcsContribution = raySolidAngle;
+
+    // Dense payloads (compact and columns) hold the frame's first tile
+    bool densePayload = (hitPayload == 1 || hitPayload == 4) && rayOffset == payloadOffset;
+
+    if (numTlasNodes == 0 && numPrimitives == 0) {
+        hits[rayIndex] = hit;
+        if (shadowMapEnabled) {
+            storeShadowTexel(hit.rayId, worldDir, -1.0);
+        }
+        if (densePayload && hitPayload == 4) {
+            writeColumns(localId, hit);
+        } else if (densePayload) {
+            compactHits[localId] = packHit(hit, floatBitsToUint(-1.0));
+        }
+        return;
+    }
+
+#ifdef TRIANGLE_HOTSPOTS
+    hitSource = 0xFFFFFFFFu;
+#endif
+#ifdef TEMPORAL_REUSE
+    // The leaf this ray hit last time first; on a hit the traversal only has
+    // to look in front of it, on a miss it runs in full
+    bool seeded = seedRays && hit.rayId < seedCapacity;
+    hitLeaf = uvec2(0xFFFFFFFFu);
+    if (seeded) {
+        testSeedLeaf(temporalSeeds[hit.rayId], worldOrigin, worldDir, tmax, hit);
+    }
+#endif
+    traceScene(worldOrigin, worldDir, tmax, hit);
+#ifdef TEMPORAL_REUSE
+    if (seeded) {
+        temporalSeeds[hit.rayId] = hit.hitPoint.w > 0.0 ? hitLeaf : uvec2(0xFFFFFFFFu);
+    }
+#endif
+
+    // Calculate reflection and intensity if we hit something
+    uint payloadIndex = densePayload ? localId : 0xFFFFFFFFu;
+    if (hit.hitPoint.w > 0.0) {
+        Material material = hitMaterial(hit);
+        shadeHit(worldDir, material, hit);
+        float weight = applyBounceEffects(ray.origin.w, hit, material, 0u);  // Seeded by the beam pattern
+        hit.reflection.w *= weight;
+        bool next = maxBounces > 1 && hit.reflection.w > 0.0 && continuePath(hit, weight, 0u);
+#ifdef TRIANGLE_HOTSPOTS
+        // Primary return only: the triangle the radar sees light up
+        uint hotspot = uint(clamp(hit.reflection.w, 0.0, 1.0) * hotspotScale + 0.5);
+        if (hotspotRays && hitSource != 0xFFFFFFFFu && 1u + hitSource < uint(hotspots.length()) && hotspot > 0u) {
+            uint sum = atomicAdd(hotspots[1u + hitSource], hotspot) + hotspot;
+            atomicMax(hotspots[0], sum);
+        }
+#endif
+
+        // Increment hit counter - doubles as the append index for hits-only output
+        uint hitIndex = atomicAdd(hitCounter[look], 1u);
+        if (hitPayload == 2 && hitIndex < compactCapacity) {
+            compactHits[hitIndex] = packHit(hit, hit.rayId);
+            payloadIndex = hitIndex;
+        }
+
+        if (next) {
+            enqueueBounce(hit, rayIndex, payloadIndex, 1u, hit.hitPoint.w, weight);
         }
+    }
+
+    // Write result. The shadow map takes the primary distance, before any
+    // bounce pass replaces the hit.
+    hits[rayIndex] = hit;
+    if (shadowMapEnabled) {
+        storeShadowTexel(hit.rayId, worldDir, hit.hitPoint.w);
+    }
 
-        // Increment hit counter
-        atomicAdd(hitCounter, 1u);
+    // Dense payloads hold the frame's first tile, with rayId implicit in the index
+    if (densePayload && hitPayload == 4) {
+        writeColumns(localId, hit);
+    } else if (densePayload) {
+        compactHits[localId] = packHit(hit, floatBitsToUint(hit.hitPoint.w));
     }
+}
 
-    // Write result
-    hits[rayId] = hit;
+void main() {
+    uint localId = gl_GlobalInvocationID.x;
+#ifdef SHADOW_VISIBILITY
+    traceShadowTexel(localId);
+    return;
+#endif
+#ifdef PERSISTENT_THREADS
+    // Only enough groups to fill the GPU; each lane takes the pass's next ray
+    // from a shared counter until none are left, so lanes whose rays finish
+    // early pick up more instead of idling beside a deep traversal
+    uint look = gl_GlobalInvocationID.y;
+    uint workCount = bouncePass > 0 ? min(bounceArgs[bouncePass].w, bounceCapacity) : uint(numRays);
+    uint counter = bouncePass > 0 ? uint(MAX_LOOKS + bouncePass) : look;
+    for (;;) {
+        uint item = atomicAdd(workCounters[counter], 1u);
+        if (item >= workCount) break;
+        if (bouncePass > 0) {
+            traceBounce(item);
+        } else {
+            tracePrimary(item, look);
+        }
+    }
+#else
+    if (bouncePass > 0) {
+        traceBounce(localId);
+        return;
+    }
+    tracePrimary(localId, gl_GlobalInvocationID.y);
+#endif
 }
 )";
 
-// Compute shader source: Shadow Map Generation
-static const char* shadowMapShaderSource = R"(
+// Compute shader source: Polar plot + heat map binning
+// Mirrors AzimuthCutSampler / ElevationCutSampler / HeatMapRenderer::accumulateHit so
+// every traced ray (all tiles) is binned without reading the hit buffer back.
+// Intensities are summed in fixed point with an explicit carry into a high word,
+// since core GL 4.3 has no float atomics.
+// FREQUENCY_BINNING builds the physical-optics variant: every hit in the polar
+// slice adds its complex field sqrt(intensity) * exp(-i k L) to one bin per
+// (angle, frequency). gl_WorkGroupID.y selects a block of kFrequencyBlock
+// frequencies; within it the phasor is advanced by one complex multiply per
+// frequency, so the trig cost is per hit and block, not per frequency.
+static const char* binningShaderSource = R"(
 #version 430 core
 layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
 
+#define POLAR_BINS 360  // kPolarPlotBins
+
 struct HitResult {
     vec4 hitPoint;   // xyz = position, w = distance (-1 = miss)
     vec4 normal;     // xyz = normal, w = material
@@ -269,35 +1324,780 @@ struct HitResult {
     float rcsContribution;
 };
 
+struct PolarBin {
+    uint intensityLo;
+    uint intensityHi;
+    uint hitCount;
+    uint padding;
+};
+
+struct Look {
+    vec4 radarPosition;
+    vec4 beamDirection;
+    vec4 slice;  // cutType, offset, thickness, minIntensity
+};
+
 layout(std430, binding = 3) readonly buffer HitBuffer { HitResult hits[]; };
-layout(r32f, binding = 0) uniform image2D shadowMap;
+layout(std430, binding = 5) buffer PolarBinBuffer { PolarBin polarBins[]; };  // POLAR_BINS per look
+layout(std430, binding = 11) readonly buffer LookBuffer { Look looks[]; };
+layout(std430, binding = 6) buffer HeatMapBinBuffer { uint heatBins[]; };  // lo, hi, count per bin
+
+uniform int numRays;  // Rays in this tile (per look)
+uniform float intensityScale;
+uniform int numLooks;  // 0 = single look, polar slice from the uniforms below
+
+uniform bool polarEnabled;
+uniform int uPolarCutType;  // 0 = azimuth, 1 = elevation
+uniform float uPolarOffset;
+uniform float uPolarThickness;
+uniform float uPolarMinIntensity;  // Hits below it are left out of the polar bins
+
+// Active polar slice - the uniforms, or the look's own slice when batched
+int polarCutType;
+float polarOffset;
+float polarThickness;
+float polarMinIntensity;
+
+#ifdef FREQUENCY_BINNING
+#define FREQ_BLOCK 8  // kFrequencyBlock
+
+// Signed 64-bit fixed point per component (two's complement lo/hi)
+struct FrequencyBin {
+    uint realLo;
+    int realHi;
+    uint imagLo;
+    int imagHi;
+};
 
-uniform int numRays;
-uniform int raysPerRing;
-uniform int numRings;
+layout(std430, binding = 16) buffer FrequencyBinBuffer { FrequencyBin frequencyBins[]; };  // POLAR_BINS x numFrequencies
+
+uniform int numFrequencies;
+uniform float waveNumberStart;  // Radians per scene unit at the first frequency
+uniform float waveNumberStep;   // Increment between frequency points
+uniform float referencePath;    // Common path length removed before the phase (keeps float precision)
+uniform float fieldScale;
+
+shared int sFieldRe[POLAR_BINS * FREQ_BLOCK];
+shared int sFieldIm[POLAR_BINS * FREQ_BLOCK];
+#endif
+
+// Full-sphere cells by reflection direction (no slice filter)
+uniform bool sphereEnabled;
+uniform int sphereAzBins;
+uniform int sphereElBins;
+layout(std430, binding = 17) buffer SphereBinBuffer { PolarBin sphereBins[]; };  // Elevation-major
+
+uniform bool heatMapEnabled;
+uniform int heatCutType;
+uniform float heatOffset;
+uniform float heatThickness;
+uniform float heatMinIntensity;
+uniform int heatLatBins;
+uniform int heatLonBins;
+
+#ifndef FREQUENCY_BINNING
+// Workgroup-local polar bins, flushed to the global buffer once per workgroup
+shared uint sPolarLo[POLAR_BINS];
+shared uint sPolarHi[POLAR_BINS];
+shared uint sPolarCount[POLAR_BINS];
+
+// Bistatic receivers: far-field directions four to a vec4 per axis, so each
+// hit is tested against four receivers with three multiply-adds
+#define MAX_RECEIVERS 8  // kMaxReceivers
+uniform int numReceivers;
+uniform float receiverCosAcceptance;
+uniform vec4 receiverX[MAX_RECEIVERS / 4];
+uniform vec4 receiverY[MAX_RECEIVERS / 4];
+uniform vec4 receiverZ[MAX_RECEIVERS / 4];
+layout(std430, binding = 18) buffer ReceiverBinBuffer { PolarBin receiverBins[]; };
+
+shared uint sReceiverLo[MAX_RECEIVERS];
+shared uint sReceiverHi[MAX_RECEIVERS];
+shared uint sReceiverCount[MAX_RECEIVERS];
+#endif
+
+const float PI = 3.14159265358979;
+
+// atan2 with the CPU convention atan2(0, 0) = 0
+float azimuthRadians(vec3 d) {
+    if (d.x == 0.0 && d.y == 0.0) return 0.0;
+    return atan(d.y, d.x);
+}
 
-void main() {
-    uint rayId = gl_GlobalInvocationID.x;
-    if (rayId >= numRays) return;
+float elevationRadians(vec3 d) {
+    return asin(clamp(d.z, -1.0, 1.0));
+}
 
-    HitResult hit = hits[rayId];
+// Returns the polar bin for a reflection direction, or -1 if outside the slice
+int polarBinIndex(vec3 dir) {
+    float elevationDeg = degrees(elevationRadians(dir));
+    float azimuthDeg = degrees(azimuthRadians(dir));
 
-    // Calculate texel coordinates directly from ray index
-    // Shadow map is raysPerRing x numRings, so ray (ring, posInRing) -> texel (posInRing, ring)
-    uint ring = rayId / uint(raysPerRing);
-    uint posInRing = rayId % uint(raysPerRing);
+    if (polarCutType == 0) {
+        // Azimuth cut: slice by elevation, bin by azimuth [0, 360)
+        if (abs(elevationDeg - polarOffset) > polarThickness) return -1;
+        if (azimuthDeg < 0.0) azimuthDeg += 360.0;
+        return clamp(int(floor(azimuthDeg)), 0, POLAR_BINS - 1);
+    }
 
-    // Direct 1:1 mapping to texels
-    ivec2 texCoord = ivec2(int(posInRing), int(ring));
+    // Elevation cut: slice by azimuth on both sides of the vertical plane
+    float offsetNorm = polarOffset - 360.0 * floor((polarOffset + 180.0) / 360.0);
 
-    // Bounds check
-    ivec2 texSize = imageSize(shadowMap);
-    if (texCoord.x >= texSize.x || texCoord.y >= texSize.y) return;
+    float delta1 = abs(azimuthDeg - offsetNorm);
+    if (delta1 > 180.0) delta1 = 360.0 - delta1;
 
-    // Store hit distance (positive = hit at that distance, negative = no hit)
-    // Fragment shader will compare its distance to determine if it's in shadow
-    float hitDistance = hit.hitPoint.w;  // -1 for miss, positive for hit distance
-    imageStore(shadowMap, texCoord, vec4(hitDistance, 0.0, 0.0, 1.0));
+    float oppositeAzimuth = offsetNorm + 180.0;
+    if (oppositeAzimuth >= 180.0) oppositeAzimuth -= 360.0;
+    float delta2 = abs(azimuthDeg - oppositeAzimuth);
+    if (delta2 > 180.0) delta2 = 360.0 - delta2;
+
+    if (min(delta1, delta2) > polarThickness) return -1;
+
+    float delta = azimuthDeg - offsetNorm;
+    if (delta > 180.0) delta -= 360.0;
+    if (delta < -180.0) delta += 360.0;
+
+    // Front side: -90 -> 0, +90 -> 180. Back side: +90 -> 180, -90 -> 360
+    float binPos = abs(delta) <= 90.0 ? elevationDeg + 90.0 : 270.0 - elevationDeg;
+    return clamp(int(floor(binPos + 0.5)), 0, POLAR_BINS - 1);
+}
+
+bool inHeatMapSlice(vec3 dir) {
+    if (heatCutType == 0) {
+        float elevationDeg = degrees(elevationRadians(dir));
+        return abs(elevationDeg - heatOffset) <= heatThickness;
+    }
+    float azimuthDeg = degrees(azimuthRadians(dir));
+    if (azimuthDeg < 0.0) azimuthDeg += 360.0;
+    float delta = abs(azimuthDeg - heatOffset);
+    if (delta > 180.0) delta = 360.0 - delta;
+    return delta <= heatThickness;
+}
+
+int heatMapBinIndex(vec3 dir) {
+    float theta = azimuthRadians(dir);
+    float phi = elevationRadians(dir);
+    if (theta < 0.0) theta += 2.0 * PI;
+    int lonBin = clamp(int(theta / (2.0 * PI) * float(heatLonBins)), 0, heatLonBins - 1);
+    int latBin = clamp(int((PI / 2.0 - phi) / PI * float(heatLatBins)), 0, heatLatBins - 1);
+    return latBin * heatLonBins + lonBin;
+}
+
+#ifdef EDGE_DIFFRACTION
+// Crease edges of one instance (RCSCompute::setMeshEdges), one per invocation
+#define EDGE_MIN_DENOMINATOR 0.05  // kEdgeDiffractionMinDenominator
+#define EDGE_MIN_INTENSITY 0.001   // kEdgeDiffractionMinIntensity
+
+struct DiffractionEdge {
+    vec4 origin;   // xyz = first vertex, w = length
+    vec4 tangent;  // xyz = unit direction, w = exterior wedge angle / pi
+    vec4 normal0;  // xyz = face 0 normal
+    vec4 face0;    // xyz = into face 0, perpendicular to the edge
+};
+
+layout(std430, binding = 25) readonly buffer EdgeBuffer { DiffractionEdge edges[]; };
+
+uniform int edgeOffset;
+uniform mat4 edgeModel;
+uniform mat3 edgeNormalMatrix;
+uniform vec3 edgeRadarPosition;   // Single look; batched looks use their own
+uniform vec3 edgeBeamDirection;
+uniform float edgeBeamCosHalfAngle;
+uniform float edgeWaveNumber;     // Radians per scene unit
+
+// Keller coefficient term with its pole (incidence along a face normal, where
+// the traced specular return takes over) clamped
+float kellerTerm(float c, float cosine) {
+    float denominator = c - cosine;
+    return 1.0 / (denominator < 0.0 ? min(denominator, -EDGE_MIN_DENOMINATOR) : max(denominator, EDGE_MIN_DENOMINATOR));
+}
+
+// Monostatic return of one edge, from equivalent edge currents with Keller's
+// wedge coefficients averaged over both polarizations and the finite edge's
+// sinc lobe. Binned like a hit whose reflection points back at the radar; a
+// miss when the radar sees only the inside of the wedge, the edge is outside
+// the beam or the return is negligible.
+HitResult diffractEdge(uint index, uint look) {
+    HitResult hit;
+    hit.hitPoint = vec4(0.0, 0.0, 0.0, -1.0);
+    hit.normal = vec4(0.0);
+    hit.reflection = vec4(0.0);
+    hit.triangleId = 0xFFFFFFFFu;
+    hit.rayId = index;
+    hit.targetId = 0u;
+    hit.rcsContribution = 0.0;
+
+    vec3 radar = numLooks > 0 ? looks[look].radarPosition.xyz : edgeRadarPosition;
+    vec3 beam = numLooks > 0 ? looks[look].beamDirection.xyz : edgeBeamDirection;
+
+    DiffractionEdge edge = edges[edgeOffset + int(index)];
+    vec3 start = (edgeModel * vec4(edge.origin.xyz, 1.0)).xyz;
+    vec3 span = mat3(edgeModel) * (edge.tangent.xyz * edge.origin.w);
+    float len = length(span);
+    if (len <= 0.0) return hit;
+    vec3 t = span / len;
+    vec3 center = start + 0.5 * span;
+
+    vec3 toRadar = radar - center;
+    float range = length(toRadar);
+    if (range <= 0.0) return hit;
+    vec3 s = toRadar / range;
+    if (dot(-s, normalize(beam)) < edgeBeamCosHalfAngle) return hit;
+
+    // Wedge frame: face 0's normal and in-face direction, both across the edge
+    vec3 n0 = normalize(edgeNormalMatrix * edge.normal0.xyz);
+    vec3 b0 = mat3(edgeModel) * edge.face0.xyz;
+    b0 = normalize(b0 - t * dot(b0, t));
+
+    float cosBeta = dot(s, t);
+    vec3 across = s - t * cosBeta;
+    float sinBeta = length(across);
+    if (sinBeta <= 1e-4) return hit;  // Looking along the edge
+    across /= sinBeta;
+    float phi = atan(dot(across, n0), dot(across, b0));
+    if (phi < 0.0) phi += 2.0 * PI;
+    float n = edge.tangent.w;
+    if (phi >= n * PI) return hit;  // Inside the wedge
+
+    // Backscatter (incidence = observation angle): soft and hard coefficients
+    // are scale * (x -/+ y), their mean square scale^2 * (x^2 + y^2)
+    float c = cos(PI / n);
+    float scale = sin(PI / n) / n;
+    float x = kellerTerm(c, 1.0);
+    float y = kellerTerm(c, cos(2.0 * phi / n));
+    float coefficient = scale * scale * (x * x + y * y);
+
+    // Finite edge: the return adds up along the length with phase 2 k l cos(beta)
+    float arg = edgeWaveNumber * len * cosBeta;
+    float lobe = abs(arg) < 1e-4 ? 1.0 : sin(arg) / arg;
+    float intensity = min(coefficient * lobe * lobe * sinBeta * sinBeta, 1.0);
+    if (!(intensity >= EDGE_MIN_INTENSITY)) return hit;
+
+    hit.hitPoint = vec4(center, range);
+    hit.normal = vec4(n0, 0.0);
+    hit.reflection = vec4(s, intensity);
+    return hit;
+}
+#endif
+
+#ifdef FREQUENCY_BINNING
+vec2 complexMul(vec2 a, vec2 b) {
+    return vec2(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+void main() {
+    uint localId = gl_GlobalInvocationID.x;
+    uint lane = gl_LocalInvocationIndex;
+    int freqBegin = int(gl_WorkGroupID.y) * FREQ_BLOCK;
+    int freqCount = min(FREQ_BLOCK, numFrequencies - freqBegin);
+
+    polarCutType = uPolarCutType;
+    polarOffset = uPolarOffset;
+    polarThickness = uPolarThickness;
+    polarMinIntensity = uPolarMinIntensity;
+
+    for (uint i = lane; i < uint(POLAR_BINS * FREQ_BLOCK); i += gl_WorkGroupSize.x) {
+        sFieldRe[i] = 0;
+        sFieldIm[i] = 0;
+    }
+    barrier();
+
+    if (localId < uint(numRays)) {
+        HitResult hit = hits[localId];
+        float intensity = hit.reflection.w;
+        bool valid = hit.hitPoint.w >= 0.0 && intensity > 0.0 &&
+                     !isnan(intensity) && !isinf(intensity);
+
+        float len = length(hit.reflection.xyz);
+        vec3 dir = len > 0.0 ? hit.reflection.xyz / len : vec3(0.0);
+        int bin = valid && intensity >= polarMinIntensity ? polarBinIndex(dir) : -1;
+
+        if (bin >= 0) {
+            // Path to the hit (all bounces) plus the far-field leg out along the
+            // exit direction, measured against a plane through the origin
+            float pathLength = hit.hitPoint.w - dot(hit.hitPoint.xyz, dir) - referencePath;
+            float amplitude = sqrt(min(intensity, 65535.0)) * fieldScale;
+
+            float phase = -(waveNumberStart + float(freqBegin) * waveNumberStep) * pathLength;
+            float stepPhase = -waveNumberStep * pathLength;
+            vec2 field = amplitude * vec2(cos(phase), sin(phase));
+            vec2 rotation = vec2(cos(stepPhase), sin(stepPhase));
+
+            int base = bin * FREQ_BLOCK;
+            for (int f = 0; f < freqCount; ++f) {
+                atomicAdd(sFieldRe[base + f], int(round(field.x)));
+                atomicAdd(sFieldIm[base + f], int(round(field.y)));
+                field = complexMul(field, rotation);
+            }
+        }
+    }
+    barrier();
+
+    // Flush into the 64-bit global sums: a negative addend carries -1 into hi
+    for (uint i = lane; i < uint(POLAR_BINS * FREQ_BLOCK); i += gl_WorkGroupSize.x) {
+        int f = int(i) % FREQ_BLOCK;
+        if (f >= freqCount) continue;
+        uint bin = (i / uint(FREQ_BLOCK)) * uint(numFrequencies) + uint(freqBegin + f);
+
+        int re = sFieldRe[i];
+        if (re != 0) {
+            uint old = atomicAdd(frequencyBins[bin].realLo, uint(re));
+            int hi = ((old + uint(re) < old) ? 1 : 0) - (re < 0 ? 1 : 0);
+            if (hi != 0) atomicAdd(frequencyBins[bin].realHi, hi);
+        }
+        int im = sFieldIm[i];
+        if (im != 0) {
+            uint old = atomicAdd(frequencyBins[bin].imagLo, uint(im));
+            int hi = ((old + uint(im) < old) ? 1 : 0) - (im < 0 ? 1 : 0);
+            if (hi != 0) atomicAdd(frequencyBins[bin].imagHi, hi);
+        }
+    }
+}
+#else
+void main() {
+    uint localId = gl_GlobalInvocationID.x;
+    uint lane = gl_LocalInvocationIndex;
+    uint look = gl_GlobalInvocationID.y;
+
+    if (numLooks > 0) {
+        polarCutType = int(looks[look].slice.x);
+        polarOffset = looks[look].slice.y;
+        polarThickness = looks[look].slice.z;
+        polarMinIntensity = looks[look].slice.w;
+    } else {
+        polarCutType = uPolarCutType;
+        polarOffset = uPolarOffset;
+        polarThickness = uPolarThickness;
+        polarMinIntensity = uPolarMinIntensity;
+    }
+
+    if (polarEnabled) {
+        for (uint i = lane; i < uint(POLAR_BINS); i += gl_WorkGroupSize.x) {
+            sPolarLo[i] = 0u;
+            sPolarHi[i] = 0u;
+            sPolarCount[i] = 0u;
+        }
+    }
+    if (lane < uint(MAX_RECEIVERS)) {
+        sReceiverLo[lane] = 0u;
+        sReceiverHi[lane] = 0u;
+        sReceiverCount[lane] = 0u;
+    }
+    barrier();
+
+    if (localId < uint(numRays)) {
+#ifdef EDGE_DIFFRACTION
+        HitResult hit = diffractEdge(localId, look);
+#else
+        HitResult hit = hits[look * uint(numRays) + localId];
+#endif
+        float intensity = hit.reflection.w;
+        bool valid = hit.hitPoint.w >= 0.0 && intensity >= 0.0 &&
+                     !isnan(intensity) && !isinf(intensity);
+
+        if (valid) {
+            float len = length(hit.reflection.xyz);
+            vec3 dir = len > 0.0 ? hit.reflection.xyz / len : vec3(0.0);
+            uint fixedIntensity = uint(min(intensity, 65535.0) * intensityScale + 0.5);
+
+            if (polarEnabled && intensity >= polarMinIntensity) {
+                int bin = polarBinIndex(dir);
+                if (bin >= 0) {
+                    uint old = atomicAdd(sPolarLo[bin], fixedIntensity);
+                    if (old + fixedIntensity < old) atomicAdd(sPolarHi[bin], 1u);
+                    atomicAdd(sPolarCount[bin], 1u);
+                }
+            }
+
+            if (sphereEnabled) {
+                float azimuthDeg = degrees(azimuthRadians(dir));
+                if (azimuthDeg < 0.0) azimuthDeg += 360.0;
+                float elevationDeg = degrees(elevationRadians(dir));
+                int column = clamp(int(azimuthDeg / 360.0 * float(sphereAzBins)), 0, sphereAzBins - 1);
+                int row = clamp(int((elevationDeg + 90.0) / 180.0 * float(sphereElBins)), 0, sphereElBins - 1);
+                uint cell = uint(row * sphereAzBins + column);
+                uint old = atomicAdd(sphereBins[cell].intensityLo, fixedIntensity);
+                if (old + fixedIntensity < old) atomicAdd(sphereBins[cell].intensityHi, 1u);
+                atomicAdd(sphereBins[cell].hitCount, 1u);
+            }
+
+            if (heatMapEnabled && intensity >= heatMinIntensity && inHeatMapSlice(dir)) {
+                int base = heatMapBinIndex(dir) * 3;
+                uint old = atomicAdd(heatBins[base + 0], fixedIntensity);
+                if (old + fixedIntensity < old) atomicAdd(heatBins[base + 1], 1u);
+                atomicAdd(heatBins[base + 2], 1u);
+            }
+
+            for (int pack = 0; pack * 4 < numReceivers; ++pack) {
+                vec4 cosines = dir.x * receiverX[pack] + dir.y * receiverY[pack] + dir.z * receiverZ[pack];
+                bvec4 inside = greaterThanEqual(cosines, vec4(receiverCosAcceptance));
+                if (!any(inside)) continue;
+                for (int j = 0; j < 4; ++j) {
+                    int r = pack * 4 + j;
+                    if (!inside[j] || r >= numReceivers) continue;
+                    uint old = atomicAdd(sReceiverLo[r], fixedIntensity);
+                    if (old + fixedIntensity < old) atomicAdd(sReceiverHi[r], 1u);
+                    atomicAdd(sReceiverCount[r], 1u);
+                }
+            }
+        }
+    }
+    barrier();
+
+    if (polarEnabled) {
+        for (uint i = lane; i < uint(POLAR_BINS); i += gl_WorkGroupSize.x) {
+            uint count = sPolarCount[i];
+            if (count == 0u) continue;
+            uint lo = sPolarLo[i];
+            uint bin = look * uint(POLAR_BINS) + i;
+            uint old = atomicAdd(polarBins[bin].intensityLo, lo);
+            uint hi = sPolarHi[i] + ((old + lo < old) ? 1u : 0u);
+            if (hi != 0u) atomicAdd(polarBins[bin].intensityHi, hi);
+            atomicAdd(polarBins[bin].hitCount, count);
+        }
+    }
+
+    if (lane < uint(numReceivers) && sReceiverCount[lane] != 0u) {
+        uint lo = sReceiverLo[lane];
+        uint old = atomicAdd(receiverBins[lane].intensityLo, lo);
+        uint hi = sReceiverHi[lane] + ((old + lo < old) ? 1u : 0u);
+        if (hi != 0u) atomicAdd(receiverBins[lane].intensityHi, hi);
+        atomicAdd(receiverBins[lane].hitCount, sReceiverCount[lane]);
+    }
+}
+#endif
+)";
+
+// Compute shader source: Heat map bins -> per-vertex intensity
+// Samples the lat/lon grid at HeatMapRenderer's sphere mesh vertices; the result
+// is bound directly as the heat map's intensity vertex attribute.
+static const char* heatMapResolveShaderSource = R"(
+#version 430 core
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+layout(std430, binding = 6) readonly buffer HeatMapBinBuffer { uint heatBins[]; };
+layout(std430, binding = 7) buffer VertexIntensityBuffer { float vertexIntensity[]; };
+
+uniform int latSegments;
+uniform int lonSegments;
+uniform int heatLatBins;
+uniform int heatLonBins;
+uniform float intensityScale;
+uniform float historyWeight;  // Share of the previous frame's value kept (RCSCompute::setTemporalReuse)
+
+const float PI = 3.14159265358979;
+
+void main() {
+    uint vertexIdx = gl_GlobalInvocationID.x;
+    int vertexCount = (latSegments + 1) * (lonSegments + 1);
+    if (vertexIdx >= uint(vertexCount)) return;
+
+    // Same vertex layout as HeatMapRenderer::generateSphereMesh
+    int lat = int(vertexIdx) / (lonSegments + 1);
+    int lon = int(vertexIdx) % (lonSegments + 1);
+    float phi = PI / 2.0 - PI * float(lat) / float(latSegments);
+    float theta = 2.0 * PI * float(lon) / float(lonSegments);
+    if (theta > PI) theta -= 2.0 * PI;
+    if (theta < 0.0) theta += 2.0 * PI;
+
+    int lonBin = clamp(int(theta / (2.0 * PI) * float(heatLonBins)), 0, heatLonBins - 1);
+    int latBin = clamp(int((PI / 2.0 - phi) / PI * float(heatLatBins)), 0, heatLatBins - 1);
+    int base = (latBin * heatLonBins + lonBin) * 3;
+
+    uint count = heatBins[base + 2];
+    float intensity = 0.0;
+    if (count > 0u) {
+        float sum = (float(heatBins[base + 1]) * 4294967296.0 + float(heatBins[base + 0])) / intensityScale;
+        intensity = sum / float(count);
+    }
+    vertexIntensity[vertexIdx] = historyWeight > 0.0 ? mix(intensity, vertexIntensity[vertexIdx], historyWeight)
+                                                     : intensity;
+}
+)";
+
+// Compute shader source: Reflection lobe clustering (accumulate)
+// Same cell/direction bucketing as ReflectionRenderer::clusterHits, into an
+// open-addressed hash table keyed by a 32-bit hash of the bucket. Sums are
+// fixed point relative to the cell origin (always non-negative) with a carry word.
+static const char* lobeClusterShaderSource = R"(
+#version 430 core
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+struct HitResult {
+    vec4 hitPoint;   // xyz = position, w = distance (-1 = miss)
+    vec4 normal;     // xyz = normal, w = material
+    vec4 reflection; // xyz = reflection direction, w = intensity
+    uint triangleId;
+    uint rayId;
+    uint targetId;
+    float rcsContribution;
+};
+
+struct ClusterSlot {
+    uint key;         // 0 = empty
+    uint count;
+    int cellX;
+    int cellY;
+    int cellZ;
+    uint targetId;
+    uint check;       // Second hash of the same bucket, 0 until claimed
+    uint pad1;
+    uint sumLo[8];    // 0-2 position offset in cell, 3-5 direction + 1, 6 intensity
+    uint sumHi[8];
+};
+
+layout(std430, binding = 3) readonly buffer HitBuffer { HitResult hits[]; };
+layout(std430, binding = 9) buffer ClusterTable { ClusterSlot slots[]; };
+
+uniform int numRays;  // Rays in this tile
+uniform float cellSize;
+uniform int dirBucketsPerFace;
+uniform float minIntensity;
+uniform float fixedScale;
+uniform uint tableMask;
+
+int lobeDirectionBucket(vec3 d) {
+    int n = dirBucketsPerFace;
+    vec3 a = abs(d);
+    int face;
+    vec2 uv;
+    if (a.x >= a.y && a.x >= a.z && a.x > 0.0) {
+        face = d.x > 0.0 ? 0 : 1; uv = vec2(d.y, d.z) / a.x;
+    } else if (a.y >= a.z && a.y > 0.0) {
+        face = d.y > 0.0 ? 2 : 3; uv = vec2(d.x, d.z) / a.y;
+    } else if (a.z > 0.0) {
+        face = d.z > 0.0 ? 4 : 5; uv = vec2(d.x, d.y) / a.z;
+    } else {
+        return 0;
+    }
+    int ui = min(int((uv.x + 1.0) * 0.5 * float(n)), n - 1);
+    int vi = min(int((uv.y + 1.0) * 0.5 * float(n)), n - 1);
+    return (face * n + vi) * n + ui;
+}
+
+uint hashBucket(ivec3 cell, int dirBucket) {
+    uint h = uint(cell.x) * 73856093u ^ uint(cell.y) * 19349663u ^ uint(cell.z) * 83492791u;
+    h ^= uint(dirBucket) * 2654435761u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h | 1u;  // Never 0 (empty marker)
+}
+
+// Independent hash of the same bucket. A slot belongs to the first (key, check)
+// pair claimed in it, so two buckets whose keys collide still accumulate apart.
+uint checkBucket(ivec3 cell, int dirBucket) {
+    uint h = uint(cell.x) * 2246822519u + uint(cell.y) * 3266489917u + uint(cell.z) * 668265263u;
+    h += uint(dirBucket) * 374761393u;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return h | 1u;
+}
+
+void addFixed(uint slot, int i, float value) {
+    uint v = uint(max(value, 0.0) * fixedScale + 0.5);
+    uint old = atomicAdd(slots[slot].sumLo[i], v);
+    if (old + v < old) atomicAdd(slots[slot].sumHi[i], 1u);
+}
+
+void main() {
+    uint localId = gl_GlobalInvocationID.x;
+    if (localId >= uint(numRays)) return;
+
+    HitResult hit = hits[localId];
+    float intensity = hit.reflection.w;
+    if (hit.hitPoint.w < 0.0 || intensity < minIntensity) return;
+
+    vec3 pos = hit.hitPoint.xyz;
+    vec3 dir = normalize(hit.reflection.xyz);
+    ivec3 cell = ivec3(floor(pos / cellSize));
+    int dirBucket = lobeDirectionBucket(dir);
+    uint key = hashBucket(cell, dirBucket);
+    uint check = checkBucket(cell, dirBucket);
+
+    // Linear probing; a full neighbourhood drops the hit. A matching key claims
+    // or compares the check word too, so a key collision probes on instead of
+    // mixing two cells.
+    uint idx = key & tableMask;
+    for (int probe = 0; probe < 32; ++probe) {
+        uint prev = atomicCompSwap(slots[idx].key, 0u, key);
+        uint prevCheck = (prev == 0u || prev == key) ? atomicCompSwap(slots[idx].check, 0u, check) : 0u;
+        if ((prev == 0u || prev == key) && (prevCheck == 0u || prevCheck == check)) {
+            // Every inserter writes the same cell, so these plain stores are benign
+            slots[idx].cellX = cell.x;
+            slots[idx].cellY = cell.y;
+            slots[idx].cellZ = cell.z;
+            slots[idx].targetId = hit.targetId;
+
+            vec3 offset = clamp(pos - vec3(cell) * cellSize, vec3(0.0), vec3(cellSize));
+            addFixed(idx, 0, offset.x);
+            addFixed(idx, 1, offset.y);
+            addFixed(idx, 2, offset.z);
+            addFixed(idx, 3, dir.x + 1.0);
+            addFixed(idx, 4, dir.y + 1.0);
+            addFixed(idx, 5, dir.z + 1.0);
+            addFixed(idx, 6, min(intensity, 65535.0));  // kBinIntensityMax, as ReflectionRenderer
+            atomicAdd(slots[idx].count, 1u);
+            return;
+        }
+        idx = (idx + 1u) & tableMask;
+    }
+}
+)";
+
+// Compute shader source: Reflection lobe clustering (collect)
+// Turns occupied hash slots into ReflectionCluster entries for readback.
+static const char* lobeClusterCollectShaderSource = R"(
+#version 430 core
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+struct ClusterSlot {
+    uint key;
+    uint count;
+    int cellX;
+    int cellY;
+    int cellZ;
+    uint targetId;
+    uint check;
+    uint pad1;
+    uint sumLo[8];
+    uint sumHi[8];
+};
+
+struct ReflectionCluster {
+    vec4 position;    // xyz = average hit position, w = hit count
+    vec4 direction;   // xyz = average reflection direction, w = unused
+    vec4 properties;  // x = average intensity, y = spread angle (deg), z = targetId
+};
+
+layout(std430, binding = 9) readonly buffer ClusterTable { ClusterSlot slots[]; };
+layout(std430, binding = 10) buffer ClusterOutput {
+    uint clusterCount;
+    uint pad0;
+    uint pad1;
+    uint pad2;
+    ReflectionCluster clusters[];
+};
+
+uniform int tableSize;
+uniform int maxClusters;
+uniform float cellSize;
+uniform float fixedScale;
+
+float mean(uint slot, int i, float count) {
+    return (float(slots[slot].sumHi[i]) * 4294967296.0 + float(slots[slot].sumLo[i])) / fixedScale / count;
+}
+
+void main() {
+    uint idx = gl_GlobalInvocationID.x;
+    if (idx >= uint(tableSize)) return;
+    if (slots[idx].key == 0u || slots[idx].count == 0u) return;
+
+    float count = float(slots[idx].count);
+    vec3 cellOrigin = vec3(slots[idx].cellX, slots[idx].cellY, slots[idx].cellZ) * cellSize;
+    vec3 position = cellOrigin + vec3(mean(idx, 0, count), mean(idx, 1, count), mean(idx, 2, count));
+    vec3 meanDir = vec3(mean(idx, 3, count), mean(idx, 4, count), mean(idx, 5, count)) - 1.0;
+    float resultant = length(meanDir);
+    vec3 direction = resultant > 0.0 ? meanDir / resultant : vec3(0.0, 0.0, 1.0);
+
+    uint outIdx = atomicAdd(clusterCount, 1u);
+    if (outIdx >= uint(maxClusters)) return;
+
+    clusters[outIdx].position = vec4(position, count);
+    clusters[outIdx].direction = vec4(direction, 0.0);
+    clusters[outIdx].properties = vec4(mean(idx, 6, count),
+                                       degrees(acos(clamp(resultant, 0.0, 1.0))),
+                                       float(slots[idx].targetId), 0.0);
+}
+)";
+
+// Compute shader source: Ray reordering keys (RCSCompute::setRayReordering)
+// One key per ray for GPURadixSort, the ray's index as its value. Primary rays
+// share the radar position, so their key is the Morton code of the octahedral
+// direction. Queued bounce rays start all over the target: the origin's cell
+// in the scene bounds comes first, then the direction, so rays that start
+// close together and head the same way trace the same nodes side by side.
+// Entries past the queued count sort last.
+static const char* rayKeyShaderSource = R"(
+#version 430 core
+layout(local_size_x = 256, local_size_y = 1, local_size_z = 1) in;
+
+struct Ray {
+    vec4 origin;
+    vec4 direction;
+};
+
+struct BounceRay {
+    vec4 origin;
+    vec4 direction;
+    uint primary;
+    uint payloadIndex;
+    uint bounce;
+    uint padding;
+};
+
+layout(std430, binding = 0) writeonly buffer SortKeys { uint keys[]; };
+layout(std430, binding = 1) writeonly buffer SortValues { uint values[]; };
+layout(std430, binding = 2) readonly buffer RayBuffer { Ray rays[]; };
+layout(std430, binding = 15) readonly buffer BounceQueue {
+    uvec4 bounceArgs[8];  // MAX_BOUNCE_PASSES
+    BounceRay bounceRays[];
+};
+
+uniform uint numKeys;
+uniform int bouncePass;  // 0 = primary rays in the ray buffer
+uniform uint bounceCapacity;
+uniform vec3 sceneMin;
+uniform vec3 sceneExtent;
+
+// Spreads the low 10 bits of v to every third bit, or the low 16 to every other
+uint spread3(uint v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+uint spread2(uint v) {
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+// Morton code of the octahedral direction, bits per axis
+uint directionKey(vec3 d, uint bits) {
+    d /= max(abs(d.x) + abs(d.y) + abs(d.z), 1e-30);
+    vec2 e = d.xy;
+    if (d.z < 0.0) {
+        e = (1.0 - abs(d.yx)) * vec2(d.x >= 0.0 ? 1.0 : -1.0, d.y >= 0.0 ? 1.0 : -1.0);
+    }
+    float cells = float(1u << bits);
+    uvec2 cell = uvec2(clamp((e * 0.5 + 0.5) * cells, vec2(0.0), vec2(cells - 1.0)));
+    return (spread2(cell.x) << 1) | spread2(cell.y);
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= numKeys) return;
+
+    uint key;
+    if (bouncePass == 0) {
+        key = directionKey(rays[index].direction.xyz, 8u);  // 16 bits
+    } else if (index < min(bounceArgs[bouncePass].w, bounceCapacity)) {
+        BounceRay ray = bounceRays[(uint(bouncePass) & 1u) * bounceCapacity + index];
+        vec3 unit = clamp((ray.origin.xyz - sceneMin) / max(sceneExtent, vec3(1e-30)), 0.0, 1.0);
+        uvec3 cell = uvec3(min(unit * 64.0, vec3(63.0)));
+        uint cellKey = (spread3(cell.x) << 2) | (spread3(cell.y) << 1) | spread3(cell.z);
+        key = (cellKey << 12) | directionKey(ray.direction.xyz, 6u);  // 18 + 12 bits
+    } else {
+        key = 0xFFFFFFFFu;
+    }
+    keys[index] = key;
+    values[index] = index;
 }
 )";
 
@@ -305,10 +2105,28 @@ void main() {
 RCSCompute::RCSCompute(QObject* parent)
     : QObject(parent)
 {
+    qRegisterMetaType<RCS::BVHBuildRequestPtr>("RCS::BVHBuildRequestPtr");
+    qRegisterMetaType<RCS::BVHSnapshotPtr>("RCS::BVHSnapshotPtr");
+
+    // BVH builds run on a worker thread; results come back queued to this thread
+    bvhWorker_ = new BVHWorker();
+    bvhWorker_->moveToThread(&bvhThread_);
+    connect(&bvhThread_, &QThread::finished, bvhWorker_, &QObject::deleteLater);
+    connect(this, &RCSCompute::bvhBuildRequested, bvhWorker_, &BVHWorker::build);
+    connect(this, &RCSCompute::bvhMeshReleased, bvhWorker_, &BVHWorker::releaseMesh);
+    connect(bvhWorker_, &BVHWorker::bvhReady, this, &RCSCompute::onBVHReady);
+    bvhThread_.setObjectName("BVHBuilder");
+    bvhThread_.start();
+
+    // Default scene: mesh 0 untransformed, as set by setTargetGeometry()
+    instanceStates_.resize(1);
 }
 
 RCSCompute::~RCSCompute() {
     cleanup();
+
+    bvhThread_.quit();
+    bvhThread_.wait();
 }
 
 bool RCSCompute::initialize() {
@@ -341,6 +2159,29 @@ bool RCSCompute::initialize() {
         return false;
     }
 
+    // glClearTexImage is GL 4.4; fall back to a texture upload without it
+    QOpenGLContext* ctx = QOpenGLContext::currentContext();
+    QSurfaceFormat format = ctx->format();
+    hasClearTexImage_ = (format.majorVersion() > 4 ||
+                         (format.majorVersion() == 4 && format.minorVersion() >= 4)) ||
+                        ctx->hasExtension(QByteArrayLiteral("GL_ARB_clear_texture"));
+
+    // Persistent trace groups: half the resident warps, roughly what the trace
+    // kernel's register use allows. Only NVIDIA reports the SM count.
+    if (ctx->hasExtension(QByteArrayLiteral("GL_NV_shader_thread_group"))) {
+        constexpr GLenum kWarpSizeNV = 0x9339;
+        constexpr GLenum kWarpsPerSmNV = 0x933A;
+        constexpr GLenum kSmCountNV = 0x933B;
+        GLint warpSize = 0, warpsPerSm = 0, smCount = 0;
+        glGetIntegerv(kWarpSizeNV, &warpSize);
+        glGetIntegerv(kWarpsPerSmNV, &warpsPerSm);
+        glGetIntegerv(kSmCountNV, &smCount);
+        int groups = smCount * warpsPerSm * warpSize / (2 * kComputeWorkgroupSize);
+        if (groups > 0) {
+            persistentGroups_ = groups;
+        }
+    }
+
     createBuffers();
 
     // Check for errors after initialization
@@ -356,22 +2197,79 @@ void RCSCompute::cleanup() {
     if (rayBuffer_) { glDeleteBuffers(1, &rayBuffer_); rayBuffer_ = 0; }
     if (bvhBuffer_) { glDeleteBuffers(1, &bvhBuffer_); bvhBuffer_ = 0; }
     if (triangleBuffer_) { glDeleteBuffers(1, &triangleBuffer_); triangleBuffer_ = 0; }
-    if (hitBuffer_) { glDeleteBuffers(1, &hitBuffer_); hitBuffer_ = 0; }
-    if (counterBuffer_) { glDeleteBuffers(1, &counterBuffer_); counterBuffer_ = 0; }
+    if (skipBuffer_) { glDeleteBuffers(1, &skipBuffer_); skipBuffer_ = 0; }
+    if (normalConeBuffer_) { glDeleteBuffers(1, &normalConeBuffer_); normalConeBuffer_ = 0; }
+    normalConesActive_ = false;
+    for (auto& entry : meshes_) {
+        retireGPUSource(entry.second);
+    }
+    pollGPUBVHBuilds();  // Frees the retired stats buffers
+    gpuBvhBuilder_.cleanup();
+    if (tlasBuffer_) { glDeleteBuffers(1, &tlasBuffer_); tlasBuffer_ = 0; }
+    if (instanceBuffer_) { glDeleteBuffers(1, &instanceBuffer_); instanceBuffer_ = 0; }
+    if (tileHitBuffer_) { glDeleteBuffers(1, &tileHitBuffer_); tileHitBuffer_ = 0; }
+    destroyReadbackSlots();
 
     if (shadowMapTexture_) { glDeleteTextures(1, &shadowMapTexture_); shadowMapTexture_ = 0; }
+    if (beamPatternTexture_) { glDeleteTextures(1, &beamPatternTexture_); beamPatternTexture_ = 0; }
+    if (heatMapBinBuffer_) { glDeleteBuffers(1, &heatMapBinBuffer_); heatMapBinBuffer_ = 0; }
+    if (heatMapIntensityBuffer_) { glDeleteBuffers(1, &heatMapIntensityBuffer_); heatMapIntensityBuffer_ = 0; }
+    if (lobeClusterTable_) { glDeleteBuffers(1, &lobeClusterTable_); lobeClusterTable_ = 0; }
+    if (lookBuffer_) { glDeleteBuffers(1, &lookBuffer_); lookBuffer_ = 0; }
+    if (lookRayBuffer_) { glDeleteBuffers(1, &lookRayBuffer_); lookRayBuffer_ = 0; }
+    if (lookHitBuffer_) { glDeleteBuffers(1, &lookHitBuffer_); lookHitBuffer_ = 0; }
+    if (lookCounterBuffer_) { glDeleteBuffers(1, &lookCounterBuffer_); lookCounterBuffer_ = 0; }
+    if (lookPolarBinBuffer_) { glDeleteBuffers(1, &lookPolarBinBuffer_); lookPolarBinBuffer_ = 0; }
+    if (bounceQueueBuffer_) { glDeleteBuffers(1, &bounceQueueBuffer_); bounceQueueBuffer_ = 0; }
+    if (workCounterBuffer_) { glDeleteBuffers(1, &workCounterBuffer_); workCounterBuffer_ = 0; }
+    if (seedBuffer_) { glDeleteBuffers(1, &seedBuffer_); seedBuffer_ = 0; }
+    seedCapacity_ = 0;
+    if (materialBuffer_) { glDeleteBuffers(1, &materialBuffer_); materialBuffer_ = 0; }
+    if (primitiveBuffer_) { glDeleteBuffers(1, &primitiveBuffer_); primitiveBuffer_ = 0; }
+    if (edgeBuffer_) { glDeleteBuffers(1, &edgeBuffer_); edgeBuffer_ = 0; }
+    edgeCount_ = 0;
+    if (hotspotBuffer_) { glDeleteBuffers(1, &hotspotBuffer_); hotspotBuffer_ = 0; }
+    hotspotCapacity_ = 0;
+    edgesDirty_ = true;  // Uploaded again by a later initialize()
 
     rayGenShader_.reset();
-    traceShader_.reset();
-    shadowMapShader_.reset();
+    tracePrograms_.clear();
+    binningShader_.reset();
+    frequencyBinningShader_.reset();
+    edgeBinningShader_.reset();
+    heatMapResolveShader_.reset();
+    lobeClusterShader_.reset();
+    lobeClusterCollectShader_.reset();
+    rayKeyShader_.reset();
+    raySort_.cleanup();
+    rayReorderFailed_ = false;
+
+    rayMemory_.release();
+    sceneMemory_.release();
+    resultMemory_.release();
+    textureMemory_.release();
+    memoryDirty_ = true;
+
+    // CPU-side BVHs survive; re-upload everything if initialize() runs again
+    blasLayoutDirty_ = true;
+    bvhDirty_ = true;
+    materialsDirty_ = true;
+    primitivesDirty_ = true;
+    tlasDirty_ = true;
+    tlasNodeCount_ = 0;
 
     initialized_ = false;
 }
 
 bool RCSCompute::compileShaders() {
+    // All programs go through Qt's program binary disk cache (as do the
+    // renderers'): link() loads the stored glGetProgramBinary blob when the
+    // source hash and driver match, and only compiles on a miss. Compile
+    // errors therefore surface from link().
+
     // Ray generation shader
     rayGenShader_ = std::make_unique<QOpenGLShaderProgram>();
-    if (!rayGenShader_->addShaderFromSourceCode(QOpenGLShader::Compute, rayGenShaderSource)) {
+    if (!rayGenShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, rayGenShaderSource)) {
         qWarning() << "Failed to compile ray generation shader:" << rayGenShader_->log();
         return false;
     }
@@ -380,25 +2278,77 @@ bool RCSCompute::compileShaders() {
         return false;
     }
 
-    // Trace shader
-    traceShader_ = std::make_unique<QOpenGLShaderProgram>();
-    if (!traceShader_->addShaderFromSourceCode(QOpenGLShader::Compute, traceShaderSource)) {
-        qWarning() << "Failed to compile trace shader:" << traceShader_->log();
+    // Trace kernels are specialized per feature combination and compiled
+    // on first use (traceProgram). Build the default one now, so a kernel
+    // that does not compile fails initialization rather than a dispatch.
+    if (!traceProgram(hitPayload_)) {
+        return false;
+    }
+
+    // Polar / heat map binning shader
+    binningShader_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!binningShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, binningShaderSource)) {
+        qWarning() << "Failed to compile binning shader:" << binningShader_->log();
+        return false;
+    }
+    if (!binningShader_->link()) {
+        qWarning() << "Failed to link binning shader:" << binningShader_->log();
+        return false;
+    }
+
+    // Complex field variant for the frequency sweep
+    frequencyBinningShader_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!frequencyBinningShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute,
+                                                                   withDefine(binningShaderSource, "FREQUENCY_BINNING"))) {
+        qWarning() << "Failed to compile frequency binning shader:" << frequencyBinningShader_->log();
+        return false;
+    }
+    if (!frequencyBinningShader_->link()) {
+        qWarning() << "Failed to link frequency binning shader:" << frequencyBinningShader_->log();
+        return false;
+    }
+
+    // Crease-edge variant: samples come from the edge buffer instead of hits
+    edgeBinningShader_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!edgeBinningShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute,
+                                                              withDefine(binningShaderSource, "EDGE_DIFFRACTION"))) {
+        qWarning() << "Failed to compile edge diffraction shader:" << edgeBinningShader_->log();
+        return false;
+    }
+    if (!edgeBinningShader_->link()) {
+        qWarning() << "Failed to link edge diffraction shader:" << edgeBinningShader_->log();
+        return false;
+    }
+
+    // Heat map resolve shader
+    heatMapResolveShader_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!heatMapResolveShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, heatMapResolveShaderSource)) {
+        qWarning() << "Failed to compile heat map resolve shader:" << heatMapResolveShader_->log();
+        return false;
+    }
+    if (!heatMapResolveShader_->link()) {
+        qWarning() << "Failed to link heat map resolve shader:" << heatMapResolveShader_->log();
+        return false;
+    }
+
+    // Lobe clustering shaders
+    lobeClusterShader_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!lobeClusterShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, lobeClusterShaderSource)) {
+        qWarning() << "Failed to compile lobe cluster shader:" << lobeClusterShader_->log();
         return false;
     }
-    if (!traceShader_->link()) {
-        qWarning() << "Failed to link trace shader:" << traceShader_->log();
+    if (!lobeClusterShader_->link()) {
+        qWarning() << "Failed to link lobe cluster shader:" << lobeClusterShader_->log();
         return false;
     }
 
-    // Shadow map generation shader
-    shadowMapShader_ = std::make_unique<QOpenGLShaderProgram>();
-    if (!shadowMapShader_->addShaderFromSourceCode(QOpenGLShader::Compute, shadowMapShaderSource)) {
-        qWarning() << "Failed to compile shadow map shader:" << shadowMapShader_->log();
+    lobeClusterCollectShader_ = std::make_unique<QOpenGLShaderProgram>();
+    if (!lobeClusterCollectShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, lobeClusterCollectShaderSource)) {
+        qWarning() << "Failed to compile lobe cluster collect shader:" << lobeClusterCollectShader_->log();
         return false;
     }
-    if (!shadowMapShader_->link()) {
-        qWarning() << "Failed to link shadow map shader:" << shadowMapShader_->log();
+    if (!lobeClusterCollectShader_->link()) {
+        qWarning() << "Failed to link lobe cluster collect shader:" << lobeClusterCollectShader_->log();
         return false;
     }
 
@@ -409,7 +2359,7 @@ void RCSCompute::createBuffers() {
     // Ray buffer
     glGenBuffers(1, &rayBuffer_);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, rayBuffer_);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, numRays_ * sizeof(Ray), nullptr, GL_DYNAMIC_DRAW);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, getTileCapacity() * sizeof(Ray), nullptr, GL_DYNAMIC_DRAW);
 
     // BVH buffer (will be resized when geometry is set)
     glGenBuffers(1, &bvhBuffer_);
@@ -417,32 +2367,69 @@ void RCSCompute::createBuffers() {
     // Triangle buffer (will be resized when geometry is set)
     glGenBuffers(1, &triangleBuffer_);
 
-    // Hit buffer
-    glGenBuffers(1, &hitBuffer_);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, hitBuffer_);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, numRays_ * sizeof(HitResult), nullptr, GL_DYNAMIC_DRAW);
+    // Skip links for stackless traversal (sized with the BVH buffer)
+    glGenBuffers(1, &skipBuffer_);
+
+    // Top-level BVH and instance buffers (rebuilt when instances change)
+    glGenBuffers(1, &tlasBuffer_);
+    glGenBuffers(1, &instanceBuffer_);
 
-    // Atomic counter buffer
-    glGenBuffers(1, &counterBuffer_);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, counterBuffer_);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
+    // Full hit results for the current tile (GPU only)
+    glGenBuffers(1, &tileHitBuffer_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, tileHitBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max(getTileCapacity(), 1) * sizeof(HitResult), nullptr, GL_DYNAMIC_COPY);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
+    // Hit and counter buffers (readback ring)
+    createReadbackSlots();
+
     // Shadow map texture for beam visualization
-    // Match resolution exactly to ray distribution for 1:1 texel mapping:
-    // - X = raysPerRing (azimuth)
-    // - Y = numRings (elevation)
-    int raysPerRing = kRaysPerRing;
-    int numRings = (numRays_ + raysPerRing - 1) / raysPerRing;
+    createShadowMap();
+    memoryDirty_ = true;
+}
+
+void RCSCompute::shadowGridSize(int& width, int& rings) const {
+    if (!isShadowDecoupled()) {
+        // Match resolution to the ray distribution for 1:1 texel mapping:
+        // - X = raysPerRing (azimuth)
+        // - Y = numRings (elevation), capped at kShadowMapMaxRings rows
+        width = kRaysPerRing;
+        rings = std::min(getNumRings(), kShadowMapMaxRings);
+        return;
+    }
+
+    // About one texel per footprint pixel: the radius spans the rings and the
+    // rim the azimuth steps. Powers of two so zooming rarely reallocates.
+    auto powerOfTwo = [](double texels, int lo, int hi) {
+        int size = lo;
+        while (size < texels && size < hi) {
+            size *= 2;
+        }
+        return size;
+    };
+    rings = powerOfTwo(0.5 * shadowFootprintPixels_, kShadowMapMinRings, kShadowMapMaxRings);
+    width = powerOfTwo(kPi * shadowFootprintPixels_, kShadowMapMinWidth, kShadowMapMaxWidth);
+}
+
+void RCSCompute::createShadowMap() {
+    int raysPerRing = 0;
+    shadowGridSize(raysPerRing, shadowMapRings_);
     shadowMapResolution_ = raysPerRing;  // Store for getShadowMapResolution()
+    shadowDirty_ = true;
+    memoryDirty_ = true;
 
     // Initialize shadow map with -1 (no hit = all visible) to avoid undefined content
-    std::vector<float> initialData(raysPerRing * numRings, -1.0f);
+    std::vector<float> initialData(raysPerRing * shadowMapRings_, -1.0f);
 
+    if (shadowMapTexture_) {
+        glDeleteTextures(1, &shadowMapTexture_);
+        shadowMapTexture_ = 0;
+    }
     glGenTextures(1, &shadowMapTexture_);
     glBindTexture(GL_TEXTURE_2D, shadowMapTexture_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, raysPerRing, numRings,
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, raysPerRing, shadowMapRings_,
                  0, GL_RED, GL_FLOAT, initialData.data());
     // Use NEAREST filtering for exact texel lookup
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -452,216 +2439,2544 @@ void RCSCompute::createBuffers() {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void RCSCompute::setTargetGeometry(const std::vector<float>& vertices,
-                                    const std::vector<uint32_t>& indices,
-                                    const QMatrix4x4& modelMatrix) {
-    bvhBuilder_.build(vertices, indices, modelMatrix);
+void RCSCompute::setMeshGeometry(uint32_t meshId,
+                                  const std::vector<float>& vertices,
+                                  const std::vector<uint32_t>& indices,
+                                  uint64_t geometryVersion,
+                                  const std::vector<uint32_t>& materialIds) {
+    auto it = meshes_.find(meshId);
+    if (it == meshes_.end()) {
+        it = meshes_.emplace(meshId, MeshState()).first;
+    } else if (it->second.geometryVersion == geometryVersion) {
+        // Same mesh as last time (built or in flight) - keep the existing BVH
+        return;
+    }
+
+    MeshState& mesh = it->second;
+    mesh.geometryVersion = geometryVersion;
+    mesh.buildPending = true;
+    if (mesh.gpuBuilt()) {
+        retireGPUSource(mesh);
+        blasLayoutDirty_ = true;
+        bvhDirty_ = true;
+    }
+
+    // The worker gets its own copy so the target can regenerate freely meanwhile
+    auto request = std::make_shared<BVHBuildRequest>();
+    request->vertices = vertices;
+    request->indices = indices;
+    request->materialIds = materialIds;
+    request->meshId = meshId;
+    request->geometryVersion = geometryVersion;
+
+    bvhWorker_->setLatestRequestedVersion(meshId, geometryVersion);
+    emit bvhBuildRequested(request);
+}
+
+void RCSCompute::setMeshBVH(uint32_t meshId, BVHSnapshotPtr bvh) {
+    if (!bvh || bvh->meshId != meshId) {
+        qWarning() << "RCSCompute::setMeshBVH - Snapshot does not belong to mesh" << meshId;
+        return;
+    }
+
+    MeshState& mesh = meshes_[meshId];
+    mesh.geometryVersion = bvh->geometryVersion;
+    mesh.buildPending = false;
+    mesh.pendingBvh = std::move(bvh);
+    if (mesh.gpuBuilt()) {
+        retireGPUSource(mesh);
+        blasLayoutDirty_ = true;
+    }
+
+    // Any build still queued for this mesh is now stale
+    bvhWorker_->setLatestRequestedVersion(meshId, mesh.geometryVersion);
     bvhDirty_ = true;
+    emit bvhUpdated();
 }
 
-void RCSCompute::setRadarPosition(const QVector3D& position) {
-    radarPosition_ = position;
+void RCSCompute::setMeshGPUGeometry(uint32_t meshId, GLuint vertexBuffer, GLuint indexBuffer, int triangleCount,
+                                    uint64_t geometryVersion, const AABB& bounds) {
+    if (!vertexBuffer || !indexBuffer || triangleCount <= 0 || triangleCount > kGPUBVHMaxTriangles) {
+        qWarning() << "RCSCompute::setMeshGPUGeometry - Mesh" << meshId << "needs buffers and 1 to"
+                   << kGPUBVHMaxTriangles << "triangles, got" << triangleCount;
+        return;
+    }
+
+    auto it = meshes_.find(meshId);
+    if (it == meshes_.end()) {
+        it = meshes_.emplace(meshId, MeshState()).first;
+    } else if (it->second.gpuBuilt() && it->second.geometryVersion == geometryVersion) {
+        return;
+    }
+
+    MeshState& mesh = it->second;
+    MeshState::GPUSource& gpu = mesh.gpu;
+    // A new node or triangle count moves the other meshes, so repack
+    if (gpu.triangleCount != triangleCount || !mesh.resident) {
+        blasLayoutDirty_ = true;
+        gpu.maxDepth = -1;
+    }
+    if (mesh.bvh || mesh.pendingBvh || mesh.buildPending) {
+        // The GPU tree replaces the CPU one; a queued build is now stale
+        mesh.bvh.reset();
+        mesh.pendingBvh.reset();
+        mesh.buildPending = false;
+        bvhWorker_->forgetMesh(meshId);
+        blasLayoutDirty_ = true;
+    }
+    mesh.geometryVersion = geometryVersion;
+    gpu.vertexBuffer = vertexBuffer;
+    gpu.indexBuffer = indexBuffer;
+    gpu.triangleCount = triangleCount;
+    gpu.buildPending = true;
+    if (bounds.min.x() <= bounds.max.x()) {
+        gpu.bounds = bounds;
+        tlasDirty_ = true;
+    }
+    bvhDirty_ = true;
+    emit bvhUpdated();
 }
 
-void RCSCompute::setBeamDirection(const QVector3D& direction) {
-    beamDirection_ = direction.normalized();
+void RCSCompute::retireGPUSource(MeshState& mesh) {
+    MeshState::GPUSource& gpu = mesh.gpu;
+    if (gpu.statsBuffer || gpu.statsFence) {
+        retiredGPUStats_.emplace_back(gpu.statsBuffer, gpu.statsFence);
+    }
+    gpu = MeshState::GPUSource();
 }
 
-void RCSCompute::setBeamWidth(float widthDegrees) {
-    beamWidthDegrees_ = widthDegrees;
+void RCSCompute::pollGPUBVHBuilds() {
+    for (auto& retired : retiredGPUStats_) {
+        if (retired.second) glDeleteSync(retired.second);
+        if (retired.first) glDeleteBuffers(1, &retired.first);
+    }
+    retiredGPUStats_.clear();
+
+    // Stats of finished builds: the root bounds place the mesh in the TLAS and
+    // the depth picks the traversal, so both go through uploadBVH() again
+    for (auto& entry : meshes_) {
+        MeshState::GPUSource& gpu = entry.second.gpu;
+        if (!gpu.statsFence) continue;
+        GLenum status = glClientWaitSync(gpu.statsFence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+        glDeleteSync(gpu.statsFence);
+        gpu.statsFence = nullptr;
+        if (!gpu.mappedStats) continue;
+
+        float bounds[8];
+        uint32_t depth = 0;
+        std::memcpy(bounds, gpu.mappedStats, sizeof(bounds));
+        std::memcpy(&depth, static_cast<const char*>(gpu.mappedStats) + sizeof(bounds), sizeof(depth));
+        gpu.bounds.min = QVector3D(bounds[0], bounds[1], bounds[2]);
+        gpu.bounds.max = QVector3D(bounds[4], bounds[5], bounds[6]);
+        gpu.maxDepth = static_cast<int>(depth);
+        bvhDirty_ = true;
+    }
+}
+
+void RCSCompute::buildMeshOnGPU(MeshState& mesh) {
+    MeshState::GPUSource& gpu = mesh.gpu;
+    gpu.buildPending = false;
+    if (gpuBvhBuilderFailed_) return;
+    if (!gpuBvhBuilder_.initialize()) {
+        qWarning() << "RCSCompute: GPU BVH builder unavailable, GPU-built meshes are not traced";
+        gpuBvhBuilderFailed_ = true;
+        return;
+    }
+    RS::FrameProfiler::Scope stage(profiler_, "buildMeshOnGPU");
+
+    if (!gpu.statsBuffer) {
+        const GLsizeiptr statsBytes = 8 * sizeof(GLfloat) + sizeof(GLuint);
+        const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &gpu.statsBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpu.statsBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, statsBytes, nullptr, flags);
+        gpu.mappedStats = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, statsBytes, flags);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+    // A newer build overwrites the stats of one still in flight
+    if (gpu.statsFence) {
+        glDeleteSync(gpu.statsFence);
+        gpu.statsFence = nullptr;
+    }
+
+    if (gpuBvhBuilder_.build(gpu.vertexBuffer, gpu.indexBuffer, gpu.triangleCount,
+                             bvhBuffer_, skipBuffer_, mesh.nodeOffset,
+                             triangleBuffer_, mesh.triangleOffset, gpu.statsBuffer)) {
+        gpu.statsFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+size_t RCSCompute::meshNodeCount(const MeshState& mesh) const {
+    if (mesh.gpuBuilt()) return static_cast<size_t>(GPUBVHBuilder::nodeCount(mesh.gpu.triangleCount));
+    if (!mesh.bvh) return 0;
+    return wideBvhActive_ ? mesh.bvh->wideNodes.size() : mesh.bvh->nodes.size();
+}
+
+size_t RCSCompute::meshTriangleCount(const MeshState& mesh) const {
+    if (mesh.gpuBuilt()) return static_cast<size_t>(mesh.gpu.triangleCount);
+    return mesh.bvh ? mesh.bvh->triangles.size() : 0;
+}
+
+BVHSnapshotPtr RCSCompute::getMeshBVH(uint32_t meshId) const {
+    auto it = meshes_.find(meshId);
+    if (it == meshes_.end()) {
+        return nullptr;
+    }
+    return it->second.pendingBvh ? it->second.pendingBvh : it->second.bvh;
+}
+
+void RCSCompute::removeMesh(uint32_t meshId) {
+    auto it = meshes_.find(meshId);
+    if (it == meshes_.end()) {
+        return;
+    }
+    retireGPUSource(it->second);
+    edgesDirty_ = edgesDirty_ || !it->second.edges.empty();
+    meshes_.erase(it);
+
+    // Cancels any queued build, then frees the worker's refit state
+    bvhWorker_->forgetMesh(meshId);
+    emit bvhMeshReleased(meshId);
+
+    blasLayoutDirty_ = true;
+    bvhDirty_ = true;
+    tlasDirty_ = true;
+}
+
+void RCSCompute::setMeshEdges(uint32_t meshId, std::vector<DiffractionEdge> edges) {
+    auto it = meshes_.find(meshId);
+    if (it == meshes_.end()) {
+        qWarning() << "RCSCompute::setMeshEdges - Unknown mesh" << meshId;
+        return;
+    }
+    if (it->second.edges.empty() && edges.empty()) {
+        return;
+    }
+    it->second.edges = std::move(edges);
+    edgesDirty_ = true;
+    if (edgeDiffraction_) {
+        restartProgressive();
+    }
+}
+
+void RCSCompute::setEdgeDiffraction(bool enabled, float waveNumber) {
+    if (enabled == edgeDiffraction_ && waveNumber == edgeWaveNumber_) {
+        return;
+    }
+    edgeDiffraction_ = enabled;
+    edgeWaveNumber_ = waveNumber;
+    historyValid_ = false;
+    restartProgressive();
+}
+
+void RCSCompute::setTriangleHotspots(bool enabled) {
+    if (triangleHotspots_ == enabled) {
+        return;
+    }
+    triangleHotspots_ = enabled;
+    restartProgressive();  // Sums start over with the next accumulation
+}
+
+int RCSCompute::getMeshHotspotOffset(uint32_t meshId) const {
+    auto it = meshes_.find(meshId);
+    if (it == meshes_.end() || !it->second.resident) {
+        return -1;
+    }
+    return it->second.triangleOffset;
+}
+
+void RCSCompute::setTargetGeometry(const std::vector<float>& vertices,
+                                    const std::vector<uint32_t>& indices,
+                                    uint64_t geometryVersion,
+                                    const std::vector<uint32_t>& materialIds) {
+    setMeshGeometry(0, vertices, indices, geometryVersion, materialIds);
+}
+
+void RCSCompute::onBVHReady(RCS::BVHSnapshotPtr snapshot) {
+    if (!snapshot) {
+        return;
+    }
+
+    // Ignore builds for meshes that have since been replaced or removed
+    auto it = meshes_.find(snapshot->meshId);
+    if (it == meshes_.end() || snapshot->geometryVersion != it->second.geometryVersion) {
+        return;
+    }
+
+    it->second.pendingBvh = std::move(snapshot);
+    it->second.buildPending = false;
+    bvhDirty_ = true;
+    emit bvhUpdated();
+}
+
+void RCSCompute::setInstances(const std::vector<TargetInstance>& instances) {
+    // Unchanged scene (the common per-frame case) - keep the current TLAS
+    if (instances.size() == instanceStates_.size() &&
+        std::equal(instances.begin(), instances.end(), instanceStates_.begin(),
+                   [](const TargetInstance& a, const InstanceState& b) {
+                       return a.meshId == b.meshId && a.modelMatrix == b.modelMatrix;
+                   })) {
+        return;
+    }
+
+    instanceStates_.clear();
+    instanceStates_.reserve(instances.size());
+    for (const TargetInstance& instance : instances) {
+        InstanceState state;
+        state.meshId = instance.meshId;
+        state.modelMatrix = instance.modelMatrix;
+        bool invertible = false;
+        state.invModelMatrix = instance.modelMatrix.inverted(&invertible);
+        if (!invertible) {
+            qWarning() << "RCSCompute::setInstances - Singular transform for instance"
+                       << instanceStates_.size() << ", using identity";
+            state.invModelMatrix.setToIdentity();
+        }
+        state.normalTransform = state.invModelMatrix.transposed();
+        instanceStates_.push_back(state);
+
+        // A mesh evicted while it had no instance is packed again
+        auto mesh = meshes_.find(instance.meshId);
+        if (mesh != meshes_.end() && mesh->second.hasTree() && !mesh->second.resident) {
+            blasLayoutDirty_ = true;
+            bvhDirty_ = true;
+        }
+    }
+    tlasDirty_ = true;
+}
+
+void RCSCompute::setPrimitives(const std::vector<ScenePrimitive>& primitives) {
+    if (primitives == primitives_) {
+        return;
+    }
+    primitives_ = primitives;
+    primitivesDirty_ = true;
+    shadowDirty_ = true;
+    restartProgressive();
+}
+
+void RCSCompute::setTargetTransform(const QMatrix4x4& modelMatrix) {
+    TargetInstance instance;
+    instance.meshId = 0;
+    instance.modelMatrix = modelMatrix;
+    setInstances({instance});
+}
+
+bool RCSCompute::isBVHBuildPending() const {
+    return std::any_of(meshes_.begin(), meshes_.end(),
+                       [](const auto& entry) { return entry.second.buildPending; });
+}
+
+void RCSCompute::setBVHLayout(BVHLayout layout) {
+    if (layout == bvhLayout_) return;
+    bvhLayout_ = layout;
+    // Repack on the next uploadBVH()
+    blasLayoutDirty_ = true;
+    bvhDirty_ = true;
+}
+
+void RCSCompute::setNormalConeCulling(bool enabled) {
+    if (enabled == normalConeCulling_) return;
+    normalConeCulling_ = enabled;
+    // Allocates or frees the cones on the next uploadBVH()
+    blasLayoutDirty_ = true;
+    bvhDirty_ = true;
+}
+
+void RCSCompute::setTrianglePrecision(TrianglePrecision precision) {
+    if (precision == trianglePrecision_) return;
+    trianglePrecision_ = precision;
+    blasLayoutDirty_ = true;
+    bvhDirty_ = true;
+}
+
+int RCSCompute::getBVHNodeCount() const {
+    int count = 0;
+    for (const auto& entry : meshes_) {
+        if (entry.second.gpuBuilt()) {
+            count += GPUBVHBuilder::nodeCount(entry.second.gpu.triangleCount);
+        } else if (entry.second.bvh) {
+            count += static_cast<int>(entry.second.bvh->nodes.size());
+        }
+    }
+    return count;
+}
+
+void RCSCompute::setRadarPosition(const QVector3D& position) {
+    if (radarPosition_ != position) {
+        restartProgressive();
+        shadowDirty_ = true;
+    }
+    radarPosition_ = position;
+}
+
+void RCSCompute::setBeamDirection(const QVector3D& direction) {
+    QVector3D normalized = direction.normalized();
+    if (beamDirection_ != normalized) {
+        restartProgressive();
+        shadowDirty_ = true;
+    }
+    beamDirection_ = normalized;
+}
+
+void RCSCompute::setBeamWidth(float widthDegrees) {
+    if (beamWidthDegrees_ != widthDegrees) {
+        restartProgressive();
+        shadowDirty_ = true;
+    }
+    beamWidthDegrees_ = widthDegrees;
+}
+
+void RCSCompute::setProgressive(bool enabled) {
+    if (progressive_ != enabled) {
+        progressive_ = enabled;
+        restartProgressive();
+    }
+}
+
+uint32_t RCSCompute::rayOrderStride() const {
+    // Rank-1 lattice generator: the golden ratio step spreads any prefix evenly
+    // over the ray index, and coprimality makes the order a permutation. The
+    // Fibonacci lattice is radially ordered, so it always takes the permutation
+    // to keep tiles uniform; Sobol prefixes are stratified already.
+    bool permute = raySampling_ == RaySampling::Fibonacci ||
+                   (progressive_ && raySampling_ == RaySampling::Rings);
+    if (!permute || numRays_ <= 2) return 1u;
+    uint32_t total = static_cast<uint32_t>(numRays_);
+    uint32_t stride = static_cast<uint32_t>(std::lround(numRays_ * kProgressiveLatticeRatio));
+    while (std::gcd(stride, total) != 1u) {
+        ++stride;
+    }
+    return stride;
+}
+
+void RCSCompute::setMaxBounces(int bounces) {
+    bounces = std::clamp(bounces, 1, kMaxRCSBounces);
+    if (maxBounces_ != bounces) {
+        maxBounces_ = bounces;
+        restartProgressive();
+    }
+}
+
+void RCSCompute::setBounceTermination(float cutoff, float rouletteThreshold) {
+    cutoff = std::max(cutoff, 0.0f);
+    rouletteThreshold = std::max(rouletteThreshold, 0.0f);
+    if (bounceCutoff_ != cutoff || rouletteThreshold_ != rouletteThreshold) {
+        bounceCutoff_ = cutoff;
+        rouletteThreshold_ = rouletteThreshold;
+        restartProgressive();
+    }
+}
+
+void RCSCompute::setBounceEffects(const BounceEffectPipeline& pipeline) {
+    // Splice the enabled shader ports into one chain; Path mode applies none
+    QByteArray chain;
+    std::vector<QVector4D> params;
+    if (pipeline.getMode() == RayTraceMode::PhysicsAccurate) {
+        for (size_t i = 0; i < pipeline.effectCount(); ++i) {
+            const BounceEffect* effect = pipeline.effectAt(i);
+            if (!effect || !effect->isEnabled() || !effect->shaderSource()) {
+                continue;
+            }
+            if (static_cast<int>(params.size()) == kMaxBounceEffects) {
+                qWarning() << "RCSCompute::setBounceEffects - Only the first" << kMaxBounceEffects
+                           << "shader effects run on the GPU; skipping" << effect->name();
+                continue;
+            }
+            float values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            effect->shaderParameters(values);
+            QByteArray source(effect->shaderSource());
+            source.replace("\n", " ");  // The chain is a one-line #define
+            chain += QByteArray("params = effectParams[") + QByteArray::number(static_cast<int>(params.size())) +
+                     "]; { " + source + " } ";
+            params.emplace_back(values[0], values[1], values[2], values[3]);
+        }
+    }
+    if (chain != bounceEffectChain_) {
+        bounceEffectChain_ = chain;
+        traceProgramsStale_ = true;  // Rebuilt in traceProgram(), where the context is current
+        restartProgressive();
+    } else if (params != effectParams_) {
+        restartProgressive();
+    }
+    effectParams_ = std::move(params);
+}
+
+void RCSCompute::setMaterials(const std::vector<Material>& materials) {
+    std::vector<Material> table(materials.begin(),
+                                materials.begin() + std::min<size_t>(materials.size(), kMaxMaterials));
+    if (table.size() < materials.size()) {
+        qWarning() << "RCSCompute::setMaterials - Keeping the first" << kMaxMaterials << "of"
+                   << materials.size() << "materials";
+    }
+    bool same = table.size() == materials_.size() &&
+                std::memcmp(table.data(), materials_.data(), table.size() * sizeof(Material)) == 0;
+    if (same) {
+        return;
+    }
+    materials_ = std::move(table);
+    materialsDirty_ = true;
+    restartProgressive();
+}
+
+void RCSCompute::setRaySampling(RaySampling sampling) {
+    if (raySampling_ != sampling) {
+        raySampling_ = sampling;
+        restartProgressive();
+    }
+}
+
+void RCSCompute::setSampleJitter(bool enabled) {
+    if (sampleJitter_ != enabled) {
+        sampleJitter_ = enabled;
+        restartProgressive();
+    }
+}
+
+void RCSCompute::setBoundsFocus(bool enabled) {
+    if (boundsFocus_ != enabled) {
+        boundsFocus_ = enabled;
+        restartProgressive();
+    }
+}
+
+void RCSCompute::updateRayFocus() {
+    // Called after the TLAS upload, so the bounds match the traced scene. The
+    // inputs only change along with a progressive restart, so an accumulation
+    // keeps one cone throughout.
+    focusHalfAngle_ = 0.0f;
+    if (!boundsFocus_ || tlasNodeCount_ == 0) return;
+
+    QVector3D toCenter = sceneBounds_.center() - radarPosition_;
+    float distance = toCenter.length();
+    float radius = 0.5f * (sceneBounds_.max - sceneBounds_.min).length();
+    float beamHalfAngle = 0.5f * beamWidthDegrees_ * kDegToRadF;
+    if (distance <= radius) return;  // Radar inside the bounds
+
+    // Only worth it when the target's bounding cone is narrower than the beam
+    float targetHalfAngle = std::asin(radius / distance);
+    if (targetHalfAngle >= beamHalfAngle) return;
+    focusDirection_ = toCenter / distance;
+    focusHalfAngle_ = targetHalfAngle;
+}
+
+float RCSCompute::raySolidAngle() const {
+    float halfAngle = isRayFocusActive() ? focusHalfAngle_ : 0.5f * beamWidthDegrees_ * kDegToRadF;
+    return static_cast<float>(kTwoPi * (1.0 - std::cos(halfAngle)) / std::max(numRays_, 1));
+}
+
+bool RCSCompute::hasPendingResults() {
+    if (!initialized_ || frameCounter_ == 0) return false;
+    pollReadbackSlots();
+    return latestSlot_ < 0 || readbackSlots_[latestSlot_].frameIndex < frameCounter_;
+}
+
+void RCSCompute::setSphereRadius(float radius) {
+    sphereRadius_ = radius;
+}
+
+void RCSCompute::setNumRays(int numRays) {
+    numRays = std::clamp(numRays, 1, kMaxRayCount);
+    if (numRays_ != numRays) {
+        int oldTileCapacity = getTileCapacity();
+        int oldSlotCapacity = getSlotHitCapacity();
+        numRays_ = numRays;
+        restartProgressive();
+
+        // Ray and hit buffers only hold one tile, so they stop growing at kRayTileSize
+        if (getTileCapacity() != oldTileCapacity) {
+            if (rayBuffer_) {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, rayBuffer_);
+                glBufferData(GL_SHADER_STORAGE_BUFFER, getTileCapacity() * sizeof(Ray), nullptr, GL_DYNAMIC_DRAW);
+            }
+            if (tileHitBuffer_) {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, tileHitBuffer_);
+                glBufferData(GL_SHADER_STORAGE_BUFFER, getTileCapacity() * sizeof(HitResult), nullptr, GL_DYNAMIC_COPY);
+            }
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+            memoryDirty_ = true;
+        }
+
+        // Immutable storage can't be resized - recreate the readback ring.
+        // hitResults_ keeps the last copied results until a new slot completes.
+        if (initialized_ && getSlotHitCapacity() != oldSlotCapacity) {
+            destroyReadbackSlots();
+            createReadbackSlots();
+        }
+
+        // Shadow map rows follow the ring count up to kShadowMapMaxRings
+        // unless the map has its own resolution
+        int width = 0;
+        int rings = 0;
+        shadowGridSize(width, rings);
+        if (initialized_ && (width != shadowMapResolution_ || rings != shadowMapRings_)) {
+            createShadowMap();
+            shadowMapReady_ = false;
+        }
+    }
+}
+
+int RCSCompute::getSlotHitCapacity() const {
+    // Hits-only output appends the hits of every tile, so it is sized for the
+    // whole frame (every ray hitting) up to kMaxCompactHits; the per-ray formats
+    // keep the first tile. Whatever does not fit is counted as dropped.
+    switch (hitPayload_) {
+    case HitPayload::None:
+        return 0;
+    case HitPayload::CompactHitsOnly:
+        return std::max(std::min(numRays_, RS::Constants::kMaxCompactHits), 1);
+    default:
+        return std::max(getTileCapacity(), 1);
+    }
+}
+
+void RCSCompute::createReadbackSlots() {
+    // New slots hold nothing to accumulate onto
+    restartProgressive();
+
+    // Persistent + coherent: the CPU reads straight from the mapping once the
+    // slot's fence has signaled. Per-frame resets use glClearBufferData, which
+    // runs on the GPU, so no DYNAMIC_STORAGE (CPU upload) access is needed.
+    const GLbitfield storageFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLbitfield mapFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    slotHitStride_ = payloadStride(hitPayload_);
+    int capacity = getSlotHitCapacity();
+    GLsizeiptr hitBytes = std::max<GLsizeiptr>(capacity * slotHitStride_, sizeof(CompactHit));
+
+    for (auto& slot : readbackSlots_) {
+        glGenBuffers(1, &slot.hitBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.hitBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, hitBytes, nullptr, storageFlags);
+        slot.mappedHits = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, hitBytes, mapFlags);
+        slot.capacity = capacity;
+
+        // Every hit atomically increments the counter, so it stays in video
+        // memory; compute() copies the final count into the mapped readback
+        glGenBuffers(1, &slot.counterBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.counterBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), nullptr, 0);
+        glGenBuffers(1, &slot.counterReadback);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, slot.counterReadback);
+        glBufferStorage(GL_COPY_WRITE_BUFFER, sizeof(GLuint), nullptr, storageFlags);
+        slot.mappedCounter = static_cast<const GLuint*>(
+            glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, sizeof(GLuint), mapFlags));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        const GLsizeiptr polarBytes = kPolarPlotBins * sizeof(PolarBin);
+        glGenBuffers(1, &slot.polarBinBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.polarBinBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, polarBytes, nullptr, storageFlags);
+        slot.mappedPolarBins = static_cast<const PolarBin*>(
+            glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, polarBytes, mapFlags));
+
+        const GLsizeiptr clusterBytes = 4 * sizeof(GLuint) + kLobeClusterMaxOutput * sizeof(ReflectionCluster);
+        glGenBuffers(1, &slot.clusterBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.clusterBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, clusterBytes, nullptr, storageFlags);
+        slot.mappedClusters = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, clusterBytes, mapFlags);
+
+        if (!slot.mappedHits || !slot.mappedCounter || !slot.mappedPolarBins || !slot.mappedClusters) {
+            qWarning() << "RCSCompute: Failed to persistently map readback buffers";
+        }
+
+        slot.fence = nullptr;
+        slot.counterFence = nullptr;
+        slot.frameIndex = 0;
+        slot.numRays = 0;
+        slot.payload = hitPayload_;
+        slot.polarBinned = false;
+        slot.lobeClustered = false;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    writeSlot_ = 0;
+    latestSlot_ = -1;
+    latestCountSlot_ = -1;
+    memoryDirty_ = true;
+}
+
+void RCSCompute::destroyReadbackSlots() {
+    for (auto& slot : readbackSlots_) {
+        if (slot.fence) { glDeleteSync(slot.fence); slot.fence = nullptr; }
+        if (slot.counterFence) { glDeleteSync(slot.counterFence); slot.counterFence = nullptr; }
+        // Deleting a buffer implicitly unmaps it
+        if (slot.hitBuffer) { glDeleteBuffers(1, &slot.hitBuffer); slot.hitBuffer = 0; }
+        if (slot.counterBuffer) { glDeleteBuffers(1, &slot.counterBuffer); slot.counterBuffer = 0; }
+        if (slot.counterReadback) { glDeleteBuffers(1, &slot.counterReadback); slot.counterReadback = 0; }
+        if (slot.polarBinBuffer) { glDeleteBuffers(1, &slot.polarBinBuffer); slot.polarBinBuffer = 0; }
+        if (slot.clusterBuffer) { glDeleteBuffers(1, &slot.clusterBuffer); slot.clusterBuffer = 0; }
+        if (slot.frequencyBinBuffer) { glDeleteBuffers(1, &slot.frequencyBinBuffer); slot.frequencyBinBuffer = 0; }
+        if (slot.sphereBinBuffer) { glDeleteBuffers(1, &slot.sphereBinBuffer); slot.sphereBinBuffer = 0; }
+        slot.mappedSphereBins = nullptr;
+        slot.sphereBinned = false;
+        if (slot.receiverBinBuffer) { glDeleteBuffers(1, &slot.receiverBinBuffer); slot.receiverBinBuffer = 0; }
+        slot.mappedReceiverBins = nullptr;
+        slot.receiversBinned = false;
+        slot.mappedFrequencyBins = nullptr;
+        slot.frequencyPoints = 0;
+        slot.mappedHits = nullptr;
+        slot.mappedCounter = nullptr;
+        slot.mappedPolarBins = nullptr;
+        slot.mappedClusters = nullptr;
+        slot.capacity = 0;
+        slot.lobeClustered = false;
+        slot.polarBinned = false;
+        slot.numRays = 0;
+    }
+    latestSlot_ = -1;
+    latestCountSlot_ = -1;
+}
+
+void RCSCompute::pollReadbackSlots() {
+    auto signaled = [this](GLsync& fence) {
+        if (!fence) return false;
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+        glDeleteSync(fence);
+        fence = nullptr;
+        return true;
+    };
+    auto newer = [this](int candidate, int current) {
+        return current < 0 || readbackSlots_[candidate].frameIndex > readbackSlots_[current].frameIndex;
+    };
+
+    // Non-blocking: retire every slot or hit count whose fence has already
+    // signaled. The count is fenced as soon as tracing ends, so it usually
+    // lands before the rest of its slot.
+    for (int i = 0; i < static_cast<int>(readbackSlots_.size()); ++i) {
+        ReadbackSlot& slot = readbackSlots_[i];
+        if (signaled(slot.counterFence) && newer(i, latestCountSlot_)) {
+            latestCountSlot_ = i;
+        }
+        if (signaled(slot.fence)) {
+            if (slot.counterFence) {
+                glDeleteSync(slot.counterFence);  // Implied by the later slot fence
+                slot.counterFence = nullptr;
+            }
+            if (newer(i, latestSlot_)) latestSlot_ = i;
+            if (newer(i, latestCountSlot_)) latestCountSlot_ = i;
+        }
+    }
+
+    if (latestCountSlot_ >= 0 && readbackSlots_[latestCountSlot_].mappedCounter) {
+        hitCount_ = static_cast<int>(*readbackSlots_[latestCountSlot_].mappedCounter);
+        completedRays_ = readbackSlots_[latestCountSlot_].accumulatedRays;
+    }
+}
+
+bool RCSCompute::waitForSlot(int slotIndex) {
+    ReadbackSlot& slot = readbackSlots_[slotIndex];
+    if (slot.fence) {
+        GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kReadbackWaitTimeoutNs);
+        if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+            qWarning() << "RCSCompute: Timed out waiting for readback fence";
+            return false;
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (slot.counterFence) {
+        glDeleteSync(slot.counterFence);
+        slot.counterFence = nullptr;
+    }
+    if (slot.frameIndex == 0) return false;  // Never dispatched
+
+    if (latestSlot_ < 0 || slot.frameIndex >= readbackSlots_[latestSlot_].frameIndex) {
+        latestSlot_ = slotIndex;
+    }
+    if (latestCountSlot_ < 0 || slot.frameIndex >= readbackSlots_[latestCountSlot_].frameIndex) {
+        latestCountSlot_ = slotIndex;
+    }
+    if (slot.mappedCounter) {
+        hitCount_ = static_cast<int>(*slot.mappedCounter);
+        completedRays_ = slot.accumulatedRays;
+    }
+    return true;
+}
+
+void RCSCompute::uploadBVH() {
+    pollGPUBVHBuilds();
+    if (!bvhDirty_) return;
+    RS::FrameProfiler::Scope profile(profiler_, "uploadBVH");
+    restartProgressive();
+    ++sceneRevision_;
+
+    // Swap finished builds in. A refit keeps its mesh's node and triangle counts,
+    // so it can overwrite its range of the shared buffers in place; anything
+    // else repacks every mesh.
+    bool repack = blasLayoutDirty_;
+    std::vector<MeshState*> updated;
+    for (auto& entry : meshes_) {
+        MeshState& mesh = entry.second;
+        // A GPU rebuild with the same triangle count is always in place
+        if (mesh.gpu.buildPending) {
+            updated.push_back(&mesh);
+            continue;
+        }
+        if (!mesh.pendingBvh) continue;
+
+        // Build ran on the worker thread; report it in the frame that consumes it
+        if (profiler_) {
+            profiler_->addCpuStage("BVH build", mesh.pendingBvh->buildTimeMs);
+        }
+
+        bool inPlace = mesh.pendingBvh->refit && mesh.bvh &&
+                       mesh.bvh->nodes.size() == mesh.pendingBvh->nodes.size() &&
+                       mesh.bvh->wideNodes.size() == mesh.pendingBvh->wideNodes.size() &&
+                       mesh.bvh->triangles.size() == mesh.pendingBvh->triangles.size();
+        repack = repack || !inPlace;
+
+        // The uploaded snapshot becomes the one traced (GPU and CPU debug rays)
+        mesh.bvh = std::move(mesh.pendingBvh);
+        updated.push_back(&mesh);
+    }
+
+    // The stack kernel silently drops subtrees past kBVHStackSize levels
+    bool exceedsStack = false;
+    bool wideFits = bvhLayout_ == BVHLayout::Wide4;
+    bool gpuMeshes = false;
+    for (const auto& entry : meshes_) {
+        // GPU trees have no wide form; until a build reports its depth, assume
+        // it may be too deep for the stack
+        if (entry.second.gpuBuilt()) {
+            gpuMeshes = true;
+            wideFits = false;
+            const int depth = entry.second.gpu.maxDepth;
+            if (depth < 0 || depth + 1 > kBVHStackSize) {
+                exceedsStack = true;
+            }
+            continue;
+        }
+        const BVHSnapshotPtr& bvh = entry.second.bvh;
+        if (!bvh) continue;
+        if (bvh->maxDepth + 1 > kBVHStackSize) {
+            exceedsStack = true;
+        }
+        // The wide kernel pushes up to three extra children per level
+        if (bvh->wideNodes.empty() || 3 * bvh->wideMaxDepth + 1 > kBVHStackSize) {
+            wideFits = false;
+        }
+    }
+    if (exceedsStack && !bvhExceedsStack_ && traversalMode_ == TraversalMode::Stack) {
+        qWarning() << "RCSCompute: BVH deeper than" << kBVHStackSize << "levels, using stackless traversal";
+    }
+    if (bvhLayout_ == BVHLayout::Wide4 && !wideFits && (wideBvhActive_ || repack)) {
+        qWarning() << "RCSCompute: Mesh does not fit the wide BVH encoding, using the binary layout";
+    }
+    bvhExceedsStack_ = exceedsStack;
+    if (wideFits != wideBvhActive_) {
+        wideBvhActive_ = wideFits;
+        repack = true;
+    }
+    const bool cones = normalConeCulling_ && !wideBvhActive_;
+    if (normalConeCulling_ && wideBvhActive_ && (normalConesActive_ || repack)) {
+        qWarning() << "RCSCompute: Normal-cone culling needs the binary BVH layout, not culling";
+    }
+    if (cones != normalConesActive_) {
+        normalConesActive_ = cones;
+        repack = true;
+    }
+    // Compact triangles are encoded against the active layout's leaf boxes,
+    // so a layout switch re-encodes them through the repack as well. The GPU
+    // builder writes full-precision triangles only.
+    if (trianglePrecision_ == TrianglePrecision::Compact && gpuMeshes && (compactTrianglesActive_ || repack)) {
+        qWarning() << "RCSCompute: GPU-built meshes need full-precision triangles, not compacting";
+    }
+    bool compact = trianglePrecision_ == TrianglePrecision::Compact && !gpuMeshes;
+    if (compact != compactTrianglesActive_) {
+        compactTrianglesActive_ = compact;
+        repack = true;
+    }
+    const size_t triangleStride = compactTrianglesActive_ ? sizeof(CompactTriangle) : sizeof(Triangle);
+
+    if (repack) {
+        // Over the GPU memory budget, meshes no instance places give their
+        // space back. Their CPU snapshots stay, so setInstances() only needs a
+        // repack to bring one back.
+        const size_t nodeStride = wideBvhActive_ ? sizeof(WideBVHNode)
+                                                 : sizeof(BVHNode) + sizeof(int32_t) +
+                                                   (normalConesActive_ ? sizeof(QVector4D) : 0);
+        size_t packedBytes = 0;
+        for (const auto& entry : meshes_) {
+            packedBytes += meshNodeCount(entry.second) * nodeStride + meshTriangleCount(entry.second) * triangleStride;
+        }
+        const bool evictInactive = packedBytes > geometryBytes_ &&
+                                   !RS::GPUMemory::fits(packedBytes - geometryBytes_);
+        auto isInstanced = [this](uint32_t meshId) {
+            return std::any_of(instanceStates_.begin(), instanceStates_.end(),
+                               [meshId](const InstanceState& instance) { return instance.meshId == meshId; });
+        };
+
+        // Meshes back to back; instances address their mesh by these offsets
+        size_t totalNodes = 0;
+        size_t totalTriangles = 0;
+        size_t evicted = 0;
+        for (auto& entry : meshes_) {
+            MeshState& mesh = entry.second;
+            mesh.nodeOffset = static_cast<int>(totalNodes);
+            mesh.triangleOffset = static_cast<int>(totalTriangles);
+            mesh.resident = mesh.hasTree() && (!evictInactive || isInstanced(entry.first));
+            if (mesh.resident) {
+                totalNodes += meshNodeCount(mesh);
+                totalTriangles += meshTriangleCount(mesh);
+            } else if (mesh.hasTree()) {
+                evicted++;
+            }
+        }
+        if (evicted > 0) {
+            qWarning() << "RCSCompute: Over the GPU memory budget, evicted" << evicted << "uninstanced BLAS";
+        }
+
+        updated.clear();
+        for (auto& entry : meshes_) {
+            if (entry.second.resident) {
+                updated.push_back(&entry.second);
+            }
+        }
+
+        // Only the active layout is resident; the skip links belong to the binary one
+        if (totalNodes > 0) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, bvhBuffer_);
+            glBufferData(GL_SHADER_STORAGE_BUFFER,
+                         totalNodes * (wideBvhActive_ ? sizeof(WideBVHNode) : sizeof(BVHNode)),
+                         nullptr, GL_DYNAMIC_DRAW);
+            if (!wideBvhActive_) {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, skipBuffer_);
+                glBufferData(GL_SHADER_STORAGE_BUFFER, totalNodes * sizeof(int32_t), nullptr, GL_DYNAMIC_DRAW);
+            }
+        }
+        if (normalConesActive_ && totalNodes > 0) {
+            if (!normalConeBuffer_) {
+                glGenBuffers(1, &normalConeBuffer_);
+            }
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, normalConeBuffer_);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, totalNodes * sizeof(QVector4D), nullptr, GL_DYNAMIC_DRAW);
+        } else if (normalConeBuffer_) {
+            glDeleteBuffers(1, &normalConeBuffer_);
+            normalConeBuffer_ = 0;
+        }
+        if (totalTriangles > 0) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, triangleBuffer_);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, totalTriangles * triangleStride, nullptr, GL_DYNAMIC_DRAW);
+        }
+        RS::GPUMemory::checkAllocation("RCSCompute BLAS buffers");
+        geometryBytes_ = totalNodes * nodeStride + totalTriangles * triangleStride;
+        blasLayoutDirty_ = false;
+        memoryDirty_ = true;
+    }
+
+    // Cones that never cull, for trees without any
+    auto clearNormalCones = [this](const MeshState& mesh) {
+        const GLfloat noCone[4] = {0.0f, 0.0f, 1.0f, kNoNormalCone};
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, normalConeBuffer_);
+        glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_RGBA32F, mesh.nodeOffset * sizeof(QVector4D),
+                             meshNodeCount(mesh) * sizeof(QVector4D), GL_RGBA, GL_FLOAT, noCone);
+    };
+
+    for (MeshState* mesh : updated) {
+        // Refit of an evicted mesh - nothing resident to overwrite
+        if (!mesh->resident) continue;
+        if (mesh->gpuBuilt()) {
+            // Writes straight into its range; a repack builds it again
+            buildMeshOnGPU(*mesh);
+            if (normalConesActive_) {
+                clearNormalCones(*mesh);
+            }
+            continue;
+        }
+        const auto& triangles = mesh->bvh->triangles;
+        if (wideBvhActive_) {
+            const auto& wideNodes = mesh->bvh->wideNodes;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, bvhBuffer_);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, mesh->nodeOffset * sizeof(WideBVHNode),
+                            wideNodes.size() * sizeof(WideBVHNode), wideNodes.data());
+        } else {
+            const auto& nodes = mesh->bvh->nodes;
+            if (!nodes.empty()) {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, bvhBuffer_);
+                glBufferSubData(GL_SHADER_STORAGE_BUFFER, mesh->nodeOffset * sizeof(BVHNode),
+                                nodes.size() * sizeof(BVHNode), nodes.data());
+            }
+            // A refit keeps the topology, so its skip links are unchanged
+            const auto& skipLinks = mesh->bvh->skipLinks;
+            if (!skipLinks.empty()) {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, skipBuffer_);
+                glBufferSubData(GL_SHADER_STORAGE_BUFFER, mesh->nodeOffset * sizeof(int32_t),
+                                skipLinks.size() * sizeof(int32_t), skipLinks.data());
+            }
+            // Refits move the normals, so the cones always go up
+            const auto& normalCones = mesh->bvh->normalCones;
+            if (normalConesActive_ && normalCones.size() == nodes.size()) {
+                glBindBuffer(GL_SHADER_STORAGE_BUFFER, normalConeBuffer_);
+                glBufferSubData(GL_SHADER_STORAGE_BUFFER, mesh->nodeOffset * sizeof(QVector4D),
+                                normalCones.size() * sizeof(QVector4D), normalCones.data());
+            } else if (normalConesActive_) {
+                clearNormalCones(*mesh);
+            }
+        }
+        if (!triangles.empty()) {
+            const void* data = triangles.data();
+            if (compactTrianglesActive_) {
+                encodeCompactTriangles(*mesh->bvh, wideBvhActive_, compactScratch_);
+                data = compactScratch_.data();
+            }
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, triangleBuffer_);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, mesh->triangleOffset * triangleStride,
+                            triangles.size() * triangleStride, data);
+        }
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // Memory barrier to ensure buffer updates are visible to compute shaders
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    // Mesh bounds or offsets may have changed under the instances
+    bvhDirty_ = false;
+    tlasDirty_ = true;
+}
+
+void RCSCompute::uploadTLAS() {
+    if (!tlasDirty_) return;
+    RS::FrameProfiler::Scope profile(profiler_, "uploadTLAS");
+    restartProgressive();
+    ++sceneRevision_;
+    shadowDirty_ = true;
+
+    // Instances whose mesh has no BVH yet are left out until it arrives
+    std::vector<AABB> bounds;
+    std::vector<int> sources;
+    bounds.reserve(instanceStates_.size());
+    sources.reserve(instanceStates_.size());
+    for (size_t i = 0; i < instanceStates_.size(); ++i) {
+        const InstanceState& instance = instanceStates_[i];
+        auto it = meshes_.find(instance.meshId);
+        if (it == meshes_.end() || !it->second.resident) {
+            continue;
+        }
+        const MeshState& mesh = it->second;
+        AABB local;
+        if (mesh.gpuBuilt()) {
+            local = mesh.gpu.bounds;  // Empty until the first build reports
+        } else if (!mesh.bvh->nodes.empty()) {
+            local.min = mesh.bvh->nodes[0].boundsMin.toVector3D();
+            local.max = mesh.bvh->nodes[0].boundsMax.toVector3D();
+        }
+        if (local.min.x() > local.max.x()) {
+            continue;
+        }
+        bounds.push_back(transformBounds(local.min, local.max, instance.modelMatrix));
+        sources.push_back(static_cast<int>(i));
+    }
+
+    sceneBounds_ = AABB();
+    for (const AABB& box : bounds) {
+        sceneBounds_.expand(box);
+    }
+
+    tlasBuilder_.build(bounds);
+    if (tlasBuilder_.isDepthCapped()) {
+        qWarning() << "RCSCompute:" << bounds.size() << "instances exceed the" << kTLASStackSize
+                   << "level top-level stack, deepest leaves hold several instances";
+    }
+    const auto& tlasNodes = tlasBuilder_.getNodes();
+    const auto& order = tlasBuilder_.getInstanceOrder();
+
+    // Instances are stored in TLAS leaf order so leaves index them directly
+    std::vector<InstanceData> gpuInstances(order.size());
+    for (size_t slot = 0; slot < order.size(); ++slot) {
+        int source = sources[order[slot]];
+        const InstanceState& instance = instanceStates_[source];
+        const MeshState& mesh = meshes_.at(instance.meshId);
+        InstanceData& data = gpuInstances[slot];
+
+        std::memcpy(data.invModel, instance.invModelMatrix.constData(), sizeof(data.invModel));
+        QMatrix3x3 normalMatrix = instance.modelMatrix.normalMatrix();
+        for (int col = 0; col < 3; ++col) {
+            for (int row = 0; row < 3; ++row) {
+                data.normalMatrix[col * 4 + row] = normalMatrix(row, col);
+            }
+            data.normalMatrix[col * 4 + 3] = 0.0f;
+        }
+        data.nodeOffset = static_cast<uint32_t>(mesh.nodeOffset);
+        data.nodeCount = static_cast<uint32_t>(meshNodeCount(mesh));
+        data.triangleOffset = static_cast<uint32_t>(mesh.triangleOffset);
+        data.targetId = static_cast<uint32_t>(source);
+    }
+
+    if (!tlasNodes.empty()) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, tlasBuffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, tlasNodes.size() * sizeof(BVHNode), tlasNodes.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, instanceBuffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, gpuInstances.size() * sizeof(InstanceData), gpuInstances.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
+
+    tlasNodeCount_ = static_cast<int>(tlasNodes.size());
+    tlasDirty_ = false;
+    memoryDirty_ = true;
+}
+
+void RCSCompute::accountMemory() {
+    memoryDirty_ = false;
+
+    // Binding makes a generated but unused name a zero-sized buffer
+    auto bufferBytes = [this](std::initializer_list<GLuint> buffers) {
+        uint64_t total = 0;
+        for (GLuint buffer : buffers) {
+            if (buffer == 0) continue;
+            GLint64 size = 0;
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+            glGetBufferParameteri64v(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+            total += static_cast<uint64_t>(std::max<GLint64>(size, 0));
+        }
+        return total;
+    };
+    // Both textures are single-level R32F
+    auto textureBytes = [this](GLuint texture) -> uint64_t {
+        if (texture == 0) return 0;
+        GLint width = 0;
+        GLint height = 0;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+        return static_cast<uint64_t>(width) * height * sizeof(float);
+    };
+
+    rayMemory_.resize(bufferBytes({rayBuffer_, tileHitBuffer_, bounceQueueBuffer_, lookRayBuffer_, lookHitBuffer_,
+                                   workCounterBuffer_, seedBuffer_}));
+    sceneMemory_.resize(bufferBytes({bvhBuffer_, skipBuffer_, normalConeBuffer_, triangleBuffer_, tlasBuffer_,
+                                     instanceBuffer_, materialBuffer_, primitiveBuffer_, edgeBuffer_}));
+    uint64_t results = bufferBytes({lobeClusterTable_, heatMapBinBuffer_, heatMapIntensityBuffer_,
+                                    lookBuffer_, lookCounterBuffer_, lookPolarBinBuffer_, hotspotBuffer_});
+    for (const auto& slot : readbackSlots_) {
+        results += bufferBytes({slot.hitBuffer, slot.counterBuffer, slot.counterReadback, slot.polarBinBuffer, slot.clusterBuffer,
+                                slot.frequencyBinBuffer, slot.sphereBinBuffer, slot.receiverBinBuffer});
+    }
+    resultMemory_.resize(results);
+    textureMemory_.resize(textureBytes(shadowMapTexture_) + textureBytes(beamPatternTexture_));
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool RCSCompute::isStacklessTraversalActive() const {
+    return !wideBvhActive_ && (traversalMode_ == TraversalMode::Stackless || bvhExceedsStack_);
+}
+
+uint32_t RCSCompute::traceVariantKey(HitPayload payload) const {
+    uint32_t key = static_cast<uint32_t>(payload) << kTracePayloadShift;
+    if (wideBvhActive_) {
+        key |= kTraceWideBVH;
+    } else if (isStacklessTraversalActive()) {
+        key |= kTraceStackless;
+    }
+    if (compactTrianglesActive_) {
+        key |= kTraceCompactTriangles;
+    }
+    if (maxBounces_ > 1) {
+        key |= kTraceMultiBounce;
+    }
+    if (persistentThreads_) {
+        key |= kTracePersistent;
+    }
+    if (normalConesActive_) {
+        key |= kTraceNormalCones;
+    }
+    if (temporalReuse_ && !wideBvhActive_) {
+        key |= kTraceTemporalReuse;
+    }
+    if (isHotspotsActive()) {
+        key |= kTraceHotspots;
+    }
+    return key;
+}
+
+QOpenGLShaderProgram* RCSCompute::traceProgram(HitPayload payload, bool shadowVisibility) {
+    uint32_t key = traceVariantKey(payload);
+    if (shadowVisibility) {
+        key = (key & ~(kTraceMultiBounce | kTracePersistent | kTraceTemporalReuse | kTraceHotspots)) |
+              kTraceShadowVisibility;  // One texel per lane
+    }
+    if (traceProgramsStale_) {
+        tracePrograms_.clear();
+        traceProgramsStale_ = false;
+    }
+    auto found = tracePrograms_.find(key);
+    if (found != tracePrograms_.end()) {
+        return found->second.get();  // Null if this variant failed to build
+    }
+
+    std::vector<QByteArray> defines;
+    defines.push_back(QByteArray("HIT_PAYLOAD ") + QByteArray::number(static_cast<int>(payload)));
+    if (key & kTraceStackless) defines.push_back("STACKLESS_TRAVERSAL");
+    if (key & kTraceWideBVH) defines.push_back("WIDE_BVH");
+    if (key & kTraceCompactTriangles) defines.push_back("COMPACT_TRIANGLES");
+    if (key & kTraceMultiBounce) defines.push_back("MULTI_BOUNCE");
+    if (key & kTraceShadowVisibility) defines.push_back("SHADOW_VISIBILITY");
+    if (key & kTracePersistent) defines.push_back("PERSISTENT_THREADS");
+    if (key & kTraceNormalCones) defines.push_back("NORMAL_CONE_CULLING");
+    if (key & kTraceTemporalReuse) defines.push_back("TEMPORAL_REUSE");
+    if (key & kTraceHotspots) defines.push_back("TRIANGLE_HOTSPOTS");
+    if (!bounceEffectChain_.isEmpty()) defines.push_back(QByteArray("BOUNCE_EFFECT_CHAIN ") + bounceEffectChain_);
+
+    auto program = std::make_unique<QOpenGLShaderProgram>();
+    if (!program->addCacheableShaderFromSourceCode(QOpenGLShader::Compute,
+                                                   withDefines(traceShaderSource, defines)) ||
+        !program->link()) {
+        qWarning() << "Failed to build trace shader variant" << QString::number(key, 16) << ":" << program->log();
+        program.reset();
+    }
+    return tracePrograms_.emplace(key, std::move(program)).first->second.get();
+}
+
+void RCSCompute::bindScene(QOpenGLShaderProgram* program) {
+    // Program must be bound
+    program->setUniformValue("numTlasNodes", tlasNodeCount_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, bvhBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, triangleBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 12, instanceBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 13, tlasBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 14, skipBuffer_);
+    if (normalConesActive_) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 23, normalConeBuffer_);
+    }
+
+    // Surface materials and the bounce effect chain's parameters
+    if (materialsDirty_) {
+        uploadMaterials();
+    }
+    program->setUniformValue("numMaterials", static_cast<int>(materials_.size()));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 19, materialBuffer_);
+
+    if (primitivesDirty_) {
+        uploadPrimitives();
+    }
+    program->setUniformValue("numPrimitives", static_cast<int>(primitives_.size()));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 20, primitiveBuffer_);
+    if (!effectParams_.empty()) {
+        program->setUniformValueArray("effectParams", effectParams_.data(), static_cast<int>(effectParams_.size()));
+    }
+}
+
+void RCSCompute::uploadMaterials() {
+    materialsDirty_ = false;
+    ++sceneRevision_;
+    if (!materialBuffer_) {
+        glGenBuffers(1, &materialBuffer_);
+    }
+    // Never empty, so binding 19 always has storage behind it
+    Material fallback;
+    const Material* data = materials_.empty() ? &fallback : materials_.data();
+    size_t count = std::max<size_t>(materials_.size(), 1);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, materialBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(count * sizeof(Material)), data, GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
+}
+
+void RCSCompute::uploadPrimitives() {
+    primitivesDirty_ = false;
+    ++sceneRevision_;
+    if (!primitiveBuffer_) {
+        glGenBuffers(1, &primitiveBuffer_);
+    }
+
+    // Never empty, so binding 20 always has storage behind it
+    std::vector<PrimitiveData> data(std::max<size_t>(primitives_.size(), 1));
+    for (size_t i = 0; i < primitives_.size(); ++i) {
+        const ScenePrimitive& primitive = primitives_[i];
+        PrimitiveData& gpu = data[i];
+        bool invertible = false;
+        QMatrix4x4 invModel = primitive.modelMatrix.inverted(&invertible);
+        if (!invertible) {
+            qWarning() << "RCSCompute::setPrimitives - Singular transform for primitive" << i << ", using identity";
+            invModel.setToIdentity();
+        }
+        std::memcpy(gpu.invModel, invModel.constData(), sizeof(gpu.invModel));
+        QMatrix3x3 normalMatrix = primitive.modelMatrix.normalMatrix();
+        for (int col = 0; col < 3; ++col) {
+            for (int row = 0; row < 3; ++row) {
+                gpu.normalMatrix[col * 4 + row] = normalMatrix(row, col);
+            }
+            gpu.normalMatrix[col * 4 + 3] = 0.0f;
+        }
+        gpu.shape = static_cast<uint32_t>(primitive.shape);
+        gpu.targetId = primitive.targetId;
+        gpu.materialId = primitive.materialId;
+        gpu.reserved = 0;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, primitiveBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(data.size() * sizeof(PrimitiveData)),
+                 data.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
+}
+
+void RCSCompute::dispatchRayGeneration(int rayOffset, int tileRays) {
+    rayGenShader_->bind();
+
+    // Set uniforms
+    rayGenShader_->setUniformValue("radarPosition", radarPosition_);
+    rayGenShader_->setUniformValue("beamDirection", beamDirection_);
+    rayGenShader_->setUniformValue("beamWidthRad", beamWidthDegrees_ * kDegToRadF);
+    rayGenShader_->setUniformValue("maxDistance", sphereRadius_ * kMaxRayDistanceMultiplier);
+    rayGenShader_->setUniformValue("numRays", tileRays);
+    rayGenShader_->setUniformValue("rayOffset", rayOffset);
+
+    // Ring parameters cover the whole beam, not just this tile
+    rayGenShader_->setUniformValue("raysPerRing", kRaysPerRing);
+    rayGenShader_->setUniformValue("numRings", getNumRings());
+    rayGenShader_->setUniformValue("numLooks", 0);
+    rayGenShader_->setUniformValue("rayStride", rayOrderStride());
+    rayGenShader_->setUniformValue("totalRays", numRays_);
+    rayGenShader_->setUniformValue("sampling", static_cast<int>(raySampling_));
+    rayGenShader_->setUniformValue("sampleRotation", sampleRotation_[0], sampleRotation_[1]);
+    rayGenShader_->setUniformValue("focusDirection", focusDirection_);
+    rayGenShader_->setUniformValue("focusHalfAngle", focusHalfAngle_);
+    bindBeamPattern();
+
+    // Bind ray buffer
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, rayBuffer_);
+
+    // Dispatch
+    int numGroups = (tileRays + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    glDispatchCompute(numGroups, 1, 1);
+
+    // Memory barrier
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    unbindBeamPattern();
+    rayGenShader_->release();
+}
+
+void RCSCompute::setBeamPattern(const std::vector<float>& gain, int azimuthBins, int offAxisBins) {
+    if (!initialized_) {
+        qWarning() << "RCSCompute::setBeamPattern - Not initialized";
+        return;
+    }
+    if (azimuthBins <= 0 || offAxisBins <= 0 ||
+        gain.size() != static_cast<size_t>(azimuthBins) * offAxisBins) {
+        qWarning() << "RCSCompute::setBeamPattern - Table of" << gain.size() << "gains is not"
+                   << azimuthBins << "x" << offAxisBins;
+        return;
+    }
+
+    if (!beamPatternTexture_) {
+        glGenTextures(1, &beamPatternTexture_);
+    }
+    glBindTexture(GL_TEXTURE_2D, beamPatternTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, azimuthBins, offAxisBins, 0, GL_RED, GL_FLOAT, gain.data());
+    memoryDirty_ = true;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);         // Azimuth wraps
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);  // Off-axis clamps
+    glBindTexture(GL_TEXTURE_2D, 0);
+    restartProgressive();
+}
+
+void RCSCompute::clearBeamPattern() {
+    if (beamPatternTexture_) {
+        glDeleteTextures(1, &beamPatternTexture_);
+        beamPatternTexture_ = 0;
+        restartProgressive();
+    }
+}
+
+void RCSCompute::bindBeamPattern() {
+    // Ray generation program must be bound
+    rayGenShader_->setUniformValue("beamPatternEnabled", beamPatternTexture_ != 0);
+    rayGenShader_->setUniformValue("beamPattern", kBeamPatternTextureUnit);
+    glActiveTexture(GL_TEXTURE0 + kBeamPatternTextureUnit);
+    glBindTexture(GL_TEXTURE_2D, beamPatternTexture_);
+}
+
+void RCSCompute::unbindBeamPattern() {
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void RCSCompute::dispatchTracing(int rayOffset, int tileRays) {
+    const ReadbackSlot& slot = readbackSlots_[writeSlot_];
+
+    QOpenGLShaderProgram* trace = traceProgram(hitPayload_);
+    if (!trace) {
+        return;
+    }
+    const bool sorted = sortRays(rayBuffer_, tileRays, 0);
+    trace->bind();
+
+    // Set uniforms
+    trace->setUniformValue("numRays", tileRays);
+    trace->setUniformValue("rayOffset", rayOffset);
+
+    // Bind buffers
+    bindScene(trace);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, rayBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, tileHitBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, slot.counterBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, slot.hitBuffer);
+    trace->setUniformValue("compactCapacity", static_cast<GLuint>(slot.capacity));
+    trace->setUniformValue("payloadOffset", frameRayBegin_);
+    trace->setUniformValue("raySolidAngle", raySolidAngle());
+    trace->setUniformValue("raysSorted", sorted);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 21, sorted ? raySort_.valueBuffer() : 0);
+    bindBounceQueue(trace);
+    bindWorkCounters(trace);
+    bindTemporalSeeds(trace, true);
+    bindHotspots(trace, true);
+    bindShadowMap(trace);
+
+    // No hit buffer clear: the shader writes every slot in [0, tileRays), misses
+    // included, and nothing reads past tileRays. The hit counter is not reset
+    // here - it accumulates across all tiles of the frame.
+
+    // Dispatch
+    glDispatchCompute(traceGroups(tileRays), 1, 1);
+
+    // Memory barrier - the shadow map texels are sampled by the beam's fragment shader
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT |
+                    GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    // Unbind image to allow texture sampling
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32UI);
+
+    trace->release();
+}
+
+void RCSCompute::bindBounceQueue(QOpenGLShaderProgram* trace) {
+    // Program must be bound. Starts a primary pass with an empty queue.
+    trace->setUniformValue("bouncePass", 0);
+    trace->setUniformValue("maxBounces", maxBounces_);
+    if (maxBounces_ <= 1) return;
+
+    const GLintptr headerBytes = static_cast<GLintptr>(kMaxRCSBounces) * 4 * sizeof(GLuint);
+    if (!bounceQueueBuffer_) {
+        // BounceRay is 48 bytes in std430; every pass holds at most one ray per primary ray
+        GLsizeiptr bytes = headerBytes + 2 * static_cast<GLsizeiptr>(kRayTileSize) * 48;
+        glGenBuffers(1, &bounceQueueBuffer_);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, bounceQueueBuffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, GL_DYNAMIC_COPY);
+        memoryDirty_ = true;
+    }
+    trace->setUniformValue("bounceCapacity", static_cast<GLuint>(kRayTileSize));
+    trace->setUniformValue("bounceMaxDistance", sphereRadius_ * kMaxRayDistanceMultiplier);
+    trace->setUniformValue("bounceCutoff", bounceCutoff_);
+    trace->setUniformValue("rouletteThreshold", rouletteThreshold_);
+    trace->setUniformValue("rouletteSeed", static_cast<GLuint>(frameCounter_ * 2654435761ull));
+
+    // Every pass starts as an empty indirect dispatch (0, 1, 1) with no rays queued
+    const GLuint emptyPass[4] = {0u, 1u, 1u, 0u};
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, bounceQueueBuffer_);
+    glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_RGBA32UI, 0, headerBytes,
+                         GL_RGBA_INTEGER, GL_UNSIGNED_INT, emptyPass);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 15, bounceQueueBuffer_);
+}
+
+GLuint RCSCompute::traceGroups(int rays) const {
+    int groups = (rays + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    return static_cast<GLuint>(persistentThreads_ ? std::min(groups, persistentGroups_) : groups);
+}
+
+void RCSCompute::bindWorkCounters(QOpenGLShaderProgram* trace) {
+    // Program must be bound. Every counter starts the primary pass at zero.
+    if (!persistentThreads_) return;
+
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(kMaxLooksPerDispatch + kMaxRCSBounces) * sizeof(GLuint);
+    if (!workCounterBuffer_) {
+        glGenBuffers(1, &workCounterBuffer_);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, workCounterBuffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, GL_DYNAMIC_COPY);
+        memoryDirty_ = true;
+    }
+    const GLuint zero = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, workCounterBuffer_);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 22, workCounterBuffer_);
+    trace->setUniformValue("persistentGroups", static_cast<GLuint>(persistentGroups_));
+}
+
+void RCSCompute::bindTemporalSeeds(QOpenGLShaderProgram* trace, bool enabled) {
+    // Program must be bound. Seeds are indexed by primary ray ID, which a
+    // progressive accumulation runs up to progressiveTarget().
+    if (!temporalReuse_ || wideBvhActive_) return;
+
+    enabled = enabled && (seedCapacity_ >= progressiveTarget() || reserveTemporalSeeds(progressiveTarget()));
+    trace->setUniformValue("seedRays", enabled);
+    trace->setUniformValue("seedCapacity", static_cast<GLuint>(enabled ? seedCapacity_ : 0));
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 24, seedBuffer_);
+}
+
+bool RCSCompute::reserveTemporalSeeds(int rays) {
+    // Grown, never shrunk; new storage starts with no seeds
+    if (seedBuffer_) {
+        glDeleteBuffers(1, &seedBuffer_);
+        seedBuffer_ = 0;
+    }
+    seedCapacity_ = 0;
+    memoryDirty_ = true;
+    const GLuint none = 0xFFFFFFFFu;
+    glGenBuffers(1, &seedBuffer_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, seedBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<GLsizeiptr>(static_cast<GLsizeiptr>(rays) * 2 * sizeof(GLuint), 16),
+                 nullptr, GL_DYNAMIC_COPY);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &none);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    if (RS::GPUMemory::checkAllocation("RCSCompute temporal seeds")) {
+        glDeleteBuffers(1, &seedBuffer_);
+        seedBuffer_ = 0;
+        return false;
+    }
+    seedCapacity_ = rays;
+    return true;
+}
+
+void RCSCompute::setTemporalReuse(bool enabled) {
+    if (temporalReuse_ == enabled) {
+        return;
+    }
+    temporalReuse_ = enabled;
+    historyValid_ = false;  // Seeds left from before are validated leaf by leaf, the bins are not
+}
+
+void RCSCompute::clearHotspots() {
+    size_t triangles = 0;
+    for (const auto& entry : meshes_) {
+        if (entry.second.resident) {
+            triangles = std::max(triangles, static_cast<size_t>(entry.second.triangleOffset) +
+                                                meshTriangleCount(entry.second));
+        }
+    }
+    if (!hotspotBuffer_ || hotspotCapacity_ != triangles) {
+        if (!hotspotBuffer_) {
+            glGenBuffers(1, &hotspotBuffer_);
+        }
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, hotspotBuffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(triangles + 1) * sizeof(GLuint),
+                     nullptr, GL_DYNAMIC_COPY);
+        memoryDirty_ = true;
+        if (RS::GPUMemory::checkAllocation("RCSCompute triangle hotspots")) {
+            glDeleteBuffers(1, &hotspotBuffer_);
+            hotspotBuffer_ = 0;
+            hotspotCapacity_ = 0;
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            return;
+        }
+        hotspotCapacity_ = triangles;
+    }
+    const GLuint zero = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, hotspotBuffer_);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void RCSCompute::bindHotspots(QOpenGLShaderProgram* trace, bool enabled) {
+    // Program must be bound. The variant is only built while hotspots are active.
+    if (!isHotspotsActive()) return;
+
+    trace->setUniformValue("hotspotRays", enabled && hotspotBuffer_ != 0);
+    trace->setUniformValue("hotspotScale", kHotspotIntensityScale);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 26, hotspotBuffer_);
+}
+
+void RCSCompute::updateHistoryWeight(bool accumulate) {
+    // Blending is only safe while the radar alone moved, and by little. A
+    // progressive batch adds onto bins that already hold the history's rays.
+    TemporalState state;
+    state.radarPosition = radarPosition_;
+    state.sceneRevision = sceneRevision_;
+    state.numRays = numRays_;
+    state.beamWidthDegrees = beamWidthDegrees_;
+    state.maxBounces = maxBounces_;
+    state.polarBinning = polarBinning_;
+    state.heatMapBinning = heatMapBinning_;
+    state.sphereBinning = sphereBinning_;
+    state.polarSlice = polarSlice_;
+    state.heatMapSlice = heatMapSlice_;
+
+    historyWeight_ = 0.0f;
+    if (temporalReuse_ && historyValid_ && !accumulate &&
+        state.sceneRevision == historyState_.sceneRevision && state.numRays == historyState_.numRays &&
+        state.beamWidthDegrees == historyState_.beamWidthDegrees && state.maxBounces == historyState_.maxBounces &&
+        state.polarBinning == historyState_.polarBinning && state.heatMapBinning == historyState_.heatMapBinning &&
+        state.sphereBinning == historyState_.sphereBinning && sameSlice(state.polarSlice, historyState_.polarSlice) &&
+        sameSlice(state.heatMapSlice, historyState_.heatMapSlice)) {
+        float range = state.radarPosition.length();
+        float previousRange = historyState_.radarPosition.length();
+        if (range > 0.0f && std::abs(range - previousRange) <= kTemporalRangeTolerance * range) {
+            float cosAngle = QVector3D::dotProduct(state.radarPosition / range,
+                                                   historyState_.radarPosition / previousRange);
+            float angle = std::acos(std::clamp(cosAngle, -1.0f, 1.0f)) / kDegToRadF;
+            if (angle <= kTemporalMaxAngleDegrees) {
+                historyWeight_ = kTemporalHistoryWeight * (1.0f - angle / kTemporalMaxAngleDegrees);
+            }
+        }
+    }
+    historyState_ = state;
+    historyValid_ = temporalReuse_;
+}
+
+void RCSCompute::dispatchBounces(GLuint hitBuffer, GLuint compactBuffer, HitPayload payload) {
+    if (maxBounces_ <= 1) return;
+
+    // Same program as the primary pass, so the uniforms bindBounceQueue set hold
+    QOpenGLShaderProgram* trace = traceProgram(payload);
+    if (!trace) {
+        return;
+    }
+    auto bindPass = [&]() {
+        trace->bind();
+        bindScene(trace);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, hitBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, compactBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 15, bounceQueueBuffer_);
+    };
+    bindPass();
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, bounceQueueBuffer_);
+
+    // Each pass is sized on the GPU by the one before it - no readback between
+    // them. A sort covers the whole queue half, since only the GPU knows how
+    // much of it the last pass filled.
+    for (int bounce = 1; bounce < maxBounces_; ++bounce) {
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+        const bool sorted = sortRays(0, kRayTileSize, bounce);
+        if (sorted) {
+            bindPass();
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 21, raySort_.valueBuffer());
+        }
+        trace->setUniformValue("raysSorted", sorted);
+        trace->setUniformValue("bouncePass", bounce);
+        glDispatchComputeIndirect(static_cast<GLintptr>(bounce) * 4 * sizeof(GLuint));
+    }
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 21, 0);
+    trace->setUniformValue("raysSorted", false);
+    trace->setUniformValue("bouncePass", 0);
+    trace->release();
+}
+
+bool RCSCompute::sortRays(GLuint rayBuffer, int count, int bouncePass) {
+    if (!rayReordering_ || rayReorderFailed_ || count <= 1) {
+        return false;
+    }
+    if (bouncePass > 0 && sceneBounds_.min.x() > sceneBounds_.max.x()) {
+        return false;  // Nothing to reflect off, so nothing queued
+    }
+    if (!rayKeyShader_) {
+        rayKeyShader_ = std::make_unique<QOpenGLShaderProgram>();
+        if (!rayKeyShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Compute, rayKeyShaderSource) ||
+            !rayKeyShader_->link()) {
+            qWarning() << "Failed to build ray key shader:" << rayKeyShader_->log();
+            rayKeyShader_.reset();
+            rayReorderFailed_ = true;
+            return false;
+        }
+        if (!raySort_.initialize() || !raySort_.reserve(kRayTileSize)) {
+            qWarning() << "RCSCompute::sortRays - Sort unavailable, rays trace unsorted";
+            rayReorderFailed_ = true;
+            return false;
+        }
+    }
+
+    rayKeyShader_->bind();
+    rayKeyShader_->setUniformValue("numKeys", static_cast<GLuint>(count));
+    rayKeyShader_->setUniformValue("bouncePass", bouncePass);
+    rayKeyShader_->setUniformValue("bounceCapacity", static_cast<GLuint>(kRayTileSize));
+    rayKeyShader_->setUniformValue("sceneMin", sceneBounds_.min);
+    rayKeyShader_->setUniformValue("sceneExtent", sceneBounds_.max - sceneBounds_.min);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, raySort_.keyBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, raySort_.valueBuffer());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, rayBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 15, bounceQueueBuffer_);
+    glDispatchCompute(static_cast<GLuint>((count + 255) / 256), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    rayKeyShader_->release();
+
+    raySort_.sort(count, bouncePass > 0 ? kBounceRayKeyBits : kPrimaryRayKeyBits);
+    return true;
+}
+
+void RCSCompute::readResults() {
+    // Update hit counter from finished slots; only synchronous mode waits
+    if (asyncReadback_) {
+        pollReadbackSlots();
+    } else {
+        int lastSlot = (writeSlot_ + kReadbackSlotCount - 1) % kReadbackSlotCount;
+        waitForSlot(lastSlot);
+    }
+}
+
+void RCSCompute::readHitBuffer() {
+    if (numRays_ <= 0) {
+        hitResults_.clear();
+        return;
+    }
+
+    // Blocking path: wait for the most recent dispatch, then copy it
+    RS::FrameProfiler::Scope profile(profiler_, "readHitBuffer");
+    int lastSlot = (writeSlot_ + kReadbackSlotCount - 1) % kReadbackSlotCount;
+    waitForSlot(lastSlot);
+    getLatestCompletedResults();
+}
+
+const std::vector<HitResult>& RCSCompute::getLatestCompletedResults() {
+    if (!initialized_) return hitResults_;
+
+    pollReadbackSlots();
+    if (latestSlot_ < 0) return hitResults_;
+
+    // Copy out of the persistent mapping once per completed frame. The slot is
+    // not rewritten until the next compute(), so this never races the GPU.
+    const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+    if (slot.frameIndex == copiedFrame_ || !slot.mappedHits) return hitResults_;
+    copiedFrame_ = slot.frameIndex;
+    QElapsedTimer copyTimer;
+    copyTimer.start();
+
+    switch (slot.payload) {
+    case HitPayload::Full:
+        hitResults_.resize(slot.numRays);
+        std::memcpy(hitResults_.data(), slot.mappedHits, slot.numRays * sizeof(HitResult));
+        break;
+    case HitPayload::Compact: {
+        const auto* compact = static_cast<const CompactHit*>(slot.mappedHits);
+        hitResults_.resize(slot.numRays);
+        for (int i = 0; i < slot.numRays; ++i) {
+            float distance;
+            std::memcpy(&distance, &compact[i].distanceOrRayId, sizeof(distance));
+            hitResults_[i] = decodeCompactHit(compact[i], static_cast<uint32_t>(i), distance);
+        }
+        break;
+    }
+    case HitPayload::CompactHitsOnly: {
+        // The hit counter is the append index; entries past capacity were dropped
+        const auto* compact = static_cast<const CompactHit*>(slot.mappedHits);
+        int total = slot.mappedCounter ? static_cast<int>(*slot.mappedCounter) : 0;
+        int count = std::min(total, slot.capacity);
+        if (total > count && droppedHits_ == 0) {
+            qWarning() << "RCSCompute: hits-only readback holds" << slot.capacity << "of" << total
+                       << "hits - the rest were dropped";
+        }
+        droppedHits_ = total - count;
+        hitResults_.resize(count);
+        for (int i = 0; i < count; ++i) {
+            QVector3D position(compact[i].position[0], compact[i].position[1], compact[i].position[2]);
+            float distance = (position - slot.radarPosition).length();
+            hitResults_[i] = decodeCompactHit(compact[i], compact[i].distanceOrRayId, distance);
+        }
+        break;
+    }
+    case HitPayload::Columns: {
+        HitColumns columns = getLatestHitColumns();
+        hitResults_.resize(columns.count);
+        for (size_t i = 0; i < columns.count; ++i) {
+            hitResults_[i] = columns.hit(i);
+        }
+        break;
+    }
+    case HitPayload::None:
+        hitResults_.clear();
+        break;
+    }
+    readbackNs_ += copyTimer.nsecsElapsed();
+    return hitResults_;
+}
+
+HitColumns RCSCompute::getLatestHitColumns() {
+    HitColumns view;
+    if (!initialized_) return view;
+
+    pollReadbackSlots();
+    if (latestSlot_ >= 0) {
+        // Columns sit slot.capacity floats apart in the slot; the copy packs them
+        // numRays apart, one memcpy per column
+        const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+        if (slot.frameIndex != copiedColumnsFrame_ && slot.mappedHits) {
+            copiedColumnsFrame_ = slot.frameIndex;
+            columnCount_ = slot.payload == HitPayload::Columns ? static_cast<size_t>(slot.numRays) : 0;
+            hitColumns_.resize(columnCount_ * kHitColumnCount);
+            const auto* mapped = static_cast<const float*>(slot.mappedHits);
+            for (int c = 0; c < kHitColumnCount && columnCount_ > 0; ++c) {
+                std::memcpy(hitColumns_.data() + c * columnCount_,
+                            mapped + static_cast<size_t>(c) * slot.capacity, columnCount_ * sizeof(float));
+            }
+        }
+    }
+
+    if (columnCount_ == 0) return view;
+    const float* base = hitColumns_.data();
+    view.count = columnCount_;
+    view.distance = base;
+    view.reflectionX = base + columnCount_;
+    view.reflectionY = base + 2 * columnCount_;
+    view.reflectionZ = base + 3 * columnCount_;
+    view.intensity = base + 4 * columnCount_;
+    view.positionX = base + 5 * columnCount_;
+    view.positionY = base + 6 * columnCount_;
+    view.positionZ = base + 7 * columnCount_;
+    return view;
+}
+
+void RCSCompute::setHitPayload(HitPayload payload) {
+    if (hitPayload_ == payload) return;
+    hitPayload_ = payload;
+    restartProgressive();
+
+    droppedHits_ = 0;
+
+    // Immutable readback storage is sized per entry and per payload capacity -
+    // recreate it if either changed
+    if (initialized_ && payload != HitPayload::None &&
+        (payloadStride(payload) != slotHitStride_ || getSlotHitCapacity() != readbackSlots_[0].capacity)) {
+        destroyReadbackSlots();
+        createReadbackSlots();
+    }
+}
+
+const std::vector<FrequencyBin>& RCSCompute::getLatestFrequencyBins() {
+    if (!initialized_) return frequencyBins_;
+
+    pollReadbackSlots();
+    if (latestSlot_ < 0) return frequencyBins_;
+
+    const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+    if (slot.frequencyPoints > 0 && slot.frameIndex != copiedFrequencyFrame_ && slot.mappedFrequencyBins) {
+        frequencyBins_.assign(slot.mappedFrequencyBins,
+                              slot.mappedFrequencyBins + kPolarPlotBins * slot.frequencyPoints);
+        copiedFrequencyFrame_ = slot.frameIndex;
+    }
+    return frequencyBins_;
+}
+
+const std::vector<PolarBin>& RCSCompute::getLatestSphereBins() {
+    if (!initialized_) return sphereBins_;
+
+    pollReadbackSlots();
+    if (latestSlot_ < 0) return sphereBins_;
+
+    const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+    if (slot.sphereBinned && slot.frameIndex != copiedSphereFrame_ && slot.mappedSphereBins) {
+        blendBins(sphereBins_, slot.mappedSphereBins,
+                  static_cast<size_t>(kSphereTableAzBins) * kSphereTableElBins, slot.historyWeight);
+        copiedSphereFrame_ = slot.frameIndex;
+    }
+    return sphereBins_;
+}
+
+const std::vector<PolarBin>& RCSCompute::getLatestReceiverBins() {
+    if (!initialized_) return receiverBins_;
+
+    pollReadbackSlots();
+    if (latestSlot_ < 0) return receiverBins_;
+
+    const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+    if (slot.receiversBinned && slot.frameIndex != copiedReceiverFrame_ && slot.mappedReceiverBins) {
+        receiverBins_.assign(slot.mappedReceiverBins, slot.mappedReceiverBins + receivers_.size());
+        copiedReceiverFrame_ = slot.frameIndex;
+    }
+    return receiverBins_;
+}
+
+const std::vector<PolarBin>& RCSCompute::getLatestPolarBins() {
+    if (!initialized_) return polarBins_;
+
+    pollReadbackSlots();
+    if (latestSlot_ < 0) return polarBins_;
+
+    const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+    if (slot.polarBinned && slot.frameIndex != copiedPolarFrame_ && slot.mappedPolarBins) {
+        blendBins(polarBins_, slot.mappedPolarBins, kPolarPlotBins, slot.historyWeight);
+        copiedPolarFrame_ = slot.frameIndex;
+    }
+    return polarBins_;
+}
+
+void RCSCompute::setLobeClustering(bool enabled) {
+    if (lobeClustering_ != enabled) {
+        restartProgressive();
+    }
+    lobeClustering_ = enabled;
+    if (enabled && initialized_ && !lobeClusterTable_) {
+        glGenBuffers(1, &lobeClusterTable_);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, lobeClusterTable_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, kLobeClusterTableSize * 24 * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        memoryDirty_ = true;
+    }
+}
+
+const std::vector<ReflectionCluster>& RCSCompute::getLatestLobeClusters() {
+    if (!initialized_) return lobeClusters_;
+
+    pollReadbackSlots();
+    if (latestSlot_ < 0) return lobeClusters_;
+
+    const ReadbackSlot& slot = readbackSlots_[latestSlot_];
+    if (slot.lobeClustered && slot.frameIndex != copiedClusterFrame_ && slot.mappedClusters) {
+        // Layout: uint count, 3 uints padding, then ReflectionCluster[kLobeClusterMaxOutput]
+        const auto* header = static_cast<const GLuint*>(slot.mappedClusters);
+        const auto* clusters = reinterpret_cast<const ReflectionCluster*>(header + 4);
+        int count = std::min(static_cast<int>(header[0]), kLobeClusterMaxOutput);
+        lobeClusters_.assign(clusters, clusters + count);
+        copiedClusterFrame_ = slot.frameIndex;
+    }
+    return lobeClusters_;
+}
+
+void RCSCompute::dispatchLobeClustering(int tileRays) {
+    if (!lobeClusterShader_ || !lobeClusterTable_) return;
+
+    lobeClusterShader_->bind();
+
+    lobeClusterShader_->setUniformValue("numRays", tileRays);
+    lobeClusterShader_->setUniformValue("cellSize", kLobeClusterDist);
+    lobeClusterShader_->setUniformValue("dirBucketsPerFace",
+                                        std::max(1, static_cast<int>(std::ceil(90.0f / kLobeClusterAngle))));
+    lobeClusterShader_->setUniformValue("minIntensity", kLobeMinIntensity);
+    lobeClusterShader_->setUniformValue("fixedScale", kBinIntensityScale);
+    lobeClusterShader_->setUniformValue("tableMask", static_cast<GLuint>(kLobeClusterTableSize - 1));
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, tileHitBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, lobeClusterTable_);
+
+    int numGroups = (tileRays + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    glDispatchCompute(numGroups, 1, 1);
+
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    lobeClusterShader_->release();
+}
+
+void RCSCompute::dispatchLobeClusterCollect() {
+    if (!lobeClusterCollectShader_ || !lobeClusterTable_) return;
+
+    lobeClusterCollectShader_->bind();
+
+    lobeClusterCollectShader_->setUniformValue("tableSize", kLobeClusterTableSize);
+    lobeClusterCollectShader_->setUniformValue("maxClusters", kLobeClusterMaxOutput);
+    lobeClusterCollectShader_->setUniformValue("cellSize", kLobeClusterDist);
+    lobeClusterCollectShader_->setUniformValue("fixedScale", kBinIntensityScale);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, lobeClusterTable_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, readbackSlots_[writeSlot_].clusterBuffer);
+
+    int numGroups = (kLobeClusterTableSize + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    glDispatchCompute(numGroups, 1, 1);
+
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    lobeClusterCollectShader_->release();
+}
+
+void RCSCompute::setPolarBinning(bool enabled, const BinningSlice& slice) {
+    if (polarBinning_ != enabled || !sameSlice(polarSlice_, slice)) {
+        restartProgressive();
+    }
+    polarBinning_ = enabled;
+    polarSlice_ = slice;
+}
+
+void RCSCompute::setSphereBinning(bool enabled) {
+    if (sphereBinning_ != enabled) {
+        restartProgressive();
+    }
+    sphereBinning_ = enabled;
+    if (enabled && initialized_) {
+        createSphereBuffers();
+    }
+}
+
+void RCSCompute::createSphereBuffers() {
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(kSphereTableAzBins) * kSphereTableElBins * sizeof(PolarBin);
+    for (auto& slot : readbackSlots_) {
+        if (slot.sphereBinBuffer) continue;
+        glGenBuffers(1, &slot.sphereBinBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.sphereBinBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, flags);
+        slot.mappedSphereBins = static_cast<const PolarBin*>(
+            glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, bytes, flags));
+        if (!slot.mappedSphereBins) {
+            qWarning() << "RCSCompute: Failed to persistently map sphere bins";
+        }
+        slot.sphereBinned = false;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
+}
+
+void RCSCompute::setReceivers(const std::vector<QVector3D>& positions) {
+    // Far field: a receiver is the direction from the origin to its site
+    std::vector<QVector3D> directions;
+    for (size_t i = 0; i < positions.size() && i < static_cast<size_t>(kMaxReceivers); ++i) {
+        directions.push_back(positions[i].normalized());
+    }
+    if (positions.size() > static_cast<size_t>(kMaxReceivers)) {
+        qWarning() << "RCSCompute:" << positions.size() << "receivers requested, binning the first" << kMaxReceivers;
+    }
+    if (directions == receivers_) {
+        return;
+    }
+    receivers_ = std::move(directions);
+    receiverBins_.clear();
+    copiedReceiverFrame_ = 0;
+    restartProgressive();
+    if (!receivers_.empty() && initialized_) {
+        createReceiverBuffers();
+    }
+}
+
+void RCSCompute::createReceiverBuffers() {
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(kMaxReceivers) * sizeof(PolarBin);
+    for (auto& slot : readbackSlots_) {
+        if (slot.receiverBinBuffer) continue;
+        glGenBuffers(1, &slot.receiverBinBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.receiverBinBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, flags);
+        slot.mappedReceiverBins = static_cast<const PolarBin*>(
+            glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, bytes, flags));
+        if (!slot.mappedReceiverBins) {
+            qWarning() << "RCSCompute: Failed to persistently map receiver bins";
+        }
+        slot.receiversBinned = false;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
+}
+
+void RCSCompute::setFrequencySweep(bool enabled, const FrequencySweep& sweep) {
+    FrequencySweep clamped = sweep;
+    clamped.points = std::clamp(sweep.points, 1, kMaxFrequencyPoints);
+    if (frequencySweep_ != enabled || sweep_ != clamped) {
+        restartProgressive();
+    }
+    frequencySweep_ = enabled;
+    sweep_ = clamped;
+    if (enabled && initialized_) {
+        createFrequencyBuffers();
+    }
+}
+
+void RCSCompute::createFrequencyBuffers() {
+    // Sized for kMaxFrequencyPoints so changing the sweep never reallocates
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(kPolarPlotBins) * kMaxFrequencyPoints * sizeof(FrequencyBin);
+    for (auto& slot : readbackSlots_) {
+        if (slot.frequencyBinBuffer) continue;
+        glGenBuffers(1, &slot.frequencyBinBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.frequencyBinBuffer);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, flags);
+        slot.mappedFrequencyBins = static_cast<const FrequencyBin*>(
+            glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, bytes, flags));
+        if (!slot.mappedFrequencyBins) {
+            qWarning() << "RCSCompute: Failed to persistently map frequency bins";
+        }
+        slot.frequencyPoints = 0;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
 }
 
-void RCSCompute::setSphereRadius(float radius) {
-    sphereRadius_ = radius;
+void RCSCompute::setHeatMapBinning(bool enabled, const BinningSlice& slice) {
+    if (heatMapBinning_ != enabled || !sameSlice(heatMapSlice_, slice)) {
+        restartProgressive();
+    }
+    heatMapBinning_ = enabled;
+    heatMapSlice_ = slice;
+    if (enabled && initialized_ && !heatMapBinBuffer_) {
+        createHeatMapBuffers();
+    }
 }
 
-void RCSCompute::setNumRays(int numRays) {
-    if (numRays_ != numRays) {
-        numRays_ = numRays;
+void RCSCompute::createHeatMapBuffers() {
+    // Allocated on first use - the lat/lon grid is 12 MB at 1024 x 1024
+    GLsizeiptr binBytes = static_cast<GLsizeiptr>(kHeatMapLatBins) * kHeatMapLonBins * 3 * sizeof(GLuint);
+    glGenBuffers(1, &heatMapBinBuffer_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, heatMapBinBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, binBytes, nullptr, GL_DYNAMIC_COPY);
+
+    GLsizeiptr vertexCount = (kHeatMapLatSegments + 1) * (kHeatMapLonSegments + 1);
+    std::vector<float> zeros(vertexCount, 0.0f);
+    glGenBuffers(1, &heatMapIntensityBuffer_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, heatMapIntensityBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, vertexCount * sizeof(float), zeros.data(), GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
+}
 
-        // Resize buffers
-        if (rayBuffer_) {
-            glBindBuffer(GL_SHADER_STORAGE_BUFFER, rayBuffer_);
-            glBufferData(GL_SHADER_STORAGE_BUFFER, numRays_ * sizeof(Ray), nullptr, GL_DYNAMIC_DRAW);
-        }
-        if (hitBuffer_) {
-            glBindBuffer(GL_SHADER_STORAGE_BUFFER, hitBuffer_);
-            glBufferData(GL_SHADER_STORAGE_BUFFER, numRays_ * sizeof(HitResult), nullptr, GL_DYNAMIC_DRAW);
-        }
-        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+void RCSCompute::readHeatMapIntensities(std::vector<float>& intensities) {
+    if (!initialized_ || !heatMapBinning_ || !heatMapIntensityBuffer_) {
+        intensities.clear();
+        return;
     }
+    intensities.resize((kHeatMapLatSegments + 1) * (kHeatMapLonSegments + 1));
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, heatMapIntensityBuffer_);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, intensities.size() * sizeof(float), intensities.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
-void RCSCompute::uploadBVH() {
-    if (!bvhDirty_) return;
+void RCSCompute::createLookBuffers() {
+    // Looks split one kRayTileSize tile between them, so the ray/hit buffers
+    // never grow with the look count
+    auto allocate = [this](GLuint& buffer, GLsizeiptr bytes) {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, bytes, nullptr, GL_DYNAMIC_COPY);
+    };
+    allocate(lookBuffer_, kMaxLooksPerDispatch * sizeof(GPULook));
+    allocate(lookRayBuffer_, kRayTileSize * sizeof(Ray));
+    allocate(lookHitBuffer_, kRayTileSize * sizeof(HitResult));
+    allocate(lookCounterBuffer_, kMaxLooksPerDispatch * sizeof(GLuint));
+    allocate(lookPolarBinBuffer_, static_cast<GLsizeiptr>(kMaxLooksPerDispatch) * kPolarPlotBins * sizeof(PolarBin));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    memoryDirty_ = true;
+}
 
-    const auto& nodes = bvhBuilder_.getNodes();
-    const auto& triangles = bvhBuilder_.getTriangles();
+bool RCSCompute::computeLooks(const std::vector<RadarLook>& looks, std::vector<LookResult>& results) {
+    results.clear();
+    if (!initialized_ || looks.empty()) {
+        return looks.empty();
+    }
+    if (static_cast<int>(looks.size()) > kMaxLooksPerDispatch) {
+        qWarning() << "RCSCompute::computeLooks -" << looks.size()
+                   << "looks exceeds kMaxLooksPerDispatch (" << kMaxLooksPerDispatch << ")";
+        return false;
+    }
+    if (!receivers_.empty()) {
+        // The binning pass only fills receiver bins for the interactive look
+        qWarning() << "RCSCompute::computeLooks - batched looks are monostatic; clear the"
+                   << receivers_.size() << "bistatic receivers first";
+        return false;
+    }
+    RS::FrameProfiler::Scope profile(profiler_, "computeLooks");
 
-    if (!nodes.empty()) {
-        glBindBuffer(GL_SHADER_STORAGE_BUFFER, bvhBuffer_);
-        glBufferData(GL_SHADER_STORAGE_BUFFER, nodes.size() * sizeof(BVHNode), nodes.data(), GL_DYNAMIC_DRAW);
+    uploadBVH();
+    uploadTLAS();
+    if (!traceProgram(HitPayload::None)) {
+        return false;  // The variant for the uploaded layout did not build
+    }
+    if (!lookBuffer_) {
+        createLookBuffers();
     }
 
-    if (!triangles.empty()) {
-        glBindBuffer(GL_SHADER_STORAGE_BUFFER, triangleBuffer_);
-        glBufferData(GL_SHADER_STORAGE_BUFFER, triangles.size() * sizeof(Triangle), triangles.data(), GL_DYNAMIC_DRAW);
+    const int numLooks = static_cast<int>(looks.size());
+    std::vector<GPULook> gpuLooks(numLooks);
+    for (int i = 0; i < numLooks; ++i) {
+        const RadarLook& look = looks[i];
+        QVector3D dir = look.beamDirection.normalized();
+        gpuLooks[i] = GPULook{
+            {look.radarPosition.x(), look.radarPosition.y(), look.radarPosition.z(), 0.0f},
+            {dir.x(), dir.y(), dir.z(), 0.0f},
+            {static_cast<float>(look.slice.cutType), look.slice.offsetDegrees, look.slice.thicknessDegrees,
+             look.slice.minIntensity}
+        };
     }
 
+    GLuint zero = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lookBuffer_);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, numLooks * sizeof(GPULook), gpuLooks.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lookCounterBuffer_);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lookPolarBinBuffer_);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-    // Memory barrier to ensure buffer updates are visible to compute shaders
-    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+    // Each dispatch covers lookTile rays of every look; counters and bins
+    // accumulate across the tiles like the single-look path
+    const int lookTile = std::max(1, std::min(numRays_, kRayTileSize / numLooks));
+    for (int rayOffset = 0; rayOffset < numRays_; rayOffset += lookTile) {
+        dispatchLooks(rayOffset, std::min(lookTile, numRays_ - rayOffset), numLooks);
+    }
+    if (edgeDiffraction_) {
+        dispatchEdgeDiffraction(numLooks);
+    }
 
-    bvhDirty_ = false;
+    // glGetBufferSubData waits for the dispatches - this path is meant for
+    // batch work (sweeps), not the interactive frame
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    std::vector<GLuint> counters(numLooks);
+    std::vector<PolarBin> bins(static_cast<size_t>(numLooks) * kPolarPlotBins);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lookCounterBuffer_);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, numLooks * sizeof(GLuint), counters.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, lookPolarBinBuffer_);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bins.size() * sizeof(PolarBin), bins.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    results.resize(numLooks);
+    for (int i = 0; i < numLooks; ++i) {
+        results[i].hitCount = static_cast<int>(counters[i]);
+        results[i].polarBins.assign(bins.begin() + static_cast<size_t>(i) * kPolarPlotBins,
+                                    bins.begin() + static_cast<size_t>(i + 1) * kPolarPlotBins);
+    }
+    return !GLUtils::checkGLError("RCSCompute::computeLooks");
 }
 
-void RCSCompute::dispatchRayGeneration() {
-    rayGenShader_->bind();
+void RCSCompute::dispatchLooks(int rayOffset, int tileRays, int numLooks) {
+    int numGroups = (tileRays + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
 
-    // Set uniforms
-    rayGenShader_->setUniformValue("radarPosition", radarPosition_);
-    rayGenShader_->setUniformValue("beamDirection", beamDirection_);
+    // Ray generation - origin and beam axis come from the look buffer
+    rayGenShader_->bind();
     rayGenShader_->setUniformValue("beamWidthRad", beamWidthDegrees_ * kDegToRadF);
     rayGenShader_->setUniformValue("maxDistance", sphereRadius_ * kMaxRayDistanceMultiplier);
-    rayGenShader_->setUniformValue("numRays", numRays_);
+    rayGenShader_->setUniformValue("numRays", tileRays);
+    rayGenShader_->setUniformValue("rayOffset", rayOffset);
+    rayGenShader_->setUniformValue("raysPerRing", kRaysPerRing);
+    rayGenShader_->setUniformValue("numRings", getNumRings());
+    rayGenShader_->setUniformValue("numLooks", numLooks);
+    rayGenShader_->setUniformValue("rayStride", 1u);
+    rayGenShader_->setUniformValue("totalRays", numRays_);
+    rayGenShader_->setUniformValue("sampling", static_cast<int>(raySampling_));
+    rayGenShader_->setUniformValue("sampleRotation", 0.0f, 0.0f);  // Sweeps stay deterministic
+    rayGenShader_->setUniformValue("focusHalfAngle", 0.0f);         // Each look covers its whole beam
+    bindBeamPattern();
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, lookRayBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, lookBuffer_);
+    glDispatchCompute(numGroups, numLooks, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    unbindBeamPattern();
+    rayGenShader_->release();
 
-    // Calculate ring parameters
-    int raysPerRing = kRaysPerRing;
-    int numRings = (numRays_ + raysPerRing - 1) / raysPerRing;
-    rayGenShader_->setUniformValue("raysPerRing", raysPerRing);
-    rayGenShader_->setUniformValue("numRings", numRings);
+    // Tracing - one BVH traversal pass for every look
+    QOpenGLShaderProgram* trace = traceProgram(HitPayload::None);
+    if (!trace) {
+        return;
+    }
+    trace->bind();
+    trace->setUniformValue("numRays", tileRays);
+    trace->setUniformValue("rayOffset", rayOffset);
+    trace->setUniformValue("compactCapacity", 0u);
+    trace->setUniformValue("payloadOffset", 0);
+    trace->setUniformValue("raySolidAngle", 0.0f);
+    trace->setUniformValue("shadowMapEnabled", false);  // The map follows the interactive look only
+    trace->setUniformValue("raysSorted", false);        // Looks trace in generation order
+    bindBounceQueue(trace);
+    bindWorkCounters(trace);
+    // Every look of the batch reads and writes the same seed per ray ID, so a
+    // ray starts from the leaf it hit in a neighbouring look. Any seed leaves
+    // the closest hit exact; the race only decides which one is tested first.
+    bindTemporalSeeds(trace, true);
+    bindHotspots(trace, false);
+    bindScene(trace);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, lookRayBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, lookHitBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, lookCounterBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, lookHitBuffer_);  // Unused with HitPayload::None
+    glDispatchCompute(traceGroups(tileRays), numLooks, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    trace->release();
+    dispatchBounces(lookHitBuffer_, lookHitBuffer_, HitPayload::None);
+
+    // Binning - each look into its own block of polar bins
+    binningShader_->bind();
+    binningShader_->setUniformValue("numRays", tileRays);
+    binningShader_->setUniformValue("intensityScale", kBinIntensityScale);
+    binningShader_->setUniformValue("numLooks", numLooks);  // Each look's slice, minIntensity included
+    binningShader_->setUniformValue("polarEnabled", true);
+    binningShader_->setUniformValue("heatMapEnabled", false);
+    binningShader_->setUniformValue("sphereEnabled", false);
+    binningShader_->setUniformValue("numReceivers", 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, lookHitBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, lookPolarBinBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, lookBuffer_);
+    glDispatchCompute(numGroups, numLooks, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    binningShader_->release();
+}
 
-    // Bind ray buffer
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, rayBuffer_);
+void RCSCompute::dispatchBinning(int tileRays) {
+    if (!binningShader_) return;
 
-    // Dispatch
-    int numGroups = (numRays_ + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    binningShader_->bind();
+
+    binningShader_->setUniformValue("numRays", tileRays);
+    setBinningUniforms(binningShader_.get());
+
+    const ReadbackSlot& slot = readbackSlots_[writeSlot_];
+    const int numReceivers = slot.receiversBinned ? static_cast<int>(receivers_.size()) : 0;
+    binningShader_->setUniformValue("numReceivers", numReceivers);
+    if (numReceivers > 0) {
+        QVector4D packs[3][kMaxReceivers / 4];
+        for (int r = 0; r < kMaxReceivers; ++r) {
+            QVector3D dir = r < numReceivers ? receivers_[r] : QVector3D();
+            packs[0][r / 4][r % 4] = dir.x();
+            packs[1][r / 4][r % 4] = dir.y();
+            packs[2][r / 4][r % 4] = dir.z();
+        }
+        binningShader_->setUniformValueArray("receiverX", packs[0], kMaxReceivers / 4);
+        binningShader_->setUniformValueArray("receiverY", packs[1], kMaxReceivers / 4);
+        binningShader_->setUniformValueArray("receiverZ", packs[2], kMaxReceivers / 4);
+        binningShader_->setUniformValue("receiverCosAcceptance", std::cos(kReceiverAcceptanceDegrees * kDegToRadF));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 18, slot.receiverBinBuffer);
+    }
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, tileHitBuffer_);
+
+    int numGroups = (tileRays + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
     glDispatchCompute(numGroups, 1, 1);
 
-    // Memory barrier
     glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-    rayGenShader_->release();
+    binningShader_->release();
 }
 
-void RCSCompute::dispatchTracing() {
-    traceShader_->bind();
-
-    // Set uniforms
-    traceShader_->setUniformValue("numRays", numRays_);
-    traceShader_->setUniformValue("numNodes", bvhBuilder_.getNodeCount());
+void RCSCompute::setBinningUniforms(QOpenGLShaderProgram* program) {
+    program->setUniformValue("intensityScale", kBinIntensityScale);
+
+    program->setUniformValue("polarEnabled", polarBinning_);
+    program->setUniformValue("numLooks", 0);
+    program->setUniformValue("uPolarCutType", polarSlice_.cutType);
+    program->setUniformValue("uPolarOffset", polarSlice_.offsetDegrees);
+    program->setUniformValue("uPolarThickness", polarSlice_.thicknessDegrees);
+    program->setUniformValue("uPolarMinIntensity", polarSlice_.minIntensity);
+
+    program->setUniformValue("sphereEnabled", sphereBinning_);
+    program->setUniformValue("sphereAzBins", kSphereTableAzBins);
+    program->setUniformValue("sphereElBins", kSphereTableElBins);
+
+    program->setUniformValue("heatMapEnabled", heatMapBinning_);
+    program->setUniformValue("heatCutType", heatMapSlice_.cutType);
+    program->setUniformValue("heatOffset", heatMapSlice_.offsetDegrees);
+    program->setUniformValue("heatThickness", heatMapSlice_.thicknessDegrees);
+    program->setUniformValue("heatMinIntensity", heatMapSlice_.minIntensity);
+    program->setUniformValue("heatLatBins", kHeatMapLatBins);
+    program->setUniformValue("heatLonBins", kHeatMapLonBins);
+
+    const ReadbackSlot& slot = readbackSlots_[writeSlot_];
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, slot.polarBinBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, heatMapBinBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 17, slot.sphereBinBuffer);
+}
 
-    // Bind buffers
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, rayBuffer_);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, bvhBuffer_);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, triangleBuffer_);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, hitBuffer_);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, counterBuffer_);
+void RCSCompute::uploadEdges() {
+    edgesDirty_ = false;
+    ++sceneRevision_;
 
-    // Reset counter
-    GLuint zero = 0;
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, counterBuffer_);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &zero);
+    // Meshes are packed in map order; each instance's dispatch reads its range
+    std::vector<DiffractionEdge> packed;
+    for (auto& entry : meshes_) {
+        MeshState& mesh = entry.second;
+        mesh.edgeOffset = static_cast<int>(packed.size());
+        packed.insert(packed.end(), mesh.edges.begin(), mesh.edges.end());
+    }
+    edgeCount_ = static_cast<int>(packed.size());
+    if (packed.empty()) {
+        if (edgeBuffer_) {
+            glDeleteBuffers(1, &edgeBuffer_);
+            edgeBuffer_ = 0;
+        }
+        memoryDirty_ = true;
+        return;
+    }
+    if (!edgeBuffer_) {
+        glGenBuffers(1, &edgeBuffer_);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, edgeBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(packed.size() * sizeof(DiffractionEdge)),
+                 packed.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    if (RS::GPUMemory::checkAllocation("RCSCompute diffraction edges")) {
+        glDeleteBuffers(1, &edgeBuffer_);
+        edgeBuffer_ = 0;
+        edgeCount_ = 0;
+    }
+    memoryDirty_ = true;
+}
 
-    // Clear hit buffer to ensure no stale data (set all hitPoint.w to -1)
-    // Use pre-allocated buffer to avoid per-frame allocation
-    if (static_cast<int>(hitClearBuffer_.size()) != numRays_) {
-        hitClearBuffer_.resize(numRays_);
-        for (auto& hit : hitClearBuffer_) {
-            hit.hitPoint = QVector4D(0, 0, 0, -1.0f);  // w=-1 means no hit
-            hit.reflection = QVector4D(0, 0, 0, 0);
+void RCSCompute::dispatchEdgeDiffraction(int numLooks) {
+    if (!edgeBinningShader_) return;
+    if (edgesDirty_) {
+        uploadEdges();
+    }
+    if (edgeCount_ == 0) return;
+
+    QOpenGLShaderProgram* program = edgeBinningShader_.get();
+    program->bind();
+    if (numLooks > 0) {
+        // Polar bins only, each look into its own block, like dispatchLooks()
+        program->setUniformValue("intensityScale", kBinIntensityScale);
+        program->setUniformValue("numLooks", numLooks);
+        program->setUniformValue("polarEnabled", true);
+        program->setUniformValue("heatMapEnabled", false);
+        program->setUniformValue("sphereEnabled", false);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, lookPolarBinBuffer_);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 11, lookBuffer_);
+    } else {
+        setBinningUniforms(program);
+        program->setUniformValue("edgeRadarPosition", radarPosition_);
+        program->setUniformValue("edgeBeamDirection", beamDirection_);
+    }
+    program->setUniformValue("numReceivers", 0);  // Receivers need the bistatic cone; not modelled
+    program->setUniformValue("edgeBeamCosHalfAngle", std::cos(0.5f * beamWidthDegrees_ * kDegToRadF));
+    program->setUniformValue("edgeWaveNumber", edgeWaveNumber_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 25, edgeBuffer_);
+
+    for (const InstanceState& instance : instanceStates_) {
+        auto it = meshes_.find(instance.meshId);
+        if (it == meshes_.end() || it->second.edges.empty()) {
+            continue;
         }
+        const int count = static_cast<int>(it->second.edges.size());
+        program->setUniformValue("numRays", count);
+        program->setUniformValue("edgeOffset", it->second.edgeOffset);
+        program->setUniformValue("edgeModel", instance.modelMatrix);
+        program->setUniformValue("edgeNormalMatrix", instance.modelMatrix.normalMatrix());
+        glDispatchCompute((count + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize, std::max(numLooks, 1), 1);
     }
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, hitBuffer_);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, numRays_ * sizeof(HitResult), hitClearBuffer_.data());
     glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    program->release();
+}
 
-    // Dispatch
-    int numGroups = (numRays_ + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
-    glDispatchCompute(numGroups, 1, 1);
+void RCSCompute::dispatchFrequencyBinning(int tileRays) {
+    if (!frequencyBinningShader_) return;
+
+    frequencyBinningShader_->bind();
+
+    // k = 2 pi f / c in radians per scene unit; the common radar range is
+    // removed from every path so the float phase keeps its precision
+    const double unitsToWaveNumber = kTwoPi * sweep_.metersPerUnit / kSpeedOfLight;
+    const double stepHz = sweep_.points > 1 ? (sweep_.stopHz - sweep_.startHz) / (sweep_.points - 1) : 0.0;
+    frequencyBinningShader_->setUniformValue("numRays", tileRays);
+    frequencyBinningShader_->setUniformValue("numFrequencies", sweep_.points);
+    frequencyBinningShader_->setUniformValue("waveNumberStart", static_cast<float>(sweep_.startHz * unitsToWaveNumber));
+    frequencyBinningShader_->setUniformValue("waveNumberStep", static_cast<float>(stepHz * unitsToWaveNumber));
+    frequencyBinningShader_->setUniformValue("referencePath", radarPosition_.length());
+    frequencyBinningShader_->setUniformValue("fieldScale", kFieldBinScale);
+    frequencyBinningShader_->setUniformValue("uPolarCutType", polarSlice_.cutType);
+    frequencyBinningShader_->setUniformValue("uPolarOffset", polarSlice_.offsetDegrees);
+    frequencyBinningShader_->setUniformValue("uPolarThickness", polarSlice_.thicknessDegrees);
+    frequencyBinningShader_->setUniformValue("uPolarMinIntensity", polarSlice_.minIntensity);
+
+    const ReadbackSlot& slot = readbackSlots_[writeSlot_];
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, tileHitBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 16, slot.frequencyBinBuffer);
+
+    int numGroups = (tileRays + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    int numBlocks = (sweep_.points + kFrequencyBlock - 1) / kFrequencyBlock;
+    glDispatchCompute(numGroups, numBlocks, 1);
 
-    // Memory barrier
     glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-    traceShader_->release();
+    frequencyBinningShader_->release();
 }
 
-void RCSCompute::readResults() {
-    // Read hit counter
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, counterBuffer_);
-    GLuint* counter = static_cast<GLuint*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), GL_MAP_READ_BIT));
-    if (counter) {
-        hitCount_ = static_cast<int>(*counter);
-        glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-    }
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-}
+void RCSCompute::dispatchHeatMapResolve() {
+    if (!heatMapResolveShader_ || !heatMapBinBuffer_) return;
 
-void RCSCompute::readHitBuffer() {
-    if (!hitBuffer_ || numRays_ <= 0) {
-        hitResults_.clear();
-        return;
-    }
+    heatMapResolveShader_->bind();
 
-    hitResults_.resize(numRays_);
+    heatMapResolveShader_->setUniformValue("latSegments", kHeatMapLatSegments);
+    heatMapResolveShader_->setUniformValue("lonSegments", kHeatMapLonSegments);
+    heatMapResolveShader_->setUniformValue("heatLatBins", kHeatMapLatBins);
+    heatMapResolveShader_->setUniformValue("heatLonBins", kHeatMapLonBins);
+    heatMapResolveShader_->setUniformValue("intensityScale", kBinIntensityScale);
+    heatMapResolveShader_->setUniformValue("historyWeight", historyWeight_);
 
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, hitBuffer_);
-    void* ptr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0,
-                                  numRays_ * sizeof(HitResult), GL_MAP_READ_BIT);
-    if (ptr) {
-        std::memcpy(hitResults_.data(), ptr, numRays_ * sizeof(HitResult));
-        glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-    }
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, heatMapBinBuffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, heatMapIntensityBuffer_);
+
+    int vertexCount = (kHeatMapLatSegments + 1) * (kHeatMapLonSegments + 1);
+    int numGroups = (vertexCount + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    glDispatchCompute(numGroups, 1, 1);
+
+    // The intensity buffer is consumed as a vertex attribute by HeatMapRenderer
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+
+    heatMapResolveShader_->release();
 }
 
 void RCSCompute::clearShadowMap() {
     if (!shadowMapTexture_) return;
 
     // Get texture dimensions
-    int raysPerRing = kRaysPerRing;
-    int numRings = (numRays_ + raysPerRing - 1) / raysPerRing;
-    int texWidth = raysPerRing;
-    int texHeight = numRings;
+    int texWidth = kRaysPerRing;
+    int texHeight = shadowMapRings_;
 
     // Clear shadow map to -1 (no hit = all visible)
-    // This is more reliable than glClearTexImage which may not be available
-    std::vector<float> clearData(texWidth * texHeight, -1.0f);
+    const float noHit = kShadowMapNoHit;
+    if (hasClearTexImage_) {
+        glClearTexImage(shadowMapTexture_, 0, GL_RED, GL_FLOAT, &noHit);
+        return;
+    }
+
+    // Fallback without GL 4.4 / ARB_clear_texture: upload from a cached buffer
+    if (static_cast<int>(shadowClearData_.size()) != texWidth * texHeight) {
+        shadowClearData_.assign(texWidth * texHeight, noHit);
+    }
     glBindTexture(GL_TEXTURE_2D, shadowMapTexture_);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texWidth, texHeight, GL_RED, GL_FLOAT, clearData.data());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texWidth, texHeight, GL_RED, GL_FLOAT, shadowClearData_.data());
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void RCSCompute::dispatchShadowMapGeneration() {
-    if (!shadowMapShader_ || !shadowMapTexture_) return;
-
-    shadowMapShader_->bind();
-
-    // Set uniforms
-    shadowMapShader_->setUniformValue("numRays", numRays_);
+void RCSCompute::bindShadowMap(QOpenGLShaderProgram* trace) {
+    // Program must be bound. Ring parameters are the same as ray generation.
+    trace->setUniformValue("shadowMapEnabled", shadowMapTexture_ != 0 && !isShadowDecoupled());
+    if (!shadowMapTexture_ || isShadowDecoupled()) return;
+
+    trace->setUniformValue("raysPerRing", kRaysPerRing);
+    trace->setUniformValue("numRings", getNumRings());
+    trace->setUniformValue("shadowRings", shadowMapRings_);
+    trace->setUniformValue("rayStride", rayOrderStride());
+    trace->setUniformValue("totalRays", numRays_);
+    trace->setUniformValue("scatterByDirection", shadowByDirection());
+    trace->setUniformValue("beamDirection", beamDirection_);
+    trace->setUniformValue("beamWidthRad", beamWidthDegrees_ * kDegToRadF);
+    glBindImageTexture(0, shadowMapTexture_, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32UI);
+}
 
-    // Calculate ring parameters (same as ray generation)
-    int raysPerRing = kRaysPerRing;
-    int numRings = (numRays_ + raysPerRing - 1) / raysPerRing;
-    shadowMapShader_->setUniformValue("raysPerRing", raysPerRing);
-    shadowMapShader_->setUniformValue("numRings", numRings);
+void RCSCompute::setShadowResolution(int footprintPixels) {
+    footprintPixels = std::max(footprintPixels, 0);
+    if (shadowFootprintPixels_ == footprintPixels) return;
+    shadowFootprintPixels_ = footprintPixels;
+
+    int width = 0;
+    int rings = 0;
+    shadowGridSize(width, rings);
+    if (initialized_ && (width != shadowMapResolution_ || rings != shadowMapRings_)) {
+        createShadowMap();
+        shadowMapReady_ = false;
+    }
+    shadowDirty_ = true;
+}
 
-    // Bind hit buffer (read) and shadow map (write)
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, hitBuffer_);
-    glBindImageTexture(0, shadowMapTexture_, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+void RCSCompute::updateShadowMap() {
+    if (!initialized_ || !isShadowDecoupled() || !shadowDirty_ || !shadowMapTexture_) return;
 
-    // Dispatch
-    int numGroups = (numRays_ + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
+    uploadBVH();
+    uploadTLAS();
+    QOpenGLShaderProgram* shadow = traceProgram(HitPayload::None, true);
+    if (!shadow) {
+        return;
+    }
+    RS::FrameProfiler::Scope stage(profiler_, "dispatchShadowVisibility");
+    shadow->bind();
+    bindScene(shadow);
+    shadow->setUniformValue("radarPosition", radarPosition_);
+    shadow->setUniformValue("beamDirection", beamDirection_);
+    shadow->setUniformValue("beamWidthRad", beamWidthDegrees_ * kDegToRadF);
+    shadow->setUniformValue("maxDistance", sphereRadius_ * kMaxRayDistanceMultiplier);
+    glBindImageTexture(0, shadowMapTexture_, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32UI);
+
+    // Every texel is written, hit or miss, so nothing is cleared first
+    int texels = shadowMapResolution_ * shadowMapRings_;
+    int numGroups = (texels + kComputeWorkgroupSize - 1) / kComputeWorkgroupSize;
     glDispatchCompute(numGroups, 1, 1);
 
-    // Memory barrier for texture writes - include TEXTURE_FETCH for sampling in fragment shader
     glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32UI);
+    shadow->release();
 
-    // Unbind image to allow texture sampling
-    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
-
-    shadowMapShader_->release();
+    shadowDirty_ = false;
+    shadowMapReady_ = true;
 }
 
 float RCSCompute::getBeamWidthRadians() const {
@@ -674,81 +4989,358 @@ void RCSCompute::compute() {
         return;
     }
 
+    RS::FrameProfiler::Scope profile(profiler_, "RCS compute");
+    readbackNs_ = 0;
+
     // Upload BVH if needed
     uploadBVH();
+    uploadTLAS();
+    if (memoryDirty_) {
+        accountMemory();
+    }
+    updateRayFocus();
+
+    // Progressive refinement traces the next batch [frameRayBegin_, frameRayEnd)
+    // of the lattice-permuted ray order and accumulates it onto the previous
+    // frame's results; batches double up to kProgressiveMaxBatchRays. With
+    // jitter the accumulation runs kSampleJitterPasses rotated passes over the
+    // ray set. Otherwise the whole beam is traced from scratch, and jitter
+    // rotates the pattern differently every frame.
+    int frameRayEnd = numRays_;
+    frameRayBegin_ = 0;
+    sampleRotation_[0] = 0.0f;
+    sampleRotation_[1] = 0.0f;
+    if (progressive_) {
+        if (progressiveRays_ >= progressiveTarget()) {
+            progressiveRays_ = 0;  // Already complete - start a new accumulation
+        }
+        int batch = std::clamp(progressiveRays_, kProgressivePreviewRays, kProgressiveMaxBatchRays);
+        frameRayBegin_ = progressiveRays_;
+        frameRayEnd = std::min(progressiveTarget(), progressiveRays_ + batch);
+        progressiveRays_ = frameRayEnd;
+    } else if (sampleJitter_) {
+        // R2 sequence over frames - successive rotations stay evenly spread
+        double n = static_cast<double>(frameCounter_ + 1);
+        sampleRotation_[0] = static_cast<float>(std::fmod(0.5 + n * 0.7548776662466927, 1.0));
+        sampleRotation_[1] = static_cast<float>(std::fmod(0.5 + n * 0.5698402909980532, 1.0));
+    }
+    const bool accumulate = frameRayBegin_ > 0;
+    updateHistoryWeight(accumulate);
+    const ReadbackSlot& previous = readbackSlots_[(writeSlot_ + kReadbackSlotCount - 1) % kReadbackSlotCount];
+
+    // Claim the next readback slot. Its previous contents (two frames old) are
+    // dropped; if it held the newest completed results, hitResults_ keeps the copy.
+    ReadbackSlot& slot = readbackSlots_[writeSlot_];
+    if (slot.fence) {
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (slot.counterFence) {
+        glDeleteSync(slot.counterFence);
+        slot.counterFence = nullptr;
+    }
+    if (latestSlot_ == writeSlot_) {
+        latestSlot_ = -1;
+    }
+    if (latestCountSlot_ == writeSlot_) {
+        latestCountSlot_ = latestSlot_;  // Fall back to the last fully completed slot
+    }
+    slot.frameIndex = ++frameCounter_;
+
+    // The trace kernel folds each ray's distance into the shadow map with an
+    // atomic min, so texels shared by several rings or directions keep their
+    // nearest hit. That needs the map cleared once per frame; a progressive
+    // batch that accumulates onto the previous one keeps its texels.
+    if (!accumulate && !isShadowDecoupled()) {
+        clearShadowMap();
+    }
+    updateShadowMap();
+
+    // Reset the hit counter once - it accumulates across every tile. An
+    // accumulating batch carries the previous frame's count over on the GPU,
+    // except for hits-only payloads where it is this frame's append index.
+    GLuint zero = 0;
+    const int frameRays = frameRayEnd - frameRayBegin_;
+    bool carryCounter = accumulate && hitPayload_ != HitPayload::CompactHitsOnly;
+    if (carryCounter) {
+        glBindBuffer(GL_COPY_READ_BUFFER, previous.counterBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, slot.counterBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(GLuint));
+    } else {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.counterBuffer);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    }
+    slot.accumulatedRays = (carryCounter ? previous.accumulatedRays : 0) + frameRays;
+
+    // Clear binning targets; bins accumulate across every tile like the counter,
+    // and across frames while a progressive accumulation is refining
+    if (heatMapBinning_ && !heatMapBinBuffer_) {
+        createHeatMapBuffers();
+    }
+    if (polarBinning_) {
+        if (accumulate && previous.polarBinned) {
+            glBindBuffer(GL_COPY_READ_BUFFER, previous.polarBinBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, slot.polarBinBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                static_cast<GLsizeiptr>(kPolarPlotBins) * sizeof(PolarBin));
+        } else {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.polarBinBuffer);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        }
+    }
+    if (sphereBinning_) {
+        createSphereBuffers();
+        if (accumulate && previous.sphereBinned) {
+            glBindBuffer(GL_COPY_READ_BUFFER, previous.sphereBinBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, slot.sphereBinBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                static_cast<GLsizeiptr>(kSphereTableAzBins) * kSphereTableElBins * sizeof(PolarBin));
+        } else {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.sphereBinBuffer);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        }
+    }
+    if (!receivers_.empty()) {
+        createReceiverBuffers();
+        if (accumulate && previous.receiversBinned) {
+            glBindBuffer(GL_COPY_READ_BUFFER, previous.receiverBinBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, slot.receiverBinBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                static_cast<GLsizeiptr>(kMaxReceivers) * sizeof(PolarBin));
+        } else {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.receiverBinBuffer);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        }
+    }
+    if (frequencySweep_) {
+        createFrequencyBuffers();
+        const GLsizeiptr frequencyBytes =
+            static_cast<GLsizeiptr>(kPolarPlotBins) * sweep_.points * sizeof(FrequencyBin);
+        if (accumulate && previous.frequencyPoints == sweep_.points) {
+            glBindBuffer(GL_COPY_READ_BUFFER, previous.frequencyBinBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, slot.frequencyBinBuffer);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, frequencyBytes);
+        } else {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.frequencyBinBuffer);
+            glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, frequencyBytes,
+                                 GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        }
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (heatMapBinning_ && !accumulate) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, heatMapBinBuffer_);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    }
+    if (isHotspotsActive() && (!accumulate || !hotspotBuffer_)) {
+        clearHotspots();
+    }
+    if (lobeClustering_ && lobeClusterTable_) {
+        if (!accumulate) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, lobeClusterTable_);
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        }
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.clusterBuffer);
+        glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, 0, sizeof(GLuint),
+                             GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    slot.polarBinned = polarBinning_;
+    slot.lobeClustered = lobeClustering_ && lobeClusterTable_;
+    slot.frequencyPoints = frequencySweep_ && slot.frequencyBinBuffer ? sweep_.points : 0;
+    slot.sphereBinned = sphereBinning_ && slot.sphereBinBuffer;
+    slot.receiversBinned = !receivers_.empty() && slot.receiverBinBuffer;
+
+    // Trace in tiles of at most kRayTileSize rays so the ray/hit buffers stay a
+    // fixed size however many rays are requested. The hit count is reduced on the
+    // GPU across all tiles. Tiles run last-to-first so the slot is left holding
+    // the frame's first tile - an interleaved, uniform subsample of the beam - for
+    // the CPU consumers.
+    const int tileCapacity = getTileCapacity();
+    const int numTiles = (frameRays + tileCapacity - 1) / tileCapacity;
+    for (int tile = numTiles - 1; tile >= 0; --tile) {
+        int rayOffset = frameRayBegin_ + tile * tileCapacity;
+        int tileRays = std::min(tileCapacity, frameRayEnd - rayOffset);
+
+        // Generate rays
+        {
+            RS::FrameProfiler::Scope stage(profiler_, "dispatchRayGeneration");
+            dispatchRayGeneration(rayOffset, tileRays);
+        }
+
+        // Trace rays
+        {
+            RS::FrameProfiler::Scope stage(profiler_, "dispatchTracing");
+            dispatchTracing(rayOffset, tileRays);
+        }
 
-    // Clear shadow map before tracing
-    clearShadowMap();
+        // Trace further bounces of this tile's reflecting hits
+        if (maxBounces_ > 1) {
+            RS::FrameProfiler::Scope stage(profiler_, "dispatchBounces");
+            dispatchBounces(tileHitBuffer_, slot.hitBuffer, hitPayload_);
+        }
+
+        // Accumulate polar / heat map bins from this tile
+        if (polarBinning_ || heatMapBinning_ || slot.sphereBinned || slot.receiversBinned) {
+            RS::FrameProfiler::Scope stage(profiler_, "dispatchBinning");
+            dispatchBinning(tileRays);
+        }
+
+        // Accumulate complex field bins for every swept frequency
+        if (slot.frequencyPoints > 0) {
+            RS::FrameProfiler::Scope stage(profiler_, "dispatchFrequencyBinning");
+            dispatchFrequencyBinning(tileRays);
+        }
+
+        // Accumulate lobe clusters from this tile
+        if (slot.lobeClustered) {
+            RS::FrameProfiler::Scope stage(profiler_, "dispatchLobeClustering");
+            dispatchLobeClustering(tileRays);
+        }
+    }
 
-    // Generate rays
-    dispatchRayGeneration();
+    // Crease-edge returns do not depend on the rays: once per accumulation
+    if (edgeDiffraction_ && !accumulate && (polarBinning_ || heatMapBinning_ || slot.sphereBinned)) {
+        RS::FrameProfiler::Scope stage(profiler_, "dispatchEdgeDiffraction");
+        dispatchEdgeDiffraction(0);
+    }
+    slot.numRays = std::min(tileCapacity, frameRays);
+    slot.historyWeight = historyWeight_;
+    slot.payload = hitPayload_;
+    slot.radarPosition = radarPosition_;
+
+    // The hit count is final once the last tile is traced. Copy it out and
+    // fence it on its own, so getHitCount() never waits for the resolve,
+    // clustering and payload copies queued behind it.
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_COPY_READ_BUFFER, slot.counterBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, slot.counterReadback);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(GLuint));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+    slot.counterFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Full payload: copy tile 0 (the last tile traced) into the readback slot
+    if (hitPayload_ == HitPayload::Full) {
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        glBindBuffer(GL_COPY_READ_BUFFER, tileHitBuffer_);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, slot.hitBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                            static_cast<GLsizeiptr>(slot.numRays) * sizeof(HitResult));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    // Resolve heat map bins into per-vertex intensities for rendering
+    if (heatMapBinning_) {
+        RS::FrameProfiler::Scope stage(profiler_, "dispatchHeatMapResolve");
+        dispatchHeatMapResolve();
+    }
 
-    // Trace rays
-    dispatchTracing();
+    // Gather occupied cluster slots into the readback slot
+    if (slot.lobeClustered) {
+        RS::FrameProfiler::Scope stage(profiler_, "dispatchLobeClusterCollect");
+        dispatchLobeClusterCollect();
+    }
 
-    // Generate shadow map from hit results
-    dispatchShadowMapGeneration();
+    // Make shader writes visible through the persistent mapping, then fence the slot
+    glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (asyncReadback_) {
+        glFlush();  // Ensure the fence reaches the GPU even if nothing else flushes
+    }
+    writeSlot_ = (writeSlot_ + 1) % kReadbackSlotCount;
 
     // Read results
-    readResults();
+    {
+        RS::FrameProfiler::Scope stage(profiler_, "readResults");
+        QElapsedTimer readTimer;
+        readTimer.start();
+        readResults();
+        readbackNs_ += readTimer.nsecsElapsed();
+    }
 
     // Mark shadow map as ready for beam rendering
     shadowMapReady_ = true;
 }
 
 float RCSCompute::getOcclusionRatio() const {
-    if (numRays_ == 0) return 0.0f;
-    return static_cast<float>(hitCount_) / static_cast<float>(numRays_);
+    int rays = completedRays_ > 0 ? completedRays_ : numRays_;
+    if (rays == 0) return 0.0f;
+    return static_cast<float>(hitCount_) / static_cast<float>(rays);
 }
 
-// CPU-side ray-AABB intersection test
-static bool rayAABBIntersect(const QVector3D& origin, const QVector3D& invDir,
-                              const QVector3D& boundsMin, const QVector3D& boundsMax,
-                              float tmin, float tmax) {
-    float tx1 = (boundsMin.x() - origin.x()) * invDir.x();
-    float tx2 = (boundsMax.x() - origin.x()) * invDir.x();
-    float txMin = std::min(tx1, tx2);
-    float txMax = std::max(tx1, tx2);
-
-    float ty1 = (boundsMin.y() - origin.y()) * invDir.y();
-    float ty2 = (boundsMax.y() - origin.y()) * invDir.y();
-    float tyMin = std::min(ty1, ty2);
-    float tyMax = std::max(ty1, ty2);
-
-    float tz1 = (boundsMin.z() - origin.z()) * invDir.z();
-    float tz2 = (boundsMax.z() - origin.z()) * invDir.z();
-    float tzMin = std::min(tz1, tz2);
-    float tzMax = std::max(tz1, tz2);
-
-    float tNear = std::max(std::max(txMin, tyMin), tzMin);
-    float tFar = std::min(std::min(txMax, tyMax), tzMax);
-
-    return tNear <= tFar && tFar >= tmin && tNear <= tmax;
-}
+bool RCSCompute::traceSceneCPU(const QVector3D& rayOrigin, const QVector3D& rayDir,
+                               float maxDist, float minT, SceneHit& sceneHit) const {
+    Traversal::ScalarRay::Hit hit;
+    hit.t = maxDist;
+
+    // Debug rays are single rays, so instances are simply tested in turn -
+    // each BLAS root box rejects misses after one test
+    for (size_t instanceIdx = 0; instanceIdx < instanceStates_.size(); ++instanceIdx) {
+        const InstanceState& instance = instanceStates_[instanceIdx];
+        auto it = meshes_.find(instance.meshId);
+        if (it == meshes_.end() || !it->second.bvh) {
+            continue;
+        }
+        const BVHSnapshot& bvh = *it->second.bvh;
+        if (bvh.nodes.empty() || bvh.triangles.empty()) {
+            continue;
+        }
 
-// CPU-side Möller–Trumbore ray-triangle intersection
-static bool rayTriangleIntersect(const QVector3D& origin, const QVector3D& dir,
-                                  const QVector3D& v0, const QVector3D& v1, const QVector3D& v2,
-                                  float& t, float& u, float& v) {
-    const float EPSILON = 1e-6f;
-    QVector3D edge1 = v1 - v0;
-    QVector3D edge2 = v2 - v0;
-    QVector3D h = QVector3D::crossProduct(dir, edge2);
-    float a = QVector3D::dotProduct(edge1, h);
+        // Object space (BVH space); t remains a world-space distance. Same
+        // layout the trace kernel walks, so debug rays see the uploaded tree.
+        Traversal::ScalarRay ray(instance.invModelMatrix.map(rayOrigin),
+                                 instance.invModelMatrix.mapVector(rayDir), minT);
+        if (wideBvhActive_ && !bvh.wideNodes.empty()) {
+            Traversal::traverse<Traversal::WideNodes, Traversal::ClosestHit>(
+                bvh, ray, static_cast<int>(instanceIdx), hit, debugStack_);
+        } else {
+            Traversal::traverse<Traversal::BinaryNodes, Traversal::ClosestHit>(
+                bvh, ray, static_cast<int>(instanceIdx), hit, debugStack_);
+        }
+    }
 
-    if (std::abs(a) < EPSILON) return false;  // Ray parallel to triangle
+    // Analytic primitives after the meshes, as the kernel's tracePrimitives
+    int primitiveHit = -1;
+    QVector3D primitiveNormal;
+    for (size_t p = 0; p < primitives_.size(); ++p) {
+        QMatrix4x4 invModel = primitives_[p].modelMatrix.inverted();
+        float t;
+        QVector3D n;
+        if (Traversal::intersectPrimitive(primitives_[p].shape, invModel.map(rayOrigin), invModel.mapVector(rayDir),
+                                          minT, hit.t, t, n)) {
+            hit.t = t;
+            primitiveHit = static_cast<int>(p);
+            primitiveNormal = n;
+        }
+    }
+    if (primitiveHit >= 0) {
+        const ScenePrimitive& primitive = primitives_[primitiveHit];
+        sceneHit.t = hit.t;
+        sceneHit.instance = static_cast<int>(primitive.targetId);
+        sceneHit.triangle = primitiveHit;
+        sceneHit.primitive = true;
+        sceneHit.normal = primitive.modelMatrix.inverted().transposed().mapVector(primitiveNormal).normalized();
+        return true;
+    }
 
-    float f = 1.0f / a;
-    QVector3D s = origin - v0;
-    u = f * QVector3D::dotProduct(s, h);
-    if (u < 0.0f || u > 1.0f) return false;
+    if (hit.instance < 0) {
+        return false;
+    }
 
-    QVector3D q = QVector3D::crossProduct(s, edge1);
-    v = f * QVector3D::dotProduct(dir, q);
-    if (v < 0.0f || u + v > 1.0f) return false;
+    // Face normal (object space -> world space)
+    const InstanceState& instance = instanceStates_[hit.instance];
+    const Triangle& tri = meshes_.at(instance.meshId).bvh->triangles[hit.triangle];
 
-    t = f * QVector3D::dotProduct(edge2, q);
-    return t > EPSILON;
+    sceneHit.t = hit.t;
+    sceneHit.instance = hit.instance;
+    sceneHit.triangle = hit.triangle;
+    sceneHit.primitive = false;
+    sceneHit.normal = instance.normalTransform.mapVector(
+        QVector3D::crossProduct(tri.edge1(), tri.edge2())).normalized();
+    return true;
 }
 
 HitResult RCSCompute::traceDebugRay(const QVector3D& targetCenter) {
@@ -761,211 +5353,63 @@ HitResult RCSCompute::traceDebugRay(const QVector3D& targetCenter) {
     result.targetId = 0;
     result.rcsContribution = 0.0f;
 
-    const auto& nodes = bvhBuilder_.getNodes();
-    const auto& triangles = bvhBuilder_.getTriangles();
-
-    if (nodes.empty() || triangles.empty()) {
-        return result;  // No geometry to trace
-    }
-
     // Create ray from radar position toward target center
     QVector3D rayOrigin = radarPosition_;
     QVector3D rayDir = (targetCenter - radarPosition_).normalized();
     float maxDist = sphereRadius_ * kMaxRayDistanceMultiplier;
 
-    // Compute inverse direction for AABB tests
-    QVector3D invDir(
-        std::abs(rayDir.x()) > 1e-6f ? 1.0f / rayDir.x() : 1e30f,
-        std::abs(rayDir.y()) > 1e-6f ? 1.0f / rayDir.y() : 1e30f,
-        std::abs(rayDir.z()) > 1e-6f ? 1.0f / rayDir.z() : 1e30f
-    );
-
-    // BVH traversal stack
-    int stack[64];
-    int stackPtr = 0;
-    stack[stackPtr++] = 0;  // Start with root node
-
-    float closestT = maxDist;
-    int hitTriIdx = -1;
-    float hitU = 0, hitV = 0;
-
-    while (stackPtr > 0) {
-        int nodeIdx = stack[--stackPtr];
-        const BVHNode& node = nodes[nodeIdx];
-
-        // Extract bounds
-        QVector3D boundsMin(node.boundsMin.x(), node.boundsMin.y(), node.boundsMin.z());
-        QVector3D boundsMax(node.boundsMax.x(), node.boundsMax.y(), node.boundsMax.z());
-
-        // Test ray-AABB intersection
-        if (!rayAABBIntersect(rayOrigin, invDir, boundsMin, boundsMax, 0.001f, closestT)) {
-            continue;
-        }
-
-        int leftChild = static_cast<int>(node.boundsMin.w());
-        int rightOrCount = static_cast<int>(node.boundsMax.w());
-
-        if (leftChild < 0) {
-            // Leaf node: leftChild encodes (-firstTriIdx - 1), rightOrCount is triCount
-            int firstTri = -leftChild - 1;
-            int triCount = rightOrCount;
-
-            for (int i = 0; i < triCount; i++) {
-                int triIdx = firstTri + i;
-                const Triangle& tri = triangles[triIdx];
-
-                QVector3D v0(tri.v0.x(), tri.v0.y(), tri.v0.z());
-                QVector3D v1(tri.v1.x(), tri.v1.y(), tri.v1.z());
-                QVector3D v2(tri.v2.x(), tri.v2.y(), tri.v2.z());
-
-                float t, u, v;
-                if (rayTriangleIntersect(rayOrigin, rayDir, v0, v1, v2, t, u, v)) {
-                    if (t < closestT && t > 0.001f) {
-                        closestT = t;
-                        hitTriIdx = triIdx;
-                        hitU = u;
-                        hitV = v;
-                    }
-                }
-            }
-        } else {
-            // Internal node: push children
-            stack[stackPtr++] = rightOrCount;  // Right child
-            stack[stackPtr++] = leftChild;     // Left child (processed first)
-        }
+    SceneHit sceneHit;
+    if (!traceSceneCPU(rayOrigin, rayDir, maxDist, 0.001f, sceneHit)) {
+        return result;  // Miss, or no BVH built yet
     }
 
-    // If we hit something, compute hit point, normal, and reflection
-    if (hitTriIdx >= 0) {
-        const Triangle& tri = triangles[hitTriIdx];
-        QVector3D v0(tri.v0.x(), tri.v0.y(), tri.v0.z());
-        QVector3D v1(tri.v1.x(), tri.v1.y(), tri.v1.z());
-        QVector3D v2(tri.v2.x(), tri.v2.y(), tri.v2.z());
-
-        // Hit point
-        QVector3D hitPos = rayOrigin + rayDir * closestT;
+    // Hit point
+    QVector3D hitPos = rayOrigin + rayDir * sceneHit.t;
 
-        // Compute face normal
-        QVector3D edge1 = v1 - v0;
-        QVector3D edge2 = v2 - v0;
-        QVector3D normal = QVector3D::crossProduct(edge1, edge2).normalized();
-
-        // Ensure normal faces toward ray origin
-        if (QVector3D::dotProduct(normal, rayDir) > 0) {
-            normal = -normal;
-        }
+    // Ensure normal faces toward ray origin
+    QVector3D normal = sceneHit.normal;
+    if (QVector3D::dotProduct(normal, rayDir) > 0) {
+        normal = -normal;
+    }
 
-        // Reflection direction: R = I - 2(N·I)N
-        float NdotI = QVector3D::dotProduct(normal, rayDir);
-        QVector3D reflection = rayDir - 2.0f * NdotI * normal;
+    // Reflection direction: R = I - 2(N·I)N
+    float NdotI = QVector3D::dotProduct(normal, rayDir);
+    QVector3D reflection = rayDir - 2.0f * NdotI * normal;
 
-        // Fill result
-        result.hitPoint = QVector4D(hitPos.x(), hitPos.y(), hitPos.z(), closestT);
-        result.normal = QVector4D(normal.x(), normal.y(), normal.z(), 0);
-        result.reflection = QVector4D(reflection.x(), reflection.y(), reflection.z(), 1.0f);
-        result.triangleId = static_cast<uint32_t>(hitTriIdx);
-        result.rayId = 0;
-        result.targetId = 0;
-        result.rcsContribution = 1.0f;
-    }
+    // Fill result
+    result.hitPoint = QVector4D(hitPos.x(), hitPos.y(), hitPos.z(), sceneHit.t);
+    result.normal = QVector4D(normal.x(), normal.y(), normal.z(), 0);
+    result.reflection = QVector4D(reflection.x(), reflection.y(), reflection.z(), 1.0f);
+    result.triangleId = static_cast<uint32_t>(sceneHit.triangle);
+    result.rayId = 0;
+    result.targetId = static_cast<uint32_t>(sceneHit.instance);
+    result.rcsContribution = 1.0f;
 
     return result;
 }
 
 std::vector<HitResult> RCSCompute::traceDebugRayMultiBounce(const QVector3D& targetCenter, int maxBounces) {
-    std::vector<HitResult> bounces;
-
-    const auto& nodes = bvhBuilder_.getNodes();
-    const auto& triangles = bvhBuilder_.getTriangles();
-
-    if (nodes.empty() || triangles.empty()) {
-        return bounces;  // No geometry to trace
-    }
-
     // Initial ray from radar toward target center
-    QVector3D rayOrigin = radarPosition_;
-    QVector3D rayDir = (targetCenter - radarPosition_).normalized();
+    return tracePathCPU(radarPosition_, (targetCenter - radarPosition_).normalized(), maxBounces);
+}
+
+std::vector<HitResult> RCSCompute::tracePathCPU(const QVector3D& origin, const QVector3D& dir, int maxBounces) const {
+    std::vector<HitResult> bounces;
+    QVector3D rayOrigin = origin;
+    QVector3D rayDir = dir;
     float maxDist = sphereRadius_ * kMaxRayDistanceMultiplier;
 
     for (int bounce = 0; bounce < maxBounces; ++bounce) {
-        // Compute inverse direction for AABB tests
-        QVector3D invDir(
-            std::abs(rayDir.x()) > 1e-6f ? 1.0f / rayDir.x() : 1e30f,
-            std::abs(rayDir.y()) > 1e-6f ? 1.0f / rayDir.y() : 1e30f,
-            std::abs(rayDir.z()) > 1e-6f ? 1.0f / rayDir.z() : 1e30f
-        );
-
-        // BVH traversal stack
-        int stack[64];
-        int stackPtr = 0;
-        stack[stackPtr++] = 0;  // Start with root node
-
-        float closestT = maxDist;
-        int hitTriIdx = -1;
-
-        while (stackPtr > 0) {
-            int nodeIdx = stack[--stackPtr];
-            const BVHNode& node = nodes[nodeIdx];
-
-            // Extract bounds
-            QVector3D boundsMin(node.boundsMin.x(), node.boundsMin.y(), node.boundsMin.z());
-            QVector3D boundsMax(node.boundsMax.x(), node.boundsMax.y(), node.boundsMax.z());
-
-            // Test ray-AABB intersection
-            if (!rayAABBIntersect(rayOrigin, invDir, boundsMin, boundsMax, 0.001f, closestT)) {
-                continue;
-            }
-
-            int leftChild = static_cast<int>(node.boundsMin.w());
-            int rightOrCount = static_cast<int>(node.boundsMax.w());
-
-            if (leftChild < 0) {
-                // Leaf node
-                int firstTri = -leftChild - 1;
-                int triCount = rightOrCount;
-
-                for (int i = 0; i < triCount; i++) {
-                    int triIdx = firstTri + i;
-                    const Triangle& tri = triangles[triIdx];
-
-                    QVector3D v0(tri.v0.x(), tri.v0.y(), tri.v0.z());
-                    QVector3D v1(tri.v1.x(), tri.v1.y(), tri.v1.z());
-                    QVector3D v2(tri.v2.x(), tri.v2.y(), tri.v2.z());
-
-                    float t, u, v;
-                    if (rayTriangleIntersect(rayOrigin, rayDir, v0, v1, v2, t, u, v)) {
-                        if (t < closestT && t > 0.01f) {  // Slightly larger epsilon for bounces
-                            closestT = t;
-                            hitTriIdx = triIdx;
-                        }
-                    }
-                }
-            } else {
-                // Internal node: push children
-                stack[stackPtr++] = rightOrCount;
-                stack[stackPtr++] = leftChild;
-            }
-        }
-
-        // No hit - stop bouncing
-        if (hitTriIdx < 0) {
+        // Slightly larger epsilon for bounces. No hit (or no BVH) - stop bouncing
+        SceneHit sceneHit;
+        if (!traceSceneCPU(rayOrigin, rayDir, maxDist, 0.01f, sceneHit)) {
             break;
         }
 
-        // Compute hit data
-        const Triangle& tri = triangles[hitTriIdx];
-        QVector3D v0(tri.v0.x(), tri.v0.y(), tri.v0.z());
-        QVector3D v1(tri.v1.x(), tri.v1.y(), tri.v1.z());
-        QVector3D v2(tri.v2.x(), tri.v2.y(), tri.v2.z());
-
-        QVector3D hitPos = rayOrigin + rayDir * closestT;
-
-        // Compute face normal
-        QVector3D edge1 = v1 - v0;
-        QVector3D edge2 = v2 - v0;
-        QVector3D normal = QVector3D::crossProduct(edge1, edge2).normalized();
+        QVector3D hitPos = rayOrigin + rayDir * sceneHit.t;
 
         // Ensure normal faces toward ray origin
+        QVector3D normal = sceneHit.normal;
         if (QVector3D::dotProduct(normal, rayDir) > 0) {
             normal = -normal;
         }
@@ -978,12 +5422,12 @@ std::vector<HitResult> RCSCompute::traceDebugRayMultiBounce(const QVector3D& tar
         // Create hit result
         // Store ray origin in normal.w as a flag (we encode bounceIndex)
         HitResult result;
-        result.hitPoint = QVector4D(hitPos.x(), hitPos.y(), hitPos.z(), closestT);
+        result.hitPoint = QVector4D(hitPos.x(), hitPos.y(), hitPos.z(), sceneHit.t);
         result.normal = QVector4D(normal.x(), normal.y(), normal.z(), static_cast<float>(bounce));
         result.reflection = QVector4D(reflection.x(), reflection.y(), reflection.z(), 1.0f);
-        result.triangleId = static_cast<uint32_t>(hitTriIdx);
+        result.triangleId = static_cast<uint32_t>(sceneHit.triangle);
         result.rayId = static_cast<uint32_t>(bounce);  // Use rayId to store bounce index
-        result.targetId = 0;
+        result.targetId = static_cast<uint32_t>(sceneHit.instance);
         result.rcsContribution = 1.0f;
 
         bounces.push_back(result);
@@ -996,4 +5440,71 @@ std::vector<HitResult> RCSCompute::traceDebugRayMultiBounce(const QVector3D& tar
     return bounces;
 }
 
+PickResult RCSCompute::pick(const QVector3D& origin, const QVector3D& direction, int maxBounces) const {
+    PickResult result;
+    QVector3D rayDir = direction.normalized();
+    if (rayDir.isNull()) {
+        return result;
+    }
+
+    SceneHit sceneHit;
+    if (!traceSceneCPU(origin, rayDir, std::numeric_limits<float>::max(), 0.001f, sceneHit)) {
+        return result;  // Miss, or no CPU BVH
+    }
+
+    QVector3D position = origin + rayDir * sceneHit.t;
+    QVector3D normal = sceneHit.normal;
+    if (QVector3D::dotProduct(normal, rayDir) > 0) {
+        normal = -normal;
+    }
+
+    result.hit = true;
+    result.position = position;
+    result.normal = normal;
+    result.distance = sceneHit.t;
+    result.primitive = sceneHit.primitive;
+    if (sceneHit.primitive) {
+        const ScenePrimitive& primitive = primitives_[sceneHit.triangle];
+        result.targetId = primitive.targetId;
+        result.triangle = sceneHit.triangle;
+        result.materialId = primitive.materialId;
+    } else {
+        const Triangle& tri = meshes_.at(instanceStates_[sceneHit.instance].meshId).bvh->triangles[sceneHit.triangle];
+        result.instance = sceneHit.instance;
+        result.targetId = static_cast<uint32_t>(sceneHit.instance);
+        result.triangle = static_cast<int>(tri.sourceIndex);
+        result.materialId = tri.materialId;
+    }
+
+    // The radar's view of the point: the path it traces through it, and
+    // whether that ray is stopped by this surface or by one in front of it
+    QVector3D toPoint = position - radarPosition_;
+    float radarDistance = toPoint.length();
+    if (radarDistance <= 0.0f) {
+        return result;
+    }
+    QVector3D radarDir = toPoint / radarDistance;
+    result.path = tracePathCPU(radarPosition_, radarDir, maxBounces);
+
+    SceneHit radarHit;
+    result.radarVisible = traceSceneCPU(radarPosition_, radarDir, radarDistance * (1.0f + kPickVisibilityTolerance),
+                                        0.01f, radarHit) &&
+                          radarHit.primitive == sceneHit.primitive && radarHit.instance == sceneHit.instance &&
+                          radarHit.triangle == sceneHit.triangle;
+
+    // shadeHit on the CPU: the BRDF return toward the radar, before bounce
+    // effects. The normal is unflipped, so a back face returns nothing.
+    float facing = QVector3D::dotProduct(sceneHit.normal, -radarDir);
+    if (result.radarVisible && facing > 0.0f) {
+        Material material;
+        if (!materials_.empty()) {
+            material = materials_[std::min<size_t>(result.materialId, materials_.size() - 1)];
+        }
+        float diffuse = material.roughness * facing;
+        float specular = (1.0f - material.roughness) * std::pow(facing, material.shininess);
+        result.intensity = std::clamp(diffuse + specular, 0.0f, 1.0f);
+    }
+    return result;
+}
+
 } // namespace RCS
@@ -6,14 +6,29 @@
 #include <QOpenGLShaderProgram>
 #include <QVector3D>
 #include <QMatrix4x4>
+#include <QThread>
 #include <vector>
 #include <memory>
+#include <array>
+#include <map>
+#include <algorithm>
 
 #include "RCSTypes.h"
 #include "BVHBuilder.h"
+#include "BVHWorker.h"
+#include "DiffractionEdges.h"
+#include "GPUBVHBuilder.h"
+#include "GPURadixSort.h"
+#include "TLASBuilder.h"
+#include "Constants.h"
+#include "FrameProfiler.h"
+#include "GPUMemory.h"
+#include "../../../../RCS/RayTraceTypes.h"
 
 namespace RCS {
 
+class BounceEffectPipeline;
+
 class RCSCompute : public QObject, protected QOpenGLFunctions_4_5_Core {
     Q_OBJECT
 
@@ -26,10 +41,56 @@ public:
     void cleanup();
     bool isInitialized() const { return initialized_; }
 
-    // Geometry management
+    // Scene geometry - a two-level BVH. Each unique mesh gets one bottom-level BVH,
+    // built in object space and only rebuilt when its geometryVersion changes.
+    // Builds run on a background thread; tracing keeps using the previous BVH until
+    // the new one arrives (bvhUpdated() is emitted then). Instances place meshes in
+    // the world and share their mesh's BVH; the top-level BVH over instance bounds
+    // is rebuilt on the next compute() whenever instances change.
+    // materialIds, if given, holds one material table index per source
+    // triangle (indices / 3); empty puts the whole mesh on material 0. The IDs
+    // are baked into the BVH, so changing them needs a new geometryVersion.
+    void setMeshGeometry(uint32_t meshId,
+                         const std::vector<float>& vertices,
+                         const std::vector<uint32_t>& indices,
+                         uint64_t geometryVersion,
+                         const std::vector<uint32_t>& materialIds = {});
+    // Installs a finished object-space tree (e.g. from TargetCache) without a
+    // build; it is uploaded on the next compute(). bvh->meshId must be meshId and
+    // bvh->geometryVersion becomes the mesh's version, so a later
+    // setMeshGeometry() with that version keeps it.
+    void setMeshBVH(uint32_t meshId, BVHSnapshotPtr bvh);
+    // Builds the mesh's tree on the GPU (GPUBVHBuilder) from geometry already in
+    // buffers of a context shared with this one: vertexBuffer holds
+    // [x,y,z,nx,ny,nz] per vertex, indexBuffer three uint indices per triangle.
+    // Only the root bounds and depth come back, so deformed or generated meshes
+    // can get a new tree every frame; a new geometryVersion with the same
+    // triangle count rebuilds in place. The buffers must outlive the mesh, as
+    // a repack builds from them again. Known object-space bounds place the
+    // mesh in the TLAS straight away; otherwise it joins (or keeps its previous
+    // bounds) until the GPU's arrive, usually a frame later. These meshes have
+    // no CPU snapshot (debug rays miss them, getMeshBVH() is null), use
+    // material 0, and keep the binary layout and full-precision triangles in
+    // use while they exist.
+    void setMeshGPUGeometry(uint32_t meshId, GLuint vertexBuffer, GLuint indexBuffer, int triangleCount,
+                            uint64_t geometryVersion, const AABB& bounds = AABB());
+    // Newest tree for a mesh (finished, possibly not yet uploaded), or null
+    BVHSnapshotPtr getMeshBVH(uint32_t meshId) const;
+    void removeMesh(uint32_t meshId);
+    // HitResult::targetId is the instance's index in this list
+    void setInstances(const std::vector<TargetInstance>& instances);
+    int getInstanceCount() const { return static_cast<int>(instanceStates_.size()); }
+    // Analytic primitives intersected in closed form after the instances, with
+    // exact normals and no BVH. A hit's triangleId is the primitive's index here.
+    void setPrimitives(const std::vector<ScenePrimitive>& primitives);
+    int getPrimitiveCount() const { return static_cast<int>(primitives_.size()); }
+
+    // Single target - mesh 0 and one instance of it (replaces any other instances)
     void setTargetGeometry(const std::vector<float>& vertices,
                            const std::vector<uint32_t>& indices,
-                           const QMatrix4x4& modelMatrix);
+                           uint64_t geometryVersion,
+                           const std::vector<uint32_t>& materialIds = {});
+    void setTargetTransform(const QMatrix4x4& modelMatrix);
 
     // Beam configuration
     void setRadarPosition(const QVector3D& position);
@@ -40,6 +101,13 @@ public:
     // Ray tracing
     void compute();
 
+    // Batched looks - every look is traced by the same dispatch (one look per
+    // gl_GlobalInvocationID.y) and binned into its own polar cut. Synchronous, and
+    // polar bins only: no shadow map, heat map, lobes or per-ray payload. Uses the
+    // current ray count, beam width and target; at most kMaxLooksPerDispatch looks.
+    // Monostatic only: returns false while bistatic receivers are set.
+    bool computeLooks(const std::vector<RadarLook>& looks, std::vector<LookResult>& results);
+
     // Debug ray - traces single ray toward target center (CPU-side)
     HitResult traceDebugRay(const QVector3D& targetCenter);
 
@@ -47,22 +115,304 @@ public:
     // Returns vector of hit results for each bounce (empty if no hits)
     std::vector<HitResult> traceDebugRayMultiBounce(const QVector3D& targetCenter, int maxBounces = 5);
 
+    // Picking - the closest surface along a scene-space ray (a screen ray
+    // unprojected by the caller), from the same CPU walk of the uploaded BVHs
+    // as the debug rays, so a query costs a few microseconds whatever the
+    // triangle count. Meshes built on the GPU have no CPU tree and are not
+    // pickable. The path is the radar's ray through the picked point.
+    PickResult pick(const QVector3D& origin, const QVector3D& direction, int maxBounces = 5) const;
+
+    // Multi-bounce RCS over the whole beam (1 = primary hits only, the default).
+    // Each pass queues the reflecting hits of the last one and traces them again,
+    // up to kMaxRCSBounces; a ray's hit is replaced by the newest reflecting one,
+    // so bins, lobes and payloads see where the path finally leaves the target.
+    // Intensity follows the BounceEffectPipeline: every enabled effect with a
+    // shader port (BounceEffect::shaderSource) is compiled, in pipeline order,
+    // into the trace kernels and runs on the path weight at each hit. Path mode
+    // applies none. A different set of effects rebuilds the kernels; new
+    // parameters only change uniforms. At most kMaxBounceEffects effects.
+    void setMaxBounces(int bounces);
+    int getMaxBounces() const { return maxBounces_; }
+    void setBounceEffects(const BounceEffectPipeline& pipeline);
+
+    // Multi-bounce path termination, measured on the return a hit reflects
+    // (intensity x path weight). At or under cutoff the path ends at that hit;
+    // under rouletteThreshold it goes on with probability return / threshold
+    // and is reweighted by its inverse, returning nothing when it loses, so
+    // the estimate stays unbiased. A threshold of 0 turns roulette off.
+    void setBounceTermination(float cutoff, float rouletteThreshold);
+    float getBounceCutoff() const { return bounceCutoff_; }
+    float getRouletteThreshold() const { return rouletteThreshold_; }
+
+    // Surface materials, indexed by the per-triangle material IDs given to
+    // setMeshGeometry() (IDs past the end use the last entry). Empty = the
+    // default Material everywhere. Shading takes roughness and shininess from
+    // the table; MaterialEffect applies reflectivity and absorption.
+    void setMaterials(const std::vector<Material>& materials);
+    const std::vector<Material>& getMaterials() const { return materials_; }
+
     // Results
     int getHitCount() const { return hitCount_; }
+    // Hits-only entries the last completed frame had no room for (0 = none dropped)
+    int getDroppedHits() const { return droppedHits_; }
     float getOcclusionRatio() const;
+    // CPU time spent waiting on and copying out results since the last compute()
+    double getReadbackMs() const { return readbackNs_ * 1.0e-6; }
+    // Per-ray results cover one tile (at most kRayTileSize rays, a uniform subsample
+    // of the beam); getHitCount() always covers every traced ray.
     const std::vector<HitResult>& getHitResults() const { return hitResults_; }
-    void readHitBuffer();  // Read hit results from GPU to CPU
+    void readHitBuffer();  // Read hit results from GPU to CPU (waits for the latest dispatch)
 
-    // Shadow map for beam visualization
+    // Newest hit results whose GPU work has finished - frame N-1 in async mode.
+    // Never blocks; returns the previous copy (or empty) if nothing new has completed.
+    const std::vector<HitResult>& getLatestCompletedResults();
+
+    // Per-ray readback payload. Compact formats halve the bytes per ray; hits-only
+    // also drops misses. getLatestCompletedResults() decodes any of them into HitResult
+    // (hits-only returns hits in completion order, and None returns nothing).
+    void setHitPayload(HitPayload payload);
+    HitPayload getHitPayload() const { return hitPayload_; }
+
+    // HitPayload::Columns readback as separate contiguous arrays (frame N-1 in
+    // async mode), so CPU consumers stream only the fields they read. The view
+    // stays valid until the next call; count is 0 for other payloads.
+    HitColumns getLatestHitColumns();
+
+    // GPU binning - accumulates every traced ray (all tiles) on the GPU, so the
+    // polar plot and heat map no longer need the per-ray hit buffer. Set before compute().
+    void setPolarBinning(bool enabled, const BinningSlice& slice);
+    void setHeatMapBinning(bool enabled, const BinningSlice& slice);
+
+    // Newest finished polar bins (kPolarPlotBins entries, frame N-1 in async mode).
+    // Empty until a binned frame completes. Only ~6 KB is copied per frame.
+    const std::vector<PolarBin>& getLatestPolarBins();
+
+    // Full-sphere binning - every hit lands in one kSphereTableAzBins x
+    // kSphereTableElBins cell by reflection direction, whatever the polar cut,
+    // so SphereRCSTable can extract any cut without a retrace. Cells are
+    // elevation-major and use the PolarBin layout. Frame N-1 in async mode.
+    void setSphereBinning(bool enabled);
+    bool isSphereBinning() const { return sphereBinning_; }
+    const std::vector<PolarBin>& getLatestSphereBins();
+    // compute() frame the newest sphere bins came from (0 = none yet)
+    uint64_t getSphereBinsFrame() const { return copiedSphereFrame_; }
+
+    // Bistatic receivers (none by default). The single transmitter is the
+    // radar position; every receiver collects, in one PolarBin, the hits whose
+    // exit direction lies within kReceiverAcceptanceDegrees of the direction
+    // from the origin to its site. The binning pass tests each hit against
+    // all receivers, four per vector compare, so receivers add no trace cost.
+    // At most kMaxReceivers; bins follow positions' order, frame N-1 in async mode.
+    void setReceivers(const std::vector<QVector3D>& positions);
+    int getReceiverCount() const { return static_cast<int>(receivers_.size()); }
+    const std::vector<PolarBin>& getLatestReceiverBins();
+    uint64_t getReceiverBinsFrame() const { return copiedReceiverFrame_; }
+
+    // Physical-optics frequency sweep (off by default). Every hit in the polar
+    // slice adds a complex field sqrt(intensity) * exp(-i k L), L being its path
+    // length, into one bin per polar angle and frequency. All sweep.points
+    // frequencies come from the same trace in one extra pass per tile, and
+    // accumulate across tiles and progressive batches like the polar bins.
+    void setFrequencySweep(bool enabled, const FrequencySweep& sweep = FrequencySweep());
+    bool isFrequencySweep() const { return frequencySweep_; }
+    const FrequencySweep& getFrequencySweep() const { return sweep_; }
+
+    // Newest finished field bins, kPolarPlotBins x sweep.points with frequency
+    // the fastest index (frame N-1 in async mode). Decode with
+    // FrequencyBin::field(kFieldBinScale). Empty until a swept frame completes.
+    const std::vector<FrequencyBin>& getLatestFrequencyBins();
+
+    // Reflection lobe clustering on the GPU - spatial hash over every traced hit,
+    // read back as at most kLobeClusterMaxOutput clusters (frame N-1 in async mode)
+    void setLobeClustering(bool enabled);
+    const std::vector<ReflectionCluster>& getLatestLobeClusters();
+
+    // Per-vertex heat map intensities (HeatMapRenderer sphere mesh order) written on
+    // the GPU by the current frame - bind as a vertex attribute, no readback needed.
+    GLuint getHeatMapIntensityBuffer() const { return heatMapBinning_ ? heatMapIntensityBuffer_ : 0; }
+    // Blocking copy of the same intensities (~17 KB), for RCSResultCache
+    // snapshots of a settled trace. Empty while heat map binning is off.
+    void readHeatMapIntensities(std::vector<float>& intensities);
+
+    // Async readback (default): hit/counter SSBOs are a fence-synchronized ring of
+    // persistent-mapped slots, so compute() never waits on the GPU.
+    // Disabled: compute() waits on its own fence, matching the old blocking behavior.
+    void setAsyncReadback(bool enabled) { asyncReadback_ = enabled; }
+    bool isAsyncReadback() const { return asyncReadback_; }
+
+    // Progressive refinement (off by default). The first compute() after any input
+    // change traces a kProgressivePreviewRays preview; each further compute() adds
+    // a batch (doubling, up to kProgressiveMaxBatchRays) into the same counter,
+    // bins, lobe table and shadow map until all numRays (times the jitter passes)
+    // are in. Rays are taken in
+    // a rank-1 lattice permutation of the ring layout, so every prefix is a
+    // stratified subset and the finished result matches a full trace. Per-ray
+    // payloads hold the newest batch only.
+    void setProgressive(bool enabled);
+    bool isProgressive() const { return progressive_; }
+    void restartProgressive() { progressiveRays_ = 0; }
+    bool isRefining() const { return progressive_ && progressiveRays_ < progressiveTarget(); }
+    int getAccumulatedRays() const { return progressive_ ? progressiveRays_ : numRays_; }
+    // A dispatched frame has not been retired yet (its results are still to come)
+    bool hasPendingResults();
+
+    // Ray placement on the beam cone (Rings by default). Fibonacci and Sobol are
+    // area-uniform low-discrepancy patterns and need fewer rays for the same RCS
+    // error. Jitter applies a Cranley-Patterson rotation: a new one every frame,
+    // or in progressive mode kSampleJitterPasses rotated passes accumulated on
+    // top of each other. Batched looks (computeLooks) are never jittered.
+    void setRaySampling(RaySampling sampling);
+    RaySampling getRaySampling() const { return raySampling_; }
+    void setSampleJitter(bool enabled);
+    bool isSampleJitter() const { return sampleJitter_; }
+
+    // Target-bounds focus (off by default). When the scene's bounding sphere
+    // subtends less than the beam, the rays cover its bounding cone instead of
+    // the whole beam; rays of that cone outside the beam are traced as misses.
+    // Every ray's solid-angle share (HitResult::rcsContribution) shrinks to
+    // match, so estimates stay unbiased with far fewer wasted rays. Batched
+    // looks always cover the full beam.
+    void setBoundsFocus(bool enabled);
+    bool isBoundsFocus() const { return boundsFocus_; }
+    bool isRayFocusActive() const { return focusHalfAngle_ > 0.0f; }
+    float raySolidAngle() const;  // Steradians per primary ray of the current compute()
+
+    // Antenna pattern weights. gain holds offAxisBins rows of azimuthBins
+    // one-way power gains (1 = boresight) over the traced cone: row r at
+    // (r + 0.5) / offAxisBins of the half-angle off axis, column c at
+    // (c + 0.5) / azimuthBins of a turn around it (RadarBeam::bakeGainPattern).
+    // Ray generation samples it per ray and each hit's intensity, and its
+    // bounce path, is weighted by the two-way gain. Without a pattern every
+    // ray weighs 1. The context must be current.
+    void setBeamPattern(const std::vector<float>& gain, int azimuthBins, int offAxisBins);
+    void clearBeamPattern();
+    bool hasBeamPattern() const { return beamPatternTexture_ != 0; }
+
+    // Optional stage timing - compute(), uploadBVH() and readback are wrapped in
+    // profiler stages. Not owned; pass nullptr to detach.
+    void setProfiler(RS::FrameProfiler* profiler) { profiler_ = profiler; }
+
+    // Shadow map for beam visualization. By default the trace kernel writes it
+    // from the RCS rays, one texel per ray (kRaysPerRing x rings). A positive
+    // footprint in pixels decouples it from the ray count: a separate
+    // occlusion-only pass traces its own ring grid, sized from the beam
+    // footprint's extent on screen, and reruns only when the radar, beam or
+    // target changes. 0 goes back to the RCS rays.
+    void setShadowResolution(int footprintPixels);
+    bool isShadowDecoupled() const { return shadowFootprintPixels_ > 0; }
+    void updateShadowMap();  // Decoupled pass if anything changed; compute() calls it too
     GLuint getShadowMapTexture() const { return shadowMapTexture_; }
     bool hasShadowMap() const { return shadowMapTexture_ != 0 && shadowMapReady_; }
-    int getShadowMapResolution() const { return shadowMapResolution_; }
+    int getShadowMapResolution() const { return shadowMapResolution_; }  // Texels per ring
+    int getShadowMapRings() const { return shadowMapRings_; }            // Texture rows
     float getBeamWidthRadians() const;
 
+    // BVH state
+    bool isBVHBuildPending() const;  // Any mesh still waiting for the BVH worker (GPU builds run before the next trace)
+    int getBVHNodeCount() const;     // Bottom-level nodes over all unique meshes
+    int getTLASNodeCount() const { return tlasNodeCount_; }
+
+    // Trace kernel variant. Trees deeper than kBVHStackSize always take the
+    // stackless kernel, whatever the mode.
+    void setTraversalMode(TraversalMode mode) { traversalMode_ = mode; }
+    TraversalMode getTraversalMode() const { return traversalMode_; }
+    bool isStacklessTraversalActive() const;
+
+    // Bottom-level node layout. Wide4 uploads the four-wide quantized tree in
+    // place of the binary one; it falls back to Binary (with a warning) for
+    // meshes the wide encoding or the wide kernel's stack cannot hold.
+    void setBVHLayout(BVHLayout layout);
+    BVHLayout getBVHLayout() const { return bvhLayout_; }
+    bool isWideBVHActive() const { return wideBvhActive_; }
+
+    // Triangle storage. Compact halves the triangle buffer (24 instead of 48
+    // bytes) by storing vertices as 16-bit offsets within their leaf box; with
+    // the Wide4 layout nodes shrink to 16 bytes per child as well. The CPU
+    // debug tracers keep the full-precision triangles.
+    void setTrianglePrecision(TrianglePrecision precision);
+    TrianglePrecision getTrianglePrecision() const { return trianglePrecision_; }
+    size_t getGeometryBytes() const { return geometryBytes_; }  // Resident BLAS nodes, skip links and triangles
+
+    // Normal-cone culling. The binary-layout kernels skip every subtree whose
+    // normal cone (BVHBuilder::getNormalCones) faces wholly away from the ray.
+    // Only valid for closed meshes traced from outside, where the closest hit
+    // is always a front face; open surfaces would lose their back faces'
+    // occlusion. Adds 16 bytes per node. The Wide4 layout keeps tracing
+    // without it, and GPU-built meshes have no cones to cull by.
+    void setNormalConeCulling(bool enabled);
+    bool isNormalConeCulling() const { return normalConeCulling_; }
+
+    // Temporal reuse while the radar moves by small angles. Each primary ray
+    // first tests the BVH leaf it hit last frame, so traversal starts with a
+    // tight tmax; hits stay exact, a miss just traverses in full. The
+    // binary-layout kernels keep one seed per ray (8 bytes). A frame that
+    // starts over within kTemporalMaxAngleDegrees of the last, with nothing
+    // else changed, also blends the previous polar, sphere and heat-map bins
+    // in at up to kTemporalHistoryWeight, fading with the angle. Batched
+    // looks (computeLooks) use the seeds, so a sweep's neighbouring looks
+    // start from each other's leaves, but never blend bins.
+    void setTemporalReuse(bool enabled);
+    bool isTemporalReuse() const { return temporalReuse_; }
+    float getHistoryWeight() const { return historyWeight_; }  // Applied by the last compute()
+
+    // Crease-edge diffraction (off by default). A mesh's wedges
+    // (buildDiffractionEdges) are uploaded once; each frame that starts an
+    // accumulation, and each computeLooks() batch, then runs one pass over the
+    // edges of every instance that adds their monostatic returns to the polar,
+    // sphere and heat-map bins, binned like hits reflecting back at the radar.
+    // The cost is O(edges), whatever the ray count. Edges are culled by the
+    // beam and by which side of the wedge the radar is on, not tested for
+    // occlusion. waveNumber is 2 pi f / c in radians per scene unit.
+    void setMeshEdges(uint32_t meshId, std::vector<DiffractionEdge> edges);
+    void setEdgeDiffraction(bool enabled, float waveNumber);
+    bool isEdgeDiffraction() const { return edgeDiffraction_; }
+    int getEdgeCount() const { return edgeCount_; }  // Uploaded wedges, all meshes
+
+    // Per-triangle hotspots (off by default). The primary pass adds each hit's
+    // return, in fixed point (kHotspotIntensityScale), to its triangle's sum in a
+    // GPU buffer the target wireframe reads as-is - nothing is read back. Sums
+    // restart with each accumulation and cover every instance of a mesh
+    // together. Word 0 is the largest sum so far, for normalizing; a mesh's
+    // triangles follow from 1 + getMeshHotspotOffset() in index-buffer order.
+    // Full-precision triangles only: the compact layout has no room for the
+    // source index, so getHotspotBuffer() stays 0 while it is active.
+    void setTriangleHotspots(bool enabled);
+    bool isTriangleHotspots() const { return triangleHotspots_; }
+    GLuint getHotspotBuffer() const { return isHotspotsActive() ? hotspotBuffer_ : 0; }  // Shared buffer
+    int getMeshHotspotOffset(uint32_t meshId) const;  // -1 if the mesh is not resident
+
+    // Ray reordering. Sorts each tile's primary rays by direction, and every
+    // bounce pass's queued rays by origin cell and direction, before tracing
+    // them, so neighbouring invocations walk the same nodes; hits, payloads and
+    // shadow texels still land at each ray's own index. Off by default: the
+    // sort adds a key pass and four to eight radix passes per trace pass, which
+    // mostly pays off for bounce queues, filled in atomic append order.
+    void setRayReordering(bool enabled) { rayReordering_ = enabled; }
+    bool isRayReordering() const { return rayReordering_; }
+
+    // Persistent threads. The trace kernels launch only enough groups to fill
+    // the GPU (getPersistentGroups), and every lane pulls rays from a shared
+    // counter until the pass runs dry, so groups of cheap misses do not idle
+    // beside deep traversals. Off by default; it mostly helps beams mixing
+    // hits and misses and the uneven bounce queues.
+    void setPersistentThreads(bool enabled) { persistentThreads_ = enabled; }
+    bool isPersistentThreads() const { return persistentThreads_; }
+    int getPersistentGroups() const { return persistentGroups_; }
+
     // Debug
     void setNumRays(int numRays);
     int getNumRays() const { return numRays_; }
-    int getNumRings() const { return (numRays_ + 63) / 64; }  // 64 rays per ring
+    int getNumRings() const { return (numRays_ + RS::Constants::kRaysPerRing - 1) / RS::Constants::kRaysPerRing; }
+    int getTileCapacity() const { return std::min(numRays_, RS::Constants::kRayTileSize); }
+    int getSlotHitCapacity() const;  // Payload entries one readback slot holds for the current payload
+
+signals:
+    void bvhBuildRequested(RCS::BVHBuildRequestPtr request);
+    void bvhMeshReleased(uint32_t meshId);
+    void bvhUpdated();  // A new BVH is ready to upload - trigger a repaint
+
+private slots:
+    void onBVHReady(RCS::BVHSnapshotPtr snapshot);
 
 private:
     bool initialized_ = false;
@@ -71,22 +421,226 @@ private:
     GLuint rayBuffer_ = 0;       // SSBO for rays
     GLuint bvhBuffer_ = 0;       // SSBO for BVH nodes
     GLuint triangleBuffer_ = 0;  // SSBO for triangles
-    GLuint hitBuffer_ = 0;       // SSBO for hit results
-    GLuint counterBuffer_ = 0;   // Atomic counter for hit count
+
+    // Hit result + hit counter SSBOs, one pair per readback slot.
+    // compute() writes slot writeSlot_ while the CPU reads the newest signaled slot.
+    struct ReadbackSlot {
+        GLuint hitBuffer = 0;                  // SSBO for the per-ray payload
+        GLuint counterBuffer = 0;              // Atomic counter for hit count (device-local)
+        GLuint counterReadback = 0;            // Mapped copy of the counter, taken when tracing ends
+        GLsync counterFence = nullptr;         // Signaled once counterReadback holds the count
+        GLuint polarBinBuffer = 0;             // GPU-binned polar plot accumulation
+        const void* mappedHits = nullptr;      // Persistent coherent mapping (HitResult or CompactHit)
+        const GLuint* mappedCounter = nullptr; // counterReadback's persistent mapping
+        GLuint clusterBuffer = 0;              // Lobe cluster count + ReflectionCluster array
+        GLuint frequencyBinBuffer = 0;         // Complex field bins, created on the first sweep
+        GLuint sphereBinBuffer = 0;            // Full-sphere cells, created on first use
+        const PolarBin* mappedSphereBins = nullptr;
+        bool sphereBinned = false;             // Sphere cells were written this frame
+        GLuint receiverBinBuffer = 0;          // kMaxReceivers bistatic bins, created on first use
+        const PolarBin* mappedReceiverBins = nullptr;
+        bool receiversBinned = false;          // Receiver bins were written this frame
+        const FrequencyBin* mappedFrequencyBins = nullptr;
+        int frequencyPoints = 0;               // Frequencies binned this frame (0 = none)
+        const PolarBin* mappedPolarBins = nullptr;
+        const void* mappedClusters = nullptr;
+        bool polarBinned = false;              // Polar bins were written this frame
+        bool lobeClustered = false;            // Lobe clusters were written this frame
+        GLsync fence = nullptr;                // Signaled when the slot's dispatch finishes
+        uint64_t frameIndex = 0;               // compute() call that filled this slot
+        float historyWeight = 0.0f;            // Share of the previous bins kept on copy-out
+        int numRays = 0;                       // Ray count the slot was traced with
+        int capacity = 0;                      // Payload entries the hit buffer holds
+        int accumulatedRays = 0;               // Rays the hit counter covers
+        HitPayload payload = HitPayload::Full; // Format written this frame
+        QVector3D radarPosition;               // Ray origin, to recover hits-only distances
+    };
+    std::array<ReadbackSlot, RS::Constants::kReadbackSlotCount> readbackSlots_;
+    int writeSlot_ = 0;
+    int latestSlot_ = -1;          // Newest slot whose fence has signaled (-1 = none)
+    int latestCountSlot_ = -1;     // Newest slot whose counter fence has signaled (-1 = none)
+    uint64_t frameCounter_ = 0;
+    uint64_t copiedFrame_ = 0;     // Slot frameIndex currently held in hitResults_
+    std::vector<float> hitColumns_;  // kHitColumnCount packed columns
+    size_t columnCount_ = 0;         // Entries per column in hitColumns_
+    uint64_t copiedColumnsFrame_ = 0;
+    bool asyncReadback_ = true;
+    int completedRays_ = 0;        // accumulatedRays of the slot hitCount_ came from
+    qint64 readbackNs_ = 0;        // Readback wait and copy time since compute() began
+    RS::FrameProfiler* profiler_ = nullptr;
+    HitPayload hitPayload_ = HitPayload::Full;
+    GLsizeiptr slotHitStride_ = 0;  // Bytes per entry the readback hit buffers were created with
+
+    // Full hit results for the tile being traced - stays on the GPU and feeds
+    // binning, the shadow map and the readback payload
+    GLuint tileHitBuffer_ = 0;
+
+    // Batched look buffers, created on the first computeLooks()
+    GLuint lookBuffer_ = 0;          // kMaxLooksPerDispatch look parameters
+    GLuint lookRayBuffer_ = 0;       // kRayTileSize rays shared by all looks
+    GLuint lookHitBuffer_ = 0;       // kRayTileSize hit results
+    GLuint lookCounterBuffer_ = 0;   // One hit counter per look
+    GLuint lookPolarBinBuffer_ = 0;  // kPolarPlotBins bins per look
 
     // Shadow map for beam visualization
     GLuint shadowMapTexture_ = 0;
     int shadowMapResolution_ = 128;
+    int shadowMapRings_ = 0;       // Texture rows currently allocated
     bool shadowMapReady_ = false;  // Set true after first compute() completes
+    int shadowFootprintPixels_ = 0;  // > 0 = decoupled shadow pass at this footprint size
+    bool shadowDirty_ = true;        // Radar, beam or target moved since the decoupled pass
+    bool hasClearTexImage_ = false;        // GL 4.4 / ARB_clear_texture available
+
+    // Beam gain table sampled by ray generation (setBeamPattern), 0 = uniform
+    GLuint beamPatternTexture_ = 0;
+    static constexpr int kBeamPatternTextureUnit = 1;
+    std::vector<float> shadowClearData_;   // Fallback clear source, sized to the texture
 
     // Compute shaders
     std::unique_ptr<QOpenGLShaderProgram> rayGenShader_;
-    std::unique_ptr<QOpenGLShaderProgram> traceShader_;
-    std::unique_ptr<QOpenGLShaderProgram> shadowMapShader_;
+    // Trace kernel variants by traceVariantKey(), built on first use. Each is
+    // traceShaderSource with its features as #defines; null = failed to build.
+    static constexpr uint32_t kTraceStackless = 1u << 0;         // STACKLESS_TRAVERSAL
+    static constexpr uint32_t kTraceWideBVH = 1u << 1;           // WIDE_BVH
+    static constexpr uint32_t kTraceCompactTriangles = 1u << 2;  // COMPACT_TRIANGLES
+    static constexpr uint32_t kTraceMultiBounce = 1u << 3;       // MULTI_BOUNCE (bounce queue)
+    static constexpr uint32_t kTraceShadowVisibility = 1u << 4;  // SHADOW_VISIBILITY (decoupled shadow pass)
+    static constexpr uint32_t kTracePersistent = 1u << 5;        // PERSISTENT_THREADS
+    static constexpr uint32_t kTraceNormalCones = 1u << 6;       // NORMAL_CONE_CULLING
+    static constexpr uint32_t kTraceTemporalReuse = 1u << 7;     // TEMPORAL_REUSE
+    static constexpr uint32_t kTraceHotspots = 1u << 8;          // TRIANGLE_HOTSPOTS
+    static constexpr int kTracePayloadShift = 9;                 // HIT_PAYLOAD value above the flags
+    std::map<uint32_t, std::unique_ptr<QOpenGLShaderProgram>> tracePrograms_;
+    std::unique_ptr<QOpenGLShaderProgram> binningShader_;
+    std::unique_ptr<QOpenGLShaderProgram> frequencyBinningShader_;  // Same source, FREQUENCY_BINNING
+    std::unique_ptr<QOpenGLShaderProgram> edgeBinningShader_;       // Same source, EDGE_DIFFRACTION
+    std::unique_ptr<QOpenGLShaderProgram> heatMapResolveShader_;
+    std::unique_ptr<QOpenGLShaderProgram> lobeClusterShader_;
+    std::unique_ptr<QOpenGLShaderProgram> lobeClusterCollectShader_;
+
+    // GPU lobe clustering state
+    bool lobeClustering_ = false;
+    GLuint lobeClusterTable_ = 0;                  // kLobeClusterTableSize hash slots (GPU only)
+    std::vector<ReflectionCluster> lobeClusters_;  // CPU-side copy of the newest clusters
+    uint64_t copiedClusterFrame_ = 0;
+
+    // GPU binning state
+    bool polarBinning_ = false;
+    bool heatMapBinning_ = false;
+    BinningSlice polarSlice_;
+    BinningSlice heatMapSlice_;
+    GLuint heatMapBinBuffer_ = 0;        // kHeatMapLatBins x kHeatMapLonBins x (lo, hi, count)
+    GLuint heatMapIntensityBuffer_ = 0;  // One float per heat map sphere vertex
+    std::vector<PolarBin> polarBins_;    // CPU-side copy of the newest polar bins
+    uint64_t copiedPolarFrame_ = 0;
+
+    // Full-sphere binning state
+    bool sphereBinning_ = false;
+    std::vector<PolarBin> sphereBins_;   // CPU-side copy of the newest sphere cells
+    uint64_t copiedSphereFrame_ = 0;
+
+    // Material table
+    std::vector<Material> materials_;
+    GLuint materialBuffer_ = 0;
+    bool materialsDirty_ = true;  // Upload on first bind
+
+    // Bistatic receiver state
+    std::vector<QVector3D> receivers_;    // Unit directions from the origin
+    std::vector<PolarBin> receiverBins_;  // CPU-side copy of the newest receiver bins
+    uint64_t copiedReceiverFrame_ = 0;
+
+    // Frequency sweep state
+    bool frequencySweep_ = false;
+    FrequencySweep sweep_;
+    std::vector<FrequencyBin> frequencyBins_;  // CPU-side copy of the newest field bins
+    uint64_t copiedFrequencyFrame_ = 0;
+
+    // Bottom level - one object-space BVH per unique mesh. bvh is what the GPU and
+    // CPU debug tracers use; pendingBvh is a finished background build waiting for
+    // uploadBVH(). Every mesh is packed into bvhBuffer_/triangleBuffer_.
+    struct MeshState {
+        BVHSnapshotPtr bvh;
+        BVHSnapshotPtr pendingBvh;
+        uint64_t geometryVersion = 0;  // Most recently requested mesh
+        bool buildPending = false;
+        int nodeOffset = 0;            // Placement in the shared buffers
+        int triangleOffset = 0;
+        bool resident = false;         // Packed; over budget only instanced meshes are
+        std::vector<DiffractionEdge> edges;  // setMeshEdges(), kept for repacks
+        int edgeOffset = 0;                  // Placement in edgeBuffer_
 
-    // BVH
-    BVHBuilder bvhBuilder_;
-    bool bvhDirty_ = true;
+        // setMeshGPUGeometry(): built by GPUBVHBuilder from the caller's buffers
+        struct GPUSource {
+            GLuint vertexBuffer = 0;
+            GLuint indexBuffer = 0;
+            int triangleCount = 0;
+            bool buildPending = false;     // Build in the next uploadBVH()
+            GLuint statsBuffer = 0;        // Root bounds and depth, persistently mapped
+            const void* mappedStats = nullptr;
+            GLsync statsFence = nullptr;   // Signaled once the last build's stats are readable
+            AABB bounds;                   // Object space, empty until known
+            int maxDepth = -1;             // -1 = not known yet
+        } gpu;
+        bool gpuBuilt() const { return gpu.triangleCount > 0; }
+        bool hasTree() const { return bvh || gpuBuilt(); }
+    };
+    std::map<uint32_t, MeshState> meshes_;
+    bool bvhDirty_ = false;         // A finished build or removed mesh awaits uploadBVH()
+    bool blasLayoutDirty_ = false;  // Mesh offsets must be recomputed (full repack)
+    GLuint skipBuffer_ = 0;         // SSBO for per-node skip links, same layout as bvhBuffer_
+    GPUBVHBuilder gpuBvhBuilder_;
+    bool gpuBvhBuilderFailed_ = false;  // Kernels did not compile; GPU meshes stay untraced
+    std::vector<std::pair<GLuint, GLsync>> retiredGPUStats_;  // Freed with the context current
+    // Node and triangle counts in the active layout
+    size_t meshNodeCount(const MeshState& mesh) const;
+    size_t meshTriangleCount(const MeshState& mesh) const;
+    void retireGPUSource(MeshState& mesh);
+    void pollGPUBVHBuilds();
+    void buildMeshOnGPU(MeshState& mesh);
+    TraversalMode traversalMode_ = TraversalMode::Stack;
+    BVHLayout bvhLayout_ = BVHLayout::Binary;
+    bool wideBvhActive_ = false;    // bvhBuffer_ holds WideBVHNodes
+    bool normalConeCulling_ = false;
+    bool normalConesActive_ = false;  // normalConeBuffer_ is resident: culling on, binary layout
+    GLuint normalConeBuffer_ = 0;     // vec4 per node, same layout as bvhBuffer_
+    TrianglePrecision trianglePrecision_ = TrianglePrecision::Full;
+    bool compactTrianglesActive_ = false;          // triangleBuffer_ holds CompactTriangles
+    std::vector<CompactTriangle> compactScratch_;  // One mesh's encoding, reused across uploads
+    size_t geometryBytes_ = 0;
+    bool bvhExceedsStack_ = false;  // Some mesh is deeper than the shader stack
+
+    // Buffer and texture sizes reported to RS::GPUMemory, measured again by
+    // accountMemory() after any allocation changed
+    void accountMemory();
+    RS::GPUAllocation rayMemory_{RS::GPUMemoryPool::RCSRays};
+    RS::GPUAllocation sceneMemory_{RS::GPUMemoryPool::RCSScene};
+    RS::GPUAllocation resultMemory_{RS::GPUMemoryPool::RCSResults};
+    RS::GPUAllocation textureMemory_{RS::GPUMemoryPool::RCSTextures};
+    bool memoryDirty_ = true;
+
+    // Top level - instances and the BVH over their world bounds
+    struct InstanceState {
+        uint32_t meshId = 0;
+        QMatrix4x4 modelMatrix;
+        QMatrix4x4 invModelMatrix;   // Rays are mapped into object space for traversal
+        QMatrix4x4 normalTransform;  // transpose(inverse) for normals
+    };
+    std::vector<InstanceState> instanceStates_;
+    TLASBuilder tlasBuilder_;
+    GLuint tlasBuffer_ = 0;      // SSBO for top-level nodes
+    GLuint instanceBuffer_ = 0;  // SSBO for InstanceData, in TLAS leaf order
+    int tlasNodeCount_ = 0;
+    bool tlasDirty_ = false;
+
+    // Analytic primitives
+    std::vector<ScenePrimitive> primitives_;
+    GLuint primitiveBuffer_ = 0;  // SSBO for PrimitiveData
+    bool primitivesDirty_ = true;  // Upload on first bind
+    void uploadPrimitives();
+
+    // Background BVH build thread
+    QThread bvhThread_;
+    BVHWorker* bvhWorker_ = nullptr;  // Owned by bvhThread_ (deleted on finish)
 
     // Configuration
 
@@ -96,20 +650,157 @@ private:
     float sphereRadius_ = 100.0f;
     int numRays_ = 10000;
 
+    // Progressive refinement state
+    bool progressive_ = false;
+    int progressiveRays_ = 0;  // Rays (in progressive order) accumulated so far
+    int frameRayBegin_ = 0;    // First progressive index traced by the current compute()
+    uint32_t rayOrderStride() const;  // Lattice generator, 1 = identity order
+    int progressiveTarget() const { return sampleJitter_ ? numRays_ * RS::Constants::kSampleJitterPasses : numRays_; }
+
+    // Multi-bounce wavefront
+    int maxBounces_ = 1;
+    QByteArray bounceEffectChain_;        // BOUNCE_EFFECT_CHAIN of the trace kernels
+    std::vector<QVector4D> effectParams_;  // One per chain entry
+    float bounceCutoff_ = RS::Constants::kBounceCutoffIntensity;
+    float rouletteThreshold_ = RS::Constants::kBounceRouletteThreshold;
+    bool traceProgramsStale_ = false;     // Chain changed; rebuild the kernels on next use
+    GLuint bounceQueueBuffer_ = 0;  // Per-pass indirect args, then two kRayTileSize halves of queued rays
+
+    // Ray reordering (rayKeyShaderSource, then raySort_ into the kernels' RayOrder)
+    bool rayReordering_ = false;
+    bool rayReorderFailed_ = false;  // Kernels unavailable; rays trace in generation order
+    GPURadixSort raySort_{RS::GPUMemoryPool::RCSRays};
+    std::unique_ptr<QOpenGLShaderProgram> rayKeyShader_;
+    static constexpr int kPrimaryRayKeyBits = 16;  // Direction only
+    static constexpr int kBounceRayKeyBits = 32;   // Origin cell and direction; unused entries all ones
+    // Sorts count primary rays of rayBuffer (bouncePass 0) or the queue of a
+    // bounce pass. True if the order is in raySort_.valueBuffer(); takes over
+    // storage bindings 0-4 and the current program.
+    bool sortRays(GLuint rayBuffer, int count, int bouncePass);
+
+    // Persistent threads
+    bool persistentThreads_ = false;
+    int persistentGroups_ = RS::Constants::kPersistentTraceGroups;  // From the SM count in initialize()
+    GLuint workCounterBuffer_ = 0;  // kMaxLooksPerDispatch primary counters, then one per bounce pass
+    GLuint traceGroups(int rays) const;  // Primary dispatch width, capped when persistent
+    void bindWorkCounters(QOpenGLShaderProgram* trace);  // Program bound; zeroes the counters
+
+    // Temporal reuse
+    struct TemporalState {  // What the history bins were traced with
+        QVector3D radarPosition;
+        uint64_t sceneRevision = 0;
+        int numRays = 0;
+        float beamWidthDegrees = 0.0f;
+        int maxBounces = 0;
+        bool polarBinning = false;
+        bool heatMapBinning = false;
+        bool sphereBinning = false;
+        BinningSlice polarSlice;
+        BinningSlice heatMapSlice;
+    };
+    bool temporalReuse_ = false;
+    GLuint seedBuffer_ = 0;          // uvec2 per primary ray ID: instance, leaf node; all ones = none
+    int seedCapacity_ = 0;
+    float historyWeight_ = 0.0f;
+    bool historyValid_ = false;
+    TemporalState historyState_;
+    uint64_t sceneRevision_ = 0;     // Bumped by every geometry, instance or material upload
+    // Program bound; enabled = this dispatch may read and write seeds
+    void bindTemporalSeeds(QOpenGLShaderProgram* trace, bool enabled);
+    bool reserveTemporalSeeds(int rays);
+    void updateHistoryWeight(bool accumulate);  // Start of compute(), before the slot is filled
+
+    // Triangle hotspots
+    bool triangleHotspots_ = false;
+    GLuint hotspotBuffer_ = 0;  // uint max, then one uint per packed triangle (MeshState::triangleOffset)
+    size_t hotspotCapacity_ = 0;  // Triangles
+    bool isHotspotsActive() const { return triangleHotspots_ && !compactTrianglesActive_; }
+    void clearHotspots();  // Start of an accumulation; sized to the packed triangles
+    // Program bound; enabled = this dispatch adds its primary hits
+    void bindHotspots(QOpenGLShaderProgram* trace, bool enabled);
+
+    // Ray sampling pattern
+    RaySampling raySampling_ = RaySampling::Rings;
+    bool sampleJitter_ = false;
+    float sampleRotation_[2] = {0.0f, 0.0f};  // Cranley-Patterson offset of the current compute()
+    bool shadowByDirection() const {  // Off the beam's ring grid
+        return raySampling_ != RaySampling::Rings || sampleJitter_ || isRayFocusActive();
+    }
+
+    // Target-bounds focus, refreshed by compute() once the TLAS is current
+    bool boundsFocus_ = false;
+    AABB sceneBounds_;              // World bounds of the traced instances
+    QVector3D focusDirection_;
+    float focusHalfAngle_ = 0.0f;   // 0 = rays cover the whole beam
+    void updateRayFocus();
+
     // Results
     int hitCount_ = 0;
+    int droppedHits_ = 0;
     std::vector<HitResult> hitResults_;  // CPU-side copy of hit buffer
-    std::vector<HitResult> hitClearBuffer_;  // Pre-allocated buffer for clearing
 
     // Shader source
     bool compileShaders();
     void createBuffers();
+    void shadowGridSize(int& width, int& rings) const;
+    void createShadowMap();
     void uploadBVH();
-    void dispatchRayGeneration();
-    void dispatchTracing();
-    void dispatchShadowMapGeneration();
+    void uploadTLAS();
+    uint32_t traceVariantKey(HitPayload payload) const;
+    QOpenGLShaderProgram* traceProgram(HitPayload payload, bool shadowVisibility = false);
+    void bindScene(QOpenGLShaderProgram* program);  // Also the material table and effect parameters
+    void uploadMaterials();
+    void dispatchRayGeneration(int rayOffset, int tileRays);
+    void bindBeamPattern();
+    void unbindBeamPattern();
+    void dispatchTracing(int rayOffset, int tileRays);
+    void bindBounceQueue(QOpenGLShaderProgram* trace);
+    void dispatchBounces(GLuint hitBuffer, GLuint compactBuffer, HitPayload payload);
+    void bindShadowMap(QOpenGLShaderProgram* trace);
+    void dispatchBinning(int tileRays);
+    void setBinningUniforms(QOpenGLShaderProgram* program);  // Program bound; the frame's slices and bins
+    void dispatchFrequencyBinning(int tileRays);
+
+    // Crease-edge diffraction
+    bool edgeDiffraction_ = false;
+    float edgeWaveNumber_ = static_cast<float>(RS::Constants::kTwoPi * RS::Constants::Defaults::kRadarFrequencyHz /
+                                               RS::Constants::kSpeedOfLight);
+    GLuint edgeBuffer_ = 0;   // DiffractionEdges of every mesh, at MeshState::edgeOffset
+    int edgeCount_ = 0;
+    bool edgesDirty_ = false;
+    void uploadEdges();
+    void dispatchEdgeDiffraction(int numLooks);  // 0 = the frame's slot, else the computeLooks() batch
+    void createFrequencyBuffers();
+    void createSphereBuffers();
+    void createReceiverBuffers();
+    void dispatchHeatMapResolve();
+    void createHeatMapBuffers();
+    void dispatchLobeClustering(int tileRays);
+    void dispatchLobeClusterCollect();
+    void createLookBuffers();
+    void dispatchLooks(int rayOffset, int tileRays, int numLooks);
     void clearShadowMap();
     void readResults();
+
+    // CPU closest hit over every instance (debug rays). Normal is world space, unflipped.
+    struct SceneHit {
+        float t = 0.0f;
+        int instance = -1;
+        int triangle = -1;
+        bool primitive = false;  // instance is then the primitive's targetId, triangle its index
+        QVector3D normal;
+    };
+    bool traceSceneCPU(const QVector3D& rayOrigin, const QVector3D& rayDir,
+                       float maxDist, float minT, SceneHit& sceneHit) const;
+    mutable std::vector<int> debugStack_;  // traceSceneCPU traversal scratch
+    // Multi-bounce path from origin along dir, one HitResult per bounce
+    std::vector<HitResult> tracePathCPU(const QVector3D& origin, const QVector3D& dir, int maxBounces) const;
+
+    // Readback ring helpers
+    void createReadbackSlots();
+    void destroyReadbackSlots();
+    void pollReadbackSlots();
+    bool waitForSlot(int slotIndex);
 };
 
 } // namespace RCS
@@ -0,0 +1,185 @@
+// RCSComputeThread.cpp - RCSCompute on a worker thread with a shared GL context
+#include "RCSComputeThread.h"
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOffscreenSurface>
+#include <QDebug>
+
+namespace RCS {
+
+RCSComputeThread::RCSComputeThread(QObject* parent)
+    : QObject(parent)
+{
+    thread_.setObjectName("RCSCompute");
+}
+
+RCSComputeThread::~RCSComputeThread() {
+    stop();
+}
+
+bool RCSComputeThread::start(QOpenGLContext* shareContext) {
+    if (compute_) {
+        return true;
+    }
+    if (!shareContext || !shareContext->isValid()) {
+        qWarning() << "RCSComputeThread::start - No display context to share with";
+        return false;
+    }
+
+    // Surface and context are created on the GUI thread; the context then
+    // moves to the worker, where it stays current for the thread's lifetime
+    surface_ = std::make_unique<QOffscreenSurface>();
+    surface_->setFormat(shareContext->format());
+    surface_->create();
+
+    context_ = std::make_unique<QOpenGLContext>();
+    context_->setFormat(shareContext->format());
+    context_->setShareContext(shareContext);
+    if (!surface_->isValid() || !context_->create() ||
+        !QOpenGLContext::areSharing(context_.get(), shareContext)) {
+        qCritical() << "RCSComputeThread: Failed to create a context shared with the display";
+        context_.reset();
+        surface_.reset();
+        return false;
+    }
+
+    worker_ = new QObject();
+    worker_->moveToThread(&thread_);
+    connect(&thread_, &QThread::finished, worker_, &QObject::deleteLater);
+    context_->moveToThread(&thread_);
+    thread_.start();
+
+    bool started = false;
+    QMetaObject::invokeMethod(worker_, [this, &started]() {
+        if (!context_->makeCurrent(surface_.get())) {
+            qCritical() << "RCSComputeThread: Failed to make the compute context current";
+            return;
+        }
+        auto compute = std::make_unique<RCSCompute>();
+        if (!compute->initialize()) {
+            qCritical() << "RCSComputeThread: RCSCompute initialization failed";
+            return;
+        }
+        connect(compute.get(), &RCSCompute::bvhUpdated, this, &RCSComputeThread::bvhUpdated);
+        compute_ = std::move(compute);
+        publish();
+        started = true;
+    }, Qt::BlockingQueuedConnection);
+
+    if (!started) {
+        stop();
+    }
+    return started;
+}
+
+void RCSComputeThread::stop() {
+    if (thread_.isRunning()) {
+        QMetaObject::invokeMethod(worker_, [this]() {
+            if (compute_) {
+                compute_->cleanup();
+                compute_.reset();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fence_ && QOpenGLContext::currentContext() == context_.get()) {
+                context_->extraFunctions()->glDeleteSync(fence_);
+            }
+            fence_ = nullptr;
+            status_ = RCSComputeStatus();
+            results_.reset();
+            tracePending_ = false;
+            context_->doneCurrent();
+            context_->moveToThread(thread());  // Back to the GUI thread for deletion
+        }, Qt::BlockingQueuedConnection);
+        thread_.quit();
+        thread_.wait();
+    }
+    worker_ = nullptr;  // Deleted with the thread's finish
+    context_.reset();
+    surface_.reset();
+}
+
+void RCSComputeThread::submit(Job job) {
+    if (!worker_) return;
+    QMetaObject::invokeMethod(worker_, [this, job = std::move(job)]() { runJob(job); }, Qt::QueuedConnection);
+}
+
+void RCSComputeThread::invoke(Job job) {
+    if (!worker_) return;
+    QMetaObject::invokeMethod(worker_, [this, &job]() { runJob(job); }, Qt::BlockingQueuedConnection);
+}
+
+void RCSComputeThread::submitTrace(TraceJob job) {
+    if (!worker_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tracePending_ = true;
+    }
+    QMetaObject::invokeMethod(worker_, [this, job = std::move(job)]() { runTrace(job); }, Qt::QueuedConnection);
+}
+
+bool RCSComputeThread::isTracePending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tracePending_;
+}
+
+std::shared_ptr<const RCSTraceResults> RCSComputeThread::takeResults() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::move(results_);
+}
+
+RCSComputeStatus RCSComputeThread::getStatus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return status_;
+}
+
+void RCSComputeThread::waitForGPU() {
+    QOpenGLContext* current = QOpenGLContext::currentContext();
+    if (!current) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fence_) {
+        current->extraFunctions()->glWaitSync(fence_, 0, GL_TIMEOUT_IGNORED);
+    }
+}
+
+void RCSComputeThread::runJob(const Job& job) {
+    if (!compute_) return;
+    job(*compute_);
+    publish();
+}
+
+void RCSComputeThread::runTrace(const TraceJob& job) {
+    auto results = std::make_shared<RCSTraceResults>();
+    if (compute_) {
+        job(*compute_, *results);
+        publish();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_ = std::move(results);
+        tracePending_ = false;
+    }
+    emit resultsReady();  // Queued: the receivers live on the GUI thread
+}
+
+void RCSComputeThread::publish() {
+    QOpenGLExtraFunctions* gl = context_->extraFunctions();
+    GLsync fence = gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl->glFlush();  // Other contexts only see a fence once it has been flushed
+
+    RCSComputeStatus status;
+    status.refining = compute_->isRefining();
+    status.pendingResults = compute_->hasPendingResults();
+    status.hasShadowMap = compute_->hasShadowMap();
+    status.shadowMapTexture = compute_->getShadowMapTexture();
+    status.shadowMapRings = compute_->getShadowMapRings();
+    status.beamWidthRadians = compute_->getBeamWidthRadians();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fence_) {
+        gl->glDeleteSync(fence_);  // Deferred by GL while a display wait still refers to it
+    }
+    fence_ = fence;
+    status_ = status;
+}
+
+} // namespace RCS
@@ -0,0 +1,118 @@
+// RCSComputeThread.h - RCSCompute on a worker thread with a shared GL context
+//
+// The trace, binning and readbacks run on their own QThread against an
+// offscreen context shared with the display context, so a heavy trace no
+// longer holds up the display's repaints. The GUI thread reaches the
+// RCSCompute only through jobs, run in submission order: submit() queues
+// one and returns, invoke() waits for it. submitTrace() queues a frame's
+// trace, which also copies out what the display needs into RCSTraceResults.
+// After every job the worker fences its GL work and refreshes the status;
+// before sampling a shared object it wrote (shadow map, heat map buffer) the
+// display thread calls waitForGPU(), which queues its commands behind that
+// fence without blocking the CPU.
+//
+#pragma once
+
+#include <QObject>
+#include <QThread>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "RCSCompute.h"
+
+class QOpenGLContext;
+class QOffscreenSurface;
+
+namespace RCS {
+
+// What a trace job copied out of RCSCompute for the display thread
+struct RCSTraceResults {
+    bool traced = false;         // compute() ran; otherwise the job only collected a finished frame
+    std::vector<PolarBin> polarBins;
+    std::vector<FrequencyBin> frequencyBins;
+    std::vector<PolarBin> sphereBins;
+    uint64_t sphereBinsFrame = 0;
+    std::vector<PolarBin> receiverBins;
+    uint64_t receiverBinsFrame = 0;
+    std::vector<ReflectionCluster> lobeClusters;
+    std::vector<HitResult> hits;  // getLatestCompletedResults(), when the job asked for it
+    GLuint heatMapIntensityBuffer = 0;  // Shared buffer - waitForGPU() before drawing from it
+    std::vector<float> heatMapIntensities;  // CPU copy, snapshot jobs and cached results only
+    GLuint hotspotBuffer = 0;    // Shared buffer - waitForGPU() before drawing from it
+    int hotspotOffset = -1;      // Target mesh's triangles in hotspotBuffer
+    bool snapshot = false;       // Full copy of a settled trace for RCSResultCache, not for display
+    uint64_t job = 0;            // Caller's tag for the job, echoed back
+    int hitCount = 0;
+    float occlusionRatio = 0.0f;
+    double computeMs = 0.0;      // Worker time in compute(), readback excluded
+    double readbackMs = 0.0;
+    bool asyncReadback = false;
+};
+
+// RCSCompute state the display thread polls every paint
+struct RCSComputeStatus {
+    bool refining = false;
+    bool pendingResults = false;
+    bool hasShadowMap = false;
+    GLuint shadowMapTexture = 0;  // Shared texture - waitForGPU() before sampling it
+    int shadowMapRings = 0;
+    float beamWidthRadians = 0.0f;
+};
+
+class RCSComputeThread : public QObject {
+    Q_OBJECT
+
+public:
+    using Job = std::function<void(RCSCompute&)>;
+    using TraceJob = std::function<void(RCSCompute&, RCSTraceResults&)>;
+
+    explicit RCSComputeThread(QObject* parent = nullptr);
+    ~RCSComputeThread() override;  // stop()
+
+    // Creates the shared context and initializes the RCSCompute on the worker.
+    // GUI thread, with shareContext (the display context) created. False if
+    // the context or RCSCompute cannot be set up; the thread is stopped then.
+    bool start(QOpenGLContext* shareContext);
+    // Releases the RCSCompute's GL objects on the worker and joins it
+    void stop();
+    bool isRunning() const { return compute_ != nullptr; }
+
+    void submit(Job job);
+    void invoke(Job job);  // Blocks until the job (and all queued before it) has run
+
+    // At most one trace is queued or running; isTracePending() says whether
+    // another may be submitted. resultsReady() follows each finished trace.
+    void submitTrace(TraceJob job);
+    bool isTracePending() const;
+    std::shared_ptr<const RCSTraceResults> takeResults();  // Newest unread, or null
+
+    RCSComputeStatus getStatus() const;
+    // Display thread, with its context current: orders its commands after
+    // the worker's newest fenced job
+    void waitForGPU();
+
+signals:
+    void resultsReady();
+    void bvhUpdated();  // RCSCompute::bvhUpdated, queued to the GUI thread
+
+private:
+    void runJob(const Job& job);
+    void runTrace(const TraceJob& job);
+    void publish();  // Worker: fence the job's GL work and refresh status_
+
+    QThread thread_;
+    QObject* worker_ = nullptr;  // Lives on thread_; jobs are invoked on it
+    std::unique_ptr<QOpenGLContext> context_;
+    std::unique_ptr<QOffscreenSurface> surface_;
+    std::unique_ptr<RCSCompute> compute_;  // Worker thread only
+
+    mutable std::mutex mutex_;
+    RCSComputeStatus status_;
+    GLsync fence_ = nullptr;
+    bool tracePending_ = false;
+    std::shared_ptr<const RCSTraceResults> results_;
+};
+
+} // namespace RCS
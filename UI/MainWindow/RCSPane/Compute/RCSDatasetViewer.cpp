@@ -0,0 +1,284 @@
+// RCSDatasetViewer.cpp - Scrubs a mapped .rcsc sweep by radar angle without retracing
+#include "RCSDatasetViewer.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+RCSDatasetViewer::RCSDatasetViewer(QObject* parent)
+    : QObject(parent)
+{
+}
+
+RCSDatasetViewer::~RCSDatasetViewer() {
+    close();
+}
+
+bool RCSDatasetViewer::open(const QString& path) {
+    close();
+    error_.clear();
+    if (!file_.open(path)) {
+        error_ = file_.errorString();
+        return false;
+    }
+    cutColumn_ = file_.columnIndex("cut_dbsm");
+    if (cutColumn_ < 0) {
+        error_ = path + " has no cut column - sweep it with --full-cut";
+        file_.close();
+        return false;
+    }
+    cutBins_ = file_.columns()[cutColumn_].width;
+    if (!buildGrid()) {
+        file_.close();
+        return false;
+    }
+
+    stopping_ = false;
+    prefetchThread_ = std::thread(&RCSDatasetViewer::prefetchLoop, this);
+    qDebug() << "RCSDatasetViewer:" << azimuthCount_ << "x" << elevationCount_ << "looks from" << path
+             << (file_.isCompressed() ? "(compressed)" : "");
+    return true;
+}
+
+void RCSDatasetViewer::close() {
+    stopPrefetch();
+    file_.close();
+    chunkCache_.clear();
+    shownRow_ = -1;
+    cutColumn_ = -1;
+    azimuthCount_ = 0;
+    elevationCount_ = 0;
+}
+
+bool RCSDatasetViewer::buildGrid() {
+    std::vector<float> azimuth;
+    std::vector<float> elevation;
+    std::vector<float> monostatic;
+    if (!file_.readColumn(file_.columnIndex("azimuth_deg"), azimuth) ||
+        !file_.readColumn(file_.columnIndex("elevation_deg"), elevation) || azimuth.empty()) {
+        error_ = "The sweep has no azimuth/elevation columns";
+        return false;
+    }
+
+    // One elevation row after another, each the same azimuth run
+    azimuthCount_ = 1;
+    while (azimuthCount_ < static_cast<int>(elevation.size()) && elevation[azimuthCount_] == elevation[0]) {
+        ++azimuthCount_;
+    }
+    if (azimuth.size() % azimuthCount_ != 0) {
+        error_ = "The sweep is not a regular azimuth x elevation grid";
+        return false;
+    }
+    elevationCount_ = static_cast<int>(azimuth.size() / azimuthCount_);
+    azimuthStart_ = azimuth[0];
+    azimuthStep_ = azimuthCount_ > 1 ? azimuth[1] - azimuth[0] : 360.0f;
+    elevationStart_ = elevation[0];
+    elevationStep_ = elevationCount_ > 1 ? elevation[azimuthCount_] - elevation[0] : 1.0f;
+    fullCircle_ = azimuthCount_ * azimuthStep_ >= 360.0f - 1.0e-3f;
+    if (azimuthStep_ <= 0.0f || elevationStep_ <= 0.0f) {
+        error_ = "The sweep is not a regular azimuth x elevation grid";
+        return false;
+    }
+
+    minDbsm_ = kDBsmFloor;
+    maxDbsm_ = kDBsmFloor + 1.0f;
+    if (file_.readColumn(file_.columnIndex("monostatic_dbsm"), monostatic)) {
+        bool any = false;
+        for (float dbsm : monostatic) {
+            if (dbsm <= kDBsmFloor) {
+                continue;
+            }
+            minDbsm_ = any ? std::min(minDbsm_, dbsm) : dbsm;
+            maxDbsm_ = any ? std::max(maxDbsm_, dbsm) : dbsm;
+            any = true;
+        }
+        if (any && maxDbsm_ - minDbsm_ < 1.0f) {
+            minDbsm_ = maxDbsm_ - 1.0f;
+        }
+    }
+    return true;
+}
+
+void RCSDatasetViewer::nearestLook(float azimuthDegrees, float elevationDegrees,
+                                   int& azimuthIndex, int& elevationIndex) const {
+    float offset = std::fmod(azimuthDegrees - azimuthStart_, 360.0f);
+    if (offset < 0.0f) {
+        offset += 360.0f;
+    }
+    if (fullCircle_) {
+        azimuthIndex = static_cast<int>(std::lround(offset / azimuthStep_)) % azimuthCount_;
+    } else {
+        // Angles in the gap past the end snap to whichever end is closer
+        float span = (azimuthCount_ - 1) * azimuthStep_;
+        if (offset > span + 0.5f * (360.0f - span)) {
+            offset = 0.0f;
+        }
+        azimuthIndex = std::clamp(static_cast<int>(std::lround(offset / azimuthStep_)), 0, azimuthCount_ - 1);
+    }
+    elevationIndex = std::clamp(static_cast<int>(std::lround((elevationDegrees - elevationStart_) / elevationStep_)),
+                                0, elevationCount_ - 1);
+}
+
+void RCSDatasetViewer::showLook(float azimuthDegrees, float elevationDegrees) {
+    if (!isOpen()) {
+        return;
+    }
+    int azimuthIndex = 0;
+    int elevationIndex = 0;
+    nearestLook(azimuthDegrees, elevationDegrees, azimuthIndex, elevationIndex);
+    int64_t row = static_cast<int64_t>(elevationIndex) * azimuthCount_ + azimuthIndex;
+    if (row == shownRow_) {
+        return;
+    }
+
+    ChunkValues hold;
+    const float* values = cutValues(row, hold);
+    if (!values) {
+        qWarning() << "RCSDatasetViewer: Cannot read look" << row;
+        return;
+    }
+    RCSResultFile::toCut(values, cutBins_, cut_);
+    shownRow_ = row;
+    schedulePrefetch(azimuthIndex, elevationIndex);
+
+    emit cutReady(cut_, azimuthStart_ + azimuthIndex * azimuthStep_, elevationStart_ + elevationIndex * elevationStep_);
+}
+
+const float* RCSDatasetViewer::cutValues(int64_t row, ChunkValues& hold) {
+    int rowInChunk = 0;
+    int chunk = file_.chunkOfRow(row, rowInChunk);
+    if (chunk < 0) {
+        return nullptr;
+    }
+    const float* values = nullptr;
+    if (file_.isCompressed()) {
+        hold = cachedChunk(chunk);
+        values = hold ? hold->data() : nullptr;
+    } else {
+        int rows = 0;
+        values = file_.chunkColumn(chunk, cutColumn_, scratch_, rows);
+    }
+    return values ? values + static_cast<size_t>(rowInChunk) * cutBins_ : nullptr;
+}
+
+RCSDatasetViewer::ChunkValues RCSDatasetViewer::cachedChunk(int chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = chunkCache_.find(chunk);
+        if (it != chunkCache_.end()) {
+            return it->second;
+        }
+    }
+
+    // Inflate outside the lock; both threads may race to the same chunk, the
+    // second insert is simply dropped
+    auto values = std::make_shared<std::vector<float>>();
+    int rows = 0;
+    const float* inflated = file_.chunkColumn(chunk, cutColumn_, *values, rows);
+    if (!inflated) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto inserted = chunkCache_.emplace(chunk, std::move(values));
+    while (static_cast<int>(chunkCache_.size()) > kDatasetCacheChunks) {
+        auto farthest = std::max_element(chunkCache_.begin(), chunkCache_.end(), [this](const auto& a, const auto& b) {
+            return std::abs(a.first - focusChunk_) < std::abs(b.first - focusChunk_);
+        });
+        if (farthest == inserted.first) {
+            break;  // Keep what was just asked for
+        }
+        chunkCache_.erase(farthest);
+    }
+    return inserted.first->second;
+}
+
+void RCSDatasetViewer::touchRow(int64_t row) const {
+    int rowInChunk = 0;
+    int chunk = file_.chunkOfRow(row, rowInChunk);
+    std::vector<float> unused;  // Raw files never inflate
+    int rows = 0;
+    const float* values = chunk >= 0 ? file_.chunkColumn(chunk, cutColumn_, unused, rows) : nullptr;
+    if (!values) {
+        return;
+    }
+    // One read per page faults the row in
+    const volatile float* cut = values + static_cast<size_t>(rowInChunk) * cutBins_;
+    const int floatsPerPage = 4096 / sizeof(float);
+    for (int bin = 0; bin < cutBins_; bin += floatsPerPage) {
+        (void)cut[bin];
+    }
+    (void)cut[cutBins_ - 1];
+}
+
+void RCSDatasetViewer::schedulePrefetch(int azimuthIndex, int elevationIndex) {
+    std::vector<int64_t> rows;
+    for (int de = -kDatasetPrefetchRadius; de <= kDatasetPrefetchRadius; ++de) {
+        int e = elevationIndex + de;
+        if (e < 0 || e >= elevationCount_) {
+            continue;
+        }
+        for (int da = -kDatasetPrefetchRadius; da <= kDatasetPrefetchRadius; ++da) {
+            int a = azimuthIndex + da;
+            if (fullCircle_) {
+                a = (a + azimuthCount_) % azimuthCount_;
+            } else if (a < 0 || a >= azimuthCount_) {
+                continue;
+            }
+            rows.push_back(static_cast<int64_t>(e) * azimuthCount_ + a);
+        }
+    }
+
+    int rowInChunk = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    focusChunk_ = std::max(file_.chunkOfRow(shownRow_, rowInChunk), 0);
+    prefetchRows_ = std::move(rows);
+    prefetchChanged_.notify_one();
+}
+
+void RCSDatasetViewer::prefetchLoop() {
+    std::vector<int64_t> rows;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            prefetchChanged_.wait(lock, [this]() { return !prefetchRows_.empty() || stopping_; });
+            if (stopping_) {
+                return;
+            }
+            rows.swap(prefetchRows_);
+            prefetchRows_.clear();
+        }
+
+        int lastChunk = -1;
+        for (int64_t row : rows) {
+            if (!file_.isCompressed()) {
+                touchRow(row);
+                continue;
+            }
+            int rowInChunk = 0;
+            int chunk = file_.chunkOfRow(row, rowInChunk);
+            if (chunk >= 0 && chunk != lastChunk) {
+                cachedChunk(chunk);
+                lastChunk = chunk;
+            }
+        }
+    }
+}
+
+void RCSDatasetViewer::stopPrefetch() {
+    if (!prefetchThread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        prefetchRows_.clear();
+    }
+    prefetchChanged_.notify_one();
+    prefetchThread_.join();
+}
+
+} // namespace RCS
@@ -0,0 +1,89 @@
+// RCSDatasetViewer.h - Scrubs a mapped .rcsc sweep by radar angle without retracing
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "RCSResultFile.h"
+#include "PolarRCSPlot.h"  // RCSDataPoint
+
+namespace RCS {
+
+// Shows the stored cut of the look nearest the radar angles of a sweep
+// written with --full-cut. Only that row's 360 bins are paged in. A prefetch
+// thread covers the looks up to kDatasetPrefetchRadius grid steps away in
+// azimuth and elevation: it touches their pages (raw files) or inflates their
+// chunks into a small cache (compressed files). The next step of a slider drag
+// is then already resident.
+class RCSDatasetViewer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit RCSDatasetViewer(QObject* parent = nullptr);
+    ~RCSDatasetViewer() override;
+
+    // The sweep must be a regular azimuth x elevation grid with a cut_dbsm column
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return file_.isOpen(); }
+    QString errorString() const { return error_; }
+
+    // Monostatic dBsm range of the whole sweep, for a steady heat map scale
+    float minDbsm() const { return minDbsm_; }
+    float maxDbsm() const { return maxDbsm_; }
+
+    // Emits cutReady when the nearest look differs from the one shown
+    void showLook(float azimuthDegrees, float elevationDegrees);
+
+signals:
+    void cutReady(const std::vector<RCSDataPoint>& cut, float azimuthDegrees, float elevationDegrees);
+
+private:
+    using ChunkValues = std::shared_ptr<const std::vector<float>>;
+
+    bool buildGrid();
+    void nearestLook(float azimuthDegrees, float elevationDegrees, int& azimuthIndex, int& elevationIndex) const;
+    const float* cutValues(int64_t row, ChunkValues& hold);
+    ChunkValues cachedChunk(int chunk);  // Compressed files - inflates on a miss
+    void touchRow(int64_t row) const;    // Raw files - faults the row's pages in
+    void schedulePrefetch(int azimuthIndex, int elevationIndex);
+    void prefetchLoop();
+    void stopPrefetch();
+
+    RCSResultFile file_;
+    int cutColumn_ = -1;
+    int cutBins_ = 0;
+    QString error_;
+
+    // Row = elevationIndex * azimuthCount_ + azimuthIndex, as RCSSweepRunner writes them
+    int azimuthCount_ = 0;
+    int elevationCount_ = 0;
+    float azimuthStart_ = 0.0f;
+    float azimuthStep_ = 1.0f;
+    float elevationStart_ = 0.0f;
+    float elevationStep_ = 1.0f;
+    bool fullCircle_ = false;
+    float minDbsm_ = 0.0f;
+    float maxDbsm_ = 0.0f;
+
+    int64_t shownRow_ = -1;
+    std::vector<RCSDataPoint> cut_;
+    std::vector<float> scratch_;  // Raw-file reads on the GUI thread
+
+    // Shared with the prefetch thread
+    std::mutex mutex_;
+    std::condition_variable prefetchChanged_;
+    std::vector<int64_t> prefetchRows_;  // Latest request replaces any pending one
+    std::unordered_map<int, ChunkValues> chunkCache_;
+    int focusChunk_ = 0;  // Eviction drops the cached chunk farthest from it
+    bool stopping_ = false;
+    std::thread prefetchThread_;
+};
+
+} // namespace RCS
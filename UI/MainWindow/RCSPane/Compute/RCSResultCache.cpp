@@ -0,0 +1,82 @@
+// RCSResultCache.cpp - Bounded LRU of finished RCS results keyed on quantized inputs
+#include "RCSResultCache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace RCS {
+
+void RCSResultKey::addQuantized(float value, float step) {
+    words_.push_back(static_cast<int32_t>(std::lround(value / step)));
+}
+
+void RCSResultKey::addQuantized(const float* values, size_t count, float step) {
+    for (size_t i = 0; i < count; ++i) {
+        addQuantized(values[i], step);
+    }
+}
+
+// FNV-1a over the words, as SceneVersions hashes its inputs
+size_t RCSResultKey::hash() const {
+    uint64_t hash = 1469598103934665603ull;
+    for (int32_t word : words_) {
+        hash = (hash ^ static_cast<uint32_t>(word)) * 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+RCSResultCache::RCSResultCache(int capacity)
+    : capacity_(std::max(capacity, 0)) {
+}
+
+void RCSResultCache::setCapacity(int capacity) {
+    capacity_ = std::max(capacity, 0);
+    evict();
+}
+
+std::shared_ptr<const RCSTraceResults> RCSResultCache::find(const RCSResultKey& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+}
+
+void RCSResultCache::insert(const RCSResultKey& key, const RCSTraceResults& results) {
+    if (capacity_ == 0 || !key.isValid()) {
+        return;
+    }
+
+    auto entry = std::make_shared<RCSTraceResults>(results);
+    entry->traced = false;  // Restoring is not a trace the pacer or telemetry should see
+    entry->hits.clear();
+    entry->hits.shrink_to_fit();
+    entry->heatMapIntensityBuffer = 0;
+    entry->hotspotBuffer = 0;
+    entry->hotspotOffset = -1;
+    entry->asyncReadback = false;
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        it->second->second = std::move(entry);
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+    entries_.emplace_front(key, std::move(entry));
+    index_.emplace(key, entries_.begin());
+    evict();
+}
+
+void RCSResultCache::clear() {
+    index_.clear();
+    entries_.clear();
+}
+
+void RCSResultCache::evict() {
+    while (entries_.size() > static_cast<size_t>(capacity_)) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+} // namespace RCS
@@ -0,0 +1,78 @@
+// RCSResultCache.h - Bounded LRU of finished RCS results keyed on quantized inputs
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "RCSComputeThread.h"
+
+namespace RCS {
+
+// The trace inputs a cached result stands for. Continuous inputs (radar
+// angles and range, instance matrices, beam width) are quantized so a
+// configuration revisited from a control or a saved profile lands on the same
+// key despite float noise; the rest is appended exactly. Keys compare word
+// for word, so a hash collision never restores the wrong result.
+class RCSResultKey {
+public:
+    void addQuantized(float value, float step);
+    void addQuantized(const float* values, size_t count, float step);
+
+    template<typename T>
+    void addExact(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "addExact() copies the object representation");
+        size_t offset = words_.size();
+        words_.resize(offset + (sizeof(T) + sizeof(int32_t) - 1) / sizeof(int32_t), 0);
+        std::memcpy(&words_[offset], &value, sizeof(T));
+    }
+
+    bool isValid() const { return !words_.empty(); }
+    void clear() { words_.clear(); }
+    bool operator==(const RCSResultKey& other) const { return words_ == other.words_; }
+    bool operator!=(const RCSResultKey& other) const { return !(*this == other); }
+    size_t hash() const;
+
+private:
+    std::vector<int32_t> words_;
+};
+
+// Finished results by key, least recently used dropped first. Entries are
+// display-side copies: they hold no per-ray hits and no GL names, only the
+// binned polar, sphere and receiver data, lobe clusters and the heat map's
+// per-vertex intensities, so restoring one never touches the GPU.
+class RCSResultCache {
+public:
+    explicit RCSResultCache(int capacity);
+
+    void setCapacity(int capacity);
+    int capacity() const { return capacity_; }
+    size_t size() const { return entries_.size(); }
+
+    // The entry for key, now the most recently used, or null
+    std::shared_ptr<const RCSTraceResults> find(const RCSResultKey& key);
+    // Stores a copy of results without its hits and GL buffer, replacing any
+    // entry for key
+    void insert(const RCSResultKey& key, const RCSTraceResults& results);
+    void clear();
+
+private:
+    struct KeyHash {
+        size_t operator()(const RCSResultKey& key) const { return key.hash(); }
+    };
+    using Entry = std::pair<RCSResultKey, std::shared_ptr<const RCSTraceResults>>;
+
+    void evict();
+
+    int capacity_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<RCSResultKey, std::list<Entry>::iterator, KeyHash> index_;
+};
+
+} // namespace RCS
@@ -0,0 +1,462 @@
+// RCSResultFile.cpp - Chunked columnar sweep results (.rcsc): streaming writer and mapped reader
+#include "RCSResultFile.h"
+#include "PolarRCSPlot.h"
+#include <QByteArray>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr char kHeaderMagic[8] = {'R', 'C', 'S', 'C', 'O', 'L', '0', '1'};
+constexpr char kTrailerMagic[8] = {'R', 'C', 'S', 'C', 'E', 'N', 'D', '0'};
+constexpr qint64 kTrailerBytes = 8 + 4 + 4 + 8;
+constexpr qint64 kIndexEntryBytes = 8 + 4 + 4;
+
+qint64 padded(qint64 bytes) {
+    return (bytes + 3) & ~qint64(3);
+}
+
+template <typename T>
+T readValue(const uchar* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+// =============================================================================
+// RCSResultWriter
+// =============================================================================
+
+RCSResultWriter::RCSResultWriter() = default;
+
+RCSResultWriter::~RCSResultWriter() {
+    if (isOpen()) {
+        finish();
+    }
+}
+
+bool RCSResultWriter::open(const QString& path, const std::vector<ResultColumn>& columns, bool compress,
+                           int chunkRows) {
+    if (isOpen()) {
+        finish();
+    }
+    columns_ = columns;
+    chunkRows_ = std::max(chunkRows, 1);
+    compress_ = compress;
+    rows_ = 0;
+    stalls_ = 0;
+    rowWidth_ = 0;
+    for (const ResultColumn& column : columns_) {
+        rowWidth_ += column.width;
+    }
+    queue_.clear();
+    spare_.clear();
+    index_.clear();
+    closing_ = false;
+    failed_ = false;
+    error_.clear();
+
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error_ = QString("Cannot open %1: %2").arg(path, file_.errorString());
+        return false;
+    }
+
+    // Header
+    const uint32_t header[4] = {kResultFileVersion, compress_ ? kResultCompressed : 0u,
+                                static_cast<uint32_t>(chunkRows_), static_cast<uint32_t>(columns_.size())};
+    bool ok = writeBytes(kHeaderMagic, sizeof(kHeaderMagic)) && writeBytes(header, sizeof(header));
+    for (const ResultColumn& column : columns_) {
+        char name[kResultColumnNameBytes] = {};
+        QByteArray utf8 = column.name.toUtf8();
+        std::memcpy(name, utf8.constData(), std::min<size_t>(utf8.size(), kResultColumnNameBytes - 1));
+        uint32_t width = static_cast<uint32_t>(column.width);
+        ok = ok && writeBytes(name, sizeof(name)) && writeBytes(&width, sizeof(width));
+    }
+    if (!ok) {
+        error_ = QString("Cannot write %1: %2").arg(path, file_.errorString());
+        file_.close();
+        return false;
+    }
+
+    current_ = takeSpareChunk();
+    ioThread_ = std::thread(&RCSResultWriter::ioLoop, this);
+    return true;
+}
+
+std::unique_ptr<RCSResultWriter::Chunk> RCSResultWriter::takeSpareChunk() {
+    std::unique_ptr<Chunk> chunk;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!spare_.empty()) {
+            chunk = std::move(spare_.back());
+            spare_.pop_back();
+        }
+    }
+    if (!chunk) {
+        chunk = std::make_unique<Chunk>();
+        chunk->columns.resize(columns_.size());
+        for (size_t c = 0; c < columns_.size(); ++c) {
+            chunk->columns[c].reserve(static_cast<size_t>(chunkRows_) * columns_[c].width);
+        }
+    }
+    chunk->rows = 0;
+    for (std::vector<float>& column : chunk->columns) {
+        column.clear();
+    }
+    return chunk;
+}
+
+void RCSResultWriter::appendRow(const float* values) {
+    if (!current_) {
+        return;
+    }
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        std::vector<float>& column = current_->columns[c];
+        column.insert(column.end(), values, values + columns_[c].width);
+        values += columns_[c].width;
+    }
+    ++current_->rows;
+    ++rows_;
+    if (current_->rows == chunkRows_) {
+        submitChunk();
+        current_ = takeSpareChunk();
+    }
+}
+
+void RCSResultWriter::submitChunk() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (static_cast<int>(queue_.size()) >= kResultWriterQueueChunks) {
+        ++stalls_;
+        queueChanged_.wait(lock, [this]() {
+            return static_cast<int>(queue_.size()) < kResultWriterQueueChunks || failed_;
+        });
+    }
+    if (failed_) {
+        spare_.push_back(std::move(current_));  // Dropped; finish() reports the error
+        return;
+    }
+    queue_.push_back(std::move(current_));
+    queueChanged_.notify_all();
+}
+
+void RCSResultWriter::ioLoop() {
+    for (;;) {
+        std::unique_ptr<Chunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queueChanged_.wait(lock, [this]() { return !queue_.empty() || closing_; });
+            if (queue_.empty()) {
+                return;  // Closing and drained
+            }
+            chunk = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        bool ok = writeChunk(*chunk);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        spare_.push_back(std::move(chunk));
+        if (!ok && !failed_) {
+            failed_ = true;
+            error_ = QString("Cannot write %1: %2").arg(file_.fileName(), file_.errorString());
+            queue_.clear();
+        }
+        queueChanged_.notify_all();
+    }
+}
+
+bool RCSResultWriter::writeChunk(const Chunk& chunk) {
+    ChunkEntry entry;
+    entry.offset = static_cast<uint64_t>(file_.pos());
+    entry.rows = static_cast<uint32_t>(chunk.rows);
+
+    static const char kPadding[4] = {};
+    for (const std::vector<float>& column : chunk.columns) {
+        const char* raw = reinterpret_cast<const char*>(column.data());
+        qint64 rawBytes = static_cast<qint64>(column.size() * sizeof(float));
+        QByteArray compressed;
+        const char* stored = raw;
+        qint64 storedBytes = rawBytes;
+        if (compress_) {
+            compressed = qCompress(reinterpret_cast<const uchar*>(raw), static_cast<int>(rawBytes));
+            stored = compressed.constData();
+            storedBytes = compressed.size();
+        }
+        const uint32_t sizes[2] = {static_cast<uint32_t>(storedBytes), static_cast<uint32_t>(rawBytes)};
+        if (!writeBytes(sizes, sizeof(sizes)) || !writeBytes(stored, storedBytes) ||
+            !writeBytes(kPadding, padded(storedBytes) - storedBytes)) {
+            return false;
+        }
+    }
+    index_.push_back(entry);
+    return true;
+}
+
+bool RCSResultWriter::writeBytes(const void* data, qint64 size) {
+    return size == 0 || file_.write(static_cast<const char*>(data), size) == size;
+}
+
+bool RCSResultWriter::finish() {
+    if (!isOpen()) {
+        return false;
+    }
+    if (current_ && current_->rows > 0) {
+        submitChunk();
+    }
+    current_.reset();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    queueChanged_.notify_all();
+    if (ioThread_.joinable()) {
+        ioThread_.join();
+    }
+
+    bool ok = !failed_;
+    if (ok) {
+        uint64_t indexOffset = static_cast<uint64_t>(file_.pos());
+        for (const ChunkEntry& entry : index_) {
+            const uint32_t rowsAndReserved[2] = {entry.rows, 0u};
+            ok = ok && writeBytes(&entry.offset, sizeof(entry.offset)) &&
+                 writeBytes(rowsAndReserved, sizeof(rowsAndReserved));
+        }
+        const uint32_t countAndReserved[2] = {static_cast<uint32_t>(index_.size()), 0u};
+        ok = ok && writeBytes(&indexOffset, sizeof(indexOffset)) &&
+             writeBytes(countAndReserved, sizeof(countAndReserved)) &&
+             writeBytes(kTrailerMagic, sizeof(kTrailerMagic));
+        if (!ok) {
+            fail(QString("Cannot write %1: %2").arg(file_.fileName(), file_.errorString()));
+        }
+    }
+    file_.close();
+    spare_.clear();
+    if (stalls_ > 0) {
+        qDebug() << "RCSResultWriter:" << stalls_ << "waits on a full write queue for" << file_.fileName();
+    }
+    return ok;
+}
+
+void RCSResultWriter::fail(const QString& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failed_ = true;
+    error_ = message;
+}
+
+QString RCSResultWriter::errorString() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+// =============================================================================
+// RCSResultFile
+// =============================================================================
+
+RCSResultFile::~RCSResultFile() {
+    close();
+}
+
+bool RCSResultFile::open(const QString& path) {
+    close();
+    file_.setFileName(path);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        return fail(QString("Cannot open %1: %2").arg(path, file_.errorString()));
+    }
+    size_ = file_.size();
+    const qint64 headerBytes = sizeof(kHeaderMagic) + 4 * sizeof(uint32_t);
+    if (size_ < headerBytes + kTrailerBytes) {
+        return fail(QString("%1 is not an RCS result file").arg(path));
+    }
+    data_ = file_.map(0, size_);
+    if (!data_) {
+        return fail(QString("Cannot map %1: %2").arg(path, file_.errorString()));
+    }
+
+    // Header
+    if (std::memcmp(data_, kHeaderMagic, sizeof(kHeaderMagic)) != 0 ||
+        readValue<uint32_t>(data_ + 8) != kResultFileVersion) {
+        return fail(QString("%1 is not an RCS result file (version %2)").arg(path).arg(kResultFileVersion));
+    }
+    flags_ = readValue<uint32_t>(data_ + 12);
+    uint32_t columnCount = readValue<uint32_t>(data_ + 20);
+    qint64 cursor = headerBytes;
+    const qint64 columnBytes = kResultColumnNameBytes + sizeof(uint32_t);
+    if (cursor + columnCount * columnBytes > size_ - kTrailerBytes) {
+        return fail(QString("%1: Truncated header").arg(path));
+    }
+    for (uint32_t c = 0; c < columnCount; ++c) {
+        ResultColumn column;
+        const char* name = reinterpret_cast<const char*>(data_ + cursor);
+        column.name = QString::fromUtf8(name, static_cast<int>(strnlen(name, kResultColumnNameBytes)));
+        column.width = static_cast<int>(readValue<uint32_t>(data_ + cursor + kResultColumnNameBytes));
+        columns_.push_back(column);
+        cursor += columnBytes;
+    }
+
+    // Trailer and chunk index
+    const uchar* trailer = data_ + size_ - kTrailerBytes;
+    if (std::memcmp(trailer + 16, kTrailerMagic, sizeof(kTrailerMagic)) != 0) {
+        return fail(QString("%1: No trailer - the sweep did not finish").arg(path));
+    }
+    uint64_t indexOffset = readValue<uint64_t>(trailer);
+    uint32_t chunkCount = readValue<uint32_t>(trailer + 8);
+    if (indexOffset + static_cast<uint64_t>(chunkCount) * kIndexEntryBytes > static_cast<uint64_t>(size_ - kTrailerBytes)) {
+        return fail(QString("%1: Damaged chunk index").arg(path));
+    }
+
+    rowStarts_.assign(1, 0);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const uchar* entry = data_ + indexOffset + i * kIndexEntryBytes;
+        ChunkInfo chunk;
+        chunk.offset = readValue<uint64_t>(entry);
+        chunk.rows = static_cast<int>(readValue<uint32_t>(entry + 8));
+
+        // Column blocks follow each other; their sizes locate the next one
+        uint64_t block = chunk.offset;
+        for (const ResultColumn& column : columns_) {
+            if (block + 8 > indexOffset) {
+                return fail(QString("%1: Damaged chunk %2").arg(path).arg(i));
+            }
+            uint32_t storedBytes = readValue<uint32_t>(data_ + block);
+            uint32_t rawBytes = readValue<uint32_t>(data_ + block + 4);
+            if (rawBytes != static_cast<uint64_t>(chunk.rows) * column.width * sizeof(float) ||
+                block + 8 + storedBytes > indexOffset) {
+                return fail(QString("%1: Damaged chunk %2").arg(path).arg(i));
+            }
+            chunk.columnOffsets.push_back(block);
+            block += 8 + padded(storedBytes);
+        }
+        rowStarts_.push_back(rowStarts_.back() + chunk.rows);
+        chunks_.push_back(std::move(chunk));
+    }
+    return true;
+}
+
+void RCSResultFile::close() {
+    if (data_) {
+        file_.unmap(const_cast<uchar*>(data_));
+        data_ = nullptr;
+    }
+    file_.close();
+    size_ = 0;
+    flags_ = 0;
+    columns_.clear();
+    chunks_.clear();
+    rowStarts_.clear();
+}
+
+bool RCSResultFile::fail(const QString& message) {
+    error_ = message;
+    close();
+    return false;
+}
+
+int RCSResultFile::columnIndex(const QString& name) const {
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        if (columns_[c].name == name) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+int RCSResultFile::chunkOfRow(int64_t row, int& rowInChunk) const {
+    if (row < 0 || row >= rowCount()) {
+        return -1;
+    }
+    int chunk = static_cast<int>(std::upper_bound(rowStarts_.begin(), rowStarts_.end(), row) - rowStarts_.begin()) - 1;
+    rowInChunk = static_cast<int>(row - rowStarts_[chunk]);
+    return chunk;
+}
+
+const float* RCSResultFile::chunkColumn(int chunk, int column, std::vector<float>& scratch, int& rows) const {
+    if (!isOpen() || chunk < 0 || chunk >= chunkCount() || column < 0 || column >= static_cast<int>(columns_.size())) {
+        return nullptr;
+    }
+    const ChunkInfo& info = chunks_[chunk];
+    const uchar* block = data_ + info.columnOffsets[column];
+    uint32_t storedBytes = readValue<uint32_t>(block);
+    uint32_t rawBytes = readValue<uint32_t>(block + 4);
+    rows = info.rows;
+
+    if (!isCompressed()) {
+        return reinterpret_cast<const float*>(block + 8);  // 4-byte aligned in the mapping
+    }
+    QByteArray raw = qUncompress(block + 8, static_cast<int>(storedBytes));
+    if (static_cast<uint32_t>(raw.size()) != rawBytes) {
+        qWarning() << "RCSResultFile: Chunk" << chunk << "column" << columns_[column].name << "does not inflate";
+        return nullptr;
+    }
+    scratch.resize(rawBytes / sizeof(float));
+    std::memcpy(scratch.data(), raw.constData(), rawBytes);
+    return scratch.data();
+}
+
+bool RCSResultFile::readColumn(int column, std::vector<float>& out) const {
+    out.clear();
+    if (column < 0 || column >= static_cast<int>(columns_.size())) {
+        return false;
+    }
+    out.reserve(static_cast<size_t>(rowCount()) * columns_[column].width);
+    std::vector<float> scratch;
+    for (int chunk = 0; chunk < chunkCount(); ++chunk) {
+        int rows = 0;
+        const float* values = chunkColumn(chunk, column, scratch, rows);
+        if (!values) {
+            return false;
+        }
+        out.insert(out.end(), values, values + static_cast<size_t>(rows) * columns_[column].width);
+    }
+    return true;
+}
+
+bool RCSResultFile::readRow(int column, int64_t row, float* out, std::vector<float>& scratch) const {
+    int rowInChunk = 0;
+    int chunk = chunkOfRow(row, rowInChunk);
+    if (chunk < 0 || column < 0 || column >= static_cast<int>(columns_.size())) {
+        return false;
+    }
+    int rows = 0;
+    const float* values = chunkColumn(chunk, column, scratch, rows);
+    if (!values) {
+        return false;
+    }
+    const int width = columns_[column].width;
+    std::memcpy(out, values + static_cast<size_t>(rowInChunk) * width, width * sizeof(float));
+    return true;
+}
+
+bool RCSResultFile::readCut(int64_t row, std::vector<RCSDataPoint>& cut, std::vector<float>& scratch) const {
+    int column = columnIndex("cut_dbsm");
+    int rowInChunk = 0;
+    int chunk = chunkOfRow(row, rowInChunk);
+    if (column < 0 || chunk < 0) {
+        return false;
+    }
+    int rows = 0;
+    const float* values = chunkColumn(chunk, column, scratch, rows);
+    if (!values) {
+        return false;
+    }
+    const int width = columns_[column].width;
+    toCut(values + static_cast<size_t>(rowInChunk) * width, width, cut);
+    return true;
+}
+
+void RCSResultFile::toCut(const float* values, int bins, std::vector<RCSDataPoint>& cut) {
+    // The sweep writes kDBsmFloor for bins without hits
+    cut.resize(bins);
+    for (int bin = 0; bin < bins; ++bin) {
+        cut[bin] = RCSDataPoint(static_cast<float>(bin), values[bin], values[bin] > kDBsmFloor);
+    }
+}
+
+} // namespace RCS
@@ -0,0 +1,162 @@
+// RCSResultFile.h - Chunked columnar sweep results (.rcsc): streaming writer and mapped reader
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Constants.h"
+
+struct RCSDataPoint;
+
+namespace RCS {
+
+// A column holds width float32 values per row. Sweeps store the whole
+// kPolarPlotBins azimuth cut as one column, so a row's cut is contiguous.
+struct ResultColumn {
+    QString name;
+    int width = 1;
+};
+
+// .rcsc layout, little endian, every block 4-byte aligned so raw columns can
+// be read in place from the mapping:
+//   header   "RCSCOL01", u32 version, u32 flags, u32 chunkRows, u32 columnCount,
+//            per column: char name[kResultColumnNameBytes], u32 width
+//   chunks   per column: u32 storedBytes, u32 rawBytes, data padded to 4 bytes
+//            (raw float32, or qCompress'd when flags has kResultCompressed)
+//   index    per chunk: u64 offset, u32 rows, u32 reserved
+//   trailer  u64 indexOffset, u32 chunkCount, u32 reserved, "RCSCEND0"
+// A file without its trailer (an interrupted sweep) does not open.
+constexpr uint32_t kResultFileVersion = 1;
+constexpr uint32_t kResultCompressed = 1u << 0;
+
+// Streams rows to a .rcsc file. Rows collect into a chunk in memory; full
+// chunks go through a bounded queue to an I/O thread that compresses and
+// writes them, so appendRow() never touches the disk. It only waits when
+// kResultWriterQueueChunks chunks are already queued, i.e. when the disk is
+// the bottleneck; those waits are counted in stalls().
+class RCSResultWriter {
+public:
+    RCSResultWriter();
+    ~RCSResultWriter();  // Finishes an open file
+
+    RCSResultWriter(const RCSResultWriter&) = delete;
+    RCSResultWriter& operator=(const RCSResultWriter&) = delete;
+
+    bool open(const QString& path, const std::vector<ResultColumn>& columns, bool compress,
+              int chunkRows = RS::Constants::kResultChunkRows);
+
+    // values holds rowWidth() floats, the columns in order
+    void appendRow(const float* values);
+
+    // Writes the last partial chunk, the index and the trailer. False if any
+    // write failed; the file is then incomplete.
+    bool finish();
+
+    bool isOpen() const { return file_.isOpen(); }
+    int rowWidth() const { return rowWidth_; }
+    int64_t rowCount() const { return rows_; }
+    int stalls() const { return stalls_; }
+    QString errorString() const;
+
+private:
+    struct Chunk {
+        int rows = 0;
+        std::vector<std::vector<float>> columns;  // rows * width values each
+    };
+    struct ChunkEntry {
+        uint64_t offset = 0;
+        uint32_t rows = 0;
+    };
+
+    std::unique_ptr<Chunk> takeSpareChunk();
+    void submitChunk();
+    void ioLoop();
+    bool writeChunk(const Chunk& chunk);
+    bool writeBytes(const void* data, qint64 size);
+    void fail(const QString& message);
+
+    QFile file_;
+    std::vector<ResultColumn> columns_;
+    int rowWidth_ = 0;
+    int chunkRows_ = 0;
+    bool compress_ = false;
+    int64_t rows_ = 0;
+    int stalls_ = 0;
+    std::unique_ptr<Chunk> current_;
+
+    // Shared with the I/O thread
+    mutable std::mutex mutex_;
+    std::condition_variable queueChanged_;
+    std::deque<std::unique_ptr<Chunk>> queue_;
+    std::vector<std::unique_ptr<Chunk>> spare_;  // Written chunks, reused for their capacity
+    bool closing_ = false;
+    bool failed_ = false;
+    QString error_;
+    std::thread ioThread_;
+
+    std::vector<ChunkEntry> index_;  // I/O thread until joined
+};
+
+// Read side: maps the whole file. Raw chunks are read in place; compressed
+// chunks are inflated into the caller's scratch buffer.
+class RCSResultFile {
+public:
+    RCSResultFile() = default;
+    ~RCSResultFile();
+
+    RCSResultFile(const RCSResultFile&) = delete;
+    RCSResultFile& operator=(const RCSResultFile&) = delete;
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    const std::vector<ResultColumn>& columns() const { return columns_; }
+    int columnIndex(const QString& name) const;  // -1 if absent
+    int64_t rowCount() const { return rowStarts_.empty() ? 0 : rowStarts_.back(); }
+    int chunkCount() const { return static_cast<int>(chunks_.size()); }
+    bool isCompressed() const { return (flags_ & kResultCompressed) != 0; }
+    int chunkOfRow(int64_t row, int& rowInChunk) const;  // -1 past the end
+    QString errorString() const { return error_; }
+
+    // rows * width values of column in chunk; nullptr if the chunk is damaged.
+    // The pointer stays valid until close() or the next call with the same scratch.
+    const float* chunkColumn(int chunk, int column, std::vector<float>& scratch, int& rows) const;
+
+    // Every row of column, rowCount() * width values
+    bool readColumn(int column, std::vector<float>& out) const;
+
+    // One row of column, width values
+    bool readRow(int column, int64_t row, float* out, std::vector<float>& scratch) const;
+
+    // The "cut_dbsm" column of row as PolarRCSPlot data
+    bool readCut(int64_t row, std::vector<RCSDataPoint>& cut, std::vector<float>& scratch) const;
+    static void toCut(const float* values, int bins, std::vector<RCSDataPoint>& cut);
+
+private:
+    struct ChunkInfo {
+        uint64_t offset = 0;
+        int rows = 0;
+        std::vector<uint64_t> columnOffsets;  // Start of each column block
+    };
+
+    bool fail(const QString& message);
+
+    QFile file_;
+    const uchar* data_ = nullptr;
+    qint64 size_ = 0;
+    uint32_t flags_ = 0;
+    std::vector<ResultColumn> columns_;
+    std::vector<ChunkInfo> chunks_;
+    std::vector<int64_t> rowStarts_;  // chunkCount() + 1 entries
+    QString error_;
+};
+
+} // namespace RCS
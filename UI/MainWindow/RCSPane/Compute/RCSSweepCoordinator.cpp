@@ -0,0 +1,358 @@
+// RCSSweepCoordinator.cpp - Headless sweeps split across RadarSim --serve worker processes
+#include "RCSSweepCoordinator.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDebug>
+#include <algorithm>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+QJsonArray vectorToJson(const QVector3D& v) {
+    return QJsonArray{v.x(), v.y(), v.z()};
+}
+
+// Option names of RadarSim --sweep, which RCSAutomationServer takes as well
+QString targetName(const SweepConfig& config) {
+    if (!config.meshPath.isEmpty()) {
+        return config.meshPath;
+    }
+    switch (config.targetType) {
+    case WireframeType::Cylinder: return "cylinder";
+    case WireframeType::Aircraft: return "aircraft";
+    case WireframeType::Sphere: return "sphere";
+    case WireframeType::Plate: return "plate";
+    case WireframeType::Dihedral: return "dihedral";
+    case WireframeType::Trihedral: return "trihedral";
+    default: return "cube";
+    }
+}
+
+QString samplingName(RaySampling sampling) {
+    switch (sampling) {
+    case RaySampling::Fibonacci: return "fibonacci";
+    case RaySampling::Sobol: return "sobol";
+    default: return "rings";
+    }
+}
+
+} // namespace
+
+RCSSweepCoordinator::RCSSweepCoordinator(QObject* parent)
+    : QObject(parent)
+{
+}
+
+RCSSweepCoordinator::~RCSSweepCoordinator() {
+    stopWorkers();
+}
+
+QStringList RCSSweepCoordinator::localWorkerCommands(int count, SweepBackend backend) {
+    QString command = QString("\"%1\" --serve --backend %2")
+        .arg(QCoreApplication::applicationFilePath(), backend == SweepBackend::CPU ? "cpu" : "gpu");
+    QStringList commands;
+    for (int i = 0; i < count; ++i) {
+        commands << command;
+    }
+    return commands;
+}
+
+bool RCSSweepCoordinator::run(const SweepConfig& config) {
+    if (commands_.isEmpty()) {
+        qCritical() << "RCSSweepCoordinator::run - No workers";
+        return false;
+    }
+    config_ = config;
+    failed_ = false;
+    finished_ = false;
+    nextToWrite_ = 0;
+    completedLooks_ = 0;
+
+    // One unit per elevation row
+    const int numElevation = RCSSweepRunner::elevationCount(config);
+    totalLooks_ = numElevation * RCSSweepRunner::azimuthCount(config);
+    units_.assign(numElevation, Unit());
+    queued_.clear();
+    for (int e = 0; e < numElevation; ++e) {
+        units_[e].elevation = config.elevationStart + e * config.elevationStep;
+        queued_.push_back(e);
+    }
+
+    if (!output_.open(config)) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    workers_.clear();
+    for (const QString& command : commands_) {
+        auto worker = std::make_unique<Worker>();
+        worker->command = command;
+        workers_.push_back(std::move(worker));
+    }
+    int started = 0;
+    for (auto& worker : workers_) {
+        if (startWorker(*worker)) {
+            sendSetup(*worker);
+            dispatch(*worker);
+            ++started;
+        }
+    }
+    if (started == 0) {
+        fail("No sweep worker could be started");
+    } else if (!finished_) {
+        loop_.exec();
+    }
+
+    stopWorkers();
+    bool written = output_.finish();
+    if (failed_) {
+        return false;
+    }
+
+    qint64 elapsedMs = std::max<qint64>(timer.elapsed(), 1);
+    qDebug() << "RCSSweepCoordinator:" << completedLooks_ << "of" << totalLooks_ << "positions in"
+             << elapsedMs << "ms on" << started << "workers," << 1000.0 * completedLooks_ / elapsedMs
+             << "positions/s ->" << config.outputPath;
+    return written;
+}
+
+void RCSSweepCoordinator::cancel() {
+    for (auto& worker : workers_) {
+        if (worker->alive) {
+            send(*worker, QJsonValue(), "cancel", QJsonObject());
+        }
+    }
+    fail("Sweep cancelled");
+}
+
+bool RCSSweepCoordinator::startWorker(Worker& worker) {
+    QStringList arguments = QProcess::splitCommand(worker.command);
+    if (arguments.isEmpty()) {
+        qWarning() << "RCSSweepCoordinator: Empty worker command";
+        return false;
+    }
+    QString program = arguments.takeFirst();
+
+    worker.process = std::make_unique<QProcess>();
+    worker.process->setProcessChannelMode(QProcess::ForwardedErrorChannel);  // Worker logs go to our stderr
+    Worker* target = &worker;
+    connect(worker.process.get(), &QProcess::readyReadStandardOutput, this, [this, target]() { onOutput(*target); });
+    connect(worker.process.get(), qOverload<int, QProcess::ExitStatus>(&QProcess::finished), this, [this, target]() { onExited(*target); });
+
+    worker.process->start(program, arguments);
+    if (!worker.process->waitForStarted(kSweepWorkerStartMs)) {
+        qWarning() << "RCSSweepCoordinator: Cannot start" << worker.command << "-" << worker.process->errorString();
+        return false;
+    }
+    worker.alive = true;
+    return true;
+}
+
+void RCSSweepCoordinator::send(Worker& worker, const QJsonValue& id, const QString& method,
+                               const QJsonObject& params) {
+    QJsonObject request;
+    request["id"] = id;
+    request["method"] = method;
+    request["params"] = params;
+    QByteArray line = QJsonDocument(request).toJson(QJsonDocument::Compact);
+    line.append('\n');
+    worker.process->write(line);
+}
+
+void RCSSweepCoordinator::sendSetup(Worker& worker) {
+    // Requests are answered in order, so units can follow without waiting
+    QJsonObject target;
+    target["type"] = targetName(config_);
+    target["position"] = vectorToJson(config_.targetPosition);
+    target["rotation"] = vectorToJson(config_.targetRotation);
+    target["scale"] = config_.targetScale;
+    target["formation"] = config_.formationCount;
+    target["formationSpacing"] = config_.formationSpacing;
+    target["cache"] = config_.useTargetCache;
+    target["analytic"] = config_.analytic;
+    send(worker, "setup", "set_target", target);
+
+    QJsonObject radar;
+    radar["radius"] = config_.sphereRadius;
+    send(worker, "setup", "set_radar", radar);
+
+    QJsonObject beam;
+    beam["width"] = config_.beamWidthDegrees;
+    send(worker, "setup", "set_beam", beam);
+
+    QJsonObject trace;
+    trace["rays"] = config_.numRays;
+    trace["bounces"] = config_.maxBounces;
+    trace["bounceCutoff"] = config_.bounceCutoff;
+    trace["roulette"] = config_.rouletteThreshold;
+    trace["sampling"] = samplingName(config_.sampling);
+    trace["sliceThickness"] = config_.sliceThicknessDegrees;
+    trace["traversal"] = config_.traversal == TraversalMode::Stackless ? "stackless" : "stack";
+    trace["bvh"] = config_.bvhLayout == BVHLayout::Wide4 ? "wide4" : "binary";
+    trace["bvhBuild"] = config_.bvhBuild == BVHBuild::GPU ? "gpu" : "cpu";
+    trace["triangles"] = config_.trianglePrecision == TrianglePrecision::Compact ? "compact" : "full";
+    trace["reorder"] = config_.rayReordering;
+    trace["persistentThreads"] = config_.persistentThreads;
+    trace["normalCones"] = config_.normalConeCulling;
+    trace["temporalReuse"] = config_.temporalReuse;
+    trace["threads"] = config_.cpuThreads;
+    trace["materials"] = QJsonArray::fromStringList(config_.materials);
+    send(worker, "setup", "set_trace", trace);
+}
+
+void RCSSweepCoordinator::dispatch(Worker& worker) {
+    while (worker.alive && !queued_.empty() && static_cast<int>(worker.units.size()) < kSweepUnitsInFlight) {
+        int unit = queued_.front();
+        queued_.pop_front();
+
+        QJsonObject params;
+        params["azimuth"] = QJsonArray{config_.azimuthStart, config_.azimuthEnd, config_.azimuthStep};
+        params["elevation"] = QJsonArray{units_[unit].elevation, units_[unit].elevation, 1.0};
+        params["fullCut"] = config_.writeFullCut;
+        send(worker, unit, "sweep", params);
+        worker.units.push_back(unit);
+    }
+}
+
+void RCSSweepCoordinator::onOutput(Worker& worker) {
+    worker.buffer.append(worker.process->readAllStandardOutput());
+    int newline;
+    while (!finished_ && (newline = worker.buffer.indexOf('\n')) >= 0) {
+        QByteArray line = worker.buffer.left(newline);
+        worker.buffer.remove(0, newline + 1);
+
+        QJsonDocument doc = QJsonDocument::fromJson(line);
+        if (!doc.isObject()) {
+            fail("Unreadable response from " + worker.command);
+            return;
+        }
+        onResponse(worker, doc.object());
+    }
+}
+
+void RCSSweepCoordinator::onResponse(Worker& worker, const QJsonObject& response) {
+    QJsonValue id = response.value("id");
+    if (response.contains("error")) {
+        fail(worker.command + ": " + response.value("error").toString());
+        return;
+    }
+    if (!id.isDouble()) {
+        return;  // A setup answer
+    }
+
+    int index = id.toInt();
+    auto pending = std::find(worker.units.begin(), worker.units.end(), index);
+    if (index < 0 || index >= static_cast<int>(units_.size()) || pending == worker.units.end()) {
+        return;
+    }
+    worker.units.erase(pending);
+
+    QJsonObject result = response.value("result").toObject();
+    Unit& unit = units_[index];
+    unit.rays = result.value("rays").toInt();
+    for (const QJsonValue& value : result.value("looks").toArray()) {
+        QJsonObject look = value.toObject();
+        Row row;
+        row.azimuth = static_cast<float>(look.value("azimuth").toDouble());
+        row.hits = look.value("hits").toInt();
+        row.monostaticDBsm = static_cast<float>(look.value("monostatic").toDouble());
+        if (config_.writeFullCut) {
+            QJsonArray cut = look.value("cut").toArray();
+            row.cut.resize(kPolarPlotBins);
+            for (int bin = 0; bin < kPolarPlotBins; ++bin) {
+                row.cut[bin].angleDegrees = static_cast<float>(bin);
+                row.cut[bin].dBsm = bin < cut.size() ? static_cast<float>(cut[bin].toDouble()) : kDBsmFloor;
+                row.cut[bin].valid = bin < cut.size();
+            }
+        }
+        unit.rows.push_back(std::move(row));
+    }
+    unit.done = true;
+    completedLooks_ += static_cast<int>(unit.rows.size());
+    emit progress(completedLooks_, totalLooks_);
+
+    writeReadyUnits();
+    dispatch(worker);
+}
+
+void RCSSweepCoordinator::onExited(Worker& worker) {
+    if (!worker.alive) {
+        return;
+    }
+    worker.alive = false;
+    if (finished_) {
+        return;
+    }
+
+    // Its units go to the front of the queue, so the output is not held up
+    qWarning() << "RCSSweepCoordinator: Worker" << worker.command << "exited with" << worker.units.size()
+               << "rows outstanding";
+    for (auto unit = worker.units.rbegin(); unit != worker.units.rend(); ++unit) {
+        queued_.push_front(*unit);
+    }
+    worker.units.clear();
+
+    bool anyAlive = false;
+    for (auto& other : workers_) {
+        if (other->alive) {
+            anyAlive = true;
+            dispatch(*other);
+        }
+    }
+    if (!anyAlive) {
+        fail("All sweep workers exited");
+    }
+}
+
+void RCSSweepCoordinator::writeReadyUnits() {
+    while (nextToWrite_ < units_.size() && units_[nextToWrite_].done) {
+        Unit& unit = units_[nextToWrite_];
+        for (const Row& row : unit.rows) {
+            output_.writeRow(row.azimuth, unit.elevation, row.hits, unit.rays, row.monostaticDBsm, &row.cut);
+        }
+        output_.endElevationRow();
+        unit.rows = std::vector<Row>();  // Written; release the cuts
+        ++nextToWrite_;
+    }
+    if (nextToWrite_ == units_.size()) {
+        finished_ = true;
+        loop_.quit();
+    }
+}
+
+void RCSSweepCoordinator::fail(const QString& message) {
+    if (finished_) {
+        return;
+    }
+    qCritical() << "RCSSweepCoordinator:" << message;
+    failed_ = true;
+    finished_ = true;
+    loop_.quit();
+}
+
+void RCSSweepCoordinator::stopWorkers() {
+    for (auto& worker : workers_) {
+        if (!worker->process) {
+            continue;
+        }
+        worker->alive = false;
+        if (worker->process->state() != QProcess::NotRunning) {
+            send(*worker, QJsonValue(), "shutdown", QJsonObject());
+            worker->process->closeWriteChannel();
+            if (!worker->process->waitForFinished(kSweepWorkerStartMs)) {
+                worker->process->kill();
+                worker->process->waitForFinished();
+            }
+        }
+    }
+    workers_.clear();
+}
+
+} // namespace RCS
@@ -0,0 +1,96 @@
+// RCSSweepCoordinator.h - Headless sweeps split across RadarSim --serve worker processes
+#pragma once
+
+#include <QEventLoop>
+#include <QJsonObject>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "RCSSweepRunner.h"
+
+namespace RCS {
+
+// Runs one sweep on several worker processes, each a RadarSim --serve
+// (RCSAutomationServer) with a backend and context of its own. Local workers
+// put one process on every GPU; a command such as "ssh node2 RadarSim --serve"
+// puts one on another machine. Model targets load through each worker's
+// TargetCache, so a warm cache skips import and BVH build there.
+//
+// The grid is cut into work units of one elevation row. Every worker gets
+// the target and trace settings once and then up to kSweepUnitsInFlight
+// units at a time, so it never idles between rows. Rows come back inline and
+// go through SweepOutput in grid order: the file matches a local sweep.
+// Units of a worker that exits go to the others; the sweep fails only once
+// no worker is left, or when a worker reports an error.
+class RCSSweepCoordinator : public QObject {
+    Q_OBJECT
+
+public:
+    explicit RCSSweepCoordinator(QObject* parent = nullptr);
+    ~RCSSweepCoordinator() override;
+
+    // One command line per worker, split as by QProcess::splitCommand
+    void setWorkerCommands(const QStringList& commands) { commands_ = commands; }
+    // count workers of this executable: "<RadarSim> --serve --backend gpu|cpu"
+    static QStringList localWorkerCommands(int count, SweepBackend backend);
+
+    // Blocks in a local event loop until the sweep is written. Returns false
+    // if the output could not be written, a worker failed or cancel() was called.
+    bool run(const SweepConfig& config);
+    void cancel();
+
+signals:
+    void progress(int completed, int total);
+
+private:
+    struct Row {
+        float azimuth = 0.0f;
+        int hits = 0;
+        float monostaticDBsm = 0.0f;
+        std::vector<RCSDataPoint> cut;  // With writeFullCut only
+    };
+    struct Unit {
+        float elevation = 0.0f;
+        int rays = 0;
+        bool done = false;
+        std::vector<Row> rows;
+    };
+    struct Worker {
+        QString command;
+        std::unique_ptr<QProcess> process;
+        QByteArray buffer;       // Output not yet split into lines
+        std::deque<int> units;   // Sent, not yet answered
+        bool alive = false;
+    };
+
+    bool startWorker(Worker& worker);
+    void send(Worker& worker, const QJsonValue& id, const QString& method, const QJsonObject& params);
+    void sendSetup(Worker& worker);
+    void dispatch(Worker& worker);
+    void onOutput(Worker& worker);
+    void onResponse(Worker& worker, const QJsonObject& response);
+    void onExited(Worker& worker);
+    void writeReadyUnits();
+    void fail(const QString& message);
+    void stopWorkers();
+
+    QStringList commands_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    SweepConfig config_;
+    SweepOutput output_;
+    std::vector<Unit> units_;
+    std::deque<int> queued_;  // Units no worker has; reassigned ones go first
+    size_t nextToWrite_ = 0;
+    int completedLooks_ = 0;
+    int totalLooks_ = 0;
+    bool failed_ = false;
+    bool finished_ = false;
+    QEventLoop loop_;
+};
+
+} // namespace RCS
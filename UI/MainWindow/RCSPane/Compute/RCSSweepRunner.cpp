@@ -0,0 +1,415 @@
+// RCSSweepRunner.cpp - Headless azimuth/elevation RCS sweeps (offscreen GL or CPU)
+#include "RCSSweepRunner.h"
+#include "GLRCSBackend.h"
+#include "CPURCSBackend.h"
+#include "WireframeTarget.h"
+#include "WireframeTargetController.h"
+#include "MeshWireframe.h"
+#include "MeshImporter.h"
+#include "TargetCache.h"
+#include <QFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+// Number of samples in [start, end] at step; fullCircle drops a duplicate 360° end
+int rangeCount(float start, float end, float step, bool fullCircle) {
+    if (step <= 0.0f || end < start) {
+        return 1;
+    }
+    int count = static_cast<int>(std::floor((end - start) / step + 1.0e-4f)) + 1;
+    if (fullCircle && count > 1 && std::abs(start + (count - 1) * step - (start + 360.0f)) < 1.0e-3f) {
+        --count;
+    }
+    return count;
+}
+
+QVector3D sphericalToCartesian(float r, float azimuthDeg, float elevationDeg) {
+    float az = azimuthDeg * kDegToRadF;
+    float el = elevationDeg * kDegToRadF;
+    return QVector3D(r * std::cos(el) * std::cos(az),
+                     r * std::cos(el) * std::sin(az),
+                     r * std::sin(el));
+}
+
+} // namespace
+
+bool SweepOutput::open(const SweepConfig& config) {
+    // Columnar output streams through the writer's I/O thread; CSV is written here
+    columnar_ = config.outputPath.endsWith(".rcsc", Qt::CaseInsensitive);
+    fullCut_ = config.writeFullCut;
+    rows_ = 0;
+    if (columnar_) {
+        std::vector<ResultColumn> columns{{"azimuth_deg"}, {"elevation_deg"}, {"frequency_hz"}, {"hits"},
+                                          {"rays"}, {"monostatic_dbsm"}};
+        if (fullCut_) {
+            columns.push_back({"cut_dbsm", kPolarPlotBins});
+        }
+        if (!writer_.open(config.outputPath, columns, config.compressOutput)) {
+            qCritical() << "RCSSweepRunner:" << writer_.errorString();
+            return false;
+        }
+        row_.assign(writer_.rowWidth(), 0.0f);
+        return true;
+    }
+
+    file_.setFileName(config.outputPath);
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCritical() << "RCSSweepRunner: Cannot open" << config.outputPath << ":" << file_.errorString();
+        return false;
+    }
+    out_.setDevice(&file_);
+    out_.setRealNumberNotation(QTextStream::FixedNotation);
+    out_.setRealNumberPrecision(3);
+
+    // Header
+    out_ << "azimuth_deg,elevation_deg,hits,rays,monostatic_dbsm";
+    if (fullCut_) {
+        for (int bin = 0; bin < kPolarPlotBins; ++bin) {
+            out_ << ",cut_" << bin;
+        }
+    }
+    out_ << "\n";
+    return true;
+}
+
+void SweepOutput::writeRow(float azimuthDegrees, float elevationDegrees, int hits, int rays,
+                           float monostaticDBsm, const std::vector<RCSDataPoint>* cut) {
+    ++rows_;
+    if (columnar_) {
+        row_[0] = azimuthDegrees;
+        row_[1] = elevationDegrees;
+        row_[2] = static_cast<float>(Defaults::kRadarFrequencyHz);
+        row_[3] = static_cast<float>(hits);
+        row_[4] = static_cast<float>(rays);
+        row_[5] = monostaticDBsm;
+        if (fullCut_) {
+            for (int i = 0; i < kPolarPlotBins; ++i) {
+                row_[6 + i] = (*cut)[i].dBsm;
+            }
+        }
+        writer_.appendRow(row_.data());
+        return;
+    }
+
+    out_ << azimuthDegrees << "," << elevationDegrees << "," << hits << "," << rays << "," << monostaticDBsm;
+    if (fullCut_) {
+        for (const RCSDataPoint& point : *cut) {
+            out_ << "," << point.dBsm;
+        }
+    }
+    out_ << "\n";
+}
+
+void SweepOutput::endElevationRow() {
+    if (!columnar_) {
+        out_.flush();
+    }
+}
+
+bool SweepOutput::finish() {
+    if (columnar_) {
+        if (!writer_.finish()) {
+            qCritical() << "RCSSweepRunner:" << writer_.errorString();
+            return false;
+        }
+        return true;
+    }
+    out_.flush();
+    file_.close();
+    return file_.error() == QFileDevice::NoError;
+}
+
+RCSSweepRunner::RCSSweepRunner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+RCSSweepRunner::~RCSSweepRunner() {
+    cleanup();
+}
+
+bool RCSSweepRunner::initialize(SweepBackend backend) {
+    if (isInitialized()) {
+        return true;
+    }
+
+    if (backend == SweepBackend::CPU) {
+        backend_ = std::make_unique<CPURCSBackend>();
+    } else {
+        backend_ = std::make_unique<GLRCSBackend>();
+    }
+    if (!backend_->initialize()) {
+        backend_.reset();
+        return false;
+    }
+    return true;
+}
+
+void RCSSweepRunner::cleanup() {
+    // The target only generated its mesh, it owns no GL resources
+    target_.reset();
+    if (backend_) {
+        backend_->cleanup();
+    }
+    backend_.reset();
+}
+
+int RCSSweepRunner::azimuthCount(const SweepConfig& config) {
+    bool fullCircle = config.azimuthEnd - config.azimuthStart >= 360.0f - 1.0e-3f;
+    return rangeCount(config.azimuthStart, config.azimuthEnd, config.azimuthStep, fullCircle);
+}
+
+int RCSSweepRunner::elevationCount(const SweepConfig& config) {
+    return rangeCount(config.elevationStart, config.elevationEnd, config.elevationStep, false);
+}
+
+int RCSSweepRunner::monostaticBin(float azimuthDegrees) {
+    float wrapped = std::fmod(azimuthDegrees, 360.0f);
+    if (wrapped < 0.0f) {
+        wrapped += 360.0f;
+    }
+    return std::min(static_cast<int>(wrapped), kPolarPlotBins - 1);
+}
+
+bool RCSSweepRunner::loadTarget(const SweepConfig& config) {
+    // Same shape or model file as the last sweep: its mesh and BVH stay, only
+    // the pose and formation are applied
+    if (target_ && config.meshPath == loadedMeshPath_ && config.bvhBuild == loadedBvhBuild_ &&
+        (!config.meshPath.isEmpty() || config.targetType == loadedType_)) {
+        return placeTarget(config);
+    }
+    target_.reset();
+
+    // Model files come from the target cache when it has them (mesh, edges and
+    // usually the BVH); otherwise they are imported and the cache is filled in
+    // once the BVH exists
+    TargetCache cache;
+    CachedTarget cached;
+    bool updateCache = false;
+    if (config.meshPath.isEmpty()) {
+        target_ = WireframeTarget::createTarget(config.targetType);
+    } else {
+        if (config.useTargetCache && cache.load(config.meshPath, cached)) {
+            qDebug() << "RCSSweepRunner: Loaded" << config.meshPath << "from the target cache -"
+                     << cached.mesh->triangleCount() << "triangles" << (cached.bvh ? "with BVH" : "without BVH");
+        } else {
+            if (config.useTargetCache) {
+                qDebug() << "RCSSweepRunner: Target cache miss for" << config.meshPath << "-" << cache.errorString();
+            }
+            MeshImporter importer;
+            auto mesh = std::make_shared<ImportedMesh>();
+            if (!importer.load(config.meshPath, *mesh)) {
+                qCritical() << "RCSSweepRunner: Failed to load" << config.meshPath << "-" << importer.errorString();
+                target_.reset();
+                return false;
+            }
+            qDebug() << "RCSSweepRunner: Loaded" << config.meshPath << "-" << mesh->triangleCount() << "triangles";
+            cached.mesh = std::move(mesh);
+        }
+        // A GPU build has no CPU tree to store
+        updateCache = config.useTargetCache && !cached.bvh && config.bvhBuild == BVHBuild::CPU;
+        target_ = std::make_unique<MeshWireframe>(cached.mesh, cached.edges);
+    }
+
+    // Only the mesh is needed; backends take a copy of the geometry
+    target_->generateMesh();
+
+    if (target_->getIndices().empty()) {
+        qCritical() << "RCSSweepRunner: Target produced no geometry";
+        target_.reset();
+        return false;
+    }
+
+    // A cached tree was built from exactly these vertices and indices
+    if (cached.bvh) {
+        cached.bvh->meshId = 0;
+        cached.bvh->geometryVersion = target_->getGeometryVersion();
+    }
+
+    if (cached.bvh && config.bvhBuild == BVHBuild::CPU) {
+        backend_->setMeshBVH(0, cached.bvh);
+    }
+    // Keeps the cached tree: same geometry version
+    backend_->setMeshGeometry(0, target_->getVertices(), target_->getIndices(),
+                              target_->getGeometryVersion(), target_->getMaterialIds());
+    if (!placeTarget(config)) {
+        target_.reset();
+        return false;
+    }
+    loadedType_ = config.targetType;
+    loadedMeshPath_ = config.meshPath;
+    loadedBvhBuild_ = config.bvhBuild;
+
+    if (updateCache) {
+        BVHSnapshotPtr bvh = backend_->getMeshBVH(0);
+        if (!cache.store(config.meshPath, *cached.mesh, bvh.get(), target_->getEdges())) {
+            qWarning() << "RCSSweepRunner: Could not update the target cache -" << cache.errorString();
+        }
+    }
+    return true;
+}
+
+bool RCSSweepRunner::placeTarget(const SweepConfig& config) {
+    target_->setPosition(config.targetPosition);
+    target_->setRotation(config.targetRotation);
+    target_->setScale(config.targetScale);
+
+    // Lead plus wingmen, every instance on mesh 0
+    QMatrix4x4 lead = target_->getModelMatrix();
+    std::vector<TargetInstance> instances(1);
+    instances[0].modelMatrix = lead;
+    for (const QMatrix4x4& offset : WireframeTargetController::makeVFormation(config.formationCount,
+                                                                              config.formationSpacing)) {
+        TargetInstance instance;
+        instance.modelMatrix = offset * lead;
+        instances.push_back(instance);
+    }
+
+    // Analytic targets put primitives in place of the mesh instances
+    std::vector<AnalyticShape> shapes;
+    if (config.analytic) {
+        shapes = target_->getAnalyticShapes();
+    }
+    std::vector<ScenePrimitive> primitives;
+    appendTargetPrimitives(shapes, instances, primitives);
+    backend_->setPrimitives(primitives);
+    backend_->setInstances(primitives.empty() ? instances : std::vector<TargetInstance>());
+    return backend_->waitForScene();
+}
+
+void RCSSweepRunner::beginRun(uint64_t cancelGeneration) {
+    runGeneration_ = cancelGeneration == kCurrentCancelGeneration ? cancelGeneration_.load() : cancelGeneration;
+}
+
+bool RCSSweepRunner::run(const SweepConfig& config, uint64_t cancelGeneration) {
+    if (!isInitialized()) {
+        qCritical() << "RCSSweepRunner::run - Not initialized";
+        return false;
+    }
+    beginRun(cancelGeneration);
+
+    SweepOutput output;
+    if (!output.open(config)) {
+        return false;
+    }
+    auto writeRow = [&](float azimuth, float elevation, const LookCut& look) {
+        output.writeRow(azimuth, elevation, look.hitCount, raysPerLook_,
+                        look.cut[monostaticBin(azimuth)].dBsm, &look.cut);
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    bool traced = traceGrid(config, writeRow, [&output]() { output.endElevationRow(); });
+    bool written = output.finish();
+    if (!traced) {
+        return false;
+    }
+    const int completed = output.rowCount();
+
+    // Rays/sec is the figure to compare traversal modes and BVH layouts by
+    const int total = azimuthCount(config) * elevationCount(config);
+    qint64 elapsedMs = std::max<qint64>(timer.elapsed(), 1);
+    double raysPerSecond = 1000.0 * completed * raysPerLook_ / elapsedMs;
+    qDebug() << "RCSSweepRunner:" << completed << "of" << total << "positions in"
+             << elapsedMs << "ms," << raysPerSecond << "rays/s," << backend_->describe()
+             << "->" << config.outputPath;
+    return !isCancelled() && written;
+}
+
+bool RCSSweepRunner::run(const SweepConfig& config, const LookCallback& onLook, uint64_t cancelGeneration) {
+    if (!isInitialized()) {
+        qCritical() << "RCSSweepRunner::run - Not initialized";
+        return false;
+    }
+    beginRun(cancelGeneration);
+    return traceGrid(config, onLook, []() {}) && !isCancelled();
+}
+
+bool RCSSweepRunner::traceGrid(const SweepConfig& config, const LookCallback& onLook,
+                               const std::function<void()>& onRow) {
+    // Settings first: bvhBuild decides how loadTarget()'s mesh is built
+    TraceSettings settings;
+    settings.sphereRadius = config.sphereRadius;
+    settings.beamWidthDegrees = config.beamWidthDegrees;
+    settings.numRays = config.numRays;
+    settings.sampling = config.sampling;
+    settings.maxBounces = config.maxBounces;
+    settings.bounceCutoff = config.bounceCutoff;
+    settings.rouletteThreshold = config.rouletteThreshold;
+    settings.traversal = config.traversal;
+    settings.bvhLayout = config.bvhLayout;
+    settings.bvhBuild = config.bvhBuild;
+    settings.trianglePrecision = config.trianglePrecision;
+    settings.rayReordering = config.rayReordering;
+    settings.persistentThreads = config.persistentThreads;
+    settings.normalConeCulling = config.normalConeCulling;
+    settings.temporalReuse = config.temporalReuse;
+    settings.threads = config.cpuThreads;
+    for (const QString& name : config.materials) {
+        const MaterialPreset* preset = findMaterialPreset(name.toUtf8().constData());
+        settings.materials.push_back(preset ? preset->material : Material());
+    }
+    backend_->applySettings(settings);
+    if (!loadTarget(config)) {
+        return false;
+    }
+    raysPerLook_ = backend_->getNumRays();
+
+    const int numAzimuth = azimuthCount(config);
+    const int numElevation = elevationCount(config);
+    const int total = numAzimuth * numElevation;
+    int completed = 0;
+
+    std::vector<RadarLook> looks;
+    std::vector<LookCut> cuts;
+    looks.reserve(kMaxLooksPerDispatch);
+
+    for (int e = 0; e < numElevation && !isCancelled(); ++e) {
+        float elevation = config.elevationStart + e * config.elevationStep;
+
+        // Azimuth cut through the radar's own elevation - the monostatic return
+        // lands in the bin at the radar azimuth
+        BinningSlice slice;
+        slice.cutType = static_cast<int>(CutType::Azimuth);
+        slice.offsetDegrees = elevation;
+        slice.thicknessDegrees = config.sliceThicknessDegrees;
+
+        // Up to kMaxLooksPerDispatch azimuths of the row per call; cancel()
+        // takes effect between calls on either backend
+        for (int first = 0; first < numAzimuth && !isCancelled(); first += kMaxLooksPerDispatch) {
+            int count = std::min(kMaxLooksPerDispatch, numAzimuth - first);
+            looks.clear();
+            for (int a = first; a < first + count; ++a) {
+                float azimuth = config.azimuthStart + a * config.azimuthStep;
+                QVector3D radarPos = sphericalToCartesian(config.sphereRadius, azimuth, elevation);
+                looks.push_back({radarPos, -radarPos.normalized(), slice});
+            }
+
+            if (!backend_->traceLooks(looks, cuts)) {
+                qCritical() << "RCSSweepRunner: Tracing failed at elevation" << elevation;
+                return false;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                float azimuth = config.azimuthStart + (first + i) * config.azimuthStep;
+                onLook(azimuth, elevation, cuts[i]);
+            }
+            completed += count;
+        }
+
+        onRow();
+        emit progress(completed, total);
+    }
+    return true;
+}
+
+} // namespace RCS
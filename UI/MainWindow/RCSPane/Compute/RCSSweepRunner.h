@@ -0,0 +1,183 @@
+// RCSSweepRunner.h - Headless azimuth/elevation RCS sweeps (offscreen GL or CPU)
+#pragma once
+
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector3D>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "RCSBackend.h"
+#include "RCSResultFile.h"
+#include "WireframeShapes.h"
+#include "Constants.h"
+
+class WireframeTarget;
+
+namespace RCS {
+
+// Where a sweep is traced
+enum class SweepBackend {
+    GPU = 0,  // GLRCSBackend - RCSCompute on an offscreen GL 4.3 context
+    CPU = 1   // CPURCSBackend - CPURayTracer, no GL needed
+};
+
+// One sweep: a target, a grid of radar positions and where to write results.
+// Angles follow RadarGLWidget (azimuth from +X toward +Y, elevation from the XY plane).
+struct SweepConfig {
+    // Target - a built-in shape, or a model file (MeshImporter) when meshPath is set
+    WireframeType targetType = WireframeType::Cube;
+    QString meshPath;
+    bool useTargetCache = true;  // Load/store meshPath through TargetCache
+    QVector3D targetPosition{RS::Constants::Defaults::kTargetPositionX,
+                             RS::Constants::Defaults::kTargetPositionY,
+                             RS::Constants::Defaults::kTargetPositionZ};
+    QVector3D targetRotation;  // pitch, yaw, roll in degrees
+    float targetScale = RS::Constants::Defaults::kTargetScale;
+    // Formation - formationCount copies of the target in a V behind the lead
+    // (WireframeTargetController::makeVFormation), all sharing one BVH
+    int formationCount = 1;
+    float formationSpacing = RS::Constants::kSweepFormationSpacing;
+    // Trace the target's exact surfaces (WireframeTarget::getAnalyticShapes:
+    // sphere, cylinder, plate, dihedral, trihedral) instead of its triangles.
+    // Targets without any keep tracing their mesh.
+    bool analytic = false;
+
+    // Radar positions. Both ranges are inclusive, except that a full 360° azimuth
+    // span skips the end angle (it duplicates the start).
+    float sphereRadius = RS::Constants::Defaults::kSphereRadius;
+    float azimuthStart = 0.0f;
+    float azimuthEnd = 360.0f;
+    float azimuthStep = 1.0f;
+    float elevationStart = -90.0f;
+    float elevationEnd = 90.0f;
+    float elevationStep = 1.0f;
+
+    // Tracing
+    int numRays = RS::Constants::kDefaultNumRays;
+    float beamWidthDegrees = RS::Constants::Defaults::kBeamWidth;
+    float sliceThicknessDegrees = RS::Constants::kSweepSliceThickness;
+    RaySampling sampling = RaySampling::Rings;
+    int maxBounces = 1;  // GPU backend only - the CPU tracer stops at the first hit
+    // Multi-bounce termination (RCSCompute::setBounceTermination), GPU backend only
+    float bounceCutoff = RS::Constants::kBounceCutoffIntensity;
+    float rouletteThreshold = RS::Constants::kBounceRouletteThreshold;
+    TraversalMode traversal = TraversalMode::Stack;
+    BVHLayout bvhLayout = BVHLayout::Binary;
+    BVHBuild bvhBuild = BVHBuild::CPU;  // GPU backend only; GPU skips the target cache's tree
+    TrianglePrecision trianglePrecision = TrianglePrecision::Full;  // GPU backend only
+    bool rayReordering = false;      // GPU backend only (RCSCompute::setRayReordering)
+    bool persistentThreads = false;  // GPU backend only (RCSCompute::setPersistentThreads)
+    bool normalConeCulling = false;  // GPU backend only, closed targets (RCSCompute::setNormalConeCulling)
+    bool temporalReuse = false;      // GPU backend only (RCSCompute::setTemporalReuse)
+    int cpuThreads = 0;  // CPU backend worker threads (0 = one per hardware thread)
+    // Material table (GPU backend): kMaterialPresets names, entry i shading
+    // imported material ID i. IDs past the end use the last entry; empty = keep
+    // the default table.
+    QStringList materials;
+
+    // Output - one row per radar position. writeFullCut appends the whole
+    // kPolarPlotBins azimuth cut (dBsm) to every row. A ".rcsc" path is written
+    // as chunked binary columns (RCSResultWriter), anything else as CSV.
+    QString outputPath;
+    bool writeFullCut = false;
+    bool compressOutput = false;  // .rcsc only - qCompress every column block
+};
+
+// The rows of a sweep on disk: CSV, or chunked columns (RCSResultWriter) for
+// a ".rcsc" path. Shared by RCSSweepRunner and RCSSweepCoordinator, so a
+// distributed sweep writes the same file as a local one.
+class SweepOutput {
+public:
+    bool open(const SweepConfig& config);  // false (logged) if the file cannot be created
+    // cut (kPolarPlotBins points) is only read with config.writeFullCut
+    void writeRow(float azimuthDegrees, float elevationDegrees, int hits, int rays, float monostaticDBsm,
+                  const std::vector<RCSDataPoint>* cut);
+    void endElevationRow();  // Flushes CSV, so partial sweeps stay usable
+    bool finish();           // false (logged) if any write failed
+
+    int rowCount() const { return rows_; }
+
+private:
+    bool columnar_ = false;
+    bool fullCut_ = false;
+    int rows_ = 0;
+    QFile file_;
+    QTextStream out_;
+    RCSResultWriter writer_;
+    std::vector<float> row_;
+};
+
+// Traces radar positions back-to-back through an RCSBackend, without any
+// widget or repaint, up to kMaxLooksPerDispatch positions per call. The GL
+// backend has an offscreen context of its own; the CPU backend is for machines
+// without GL 4.3. The BVH is built once and stays resident for the whole
+// sweep; rows are streamed to disk as they finish. A runner can run any
+// number of sweeps: while the target's type or model file stays the same,
+// the next sweep only re-poses it and keeps its BVH.
+class RCSSweepRunner : public QObject {
+    Q_OBJECT
+
+public:
+    // One traced look of a sweep, in grid order
+    using LookCallback = std::function<void(float azimuthDegrees, float elevationDegrees, const LookCut& look)>;
+
+    explicit RCSSweepRunner(QObject* parent = nullptr);
+    ~RCSSweepRunner() override;
+
+    // Creates the backend (GPU must be created and run on the GUI thread)
+    bool initialize(SweepBackend backend = SweepBackend::GPU);
+    bool isInitialized() const { return backend_ != nullptr; }
+
+    // Runs the whole sweep synchronously. Returns false if the output could not
+    // be written or the context failed; cancel() stops after the current batch
+    // and may be called from any thread. A sweep given the cancelGeneration()
+    // seen when it was queued is also stopped by every cancel() since, even
+    // one made before it started; by default only later cancels count.
+    bool run(const SweepConfig& config, uint64_t cancelGeneration = kCurrentCancelGeneration);
+    // Same sweep, but every look goes to onLook instead of outputPath
+    bool run(const SweepConfig& config, const LookCallback& onLook,
+             uint64_t cancelGeneration = kCurrentCancelGeneration);
+    void cancel() { ++cancelGeneration_; }
+    uint64_t cancelGeneration() const { return cancelGeneration_.load(); }
+    static constexpr uint64_t kCurrentCancelGeneration = ~0ull;
+
+    // Rays traced per look by the last sweep
+    int getRaysPerLook() const { return raysPerLook_; }
+
+    static int azimuthCount(const SweepConfig& config);
+    static int elevationCount(const SweepConfig& config);
+    // Bin of a look's azimuth cut that holds the return toward the radar
+    static int monostaticBin(float azimuthDegrees);
+
+signals:
+    void progress(int completed, int total);
+
+private:
+    bool loadTarget(const SweepConfig& config);
+    bool placeTarget(const SweepConfig& config);
+    // Loads the target, applies the trace settings and traces the grid;
+    // onRow runs after each elevation row
+    bool traceGrid(const SweepConfig& config, const LookCallback& onLook, const std::function<void()>& onRow);
+    void cleanup();
+    void beginRun(uint64_t cancelGeneration);
+    bool isCancelled() const { return cancelGeneration_.load() != runGeneration_; }
+
+    std::unique_ptr<RCSBackend> backend_;
+    std::unique_ptr<WireframeTarget> target_;
+    // Source of target_, to tell a new target from a new pose
+    WireframeType loadedType_ = WireframeType::Cube;
+    QString loadedMeshPath_;
+    BVHBuild loadedBvhBuild_ = BVHBuild::CPU;
+    int raysPerLook_ = 0;
+    // cancel() bumps the generation; a run stops once it differs from the
+    // one the run started from, so a cancel is never cleared by a later start
+    std::atomic<uint64_t> cancelGeneration_{0};
+    uint64_t runGeneration_ = 0;
+};
+
+} // namespace RCS
@@ -0,0 +1,318 @@
+// RCSTrajectoryPlayer.cpp - Timeline playback of target and radar poses with RCS traced ahead of the playhead
+#include "RCSTrajectoryPlayer.h"
+#include "GLRCSBackend.h"
+#include "CPURCSBackend.h"
+#include "WireframeTargetController.h"
+#include <QFile>
+#include <QTextStream>
+#include <QQuaternion>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr int kKeyframeFields = 9;
+
+QVector3D sphericalToCartesian(float r, float azimuthDeg, float elevationDeg) {
+    float az = azimuthDeg * kDegToRadF;
+    float el = elevationDeg * kDegToRadF;
+    return QVector3D(r * std::cos(el) * std::cos(az),
+                     r * std::cos(el) * std::sin(az),
+                     r * std::sin(el));
+}
+
+// Shortest way round from a to b
+float lerpDegrees(float a, float b, float t) {
+    float delta = std::fmod(b - a, 360.0f);
+    if (delta > 180.0f) {
+        delta -= 360.0f;
+    } else if (delta < -180.0f) {
+        delta += 360.0f;
+    }
+    float angle = std::fmod(a + delta * t, 360.0f);
+    return angle < 0.0f ? angle + 360.0f : angle;
+}
+
+} // namespace
+
+RCSTrajectoryPlayer::RCSTrajectoryPlayer(QObject* parent)
+    : QObject(parent)
+    , ring_(kTrajectoryRingKeyframes)
+{
+    timer_.setTimerType(Qt::PreciseTimer);
+    timer_.setInterval(1000 / kTrajectoryPlaybackHz);
+    connect(&timer_, &QTimer::timeout, this, &RCSTrajectoryPlayer::tick);
+}
+
+RCSTrajectoryPlayer::~RCSTrajectoryPlayer() {
+    stop();
+    if (backend_) {
+        backend_->cleanup();
+    }
+}
+
+bool RCSTrajectoryPlayer::loadTrajectory(const QString& path) {
+    error_.clear();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error_ = "Cannot open " + path + ": " + file.errorString();
+        return false;
+    }
+
+    std::vector<TrajectoryKeyframe> keyframes;
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QStringList fields = line.split(',');
+        float values[kKeyframeFields] = {};
+        bool ok = fields.size() >= kKeyframeFields;
+        for (int i = 0; ok && i < kKeyframeFields; ++i) {
+            values[i] = fields[i].trimmed().toFloat(&ok);
+        }
+        if (!ok) {
+            if (keyframes.empty() && lineNumber == 1) {
+                continue;  // Column header
+            }
+            error_ = QString("%1 line %2: expected time,x,y,z,pitch,yaw,roll,azimuth,elevation").arg(path).arg(lineNumber);
+            return false;
+        }
+
+        TrajectoryKeyframe key;
+        key.time = values[0];
+        key.position = QVector3D(values[1], values[2], values[3]);
+        key.rotation = QVector3D(values[4], values[5], values[6]);
+        key.azimuth = values[7];
+        key.elevation = values[8];
+        if (!keyframes.empty() && key.time <= keyframes.back().time) {
+            error_ = QString("%1 line %2: keyframe times must increase").arg(path).arg(lineNumber);
+            return false;
+        }
+        keyframes.push_back(key);
+    }
+
+    if (keyframes.size() < 2) {
+        error_ = path + " needs at least two keyframes";
+        return false;
+    }
+    stop();
+    keyframes_ = std::move(keyframes);
+    qDebug() << "RCSTrajectoryPlayer:" << keyframes_.size() << "keyframes," << duration() << "s from" << path;
+    return true;
+}
+
+double RCSTrajectoryPlayer::duration() const {
+    return keyframes_.empty() ? 0.0 : keyframes_.back().time - keyframes_.front().time;
+}
+
+bool RCSTrajectoryPlayer::setTarget(const WireframeTargetController& controller) {
+    error_.clear();
+    WireframeTarget* target = controller.getTarget();
+    if (!target || target->getIndices().empty()) {
+        error_ = "The scene has no target geometry";
+        return false;
+    }
+
+    if (!backend_) {
+        backend_ = std::make_unique<GLRCSBackend>();
+        if (!backend_->initialize()) {
+            qWarning() << "RCSTrajectoryPlayer: GL 4.3 backend unavailable, tracing on the CPU";
+            backend_ = std::make_unique<CPURCSBackend>();
+            backend_->initialize();
+        }
+        backend_->applySettings(settings_);
+    }
+
+    // Wingmen keep their place relative to the lead at every keyframe
+    std::vector<QMatrix4x4> matrices;
+    controller.getInstanceModelMatrices(matrices);
+    QMatrix4x4 leadInverse = target->getModelMatrix().inverted();
+    formationOffsets_.clear();
+    for (size_t i = 1; i < matrices.size(); ++i) {
+        formationOffsets_.push_back(matrices[i] * leadInverse);
+    }
+    scale_ = target->getScale();
+
+    // Geometry in object space: the BVH is built here once and never again
+    // during playback, whatever the keyframes do to the pose
+    backend_->setMeshGeometry(0, target->getVertices(), target->getIndices(), target->getGeometryVersion());
+    std::vector<TargetInstance> instances(1);
+    instances[0].modelMatrix = target->getModelMatrix();
+    backend_->setInstances(instances);
+    hasTarget_ = backend_->waitForScene();
+    if (!hasTarget_) {
+        error_ = "The target BVH could not be built";
+    }
+    return hasTarget_;
+}
+
+void RCSTrajectoryPlayer::setTraceSettings(const TraceSettings& settings, float sliceThicknessDegrees) {
+    settings_ = settings;
+    sliceThickness_ = sliceThicknessDegrees;
+    if (backend_) {
+        backend_->applySettings(settings_);
+    }
+}
+
+bool RCSTrajectoryPlayer::start() {
+    if (!hasTarget_ || keyframes_.size() < 2) {
+        error_ = hasTarget_ ? "No trajectory loaded" : "No target loaded";
+        return false;
+    }
+    stop();
+    for (Slot& slot : ring_) {
+        slot.keyframe = -1;
+    }
+    headKeyframe_ = 0;
+    nextToTrace_ = 0;
+    stalls_ = 0;
+    minDbsm_ = kDBsmFloor;
+    maxDbsm_ = kDBsmFloor + 1.0f;
+    hasRange_ = false;
+    // The first tick lands on the first keyframe
+    playTime_ = keyframes_.front().time - 1.0 / kTrajectoryPlaybackHz;
+    timer_.start();
+    return true;
+}
+
+void RCSTrajectoryPlayer::stop() {
+    if (!timer_.isActive()) {
+        return;
+    }
+    timer_.stop();
+    if (stalls_ > 0) {
+        qDebug() << "RCSTrajectoryPlayer: Held" << stalls_ << "ticks waiting for traces -" << backend_->describe();
+    }
+}
+
+void RCSTrajectoryPlayer::tick() {
+    precompute();
+    if (!timer_.isActive()) {
+        return;  // Tracing failed
+    }
+
+    // Advance only once both keyframes around the next time are traced
+    double next = std::min(playTime_ + 1.0 / kTrajectoryPlaybackHz, keyframes_.back().time);
+    int keyframe = keyframeAt(next);
+    int following = std::min(keyframe + 1, static_cast<int>(keyframes_.size()) - 1);
+    if (!isTraced(keyframe) || !isTraced(following)) {
+        ++stalls_;
+        return;
+    }
+
+    playTime_ = next;
+    headKeyframe_ = keyframe;
+    buildFrame(keyframe, playTime_);
+    emit frameReady(frame_);
+
+    if (playTime_ >= keyframes_.back().time) {
+        stop();
+        emit finished();
+    }
+}
+
+void RCSTrajectoryPlayer::precompute() {
+    const int count = static_cast<int>(keyframes_.size());
+    QElapsedTimer budget;
+    budget.start();
+    while (nextToTrace_ < count && nextToTrace_ < headKeyframe_ + kTrajectoryRingKeyframes &&
+           budget.elapsed() < kTrajectoryTraceBudgetMs) {
+        if (!traceKeyframe(nextToTrace_)) {
+            qWarning() << "RCSTrajectoryPlayer: Tracing failed at keyframe" << nextToTrace_;
+            error_ = "Tracing failed";
+            stop();
+            return;
+        }
+        ++nextToTrace_;
+    }
+}
+
+bool RCSTrajectoryPlayer::traceKeyframe(int keyframe) {
+    const TrajectoryKeyframe& key = keyframes_[keyframe];
+
+    // Same composition as WireframeTarget::buildModelMatrix
+    QMatrix4x4 lead;
+    lead.translate(key.position);
+    lead.rotate(QQuaternion::fromEulerAngles(key.rotation));
+    lead.scale(scale_);
+    instances_.resize(1 + formationOffsets_.size());
+    instances_[0].modelMatrix = lead;
+    for (size_t i = 0; i < formationOffsets_.size(); ++i) {
+        instances_[i + 1].modelMatrix = formationOffsets_[i] * lead;
+    }
+    backend_->setInstances(instances_);  // TLAS only - the mesh BVH is untouched
+
+    BinningSlice slice;
+    slice.cutType = static_cast<int>(CutType::Azimuth);
+    slice.offsetDegrees = key.elevation;
+    slice.thicknessDegrees = sliceThickness_;
+    QVector3D radarPos = sphericalToCartesian(settings_.sphereRadius, key.azimuth, key.elevation);
+    looks_.assign(1, {radarPos, -radarPos.normalized(), slice});
+    if (!backend_->traceLooks(looks_, cuts_)) {
+        return false;
+    }
+
+    // Swap keeps the slot's cut capacity for the keyframe after next lap
+    Slot& slot = ring_[keyframe % kTrajectoryRingKeyframes];
+    std::swap(slot.look, cuts_[0]);
+    slot.keyframe = keyframe;
+
+    for (const RCSDataPoint& point : slot.look.cut) {
+        if (point.dBsm <= kDBsmFloor) {
+            continue;
+        }
+        minDbsm_ = hasRange_ ? std::min(minDbsm_, point.dBsm) : point.dBsm - 1.0f;
+        maxDbsm_ = hasRange_ ? std::max(maxDbsm_, point.dBsm) : point.dBsm;
+        hasRange_ = true;
+    }
+    return true;
+}
+
+bool RCSTrajectoryPlayer::isTraced(int keyframe) const {
+    return ring_[keyframe % kTrajectoryRingKeyframes].keyframe == keyframe;
+}
+
+int RCSTrajectoryPlayer::keyframeAt(double time) const {
+    auto after = std::upper_bound(keyframes_.begin(), keyframes_.end(), time,
+                                  [](double t, const TrajectoryKeyframe& key) { return t < key.time; });
+    int index = static_cast<int>(after - keyframes_.begin()) - 1;
+    return std::clamp(index, 0, static_cast<int>(keyframes_.size()) - 1);
+}
+
+void RCSTrajectoryPlayer::buildFrame(int keyframe, double time) {
+    int following = std::min(keyframe + 1, static_cast<int>(keyframes_.size()) - 1);
+    const TrajectoryKeyframe& a = keyframes_[keyframe];
+    const TrajectoryKeyframe& b = keyframes_[following];
+    float t = following == keyframe ? 0.0f : static_cast<float>((time - a.time) / (b.time - a.time));
+    t = std::clamp(t, 0.0f, 1.0f);
+
+    frame_.time = time;
+    frame_.position = a.position + (b.position - a.position) * t;
+    frame_.rotation = QQuaternion::slerp(QQuaternion::fromEulerAngles(a.rotation),
+                                         QQuaternion::fromEulerAngles(b.rotation), t).toEulerAngles();
+    frame_.azimuth = lerpDegrees(a.azimuth, b.azimuth, t);
+    frame_.elevation = a.elevation + (b.elevation - a.elevation) * t;
+
+    // Per-bin dBsm blend; a bin counts as hit if either keyframe hit it
+    const std::vector<RCSDataPoint>& cutA = ring_[keyframe % kTrajectoryRingKeyframes].look.cut;
+    const std::vector<RCSDataPoint>& cutB = ring_[following % kTrajectoryRingKeyframes].look.cut;
+    frame_.cut.resize(cutA.size());
+    for (size_t i = 0; i < cutA.size(); ++i) {
+        float dBsm = i < cutB.size() ? cutA[i].dBsm + (cutB[i].dBsm - cutA[i].dBsm) * t : cutA[i].dBsm;
+        bool valid = cutA[i].valid || (i < cutB.size() && cutB[i].valid);
+        frame_.cut[i] = RCSDataPoint(cutA[i].angleDegrees, dBsm, valid);
+    }
+}
+
+} // namespace RCS
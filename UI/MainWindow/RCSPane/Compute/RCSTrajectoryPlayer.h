@@ -0,0 +1,119 @@
+// RCSTrajectoryPlayer.h - Timeline playback of target and radar poses with RCS traced ahead of the playhead
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector3D>
+#include <QMatrix4x4>
+#include <memory>
+#include <vector>
+
+#include "RCSBackend.h"
+#include "Constants.h"
+
+class WireframeTargetController;
+
+namespace RCS {
+
+// One pose of a trajectory. Angles follow RadarGLWidget (azimuth from +X
+// toward +Y, elevation from the XY plane).
+struct TrajectoryKeyframe {
+    double time = 0.0;   // Seconds from the start of the timeline
+    QVector3D position;
+    QVector3D rotation;  // pitch, yaw, roll in degrees
+    float azimuth = 0.0f;
+    float elevation = 0.0f;
+};
+
+// What one playback tick shows, interpolated between the bracketing keyframes
+struct TrajectoryFrame {
+    double time = 0.0;
+    QVector3D position;
+    QVector3D rotation;  // pitch, yaw, roll in degrees
+    float azimuth = 0.0f;
+    float elevation = 0.0f;
+    std::vector<RCSDataPoint> cut;
+};
+
+// Plays a trajectory at kTrajectoryPlaybackHz. The target's mesh and BVH are
+// loaded into an RCSBackend once, in object space; each keyframe only moves
+// the instances (a TLAS update) and traces one look. Traced keyframes live in
+// a ring of kTrajectoryRingKeyframes slots ahead of the playhead, refilled for
+// at most kTrajectoryTraceBudgetMs per tick, so frames between keyframes are
+// interpolated from cuts that are already there. When tracing falls behind the
+// playhead holds on the last frame rather than showing a stale look; those
+// ticks are counted in stalls(). Runs on the GUI thread (GLRCSBackend needs it).
+class RCSTrajectoryPlayer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit RCSTrajectoryPlayer(QObject* parent = nullptr);
+    ~RCSTrajectoryPlayer() override;
+
+    // CSV, one keyframe per line: time,x,y,z,pitch,yaw,roll,azimuth,elevation.
+    // '#' comments and a header line are skipped; times must increase.
+    bool loadTrajectory(const QString& path);
+    const std::vector<TrajectoryKeyframe>& keyframes() const { return keyframes_; }
+    double duration() const;
+
+    // Copies the controller's mesh, scale and formation into the backend and
+    // waits for the BVH. Creates the backend on first use - GL, or the CPU
+    // tracer where GL 4.3 is missing.
+    bool setTarget(const WireframeTargetController& controller);
+    void setTraceSettings(const TraceSettings& settings, float sliceThicknessDegrees);
+
+    bool start();
+    void stop();
+    bool isPlaying() const { return timer_.isActive(); }
+    int stalls() const { return stalls_; }
+    QString errorString() const { return error_; }
+
+    // dBsm range of the keyframes traced so far, for the heat map scale
+    float minDbsm() const { return minDbsm_; }
+    float maxDbsm() const { return maxDbsm_; }
+
+signals:
+    void frameReady(const TrajectoryFrame& frame);
+    void finished();
+
+private:
+    struct Slot {
+        int keyframe = -1;  // Keyframe whose cut the slot holds
+        LookCut look;
+    };
+
+    void tick();
+    void precompute();
+    bool traceKeyframe(int keyframe);
+    bool isTraced(int keyframe) const;
+    int keyframeAt(double time) const;  // Last keyframe at or before time
+    void buildFrame(int keyframe, double time);
+
+    std::unique_ptr<RCSBackend> backend_;
+    TraceSettings settings_;
+    float sliceThickness_ = RS::Constants::kSweepSliceThickness;
+    QVector3D scale_{1.0f, 1.0f, 1.0f};
+    std::vector<QMatrix4x4> formationOffsets_;  // World-space offsets of the wingmen from the lead
+    bool hasTarget_ = false;
+
+    std::vector<TrajectoryKeyframe> keyframes_;
+    std::vector<Slot> ring_;  // Keyframe k lives in slot k % kTrajectoryRingKeyframes
+    int headKeyframe_ = 0;    // Keyframes before it are played and may be overwritten
+    int nextToTrace_ = 0;
+    double playTime_ = 0.0;
+
+    std::vector<TargetInstance> instances_;
+    std::vector<RadarLook> looks_;
+    std::vector<LookCut> cuts_;
+    TrajectoryFrame frame_;
+
+    QTimer timer_;
+    int stalls_ = 0;
+    float minDbsm_ = RS::Constants::kDBsmFloor;
+    float maxDbsm_ = RS::Constants::kDBsmFloor + 1.0f;
+    bool hasRange_ = false;
+    QString error_;
+};
+
+} // namespace RCS
@@ -1,39 +1,365 @@
 // RCSTypes.h - GPU-aligned data structures for RCS computation
 #pragma once
 
+#include <QVector3D>
 #include <QVector4D>
+#include <QMatrix4x4>
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstdint>
+#include <vector>
+
+#include "WireframeShapes.h"
 
 namespace RCS {
 
 // Ray structure - 32 bytes, GPU cache-line aligned
 struct alignas(16) Ray {
-    QVector4D origin;      // xyz = origin, w = tmin
+    QVector4D origin;      // xyz = origin, w = two-way beam pattern weight (tmin is fixed at 0.001)
     QVector4D direction;   // xyz = direction (normalized), w = tmax
 };
 
-// BVH Node structure - 32 bytes
+// BVH Node structure - 32 bytes. Nodes are stored depth-first, so an internal
+// node's left child is always the next node and w carries the split axis instead.
 struct alignas(16) BVHNode {
-    QVector4D boundsMin;   // xyz = AABB min, w = left child index (negative = leaf)
+    QVector4D boundsMin;   // xyz = AABB min, w = split axis 0-2 (leaf: -firstTri-1)
     QVector4D boundsMax;   // xyz = AABB max, w = right child (or triangle count for leaf)
 };
 
-// Triangle structure for GPU - 48 bytes (3 vertices, position only)
+// Four-wide BVH node - 64 bytes, one cache line (BVHBuilder::getWideNodes).
+// Child boxes are 8-bit offsets from origin in steps of 2^exponent per axis,
+// rounded outward so a quantized box always contains the exact one.
+struct alignas(16) WideBVHNode {
+    float origin[3];        // Minimum of the node's bounds
+    uint32_t exponents;     // Biased (+127) power-of-two step, one byte per axis (x, y, z)
+    uint32_t children[4];   // Wide node index, leaf (kWideBVHLeafFlag | count << 24 | firstTri) or empty
+    uint32_t quantLo[3];    // Per axis, byte i = child i lower bound
+    uint32_t pad0;
+    uint32_t quantHi[3];    // Per axis, byte i = child i upper bound
+    uint32_t pad1;
+};
+static_assert(sizeof(WideBVHNode) == 64, "WideBVHNode must match the GLSL std430 layout");
+
+// Octahedral encoding of a unit vector as snorm 2x16 (zero vector -> +Z), bit
+// for bit what the shaders' octEncode/packSnorm2x16 produce
+inline uint32_t octEncodeUnit(const QVector3D& v) {
+    float s = std::abs(v.x()) + std::abs(v.y()) + std::abs(v.z());
+    if (s == 0.0f) return 0u;
+    float x = v.x() / s;
+    float y = v.y() / s;
+    if (v.z() < 0.0f) {
+        float ox = x;
+        x = (1.0f - std::abs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+        y = (1.0f - std::abs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+    }
+    auto snorm = [](float f) {
+        return static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(
+            std::lround(std::clamp(f, -1.0f, 1.0f) * 32767.0f))));
+    };
+    return snorm(x) | (snorm(y) << 16);
+}
+
+// Inverse of octEncodeUnit, matching the shaders' octDecode
+inline QVector3D octDecodeUnit(uint32_t packed) {
+    // unpackSnorm2x16: x in the low 16 bits
+    float x = std::clamp(static_cast<int16_t>(packed & 0xFFFFu) / 32767.0f, -1.0f, 1.0f);
+    float y = std::clamp(static_cast<int16_t>(packed >> 16) / 32767.0f, -1.0f, 1.0f);
+    QVector3D n(x, y, 1.0f - std::abs(x) - std::abs(y));
+    if (n.z() < 0.0f) {
+        n.setX((1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f));
+        n.setY((1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f));
+    }
+    return n.normalized();
+}
+
+// Triangle structure for GPU - 48 bytes. Edges are precomputed so the trace
+// kernel's Moller-Trumbore test skips two subtractions, and the fourth lane of
+// each vec4 carries per-triangle data instead of padding.
 struct alignas(16) Triangle {
-    QVector4D v0;          // xyz = vertex 0, w = unused
-    QVector4D v1;          // xyz = vertex 1, w = unused
-    QVector4D v2;          // xyz = vertex 2, w = unused
+    float v0[3];          // Vertex 0
+    uint32_t normalOct;   // Unit geometric normal (e1 x e2), octahedral snorm 2x16
+    float e1[3];          // Vertex 1 - vertex 0
+    uint32_t materialId;  // Reported in HitResult::normal.w (0 = default)
+    float e2[3];          // Vertex 2 - vertex 0
+    uint32_t sourceIndex; // Index of the triangle in the mesh's index buffer (before BVH sorting)
+
+    void setVertices(const QVector3D& a, const QVector3D& b, const QVector3D& c) {
+        QVector3D edge1 = b - a;
+        QVector3D edge2 = c - a;
+        for (int i = 0; i < 3; i++) {
+            v0[i] = a[i];
+            e1[i] = edge1[i];
+            e2[i] = edge2[i];
+        }
+        normalOct = octEncodeUnit(QVector3D::crossProduct(edge1, edge2).normalized());
+    }
+
+    QVector3D vertex0() const { return QVector3D(v0[0], v0[1], v0[2]); }
+    QVector3D edge1() const { return QVector3D(e1[0], e1[1], e1[2]); }
+    QVector3D edge2() const { return QVector3D(e2[0], e2[1], e2[2]); }
+    QVector3D normal() const { return octDecodeUnit(normalOct); }
+};
+static_assert(sizeof(Triangle) == 48, "Triangle must match the GLSL std430 layout");
+
+// Compact triangle - 24 bytes (TrianglePrecision::Compact). Vertices are 16-bit
+// offsets from the box of the BVH leaf that holds the triangle, in power-of-two
+// steps per axis (compactStepExponent). Offsets never leave that box, so the
+// decoded triangle is always inside the bounds the traversal tested.
+struct CompactTriangle {
+    uint16_t q[9];        // v0, v1, v2 (x, y, z each)
+    uint16_t materialId;
+    uint32_t normalOct;   // Unit geometric normal of the full-precision triangle
+};
+static_assert(sizeof(CompactTriangle) == 24, "CompactTriangle must match the GLSL std430 layout");
+
+// Step exponent for one axis of a leaf box: the extent spans fewer than 2^16
+// steps. Same as the shader's compactStep (frexp, no division).
+inline int compactStepExponent(float extent) {
+    int exponent = 0;
+    std::frexp(extent, &exponent);
+    return std::max(exponent - 16, -126);
+}
+
+// Top-level BVH instance - 128 bytes. Places one bottom-level (per-mesh) BVH in
+// the scene; every instance of a mesh shares its nodes and triangles.
+struct alignas(16) InstanceData {
+    float invModel[16];       // World -> object space, column-major mat4
+    float normalMatrix[12];   // Object -> world normals, mat3 as three vec4 columns (std430)
+    uint32_t nodeOffset;      // Mesh root in the shared BLAS node buffer
+    uint32_t nodeCount;       // Nodes in the mesh's BVH
+    uint32_t triangleOffset;  // Mesh's first triangle in the shared triangle buffer
+    uint32_t targetId;        // Reported in HitResult::targetId
+};
+static_assert(sizeof(InstanceData) == 128, "InstanceData must match the GLSL std430 layout");
+
+// One placed target - a mesh (RCSCompute::setMeshGeometry) and its model matrix
+struct TargetInstance {
+    uint32_t meshId = 0;
+    QMatrix4x4 modelMatrix;
+
+    bool operator==(const TargetInstance& other) const {
+        return meshId == other.meshId && modelMatrix == other.modelMatrix;
+    }
 };
 
+// One analytic primitive placed in the scene (RCSCompute::setPrimitives). It is
+// intersected in closed form after the BVH instances; a hit reports targetId
+// and the primitive's index in setPrimitives() order as its triangleId.
+struct ScenePrimitive {
+    AnalyticShapeType shape = AnalyticShapeType::Sphere;
+    QMatrix4x4 modelMatrix;  // Unit primitive -> world
+    uint32_t targetId = 0;
+    uint32_t materialId = 0;
+
+    bool operator==(const ScenePrimitive& other) const {
+        return shape == other.shape && modelMatrix == other.modelMatrix && targetId == other.targetId &&
+               materialId == other.materialId;
+    }
+};
+
+// Analytic primitive for GPU - 128 bytes, same transforms as InstanceData
+struct alignas(16) PrimitiveData {
+    float invModel[16];      // World -> unit primitive space, column-major mat4
+    float normalMatrix[12];  // Primitive -> world normals, mat3 as three vec4 columns (std430)
+    uint32_t shape;          // AnalyticShapeType
+    uint32_t targetId;       // Reported in HitResult::targetId
+    uint32_t materialId;     // Reported in HitResult::normal.w
+    uint32_t reserved;
+};
+static_assert(sizeof(PrimitiveData) == 128, "PrimitiveData must match the GLSL std430 layout");
+
+// Places every shape of a target (object space) at every instance, giving the
+// primitives the targetId of their instance
+inline void appendTargetPrimitives(const std::vector<AnalyticShape>& shapes,
+                                   const std::vector<TargetInstance>& instances,
+                                   std::vector<ScenePrimitive>& primitives) {
+    for (size_t i = 0; i < instances.size(); ++i) {
+        for (const AnalyticShape& shape : shapes) {
+            ScenePrimitive primitive;
+            primitive.shape = shape.type;
+            primitive.modelMatrix = instances[i].modelMatrix * shape.transform;
+            primitive.targetId = static_cast<uint32_t>(i);
+            primitives.push_back(primitive);
+        }
+    }
+}
+
 // Hit result structure - 64 bytes (extended for reflection visualization)
 struct alignas(16) HitResult {
     QVector4D hitPoint;    // xyz = world position, w = distance (-1 = miss)
     QVector4D normal;      // xyz = surface normal, w = material ID
     QVector4D reflection;  // xyz = reflection direction, w = intensity (0-1)
-    uint32_t triangleId;   // Index of hit triangle
+    uint32_t triangleId;   // Index of hit triangle within its mesh (BVH order)
     uint32_t rayId;        // Index of ray that produced this hit
-    uint32_t targetId;     // Index of target that was hit (multi-target support)
-    float rcsContribution; // RCS contribution value
+    uint32_t targetId;     // Index of the instance that was hit (RCSCompute::setInstances order)
+    float rcsContribution; // Solid angle (sr) the primary ray stands for; debug rays: 1
+};
+
+// Compact hit result - 32 bytes (readback payload, see HitPayload)
+// Normals/directions are octahedral snorm 2x16, intensity is a half float.
+struct alignas(16) CompactHit {
+    float position[3];         // World-space hit position
+    uint32_t distanceOrRayId;  // Dense: float bits of distance (-1 = miss). Hits-only: rayId
+    uint32_t normalOct;        // Octahedral-encoded surface normal
+    uint32_t reflectionOct;    // Octahedral-encoded reflection direction
+    uint32_t intensityTarget;  // Low 16 bits: half-float intensity, high 16 bits: targetId
+    uint32_t triangleId;       // Index of hit triangle
+};
+static_assert(sizeof(CompactHit) == 32, "CompactHit must match the GLSL std430 layout");
+
+// Per-ray data copied back to the CPU each frame (values match the trace shader)
+enum class HitPayload {
+    Full = 0,             // 64-byte HitResult per ray of tile 0
+    Compact = 1,          // 32-byte CompactHit per ray of tile 0, rayId implicit
+    CompactHitsOnly = 2,  // 32-byte CompactHit per hit (all tiles, up to kMaxCompactHits), appended via the hit counter
+    None = 3,             // No per-ray output - hit count and GPU binning only
+    Columns = 4           // Structure of arrays per ray of tile 0 (see HitColumns)
+};
+
+// HitPayload::Columns readback: kHitColumnCount float arrays of one entry per
+// ray, in this order (distance, reflection xyz, intensity, position xyz)
+constexpr int kHitColumnCount = 8;
+
+// Structure-of-arrays view of a HitPayload::Columns readback
+// (RCSCompute::getLatestHitColumns). Index i is ray i of tile 0.
+struct HitColumns {
+    size_t count = 0;
+    const float* distance = nullptr;  // -1 = miss
+    const float* reflectionX = nullptr;
+    const float* reflectionY = nullptr;
+    const float* reflectionZ = nullptr;
+    const float* intensity = nullptr;
+    const float* positionX = nullptr;
+    const float* positionY = nullptr;
+    const float* positionZ = nullptr;
+
+    // One entry as a HitResult (normal, triangle and target are not carried)
+    HitResult hit(size_t i) const {
+        HitResult h{};
+        h.hitPoint = QVector4D(positionX[i], positionY[i], positionZ[i], distance[i]);
+        h.reflection = QVector4D(reflectionX[i], reflectionY[i], reflectionZ[i], intensity[i]);
+        h.triangleId = 0xFFFFFFFFu;
+        h.rayId = static_cast<uint32_t>(i);
+        return h;
+    }
+};
+
+// Where the rays of a beam are placed on the cone (values match the ray generation shader)
+enum class RaySampling {
+    Rings = 0,      // kRaysPerRing rays on each of numRings equal-angle rings
+    Fibonacci = 1,  // Fibonacci lattice, area-uniform over the cone's solid angle
+    Sobol = 2       // 2D Sobol (0,2)-sequence, area-uniform; every power-of-two prefix is stratified
+};
+
+// Bottom-level node layout uploaded to the GPU
+enum class BVHLayout {
+    Binary = 0,  // 32-byte BVHNode per node
+    Wide4 = 1    // 64-byte WideBVHNode, four quantized children per fetch
+};
+
+// Where a batch backend builds mesh BVHs (TraceSettings::bvhBuild)
+enum class BVHBuild {
+    CPU = 0,  // BVHBuilder on the BVH worker: SAH splits, uploaded afterwards
+    GPU = 1   // GPUBVHBuilder from uploaded geometry: Morton-order LBVH, material 0
+};
+
+// Triangle storage uploaded to the GPU
+enum class TrianglePrecision {
+    Full = 0,    // 48-byte Triangle, float vertex and edges
+    Compact = 1  // 24-byte CompactTriangle, 16-bit offsets within the leaf box
+};
+
+// Bottom-level traversal in the trace shader
+enum class TraversalMode {
+    Stack = 0,     // Per-invocation stack of kBVHStackSize entries
+    Stackless = 1  // Skip links, no stack - fewer registers, any tree depth
+};
+
+// Polar plot accumulation bin - 16 bytes (GPU binning output)
+// Intensity is summed in kBinIntensityScale fixed point, carried into a 64-bit lo/hi pair
+struct alignas(16) PolarBin {
+    uint32_t intensityLo;  // Low 32 bits of the fixed-point intensity sum
+    uint32_t intensityHi;  // High 32 bits of the fixed-point intensity sum
+    uint32_t hitCount;     // Hits accumulated into this bin
+    uint32_t padding;
+
+    double intensitySum(double scale) const {
+        return (static_cast<double>(intensityHi) * 4294967296.0 + static_cast<double>(intensityLo)) / scale;
+    }
+};
+
+// Complex far-field accumulation bin - 16 bytes (frequency-sweep binning output).
+// Real and imaginary parts are signed kFieldBinScale fixed point, each summed
+// as a two's complement 64-bit lo/hi pair.
+struct alignas(16) FrequencyBin {
+    uint32_t realLo;
+    int32_t realHi;
+    uint32_t imagLo;
+    int32_t imagHi;
+
+    std::complex<double> field(double scale) const {
+        return std::complex<double>(
+            (static_cast<double>(realHi) * 4294967296.0 + static_cast<double>(realLo)) / scale,
+            (static_cast<double>(imagHi) * 4294967296.0 + static_cast<double>(imagLo)) / scale);
+    }
+    // |E|^2 - same units as the incoherent PolarBin intensity sum
+    double coherentIntensity(double scale) const { return std::norm(field(scale)); }
+};
+
+// Evenly spaced frequency points for physical-optics binning
+struct FrequencySweep {
+    double startHz = 8.0e9;
+    double stopHz = 12.0e9;
+    int points = 64;              // 1 to kMaxFrequencyPoints
+    double metersPerUnit = 1.0;   // Scene units to meters, for the path-length phase
+
+    double frequencyHz(int index) const {
+        return points > 1 ? startHz + (stopHz - startHz) * index / (points - 1) : startHz;
+    }
+    bool operator==(const FrequencySweep& o) const {
+        return startHz == o.startHz && stopHz == o.stopHz && points == o.points &&
+               metersPerUnit == o.metersPerUnit;
+    }
+    bool operator!=(const FrequencySweep& o) const { return !(*this == o); }
+};
+
+// Angular slice filter applied while binning hits on the GPU
+struct BinningSlice {
+    int cutType = 0;                // CutType value: 0 = azimuth cut, 1 = elevation cut
+    float offsetDegrees = 0.0f;     // Slice plane offset
+    float thicknessDegrees = 10.0f; // Slice half-thickness (+/-)
+    float minIntensity = 0.0f;      // Hits below this intensity are not binned
+};
+
+// One radar look for batched dispatch (RCSCompute::computeLooks)
+struct RadarLook {
+    QVector3D radarPosition;
+    QVector3D beamDirection;
+    BinningSlice slice;  // Polar cut this look is binned into
+};
+
+// Per-look output of a batched dispatch
+struct LookResult {
+    std::vector<PolarBin> polarBins;  // kPolarPlotBins entries
+    int hitCount = 0;
+};
+
+// What a screen ray picks on the targets (RCSCompute::pick). Scene space, as
+// the trace; a miss leaves hit false and everything else at its default.
+struct PickResult {
+    bool hit = false;
+    QVector3D position;
+    QVector3D normal;        // Facing the picking ray
+    float distance = 0.0f;   // Along the picking ray
+    int instance = -1;       // RCSCompute::setInstances order; analytic primitives: -1
+    uint32_t targetId = 0;   // HitResult::targetId of the surface
+    int triangle = -1;       // Index-buffer triangle (Triangle::sourceIndex), or the primitive's index
+    bool primitive = false;  // triangle indexes the analytic primitives
+    uint32_t materialId = 0;
+    bool radarVisible = false;  // The radar's ray to the point reaches this surface first
+    float intensity = 0.0f;     // Return of the surface to the radar as the kernel shades it, before bounce effects
+    std::vector<HitResult> path;  // Radar ray through the point and its bounces (traceDebugRayMultiBounce layout)
 };
 
 // Reflection lobe cluster - 48 bytes (for GPU clustering)
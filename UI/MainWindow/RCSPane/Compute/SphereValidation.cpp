@@ -0,0 +1,252 @@
+// SphereValidation.cpp - Accuracy vs. cost of the tracers against the analytic sphere RCS
+#include "SphereValidation.h"
+#include "GLRCSBackend.h"
+#include "SphereWireframe.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+const char* samplingName(RaySampling sampling) {
+    switch (sampling) {
+    case RaySampling::Fibonacci: return "fibonacci";
+    case RaySampling::Sobol: return "sobol";
+    default: return "rings";
+    }
+}
+
+// Aspect angles around the sphere, so facet alignment averages out
+QVector3D lookPosition(int look, float distance) {
+    float az = (360.0f * look / kSphereValidationLooks + 11.25f) * kDegToRadF;
+    float el = 30.0f * std::sin(2.0f * static_cast<float>(kPi) * look / kSphereValidationLooks) * kDegToRadF;
+    return distance * QVector3D(std::cos(el) * std::cos(az), std::cos(el) * std::sin(az), std::sin(el));
+}
+
+} // namespace
+
+SphereValidation::SphereValidation() = default;
+
+SphereValidation::~SphereValidation() {
+    if (gl_) {
+        gl_->cleanup();
+    }
+}
+
+bool SphereValidation::run(const SphereValidationConfig& config) {
+    config_ = config;
+    rows_.clear();
+
+    if (config_.gpu && !gl_) {
+        gl_ = std::make_unique<GLRCSBackend>();
+        if (!gl_->initialize()) {
+            qWarning() << "SphereValidation: No OpenGL 4.3 offscreen context, skipping the GPU backend";
+            gl_.reset();
+        }
+    }
+    if (!config_.cpu && !gl_) {
+        qCritical() << "SphereValidation: No backend to run";
+        return false;
+    }
+
+    // A beam just wider than the sphere, so every look sees all of it
+    float angularRadius = std::asin(std::min(1.0f, config_.sphereRadius / config_.radarDistance));
+    beamWidthDegrees_ = 2.0f * std::min(angularRadius * kSphereValidationBeamMargin, 1.5f) / kDegToRadF;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int level : config_.subdivisions) {
+        SphereWireframe sphere(level);
+        sphere.generateMesh();
+        sphere.setScale(config_.sphereRadius);
+        std::vector<uint32_t> indices(sphere.getIndices().begin(), sphere.getIndices().end());
+        TargetInstance instance;
+        instance.modelMatrix = sphere.getModelMatrix();
+
+        if (config_.cpu) {
+            cpu_.setMeshGeometry(0, sphere.getVertices(), indices);
+            cpu_.setInstances({instance});
+            cpu_.setThreadCount(config_.cpuThreads);
+            cpu_.setBeamWidth(beamWidthDegrees_);
+            cpu_.setSphereRadius(config_.radarDistance);
+        }
+        bool gpuReady = false;
+        if (gl_) {
+            gl_->setMeshGeometry(0, sphere.getVertices(), indices, sphere.getGeometryVersion());
+            gl_->setInstances({instance});
+            gpuReady = gl_->waitForScene();  // Leaves the backend's context current
+            if (gpuReady) {
+                RCSCompute* compute = gl_->compute();
+                compute->setAsyncReadback(false);
+                compute->setSampleJitter(false);
+                compute->setBeamWidth(beamWidthDegrees_);
+                compute->setSphereRadius(config_.radarDistance);
+            }
+        }
+
+        for (RaySampling sampling : config_.samplings) {
+            for (int rays : config_.rayCounts) {
+                SphereValidationRow row;
+                row.subdivisions = level;
+                row.triangles = static_cast<int>(indices.size() / 3);
+                row.sampling = sampling;
+                if (config_.cpu) {
+                    traceConfiguration(false, rays, sampling, row);
+                    rows_.push_back(row);
+                }
+                if (gpuReady) {
+                    traceConfiguration(true, rays, sampling, row);
+                    rows_.push_back(row);
+                }
+            }
+        }
+    }
+
+    markPareto();
+    if (!writeCsv(config_.outputPath)) {
+        return false;
+    }
+    qDebug() << "SphereValidation:" << rows_.size() << "configurations in" << timer.elapsed()
+             << "ms ->" << config_.outputPath;
+    return true;
+}
+
+void SphereValidation::traceConfiguration(bool gpu, int rays, RaySampling sampling, SphereValidationRow& row) {
+    const double analytic = kPi * config_.sphereRadius * config_.sphereRadius;
+
+    double rcsSum = 0.0;
+    double errorSquaredSum = 0.0;
+    double msSum = 0.0;
+    int tracedRays = rays;
+    for (int look = 0; look < kSphereValidationLooks; ++look) {
+        QVector3D radar = lookPosition(look, config_.radarDistance);
+        QVector3D beam = -radar.normalized();
+
+        QElapsedTimer timer;
+        const std::vector<HitResult>* hits = nullptr;
+        if (gpu) {
+            RCSCompute* compute = gl_->compute();
+            compute->setNumRays(rays);
+            compute->setRaySampling(sampling);
+            compute->setRadarPosition(radar);
+            compute->setBeamDirection(beam);
+            timer.start();
+            compute->compute();
+            compute->readHitBuffer();
+            msSum += timer.nsecsElapsed() * 1.0e-6;
+            hits = &compute->getHitResults();
+            tracedRays = compute->getNumRays();
+        } else {
+            cpu_.setNumRays(rays);
+            cpu_.setRaySampling(sampling);
+            cpu_.setRadarPosition(radar);
+            cpu_.setBeamDirection(beam);
+            timer.start();
+            cpu_.compute();
+            msSum += timer.nsecsElapsed() * 1.0e-6;
+            hits = &cpu_.getHitResults();
+            tracedRays = cpu_.getNumRays();
+        }
+
+        double rcs = estimateRCS(*hits, tracedRays, sampling, radar);
+        double errorDb = 10.0 * std::log10(std::max(rcs, 1.0e-12) / analytic);
+        rcsSum += rcs;
+        errorSquaredSum += errorDb * errorDb;
+    }
+
+    row.backend = gpu ? "gpu" : "cpu";
+    row.rays = tracedRays;
+    row.rcs = rcsSum / kSphereValidationLooks;
+    row.errorDb = 10.0 * std::log10(std::max(row.rcs, 1.0e-12) / analytic);
+    row.rmsErrorDb = std::sqrt(errorSquaredSum / kSphereValidationLooks);
+    row.wallMs = msSum / kSphereValidationLooks;
+}
+
+double SphereValidation::estimateRCS(const std::vector<HitResult>& hits, int rays, RaySampling sampling,
+                                     const QVector3D& radarPosition) const {
+    if (hits.empty() || rays <= 0) {
+        return 0.0;
+    }
+
+    const double halfAngle = 0.5 * beamWidthDegrees_ * kDegToRadF;
+    const double capSolidAngle = 2.0 * kPi * (1.0 - std::cos(halfAngle));
+    const int numRings = (rays + kRaysPerRing - 1) / kRaysPerRing;
+    const double subsample = static_cast<double>(rays) / static_cast<double>(hits.size());
+    const float cosBackscatter = std::cos(kSphereValidationBackscatterDegrees * kDegToRadF);
+    const double backscatterSolidAngle = 2.0 * kPi * (1.0 - cosBackscatter);
+
+    double sum = 0.0;
+    for (const HitResult& hit : hits) {
+        float t = hit.hitPoint.w();
+        QVector3D reflection = hit.reflection.toVector3D();
+        if (t < 0.0f || reflection.lengthSquared() == 0.0f) {
+            continue;
+        }
+        QVector3D toRadar = (radarPosition - hit.hitPoint.toVector3D()).normalized();
+        if (QVector3D::dotProduct(reflection.normalized(), toRadar) < cosBackscatter) {
+            continue;
+        }
+
+        // Area-uniform rays carry their share, which bounds focus narrows
+        double rayOmega = hit.rcsContribution > 0.0f ? hit.rcsContribution : capSolidAngle / rays;
+        if (sampling == RaySampling::Rings) {
+            // Ring k sits on the outer edge of the annulus [k, k + 1] * halfAngle / numRings
+            int ring = static_cast<int>(hit.rayId % static_cast<uint32_t>(numRings));
+            int raysInRing = (rays - ring + numRings - 1) / numRings;
+            double inner = halfAngle * ring / numRings;
+            double outer = halfAngle * (ring + 1) / numRings;
+            rayOmega = 2.0 * kPi * (std::cos(inner) - std::cos(outer)) / std::max(raysInRing, 1);
+        }
+        sum += rayOmega * subsample * static_cast<double>(t) * t;
+    }
+    return 4.0 * kPi / backscatterSolidAngle * sum;
+}
+
+void SphereValidation::markPareto() {
+    for (SphereValidationRow& row : rows_) {
+        row.pareto = std::none_of(rows_.begin(), rows_.end(), [&row](const SphereValidationRow& other) {
+            if (&other == &row || other.backend != row.backend) {
+                return false;
+            }
+            bool noWorse = other.wallMs <= row.wallMs && std::abs(other.errorDb) <= std::abs(row.errorDb);
+            bool better = other.wallMs < row.wallMs || std::abs(other.errorDb) < std::abs(row.errorDb);
+            return noWorse && better;
+        });
+    }
+}
+
+bool SphereValidation::writeCsv(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCritical() << "SphereValidation: Cannot open" << path << ":" << file.errorString();
+        return false;
+    }
+    QTextStream out(&file);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(4);
+
+    const double analyticDbsm = 10.0 * std::log10(kPi * config_.sphereRadius * config_.sphereRadius);
+    out << "backend,subdivisions,triangles,sampling,rays,rcs_m2,rcs_dbsm,analytic_dbsm,"
+           "error_db,rms_error_db,wall_ms,pareto\n";
+    for (const SphereValidationRow& row : rows_) {
+        out << row.backend << "," << row.subdivisions << "," << row.triangles << ","
+            << samplingName(row.sampling) << "," << row.rays << "," << row.rcs << ","
+            << 10.0 * std::log10(std::max(row.rcs, 1.0e-12)) << "," << analyticDbsm << ","
+            << row.errorDb << "," << row.rmsErrorDb << "," << row.wallMs << ","
+            << (row.pareto ? 1 : 0) << "\n";
+    }
+    out.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+} // namespace RCS
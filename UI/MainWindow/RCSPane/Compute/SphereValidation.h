@@ -0,0 +1,78 @@
+// SphereValidation.h - Accuracy vs. cost of the tracers against the analytic sphere RCS
+#pragma once
+
+#include <QString>
+#include <memory>
+#include <vector>
+
+#include "RCSTypes.h"
+#include "CPURayTracer.h"
+#include "Constants.h"
+
+namespace RCS {
+
+class GLRCSBackend;
+
+// One --validate-sphere run: every combination of backend, subdivision level,
+// sampling pattern and ray count is traced and written as one CSV row.
+struct SphereValidationConfig {
+    QString outputPath;
+    bool cpu = true;
+    bool gpu = true;
+    std::vector<int> rayCounts{1000, 10000, 100000, 1000000};
+    std::vector<int> subdivisions{1, 2, 3, 4};
+    std::vector<RaySampling> samplings{RaySampling::Rings, RaySampling::Fibonacci, RaySampling::Sobol};
+    float sphereRadius = RS::Constants::Defaults::kTargetScale;  // World units (SphereWireframe is a unit sphere)
+    float radarDistance = RS::Constants::Defaults::kSphereRadius;
+    int cpuThreads = 0;
+};
+
+// One traced configuration, averaged over kSphereValidationLooks aspect angles
+struct SphereValidationRow {
+    QString backend;
+    int subdivisions = 0;
+    int triangles = 0;
+    RaySampling sampling = RaySampling::Rings;
+    int rays = 0;
+    double rcs = 0.0;         // Mean estimate over the looks (m^2)
+    double errorDb = 0.0;     // 10 log10(rcs / pi r^2)
+    double rmsErrorDb = 0.0;  // Spread of the per-look errors
+    double wallMs = 0.0;      // Mean trace time per look
+    bool pareto = false;      // No row of the same backend is both faster and more accurate
+};
+
+// The trace kernels only shade hits; the RCS itself comes from the per-ray
+// results with the geometric-optics estimate
+//   sigma = 4 pi / Omega_b * sum(d_omega_i * t_i^2)
+// over the rays whose reflection leaves within kSphereValidationBackscatterDegrees
+// of the direction back to the radar. d_omega_i is the ray's share of the beam's
+// solid angle (its ring's annulus for Rings) and t_i its hit distance, so each
+// ray stands for the wavefront area it sweeps. For a smooth sphere this
+// converges to pi r^2. The GPU returns per-ray results for its first tile only,
+// an interleaved subsample that is weighted up to the whole beam.
+class SphereValidation {
+public:
+    SphereValidation();
+    ~SphereValidation();
+
+    // Traces every configuration and writes the CSV. False if the output
+    // cannot be written or no backend could run.
+    bool run(const SphereValidationConfig& config);
+
+    const std::vector<SphereValidationRow>& rows() const { return rows_; }
+
+private:
+    void traceConfiguration(bool gpu, int rays, RaySampling sampling, SphereValidationRow& row);
+    double estimateRCS(const std::vector<HitResult>& hits, int rays, RaySampling sampling,
+                       const QVector3D& radarPosition) const;
+    void markPareto();
+    bool writeCsv(const QString& path) const;
+
+    SphereValidationConfig config_;
+    std::unique_ptr<GLRCSBackend> gl_;
+    CPURayTracer cpu_;
+    float beamWidthDegrees_ = 0.0f;  // Set per run to cover the sphere
+    std::vector<SphereValidationRow> rows_;
+};
+
+} // namespace RCS
@@ -0,0 +1,73 @@
+// TLASBuilder.cpp - Top-level BVH over target instance bounds
+#include "TLASBuilder.h"
+#include "Constants.h"
+#include <algorithm>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+void TLASBuilder::build(const std::vector<AABB>& bounds) {
+    nodes_.clear();
+    order_.clear();
+    centroids_.clear();
+    depthCapped_ = false;
+
+    int count = static_cast<int>(bounds.size());
+    if (count == 0) {
+        return;
+    }
+
+    order_.resize(count);
+    centroids_.reserve(count);
+    for (int i = 0; i < count; i++) {
+        order_[i] = i;
+        centroids_.push_back(bounds[i].center());
+    }
+
+    nodes_.reserve(2 * count);
+    buildRecursive(bounds, 0, count, 0);
+}
+
+int TLASBuilder::buildRecursive(const std::vector<AABB>& bounds, int start, int end, int depth) {
+    int nodeIndex = static_cast<int>(nodes_.size());
+    nodes_.push_back(BVHNode());
+
+    AABB nodeBounds;
+    AABB centroidBounds;
+    for (int i = start; i < end; i++) {
+        nodeBounds.expand(bounds[order_[i]]);
+        centroidBounds.expand(centroids_[order_[i]]);
+    }
+
+    // Ordered traversal pops a node and pushes both children, so an internal
+    // node at this depth needs depth + 2 stack entries
+    int count = end - start;
+    if (count <= kTLASMaxLeafSize || depth + 2 > kTLASStackSize) {
+        depthCapped_ = depthCapped_ || count > kTLASMaxLeafSize;
+        nodes_[nodeIndex].boundsMin = QVector4D(nodeBounds.min, static_cast<float>(-(start + 1)));
+        nodes_[nodeIndex].boundsMax = QVector4D(nodeBounds.max, static_cast<float>(count));
+        return nodeIndex;
+    }
+
+    // Median split on the widest centroid axis - instances are few and usually
+    // similar in size, so SAH binning would not pay for itself here
+    QVector3D extent = centroidBounds.max - centroidBounds.min;
+    int axis = 0;
+    if (extent.y() > extent.x()) axis = 1;
+    if (extent.z() > extent[axis]) axis = 2;
+
+    int mid = (start + end) / 2;
+    std::nth_element(order_.begin() + start, order_.begin() + mid, order_.begin() + end,
+        [this, axis](int a, int b) { return centroids_[a][axis] < centroids_[b][axis]; });
+
+    // Left child is the next node; w records the axis for ordered traversal
+    buildRecursive(bounds, start, mid, depth + 1);
+    int rightChild = buildRecursive(bounds, mid, end, depth + 1);
+
+    nodes_[nodeIndex].boundsMin = QVector4D(nodeBounds.min, static_cast<float>(axis));
+    nodes_[nodeIndex].boundsMax = QVector4D(nodeBounds.max, static_cast<float>(rightChild));
+    return nodeIndex;
+}
+
+} // namespace RCS
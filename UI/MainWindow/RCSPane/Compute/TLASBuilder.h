@@ -0,0 +1,39 @@
+// TLASBuilder.h - Top-level BVH over target instance bounds
+#pragma once
+
+#include "RCSTypes.h"
+#include <vector>
+
+namespace RCS {
+
+// Builds the top-level tree of a two-level BVH. Leaves reference instances
+// instead of triangles and use the same BVHNode encoding as the bottom level
+// (leaf: boundsMin.w = -firstInstance-1, boundsMax.w = instance count; internal:
+// split axis and right child, left child next). Instance counts are small, so
+// this runs on the GL thread whenever instances move. Nodes at the depth the
+// kTLASStackSize traversal stack allows become leaves of every instance left,
+// so a deep tree costs leaf tests, never dropped instances.
+class TLASBuilder {
+public:
+    TLASBuilder() = default;
+    ~TLASBuilder() = default;
+
+    // bounds: world-space AABB per instance
+    void build(const std::vector<AABB>& bounds);
+
+    const std::vector<BVHNode>& getNodes() const { return nodes_; }
+    // Leaf slot -> index into the bounds passed to build()
+    const std::vector<int>& getInstanceOrder() const { return order_; }
+    // The last build stopped splitting at the stack depth somewhere
+    bool isDepthCapped() const { return depthCapped_; }
+
+private:
+    std::vector<BVHNode> nodes_;
+    std::vector<int> order_;
+    std::vector<QVector3D> centroids_;
+    bool depthCapped_ = false;
+
+    int buildRecursive(const std::vector<AABB>& bounds, int start, int end, int depth);
+};
+
+} // namespace RCS
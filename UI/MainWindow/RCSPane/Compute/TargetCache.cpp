@@ -0,0 +1,413 @@
+// TargetCache.cpp - Binary cache of imported targets (mesh, materials, BVH, crease edges)
+#include "TargetCache.h"
+#include "Constants.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QStandardPaths>
+#include <QByteArray>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+using namespace RS::Constants;
+
+namespace RCS {
+
+namespace {
+
+constexpr char kCacheMagic[4] = {'R', 'S', 'T', 'C'};
+constexpr uint32_t kByteOrderMark = 0x01020304u;  // Reads back swapped on a foreign-endian machine
+
+// BVHBuilder settings a cached tree was built with; a tree from other settings
+// is still valid but is rebuilt so results match a fresh build
+constexpr uint32_t kBuildConfig = static_cast<uint32_t>(kBVHMaxLeafSize) |
+                                  static_cast<uint32_t>(kBVHNumBins) << 8 |
+                                  static_cast<uint32_t>(kWideBVHWidth) << 16 |
+                                  static_cast<uint32_t>(kWideBVHMaxLeafTriangles) << 24;
+
+enum Section {
+    kSectionVertices = 0,
+    kSectionIndices,
+    kSectionTriangles,
+    kSectionNodes,
+    kSectionSkipLinks,
+    kSectionWideNodes,
+    kSectionNormalCones,
+    kSectionEdges,
+    kSectionMaterialIds,
+    kSectionMaterialNames,  // UTF-8, one name per line
+    kSectionCount
+};
+
+struct CacheSection {
+    uint64_t offset;  // From the start of the file, kTargetCacheAlignment aligned
+    uint64_t bytes;
+};
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;      // kTargetCacheVersion
+    uint32_t byteOrder;    // kByteOrderMark
+    uint32_t buildConfig;  // kBuildConfig of the stored tree
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    uint64_t sourceVertexCount;
+    float boundsMin[3];
+    float boundsMax[3];
+    int32_t maxDepth;
+    int32_t wideMaxDepth;
+    CacheSection sections[kSectionCount];
+};
+
+// GeometricEdge without the bool, so the file layout is fixed
+struct CacheEdge {
+    uint32_t v0, v1;
+    float creaseAngle;
+    uint32_t isCrease;
+};
+static_assert(sizeof(CacheEdge) == 16, "CacheEdge is stored as-is");
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// 64-bit content hash, four independent lanes so it runs at memory speed.
+// A cache key, not a checksum against tampering.
+uint64_t hashBytes(const char* data, size_t size) {
+    constexpr uint64_t k1 = 0x9E3779B97F4A7C15ull;
+    constexpr uint64_t k2 = 0xC2B2AE3D27D4EB4Full;
+    uint64_t lanes[4] = {k1, k2, k1 ^ k2, size};
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            std::memcpy(&word, data + i + lane * 8, sizeof(word));
+            lanes[lane] = rotl(lanes[lane] ^ (word * k2), 31) * k1;
+        }
+    }
+    uint64_t tail = 0;
+    if (size > i) {
+        std::memcpy(&tail, data + i, size - i);
+    }
+
+    uint64_t h = lanes[0] ^ rotl(lanes[1], 17) ^ rotl(lanes[2], 29) ^ rotl(lanes[3], 43) ^ (tail * k2);
+    h ^= h >> 33;
+    h *= k1;
+    h ^= h >> 29;
+    h *= k2;
+    return h ^ (h >> 32);
+}
+
+uint64_t alignUp(uint64_t offset) {
+    const uint64_t alignment = static_cast<uint64_t>(kTargetCacheAlignment);
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+bool readSection(const char* data, uint64_t fileSize, const CacheSection& section, std::vector<T>& out) {
+    if (section.offset > fileSize || section.bytes > fileSize - section.offset || section.bytes % sizeof(T) != 0) {
+        return false;
+    }
+    out.resize(static_cast<size_t>(section.bytes / sizeof(T)));
+    if (!out.empty()) {
+        std::memcpy(out.data(), data + section.offset, static_cast<size_t>(section.bytes));
+    }
+    return true;
+}
+
+// Every child, leaf range and skip link must stay inside the arrays the GPU
+// will index, or a damaged file could make the trace shaders read out of bounds
+bool validateTree(const BVHSnapshot& bvh) {
+    const int64_t nodeCount = static_cast<int64_t>(bvh.nodes.size());
+    const int64_t triangleCount = static_cast<int64_t>(bvh.triangles.size());
+    if (static_cast<int64_t>(bvh.skipLinks.size()) != nodeCount ||
+        static_cast<int64_t>(bvh.normalCones.size()) != nodeCount) {
+        return false;
+    }
+    for (int64_t i = 0; i < nodeCount; ++i) {
+        const BVHNode& node = bvh.nodes[i];
+        int64_t w0 = static_cast<int64_t>(node.boundsMin.w());
+        int64_t w1 = static_cast<int64_t>(node.boundsMax.w());
+        if (w0 < 0) {
+            int64_t first = -w0 - 1;
+            if (w1 < 0 || first + w1 > triangleCount) {
+                return false;
+            }
+        } else if (w0 > 2 || i + 1 >= nodeCount || w1 <= i || w1 >= nodeCount) {
+            return false;
+        }
+        if (bvh.skipLinks[i] < -1 || bvh.skipLinks[i] >= nodeCount) {
+            return false;
+        }
+    }
+
+    const uint64_t wideCount = bvh.wideNodes.size();
+    for (const WideBVHNode& node : bvh.wideNodes) {
+        for (uint32_t child : node.children) {
+            if (child == kWideBVHChildEmpty) {
+                continue;
+            }
+            if (child & kWideBVHLeafFlag) {
+                uint64_t count = (child >> kWideBVHLeafCountShift) & 0x7Fu;
+                uint64_t first = child & ((1u << kWideBVHLeafCountShift) - 1u);
+                if (first + count > static_cast<uint64_t>(triangleCount)) {
+                    return false;
+                }
+            } else if (child >= wideCount) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TargetCache::TargetCache()
+    : directory_(defaultDirectory())
+{
+}
+
+TargetCache::TargetCache(const QString& directory)
+    : directory_(directory)
+{
+}
+
+QString TargetCache::defaultDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/target_cache";
+}
+
+QString TargetCache::entryPath(uint64_t sourceHash) const {
+    return directory_ + "/" + QString::number(sourceHash, 16).rightJustified(16, '0') + ".rstc";
+}
+
+bool TargetCache::fail(const QString& message) {
+    error_ = message;
+    return false;
+}
+
+bool TargetCache::hashFile(const QString& path, uint64_t& hash, uint64_t& size) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    size = static_cast<uint64_t>(file.size());
+    if (size == 0) {
+        hash = hashBytes(nullptr, 0);
+        return true;
+    }
+    uchar* mapped = file.map(0, file.size());
+    if (mapped) {
+        hash = hashBytes(reinterpret_cast<const char*>(mapped), static_cast<size_t>(size));
+        file.unmap(mapped);
+    } else {
+        QByteArray contents = file.readAll();
+        hash = hashBytes(contents.constData(), static_cast<size_t>(contents.size()));
+    }
+    return true;
+}
+
+bool TargetCache::load(const QString& sourcePath, CachedTarget& target) {
+    error_.clear();
+
+    uint64_t sourceHash = 0;
+    uint64_t sourceSize = 0;
+    if (!hashFile(sourcePath, sourceHash, sourceSize)) {
+        return fail(QString("Cannot read %1").arg(sourcePath));
+    }
+
+    QString path = entryPath(sourceHash);
+    QFile file(path);
+    if (!file.exists()) {
+        return fail("No cache entry");
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(QString("Cannot open %1: %2").arg(path, file.errorString()));
+    }
+
+    const uint64_t fileSize = static_cast<uint64_t>(file.size());
+    if (fileSize < sizeof(CacheHeader)) {
+        return fail(QString("%1 is truncated").arg(path));
+    }
+    QByteArray contents;
+    uchar* mapped = file.map(0, file.size());
+    const char* data = reinterpret_cast<const char*>(mapped);
+    if (!mapped) {
+        contents = file.readAll();
+        data = contents.constData();
+        if (static_cast<uint64_t>(contents.size()) != fileSize) {
+            return fail(QString("Cannot read %1").arg(path));
+        }
+    }
+
+    // Arrays are copied out, so the mapping only lives for this call
+    struct Unmapper {
+        QFile& file;
+        uchar* mapped;
+        ~Unmapper() { if (mapped) file.unmap(mapped); }
+    } unmapper{file, mapped};
+
+    CacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.byteOrder != kByteOrderMark) {
+        return fail(QString("%1 is not a target cache for this machine").arg(path));
+    }
+    if (header.version != kTargetCacheVersion) {
+        return fail(QString("%1 has cache version %2, expected %3").arg(path).arg(header.version).arg(kTargetCacheVersion));
+    }
+    if (header.sourceHash != sourceHash || header.sourceSize != sourceSize) {
+        return fail(QString("%1 belongs to a different source file").arg(path));
+    }
+
+    auto mesh = std::make_shared<ImportedMesh>();
+    auto bvh = std::make_shared<BVHSnapshot>();
+    std::vector<CacheEdge> edges;
+    std::vector<char> materialNames;
+    const CacheSection* sections = header.sections;
+    if (!readSection(data, fileSize, sections[kSectionVertices], mesh->vertices) ||
+        !readSection(data, fileSize, sections[kSectionIndices], mesh->indices) ||
+        !readSection(data, fileSize, sections[kSectionTriangles], bvh->triangles) ||
+        !readSection(data, fileSize, sections[kSectionNodes], bvh->nodes) ||
+        !readSection(data, fileSize, sections[kSectionSkipLinks], bvh->skipLinks) ||
+        !readSection(data, fileSize, sections[kSectionWideNodes], bvh->wideNodes) ||
+        !readSection(data, fileSize, sections[kSectionNormalCones], bvh->normalCones) ||
+        !readSection(data, fileSize, sections[kSectionEdges], edges) ||
+        !readSection(data, fileSize, sections[kSectionMaterialIds], mesh->materialIds) ||
+        !readSection(data, fileSize, sections[kSectionMaterialNames], materialNames)) {
+        return fail(QString("%1 is corrupt (section outside the file)").arg(path));
+    }
+
+    const size_t vertexCount = mesh->vertices.size() / 6;
+    if (mesh->vertices.empty() || mesh->vertices.size() % 6 != 0 ||
+        mesh->indices.empty() || mesh->indices.size() % 3 != 0 ||
+        std::any_of(mesh->indices.begin(), mesh->indices.end(),
+                    [vertexCount](uint32_t index) { return index >= vertexCount; })) {
+        return fail(QString("%1 is corrupt (mesh)").arg(path));
+    }
+    if (!mesh->materialIds.empty()) {
+        QString names = QString::fromUtf8(materialNames.data(), static_cast<int>(materialNames.size()));
+        for (const QString& name : names.split('\n')) {
+            mesh->materialNames.push_back(name);
+        }
+        if (mesh->materialIds.size() != mesh->triangleCount() ||
+            std::any_of(mesh->materialIds.begin(), mesh->materialIds.end(),
+                        [&](uint32_t id) { return id >= mesh->materialNames.size(); })) {
+            return fail(QString("%1 is corrupt (materials)").arg(path));
+        }
+    }
+    mesh->boundsMin = QVector3D(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    mesh->boundsMax = QVector3D(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    mesh->sourceVertexCount = static_cast<size_t>(header.sourceVertexCount);
+
+    target.edges.clear();
+    target.edges.reserve(edges.size());
+    for (const CacheEdge& edge : edges) {
+        if (edge.v0 >= vertexCount || edge.v1 >= vertexCount) {
+            return fail(QString("%1 is corrupt (edges)").arg(path));
+        }
+        target.edges.push_back({edge.v0, edge.v1, edge.creaseAngle, edge.isCrease != 0});
+    }
+
+    target.bvh.reset();
+    if (!bvh->nodes.empty()) {
+        if (bvh->triangles.size() != mesh->triangleCount() || !validateTree(*bvh)) {
+            return fail(QString("%1 is corrupt (BVH)").arg(path));
+        }
+        if (header.buildConfig == kBuildConfig) {
+            bvh->maxDepth = header.maxDepth;
+            bvh->wideMaxDepth = header.wideMaxDepth;
+            target.bvh = std::move(bvh);
+        } else {
+            qDebug() << "TargetCache: BVH in" << path << "was built with other settings - ignoring it";
+        }
+    }
+    target.mesh = std::move(mesh);
+    return true;
+}
+
+bool TargetCache::store(const QString& sourcePath, const ImportedMesh& mesh, const BVHSnapshot* bvh,
+                        const std::vector<GeometricEdge>& edges) {
+    error_.clear();
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kTargetCacheVersion;
+    header.byteOrder = kByteOrderMark;
+    header.buildConfig = kBuildConfig;
+    if (!hashFile(sourcePath, header.sourceHash, header.sourceSize)) {
+        return fail(QString("Cannot read %1").arg(sourcePath));
+    }
+    header.sourceVertexCount = mesh.sourceVertexCount;
+    for (int axis = 0; axis < 3; ++axis) {
+        header.boundsMin[axis] = mesh.boundsMin[axis];
+        header.boundsMax[axis] = mesh.boundsMax[axis];
+    }
+    header.maxDepth = bvh ? bvh->maxDepth : 0;
+    header.wideMaxDepth = bvh ? bvh->wideMaxDepth : 0;
+
+    QByteArray materialNames;
+    for (size_t id = 0; id < mesh.materialNames.size(); ++id) {
+        if (id > 0) {
+            materialNames += '\n';
+        }
+        materialNames += mesh.materialNames[id].toUtf8();
+    }
+
+    std::vector<CacheEdge> cacheEdges;
+    cacheEdges.reserve(edges.size());
+    for (const GeometricEdge& edge : edges) {
+        cacheEdges.push_back({edge.v0, edge.v1, edge.creaseAngle, edge.isCrease ? 1u : 0u});
+    }
+
+    const std::pair<const void*, uint64_t> payloads[kSectionCount] = {
+        {mesh.vertices.data(), mesh.vertices.size() * sizeof(float)},
+        {mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t)},
+        {bvh ? bvh->triangles.data() : nullptr, bvh ? bvh->triangles.size() * sizeof(Triangle) : 0},
+        {bvh ? bvh->nodes.data() : nullptr, bvh ? bvh->nodes.size() * sizeof(BVHNode) : 0},
+        {bvh ? bvh->skipLinks.data() : nullptr, bvh ? bvh->skipLinks.size() * sizeof(int32_t) : 0},
+        {bvh ? bvh->wideNodes.data() : nullptr, bvh ? bvh->wideNodes.size() * sizeof(WideBVHNode) : 0},
+        {bvh ? bvh->normalCones.data() : nullptr, bvh ? bvh->normalCones.size() * sizeof(QVector4D) : 0},
+        {cacheEdges.data(), cacheEdges.size() * sizeof(CacheEdge)},
+        {mesh.materialIds.data(), mesh.materialIds.size() * sizeof(uint32_t)},
+        {materialNames.constData(), static_cast<uint64_t>(materialNames.size())},
+    };
+    uint64_t cursor = alignUp(sizeof(CacheHeader));
+    for (int s = 0; s < kSectionCount; ++s) {
+        header.sections[s] = {cursor, payloads[s].second};
+        cursor = alignUp(cursor + payloads[s].second);
+    }
+
+    if (!QDir().mkpath(directory_)) {
+        return fail(QString("Cannot create %1").arg(directory_));
+    }
+
+    // QSaveFile writes a temporary and renames it on commit, so a reader never
+    // sees half an entry
+    QString path = entryPath(header.sourceHash);
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return fail(QString("Cannot write %1: %2").arg(path, file.errorString()));
+    }
+    const char padding[kTargetCacheAlignment] = {};
+    uint64_t written = 0;
+    auto write = [&](const void* bytes, uint64_t count) {
+        if (count > 0 && file.write(static_cast<const char*>(bytes), static_cast<qint64>(count)) != static_cast<qint64>(count)) {
+            return false;
+        }
+        written += count;
+        return true;
+    };
+    bool ok = write(&header, sizeof(header));
+    for (int s = 0; ok && s < kSectionCount; ++s) {
+        ok = write(padding, header.sections[s].offset - written) &&
+             write(payloads[s].first, payloads[s].second);
+    }
+    if (!ok || !file.commit()) {
+        return fail(QString("Cannot write %1: %2").arg(path, file.errorString()));
+    }
+
+    qDebug() << "TargetCache: Stored" << sourcePath << "as" << path << "-" << written / 1024 << "KiB"
+             << (bvh ? "with BVH" : "without BVH");
+    return true;
+}
+
+} // namespace RCS
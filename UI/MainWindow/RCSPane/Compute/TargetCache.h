@@ -0,0 +1,60 @@
+// TargetCache.h - Binary cache of imported targets (mesh, materials, BVH, crease edges)
+#pragma once
+
+#include "BVHBuilder.h"
+#include "MeshImporter.h"
+#include "WireframeTarget.h"
+#include <QString>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace RCS {
+
+// Everything needed to draw and trace an imported model without parsing it
+struct CachedTarget {
+    ImportedMeshPtr mesh;
+    // Object-space tree over mesh->vertices/indices, or null when the entry has
+    // none (or one built with other BVH settings). The caller stamps meshId and
+    // geometryVersion before handing it to RCSCompute/CPURayTracer.
+    std::shared_ptr<BVHSnapshot> bvh;
+    std::vector<GeometricEdge> edges;  // Crease edges (empty if none were stored)
+};
+
+// One file per model, named after a hash of the source file's contents, so an
+// edited model simply misses. A file is a small header plus 64-byte aligned raw
+// arrays in their in-memory (std430) layout: load() maps it, validates every
+// index against the array sizes and copies the arrays out - no text parsing
+// and no BVH build. Entries live in <app data>/target_cache, next to the
+// AppSettings profiles. Any thread; instances share nothing.
+class TargetCache {
+public:
+    TargetCache();
+    explicit TargetCache(const QString& directory);
+
+    static QString defaultDirectory();
+    const QString& directory() const { return directory_; }
+
+    // Entry for the current contents of sourcePath. Returns false on a miss or
+    // an unusable file; errorString() says which.
+    bool load(const QString& sourcePath, CachedTarget& target);
+
+    // Writes (or replaces) the entry for sourcePath. bvh may be null and edges
+    // empty; a later store() with them fills the entry in.
+    bool store(const QString& sourcePath, const ImportedMesh& mesh, const BVHSnapshot* bvh,
+               const std::vector<GeometricEdge>& edges);
+
+    const QString& errorString() const { return error_; }
+
+    // Content hash used as the cache key
+    static bool hashFile(const QString& path, uint64_t& hash, uint64_t& size);
+
+private:
+    QString entryPath(uint64_t sourceHash) const;
+    bool fail(const QString& message);
+
+    QString directory_;
+    QString error_;
+};
+
+} // namespace RCS
@@ -2,12 +2,25 @@
 
 #include "PolarRCSPlot.h"
 #include "Constants.h"
-#include <QPainter>
 #include <QFont>
+#include <algorithm>
 #include <cmath>
 
 using namespace RS::Constants;
 
+namespace {
+
+bool sameCurve(const std::vector<RCSDataPoint>& a, const std::vector<RCSDataPoint>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].angleDegrees != b[i].angleDegrees || a[i].dBsm != b[i].dBsm || a[i].valid != b[i].valid) {
+            return false;
+        }
+    }
+    return a.size() == b.size();
+}
+
+} // namespace
+
 PolarRCSPlot::PolarRCSPlot(QWidget* parent)
     : QOpenGLWidget(parent)
 {
@@ -15,8 +28,8 @@ PolarRCSPlot::PolarRCSPlot(QWidget* parent)
     setUpdateBehavior(QOpenGLWidget::NoPartialUpdate);
 
     // Pre-allocate data vector for 360 bins
-    data_.resize(360);
-    for (int i = 0; i < 360; ++i) {
+    data_.resize(kCurvePoints);
+    for (int i = 0; i < kCurvePoints; ++i) {
         data_[i] = RCSDataPoint(static_cast<float>(i), -60.0f, false);
     }
 }
@@ -24,6 +37,7 @@ PolarRCSPlot::PolarRCSPlot(QWidget* parent)
 PolarRCSPlot::~PolarRCSPlot() {
     makeCurrent();
 
+    labels_.cleanup();
     if (gridVao_ != 0) {
         glDeleteVertexArrays(1, &gridVao_);
     }
@@ -36,20 +50,47 @@ PolarRCSPlot::~PolarRCSPlot() {
     if (dataVbo_ != 0) {
         glDeleteBuffers(1, &dataVbo_);
     }
+    if (overlayVao_ != 0) {
+        glDeleteVertexArrays(1, &overlayVao_);
+    }
+    if (overlayVbo_ != 0) {
+        glDeleteBuffers(1, &overlayVbo_);
+    }
 
     doneCurrent();
 }
 
 void PolarRCSPlot::setData(const std::vector<RCSDataPoint>& data) {
-    if (data.size() != 360) {
+    if (data.size() != static_cast<size_t>(kCurvePoints)) {
         qWarning("PolarRCSPlot::setData: expected 360 data points, got %zu", data.size());
         return;
     }
+    if (sameCurve(data, data_)) {
+        return;
+    }
     data_ = data;
     dataDirty_ = true;
     update();
 }
 
+void PolarRCSPlot::setOverlayData(const std::vector<std::vector<RCSDataPoint>>& curves) {
+    size_t count = std::min<size_t>(curves.size(), kMaxOverlayCuts);
+    bool same = count == overlays_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (curves[i].size() != static_cast<size_t>(kCurvePoints)) {
+            qWarning("PolarRCSPlot::setOverlayData: expected 360 data points, got %zu", curves[i].size());
+            return;
+        }
+        same = same && sameCurve(curves[i], overlays_[i]);
+    }
+    if (same) {
+        return;
+    }
+    overlays_.assign(curves.begin(), curves.begin() + count);
+    overlayDirty_ = true;
+    update();
+}
+
 void PolarRCSPlot::setScale(float minDBsm, float maxDBsm) {
     if (minDBsm >= maxDBsm) {
         qWarning("PolarRCSPlot::setScale: min must be less than max");
@@ -59,6 +100,8 @@ void PolarRCSPlot::setScale(float minDBsm, float maxDBsm) {
     maxDBsm_ = maxDBsm;
     gridDirty_ = true;
     dataDirty_ = true;
+    overlayDirty_ = true;
+    labelsDirty_ = true;
     update();
 }
 
@@ -79,6 +122,22 @@ void PolarRCSPlot::initializeGL() {
     setupShaders();
     setupBuffers();
 
+    if (labels_.initialize()) {
+        QFont titleFont = font();
+        titleFont.setPointSize(14);
+        titleFont.setBold(true);
+        QFont subtitleFont = font();
+        subtitleFont.setPointSize(10);
+        QFont legendFont = font();
+        legendFont.setPointSize(8);
+        labels_.setDevicePixelRatio(devicePixelRatioF());
+        titleFont_ = labels_.addFont(titleFont);
+        subtitleFont_ = labels_.addFont(subtitleFont);
+        legendFont_ = labels_.addFont(legendFont);
+        labelFont_ = subtitleFont_;  // Angle and ring labels share the subtitle's size
+    }
+    labelsDirty_ = true;
+
     glInitialized_ = true;
 }
 
@@ -95,6 +154,8 @@ void PolarRCSPlot::resizeGL(int w, int h) {
 
     gridDirty_ = true;
     dataDirty_ = true;
+    overlayDirty_ = true;
+    labelsDirty_ = true;
 }
 
 void PolarRCSPlot::paintGL() {
@@ -129,14 +190,18 @@ void PolarRCSPlot::paintGL() {
     }
 
     drawPolarGrid();
-    drawDataCurve();
+    drawOverlayCurves();
+    drawDataCurve();  // Primary cut on top
 
     if (lineShader_) {
         lineShader_->release();
     }
 
-    // Draw labels using QPainter (after OpenGL)
+    // Labels last, blended over the grid and curve
     drawAxisLabels();
+    if (labels_.isInitialized()) {
+        labels_.draw(projection);
+    }
 }
 
 void PolarRCSPlot::setupShaders() {
@@ -167,8 +232,8 @@ void PolarRCSPlot::setupShaders() {
     )";
 
     lineShader_ = std::make_unique<QOpenGLShaderProgram>();
-    lineShader_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource);
-    lineShader_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource);
+    lineShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource);
+    lineShader_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource);
     lineShader_->link();
 }
 
@@ -177,9 +242,31 @@ void PolarRCSPlot::setupBuffers() {
     glGenVertexArrays(1, &gridVao_);
     glGenBuffers(1, &gridVbo_);
 
-    // Data curve buffers
+    // Data curve buffers: positions only, the color is a constant attribute
     glGenVertexArrays(1, &dataVao_);
     glGenBuffers(1, &dataVbo_);
+    dataVertices_.assign(kCurvePoints * 2, 0.0f);
+    glBindVertexArray(dataVao_);
+    glBindBuffer(GL_ARRAY_BUFFER, dataVbo_);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(dataVertices_.size() * sizeof(float)),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+
+    // Overlay curves share one buffer, one kCurvePoints range per curve
+    glGenVertexArrays(1, &overlayVao_);
+    glGenBuffers(1, &overlayVbo_);
+    overlayVertices_.assign(static_cast<size_t>(kMaxOverlayCuts) * kCurvePoints * 2, 0.0f);
+    glBindVertexArray(overlayVao_);
+    glBindBuffer(GL_ARRAY_BUFFER, overlayVbo_);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(overlayVertices_.size() * sizeof(float)),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 QPointF PolarRCSPlot::polarToScreen(float angleDeg, float radius) const {
@@ -287,105 +374,91 @@ void PolarRCSPlot::drawPolarGrid() {
 
 void PolarRCSPlot::drawDataCurve() {
     if (dataDirty_) {
-        dataVertices_.clear();
-
-        // Data color (orange to match beam)
-        const float dc[3] = {1.0f, 0.5f, 0.0f};
-
-        // Build line strip from data
-        bool firstValid = true;
-        QPointF lastPoint;
-
-        for (int i = 0; i <= 360; ++i) {
-            int idx = i % 360;
-            const auto& point = data_[idx];
-
-            float radius = dBsmToRadius(point.dBsm);
-            QPointF screenPos = polarToScreen(point.angleDegrees, radius);
-
-            if (!firstValid) {
-                // Add line segment from last point to this point
-                dataVertices_.push_back(static_cast<float>(lastPoint.x()));
-                dataVertices_.push_back(static_cast<float>(lastPoint.y()));
-                dataVertices_.push_back(dc[0]);
-                dataVertices_.push_back(dc[1]);
-                dataVertices_.push_back(dc[2]);
-
-                dataVertices_.push_back(static_cast<float>(screenPos.x()));
-                dataVertices_.push_back(static_cast<float>(screenPos.y()));
-                dataVertices_.push_back(dc[0]);
-                dataVertices_.push_back(dc[1]);
-                dataVertices_.push_back(dc[2]);
-            }
-
-            lastPoint = screenPos;
-            firstValid = false;
+        // Rewrite the positions in place; the loop closes 359 -> 0 itself
+        for (int i = 0; i < kCurvePoints; ++i) {
+            const auto& point = data_[i];
+            QPointF screenPos = polarToScreen(point.angleDegrees, dBsmToRadius(point.dBsm));
+            dataVertices_[2 * i] = static_cast<float>(screenPos.x());
+            dataVertices_[2 * i + 1] = static_cast<float>(screenPos.y());
         }
 
-        // Upload to GPU
-        glBindVertexArray(dataVao_);
         glBindBuffer(GL_ARRAY_BUFFER, dataVbo_);
-        glBufferData(GL_ARRAY_BUFFER,
-                     static_cast<GLsizeiptr>(dataVertices_.size() * sizeof(float)),
-                     dataVertices_.data(), GL_DYNAMIC_DRAW);
-
-        // Position attribute (location 0)
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), nullptr);
-        glEnableVertexAttribArray(0);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(dataVertices_.size() * sizeof(float)),
+                        dataVertices_.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        dataDirty_ = false;
+    }
 
-        // Color attribute (location 1)
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float),
-                              reinterpret_cast<void*>(2 * sizeof(float)));
-        glEnableVertexAttribArray(1);
+    // Draw data curve (orange to match beam)
+    glBindVertexArray(dataVao_);
+    glVertexAttrib3f(1, 1.0f, 0.5f, 0.0f);
+    glLineWidth(2.0f);
+    glDrawArrays(GL_LINE_LOOP, 0, kCurvePoints);
+    glBindVertexArray(0);
+}
 
-        glBindVertexArray(0);
-        dataDirty_ = false;
+void PolarRCSPlot::drawOverlayCurves() {
+    if (overlays_.empty()) {
+        return;
+    }
+    if (overlayDirty_) {
+        for (size_t c = 0; c < overlays_.size(); ++c) {
+            float* out = &overlayVertices_[c * kCurvePoints * 2];
+            for (int i = 0; i < kCurvePoints; ++i) {
+                const auto& point = overlays_[c][i];
+                QPointF screenPos = polarToScreen(point.angleDegrees, dBsmToRadius(point.dBsm));
+                out[2 * i] = static_cast<float>(screenPos.x());
+                out[2 * i + 1] = static_cast<float>(screenPos.y());
+            }
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, overlayVbo_);
+        glBufferSubData(GL_ARRAY_BUFFER, 0,
+                        static_cast<GLsizeiptr>(overlays_.size() * kCurvePoints * 2 * sizeof(float)),
+                        overlayVertices_.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        overlayDirty_ = false;
     }
 
-    // Draw data curve
-    if (!dataVertices_.empty()) {
-        glBindVertexArray(dataVao_);
-        glLineWidth(2.0f);
-        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(dataVertices_.size() / 5));
-        glBindVertexArray(0);
+    // Cyan, magenta, green, yellow - apart from the orange primary curve
+    static const float kOverlayColors[kMaxOverlayCuts][3] = {
+        {0.2f, 0.8f, 1.0f}, {0.9f, 0.3f, 0.9f}, {0.4f, 0.9f, 0.3f}, {1.0f, 0.9f, 0.2f}
+    };
+    glBindVertexArray(overlayVao_);
+    glLineWidth(1.5f);
+    for (size_t c = 0; c < overlays_.size(); ++c) {
+        glVertexAttrib3f(1, kOverlayColors[c][0], kOverlayColors[c][1], kOverlayColors[c][2]);
+        glDrawArrays(GL_LINE_LOOP, static_cast<GLint>(c * kCurvePoints), kCurvePoints);
     }
+    glBindVertexArray(0);
 }
 
 void PolarRCSPlot::drawAxisLabels() {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    // Draw title
-    QFont titleFont = painter.font();
-    titleFont.setPointSize(14);
-    titleFont.setBold(true);
-    painter.setFont(titleFont);
-    painter.setPen(Qt::white);
-    painter.drawText(QRectF(25, 8, viewWidth_ - 25, 20), Qt::AlignLeft, "RCS Polar Plot");
-
-    // Draw subtitle
-    QFont subtitleFont = painter.font();
-    subtitleFont.setPointSize(10);
-    subtitleFont.setBold(false);
-    painter.setFont(subtitleFont);
-    painter.setPen(QColor(180, 180, 180));  // Light gray
-    painter.drawText(QRectF(25, 28, viewWidth_ - 25, 16), Qt::AlignLeft, "dBsm");
-
-    // Draw angular convention legend
-    QFont legendFont = painter.font();
-    legendFont.setPointSize(8);
-    painter.setFont(legendFont);
-    painter.setPen(QColor(140, 140, 140));  // Darker gray
-    painter.drawText(QRectF(25, 46, viewWidth_ - 25, 12), Qt::AlignLeft,
-        QString::fromUtf8("0\u00B0=+X  90\u00B0=+Y  180\u00B0=-X  270\u00B0=-Y  (CCW)"));
-
-    // Reset font for other labels
-    QFont font = painter.font();
-    font.setPointSize(10);
-    painter.setFont(font);
-    painter.setPen(Qt::white);
-
-    // Draw angle labels at cardinal and intercardinal directions
+    if (!labels_.isInitialized()) {
+        return;
+    }
+    if (labels_.getDevicePixelRatio() != devicePixelRatioF()) {
+        labels_.setDevicePixelRatio(devicePixelRatioF());  // Drops the queued text
+        labelsDirty_ = true;
+    }
+    if (labelsDirty_) {
+        buildAxisLabels();
+        labelsDirty_ = false;
+    }
+}
+
+void PolarRCSPlot::buildAxisLabels() {
+    labels_.clear();
+
+    // Title, subtitle and angular convention legend
+    labels_.addText(titleFont_, QRectF(25, 8, viewWidth_ - 25, 20), Qt::AlignLeft,
+                    "RCS Polar Plot", Qt::white);
+    labels_.addText(subtitleFont_, QRectF(25, 28, viewWidth_ - 25, 16), Qt::AlignLeft,
+                    "dBsm", QColor(180, 180, 180));  // Light gray
+    labels_.addText(legendFont_, QRectF(25, 46, viewWidth_ - 25, 12), Qt::AlignLeft,
+                    QString::fromUtf8("0\u00B0=+X  90\u00B0=+Y  180\u00B0=-X  270\u00B0=-Y  (CCW)"),
+                    QColor(140, 140, 140));  // Darker gray
+
+    // Angle labels at cardinal and intercardinal directions
     const char* angleLabels[] = {"0", "30", "60", "90", "120", "150", "180", "210", "240", "270", "300", "330"};
     for (int i = 0; i < 12; ++i) {
         float angleDeg = static_cast<float>(i * 30);
@@ -394,10 +467,10 @@ void PolarRCSPlot::drawAxisLabels() {
 
         QString label = QString::fromLatin1(angleLabels[i]) + QString::fromUtf8("\u00B0");
         QRectF rect(pos.x() - 20, pos.y() - 10, 40, 20);
-        painter.drawText(rect, Qt::AlignCenter, label);
+        labels_.addText(labelFont_, rect, Qt::AlignCenter, label, Qt::white);
     }
 
-    // Draw dBsm values along the 45-degree line (just numbers, no unit)
+    // dBsm values along the 45-degree line (just numbers, no unit)
     float dBsmRange = maxDBsm_ - minDBsm_;
     int numRings = static_cast<int>(dBsmRange / 10.0f);
 
@@ -410,8 +483,6 @@ void PolarRCSPlot::drawAxisLabels() {
 
         QString label = QString::number(static_cast<int>(dBsm));
         QRectF rect(pos.x() + 5, pos.y() - 8, 40, 16);
-        painter.drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, label);
+        labels_.addText(labelFont_, rect, Qt::AlignLeft | Qt::AlignVCenter, label, Qt::white);
     }
-
-    painter.end();
 }
@@ -9,6 +9,8 @@
 #include <vector>
 #include <memory>
 
+#include "TextRenderer.h"
+
 // Data point for polar RCS plot - keeps angle and dBsm paired
 struct RCSDataPoint {
     float angleDegrees;  // 0-360 degrees (azimuth) or -90 to +90 (elevation)
@@ -27,9 +29,15 @@ public:
     explicit PolarRCSPlot(QWidget* parent = nullptr);
     ~PolarRCSPlot() override;
 
-    // Set the RCS data to display (360 data points, one per degree)
+    // Set the RCS data to display (360 data points, one per degree). Data
+    // equal to what is shown is ignored, so callers may push every update.
     void setData(const std::vector<RCSDataPoint>& data);
 
+    // Extra curves drawn over the primary one (multi-cut mode), 360 points
+    // each, in a fixed palette by index; empty removes them. At most
+    // kMaxOverlayCuts; unchanged data is ignored as in setData().
+    void setOverlayData(const std::vector<std::vector<RCSDataPoint>>& curves);
+
     // Set the dBsm scale range
     void setScale(float minDBsm, float maxDBsm);
 
@@ -51,6 +59,8 @@ private:
     void drawPolarGrid();
     void drawAxisLabels();
     void drawDataCurve();
+    void drawOverlayCurves();
+    void buildAxisLabels();  // Lays the label text out again (resize, scale, pixel ratio)
 
     // Shader setup
     void setupShaders();
@@ -62,6 +72,7 @@ private:
 
     // Data
     std::vector<RCSDataPoint> data_;
+    std::vector<std::vector<RCSDataPoint>> overlays_;
     float minDBsm_ = -40.0f;   // Minimum dBsm for display scale
     float maxDBsm_ = 20.0f;    // Maximum dBsm for display scale
 
@@ -71,12 +82,25 @@ private:
     GLuint gridVbo_ = 0;
     GLuint dataVao_ = 0;
     GLuint dataVbo_ = 0;
+    GLuint overlayVao_ = 0;
+    GLuint overlayVbo_ = 0;  // kMaxOverlayCuts curves of kCurvePoints positions
 
-    // Geometry cache
+    // Geometry cache. The curve buffer holds kCurvePoints positions drawn as
+    // a line loop, allocated once and rewritten in place.
     std::vector<float> gridVertices_;
     std::vector<float> dataVertices_;
     bool gridDirty_ = true;
     bool dataDirty_ = true;
+    std::vector<float> overlayVertices_;
+    bool overlayDirty_ = true;
+
+    // Labels come from a glyph atlas, laid out once per resize or scale change
+    TextRenderer labels_;
+    int titleFont_ = -1;
+    int subtitleFont_ = -1;
+    int legendFont_ = -1;
+    int labelFont_ = -1;
+    bool labelsDirty_ = true;
 
     // View parameters
     float plotCenterX_ = 0.0f;
@@ -90,4 +114,5 @@ private:
     static constexpr int kAngularGridLines = 12;    // Every 30 degrees
     static constexpr int kRadialGridRings = 6;      // Every 10 dB from -40 to +20
     static constexpr int kCircleSegments = 360;     // Segments for circular elements
+    static constexpr int kCurvePoints = 360;        // One per degree
 };
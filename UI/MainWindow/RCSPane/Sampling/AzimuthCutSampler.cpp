@@ -1,6 +1,7 @@
 // ---- RCSCompute/AzimuthCutSampler.cpp ----
 
 #include "AzimuthCutSampler.h"
+#include "ParallelChunks.h"
 #include <cmath>
 #include <algorithm>
 
@@ -24,10 +25,18 @@ void AzimuthCutSampler::clear() {
 
 void AzimuthCutSampler::sample(const std::vector<RCS::HitResult>& hits,
                                 std::vector<RCSDataPoint>& outData) {
-    // 1. Clear bins
+    if (!coherent_) {
+        angles_.compute(hits);
+        buildSliceTable();
+        resample(outData);
+        return;
+    }
+
+    // Coherent: field sums do not subtract, so the slice is applied per hit
+    sliceTable_.clear();
     clear();
+    coherentBins_.reset(kPolarPlotBins);
 
-    // 2. Accumulate hits into bins
     for (const auto& hit : hits) {
         // Skip misses (distance == -1)
         if (hit.hitPoint.w() < 0.0f) {
@@ -50,12 +59,81 @@ void AzimuthCutSampler::sample(const std::vector<RCS::HitResult>& hits,
             continue;
         }
 
-        // Accumulate intensity
-        binIntensity_[bin] += hit.reflection.w();  // w = intensity
+        coherentBins_.add(bin, hit, waveNumber_);
         binHitCount_[bin]++;
     }
+    coherentBins_.resolve();
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        binIntensity_[i] = static_cast<float>(coherentBins_.intensity(i));
+    }
+
+    writeOutput(outData);
+}
+
+void AzimuthCutSampler::sampleColumns(const RCS::HitColumns& columns,
+                                      std::vector<RCSDataPoint>& outData) {
+    if (coherent_) {
+        std::vector<RCS::HitResult> hits(columns.count);
+        for (size_t i = 0; i < columns.count; ++i) {
+            hits[i] = columns.hit(i);
+        }
+        sample(hits, outData);
+        return;
+    }
+
+    angles_.compute(columns);
+    buildSliceTable();
+    resample(outData);
+}
+
+void AzimuthCutSampler::buildSliceTable() {
+    // Bucket every hit once by azimuth bin and elevation; the slice itself
+    // is resolved from the table, so offset and thickness are free to change
+    // Large hit sets fill one partial table per chunk, merged before the prefix pass
+    const int cells = static_cast<int>(std::lround(180.0f / kSliceTableCellDegrees));
+    int chunks = RS::parallelChunkCount(angles_.size(), kHitParallelMinHits);
+    partialTables_.resize(chunks - 1);
+    sliceTable_.reset(kPolarPlotBins, cells, -90.0f, kSliceTableCellDegrees, false);
+    for (auto& partial : partialTables_) {
+        partial.reset(kPolarPlotBins, cells, -90.0f, kSliceTableCellDegrees, false);
+    }
+
+    const float* azimuth = angles_.azimuthDegrees().data();
+    const float* elevation = angles_.elevationDegrees().data();
+    const float* intensity = angles_.intensities().data();
+    RS::runChunks(chunks, angles_.size(), [&](int chunk, size_t begin, size_t end) {
+        SliceTable& table = chunk == 0 ? sliceTable_ : partialTables_[chunk - 1];
+        for (size_t i = begin; i < end; ++i) {
+            // Azimuth [-180, 180] to bin 0-359
+            float azimuthDeg = azimuth[i] < 0.0f ? azimuth[i] + 360.0f : azimuth[i];
+            int bin = std::min(static_cast<int>(azimuthDeg), kPolarPlotBins - 1);
+            table.add(bin, elevation[i], intensity[i]);
+        }
+    });
+    for (const auto& partial : partialTables_) {
+        sliceTable_.accumulate(partial);
+    }
+    sliceTable_.finalize();
+}
+
+bool AzimuthCutSampler::resample(std::vector<RCSDataPoint>& outData) {
+    if (coherent_ || !sliceTable_.isValid()) {
+        return false;
+    }
+
+    // Two prefix lookups per bin
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        SliceTable::Sum sum = sliceTable_.range(i, elevationOffset_ - thickness_, elevationOffset_ + thickness_);
+        binIntensity_[i] = static_cast<float>(sum.intensity);
+        binHitCount_[i] = static_cast<int>(sum.hitCount);
+    }
+
+    writeOutput(outData);
+    return true;
+}
 
-    // 3. Convert to dBsm and output
+void AzimuthCutSampler::writeOutput(std::vector<RCSDataPoint>& outData) const {
+    // Convert to dBsm and output
     outData.resize(kPolarPlotBins);
     for (int i = 0; i < kPolarPlotBins; ++i) {
         outData[i].angleDegrees = static_cast<float>(i);
@@ -72,6 +150,43 @@ void AzimuthCutSampler::sample(const std::vector<RCS::HitResult>& hits,
     }
 }
 
+void AzimuthCutSampler::sampleBins(const std::vector<RCS::PolarBin>& bins,
+                                   std::vector<RCSDataPoint>& outData) {
+    // Bins were accumulated on the GPU with the same slice/bin rules as sample()
+    outData.resize(kPolarPlotBins);
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        outData[i].angleDegrees = static_cast<float>(i);
+
+        if (i < static_cast<int>(bins.size()) && bins[i].hitCount > 0) {
+            double avgIntensity = bins[i].intensitySum(kBinIntensityScale) / bins[i].hitCount;
+            outData[i].dBsm = intensityToDBsm(static_cast<float>(avgIntensity));
+            outData[i].valid = true;
+        } else {
+            outData[i].dBsm = kDBsmFloor;
+            outData[i].valid = false;
+        }
+    }
+}
+
+void AzimuthCutSampler::sampleFieldBins(const std::vector<RCS::PolarBin>& bins,
+                                      const std::vector<RCS::FrequencyBin>& fields,
+                                      std::vector<RCSDataPoint>& outData) {
+    // |sum E|^2 over the hit count, as sample() reports in coherent mode
+    outData.resize(kPolarPlotBins);
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        outData[i].angleDegrees = static_cast<float>(i);
+
+        if (i < static_cast<int>(bins.size()) && i < static_cast<int>(fields.size()) && bins[i].hitCount > 0) {
+            double avgIntensity = fields[i].coherentIntensity(kFieldBinScale) / bins[i].hitCount;
+            outData[i].dBsm = intensityToDBsm(static_cast<float>(avgIntensity));
+            outData[i].valid = true;
+        } else {
+            outData[i].dBsm = kDBsmFloor;
+            outData[i].valid = false;
+        }
+    }
+}
+
 bool AzimuthCutSampler::validateHit(const RCS::HitResult& hit) const {
     float intensity = hit.reflection.w();
 
@@ -4,6 +4,9 @@
 #pragma once
 
 #include "RCSSampler.h"
+#include "CoherentAccumulator.h"
+#include "SliceTable.h"
+#include "HitAngles.h"
 #include "Constants.h"
 #include <vector>
 
@@ -17,6 +20,20 @@ public:
     void clear() override;
     void sample(const std::vector<RCS::HitResult>& hits,
                 std::vector<RCSDataPoint>& outData) override;
+    void sampleColumns(const RCS::HitColumns& columns,
+                       std::vector<RCSDataPoint>& outData) override;
+    bool resample(std::vector<RCSDataPoint>& outData) override;
+    void sampleBins(const std::vector<RCS::PolarBin>& bins,
+                    std::vector<RCSDataPoint>& outData) override;
+    void sampleFieldBins(const std::vector<RCS::PolarBin>& bins,
+                         const std::vector<RCS::FrequencyBin>& fields,
+                         std::vector<RCSDataPoint>& outData) override;
+
+    void setCoherent(bool coherent, double waveNumber) override {
+        coherent_ = coherent;
+        waveNumber_ = waveNumber;
+    }
+    bool isCoherent() const override { return coherent_; }
 
     void setThickness(float degrees) override { thickness_ = degrees; }
     void setOffset(float offset) override { elevationOffset_ = offset; }
@@ -32,7 +49,19 @@ private:
     std::vector<float> binIntensity_;   // Accumulated intensity per bin
     std::vector<int> binHitCount_;      // Hit count per bin
 
+    // Coherent summation
+    bool coherent_ = false;
+    double waveNumber_ = 0.0;
+    CoherentAccumulator coherentBins_;
+
+    // Hits of the last incoherent sample(), bucketed by output bin and slice angle
+    SliceTable sliceTable_;
+    std::vector<SliceTable> partialTables_;  // Per-chunk tables for large hit sets
+    HitAngles angles_;
+
     // Helper methods
+    void buildSliceTable();  // From angles_
+    void writeOutput(std::vector<RCSDataPoint>& outData) const;
     bool isHitInSlice(const RCS::HitResult& hit) const;
     int getAzimuthBin(const QVector3D& reflectionDir) const;
     float intensityToDBsm(float intensity) const;
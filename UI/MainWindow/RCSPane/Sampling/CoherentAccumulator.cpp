@@ -0,0 +1,79 @@
+// ---- RCSCompute/CoherentAccumulator.cpp ----
+
+#include "CoherentAccumulator.h"
+#include "Constants.h"
+#include "SinCos4.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace {
+
+constexpr int kLanes = RS::kSinCosLanes;
+
+} // namespace
+
+void CoherentAccumulator::reset(int bins) {
+    bins_.clear();
+    amplitudes_.clear();
+    phases_.clear();
+    real_.assign(bins, 0.0);
+    imag_.assign(bins, 0.0);
+}
+
+void CoherentAccumulator::add(int bin, const RCS::HitResult& hit, double waveNumber) {
+    float amplitude, phase;
+    hitPhasor(hit, waveNumber, amplitude, phase);
+    addPhasor(bin, amplitude, phase);
+}
+
+void CoherentAccumulator::hitPhasor(const RCS::HitResult& hit, double waveNumber, float& amplitude, float& phase) {
+    QVector3D dir = hit.reflection.toVector3D().normalized();
+    double pathLength = static_cast<double>(hit.hitPoint.w()) -
+                        QVector3D::dotProduct(hit.hitPoint.toVector3D(), dir);
+
+    // Reduce in double so the float polynomials see a small argument
+    double reduced = -waveNumber * pathLength;
+    reduced -= kTwoPi * std::nearbyint(reduced / kTwoPi);
+
+    amplitude = std::sqrt(hit.reflection.w());
+    phase = static_cast<float>(reduced);
+}
+
+void CoherentAccumulator::addPhasor(int bin, float amplitude, float phase) {
+    bins_.push_back(bin);
+    amplitudes_.push_back(amplitude);
+    phases_.push_back(phase);
+}
+
+void CoherentAccumulator::resolve() {
+    // Pad to whole lanes with zero-amplitude phasors
+    size_t count = bins_.size();
+    size_t padded = (count + kLanes - 1) / kLanes * kLanes;
+    phases_.resize(padded, 0.0f);
+
+    float s[kLanes];
+    float c[kLanes];
+    for (size_t i = 0; i < count; i += kLanes) {
+        RS::sinCos4(&phases_[i], s, c);
+        size_t lanes = std::min<size_t>(kLanes, count - i);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            int bin = bins_[i + lane];
+            float amplitude = amplitudes_[i + lane];
+            real_[bin] += amplitude * c[lane];
+            imag_[bin] += amplitude * s[lane];
+        }
+    }
+
+    bins_.clear();
+    amplitudes_.clear();
+    phases_.clear();
+}
+
+double CoherentAccumulator::intensity(int bin) const {
+    if (bin < 0 || bin >= static_cast<int>(real_.size())) {
+        return 0.0;
+    }
+    return real_[bin] * real_[bin] + imag_[bin] * imag_[bin];
+}
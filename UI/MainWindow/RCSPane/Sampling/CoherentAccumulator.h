@@ -0,0 +1,39 @@
+// ---- RCSCompute/CoherentAccumulator.h ----
+// Complex-field (coherent) summation of hits into polar bins on the CPU
+
+#pragma once
+
+#include "RCSTypes.h"
+#include <vector>
+
+// Collects (bin, amplitude, phase) per hit, then evaluates the phasors four
+// at a time with SSE2 sincos and sums them per bin. The CPU counterpart of the
+// GPU field binning in RCSCompute (FREQUENCY_BINNING) at a single frequency.
+class CoherentAccumulator {
+public:
+    // Clear the queue and resize the per-bin sums
+    void reset(int bins);
+
+    // Queue a hit's field sqrt(intensity) * exp(-i k L). L is the path to the
+    // hit plus the far-field leg along the exit direction - the same path the
+    // GPU bins use - so for a backscattered ray it is the two-way range.
+    void add(int bin, const RCS::HitResult& hit, double waveNumber);
+
+    // The same split in two, for callers that bin one hit into several
+    // accumulators: hitPhasor() once per hit, addPhasor() per bin
+    static void hitPhasor(const RCS::HitResult& hit, double waveNumber, float& amplitude, float& phase);
+    void addPhasor(int bin, float amplitude, float phase);
+
+    // Evaluate and sum every queued phasor into its bin
+    void resolve();
+
+    // |sum E|^2 of a bin after resolve()
+    double intensity(int bin) const;
+
+private:
+    std::vector<int> bins_;
+    std::vector<float> amplitudes_;
+    std::vector<float> phases_;  // Reduced to [-pi, pi]
+    std::vector<double> real_;
+    std::vector<double> imag_;
+};
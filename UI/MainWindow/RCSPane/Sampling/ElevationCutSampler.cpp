@@ -1,6 +1,7 @@
 // ---- RCSCompute/ElevationCutSampler.cpp ----
 
 #include "ElevationCutSampler.h"
+#include "ParallelChunks.h"
 #include <cmath>
 #include <algorithm>
 
@@ -24,10 +25,18 @@ void ElevationCutSampler::clear() {
 
 void ElevationCutSampler::sample(const std::vector<RCS::HitResult>& hits,
                                   std::vector<RCSDataPoint>& outData) {
-    // 1. Clear bins
+    if (!coherent_) {
+        angles_.compute(hits);
+        buildSliceTable();
+        resample(outData);
+        return;
+    }
+
+    // Coherent: field sums do not subtract, so the slice is applied per hit
+    sliceTable_.clear();
     clear();
+    coherentBins_.reset(kPolarPlotBins);
 
-    // 2. Accumulate hits into bins
     for (const auto& hit : hits) {
         // Skip misses (distance == -1)
         if (hit.hitPoint.w() < 0.0f) {
@@ -50,12 +59,93 @@ void ElevationCutSampler::sample(const std::vector<RCS::HitResult>& hits,
             continue;
         }
 
-        // Accumulate intensity
-        binIntensity_[bin] += hit.reflection.w();  // w = intensity
+        coherentBins_.add(bin, hit, waveNumber_);
         binHitCount_[bin]++;
     }
+    coherentBins_.resolve();
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        binIntensity_[i] = static_cast<float>(coherentBins_.intensity(i));
+    }
+
+    writeOutput(outData);
+}
+
+void ElevationCutSampler::sampleColumns(const RCS::HitColumns& columns,
+                                        std::vector<RCSDataPoint>& outData) {
+    if (coherent_) {
+        std::vector<RCS::HitResult> hits(columns.count);
+        for (size_t i = 0; i < columns.count; ++i) {
+            hits[i] = columns.hit(i);
+        }
+        sample(hits, outData);
+        return;
+    }
+
+    angles_.compute(columns);
+    buildSliceTable();
+    resample(outData);
+}
+
+void ElevationCutSampler::buildSliceTable() {
+    // Bucket every hit once by elevation and azimuth. The front/back side
+    // (and so the output bin) depends on the offset; resample() picks it
+    // from the azimuth range each lookup covers.
+    // Large hit sets fill one partial table per chunk, merged before the prefix pass
+    const int bins = kPolarPlotBins / 2 + 1;
+    const int cells = static_cast<int>(std::lround(360.0f / kSliceTableCellDegrees));
+    int chunks = RS::parallelChunkCount(angles_.size(), kHitParallelMinHits);
+    partialTables_.resize(chunks - 1);
+    sliceTable_.reset(bins, cells, -180.0f, kSliceTableCellDegrees, true);
+    for (auto& partial : partialTables_) {
+        partial.reset(bins, cells, -180.0f, kSliceTableCellDegrees, true);
+    }
 
-    // 3. Convert to dBsm and output
+    const float* azimuth = angles_.azimuthDegrees().data();
+    const float* elevation = angles_.elevationDegrees().data();
+    const float* intensity = angles_.intensities().data();
+    RS::runChunks(chunks, angles_.size(), [&](int chunk, size_t begin, size_t end) {
+        SliceTable& table = chunk == 0 ? sliceTable_ : partialTables_[chunk - 1];
+        for (size_t i = begin; i < end; ++i) {
+            int elevationIndex = std::clamp(static_cast<int>(std::round(elevation[i] + 90.0f)), 0, kPolarPlotBins / 2);
+            table.add(elevationIndex, azimuth[i], intensity[i]);
+        }
+    });
+    for (const auto& partial : partialTables_) {
+        sliceTable_.accumulate(partial);
+    }
+    sliceTable_.finalize();
+}
+
+bool ElevationCutSampler::resample(std::vector<RCSDataPoint>& outData) {
+    if (coherent_ || !sliceTable_.isValid()) {
+        return false;
+    }
+
+    clear();
+
+    // Front side of the plane maps elevation -90..+90 to bins 0-180, the back
+    // side +90..-90 to bins 180-360 (as getElevationBin). Each side is within
+    // 90 degrees of its azimuth, so a slice never reaches the other side.
+    float side = std::min(thickness_, 90.0f);
+    float front = azimuthOffset_;
+    float back = azimuthOffset_ + 180.0f;
+    for (int e = 0; e <= kPolarPlotBins / 2; ++e) {
+        SliceTable::Sum frontSum = sliceTable_.range(e, front - side, front + side);
+        binIntensity_[e] += static_cast<float>(frontSum.intensity);
+        binHitCount_[e] += static_cast<int>(frontSum.hitCount);
+
+        int backBin = std::min(kPolarPlotBins - e, kPolarPlotBins - 1);
+        SliceTable::Sum backSum = sliceTable_.range(e, back - side, back + side);
+        binIntensity_[backBin] += static_cast<float>(backSum.intensity);
+        binHitCount_[backBin] += static_cast<int>(backSum.hitCount);
+    }
+
+    writeOutput(outData);
+    return true;
+}
+
+void ElevationCutSampler::writeOutput(std::vector<RCSDataPoint>& outData) const {
+    // Convert to dBsm and output
     // For elevation cut: bin 0 = -90°, bin 90 = 0°, bin 180 = +90°, etc.
     // We map bins to degrees for the polar plot display
     outData.resize(kPolarPlotBins);
@@ -77,6 +167,43 @@ void ElevationCutSampler::sample(const std::vector<RCS::HitResult>& hits,
     }
 }
 
+void ElevationCutSampler::sampleBins(const std::vector<RCS::PolarBin>& bins,
+                                     std::vector<RCSDataPoint>& outData) {
+    // Bins were accumulated on the GPU with the same slice/bin rules as sample()
+    outData.resize(kPolarPlotBins);
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        outData[i].angleDegrees = static_cast<float>(i);
+
+        if (i < static_cast<int>(bins.size()) && bins[i].hitCount > 0) {
+            double avgIntensity = bins[i].intensitySum(kBinIntensityScale) / bins[i].hitCount;
+            outData[i].dBsm = intensityToDBsm(static_cast<float>(avgIntensity));
+            outData[i].valid = true;
+        } else {
+            outData[i].dBsm = kDBsmFloor;
+            outData[i].valid = false;
+        }
+    }
+}
+
+void ElevationCutSampler::sampleFieldBins(const std::vector<RCS::PolarBin>& bins,
+                                        const std::vector<RCS::FrequencyBin>& fields,
+                                        std::vector<RCSDataPoint>& outData) {
+    // |sum E|^2 over the hit count, as sample() reports in coherent mode
+    outData.resize(kPolarPlotBins);
+    for (int i = 0; i < kPolarPlotBins; ++i) {
+        outData[i].angleDegrees = static_cast<float>(i);
+
+        if (i < static_cast<int>(bins.size()) && i < static_cast<int>(fields.size()) && bins[i].hitCount > 0) {
+            double avgIntensity = fields[i].coherentIntensity(kFieldBinScale) / bins[i].hitCount;
+            outData[i].dBsm = intensityToDBsm(static_cast<float>(avgIntensity));
+            outData[i].valid = true;
+        } else {
+            outData[i].dBsm = kDBsmFloor;
+            outData[i].valid = false;
+        }
+    }
+}
+
 bool ElevationCutSampler::validateHit(const RCS::HitResult& hit) const {
     float intensity = hit.reflection.w();
 
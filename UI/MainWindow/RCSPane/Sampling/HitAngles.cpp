@@ -0,0 +1,167 @@
+// ---- RCSCompute/HitAngles.cpp ----
+
+#include "HitAngles.h"
+#include "Constants.h"
+#include "ParallelChunks.h"
+#include <algorithm>
+#include <cmath>
+
+// SSE2 is the x86-64 baseline, so this needs no extra compiler flags there
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RCS_ANGLES_SSE 1
+#endif
+
+using namespace RS::Constants;
+
+namespace {
+
+// Minimax odd polynomial for atan on [0, 1], max error about 1e-5 rad
+constexpr float kAtan1 = 0.99997726f;
+constexpr float kAtan3 = -0.33262347f;
+constexpr float kAtan5 = 0.19354346f;
+constexpr float kAtan7 = -0.11643287f;
+constexpr float kAtan9 = 0.05265332f;
+constexpr float kAtan11 = -0.01172120f;
+constexpr float kHalfPi = 1.57079633f;
+
+float atanUnit(float t) {
+    float t2 = t * t;
+    float p = kAtan9 + t2 * kAtan11;
+    p = kAtan7 + t2 * p;
+    p = kAtan5 + t2 * p;
+    p = kAtan3 + t2 * p;
+    p = kAtan1 + t2 * p;
+    return t * p;
+}
+
+// atan2 by octant reduction onto [0, 1]
+float fastAtan2(float y, float x) {
+    float ax = std::abs(x);
+    float ay = std::abs(y);
+    float hi = std::max(ax, ay);
+    float t = hi > 0.0f ? std::min(ax, ay) / hi : 0.0f;
+    float r = atanUnit(t);
+    if (ay > ax) r = kHalfPi - r;
+    if (x < 0.0f) r = kPiF - r;
+    return std::copysign(r, y);
+}
+
+#ifdef RCS_ANGLES_SSE
+__m128 atanUnit4(__m128 t) {
+    __m128 t2 = _mm_mul_ps(t, t);
+    __m128 p = _mm_add_ps(_mm_set1_ps(kAtan9), _mm_mul_ps(t2, _mm_set1_ps(kAtan11)));
+    p = _mm_add_ps(_mm_set1_ps(kAtan7), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(_mm_set1_ps(kAtan5), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(_mm_set1_ps(kAtan3), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(_mm_set1_ps(kAtan1), _mm_mul_ps(t2, p));
+    return _mm_mul_ps(t, p);
+}
+
+__m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Four atan2(y, x), same reduction as fastAtan2
+__m128 atan2x4(__m128 y, __m128 x) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 ax = _mm_andnot_ps(signMask, x);
+    __m128 ay = _mm_andnot_ps(signMask, y);
+    __m128 hi = _mm_max_ps(ax, ay);
+    __m128 lo = _mm_min_ps(ax, ay);
+    __m128 nonZero = _mm_cmpgt_ps(hi, _mm_setzero_ps());
+    __m128 t = _mm_and_ps(nonZero, _mm_div_ps(lo, select4(nonZero, hi, _mm_set1_ps(1.0f))));
+
+    __m128 r = atanUnit4(t);
+    r = select4(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(kHalfPi), r), r);
+    r = select4(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(kPiF), r), r);
+    return _mm_or_ps(r, _mm_and_ps(signMask, y));  // r >= 0, so OR-ing the sign copies it
+}
+#endif
+
+} // namespace
+
+void batchDirectionAngles(const float* x, const float* y, const float* z, size_t n,
+                          float* azimuthDegrees, float* elevationDegrees) {
+    size_t i = 0;
+#ifdef RCS_ANGLES_SSE
+    const __m128 toDegrees = _mm_set1_ps(kRadToDegF);
+    for (; i + 4 <= n; i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i);
+
+        // asin(z / |v|) == atan2(z, |v.xy|), which needs no normalization
+        __m128 horizontal = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+        _mm_storeu_ps(azimuthDegrees + i, _mm_mul_ps(atan2x4(vy, vx), toDegrees));
+        _mm_storeu_ps(elevationDegrees + i, _mm_mul_ps(atan2x4(vz, horizontal), toDegrees));
+    }
+#endif
+    for (; i < n; ++i) {
+        float horizontal = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+        azimuthDegrees[i] = fastAtan2(y[i], x[i]) * kRadToDegF;
+        elevationDegrees[i] = fastAtan2(z[i], horizontal) * kRadToDegF;
+    }
+}
+
+namespace {
+
+// Misses (distance == -1) and negative, NaN or infinite intensities are dropped
+bool usableHit(float distance, float intensity, float minIntensity) {
+    return distance >= 0.0f && std::isfinite(intensity) && intensity >= 0.0f && intensity >= minIntensity;
+}
+
+} // namespace
+
+void HitAngles::clearArrays(size_t capacity) {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    intensity_.clear();
+    x_.reserve(capacity);
+    y_.reserve(capacity);
+    z_.reserve(capacity);
+    intensity_.reserve(capacity);
+}
+
+void HitAngles::compute(const std::vector<RCS::HitResult>& hits, float minIntensity) {
+    clearArrays(hits.size());
+    for (const auto& hit : hits) {
+        float intensity = hit.reflection.w();
+        if (!usableHit(hit.hitPoint.w(), intensity, minIntensity)) {
+            continue;
+        }
+        x_.push_back(hit.reflection.x());
+        y_.push_back(hit.reflection.y());
+        z_.push_back(hit.reflection.z());
+        intensity_.push_back(intensity);
+    }
+    batchAngles();
+}
+
+void HitAngles::compute(const RCS::HitColumns& columns, float minIntensity) {
+    clearArrays(columns.count);
+    for (size_t i = 0; i < columns.count; ++i) {
+        if (!usableHit(columns.distance[i], columns.intensity[i], minIntensity)) {
+            continue;
+        }
+        x_.push_back(columns.reflectionX[i]);
+        y_.push_back(columns.reflectionY[i]);
+        z_.push_back(columns.reflectionZ[i]);
+        intensity_.push_back(columns.intensity[i]);
+    }
+    batchAngles();
+}
+
+void HitAngles::batchAngles() {
+    size_t count = intensity_.size();
+    azimuth_.resize(count);
+    elevation_.resize(count);
+
+    // Every angle is independent, so chunks need no merge
+    RS::runChunks(RS::parallelChunkCount(count, kHitParallelMinHits), count,
+                  [this](int, size_t begin, size_t end) {
+        batchDirectionAngles(x_.data() + begin, y_.data() + begin, z_.data() + begin, end - begin,
+                             azimuth_.data() + begin, elevation_.data() + begin);
+    });
+}
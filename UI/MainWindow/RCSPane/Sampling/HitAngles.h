@@ -0,0 +1,46 @@
+// ---- RCSCompute/HitAngles.h ----
+// Batched azimuth/elevation of hit reflection directions for the CPU samplers
+
+#pragma once
+
+#include "RCSTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Angles of n direction vectors (need not be normalized), four at a time with
+// SSE2 polynomial atan2 where available. Azimuth is atan2(y, x) in
+// [-180, 180] degrees, elevation asin(z / |v|) in [-90, 90] degrees, both
+// within 0.003 degrees of libm - far below half a 1-degree bin.
+void batchDirectionAngles(const float* x, const float* y, const float* z, size_t n,
+                          float* azimuthDegrees, float* elevationDegrees);
+
+// Copies the usable hits of a result buffer into structure-of-arrays form
+// (reflection direction and intensity) and computes their angles in one
+// batch. The samplers and the CPU heat map then bin from the arrays instead
+// of calling libm through QVector3D per hit.
+class HitAngles {
+public:
+    // Keeps hits with a hit point and a finite intensity >= minIntensity
+    void compute(const std::vector<RCS::HitResult>& hits, float minIntensity = 0.0f);
+
+    // Same from a HitPayload::Columns view; only distance, reflection and
+    // intensity are read
+    void compute(const RCS::HitColumns& columns, float minIntensity = 0.0f);
+
+    size_t size() const { return intensity_.size(); }
+    const std::vector<float>& azimuthDegrees() const { return azimuth_; }
+    const std::vector<float>& elevationDegrees() const { return elevation_; }
+    const std::vector<float>& intensities() const { return intensity_; }
+
+private:
+    void clearArrays(size_t capacity);
+    void batchAngles();
+
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> z_;
+    std::vector<float> intensity_;
+    std::vector<float> azimuth_;
+    std::vector<float> elevation_;
+};
@@ -0,0 +1,203 @@
+// ---- RCSCompute/MultiCutSampler.cpp ----
+
+#include "MultiCutSampler.h"
+#include "ParallelChunks.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace {
+
+float intensityToDBsm(double intensity) {
+    if (intensity <= kMinValidIntensity) {
+        return kDBsmFloor;
+    }
+    return std::max(static_cast<float>(10.0 * std::log10(intensity)), kDBsmFloor);
+}
+
+// As HitAngles: misses and negative, NaN or infinite intensities are dropped
+bool usableHit(const RCS::HitResult& hit) {
+    float intensity = hit.reflection.w();
+    return hit.hitPoint.w() >= 0.0f && std::isfinite(intensity) && intensity >= 0.0f;
+}
+
+} // namespace
+
+MultiCutSampler::MultiCutSampler() = default;
+
+void MultiCutSampler::setCuts(const std::vector<CutSpec>& cuts) {
+    cuts_ = cuts;
+    prepareSlices();
+}
+
+void MultiCutSampler::setCoherent(bool coherent, double waveNumber) {
+    coherent_ = coherent;
+    waveNumber_ = waveNumber;
+}
+
+void MultiCutSampler::prepareSlices() {
+    slices_.clear();
+    for (const CutSpec& cut : cuts_) {
+        Slice slice;
+        slice.azimuthCut = cut.type == CutType::Azimuth;
+        slice.offset = slice.azimuthCut
+            ? cut.offsetDegrees
+            : cut.offsetDegrees - 360.0f * std::floor((cut.offsetDegrees + 180.0f) / 360.0f);
+        slice.thickness = cut.thicknessDegrees;
+        slices_.push_back(slice);
+    }
+}
+
+int MultiCutSampler::binHit(const Slice& slice, float azimuthDegrees, float elevationDegrees) {
+    if (slice.azimuthCut) {
+        // Horizontal slab around the offset elevation, binned by azimuth
+        if (std::abs(elevationDegrees - slice.offset) > slice.thickness) {
+            return -1;
+        }
+        float azimuth = azimuthDegrees < 0.0f ? azimuthDegrees + 360.0f : azimuthDegrees;
+        return std::min(static_cast<int>(azimuth), kPolarPlotBins - 1);
+    }
+
+    // Vertical plane through the offset azimuth; both sides count, the
+    // front maps elevation to bins 0-180 and the back to 180-360
+    float delta = azimuthDegrees - slice.offset;
+    if (delta > 180.0f) delta -= 360.0f;
+    if (delta < -180.0f) delta += 360.0f;
+    float fromPlane = std::abs(delta);
+    if (std::min(fromPlane, 180.0f - fromPlane) > slice.thickness) {
+        return -1;
+    }
+    int bin = fromPlane <= 90.0f ? static_cast<int>(std::round(elevationDegrees + 90.0f))
+                                 : static_cast<int>(std::round(270.0f - elevationDegrees));
+    return std::clamp(bin, 0, kPolarPlotBins - 1);
+}
+
+void MultiCutSampler::sample(const std::vector<RCS::HitResult>& hits,
+                             std::vector<std::vector<RCSDataPoint>>& outCurves) {
+    const size_t cutCount = slices_.size();
+    binIntensity_.assign(cutCount * kPolarPlotBins, 0.0);
+    binHitCount_.assign(cutCount * kPolarPlotBins, 0);
+
+    if (coherent_) {
+        // Angles and phasor once per hit, then one queue entry per cut it falls in
+        x_.clear();
+        y_.clear();
+        z_.clear();
+        for (const auto& hit : hits) {
+            if (usableHit(hit)) {
+                x_.push_back(hit.reflection.x());
+                y_.push_back(hit.reflection.y());
+                z_.push_back(hit.reflection.z());
+            }
+        }
+        azimuth_.resize(x_.size());
+        elevation_.resize(x_.size());
+        batchDirectionAngles(x_.data(), y_.data(), z_.data(), x_.size(), azimuth_.data(), elevation_.data());
+
+        coherentBins_.resize(cutCount);
+        for (auto& bins : coherentBins_) {
+            bins.reset(kPolarPlotBins);
+        }
+        size_t usable = 0;
+        for (const auto& hit : hits) {
+            if (!usableHit(hit)) {
+                continue;
+            }
+            float amplitude = 0.0f;
+            float phase = 0.0f;
+            bool phasor = false;
+            for (size_t c = 0; c < cutCount; ++c) {
+                int bin = binHit(slices_[c], azimuth_[usable], elevation_[usable]);
+                if (bin < 0) {
+                    continue;
+                }
+                if (!phasor) {
+                    CoherentAccumulator::hitPhasor(hit, waveNumber_, amplitude, phase);
+                    phasor = true;
+                }
+                coherentBins_[c].addPhasor(bin, amplitude, phase);
+                binHitCount_[c * kPolarPlotBins + bin]++;
+            }
+            ++usable;
+        }
+        for (size_t c = 0; c < cutCount; ++c) {
+            coherentBins_[c].resolve();
+            for (int i = 0; i < kPolarPlotBins; ++i) {
+                binIntensity_[c * kPolarPlotBins + i] = coherentBins_[c].intensity(i);
+            }
+        }
+        writeOutput(outCurves);
+        return;
+    }
+
+    // Incoherent: batched angles, then every chunk bins its hits into all cuts
+    angles_.compute(hits);
+    int chunks = RS::parallelChunkCount(angles_.size(), kHitParallelMinHits);
+    partialIntensity_.resize(chunks - 1);
+    partialHitCount_.resize(chunks - 1);
+    for (int c = 0; c + 1 < chunks; ++c) {
+        partialIntensity_[c].assign(cutCount * kPolarPlotBins, 0.0);
+        partialHitCount_[c].assign(cutCount * kPolarPlotBins, 0);
+    }
+
+    const float* azimuth = angles_.azimuthDegrees().data();
+    const float* elevation = angles_.elevationDegrees().data();
+    const float* intensity = angles_.intensities().data();
+    RS::runChunks(chunks, angles_.size(), [&](int chunk, size_t begin, size_t end) {
+        double* sums = chunk == 0 ? binIntensity_.data() : partialIntensity_[chunk - 1].data();
+        uint32_t* counts = chunk == 0 ? binHitCount_.data() : partialHitCount_[chunk - 1].data();
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t c = 0; c < cutCount; ++c) {
+                int bin = binHit(slices_[c], azimuth[i], elevation[i]);
+                if (bin >= 0) {
+                    sums[c * kPolarPlotBins + bin] += intensity[i];
+                    counts[c * kPolarPlotBins + bin]++;
+                }
+            }
+        }
+    });
+    for (int c = 0; c + 1 < chunks; ++c) {
+        for (size_t i = 0; i < binIntensity_.size(); ++i) {
+            binIntensity_[i] += partialIntensity_[c][i];
+            binHitCount_[i] += partialHitCount_[c][i];
+        }
+    }
+    writeOutput(outCurves);
+}
+
+void MultiCutSampler::sampleTable(const SphereRCSTable& table,
+                                  std::vector<std::vector<RCSDataPoint>>& outCurves) {
+    const size_t cutCount = cuts_.size();
+    binIntensity_.assign(cutCount * kPolarPlotBins, 0.0);
+    binHitCount_.assign(cutCount * kPolarPlotBins, 0);
+    for (size_t c = 0; c < cutCount; ++c) {
+        const CutSpec& cut = cuts_[c];
+        table.extractCut(static_cast<int>(cut.type), cut.offsetDegrees, cut.thicknessDegrees, tableBins_);
+        for (int i = 0; i < kPolarPlotBins; ++i) {
+            binIntensity_[c * kPolarPlotBins + i] = tableBins_[i].intensitySum(kBinIntensityScale);
+            binHitCount_[c * kPolarPlotBins + i] = tableBins_[i].hitCount;
+        }
+    }
+    writeOutput(outCurves);
+}
+
+void MultiCutSampler::writeOutput(std::vector<std::vector<RCSDataPoint>>& outCurves) const {
+    // Average intensity per bin in dBsm, as the single-cut samplers report
+    outCurves.resize(binIntensity_.size() / kPolarPlotBins);
+    for (size_t c = 0; c < outCurves.size(); ++c) {
+        std::vector<RCSDataPoint>& curve = outCurves[c];
+        curve.resize(kPolarPlotBins);
+        for (int i = 0; i < kPolarPlotBins; ++i) {
+            uint32_t count = binHitCount_[c * kPolarPlotBins + i];
+            curve[i].angleDegrees = static_cast<float>(i);
+            if (count > 0) {
+                curve[i].dBsm = intensityToDBsm(binIntensity_[c * kPolarPlotBins + i] / count);
+                curve[i].valid = true;
+            } else {
+                curve[i].dBsm = kDBsmFloor;
+                curve[i].valid = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+// ---- RCSCompute/MultiCutSampler.h ----
+// Several polar cuts of one hit set in a single pass over the hits
+
+#pragma once
+
+#include "RCSSampler.h"
+#include "CoherentAccumulator.h"
+#include "HitAngles.h"
+#include "SphereRCSTable.h"
+#include "Constants.h"
+#include <vector>
+
+// One cut of a multi-cut set: the slice AzimuthCutSampler or
+// ElevationCutSampler would take at this offset and thickness
+struct CutSpec {
+    CutType type = CutType::Azimuth;
+    float offsetDegrees = 0.0f;
+    float thicknessDegrees = RS::Constants::kDefaultSliceThickness;
+};
+
+// Bins a hit set into any mix of azimuth and elevation cuts at once. The
+// angles of each hit's reflection direction (and in coherent mode its
+// phasor) are computed once; every cut then only tests its slice and adds
+// to its bin. Slice and bin rules are the per-hit ones of the single-cut
+// samplers' coherent path and of the GPU polar binning. Incoherent hit sets
+// large enough to split are binned in parallel chunks.
+class MultiCutSampler {
+public:
+    MultiCutSampler();
+
+    void setCuts(const std::vector<CutSpec>& cuts);
+    const std::vector<CutSpec>& getCuts() const { return cuts_; }
+
+    // See RCSSampler::setCoherent
+    void setCoherent(bool coherent, double waveNumber);
+    bool isCoherent() const { return coherent_; }
+
+    // One curve (kPolarPlotBins points) per cut, in setCuts() order
+    void sample(const std::vector<RCS::HitResult>& hits,
+                std::vector<std::vector<RCSDataPoint>>& outCurves);
+
+    // Incoherent cuts of a full-sphere table (RCSCompute sphere binning);
+    // no pass over the hits at all
+    void sampleTable(const SphereRCSTable& table,
+                     std::vector<std::vector<RCSDataPoint>>& outCurves);
+
+private:
+    struct Slice {
+        bool azimuthCut;
+        float offset;     // Elevation (azimuth cut) or azimuth in [-180, 180) (elevation cut)
+        float thickness;
+    };
+
+    // Output bin of a hit in one cut, or -1 outside its slice
+    static int binHit(const Slice& slice, float azimuthDegrees, float elevationDegrees);
+    void prepareSlices();
+    void writeOutput(std::vector<std::vector<RCSDataPoint>>& outCurves) const;
+
+    std::vector<CutSpec> cuts_;
+    std::vector<Slice> slices_;
+
+    // Per cut, kPolarPlotBins each
+    std::vector<double> binIntensity_;
+    std::vector<uint32_t> binHitCount_;
+    std::vector<std::vector<double>> partialIntensity_;  // Per extra chunk
+    std::vector<std::vector<uint32_t>> partialHitCount_;
+
+    bool coherent_ = false;
+    double waveNumber_ = 0.0;
+    std::vector<CoherentAccumulator> coherentBins_;  // One per cut
+
+    HitAngles angles_;
+    std::vector<float> x_, y_, z_;  // Coherent: directions of the usable hits
+    std::vector<float> azimuth_, elevation_;
+    std::vector<RCS::PolarBin> tableBins_;
+};
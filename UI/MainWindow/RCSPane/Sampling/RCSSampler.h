@@ -29,6 +29,33 @@ public:
     virtual void sample(const std::vector<RCS::HitResult>& hits,
                         std::vector<RCSDataPoint>& outData) = 0;
 
+    // Same as sample() from a HitPayload::Columns view (RCSCompute::getLatestHitColumns)
+    virtual void sampleColumns(const RCS::HitColumns& columns,
+                               std::vector<RCSDataPoint>& outData) = 0;
+
+    // Re-slice the hits of the last sample() at the current offset and
+    // thickness without touching them again. Returns false when there is
+    // nothing to re-slice (no sample() yet, or coherent mode, which bins
+    // directly); call sample() instead.
+    virtual bool resample(std::vector<RCSDataPoint>& outData) = 0;
+
+    // Convert GPU-binned results (RCSCompute::getLatestPolarBins) to angle->dBsm data.
+    // Bins must have been accumulated with this sampler's cut type, offset and thickness.
+    virtual void sampleBins(const std::vector<RCS::PolarBin>& bins,
+                            std::vector<RCSDataPoint>& outData) = 0;
+
+    // Coherent (GPU) counterpart of sampleBins: field bins from a one-point
+    // RCSCompute frequency sweep, normalized by the polar bins' hit counts
+    virtual void sampleFieldBins(const std::vector<RCS::PolarBin>& bins,
+                                 const std::vector<RCS::FrequencyBin>& fields,
+                                 std::vector<RCSDataPoint>& outData) = 0;
+
+    // Coherent summation - sample() adds each hit's complex field
+    // sqrt(intensity) * exp(-i k L) per bin instead of its intensity, so the
+    // cut shows interference lobes. waveNumber is k in radians per scene unit.
+    virtual void setCoherent(bool coherent, double waveNumber) = 0;
+    virtual bool isCoherent() const = 0;
+
     // Configuration
     virtual void setThickness(float degrees) = 0;  // Angular slab ±thickness
     virtual void setOffset(float offset) = 0;      // Plane offset (elevation for azimuth cut)
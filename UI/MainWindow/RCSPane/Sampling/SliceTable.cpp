@@ -0,0 +1,102 @@
+// ---- RCSCompute/SliceTable.cpp ----
+
+#include "SliceTable.h"
+#include <algorithm>
+#include <cmath>
+
+void SliceTable::reset(int bins, int cells, float firstDegrees, float cellDegrees, bool wraps) {
+    bins_ = std::max(bins, 0);
+    cells_ = std::max(cells, 1);
+    firstDegrees_ = firstDegrees;
+    cellDegrees_ = cellDegrees;
+    wraps_ = wraps;
+    finalized_ = false;
+    sums_.assign(static_cast<size_t>(bins_) * (cells_ + 1), Sum());
+}
+
+void SliceTable::add(int bin, float sliceDegrees, float intensity) {
+    if (finalized_ || bin < 0 || bin >= bins_) {
+        return;
+    }
+
+    int cell = static_cast<int>(std::floor((sliceDegrees - firstDegrees_) / cellDegrees_));
+    if (wraps_) {
+        cell %= cells_;
+        if (cell < 0) cell += cells_;
+    } else {
+        // The axis end itself (elevation +90) belongs to the last cell
+        cell = std::clamp(cell, 0, cells_ - 1);
+    }
+
+    // Slot 0 of each bin stays zero so the prefix sums need no special case
+    Sum& sum = sums_[static_cast<size_t>(bin) * (cells_ + 1) + cell + 1];
+    sum.intensity += intensity;
+    sum.hitCount++;
+}
+
+void SliceTable::accumulate(const SliceTable& other) {
+    if (finalized_ || other.finalized_ || other.sums_.size() != sums_.size()) {
+        return;
+    }
+    for (size_t i = 0; i < sums_.size(); ++i) {
+        sums_[i].intensity += other.sums_[i].intensity;
+        sums_[i].hitCount += other.sums_[i].hitCount;
+    }
+}
+
+void SliceTable::finalize() {
+    for (int bin = 0; bin < bins_; ++bin) {
+        Sum* sums = &sums_[static_cast<size_t>(bin) * (cells_ + 1)];
+        for (int cell = 1; cell <= cells_; ++cell) {
+            sums[cell].intensity += sums[cell - 1].intensity;
+            sums[cell].hitCount += sums[cell - 1].hitCount;
+        }
+    }
+    finalized_ = true;
+}
+
+SliceTable::Sum SliceTable::prefixSpan(int bin, int first, int last) const {
+    const Sum* sums = &sums_[static_cast<size_t>(bin) * (cells_ + 1)];
+    Sum span;
+    span.intensity = sums[last + 1].intensity - sums[first].intensity;
+    span.hitCount = sums[last + 1].hitCount - sums[first].hitCount;
+    return span;
+}
+
+SliceTable::Sum SliceTable::range(int bin, float lowDegrees, float highDegrees) const {
+    Sum sum;
+    if (!finalized_ || bin < 0 || bin >= bins_) {
+        return sum;
+    }
+
+    int first = static_cast<int>(std::ceil((lowDegrees - firstDegrees_) / cellDegrees_ - 0.5f));
+    int last = static_cast<int>(std::floor((highDegrees - firstDegrees_) / cellDegrees_ - 0.5f));
+    if (last < first) {
+        return sum;
+    }
+
+    if (!wraps_) {
+        first = std::max(first, 0);
+        last = std::min(last, cells_ - 1);
+        return first <= last ? prefixSpan(bin, first, last) : sum;
+    }
+
+    // Wider than the axis: every cell once
+    if (last - first + 1 >= cells_) {
+        return prefixSpan(bin, 0, cells_ - 1);
+    }
+    first %= cells_;
+    if (first < 0) first += cells_;
+    last %= cells_;
+    if (last < 0) last += cells_;
+    if (first <= last) {
+        return prefixSpan(bin, first, last);
+    }
+
+    // Runs past the end of the axis: the tail plus the head
+    Sum tail = prefixSpan(bin, first, cells_ - 1);
+    Sum head = prefixSpan(bin, 0, last);
+    sum.intensity = tail.intensity + head.intensity;
+    sum.hitCount = tail.hitCount + head.hitCount;
+    return sum;
+}
@@ -0,0 +1,50 @@
+// ---- RCSCompute/SliceTable.h ----
+// Per-bin prefix sums of hit intensity over a finely bucketed slice angle
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// The CPU samplers bucket each hit once by output bin (the polar plot angle)
+// and by the angle their slice test looks at, in kSliceTableCellDegrees
+// cells. Every bin keeps a prefix sum over those cells, so the hits of any
+// slice offset and thickness are two lookups per bin.
+// A cell is in a slice if its center is.
+class SliceTable {
+public:
+    struct Sum {
+        double intensity = 0.0;
+        uint32_t hitCount = 0;
+    };
+
+    // Clear to bins x cells; cells cover [firstDegrees, firstDegrees + cells * cellDegrees).
+    // A wrapping axis (azimuth) lets ranges run past either end.
+    void reset(int bins, int cells, float firstDegrees, float cellDegrees, bool wraps);
+
+    // Accumulate one hit; ignored after finalize() or outside the axis
+    void add(int bin, float sliceDegrees, float intensity);
+
+    // Add another table's cell sums (same shape, neither finalized). Lets
+    // threads fill partial tables over chunks of hits and merge them.
+    void accumulate(const SliceTable& other);
+
+    // Turn the cell sums into prefix sums; range() is valid afterwards
+    void finalize();
+    bool isValid() const { return finalized_; }
+    void clear() { bins_ = 0; finalized_ = false; sums_.clear(); }
+
+    // Sum of a bin over cells whose centers lie in [lowDegrees, highDegrees]
+    Sum range(int bin, float lowDegrees, float highDegrees) const;
+
+private:
+    Sum prefixSpan(int bin, int first, int last) const;  // Inclusive, within the axis
+
+    int bins_ = 0;
+    int cells_ = 0;
+    float firstDegrees_ = 0.0f;
+    float cellDegrees_ = 1.0f;
+    bool wraps_ = false;
+    bool finalized_ = false;
+    std::vector<Sum> sums_;  // (cells_ + 1) per bin; cell sums until finalize()
+};
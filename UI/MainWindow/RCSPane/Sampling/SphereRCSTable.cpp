@@ -0,0 +1,140 @@
+// ---- RCSCompute/SphereRCSTable.cpp ----
+
+#include "SphereRCSTable.h"
+#include "Constants.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace RS::Constants;
+
+namespace {
+
+constexpr float kAzCellDegrees = 360.0f / kSphereTableAzBins;
+constexpr float kElCellDegrees = 180.0f / kSphereTableElBins;
+
+uint64_t cellIntensity(const RCS::PolarBin& cell) {
+    return (static_cast<uint64_t>(cell.intensityHi) << 32) | cell.intensityLo;
+}
+
+// First and last cell index whose center lies in [low, high] for cells of
+// the given size starting at origin (indices may fall outside the grid)
+void centeredRange(float low, float high, float origin, float cellSize, int& first, int& last) {
+    first = static_cast<int>(std::ceil((low - origin) / cellSize - 0.5f));
+    last = static_cast<int>(std::floor((high - origin) / cellSize - 0.5f));
+}
+
+} // namespace
+
+void SphereRCSTable::clear() {
+    valid_ = false;
+    columnPrefix_.clear();
+    rowPrefix_.clear();
+}
+
+void SphereRCSTable::build(const std::vector<RCS::PolarBin>& cells) {
+    if (static_cast<int>(cells.size()) != kSphereTableAzBins * kSphereTableElBins) {
+        clear();
+        return;
+    }
+
+    const int columnStride = kSphereTableElBins + 1;
+    const int rowStride = kSphereTableAzBins + 1;
+    columnPrefix_.assign(static_cast<size_t>(kSphereTableAzBins) * columnStride, Sum());
+    rowPrefix_.assign(static_cast<size_t>(kSphereTableElBins) * rowStride, Sum());
+
+    for (int row = 0; row < kSphereTableElBins; ++row) {
+        Sum* rowSums = &rowPrefix_[static_cast<size_t>(row) * rowStride];
+        for (int column = 0; column < kSphereTableAzBins; ++column) {
+            const RCS::PolarBin& cell = cells[static_cast<size_t>(row) * kSphereTableAzBins + column];
+            uint64_t intensity = cellIntensity(cell);
+
+            rowSums[column + 1].intensity = rowSums[column].intensity + intensity;
+            rowSums[column + 1].count = rowSums[column].count + cell.hitCount;
+
+            Sum* columnSums = &columnPrefix_[static_cast<size_t>(column) * columnStride];
+            columnSums[row + 1].intensity = columnSums[row].intensity + intensity;
+            columnSums[row + 1].count = columnSums[row].count + cell.hitCount;
+        }
+    }
+    valid_ = true;
+}
+
+SphereRCSTable::Sum SphereRCSTable::columnRange(int column, int rowBegin, int rowEnd) const {
+    rowBegin = std::max(rowBegin, 0);
+    rowEnd = std::min(rowEnd, kSphereTableElBins - 1);
+    Sum sum;
+    if (rowBegin > rowEnd) return sum;
+
+    const Sum* sums = &columnPrefix_[static_cast<size_t>(column) * (kSphereTableElBins + 1)];
+    sum.intensity = sums[rowEnd + 1].intensity - sums[rowBegin].intensity;
+    sum.count = sums[rowEnd + 1].count - sums[rowBegin].count;
+    return sum;
+}
+
+SphereRCSTable::Sum SphereRCSTable::rowRange(int row, int columnBegin, int columnEnd) const {
+    Sum sum;
+    if (columnBegin > columnEnd) return sum;
+    if (columnEnd - columnBegin + 1 >= kSphereTableAzBins) {
+        columnBegin = 0;
+        columnEnd = kSphereTableAzBins - 1;
+    }
+
+    // Wrap into the grid; a range crossing 0/360 degrees splits in two
+    int begin = ((columnBegin % kSphereTableAzBins) + kSphereTableAzBins) % kSphereTableAzBins;
+    int end = begin + (columnEnd - columnBegin);
+    const Sum* sums = &rowPrefix_[static_cast<size_t>(row) * (kSphereTableAzBins + 1)];
+    auto span = [&](int b, int e) {
+        sum.intensity += sums[e + 1].intensity - sums[b].intensity;
+        sum.count += sums[e + 1].count - sums[b].count;
+    };
+    if (end < kSphereTableAzBins) {
+        span(begin, end);
+    } else {
+        span(begin, kSphereTableAzBins - 1);
+        span(0, end - kSphereTableAzBins);
+    }
+    return sum;
+}
+
+void SphereRCSTable::addTo(RCS::PolarBin& bin, const Sum& sum) {
+    uint64_t intensity = ((static_cast<uint64_t>(bin.intensityHi) << 32) | bin.intensityLo) + sum.intensity;
+    bin.intensityLo = static_cast<uint32_t>(intensity & 0xFFFFFFFFu);
+    bin.intensityHi = static_cast<uint32_t>(intensity >> 32);
+    bin.hitCount += static_cast<uint32_t>(sum.count);
+}
+
+void SphereRCSTable::extractCut(int cutType, float offsetDegrees, float thicknessDegrees,
+                                std::vector<RCS::PolarBin>& outBins) const {
+    outBins.assign(kPolarPlotBins, RCS::PolarBin{0, 0, 0, 0});
+    if (!valid_) return;
+
+    if (cutType == 0) {
+        // Azimuth cut: elevation rows within the slice, one-degree azimuth bins
+        int rowBegin, rowEnd;
+        centeredRange(offsetDegrees - thicknessDegrees, offsetDegrees + thicknessDegrees,
+                      -90.0f, kElCellDegrees, rowBegin, rowEnd);
+        const int columnsPerBin = kSphereTableAzBins / kPolarPlotBins;
+        for (int column = 0; column < kSphereTableAzBins; ++column) {
+            addTo(outBins[column / columnsPerBin], columnRange(column, rowBegin, rowEnd));
+        }
+        return;
+    }
+
+    // Elevation cut: azimuth columns around the offset (front) and its
+    // opposite (back), binned by elevation like the GPU polar binning
+    float offsetNorm = offsetDegrees - 360.0f * std::floor((offsetDegrees + 180.0f) / 360.0f);
+    float opposite = offsetNorm + 180.0f;
+    int frontBegin, frontEnd, backBegin, backEnd;
+    centeredRange(offsetNorm - thicknessDegrees, offsetNorm + thicknessDegrees, 0.0f, kAzCellDegrees,
+                  frontBegin, frontEnd);
+    centeredRange(opposite - thicknessDegrees, opposite + thicknessDegrees, 0.0f, kAzCellDegrees,
+                  backBegin, backEnd);
+
+    for (int row = 0; row < kSphereTableElBins; ++row) {
+        float elevation = -90.0f + (row + 0.5f) * kElCellDegrees;
+        int frontBin = std::clamp(static_cast<int>(std::floor(elevation + 90.0f + 0.5f)), 0, kPolarPlotBins - 1);
+        int backBin = std::clamp(static_cast<int>(std::floor(270.0f - elevation + 0.5f)), 0, kPolarPlotBins - 1);
+        addTo(outBins[frontBin], rowRange(row, frontBegin, frontEnd));
+        addTo(outBins[backBin], rowRange(row, backBegin, backEnd));
+    }
+}
@@ -0,0 +1,44 @@
+// ---- RCSCompute/SphereRCSTable.h ----
+// Full-sphere (azimuth x elevation) RCS accumulation with prefix sums for cut extraction
+
+#pragma once
+
+#include "RCSTypes.h"
+#include <cstdint>
+#include <vector>
+
+// Built from RCSCompute::getLatestSphereBins(). Every azimuth column keeps a
+// prefix sum over elevation and every elevation row a prefix sum over
+// azimuth. A polar cut at any cut type, offset and thickness is then a few
+// hundred prefix differences - no retrace and no pass over the hits. Sums
+// stay in the GPU's fixed point, so extracted bins are exact cell sums.
+// Slices resolve to the kSphereTableAzBins x kSphereTableElBins cell grid.
+// A cell is in a slice if its center is.
+class SphereRCSTable {
+public:
+    // Cells are elevation-major (row = elevation, -90 degrees first)
+    void build(const std::vector<RCS::PolarBin>& cells);
+    void clear();
+    bool isValid() const { return valid_; }
+
+    // Polar bins (kPolarPlotBins, same bin layout as the GPU polar binning)
+    // for a cut: cutType 0 = azimuth cut, 1 = elevation cut
+    void extractCut(int cutType, float offsetDegrees, float thicknessDegrees,
+                    std::vector<RCS::PolarBin>& outBins) const;
+
+private:
+    struct Sum {
+        uint64_t intensity = 0;  // kBinIntensityScale fixed point
+        uint64_t count = 0;
+    };
+
+    // Inclusive cell ranges; callers pass ranges that may wrap in azimuth
+    Sum columnRange(int column, int rowBegin, int rowEnd) const;
+    Sum rowRange(int row, int columnBegin, int columnEnd) const;
+
+    static void addTo(RCS::PolarBin& bin, const Sum& sum);
+
+    bool valid_ = false;
+    std::vector<Sum> columnPrefix_;  // (kSphereTableElBins + 1) per azimuth column
+    std::vector<Sum> rowPrefix_;     // (kSphereTableAzBins + 1) per elevation row
+};
@@ -2,35 +2,70 @@
 #include "ReflectionRenderer.h"
 #include "GLUtils.h"
 #include "Constants.h"
+#include "ParallelChunks.h"
+#include "TransparencyPass.h"
 #include <QOpenGLContext>
 #include <QDebug>
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 
 using namespace RS::Constants;
 
 ReflectionRenderer::ReflectionRenderer(QObject* parent)
     : QObject(parent)
 {
-    // Vertex shader for lobe rendering
+    // Vertex shader: places the unit cone (apex at the origin, axis +Z, unit
+    // length and base radius) at one lobe per instance. Instance attributes are
+    // an RCS::ReflectionCluster, the layout the GPU clustering pass writes.
     vertexShaderSource_ = R"(
         #version 430 core
         layout (location = 0) in vec3 aPos;
         layout (location = 1) in vec3 aNormal;
-        layout (location = 2) in vec3 aColor;
+        layout (location = 2) in vec4 iPosition;    // xyz = apex, w = hit count
+        layout (location = 3) in vec4 iDirection;   // xyz = reflection direction
+        layout (location = 4) in vec4 iProperties;  // x = intensity (0-1)
 
         uniform mat4 model;
         uniform mat4 view;
         uniform mat4 projection;
+        uniform float coneLength;      // World length at full intensity, lobe scale applied
+        uniform float coneRadius;
+        uniform float lengthScaleMin;  // Fractions of the full size at zero intensity
+        uniform float radiusScaleMin;
+        uniform float gimbalThreshold;
+        uniform float colorThreshold;
+        uniform vec3 lowColor;
+        uniform vec3 midColor;
+        uniform vec3 highColor;
 
         out vec3 FragPos;
         out vec3 Normal;
         out vec3 Color;
 
         void main() {
-            FragPos = vec3(model * vec4(aPos, 1.0));
-            Normal = mat3(transpose(inverse(model))) * aNormal;
-            Color = aColor;
+            float intensity = iProperties.x;
+            float len = coneLength * (lengthScaleMin + (1.0 - lengthScaleMin) * intensity);
+            float radius = coneRadius * (radiusScaleMin + (1.0 - radiusScaleMin) * intensity);
+
+            // Cone frame around the reflection direction
+            vec3 dir = normalize(iDirection.xyz);
+            vec3 up = abs(dot(dir, vec3(0.0, 0.0, 1.0))) > gimbalThreshold ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 0.0, 1.0);
+            vec3 right = normalize(cross(dir, up));
+            up = normalize(cross(right, dir));
+
+            vec3 local = (right * aPos.x + up * aPos.y) * radius + dir * (aPos.z * len);
+            vec3 normal = right * aNormal.x + up * aNormal.y + dir * aNormal.z;
+
+            // Blue (low) -> Yellow (mid) -> Red (high)
+            Color = intensity < colorThreshold
+                ? mix(lowColor, midColor, intensity / colorThreshold)
+                : mix(midColor, highColor, (intensity - colorThreshold) / (1.0 - colorThreshold));
+
+            FragPos = vec3(model * vec4(iPosition.xyz + local, 1.0));
+            Normal = mat3(transpose(inverse(model))) * normal;
             gl_Position = projection * view * vec4(FragPos, 1.0);
         }
     )";
@@ -45,8 +80,6 @@ ReflectionRenderer::ReflectionRenderer(QObject* parent)
         uniform vec3 viewPos;
         uniform float opacity;
 
-        out vec4 FragColor;
-
         void main() {
             vec3 norm = normalize(Normal);
             vec3 viewDir = normalize(viewPos - FragPos);
@@ -60,7 +93,7 @@ ReflectionRenderer::ReflectionRenderer(QObject* parent)
             float fresnel = 0.4 + 0.6 * pow(1.0 - abs(dot(norm, viewDir)), 2.0);
 
             vec3 result = Color * lighting;
-            FragColor = vec4(result, opacity * fresnel);
+            writeTransparent(vec4(result, opacity * fresnel));
         }
     )";
 }
@@ -89,8 +122,11 @@ bool ReflectionRenderer::initialize() {
     setupShaders();
 
     vao_.create();
-    vao_.bind();
-    vao_.release();
+    createConeMesh();
+
+    if (!stream_.initialize("ReflectionRenderer", kMaxReflectionLobes * sizeof(RCS::ReflectionCluster))) {
+        return false;
+    }
 
     GLUtils::checkGLError("ReflectionRenderer::initialize");
 
@@ -116,6 +152,7 @@ void ReflectionRenderer::cleanup() {
         glDeleteBuffers(1, &eboId_);
         eboId_ = 0;
     }
+    stream_.cleanup();
     shaderProgram_.reset();
     initialized_ = false;
 }
@@ -128,12 +165,13 @@ void ReflectionRenderer::setupShaders() {
 
     shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
         qCritical() << "ReflectionRenderer: Failed to compile vertex shader:" << shaderProgram_->log();
         return;
     }
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+    const std::string fragmentSource = TransparencyPass::fragmentShader(fragmentShaderSource_);
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentSource.c_str())) {
         qCritical() << "ReflectionRenderer: Failed to compile fragment shader:" << shaderProgram_->log();
         return;
     }
@@ -145,24 +183,93 @@ void ReflectionRenderer::setupShaders() {
 }
 
 void ReflectionRenderer::updateLobes(const std::vector<RCS::HitResult>& hits) {
-    lobes_ = clusterHits(hits);
-    generateLobeGeometry();
+    clusterHits(hits);
+    generateInstances();
     geometryDirty_ = true;
     emit lobeCountChanged(static_cast<int>(lobes_.size()));
 }
 
-std::vector<ReflectionLobe> ReflectionRenderer::clusterHits(const std::vector<RCS::HitResult>& hits) {
-    std::vector<ReflectionLobe> result;
-    std::vector<bool> assigned(hits.size(), false);
+int ReflectionRenderer::directionBucket(const QVector3D& dir) {
+    // Cube-map quantization: 6 faces x N x N cells, each roughly kLobeClusterAngle wide.
+    // Must match lobeDirectionBucket() in RCSCompute's clustering shader.
+    const int n = std::max(1, static_cast<int>(std::ceil(90.0f / kLobeClusterAngle)));
+    float ax = std::abs(dir.x()), ay = std::abs(dir.y()), az = std::abs(dir.z());
+    int face;
+    float u, v;
+    if (ax >= ay && ax >= az && ax > 0.0f) {
+        face = dir.x() > 0.0f ? 0 : 1; u = dir.y() / ax; v = dir.z() / ax;
+    } else if (ay >= az && ay > 0.0f) {
+        face = dir.y() > 0.0f ? 2 : 3; u = dir.x() / ay; v = dir.z() / ay;
+    } else if (az > 0.0f) {
+        face = dir.z() > 0.0f ? 4 : 5; u = dir.x() / az; v = dir.y() / az;
+    } else {
+        return 0;
+    }
+    int ui = std::min(static_cast<int>((u + 1.0f) * 0.5f * n), n - 1);
+    int vi = std::min(static_cast<int>((v + 1.0f) * 0.5f * n), n - 1);
+    return (face * n + vi) * n + ui;
+}
 
-    float clusterAngleCos = std::cos(kLobeClusterAngle * kDegToRadF);
-    float clusterDistSq = kLobeClusterDist * kLobeClusterDist;
+namespace {
+    size_t clusterSlot(uint64_t key, size_t mask) {
+        uint64_t h = key * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32)) & mask;
+    }
+}
 
-    for (size_t i = 0; i < hits.size() && result.size() < static_cast<size_t>(kMaxReflectionLobes); ++i) {
-        const auto& hit = hits[i];
+void ReflectionRenderer::ClusterTable::reset(size_t expected) {
+    // Load factor stays at or below 1/2
+    size_t size = 64;
+    while (size < expected * 2) {
+        size *= 2;
+    }
+    if (buckets.size() < size) {
+        buckets.resize(size);
+    }
+    std::fill(buckets.begin(), buckets.end(), -1);
+    accum.clear();
+}
 
-        // Skip misses and already assigned hits
-        if (hit.hitPoint.w() < 0.0f || assigned[i]) {
+ReflectionRenderer::ClusterAccum& ReflectionRenderer::ClusterTable::at(uint64_t key) {
+    if ((accum.size() + 1) * 2 > buckets.size()) {
+        grow();
+    }
+    const size_t mask = buckets.size() - 1;
+    for (size_t s = clusterSlot(key, mask);; s = (s + 1) & mask) {
+        int index = buckets[s];
+        if (index < 0) {
+            buckets[s] = static_cast<int>(accum.size());
+            accum.push_back({});
+            accum.back().key = key;
+            return accum.back();
+        }
+        if (accum[index].key == key) {
+            return accum[index];
+        }
+    }
+}
+
+void ReflectionRenderer::ClusterTable::grow() {
+    buckets.assign(std::max<size_t>(buckets.size() * 2, 64), -1);
+    const size_t mask = buckets.size() - 1;
+    for (size_t i = 0; i < accum.size(); ++i) {
+        size_t s = clusterSlot(accum[i].key, mask);
+        while (buckets[s] >= 0) {
+            s = (s + 1) & mask;
+        }
+        buckets[s] = static_cast<int>(i);
+    }
+}
+
+void ReflectionRenderer::accumulateClusters(const std::vector<RCS::HitResult>& hits, size_t begin, size_t end,
+                                            ClusterTable& table) {
+    table.reset((end - begin) / 4 + 16);
+
+    const float invCellSize = 1.0f / kLobeClusterDist;
+    for (size_t i = begin; i < end; ++i) {
+        const RCS::HitResult& hit = hits[i];
+        // Skip misses
+        if (hit.hitPoint.w() < 0.0f) {
             continue;
         }
 
@@ -172,226 +279,170 @@ std::vector<ReflectionLobe> ReflectionRenderer::clusterHits(const std::vector<RC
             continue;
         }
 
-        // Start new cluster with this hit
-        ReflectionLobe lobe;
-        lobe.position = hit.hitPoint.toVector3D();
-        lobe.direction = hit.reflection.toVector3D().normalized();
-        lobe.intensity = intensity;
-        lobe.hitCount = 1;
-        assigned[i] = true;
-
-        // Find nearby hits with similar reflection directions
-        for (size_t j = i + 1; j < hits.size(); ++j) {
-            if (assigned[j] || hits[j].hitPoint.w() < 0.0f) {
-                continue;
-            }
-
-            QVector3D pos = hits[j].hitPoint.toVector3D();
-            QVector3D dir = hits[j].reflection.toVector3D().normalized();
-            float hitIntensity = hits[j].reflection.w();
-
-            // Skip low intensity hits in clustering too
-            if (hitIntensity < kLobeMinIntensity) {
-                continue;
-            }
-
-            // Check spatial distance
-            float distSq = (pos - lobe.position).lengthSquared();
-            if (distSq > clusterDistSq) {
-                continue;
-            }
-
-            // Check angular similarity
-            float dirDot = QVector3D::dotProduct(dir, lobe.direction);
-            if (dirDot < clusterAngleCos) {
-                continue;
-            }
-
-            // Add to cluster with weighted average
-            float w = 1.0f / (lobe.hitCount + 1);
-            lobe.position = lobe.position * (1.0f - w) + pos * w;
-            lobe.direction = (lobe.direction * (1.0f - w) + dir * w).normalized();
-            lobe.intensity = lobe.intensity * (1.0f - w) + hitIntensity * w;
-            lobe.hitCount++;
-            assigned[j] = true;
+        QVector3D pos = hit.hitPoint.toVector3D();
+        QVector3D dir = hit.reflection.toVector3D().normalized();
+
+        // 14 bits per cell axis + direction bucket
+        auto cell = [invCellSize](float c) {
+            return static_cast<uint64_t>(static_cast<int64_t>(std::floor(c * invCellSize)) + 8192) & 0x3FFFu;
+        };
+        uint64_t key = (cell(pos.x()) << 50) | (cell(pos.y()) << 36) | (cell(pos.z()) << 22) |
+                       static_cast<uint64_t>(directionBucket(dir));
+
+        ClusterAccum& accum = table.at(key);
+        accum.positionSum += pos;
+        accum.directionSum += dir;
+        accum.intensitySum += std::min(intensity, kBinIntensityMax);  // As the GPU clustering pass
+        accum.hitCount++;
+    }
+}
+
+void ReflectionRenderer::clusterHits(const std::vector<RCS::HitResult>& hits) {
+    // Spatial hash: hits sharing a kLobeClusterDist position cell and a
+    // kLobeClusterAngle direction bucket form one lobe. O(n) instead of the
+    // pairwise scan, so it scales with the ray count. Large hit sets hash
+    // chunks into their own tables, merged in chunk order so the result does
+    // not depend on thread timing.
+    int chunks = RS::parallelChunkCount(hits.size(), kHitParallelMinHits);
+    partialClusters_.resize(chunks - 1);
+    RS::runChunks(chunks, hits.size(), [&](int chunk, size_t begin, size_t end) {
+        accumulateClusters(hits, begin, end, chunk == 0 ? clusters_ : partialClusters_[chunk - 1]);
+    });
+    for (const auto& partial : partialClusters_) {
+        for (const auto& source : partial.accum) {
+            ClusterAccum& accum = clusters_.at(source.key);
+            accum.positionSum += source.positionSum;
+            accum.directionSum += source.directionSum;
+            accum.intensitySum += source.intensitySum;
+            accum.hitCount += source.hitCount;
         }
+    }
 
-        result.push_back(lobe);
+    lobes_.clear();
+    for (const auto& accum : clusters_.accum) {
+        float inv = 1.0f / static_cast<float>(accum.hitCount);
+        ReflectionLobe lobe;
+        lobe.position = accum.positionSum * inv;
+        lobe.direction = accum.directionSum.normalized();
+        lobe.intensity = accum.intensitySum * inv;
+        lobe.hitCount = accum.hitCount;
+        lobes_.push_back(lobe);
     }
 
-    // Sort by intensity (highest first)
-    std::sort(result.begin(), result.end(),
+    // Keep the strongest kMaxReflectionLobes, highest intensity first
+    std::sort(lobes_.begin(), lobes_.end(),
               [](const ReflectionLobe& a, const ReflectionLobe& b) {
                   return a.intensity > b.intensity;
               });
-
-    return result;
+    if (lobes_.size() > static_cast<size_t>(kMaxReflectionLobes)) {
+        lobes_.resize(kMaxReflectionLobes);
+    }
 }
 
-void ReflectionRenderer::generateLobeGeometry() {
-    vertices_.clear();
-    indices_.clear();
+void ReflectionRenderer::updateLobesFromClusters(const std::vector<RCS::ReflectionCluster>& clusters) {
+    lobes_.clear();
+    lobes_.reserve(clusters.size());
+    for (const auto& cluster : clusters) {
+        ReflectionLobe lobe;
+        lobe.position = cluster.position.toVector3D();
+        lobe.direction = cluster.direction.toVector3D();
+        lobe.intensity = cluster.properties.x();
+        lobe.hitCount = static_cast<int>(cluster.position.w());
+        lobes_.push_back(lobe);
+    }
 
-    for (const auto& lobe : lobes_) {
-        generateConeGeometry(lobe);
+    std::sort(lobes_.begin(), lobes_.end(),
+              [](const ReflectionLobe& a, const ReflectionLobe& b) {
+                  return a.intensity > b.intensity;
+              });
+    if (lobes_.size() > static_cast<size_t>(kMaxReflectionLobes)) {
+        lobes_.resize(kMaxReflectionLobes);
     }
 
-    vertexCount_ = static_cast<int>(vertices_.size() / 9);  // 9 floats per vertex (pos + normal + color)
-    indexCount_ = static_cast<int>(indices_.size());
+    generateInstances();
+    geometryDirty_ = true;
+    emit lobeCountChanged(static_cast<int>(lobes_.size()));
 }
 
-void ReflectionRenderer::generateConeGeometry(const ReflectionLobe& lobe) {
-    // Cone parameters scaled by intensity (min + range * intensity)
-    float lengthScale = kLobeScaleLengthMin + (1.0f - kLobeScaleLengthMin) * lobe.intensity;
-    float radiusScale = kLobeScaleRadiusMin + (1.0f - kLobeScaleRadiusMin) * lobe.intensity;
-    float length = kLobeConeLength * lobeScale_ * lengthScale;
-    float radius = kLobeConeRadius * lobeScale_ * radiusScale;
-    int segments = kLobeConeSegments;
-
-    QVector3D apex = lobe.position;
-    QVector3D dir = lobe.direction.normalized();
-    QVector3D baseCenter = apex + dir * length;
-
-    // Get color based on intensity
-    QVector3D color = intensityToColor(lobe.intensity);
-
-    // Find perpendicular vectors for cone base
-    QVector3D up(0.0f, 0.0f, 1.0f);
-    if (std::abs(QVector3D::dotProduct(dir, up)) > kGimbalLockThreshold) {
-        up = QVector3D(1.0f, 0.0f, 0.0f);
-    }
-    QVector3D right = QVector3D::crossProduct(dir, up).normalized();
-    up = QVector3D::crossProduct(right, dir).normalized();
-
-    // Base index for this cone
-    unsigned int baseIdx = static_cast<unsigned int>(vertices_.size() / 9);
-
-    // Apex vertex
-    vertices_.push_back(apex.x());
-    vertices_.push_back(apex.y());
-    vertices_.push_back(apex.z());
-    vertices_.push_back(dir.x());  // Normal points along cone
-    vertices_.push_back(dir.y());
-    vertices_.push_back(dir.z());
-    vertices_.push_back(color.x());
-    vertices_.push_back(color.y());
-    vertices_.push_back(color.z());
-
-    // Base ring vertices
+void ReflectionRenderer::createConeMesh() {
+    // Unit cone: apex at the origin, base ring of kLobeConeSegments at z = 1,
+    // closed by a cap. Position (3) + normal (3) per vertex, uploaded once.
+    const int segments = kLobeConeSegments;
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    auto addVertex = [&vertices](float x, float y, float z, float nx, float ny, float nz) {
+        vertices.insert(vertices.end(), {x, y, z, nx, ny, nz});
+    };
+
+    addVertex(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);  // Apex, normal along the cone
     for (int i = 0; i < segments; ++i) {
         float angle = kTwoPiF * static_cast<float>(i) / static_cast<float>(segments);
-        QVector3D offset = (right * std::cos(angle) + up * std::sin(angle)) * radius;
-        QVector3D pos = baseCenter + offset;
-        QVector3D normal = offset.normalized();
-
-        vertices_.push_back(pos.x());
-        vertices_.push_back(pos.y());
-        vertices_.push_back(pos.z());
-        vertices_.push_back(normal.x());
-        vertices_.push_back(normal.y());
-        vertices_.push_back(normal.z());
-        vertices_.push_back(color.x());
-        vertices_.push_back(color.y());
-        vertices_.push_back(color.z());
-    }
-
-    // Generate indices for cone faces
-    for (int i = 0; i < segments; ++i) {
-        unsigned int curr = baseIdx + 1 + static_cast<unsigned int>(i);
-        unsigned int next = baseIdx + 1 + static_cast<unsigned int>((i + 1) % segments);
-        indices_.push_back(baseIdx);  // Apex
-        indices_.push_back(curr);
-        indices_.push_back(next);
-    }
-
-    // Base cap (optional - for closed cones)
-    unsigned int baseCenterIdx = static_cast<unsigned int>(vertices_.size() / 9);
-    vertices_.push_back(baseCenter.x());
-    vertices_.push_back(baseCenter.y());
-    vertices_.push_back(baseCenter.z());
-    vertices_.push_back(dir.x());
-    vertices_.push_back(dir.y());
-    vertices_.push_back(dir.z());
-    vertices_.push_back(color.x());
-    vertices_.push_back(color.y());
-    vertices_.push_back(color.z());
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        addVertex(c, s, 1.0f, c, s, 0.0f);
+    }
+    const unsigned int baseCenter = static_cast<unsigned int>(segments + 1);
+    addVertex(0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f);
 
     for (int i = 0; i < segments; ++i) {
-        unsigned int curr = baseIdx + 1 + static_cast<unsigned int>(i);
-        unsigned int next = baseIdx + 1 + static_cast<unsigned int>((i + 1) % segments);
-        indices_.push_back(baseCenterIdx);
-        indices_.push_back(next);
-        indices_.push_back(curr);
+        unsigned int curr = 1 + static_cast<unsigned int>(i);
+        unsigned int next = 1 + static_cast<unsigned int>((i + 1) % segments);
+        indices.insert(indices.end(), {0u, curr, next});            // Side
+        indices.insert(indices.end(), {baseCenter, next, curr});    // Cap
+    }
+    indexCount_ = static_cast<int>(indices.size());
+
+    vao_.bind();
+
+    glGenBuffers(1, &vboId_);
+    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glGenBuffers(1, &eboId_);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    // Lobe instances (locations 2-4) - the source region is chosen in render()
+    for (GLuint i = 2; i <= 4; ++i) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
     }
+
+    vao_.release();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-QVector3D ReflectionRenderer::intensityToColor(float intensity) {
-    // Blue (low) -> Yellow (mid) -> Red (high)
-    using namespace Colors;
-    if (intensity < kLobeColorThreshold) {
-        float t = intensity / kLobeColorThreshold;
-        return QVector3D(
-            kLobeLowIntensity[0] * (1.0f - t) + kLobeMidIntensity[0] * t,
-            kLobeLowIntensity[1] * (1.0f - t) + kLobeMidIntensity[1] * t,
-            kLobeLowIntensity[2] * (1.0f - t) + kLobeMidIntensity[2] * t
-        );
-    } else {
-        float t = (intensity - kLobeColorThreshold) / (1.0f - kLobeColorThreshold);
-        return QVector3D(
-            kLobeMidIntensity[0] * (1.0f - t) + kLobeHighIntensity[0] * t,
-            kLobeMidIntensity[1] * (1.0f - t) + kLobeHighIntensity[1] * t,
-            kLobeMidIntensity[2] * (1.0f - t) + kLobeHighIntensity[2] * t
-        );
+void ReflectionRenderer::generateInstances() {
+    // One cluster record per lobe; size and color are derived in the shader
+    instances_.resize(lobes_.size());
+    for (size_t i = 0; i < lobes_.size(); ++i) {
+        const ReflectionLobe& lobe = lobes_[i];
+        RCS::ReflectionCluster& instance = instances_[i];
+        instance.position = QVector4D(lobe.position, static_cast<float>(lobe.hitCount));
+        instance.direction = QVector4D(lobe.direction.normalized(), 0.0f);
+        instance.properties = QVector4D(lobe.intensity, 0.0f, 0.0f, 0.0f);
     }
 }
 
-void ReflectionRenderer::uploadGeometry() {
+void ReflectionRenderer::uploadInstances() {
     if (!QOpenGLContext::currentContext() || !vao_.isCreated()) {
         geometryDirty_ = true;
         return;
     }
 
-    if (vertices_.empty() || indices_.empty()) {
-        vertexCount_ = 0;
-        indexCount_ = 0;
+    instanceCount_ = 0;
+    const size_t bytes = instances_.size() * sizeof(RCS::ReflectionCluster);
+    if (bytes == 0 || !stream_.beginRegion(bytes)) {
         return;
     }
-
-    vao_.bind();
-
-    // VBO
-    if (vboId_ == 0) {
-        glGenBuffers(1, &vboId_);
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-    glBufferData(GL_ARRAY_BUFFER,
-                 vertices_.size() * sizeof(float),
-                 vertices_.data(),
-                 GL_DYNAMIC_DRAW);
-
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Normal attribute (location 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Color attribute (location 2)
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // EBO
-    if (eboId_ == 0) {
-        glGenBuffers(1, &eboId_);
-    }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 indices_.size() * sizeof(unsigned int),
-                 indices_.data(),
-                 GL_DYNAMIC_DRAW);
-
-    vao_.release();
+    RS::StreamingBuffer::Allocation block = stream_.allocate(bytes);
+    std::memcpy(block.data, instances_.data(), bytes);
+    instanceOffset_ = block.offset;
+    instanceCount_ = static_cast<int>(instances_.size());
     geometryDirty_ = false;
 }
 
@@ -406,18 +457,14 @@ void ReflectionRenderer::render(const QMatrix4x4& projection, const QMatrix4x4&
     }
 
     if (geometryDirty_) {
-        uploadGeometry();
+        uploadInstances();
     }
 
-    if (vboId_ == 0 || eboId_ == 0 || indexCount_ == 0) {
+    if (vboId_ == 0 || instanceCount_ == 0) {
         return;
     }
 
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);  // Don't write to depth buffer for transparent objects
+    // Blending and depth writes belong to the enclosing TransparencyPass
     glDisable(GL_CULL_FACE);
 
     shaderProgram_->bind();
@@ -425,6 +472,18 @@ void ReflectionRenderer::render(const QMatrix4x4& projection, const QMatrix4x4&
     shaderProgram_->setUniformValue("view", view);
     shaderProgram_->setUniformValue("model", model);
     shaderProgram_->setUniformValue("opacity", opacity_);
+    shaderProgram_->setUniformValue("coneLength", kLobeConeLength * lobeScale_);
+    shaderProgram_->setUniformValue("coneRadius", kLobeConeRadius * lobeScale_);
+    shaderProgram_->setUniformValue("lengthScaleMin", kLobeScaleLengthMin);
+    shaderProgram_->setUniformValue("radiusScaleMin", kLobeScaleRadiusMin);
+    shaderProgram_->setUniformValue("gimbalThreshold", kGimbalLockThreshold);
+    shaderProgram_->setUniformValue("colorThreshold", kLobeColorThreshold);
+    shaderProgram_->setUniformValue("lowColor", QVector3D(Colors::kLobeLowIntensity[0], Colors::kLobeLowIntensity[1],
+                                                          Colors::kLobeLowIntensity[2]));
+    shaderProgram_->setUniformValue("midColor", QVector3D(Colors::kLobeMidIntensity[0], Colors::kLobeMidIntensity[1],
+                                                          Colors::kLobeMidIntensity[2]));
+    shaderProgram_->setUniformValue("highColor", QVector3D(Colors::kLobeHighIntensity[0], Colors::kLobeHighIntensity[1],
+                                                           Colors::kLobeHighIntensity[2]));
 
     // Extract camera position from view matrix
     QMatrix4x4 invView = view.inverted();
@@ -432,15 +491,22 @@ void ReflectionRenderer::render(const QMatrix4x4& projection, const QMatrix4x4&
     shaderProgram_->setUniformValue("viewPos", viewPos);
 
     vao_.bind();
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
 
-    glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr);
+    // Instance attributes from the region the last lobe update wrote; the
+    // stream buffer may have grown since, so they are pointed here
+    glBindBuffer(GL_ARRAY_BUFFER, stream_.buffer());
+    const GLsizei stride = sizeof(RCS::ReflectionCluster);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(instanceOffset_ + offsetof(RCS::ReflectionCluster, position)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(instanceOffset_ + offsetof(RCS::ReflectionCluster, direction)));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(instanceOffset_ + offsetof(RCS::ReflectionCluster, properties)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr, instanceCount_);
+    stream_.fence();
 
     vao_.release();
     shaderProgram_->release();
-
-    // Restore state
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
 }
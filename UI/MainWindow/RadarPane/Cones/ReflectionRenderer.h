@@ -12,6 +12,7 @@
 #include <string_view>
 
 #include "RCSTypes.h"
+#include "StreamingBuffer.h"
 
 // Aggregated reflection lobe for visualization
 struct ReflectionLobe {
@@ -36,7 +37,10 @@ public:
     // Update lobes from RCS compute results
     void updateLobes(const std::vector<RCS::HitResult>& hits);
 
-    // Rendering
+    // Update lobes from clusters built on the GPU (RCSCompute lobe clustering)
+    void updateLobesFromClusters(const std::vector<RCS::ReflectionCluster>& clusters);
+
+    // Rendering - translucent, between TransparencyPass::begin() and end()
     void render(const QMatrix4x4& projection, const QMatrix4x4& view,
                 const QMatrix4x4& model);
 
@@ -63,16 +67,39 @@ private:
     // OpenGL resources
     std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
     QOpenGLVertexArrayObject vao_;
-    GLuint vboId_ = 0;
+    GLuint vboId_ = 0;  // Unit cone, uploaded once
     GLuint eboId_ = 0;
+    RS::StreamingBuffer stream_;  // Lobe instances, one region per lobe update
+    GLintptr instanceOffset_ = 0;
+    int instanceCount_ = 0;
 
-    // Geometry data
-    std::vector<float> vertices_;
-    std::vector<unsigned int> indices_;
+    // Lobes and their per-instance records (ReflectionCluster layout)
     std::vector<ReflectionLobe> lobes_;
+    std::vector<RCS::ReflectionCluster> instances_;
     bool geometryDirty_ = false;
-    int vertexCount_ = 0;
-    int indexCount_ = 0;
+
+    // Spatial-hash clustering scratch (kept between frames to avoid reallocation)
+    struct ClusterAccum {
+        uint64_t key = 0;
+        QVector3D positionSum;
+        QVector3D directionSum;
+        float intensitySum = 0.0f;
+        int hitCount = 0;
+    };
+    // Open-addressed key -> accum table. Both vectors keep their capacity
+    // across frames, so steady-state clustering does not allocate.
+    struct ClusterTable {
+        std::vector<int> buckets;         // Accum index per bucket, -1 = empty; power-of-two size
+        std::vector<ClusterAccum> accum;  // First-seen order
+
+        void reset(size_t expected);
+        ClusterAccum& at(uint64_t key);   // Inserts a zeroed entry on first use
+    private:
+        void grow();
+    };
+    ClusterTable clusters_;
+    std::vector<ClusterTable> partialClusters_;  // Per-chunk tables for large hit sets
+    int indexCount_ = 0;  // Of the unit cone
 
     // Shader sources
     std::string_view vertexShaderSource_;
@@ -80,11 +107,11 @@ private:
 
     // Helper methods
     void setupShaders();
-    std::vector<ReflectionLobe> clusterHits(const std::vector<RCS::HitResult>& hits);
-    void generateLobeGeometry();
-    void uploadGeometry();
-    void generateConeGeometry(const ReflectionLobe& lobe);
-
-    // Intensity to color conversion
-    static QVector3D intensityToColor(float intensity);
+    void clusterHits(const std::vector<RCS::HitResult>& hits);  // Fills lobes_
+    static int directionBucket(const QVector3D& dir);
+    static void accumulateClusters(const std::vector<RCS::HitResult>& hits, size_t begin, size_t end,
+                                   ClusterTable& table);
+    void createConeMesh();
+    void generateInstances();
+    void uploadInstances();
 };
@@ -1,9 +1,6 @@
 // DebugRayRenderer.cpp - Implementation of debug ray visualization
 #include "DebugRayRenderer.h"
-#include "GLUtils.h"
 #include "Constants.h"
-#include <QOpenGLContext>
-#include <QDebug>
 #include <cmath>
 
 using namespace RS::Constants;
@@ -17,6 +14,7 @@ namespace {
     const QVector3D kFinalRayColor(1.0f, 0.5f, 0.0f);         // Orange for final ray to sphere
     const float kHitMarkerSize = 2.0f;
     const float kReflectionRayLength = 50.0f;
+    const float kRayLineWidth = 3.0f;                          // Pixels
 
     // Color palette for multi-bounce segments (distinct, bright colors)
     const QVector3D kBounceColors[] = {
@@ -35,112 +33,11 @@ namespace {
 DebugRayRenderer::DebugRayRenderer(QObject* parent)
     : QObject(parent)
 {
-    // Simple vertex shader for colored lines
-    vertexShaderSource_ = R"(
-        #version 430 core
-        layout (location = 0) in vec3 aPos;
-        layout (location = 1) in vec3 aColor;
-
-        uniform mat4 view;
-        uniform mat4 projection;
-
-        out vec3 Color;
-
-        void main() {
-            Color = aColor;
-            gl_Position = projection * view * vec4(aPos, 1.0);
-        }
-    )";
-
-    // Simple fragment shader - pass through color
-    fragmentShaderSource_ = R"(
-        #version 430 core
-        in vec3 Color;
-        out vec4 FragColor;
-
-        void main() {
-            FragColor = vec4(Color, 1.0);
-        }
-    )";
-}
-
-DebugRayRenderer::~DebugRayRenderer() {
-    // OpenGL cleanup should be done via cleanup() before context destruction
-}
-
-bool DebugRayRenderer::initialize() {
-    if (initialized_) {
-        return true;
-    }
-
-    if (!QOpenGLContext::currentContext()) {
-        qWarning() << "DebugRayRenderer::initialize - No OpenGL context available";
-        return false;
-    }
-
-    if (!initializeOpenGLFunctions()) {
-        qCritical() << "DebugRayRenderer: Failed to initialize OpenGL functions!";
-        return false;
-    }
-
-    GLUtils::clearGLErrors();
-
-    setupShaders();
-
-    vao_.create();
-    vao_.bind();
-    vao_.release();
-
-    GLUtils::checkGLError("DebugRayRenderer::initialize");
-
-    initialized_ = true;
-    return true;
-}
-
-void DebugRayRenderer::cleanup() {
-    QOpenGLContext* ctx = QOpenGLContext::currentContext();
-    if (!ctx) {
-        shaderProgram_.reset();
-        return;
-    }
-
-    if (vao_.isCreated()) {
-        vao_.destroy();
-    }
-    if (vboId_ != 0) {
-        glDeleteBuffers(1, &vboId_);
-        vboId_ = 0;
-    }
-    shaderProgram_.reset();
-    initialized_ = false;
-}
-
-void DebugRayRenderer::setupShaders() {
-    if (vertexShaderSource_.empty() || fragmentShaderSource_.empty()) {
-        qCritical() << "DebugRayRenderer: Shader sources not initialized!";
-        return;
-    }
-
-    shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
-
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
-        qCritical() << "DebugRayRenderer: Failed to compile vertex shader:" << shaderProgram_->log();
-        return;
-    }
-
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
-        qCritical() << "DebugRayRenderer: Failed to compile fragment shader:" << shaderProgram_->log();
-        return;
-    }
-
-    if (!shaderProgram_->link()) {
-        qCritical() << "DebugRayRenderer: Failed to link shader program:" << shaderProgram_->log();
-        return;
-    }
 }
 
 void DebugRayRenderer::setRayData(const QVector3D& radarPos, const RCS::HitResult& hit,
                                    float maxDistance) {
+    pathRevision_ = 0;
     radarPos_ = radarPos;
     maxDistance_ = maxDistance;
 
@@ -168,17 +65,15 @@ void DebugRayRenderer::setRayData(const QVector3D& radarPos, const RCS::HitResul
     }
 
     generateGeometry();
-    geometryDirty_ = true;
 }
 
 void DebugRayRenderer::clearRayData() {
+    pathRevision_ = 0;
     hasHit_ = false;
-    vertices_.clear();
     lineSegments_.clear();
-    vertexCount_ = 0;
+    markers_.clear();
     bounceHitPoints_.clear();
     totalPathLength_ = 0.0f;
-    geometryDirty_ = true;
 }
 
 QVector3D DebugRayRenderer::getBounceHitPoint(int index) const {
@@ -224,13 +119,18 @@ bool DebugRayRenderer::raySphereIntersect(const QVector3D& origin, const QVector
 
 void DebugRayRenderer::setMultiBounceData(const QVector3D& radarPos,
                                            const std::vector<RCS::HitResult>& bounces,
-                                           float sphereRadius) {
+                                           float sphereRadius, uint64_t pathRevision) {
+    if (pathRevision != 0 && pathRevision == pathRevision_ &&
+        radarPos == radarPos_ && sphereRadius == sphereRadius_) {
+        return;
+    }
+    pathRevision_ = pathRevision;
     radarPos_ = radarPos;
     sphereRadius_ = sphereRadius;
     bounceHitPoints_.clear();
     totalPathLength_ = 0.0f;
-    vertices_.clear();
     lineSegments_.clear();
+    markers_.clear();
 
     if (bounces.empty()) {
         // No hits - draw miss ray toward center
@@ -238,8 +138,6 @@ void DebugRayRenderer::setMultiBounceData(const QVector3D& radarPos,
         QVector3D missDir = -radarPos.normalized();  // Toward origin
         QVector3D missEnd = radarPos + missDir * sphereRadius * 2.0f;
         addLineSegment(radarPos, missEnd, kMissRayColor);
-        vertexCount_ = static_cast<int>(vertices_.size() / 6);
-        geometryDirty_ = true;
         return;
     }
 
@@ -294,13 +192,11 @@ void DebugRayRenderer::setMultiBounceData(const QVector3D& radarPos,
         QVector3D extendedEnd = lastHitPos + lastReflection * kReflectionRayLength;
         addLineSegment(lastHitPos, extendedEnd, kFinalRayColor);
     }
-
-    vertexCount_ = static_cast<int>(vertices_.size() / 6);
-    geometryDirty_ = true;
 }
 
 void DebugRayRenderer::generateGeometry() {
-    vertices_.clear();
+    lineSegments_.clear();
+    markers_.clear();
 
     if (hasHit_) {
         // Incident ray: radar -> hit point (green)
@@ -317,123 +213,28 @@ void DebugRayRenderer::generateGeometry() {
         QVector3D missEnd = radarPos_ + rayDirection_ * maxDistance_;
         addLineSegment(radarPos_, missEnd, kMissRayColor);
     }
-
-    vertexCount_ = static_cast<int>(vertices_.size() / 6);  // 6 floats per vertex (pos + color)
 }
 
 void DebugRayRenderer::addLineSegment(const QVector3D& start, const QVector3D& end,
                                        const QVector3D& color) {
-    // Start vertex
-    vertices_.push_back(start.x());
-    vertices_.push_back(start.y());
-    vertices_.push_back(start.z());
-    vertices_.push_back(color.x());
-    vertices_.push_back(color.y());
-    vertices_.push_back(color.z());
-
-    // End vertex
-    vertices_.push_back(end.x());
-    vertices_.push_back(end.y());
-    vertices_.push_back(end.z());
-    vertices_.push_back(color.x());
-    vertices_.push_back(color.y());
-    vertices_.push_back(color.z());
+    lineSegments_.push_back({start, end, color});
 }
 
 void DebugRayRenderer::addHitMarker(const QVector3D& position, float size,
                                      const QVector3D& color) {
-    // Draw a 3D cross at the hit point
-    float halfSize = size * 0.5f;
-
-    // X axis line
-    addLineSegment(position - QVector3D(halfSize, 0, 0),
-                   position + QVector3D(halfSize, 0, 0), color);
-
-    // Y axis line
-    addLineSegment(position - QVector3D(0, halfSize, 0),
-                   position + QVector3D(0, halfSize, 0), color);
-
-    // Z axis line
-    addLineSegment(position - QVector3D(0, 0, halfSize),
-                   position + QVector3D(0, 0, halfSize), color);
-}
-
-void DebugRayRenderer::uploadGeometry() {
-    if (!QOpenGLContext::currentContext() || !vao_.isCreated()) {
-        geometryDirty_ = true;
-        return;
-    }
-
-    if (vertices_.empty()) {
-        vertexCount_ = 0;
-        return;
-    }
-
-    vao_.bind();
-
-    // VBO
-    if (vboId_ == 0) {
-        glGenBuffers(1, &vboId_);
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-    glBufferData(GL_ARRAY_BUFFER,
-                 vertices_.size() * sizeof(float),
-                 vertices_.data(),
-                 GL_DYNAMIC_DRAW);
-
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Color attribute (location 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    vao_.release();
-    geometryDirty_ = false;
+    // Expanded to a camera-facing cross by the line batcher
+    markers_.push_back({position, size, color});
 }
 
-void DebugRayRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view,
-                               const QVector3D& cameraPos) {
-    (void)cameraPos;  // Not used in GL_LINES mode
-
-    if (!visible_ || vertices_.empty() || !shaderProgram_) {
+void DebugRayRenderer::submit(LineBatcher& batch) const {
+    if (!visible_) {
         return;
     }
 
-    if (!vao_.isCreated()) {
-        return;
+    for (const LineSegment& segment : lineSegments_) {
+        batch.addLine(segment.start, segment.end, segment.color, kRayLineWidth);
     }
-
-    if (geometryDirty_) {
-        uploadGeometry();
+    for (const Marker& marker : markers_) {
+        batch.addMarker(marker.position, marker.size, marker.color);
     }
-
-    if (vboId_ == 0 || vertexCount_ == 0) {
-        return;
-    }
-
-    // Enable depth test so rays are occluded by solid geometry (target)
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-
-    // Set thick line width for visibility
-    glLineWidth(3.0f);
-
-    shaderProgram_->bind();
-    shaderProgram_->setUniformValue("projection", projection);
-    shaderProgram_->setUniformValue("view", view);
-
-    vao_.bind();
-    glBindBuffer(GL_ARRAY_BUFFER, vboId_);
-
-    // Draw all lines
-    glDrawArrays(GL_LINES, 0, vertexCount_);
-
-    vao_.release();
-    shaderProgram_->release();
-
-    // Restore state
-    glLineWidth(1.0f);
-    glEnable(GL_DEPTH_TEST);
 }
@@ -2,27 +2,20 @@
 #pragma once
 
 #include <QObject>
-#include <QOpenGLFunctions_4_5_Core>
-#include <QOpenGLShaderProgram>
-#include <QOpenGLVertexArrayObject>
-#include <QMatrix4x4>
 #include <QVector3D>
-#include <memory>
-#include <string_view>
+#include <vector>
+#include <cstdint>
 
 #include "RCSTypes.h"
+#include "LineBatcher.h"
 
-class DebugRayRenderer : public QObject, protected QOpenGLFunctions_4_5_Core {
+// Builds the debug ray path on the CPU; drawing goes through the shared
+// LineBatcher with the other overlays
+class DebugRayRenderer : public QObject {
     Q_OBJECT
 
 public:
     explicit DebugRayRenderer(QObject* parent = nullptr);
-    ~DebugRayRenderer() override;
-
-    // Lifecycle
-    bool initialize();
-    void cleanup();
-    bool isInitialized() const { return initialized_; }
 
     // Update ray data from single RCS hit result (legacy, single bounce)
     void setRayData(const QVector3D& radarPos, const RCS::HitResult& hit,
@@ -30,16 +23,17 @@ public:
 
     // Update ray data from multi-bounce trace
     // sphereRadius is used to extend final ray to sphere surface
+    // pathRevision identifies the traced path; a repeated non-zero revision
+    // with the same radar position and radius keeps the current geometry
     void setMultiBounceData(const QVector3D& radarPos,
                             const std::vector<RCS::HitResult>& bounces,
-                            float sphereRadius);
+                            float sphereRadius, uint64_t pathRevision = 0);
 
     // Clear ray data (no hit)
     void clearRayData();
 
-    // Rendering (cameraPos needed for view-aligned quad generation)
-    void render(const QMatrix4x4& projection, const QMatrix4x4& view,
-                const QVector3D& cameraPos);
+    // Queue the path's lines and hit markers for this frame
+    void submit(LineBatcher& batch) const;
 
     // Configuration
     void setVisible(bool visible) { visible_ = visible; }
@@ -61,9 +55,7 @@ public:
     static QVector3D getBounceColor(int bounceIndex);
 
 private:
-    bool initialized_ = false;
     bool visible_ = false;
-    bool geometryDirty_ = false;
 
     // Ray data
     QVector3D radarPos_;
@@ -75,41 +67,28 @@ private:
     float reflectionAngle_ = 0.0f;  // Angle from surface normal
     float maxDistance_ = 300.0f;
     float sphereRadius_ = 100.0f;
+    uint64_t pathRevision_ = 0;     // Revision the geometry was built from (0 = none)
 
     // Multi-bounce data
     std::vector<QVector3D> bounceHitPoints_;
     float totalPathLength_ = 0.0f;
 
-    // OpenGL resources
-    std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
-    QOpenGLVertexArrayObject vao_;
-    GLuint vboId_ = 0;
-
-    // Geometry data (position + color per vertex)
-    std::vector<float> vertices_;
-    int vertexCount_ = 0;
-
-    // Shader sources
-    std::string_view vertexShaderSource_;
-    std::string_view fragmentShaderSource_;
-
-    // Line segment data (stored before quad generation)
+    // Path geometry, rebuilt only when the ray data changes
     struct LineSegment {
         QVector3D start;
         QVector3D end;
         QVector3D color;
     };
+    struct Marker {
+        QVector3D position;
+        float size;
+        QVector3D color;
+    };
     std::vector<LineSegment> lineSegments_;
+    std::vector<Marker> markers_;
 
     // Helper methods
-    void setupShaders();
     void generateGeometry();
-    void uploadGeometry();
-
-    // Generate quad geometry from stored line segments (requires camera position)
-    void generateQuadGeometry(const QVector3D& cameraPos, float lineWidth);
-
-    // Store line segment for later quad generation
     void addLineSegment(const QVector3D& start, const QVector3D& end,
                         const QVector3D& color);
     void addHitMarker(const QVector3D& position, float size,
@@ -2,10 +2,13 @@
 #include "HeatMapRenderer.h"
 #include "GLUtils.h"
 #include "Constants.h"
+#include "ParallelChunks.h"
+#include "TransparencyPass.h"
 #include <QOpenGLContext>
 #include <QDebug>
 #include <cmath>
 #include <algorithm>
+#include <cstring>
 
 using namespace RS::Constants;
 
@@ -52,8 +55,6 @@ HeatMapRenderer::HeatMapRenderer(QObject* parent)
         uniform float opacity;
         uniform float minIntensity;
 
-        out vec4 FragColor;
-
         // Blue -> Yellow -> Red gradient
         vec3 intensityToColor(float t) {
             // Remap from [minIntensity, 1] to [0, 1] for color
@@ -86,7 +87,7 @@ HeatMapRenderer::HeatMapRenderer(QObject* parent)
 
             // Alpha based on intensity for smooth fadeout
             float alpha = opacity * clamp((Intensity - minIntensity) / (0.3 - minIntensity), 0.3, 1.0);
-            FragColor = vec4(result, alpha);
+            writeTransparent(vec4(result, alpha));
         }
     )";
 }
@@ -119,6 +120,10 @@ bool HeatMapRenderer::initialize() {
     vao_.bind();
     vao_.release();
 
+    if (!intensityStream_.initialize("HeatMapRenderer", intensities_.size() * sizeof(float))) {
+        return false;
+    }
+
     GLUtils::checkGLError("HeatMapRenderer::initialize");
 
     initialized_ = true;
@@ -143,6 +148,9 @@ void HeatMapRenderer::cleanup() {
         glDeleteBuffers(1, &eboId_);
         eboId_ = 0;
     }
+    meshMemory_.release();
+    intensityStream_.cleanup();
+    intensityOffset_ = -1;
     shaderProgram_.reset();
     initialized_ = false;
 }
@@ -155,12 +163,13 @@ void HeatMapRenderer::setupShaders() {
 
     shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
         qCritical() << "HeatMapRenderer: Failed to compile vertex shader:" << shaderProgram_->log();
         return;
     }
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+    const std::string fragmentSource = TransparencyPass::fragmentShader(fragmentShaderSource_);
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentSource.c_str())) {
         qCritical() << "HeatMapRenderer: Failed to compile fragment shader:" << shaderProgram_->log();
         return;
     }
@@ -174,7 +183,7 @@ void HeatMapRenderer::setupShaders() {
 void HeatMapRenderer::setSphereRadius(float radius) {
     if (sphereRadius_ != radius) {
         sphereRadius_ = radius;
-        geometryDirty_ = true;
+        generateSphereMesh();
     }
 }
 
@@ -278,55 +287,33 @@ int HeatMapRenderer::getBinIndex(float theta, float phi) const {
     return latBin * lonBins_ + lonBin;
 }
 
-void HeatMapRenderer::accumulateHit(const RCS::HitResult& hit) {
-    // Skip misses
-    if (hit.hitPoint.w() < 0.0f) {
-        return;
-    }
-
-    float intensity = hit.reflection.w();
-    if (intensity < minIntensity_) {
-        return;
-    }
-
+void HeatMapRenderer::accumulateHit(float azimuthDeg, float elevationDeg, float intensity,
+                                    float* binIntensity, int* binHitCount) const {
     // Skip hits outside current slice
-    if (!isHitInSlice(hit)) {
+    if (!isHitInSlice(azimuthDeg, elevationDeg)) {
         return;
     }
 
-    // Get reflection direction (where the energy goes)
-    QVector3D dir = hit.reflection.toVector3D().normalized();
-
-    // Convert direction to spherical coordinates
-    float theta = atan2(dir.y(), dir.x());                          // azimuth [-pi, pi]
-    float phi = asin(std::clamp(dir.z(), -1.0f, 1.0f));            // elevation [-pi/2, pi/2]
+    // Reflection direction (where the energy goes) in spherical coordinates
+    float theta = azimuthDeg * kDegToRadF;   // azimuth [-pi, pi]
+    float phi = elevationDeg * kDegToRadF;   // elevation [-pi/2, pi/2]
 
     int bin = getBinIndex(theta, phi);
     if (bin >= 0 && bin < static_cast<int>(binIntensity_.size())) {
-        binIntensity_[bin] += intensity;
-        binHitCount_[bin]++;
+        binIntensity[bin] += intensity;
+        binHitCount[bin]++;
     }
 }
 
-bool HeatMapRenderer::isHitInSlice(const RCS::HitResult& hit) const {
-    // Get the reflection direction
-    QVector3D reflectDir = hit.reflection.toVector3D().normalized();
-
+bool HeatMapRenderer::isHitInSlice(float azimuthDeg, float elevationDeg) const {
     if (cutType_ == CutType::Azimuth) {
         // Azimuth cut: filter by elevation angle
         // Elevation = angle from horizontal plane (XY plane)
-        float elevationRad = std::asin(std::clamp(reflectDir.z(), -1.0f, 1.0f));
-        float elevationDeg = elevationRad * kRadToDegF;
-
         // Check if within slice thickness of the offset elevation
         float delta = std::abs(elevationDeg - sliceOffset_);
         return delta <= sliceThickness_;
     } else {
-        // Elevation cut: filter by azimuth angle
-        float azimuthRad = std::atan2(reflectDir.y(), reflectDir.x());
-        float azimuthDeg = azimuthRad * kRadToDegF;
-
-        // Normalize to [0, 360)
+        // Elevation cut: filter by azimuth angle, normalized to [0, 360)
         if (azimuthDeg < 0.0f) {
             azimuthDeg += 360.0f;
         }
@@ -387,16 +374,87 @@ void HeatMapRenderer::updateFromHits(const std::vector<RCS::HitResult>& hits, fl
         generateSphereMesh();
     }
 
-    // Clear and accumulate
+    // Clear and accumulate; angles for every kept hit come from one batch
+    hitAngles_.compute(hits, minIntensity_);
+    accumulateAngles();
+}
+
+void HeatMapRenderer::updateFromColumns(const RCS::HitColumns& columns, float sphereRadius) {
+    if (sphereRadius != sphereRadius_) {
+        sphereRadius_ = sphereRadius;
+        generateSphereMesh();
+    }
+
+    hitAngles_.compute(columns, minIntensity_);
+    accumulateAngles();
+}
+
+void HeatMapRenderer::updateFromCut(const std::vector<RCSDataPoint>& cut, float elevationDegrees,
+                                    float minDbsm, float maxDbsm) {
+    clearBins();
+    if (!cut.empty()) {
+        const float scale = 1.0f / std::max(maxDbsm - minDbsm, 1.0e-3f);
+        for (int lat = 0; lat < latBins_; ++lat) {
+            float binElevation = 90.0f - (lat + 0.5f) * 180.0f / latBins_;
+            if (std::abs(binElevation - elevationDegrees) > sliceThickness_) {
+                continue;
+            }
+            for (int lon = 0; lon < lonBins_; ++lon) {
+                // Same azimuth convention as getBinIndex: lon 0 starts at 0 degrees
+                float binAzimuth = (lon + 0.5f) * 360.0f / lonBins_;
+                const RCSDataPoint& point = cut[static_cast<size_t>(binAzimuth * cut.size() / 360.0f) % cut.size()];
+                if (!point.valid) {
+                    continue;
+                }
+                int bin = lat * lonBins_ + lon;
+                binIntensity_[bin] = std::clamp((point.dBsm - minDbsm) * scale, 0.0f, 1.0f);
+                binHitCount_[bin] = 1;
+            }
+        }
+    }
+    computeVertexIntensities();
+    intensitiesDirty_ = true;
+}
+
+void HeatMapRenderer::setIntensities(const std::vector<float>& intensities) {
+    if (intensities.size() != intensities_.size()) {
+        return;
+    }
+    intensities_ = intensities;
+    gpuIntensityBuffer_ = 0;
+    intensitiesDirty_ = true;
+}
+
+void HeatMapRenderer::accumulateAngles() {
     clearBins();
-    for (const auto& hit : hits) {
-        accumulateHit(hit);
+
+    // Large hit sets bin into one partial set of bins per chunk, merged below
+    const size_t binCount = binIntensity_.size();
+    int chunks = RS::parallelChunkCount(hitAngles_.size(), kHitParallelMinHits);
+    partialIntensity_.assign(binCount * (chunks - 1), 0.0f);
+    partialHitCount_.assign(binCount * (chunks - 1), 0);
+
+    const float* azimuth = hitAngles_.azimuthDegrees().data();
+    const float* elevation = hitAngles_.elevationDegrees().data();
+    const float* intensity = hitAngles_.intensities().data();
+    RS::runChunks(chunks, hitAngles_.size(), [&](int chunk, size_t begin, size_t end) {
+        float* chunkIntensity = chunk == 0 ? binIntensity_.data() : &partialIntensity_[binCount * (chunk - 1)];
+        int* chunkHitCount = chunk == 0 ? binHitCount_.data() : &partialHitCount_[binCount * (chunk - 1)];
+        for (size_t i = begin; i < end; ++i) {
+            accumulateHit(azimuth[i], elevation[i], intensity[i], chunkIntensity, chunkHitCount);
+        }
+    });
+    for (size_t offset = 0; offset < partialIntensity_.size(); offset += binCount) {
+        for (size_t bin = 0; bin < binCount; ++bin) {
+            binIntensity_[bin] += partialIntensity_[offset + bin];
+            binHitCount_[bin] += partialHitCount_[offset + bin];
+        }
     }
 
     // Compute per-vertex intensities
     computeVertexIntensities();
 
-    geometryDirty_ = true;
+    intensitiesDirty_ = true;
 }
 
 void HeatMapRenderer::uploadGeometry() {
@@ -410,43 +468,26 @@ void HeatMapRenderer::uploadGeometry() {
 
     vao_.bind();
 
-    // Create interleaved buffer: position (3) + normal (3) + intensity (1) = 7 floats per vertex
-    std::vector<float> interleavedData;
-    interleavedData.reserve(vertexCount_ * 7);
-
-    for (int i = 0; i < vertexCount_; i++) {
-        // Position (3 floats)
-        interleavedData.push_back(vertices_[i * 6 + 0]);
-        interleavedData.push_back(vertices_[i * 6 + 1]);
-        interleavedData.push_back(vertices_[i * 6 + 2]);
-        // Normal (3 floats)
-        interleavedData.push_back(vertices_[i * 6 + 3]);
-        interleavedData.push_back(vertices_[i * 6 + 4]);
-        interleavedData.push_back(vertices_[i * 6 + 5]);
-        // Intensity (1 float)
-        interleavedData.push_back(intensities_[i]);
-    }
-
-    // VBO
+    // Static VBO: position (3) + normal (3) = 6 floats per vertex, only re-uploaded
+    // when the mesh changes. Intensities stream through a separate buffer.
     if (vboId_ == 0) {
         glGenBuffers(1, &vboId_);
     }
     glBindBuffer(GL_ARRAY_BUFFER, vboId_);
     glBufferData(GL_ARRAY_BUFFER,
-                 interleavedData.size() * sizeof(float),
-                 interleavedData.data(),
-                 GL_DYNAMIC_DRAW);
+                 vertices_.size() * sizeof(float),
+                 vertices_.data(),
+                 GL_STATIC_DRAW);
 
     // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
     // Normal attribute (location 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    // Intensity attribute (location 2)
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 7 * sizeof(float), (void*)(6 * sizeof(float)));
+    // Intensity attribute (location 2) - source buffer is chosen in render()
     glEnableVertexAttribArray(2);
 
     // EBO
@@ -457,16 +498,26 @@ void HeatMapRenderer::uploadGeometry() {
     glBufferData(GL_ELEMENT_ARRAY_BUFFER,
                  indices_.size() * sizeof(unsigned int),
                  indices_.data(),
-                 GL_DYNAMIC_DRAW);
+                 GL_STATIC_DRAW);
 
     vao_.release();
+    meshMemory_.resize(vertices_.size() * sizeof(float) + indices_.size() * sizeof(unsigned int));
+    RS::GPUMemory::checkAllocation("heat map mesh");
+
     geometryDirty_ = false;
+    intensitiesDirty_ = true;
 }
 
 void HeatMapRenderer::uploadIntensities() {
-    // For now, we rebuild the entire VBO in uploadGeometry()
-    // This could be optimized to update only the intensity portion
-    geometryDirty_ = true;
+    // 4 bytes per vertex, written straight into the mapping
+    const size_t bytes = intensities_.size() * sizeof(float);
+    if (bytes == 0 || !intensityStream_.beginRegion(bytes)) {
+        return;
+    }
+    RS::StreamingBuffer::Allocation allocation = intensityStream_.allocate(bytes);
+    std::memcpy(allocation.data, intensities_.data(), bytes);
+    intensityOffset_ = allocation.offset;
+    intensitiesDirty_ = false;
 }
 
 void HeatMapRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view,
@@ -482,16 +533,18 @@ void HeatMapRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& vie
     if (geometryDirty_) {
         uploadGeometry();
     }
+    if (intensitiesDirty_ && gpuIntensityBuffer_ == 0) {
+        uploadIntensities();
+    }
 
     if (vboId_ == 0 || eboId_ == 0 || indexCount_ == 0) {
         return;
     }
+    if (gpuIntensityBuffer_ == 0 && intensityOffset_ < 0) {
+        return;  // No CPU intensities streamed yet
+    }
 
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);  // Don't write to depth buffer for transparent objects
+    // Blending and depth writes belong to the enclosing TransparencyPass
     glDisable(GL_CULL_FACE);  // Show both sides
 
     shaderProgram_->bind();
@@ -507,17 +560,29 @@ void HeatMapRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& vie
     shaderProgram_->setUniformValue("viewPos", viewPos);
 
     vao_.bind();
+
+    // Intensity attribute comes from the GPU-binned buffer when one is set,
+    // otherwise from the current region of the CPU stream buffer
+    bool fromStream = gpuIntensityBuffer_ == 0;
+    if (fromStream) {
+        glBindBuffer(GL_ARRAY_BUFFER, intensityStream_.buffer());
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)intensityOffset_);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, gpuIntensityBuffer_);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, vboId_);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, eboId_);
 
     glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr);
 
+    if (fromStream) {
+        intensityStream_.fence();
+    }
+
     vao_.release();
     shaderProgram_->release();
-
-    // Restore state
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
 }
 
 QVector3D HeatMapRenderer::intensityToColor(float intensity) {
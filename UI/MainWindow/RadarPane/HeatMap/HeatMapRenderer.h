@@ -13,6 +13,9 @@
 
 #include "RCSTypes.h"
 #include "RCSSampler.h"  // For CutType enum
+#include "HitAngles.h"
+#include "StreamingBuffer.h"
+#include "GPUMemory.h"
 
 class HeatMapRenderer : public QObject, protected QOpenGLFunctions_4_5_Core {
     Q_OBJECT
@@ -28,8 +31,21 @@ public:
 
     // Update heat map from RCS hit results
     void updateFromHits(const std::vector<RCS::HitResult>& hits, float sphereRadius);
-
-    // Rendering
+    // Same from a HitPayload::Columns view (RCSCompute::getLatestHitColumns)
+    void updateFromColumns(const RCS::HitColumns& columns, float sphereRadius);
+    // Stored azimuth cut (RCSDatasetViewer), painted over the slice thickness
+    // around elevationDegrees and scaled from [minDbsm, maxDbsm] to [0, 1]
+    void updateFromCut(const std::vector<RCSDataPoint>& cut, float elevationDegrees,
+                       float minDbsm, float maxDbsm);
+
+    // Use per-vertex intensities computed on the GPU (RCSCompute heat map binning)
+    // instead of CPU-binned hits. Pass 0 to go back to updateFromHits().
+    void setGPUIntensityBuffer(GLuint buffer) { gpuIntensityBuffer_ = buffer; }
+    // Per-vertex intensities in the same order (RCSResultCache); streamed
+    // like CPU-binned hits. Ignored if the count does not match the mesh.
+    void setIntensities(const std::vector<float>& intensities);
+
+    // Rendering - translucent, between TransparencyPass::begin() and end()
     void render(const QMatrix4x4& projection, const QMatrix4x4& view,
                 const QMatrix4x4& model);
 
@@ -68,6 +84,12 @@ private:
     QOpenGLVertexArrayObject vao_;
     GLuint vboId_ = 0;
     GLuint eboId_ = 0;
+    GLuint gpuIntensityBuffer_ = 0;  // Not owned - RCSCompute heat map intensities
+    RS::GPUAllocation meshMemory_{RS::GPUMemoryPool::Overlays};  // vboId_ + eboId_
+
+    // CPU intensities, one stream region per update
+    RS::StreamingBuffer intensityStream_;
+    GLintptr intensityOffset_ = -1;  // Where the next draw reads them, -1 before the first update
 
     // Geometry data - sphere mesh
     std::vector<float> vertices_;        // Position + Normal (6 floats per vertex)
@@ -75,13 +97,17 @@ private:
     std::vector<float> intensities_;     // Per-vertex intensity (updated each frame)
     int vertexCount_ = 0;
     int indexCount_ = 0;
-    bool geometryDirty_ = true;
+    bool geometryDirty_ = true;       // Mesh changed - re-upload positions/normals
+    bool intensitiesDirty_ = false;   // CPU intensities changed - write the next stream region
 
     // Spherical binning for intensity accumulation
     int latBins_;
     int lonBins_;
     std::vector<float> binIntensity_;
     std::vector<int> binHitCount_;
+    HitAngles hitAngles_;  // Batched reflection angles of the last CPU update
+    std::vector<float> partialIntensity_;  // Per-chunk bins beyond the first, merged into binIntensity_
+    std::vector<int> partialHitCount_;
 
     // Shader sources
     std::string_view vertexShaderSource_;
@@ -93,11 +119,13 @@ private:
     void uploadGeometry();
     void uploadIntensities();
     void clearBins();
-    void accumulateHit(const RCS::HitResult& hit);
+    void accumulateAngles();  // Bin hitAngles_ and refresh the vertex intensities
+    void accumulateHit(float azimuthDeg, float elevationDeg, float intensity,
+                       float* binIntensity, int* binHitCount) const;
     void computeVertexIntensities();
     int getBinIndex(float theta, float phi) const;
     void getVertexSphericalCoords(int vertexIndex, float& theta, float& phi) const;
-    bool isHitInSlice(const RCS::HitResult& hit) const;
+    bool isHitInSlice(float azimuthDeg, float elevationDeg) const;
 
     // Intensity to color conversion (same gradient as ReflectionRenderer)
     static QVector3D intensityToColor(float intensity);
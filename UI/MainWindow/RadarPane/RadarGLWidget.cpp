@@ -3,12 +3,39 @@
 #include "FBORenderer.h"
 #include "GLUtils.h"
 #include "Constants.h"
+#include "Frustum.h"
+#include "../../../RCS/BounceEffectPipeline.h"
+#include <QApplication>
 #include <QDebug>
 #include <QPainter>
 #include <QFont>
+#include <QFontMetrics>
+#include <QStringList>
 
 using namespace RS::Constants;
 
+namespace {
+
+// GL setup of a deferred component; a component that fails is dropped, as it
+// was when everything initialized up front
+template <typename Component>
+bool ensureInitialized(std::unique_ptr<Component>& component, const char* name) {
+	if (!component) {
+		return false;
+	}
+	if (component->isInitialized()) {
+		return true;
+	}
+	if (!component->initialize()) {
+		qWarning() << name << "initialization failed";
+		component.reset();
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
 RadarGLWidget::RadarGLWidget(QWidget* parent)
 	: QOpenGLWidget(parent),
 	radius_(Defaults::kSphereRadius),
@@ -22,6 +49,29 @@ RadarGLWidget::RadarGLWidget(QWidget* parent)
 {
 	// Set focus policy to receive keyboard events
 	setFocusPolicy(Qt::StrongFocus);
+
+	// The scene is multisampled in SceneTarget; samples in the widget's own
+	// framebuffer would only add a second resolve
+	QSurfaceFormat surfaceFormat = format();
+	surfaceFormat.setSamples(0);
+	setFormat(surfaceFormat);
+
+	// Animations step on swaps, not timers
+	frameClock_.attach(this);
+
+	// Repaint once inputs settle so a throttled trace or paused refinement resumes
+	rcsIdleTimer_.setSingleShot(true);
+	rcsIdleTimer_.setInterval(kRCSIdleDelayMs);
+	connect(&rcsIdleTimer_, &QTimer::timeout, this, [this]() { update(); });
+
+	// Deferred components finish initializing while the app is idle
+	warmUpTimer_.setSingleShot(true);
+	warmUpTimer_.setInterval(View::kComponentWarmUpDelayMs);
+	connect(&warmUpTimer_, &QTimer::timeout, this, &RadarGLWidget::warmUpNextComponent);
+
+	telemetryTimer_.setInterval(kTelemetryDumpIntervalMs);
+	connect(&telemetryTimer_, &QTimer::timeout, this, &RadarGLWidget::dumpTelemetry);
+	telemetryTimer_.start();
 }
 
 RadarGLWidget::~RadarGLWidget() {
@@ -38,11 +88,16 @@ RadarGLWidget::~RadarGLWidget() {
 	cameraController_.reset();
 	modelManager_.reset();
 	wireframeController_.reset();
-	rcsCompute_.reset();
+	rcsThread_.reset();
+	profiler_.reset();
 	reflectionRenderer_.reset();
 	heatMapRenderer_.reset();
 	debugRayRenderer_.reset();
+	bounceRenderer_.reset();
 	slicingPlaneRenderer_.reset();
+	lineBatcher_.reset();
+	transparencyPass_.reset();
+	sceneTarget_.reset();
 	fboRenderer_.reset();
 
 	doneCurrent();
@@ -54,6 +109,8 @@ void RadarGLWidget::cleanupGL() {
 		return;
 	}
 	glCleanedUp_ = true;
+	warmUpTimer_.stop();
+	telemetryTimer_.stop();
 
 	// Try to make context current for cleanup
 	// This may fail if the context is already being destroyed
@@ -67,10 +124,20 @@ void RadarGLWidget::cleanupGL() {
 		qWarning() << "RadarGLWidget::cleanupGL() - could not make context current";
 	}
 
-	// Clean up RCS compute resources
-	if (rcsCompute_) {
-		rcsCompute_->cleanup();
+	// Clean up RCS compute resources (on the compute thread, which then exits)
+	if (rcsThread_) {
+		rcsThread_->stop();
+		rcsThread_.reset();
 	}
+	resultCache_.clear();  // Its frame numbers belong to that RCSCompute
+
+	// Clean up profiler queries
+	if (profiler_) {
+		profiler_->cleanup();
+	}
+	rcsIdleTimer_.stop();
+	framePacer_.cleanup();
+	renderScaler_.cleanup();
 
 	// Clean up reflection renderer
 	if (reflectionRenderer_) {
@@ -82,14 +149,19 @@ void RadarGLWidget::cleanupGL() {
 		heatMapRenderer_->cleanup();
 	}
 
-	// Clean up debug ray renderer
-	if (debugRayRenderer_) {
-		debugRayRenderer_->cleanup();
+	// Clean up the overlay line batcher (debug ray, bounces, slicing outlines)
+	if (lineBatcher_) {
+		lineBatcher_->cleanup();
 	}
 
-	// Clean up bounce renderer
-	if (bounceRenderer_) {
-		bounceRenderer_->cleanup();
+	// Clean up the translucent accumulation targets
+	if (transparencyPass_) {
+		transparencyPass_->cleanup();
+	}
+
+	// Clean up the offscreen scene buffers
+	if (sceneTarget_) {
+		sceneTarget_->cleanup();
 	}
 
 	// Clean up slicing plane renderer
@@ -124,6 +196,9 @@ void RadarGLWidget::cleanupGL() {
 void RadarGLWidget::initialize(SphereRenderer* sphereRenderer, BeamController* beamController, CameraController* cameraController, ModelManager* modelManager, WireframeTargetController* wireframeController) {
 	// Take ownership of components via unique_ptr
 	sphereRenderer_.reset(sphereRenderer);
+	if (sphereRenderer_) {
+		sphereRenderer_->setFrameClock(&frameClock_);
+	}
 	beamController_.reset(beamController);
 	cameraController_.reset(cameraController);
 	modelManager_.reset(modelManager);
@@ -139,6 +214,8 @@ void RadarGLWidget::initialize(SphereRenderer* sphereRenderer, BeamController* b
 	if (cameraController_) {
 		connect(cameraController_.get(), &CameraController::viewChanged,
 			this, QOverload<>::of(&QWidget::update));
+		connect(cameraController_.get(), &CameraController::viewChanged,
+			this, [this]() { renderScaler_.noteInput(); });
 	}
 
 }
@@ -181,6 +258,7 @@ void RadarGLWidget::initializeGL() {
 			radarSiteRenderer_.reset();
 		} else {
 			radarSiteRenderer_->setPosition(theta_, phi_);
+			radarSiteRenderer_->setReceivers(receiverSites_);
 		}
 
 		if (beamController_) {
@@ -199,61 +277,105 @@ void RadarGLWidget::initializeGL() {
 			wireframeController_->initialize();
 		}
 
-		// Initialize RCS compute for GPU ray tracing
-		rcsCompute_ = std::make_unique<RCS::RCSCompute>(this);
-		if (!rcsCompute_->initialize()) {
+		// Initialize RCS compute for GPU ray tracing, on its own thread and
+		// context so a heavy trace does not hold up repaints
+		rcsThread_ = std::make_unique<RCS::RCSComputeThread>();
+		if (!rcsThread_->start(context())) {
 			qWarning() << "RCSCompute initialization failed - ray tracing disabled";
-			rcsCompute_.reset();
+			rcsThread_.reset();
 		} else {
-			rcsCompute_->setSphereRadius(radius_);
+			rcsThread_->submit([radius = radius_, progressive = progressiveRefinement_, temporal = temporalReuse_,
+			                    sampling = raySampling_, jitter = sampleJitter_, bounces = rcsBounces_,
+			                    cutoff = bounceCutoff_, roulette = rouletteThreshold_, mode = rayTraceMode_,
+			                    material = targetMaterial_, edges = edgeDiffraction_,
+			                    hotspots = triangleHotspots_](RCS::RCSCompute& compute) {
+				compute.setSphereRadius(radius);
+				compute.setProgressive(progressive);
+				compute.setTemporalReuse(temporal);
+				compute.setRaySampling(sampling);
+				compute.setSampleJitter(jitter);
+				compute.setBoundsFocus(Defaults::kBoundsFocusedRays);
+				compute.setMaxBounces(bounces);
+				compute.setBounceTermination(cutoff, roulette);
+				RCS::BounceEffectPipeline bounceEffects;
+				bounceEffects.setMode(mode);
+				compute.setBounceEffects(bounceEffects);
+				compute.setMaterials({material});
+				compute.setEdgeDiffraction(edges, edgeWaveNumber());
+				compute.setTriangleHotspots(hotspots);
+			});
+			targetSubmitted_ = false;
+			// Background BVH builds finish between frames - repaint to pick them up
+			connect(rcsThread_.get(), &RCS::RCSComputeThread::bvhUpdated, this, [this]() {
+				sceneVersions_.bump(RS::SceneInput::TargetGeometry);
+				update();
+			});
+			// A finished trace repaints to show its results
+			connect(rcsThread_.get(), &RCS::RCSComputeThread::resultsReady, this, [this]() { update(); });
 		}
 
-		// Initialize reflection lobe renderer
-		reflectionRenderer_ = std::make_unique<ReflectionRenderer>(this);
-		if (!reflectionRenderer_->initialize()) {
-			qWarning() << "ReflectionRenderer initialization failed";
-			reflectionRenderer_.reset();
+		// Initialize frame profiler (idle until the overlay or log is enabled)
+		profiler_ = std::make_unique<RS::FrameProfiler>();
+		if (!profiler_->initialize()) {
+			qWarning() << "FrameProfiler initialization failed - profiling disabled";
+			profiler_.reset();
 		}
 
-		// Initialize heat map renderer
-		heatMapRenderer_ = std::make_unique<HeatMapRenderer>(this);
-		if (!heatMapRenderer_->initialize()) {
-			qWarning() << "HeatMapRenderer initialization failed";
-			heatMapRenderer_.reset();
-		} else {
-			heatMapRenderer_->setSphereRadius(radius_);
+		// Trace pacing - without it every trace runs, as before
+		if (!framePacer_.initialize()) {
+			qWarning() << "FramePacer initialization failed - RCS traces unthrottled";
 		}
 
-		// Initialize debug ray renderer
-		debugRayRenderer_ = std::make_unique<DebugRayRenderer>(this);
-		if (!debugRayRenderer_->initialize()) {
-			qWarning() << "DebugRayRenderer initialization failed";
-			debugRayRenderer_.reset();
+		// Scaled offscreen scene; without it the scene draws straight to the
+		// widget at full resolution
+		sceneTarget_ = std::make_unique<SceneTarget>();
+		if (!sceneTarget_->initialize()) {
+			qWarning() << "SceneTarget initialization failed - render scaling disabled";
+			sceneTarget_.reset();
+		}
+		if (!renderScaler_.initialize()) {
+			qWarning() << "RenderScaler initialization failed - scene stays at full quality";
 		}
 
-		// Initialize bounce renderer (for beam bounce visualization)
-		bounceRenderer_ = std::make_unique<BounceRenderer>(this);
-		if (!bounceRenderer_->initialize()) {
-			qWarning() << "BounceRenderer initialization failed";
-			bounceRenderer_.reset();
+		// Before the first allocations, so oversized ones are reported
+		applyGPUMemoryBudget();
+
+		// Reflection lobe, heat map and slicing plane renderers hold their
+		// settings from here on; their shaders and buffers are created the
+		// first time they are shown (initializeVisibleComponents) or by the
+		// warm-up timer, whichever comes first
+		reflectionRenderer_ = std::make_unique<ReflectionRenderer>(this);
+		heatMapRenderer_ = std::make_unique<HeatMapRenderer>(this);
+		heatMapRenderer_->setSphereRadius(radius_);
+
+		// Initialize the shared overlay line batcher; the debug ray and bounce
+		// renderers only build CPU paths and queue them into it
+		lineBatcher_ = std::make_unique<LineBatcher>();
+		if (!lineBatcher_->initialize()) {
+			qWarning() << "LineBatcher initialization failed";
+			lineBatcher_.reset();
 		}
 
+		// Shared order-independent pass for the translucent renderers
+		transparencyPass_ = std::make_unique<TransparencyPass>();
+		if (!transparencyPass_->initialize()) {
+			qWarning() << "TransparencyPass initialization failed";
+			transparencyPass_.reset();
+		}
+		debugRayRenderer_ = std::make_unique<DebugRayRenderer>(this);
+		bounceRenderer_ = std::make_unique<BounceRenderer>(this);
+
 		// Initialize RCS samplers for polar plot
 		azimuthSampler_ = std::make_unique<AzimuthCutSampler>();
 		elevationSampler_ = std::make_unique<ElevationCutSampler>();
 		currentSampler_ = azimuthSampler_.get();  // Default to azimuth cut
 		currentCutType_ = CutType::Azimuth;
 		polarPlotData_.resize(RS::Constants::kPolarPlotBins);
+		applyRCSCoherent();
 
-		// Initialize slicing plane renderer
 		slicingPlaneRenderer_ = std::make_unique<SlicingPlaneRenderer>(this);
-		if (!slicingPlaneRenderer_->initialize()) {
-			qWarning() << "SlicingPlaneRenderer initialization failed";
-			slicingPlaneRenderer_.reset();
-		} else {
-			slicingPlaneRenderer_->setSphereRadius(radius_);
-			slicingPlaneRenderer_->setCutType(currentCutType_);
-		}
+		slicingPlaneRenderer_->setSphereRadius(radius_);
+		slicingPlaneRenderer_->setCutType(currentCutType_);
 
 		// Force beam geometry creation with initial position
 		if (beamController_) {
@@ -262,12 +384,15 @@ void RadarGLWidget::initializeGL() {
 			beamController_->rebuildBeamGeometry();
 		}
 
-		// Initialize FBO renderer for pop-out windows
+		// FBO renderer for pop-out windows; its attachments are only
+		// allocated once a pop-out asks for them (ensureFBORenderer)
 		fboRenderer_ = std::make_unique<FBORenderer>(this);
-		if (!fboRenderer_->initialize(width(), height())) {
-			qWarning() << "FBORenderer initialization failed - pop-out windows may not work";
-			fboRenderer_.reset();
-		}
+		// Debounced attachment resizes are applied by the next bind()
+		connect(fboRenderer_.get(), &FBORenderer::resizeReady, this, [this]() {
+			if (renderToFBO_) {
+				update();
+			}
+		});
 
 		// Mark initialization as complete
 		glInitialized_ = true;
@@ -310,13 +435,37 @@ void RadarGLWidget::paintGL() {
 		return;
 	}
 
-	// Bind FBO if rendering to texture for pop-out window
-	if (renderToFBO_ && fboRenderer_ && fboRenderer_->isValid()) {
-		fboRenderer_->bind();
+	QElapsedTimer frameTimer;
+	frameTimer.start();
+
+	initializeVisibleComponents();
+
+	// The output is the pop-out texture when rendering for a pop-out window,
+	// otherwise the widget, in device pixels
+	int outputWidth = static_cast<int>(std::lround(width() * devicePixelRatioF()));
+	int outputHeight = static_cast<int>(std::lround(height() * devicePixelRatioF()));
+	if (renderToFBO_ && ensureFBORenderer()) {
+		fboRenderer_->prepareFrame();
+		outputWidth = fboRenderer_->width();
+		outputHeight = fboRenderer_->height();
 	}
 
-	// Now safe to use GL functions - update beam position and geometry
-	updateBeamPosition();
+	// Draw the scene offscreen at the quality the last frames' GPU cost allows
+	renderScaler_.update();
+	const bool sceneBound = sceneTarget_ &&
+		sceneTarget_->bind(outputWidth, outputHeight, renderScaler_.scale(), renderScaler_.multisample());
+
+	RS::FrameProfiler* profiler = profiler_.get();
+	if (profiler) {
+		profiler->beginFrame();
+	}
+	renderScaler_.beginFrame();
+
+	// Now safe to use GL functions - update beam position and geometry.
+	// The radar only moves through setRadius/setAngles, which mark beamDirty_.
+	if (beamDirty_) {
+		updateBeamPosition();
+	}
 	beamController_->rebuildBeamGeometry();
 	beamDirty_ = false;
 
@@ -340,25 +489,31 @@ void RadarGLWidget::paintGL() {
 	QMatrix4x4 modelMatrix = cameraController_->getModelMatrix();
 
 	// Set up projection matrix
-	// When rendering to FBO, use FBO dimensions for correct aspect ratio
-	int renderWidth = width();
-	int renderHeight = height();
-	if (renderToFBO_ && fboRenderer_ && fboRenderer_->isValid()) {
-		renderWidth = fboRenderer_->width();
-		renderHeight = fboRenderer_->height();
-	}
+	// The output's aspect ratio, whatever the scene is scaled to
 	QMatrix4x4 projectionMatrix;
 	projectionMatrix.setToIdentity();
-	projectionMatrix.perspective(View::kPerspectiveFOV, float(renderWidth) / float(renderHeight), View::kNearPlane, View::kFarPlane);
+	projectionMatrix.perspective(View::kPerspectiveFOV, float(outputWidth) / float(outputHeight), View::kNearPlane, View::kFarPlane);
+
+	// Whole-object frustum culling in scene space. The sphere, grid, axes, radar
+	// site, heat map, slicing plane and beam all lie within the axes' reach of
+	// the origin; lobes stand out from the sphere by up to one cone length.
+	// The target culls its own instances in WireframeTarget::render.
+	const RS::Frustum frustum(projectionMatrix * viewMatrix * modelMatrix);
+	submitPick(projectionMatrix * viewMatrix * modelMatrix);
+	const bool sceneInView = frustum.intersectsSphere(QVector3D(), radius_ * View::kAxisLengthMultiplier);
+	const bool lobesInView = reflectionRenderer_ &&
+		frustum.intersectsSphere(QVector3D(), radius_ + kLobeConeLength * reflectionRenderer_->getLobeScale());
 
 	// Draw components
 	try {
-		if (sphereRenderer_) {
+		if (sphereRenderer_ && sceneInView) {
+			RS::FrameProfiler::Scope stage(profiler, "SphereRenderer");
 			sphereRenderer_->render(projectionMatrix, viewMatrix, modelMatrix);
 		}
 
 		// Render radar site dot (after sphere, using sphere's rotation)
-		if (radarSiteRenderer_) {
+		if (radarSiteRenderer_ && sceneInView) {
+			RS::FrameProfiler::Scope stage(profiler, "RadarSiteRenderer");
 			// Apply sphere rotation to model matrix for consistent dot positioning
 			QMatrix4x4 rotatedModel = modelMatrix;
 			if (sphereRenderer_) {
@@ -368,6 +523,7 @@ void RadarGLWidget::paintGL() {
 		}
 
 		if (modelManager_) {
+			RS::FrameProfiler::Scope stage(profiler, "ModelManager");
 			modelManager_->render(projectionMatrix, viewMatrix, modelMatrix);
 		}
 
@@ -378,124 +534,575 @@ void RadarGLWidget::paintGL() {
 			// Pass radar position for angle-based edge shading
 			wireframeController_->setRadarPosition(radarPos);
 
-			wireframeController_->render(projectionMatrix, viewMatrix, modelMatrix);
+			{
+				RS::FrameProfiler::Scope stage(profiler, "WireframeTarget");
+				// The hotspot overlay reads a buffer the compute thread writes
+				WireframeTarget* target = wireframeController_->getTarget();
+				if (rcsThread_ && target && target->getHotspotBuffer() != 0) {
+					rcsThread_->waitForGPU();
+				}
+				wireframeController_->render(projectionMatrix, viewMatrix, modelMatrix);
+			}
 
-			// Run RCS ray tracing if available
-			if (rcsCompute_ && wireframeController_->getTarget()) {
+			// Run RCS ray tracing if available. The trace runs on the compute
+			// thread: every frame hands it the current inputs, submits a trace
+			// when one is due and none is in flight, and draws whatever
+			// results it has published since the last frame.
+			if (rcsThread_ && wireframeController_->getTarget() && !datasetView_) {
 				auto* target = wireframeController_->getTarget();
 
-				rcsCompute_->setTargetGeometry(
-					target->getVertices(),
-					target->getIndices(),
-					target->getModelMatrix()
-				);
-				rcsCompute_->setRadarPosition(radarPos);
-				rcsCompute_->setBeamDirection(-radarPos.normalized());
+				// BVH is only rebuilt when the mesh changes; motion (and every
+				// formation member) only touches the small top-level BVH. The
+				// compute thread gets its own copy of each new mesh.
+				uint64_t geometryVersion = target->getGeometryVersion();
+				if (!targetSubmitted_ || geometryVersion != submittedGeometryVersion_) {
+					rcsThread_->submit([vertices = target->getVertices(), indices = target->getIndices(),
+										edges = target->getEdges(), materialIds = target->getMaterialIds(),
+										geometryVersion](RCS::RCSCompute& compute) {
+						compute.setTargetGeometry(vertices, indices, geometryVersion, materialIds);
+						compute.setMeshEdges(0, RCS::buildDiffractionEdges(vertices, indices, edges));
+					});
+					submittedGeometryVersion_ = geometryVersion;
+					targetSubmitted_ = true;
+				}
+				wireframeController_->getInstanceModelMatrices(instanceModels_);
+				instances_.clear();
+				instanceMatrices_.clear();
+				for (const QMatrix4x4& instanceModel : instanceModels_) {
+					RCS::TargetInstance instance;
+					instance.modelMatrix = instanceModel;
+					instances_.push_back(instance);
+					instanceMatrices_.insert(instanceMatrices_.end(), instanceModel.constData(), instanceModel.constData() + 16);
+				}
+				receiverPositions_.clear();
+				for (const RadarSite& site : receiverSites_) {
+					receiverPositions_.push_back(sphericalToCartesian(radius_, site.theta, site.phi));
+				}
 				// Set beam width for ray generation to cover full visual extent (4× for SincBeam side lobes)
 				float visualExtent = beamController_ ? beamController_->getVisualExtentDegrees() : 15.0f;
-				rcsCompute_->setBeamWidth(visualExtent);
+				updateBeamPattern(visualExtent);
 				// SingleRay mode uses exactly 1 ray for diagnostic tracing
 				bool isSingleRay = beamController_ &&
-				                   beamController_->getBeamType() == BeamType::SingleRay;
-				if (isSingleRay) {
-					rcsCompute_->setNumRays(1);
-				} else {
-					rcsCompute_->setNumRays(rayCount_);
+								   beamController_->getBeamType() == BeamType::SingleRay;
+				int numRays = isSingleRay ? 1 : rayCount_;
+
+				// Polar plot and heat map are binned on the GPU over every traced ray;
+				// only the reflection lobes still need the per-ray hit buffer
+				bool lobesVisible = reflectionRenderer_ && reflectionRenderer_->isVisible();
+				bool heatMapVisible = heatMapRenderer_ && heatMapRenderer_->isVisible();
+				bool needResults = lobesVisible || heatMapVisible;
+
+				RCS::BinningSlice polarSlice;
+				if (currentSampler_) {
+					polarSlice.cutType = static_cast<int>(currentCutType_);
+					polarSlice.offsetDegrees = currentSampler_->getOffset();
+					polarSlice.thicknessDegrees = currentSampler_->getThickness();
+				}
+				// Incoherent cuts come from the full-sphere table; coherent cuts need
+				// the per-cut field sums, so they keep binning the slice itself
+				bool sphereCuts = !rcsCoherent_;
+				bool cutBinning = needResults && currentSampler_;
+
+				RCS::BinningSlice heatMapSlice;
+				if (heatMapRenderer_) {
+					heatMapSlice.cutType = static_cast<int>(heatMapRenderer_->getCutType());
+					heatMapSlice.offsetDegrees = heatMapRenderer_->getSliceOffset();
+					heatMapSlice.thicknessDegrees = heatMapRenderer_->getSliceThickness();
+					heatMapSlice.minIntensity = heatMapRenderer_->getMinIntensityThreshold();
 				}
-				rcsCompute_->compute();
 
-				// Read hit results for visualization
-				bool needHitResults = (reflectionRenderer_ && reflectionRenderer_->isVisible()) ||
-				                       (heatMapRenderer_ && heatMapRenderer_->isVisible());
-				if (needHitResults) {
-					rcsCompute_->readHitBuffer();
+				// Lobes are clustered on the GPU; the CPU spatial hash only needs the
+				// compact hits-only stream
+				bool needLobes = lobesVisible && !isSingleRay;
+				bool gpuLobes = gpuLobeClustering_;
+				// Coherent overlay cuts are binned from the same hit stream
+				bool overlayHits = cutBinning && !sphereCuts && !overlayCuts_.empty();
+				bool hitStream = (needLobes && !gpuLobes) || overlayHits;
+
+				// Inputs go over every frame, traced or not, so the shadow map
+				// below follows the radar while a trace is paced or in flight
+				rcsThread_->submit([instances = instances_, receivers = receiverPositions_, radarPos, visualExtent,
+									numRays, polarSlice, heatMapSlice, cutBinning, sphereCuts, heatMapVisible,
+									needLobes, gpuLobes, hitStream](RCS::RCSCompute& compute) {
+					compute.setInstances(instances);
+					compute.setRadarPosition(radarPos);
+					compute.setBeamDirection(-radarPos.normalized());
+					compute.setReceivers(receivers);
+					compute.setBeamWidth(visualExtent);
+					compute.setNumRays(numRays);
+					compute.setPolarBinning(cutBinning && !sphereCuts, polarSlice);
+					compute.setSphereBinning(cutBinning && sphereCuts);
+					compute.setHeatMapBinning(heatMapVisible, heatMapSlice);
+					compute.setLobeClustering(needLobes && gpuLobes);
+					compute.setHitPayload(hitStream ? RCS::HitPayload::CompactHitsOnly : RCS::HitPayload::None);
+				});
+
+				// Version every input the trace depends on; the camera is not one
+				// of them, so orbiting and zooming skip the whole RCS pipeline
+				struct BeamKey {
+					float visualExtent;
+					int beamType;
+					int traceMode;
+				} beamKey{visualExtent, beamController_ ? static_cast<int>(beamController_->getBeamType()) : 0,
+						  static_cast<int>(rayTraceMode_)};
+				struct CutKey {
+					RCS::BinningSlice polar;
+					RCS::BinningSlice heatMap;
+					int polarBinning;
+					int heatMapBinning;
+					int lobeMode;  // 0 = none, 1 = GPU clusters, 2 = CPU hash
+					int sampler;   // Samplers share offsets, so the active one matters too
+					int overlayHits;
+				} cutKey{sphereCuts ? RCS::BinningSlice() : polarSlice, heatMapSlice, cutBinning, heatMapVisible,
+						 needLobes ? (gpuLobes ? 1 : 2) : 0,
+						 sphereCuts ? 0 : static_cast<int>(currentCutType_), overlayHits};
+				const float radarKey[3] = { radarPos.x(), radarPos.y(), radarPos.z() };
+
+				sceneVersions_.observe(RS::SceneInput::RadarPosition, radarKey);
+				sceneVersions_.observe(RS::SceneInput::BeamParams, beamKey);
+				sceneVersions_.observe(RS::SceneInput::TargetGeometry, geometryVersion);
+				sceneVersions_.observe(RS::SceneInput::TargetTransform, instanceMatrices_.data(),
+									   instanceMatrices_.size() * sizeof(float));
+				sceneVersions_.observe(RS::SceneInput::RayCount, numRays);
+				sceneVersions_.observe(RS::SceneInput::CutParams, cutKey);
+				sceneVersions_.observe(RS::SceneInput::Receivers, receiverPositions_.data(),
+									   receiverPositions_.size() * sizeof(QVector3D));
+
+				// The same inputs, quantized, key the result cache. Per-ray hit
+				// streams are never cached, so configurations needing one miss.
+				traceKey_.clear();
+				if (resultCaching_ && needResults && !hitStream) {
+					traceKey_.addQuantized(theta_, kResultCacheAngleStep);
+					traceKey_.addQuantized(phi_, kResultCacheAngleStep);
+					traceKey_.addQuantized(radius_, kResultCacheRangeStep);
+					traceKey_.addExact(static_cast<int>(instanceMatrices_.size()));
+					traceKey_.addQuantized(instanceMatrices_.data(), instanceMatrices_.size(), kResultCachePoseStep);
+					traceKey_.addQuantized(visualExtent, kResultCacheAngleStep);
+					traceKey_.addExact(beamKey.beamType);
+					traceKey_.addExact(beamKey.traceMode);
+					traceKey_.addExact(beamPatternKey_.version);
+					traceKey_.addExact(numRays);
+					traceKey_.addExact(geometryVersion);
+					traceKey_.addExact(cutKey);
+					traceKey_.addExact(static_cast<int>(receiverPositions_.size()));
+					for (const QVector3D& receiver : receiverPositions_) {
+						const float position[3] = { receiver.x(), receiver.y(), receiver.z() };
+						traceKey_.addQuantized(position, 3, kResultCacheRangeStep);
+					}
+				}
+
+				// Progressive mode restarts from a cheap preview whenever an input
+				// changes and adds a batch per trace once input settles.
+				// Otherwise the async catch-up paint must trace again even though
+				// nothing changed.
+				// While a control is dragged the pacer drops traces that would
+				// overrun the frame budget; the stamp stays stale so a later
+				// frame picks the latest state up. Refinement waits for idle.
+				// One trace is in flight at a time; its resultsReady() repaints.
+				bool progressive = progressiveRefinement_;
+				rcsStatus_ = rcsThread_->getStatus();
+				bool traceStale = !rcsTraceStamp_.isCurrent(sceneVersions_);
+				if (traceStale) {
+					framePacer_.noteInput();
+					renderScaler_.noteInput();
+					rcsIdleTimer_.start();
+					restoredFromCache_ = false;
+					snapshotDue_ = false;
+				}
 
+				// A revisited configuration shows its cached results instead of
+				// tracing. Pacing does not apply, and whatever trace is still in
+				// flight is dropped when it lands. Refinement and the settle paint
+				// stay off until an input changes again. The hotspot overlay is
+				// only filled by tracing, so it bypasses the cache.
+				std::shared_ptr<const RCS::RCSTraceResults> cached;
+				if (traceStale && traceKey_.isValid() && !triangleHotspots_) {
+					cached = resultCache_.find(traceKey_);
+				}
+				if (cached) {
+					rcsTraceStamp_.update(sceneVersions_);
+					restoredFromCache_ = true;
+					readbackSettlePaint_ = false;
+					staleTraceJobs_ = traceJobs_;
+					traceStale = false;
+				}
+
+				bool interacting = framePacer_.isInteracting();
+				bool tracePending = rcsThread_->isTracePending();
+				bool throttled = traceStale && !tracePending && !framePacer_.admitTrace();
+				bool restart = traceStale && !tracePending && !throttled;
+				bool runTrace = !tracePending &&
+								(restart || (!restoredFromCache_ &&
+											 ((rcsStatus_.refining && !interacting) ||
+											  (!progressive && readbackSettlePaint_))));
+				// A finished progressive batch is still collected without tracing again
+				bool collect = !tracePending && !runTrace && !restoredFromCache_ && progressive &&
+							   rcsStatus_.pendingResults;
+
+				if (runTrace || collect) {
+					bool sampler = currentSampler_ != nullptr;
+					bool coherent = rcsCoherent_;
+					uint64_t knownSphereFrame = sphereTableFrame_;
+					uint64_t job = ++traceJobs_;
+					rcsThread_->submitTrace([restart, runTrace, needResults, needLobes, gpuLobes, hitStream, heatMapVisible,
+											 sampler, sphereCuts, coherent, knownSphereFrame, job](
+												RCS::RCSCompute& compute, RCS::RCSTraceResults& results) {
+						results.job = job;
+						if (restart) {
+							compute.restartProgressive();
+						}
+						if (runTrace) {
+							QElapsedTimer traceTimer;
+							traceTimer.start();
+							compute.compute();
+							results.computeMs = traceTimer.nsecsElapsed() * 1.0e-6 - compute.getReadbackMs();
+							results.traced = true;
+						}
+
+						// Copies of the newest finished frame (N-1 in async mode)
+						if (needResults) {
+							if (needLobes && gpuLobes) {
+								results.lobeClusters = compute.getLatestLobeClusters();
+							}
+							if (hitStream) {
+								results.hits = compute.getLatestCompletedResults();
+							}
+							if (heatMapVisible) {
+								results.heatMapIntensityBuffer = compute.getHeatMapIntensityBuffer();
+							}
+							if (sampler && sphereCuts) {
+								const auto& cells = compute.getLatestSphereBins();
+								if (compute.getSphereBinsFrame() != knownSphereFrame) {
+									results.sphereBins = cells;
+									results.sphereBinsFrame = compute.getSphereBinsFrame();
+								}
+							} else if (sampler) {
+								results.polarBins = compute.getLatestPolarBins();
+								if (coherent) {
+									results.frequencyBins = compute.getLatestFrequencyBins();
+								}
+							}
+						}
+						if (compute.getReceiverCount() > 0) {
+							results.receiverBins = compute.getLatestReceiverBins();
+							results.receiverBinsFrame = compute.getReceiverBinsFrame();
+						}
+						results.hotspotBuffer = compute.getHotspotBuffer();
+						results.hotspotOffset = compute.getMeshHotspotOffset(0);
+						results.readbackMs = compute.getReadbackMs();
+						results.hitCount = compute.getHitCount();
+						results.occlusionRatio = compute.getOcclusionRatio();
+						results.asyncReadback = compute.isAsyncReadback();
+					});
+					if (restart) {
+						rcsTraceStamp_.update(sceneVersions_);
+						settleKey_ = traceKey_;
+						snapshotDue_ = traceKey_.isValid();
+					}
+				}
+				if (throttled) {
+					update();  // Earn credit on the next frame
+				}
+
+				// Once the trace has settled (refined, collected and caught up with
+				// async readback) one more job copies every output of it for the
+				// cache, the full sphere table included
+				bool settled = snapshotDue_ && !traceStale && !tracePending && !runTrace && !collect &&
+							   !readbackSettlePaint_ && !rcsStatus_.refining && !rcsStatus_.pendingResults &&
+							   traceKey_ == settleKey_;
+				if (settled) {
+					bool sampler = currentSampler_ != nullptr;
+					bool coherent = rcsCoherent_;
+					uint64_t job = ++traceJobs_;
+					rcsThread_->submitTrace([needLobes, gpuLobes, heatMapVisible, sampler, sphereCuts, coherent, job](
+												RCS::RCSCompute& compute, RCS::RCSTraceResults& results) {
+						results.job = job;
+						results.snapshot = true;
+						if (needLobes && gpuLobes) {
+							results.lobeClusters = compute.getLatestLobeClusters();
+						}
+						if (heatMapVisible) {
+							compute.readHeatMapIntensities(results.heatMapIntensities);
+						}
+						if (sampler && sphereCuts) {
+							results.sphereBins = compute.getLatestSphereBins();
+							results.sphereBinsFrame = compute.getSphereBinsFrame();
+						} else if (sampler) {
+							results.polarBins = compute.getLatestPolarBins();
+							if (coherent) {
+								results.frequencyBins = compute.getLatestFrequencyBins();
+							}
+						}
+						if (compute.getReceiverCount() > 0) {
+							results.receiverBins = compute.getLatestReceiverBins();
+							results.receiverBinsFrame = compute.getReceiverBinsFrame();
+						}
+						results.hitCount = compute.getHitCount();
+						results.occlusionRatio = compute.getOcclusionRatio();
+					});
+					snapshotKey_ = settleKey_;
+					snapshotDue_ = false;
+				}
+
+				// Consumes the newest published results without stalling. Lobes,
+				// heat map and polar plot keep their previous output otherwise.
+				// Snapshots only fill the cache; a restored entry replaces
+				// whatever was in flight when it was restored.
+				std::shared_ptr<const RCS::RCSTraceResults> results = rcsThread_->takeResults();
+				if (results && results->snapshot) {
+					resultCache_.insert(snapshotKey_, *results);
+					results.reset();
+				} else if (results && results->job <= staleTraceJobs_) {
+					results.reset();
+				}
+				if (results && triangleHotspots_) {
+					target->setHotspotBuffer(results->hotspotBuffer, results->hotspotOffset);
+				}
+				if (cached) {
+					results = cached;
+				}
+				if (results && needResults) {
 					// Update reflection lobes (skip for SingleRay - use bounce viz instead)
-					if (reflectionRenderer_ && reflectionRenderer_->isVisible() && !isSingleRay) {
-						reflectionRenderer_->updateLobes(rcsCompute_->getHitResults());
+					if (needLobes) {
+						RS::FrameProfiler::Scope stage(profiler, "Lobes");
+						if (gpuLobes) {
+							reflectionRenderer_->updateLobesFromClusters(results->lobeClusters);
+						} else {
+							reflectionRenderer_->updateLobes(results->hits);
+						}
 					}
 
-					// Update heat map
-					if (heatMapRenderer_ && heatMapRenderer_->isVisible()) {
-						heatMapRenderer_->updateFromHits(rcsCompute_->getHitResults(), radius_);
+					// Heat map samples the GPU-resolved per-vertex intensities directly
+					if (heatMapVisible) {
+						RS::FrameProfiler::Scope stage(profiler, "Heat map");
+						heatMapRenderer_->setSphereRadius(radius_);
+						if (!results->heatMapIntensities.empty()) {
+							heatMapRenderer_->setIntensities(results->heatMapIntensities);
+						} else {
+							heatMapRenderer_->setGPUIntensityBuffer(results->heatMapIntensityBuffer);
+						}
 					}
 
-					// Sample RCS data for polar plot
-					if (currentSampler_) {
-						currentSampler_->sample(rcsCompute_->getHitResults(), polarPlotData_);
+					// Polar plot from the GPU bins (~6 KB readback), or the sphere
+					// table the cut is extracted from below
+					if (currentSampler_ && sphereCuts) {
+						RS::FrameProfiler::Scope stage(profiler, "Sphere table");
+						if (results->sphereBinsFrame != 0 && results->sphereBinsFrame != sphereTableFrame_) {
+							sphereTable_.build(results->sphereBins);
+							sphereTableFrame_ = results->sphereBinsFrame;
+							sphereCutStale_ = true;
+						}
+					} else if (currentSampler_) {
+						RS::FrameProfiler::Scope stage(profiler, "Sampler");
+						if (rcsCoherent_) {
+							currentSampler_->sampleFieldBins(results->polarBins, results->frequencyBins, polarPlotData_);
+						} else {
+							currentSampler_->sampleBins(results->polarBins, polarPlotData_);
+						}
 						emit polarPlotDataReady(polarPlotData_);
 					}
+
+					// Coherent overlays: one fused pass bins the hits into every cut
+					if (overlayHits) {
+						RS::FrameProfiler::Scope stage(profiler, "Overlay cuts");
+						overlaySampler_.sample(results->hits, overlayCurves_);
+						emit overlayCutsReady(overlayCurves_);
+						overlayStale_ = false;
+					}
+
+					// Async results lag one frame - schedule a single settle repaint so
+					// the views catch up with the final state once interaction stops
+					if (results->asyncReadback && !progressive) {
+						if (!readbackSettlePaint_) {
+							readbackSettlePaint_ = true;
+							update();
+						} else {
+							readbackSettlePaint_ = false;
+						}
+					}
+				}
+
+				// One averaged return per receiver, as the polar bins are
+				if (results && !results->receiverBins.empty() && results->receiverBinsFrame != bistaticFrame_) {
+					const auto& bins = results->receiverBins;
+					bistaticFrame_ = results->receiverBinsFrame;
+					bistaticDbsm_.assign(bins.size(), kDBsmFloor);
+					for (size_t i = 0; i < bins.size(); ++i) {
+						double average = bins[i].hitCount > 0
+							? bins[i].intensitySum(kBinIntensityScale) / bins[i].hitCount : 0.0;
+						if (average > kMinValidIntensity) {
+							bistaticDbsm_[i] = std::max(static_cast<float>(10.0 * std::log10(average)), kDBsmFloor);
+						}
+					}
+					emit bistaticRCSReady(bistaticDbsm_);
+				}
+
+				// The pacer budgets the compute thread's time per trace, as
+				// its own timer query cannot see another context's work
+				if (results && results->traced) {
+					framePacer_.addTraceSample(results->computeMs + results->readbackMs);
+					telemetry_.record(RS::TelemetryMetric::ComputeMs, results->computeMs);
+					telemetry_.record(RS::TelemetryMetric::ReadbackMs, results->readbackMs);
+					telemetry_.record(RS::TelemetryMetric::HitCount, results->hitCount);
+					telemetry_.record(RS::TelemetryMetric::OcclusionRatio, results->occlusionRatio);
+				}
+
+				// Cut changes are a pure lookup: re-extract whenever the table or
+				// the slice changed, traced this frame or not
+				bool sliceMoved = polarSlice.cutType != sphereCutSlice_.cutType ||
+								  polarSlice.offsetDegrees != sphereCutSlice_.offsetDegrees ||
+								  polarSlice.thicknessDegrees != sphereCutSlice_.thicknessDegrees;
+				bool tableChanged = sphereCutStale_;
+				if (sphereCuts && cutBinning && sphereTable_.isValid() && (sphereCutStale_ || sliceMoved)) {
+					RS::FrameProfiler::Scope stage(profiler, "Sampler");
+					sphereTable_.extractCut(polarSlice.cutType, polarSlice.offsetDegrees,
+											polarSlice.thicknessDegrees, sphereCutBins_);
+					currentSampler_->sampleBins(sphereCutBins_, polarPlotData_);
+					emit polarPlotDataReady(polarPlotData_);
+					sphereCutSlice_ = polarSlice;
+					sphereCutStale_ = false;
+				}
+				if (sphereCuts && cutBinning && !overlayCuts_.empty() && sphereTable_.isValid() &&
+					(tableChanged || overlayStale_)) {
+					RS::FrameProfiler::Scope stage(profiler, "Overlay cuts");
+					overlaySampler_.sampleTable(sphereTable_, overlayCurves_);
+					emit overlayCutsReady(overlayCurves_);
+					overlayStale_ = false;
+				}
+
+				// Keep refining (and collecting the last batch's results) on later
+				// repaints; a trace in flight repaints when it lands, and during
+				// interaction the idle timer resumes refinement
+				if (progressive && !restoredFromCache_ && !rcsThread_->isTracePending() &&
+					((rcsStatus_.refining && !interacting) || rcsStatus_.pendingResults)) {
+					update();
 				}
 			}
 		}
 
-		// Render heat map (semi-transparent, render after sphere before beam)
-		if (heatMapRenderer_ && heatMapRenderer_->isVisible()) {
+		// The heat map buffer and shadow map below are written by the compute
+		// thread; order this frame's draws after its newest finished job
+		if (rcsThread_) {
+			rcsThread_->waitForGPU();
+		}
+
+		// Translucent layers share one weighted blended OIT pass: they need no
+		// draw order among themselves and no blend state of their own. Opaque
+		// geometry is all drawn by now, so its depth hides them.
+		const bool translucent = transparencyPass_ && (sceneInView || lobesInView) && transparencyPass_->begin();
+
+		// Render heat map (translucent)
+		if (heatMapRenderer_ && heatMapRenderer_->isVisible() && sceneInView && translucent) {
+			RS::FrameProfiler::Scope stage(profiler, "HeatMapRenderer");
 			heatMapRenderer_->render(projectionMatrix, viewMatrix, modelMatrix);
 		}
 
 		// Render slicing plane visualization
-		if (slicingPlaneRenderer_ && slicingPlaneRenderer_->isVisible()) {
-			slicingPlaneRenderer_->render(projectionMatrix, viewMatrix, modelMatrix);
+		if (slicingPlaneRenderer_ && slicingPlaneRenderer_->isVisible() && sceneInView) {
+			RS::FrameProfiler::Scope stage(profiler, "SlicingPlaneRenderer");
+			if (translucent) {
+				slicingPlaneRenderer_->render(projectionMatrix, viewMatrix, modelMatrix);
+			}
+			if (lineBatcher_) {
+				slicingPlaneRenderer_->submitOutline(*lineBatcher_, modelMatrix);
+			}
 		}
 
 		if (beamController_) {
+			RS::FrameProfiler::Scope stage(profiler, "BeamController");
+			// The decoupled shadow map follows the footprint's size on screen and
+			// is only retraced when the radar, beam or target moved, so it stays
+			// current while the RCS trace itself is paced or skipped
+			if (rcsThread_ && wireframeController_ && wireframeController_->isVisible()) {
+				int resolution = decoupledShadows_ ? beamFootprintPixels(projectionMatrix, viewMatrix, modelMatrix) : 0;
+				rcsThread_->submit([resolution](RCS::RCSCompute& compute) {
+					compute.setShadowResolution(resolution);
+					compute.updateShadowMap();
+				});
+			}
+
 			// Pass GPU shadow map from RCS compute to beam for ray-traced shadow
-			if (rcsCompute_ && rcsCompute_->hasShadowMap() && wireframeController_ && wireframeController_->isVisible()) {
+			// (the newest one the compute thread has published)
+			if (rcsThread_ && rcsStatus_.hasShadowMap && wireframeController_ && wireframeController_->isVisible()) {
 				QVector3D radarPos = sphericalToCartesian(radius_, theta_, phi_);
-				beamController_->setGPUShadowMap(rcsCompute_->getShadowMapTexture());
+				beamController_->setGPUShadowMap(rcsStatus_.shadowMapTexture);
 				beamController_->setGPUShadowEnabled(true);
 				beamController_->setBeamAxis(-radarPos.normalized());
-				beamController_->setBeamWidthRadians(rcsCompute_->getBeamWidthRadians());
-				beamController_->setNumRings(rcsCompute_->getNumRings());
+				beamController_->setBeamWidthRadians(rcsStatus_.beamWidthRadians);
+				beamController_->setNumRings(rcsStatus_.shadowMapRings);
 			} else {
 				beamController_->setGPUShadowEnabled(false);
 			}
 
-			beamController_->render(projectionMatrix, viewMatrix, modelMatrix);
+			if (sceneInView && translucent) {
+				beamController_->render(projectionMatrix, viewMatrix, modelMatrix);
+			}
 		}
 
-		// Render reflection lobes (transparent, so render last)
+		// Render reflection lobes (translucent)
 		// Skip for SingleRay - use bounce visualization instead
 		bool skipReflectionLobes = beamController_ &&
 		                           beamController_->getBeamType() == BeamType::SingleRay;
-		if (reflectionRenderer_ && reflectionRenderer_->isVisible() && !skipReflectionLobes) {
+		if (reflectionRenderer_ && reflectionRenderer_->isVisible() && !skipReflectionLobes && lobesInView && translucent) {
+			RS::FrameProfiler::Scope stage(profiler, "ReflectionRenderer");
 			reflectionRenderer_->render(projectionMatrix, viewMatrix, modelMatrix);
 		}
 
-		// Render debug ray visualization (additive, on top of everything)
-		if (debugRayEnabled_ && debugRayRenderer_ && rcsCompute_ && wireframeController_) {
-			// Get target center position for debug ray aiming
-			QVector3D targetCenter = wireframeController_->getPosition();
-			QVector3D radarPos = sphericalToCartesian(radius_, theta_, phi_);
+		if (translucent) {
+			RS::FrameProfiler::Scope stage(profiler, "TransparencyPass");
+			transparencyPass_->end();
+		}
+
+		// The debug ray and the bounce visualization draw from one diagnostic
+		// trace, redone only when the radar or the target moved
+		bool showDebugRay = debugRayEnabled_ && debugRayRenderer_ && lineBatcher_ && rcsThread_ && wireframeController_;
+		bool showBounces = bounceRenderer_ && lineBatcher_ && beamController_ && beamController_->showBounceVisualization() &&
+		                   rcsThread_ && wireframeController_;
+		if ((showDebugRay || showBounces) && !bouncePathStamp_.isCurrent(sceneVersions_)) {
+			// Trace multi-bounce ray from radar toward target center on the
+			// compute thread; the path is drawn once it comes back
+			rcsThread_->submit([this, targetCenter = wireframeController_->getPosition()](RCS::RCSCompute& compute) {
+				std::vector<RCS::HitResult> path = compute.traceDebugRayMultiBounce(targetCenter, kMaxBounces);
+				QMetaObject::invokeMethod(this, [this, path = std::move(path)]() mutable {
+					bouncePath_ = std::move(path);
+					++bouncePathRevision_;
+					update();
+				}, Qt::QueuedConnection);
+			});
+			bouncePathStamp_.update(sceneVersions_);
+		}
 
-			// Trace multi-bounce debug ray from radar toward target center
-			std::vector<RCS::HitResult> bounces = rcsCompute_->traceDebugRayMultiBounce(targetCenter, 5);
+		// Queue debug ray visualization (drawn with the overlay batch below)
+		if (showDebugRay) {
+			RS::FrameProfiler::Scope stage(profiler, "DebugRayRenderer");
+			QVector3D radarPos = sphericalToCartesian(radius_, theta_, phi_);
 
-			// Update debug ray renderer with multi-bounce data
-			debugRayRenderer_->setMultiBounceData(radarPos, bounces, radius_);
+			// The debug ray shows the first bounces of the cached path
+			size_t debugBounces = std::min(bouncePath_.size(), static_cast<size_t>(kDebugRayBounces));
+			debugBounces_.assign(bouncePath_.begin(), bouncePath_.begin() + debugBounces);
+			debugRayRenderer_->setMultiBounceData(radarPos, debugBounces_, radius_, bouncePathRevision_);
 			debugRayRenderer_->setVisible(true);
-			QVector3D cameraPos = cameraController_->getCameraPosition();
-			debugRayRenderer_->render(projectionMatrix, viewMatrix, cameraPos);
+			debugRayRenderer_->submit(*lineBatcher_);
 		} else if (debugRayRenderer_) {
 			debugRayRenderer_->setVisible(false);
 		}
 
-		// Render bounce visualization if enabled on current beam
-		if (bounceRenderer_ && beamController_ && beamController_->showBounceVisualization() && rcsCompute_ && wireframeController_) {
+		// Queue bounce visualization if enabled on current beam
+		if (showBounces) {
+			RS::FrameProfiler::Scope stage(profiler, "BounceRenderer");
 			QVector3D radarPos = sphericalToCartesian(radius_, theta_, phi_);
-			QVector3D targetCenter = wireframeController_->getPosition();
-
-			// Trace bounces using the diagnostic ray
-			std::vector<RCS::HitResult> bounces = rcsCompute_->traceDebugRayMultiBounce(targetCenter, kMaxBounces);
-
-			bounceRenderer_->setBounceData(radarPos, bounces, radius_);
+			bounceRenderer_->setBounceData(radarPos, bouncePath_, radius_, bouncePathRevision_);
 			bounceRenderer_->setVisible(true);
-			QVector3D cameraPos = cameraController_->getCameraPosition();
-			bounceRenderer_->render(projectionMatrix, viewMatrix, cameraPos);
+			bounceRenderer_->submit(*lineBatcher_);
 		} else if (bounceRenderer_) {
 			bounceRenderer_->setVisible(false);
 		}
+
+		// All overlay lines and markers queued this frame, in one draw
+		if (lineBatcher_ && !lineBatcher_->isEmpty()) {
+			RS::FrameProfiler::Scope stage(profiler, "LineBatcher");
+			lineBatcher_->flush(projectionMatrix, viewMatrix);
+		}
 	}
 	catch (const std::exception& e) {
 		qCritical() << "Exception in RadarGLWidget::paintGL:" << e.what();
@@ -504,12 +1111,32 @@ void RadarGLWidget::paintGL() {
 		qCritical() << "Unknown exception in RadarGLWidget::paintGL";
 	}
 
-	// Release FBO if rendering to texture (before QPainter which doesn't work with FBO)
+	if (profiler) {
+		profiler->endFrame();
+	}
+	telemetry_.record(RS::TelemetryMetric::FrameMs, frameTimer.nsecsElapsed() * 1.0e-6);
+
+	// The first frame is out; finish the deferred components in idle time
+	if (!warmUpStarted_) {
+		warmUpStarted_ = true;
+		warmUpTimer_.start();
+	}
+
+	// Resolve and upscale the scene into the pop-out texture, or into the
+	// widget before QPainter draws over it
 	if (renderToFBO_ && fboRenderer_ && fboRenderer_->isValid()) {
-		fboRenderer_->release();
+		if (sceneBound) {
+			sceneTarget_->present(fboRenderer_->beginPresent(), outputWidth, outputHeight);
+			fboRenderer_->endPresent();
+		}
+		renderScaler_.endFrame();
 		// Skip 2D text rendering when in FBO mode - it would render to screen, not FBO
 		return;
 	}
+	if (sceneBound) {
+		sceneTarget_->present(defaultFramebufferObject(), outputWidth, outputHeight);
+	}
+	renderScaler_.endFrame();
 
 	// Render 2D text labels for axes on top of 3D scene
 	if (sphereRenderer_ && sphereRenderer_->areAxesVisible()) {
@@ -583,6 +1210,89 @@ void RadarGLWidget::paintGL() {
 
 		painter.end();
 	}
+
+	if (lastPickHover_ && lastPick_.hit) {
+		drawPickLabel();
+	}
+
+	// Render profiler overlay last so it sits above every other label
+	if (profilerOverlayVisible_ && profiler_) {
+		drawProfilerOverlay();
+	}
+}
+
+void RadarGLWidget::drawProfilerOverlay() {
+	std::vector<RS::StageTiming> stages = profiler_->getAveragedStages();
+	const auto& history = profiler_->getHistory();
+
+	QPainter painter(this);
+	QFont font("Monospace");
+	font.setStyleHint(QFont::TypeWriter);
+	font.setPointSize(UI::kProfilerFontSize);
+	painter.setFont(font);
+	QFontMetrics metrics(font);
+
+	// Frame totals averaged over the same window as the stages
+	double frameCpuMs = 0.0;
+	double frameGpuMs = 0.0;
+	for (const auto& frame : history) {
+		frameCpuMs += frame.cpuMs;
+		frameGpuMs += frame.gpuMs;
+	}
+	if (!history.empty()) {
+		frameCpuMs /= static_cast<double>(history.size());
+		frameGpuMs /= static_cast<double>(history.size());
+	}
+
+	QStringList lines;
+	lines << QString("%1 %2 %3").arg(QString("Stage"), -30).arg(QString("CPU ms"), 8).arg(QString("GPU ms"), 8);
+	lines << QString("%1 %2 %3").arg(QString("Frame"), -30)
+		.arg(frameCpuMs, 8, 'f', 3).arg(frameGpuMs, 8, 'f', 3);
+	for (const auto& stage : stages) {
+		QString name = QString(stage.depth * 2, ' ') + QString::fromLatin1(stage.name);
+		if (stage.calls > 1) {
+			name += QString(" x%1").arg(stage.calls);
+		}
+		QString gpu = stage.gpuMs >= 0.0 ? QString::number(stage.gpuMs, 'f', 3) : QString("-");
+		lines << QString("%1 %2 %3").arg(name, -30).arg(stage.cpuMs, 8, 'f', 3).arg(gpu, 8);
+	}
+	if (RS::kAllocationCounting) {
+		RS::AllocationStats allocations = profiler_->getAveragedAllocations();
+		lines << QString("Allocations/frame: %1 (%2 KB)")
+			.arg(allocations.allocations).arg(allocations.bytes / 1024.0, 0, 'f', 1);
+	}
+	if (profiler_->getDroppedFrames() > 0) {
+		lines << QString("Dropped (GPU behind): %1").arg(profiler_->getDroppedFrames());
+	}
+	const double mb = 1.0 / (1024.0 * 1024.0);
+	QString gpuBudget = RS::GPUMemory::budgetBytes() > 0
+		? QString(" of %1 MB").arg(RS::GPUMemory::budgetBytes() * mb, 0, 'f', 0) : QString();
+	lines << QString("GPU memory: %1 MB%2").arg(RS::GPUMemory::usedBytes() * mb, 0, 'f', 1).arg(gpuBudget);
+	for (int i = 0; i < static_cast<int>(RS::GPUMemoryPool::Count); i++) {
+		auto pool = static_cast<RS::GPUMemoryPool>(i);
+		if (RS::GPUMemory::usedBytes(pool) > 0) {
+			lines << QString("  %1 %2 MB").arg(QString::fromLatin1(RS::gpuMemoryPoolName(pool)), -28)
+				.arg(RS::GPUMemory::usedBytes(pool) * mb, 8, 'f', 1);
+		}
+	}
+
+	// Translucent backing so the text stays readable over the scene
+	const int margin = 6;
+	const int lineHeight = metrics.lineSpacing();
+	int textWidth = 0;
+	for (const QString& line : lines) {
+		textWidth = std::max(textWidth, metrics.horizontalAdvance(line));
+	}
+	QRect box(margin, margin, textWidth + 2 * margin, lineHeight * static_cast<int>(lines.size()) + 2 * margin);
+	painter.fillRect(box, QColor(0, 0, 0, 160));
+
+	painter.setPen(Qt::white);
+	int y = box.top() + margin + metrics.ascent();
+	for (const QString& line : lines) {
+		painter.drawText(QPointF(box.left() + margin, y), line);
+		y += lineHeight;
+	}
+	painter.end();
 }
 
 void RadarGLWidget::updateBeamPosition() {
@@ -617,6 +1327,129 @@ bool RadarGLWidget::areReflectionLobesVisible() const {
 	return reflectionRenderer_ ? reflectionRenderer_->isVisible() : false;
 }
 
+void RadarGLWidget::setDatasetView(bool enabled) {
+	if (datasetView_ == enabled) {
+		return;
+	}
+	datasetView_ = enabled;
+	if (!enabled) {
+		// Back to live results; the retrace also points the heat map at the GPU bins again
+		rcsTraceStamp_.invalidate();
+	}
+	update();
+}
+
+void RadarGLWidget::showDatasetCut(const std::vector<RCSDataPoint>& cut, float elevationDegrees,
+								   float minDbsm, float maxDbsm) {
+	if (!datasetView_) {
+		return;
+	}
+	if (heatMapRenderer_) {
+		heatMapRenderer_->setSphereRadius(radius_);
+		heatMapRenderer_->setGPUIntensityBuffer(0);
+		heatMapRenderer_->updateFromCut(cut, elevationDegrees, minDbsm, maxDbsm);
+	}
+	polarPlotData_ = cut;
+	emit polarPlotDataReady(polarPlotData_);
+	update();
+}
+
+void RadarGLWidget::setProfilerOverlayVisible(bool visible) {
+	profilerOverlayVisible_ = visible;
+	updateProfilerEnabled();
+	update();
+}
+
+bool RadarGLWidget::startProfilerLog(const QString& path) {
+	if (!profiler_) {
+		return false;
+	}
+	bool started = profiler_->startLog(path);
+	updateProfilerEnabled();
+	update();
+	return started;
+}
+
+void RadarGLWidget::stopProfilerLog() {
+	if (profiler_) {
+		profiler_->stopLog();
+	}
+	updateProfilerEnabled();
+}
+
+void RadarGLWidget::updateProfilerEnabled() {
+	if (profiler_) {
+		profiler_->setEnabled(profilerOverlayVisible_ || profiler_->isLogging());
+	}
+}
+
+void RadarGLWidget::initializeVisibleComponents() {
+	// Context is current (paintGL); hidden components stay uninitialized
+	if (reflectionRenderer_ && reflectionRenderer_->isVisible()) {
+		ensureInitialized(reflectionRenderer_, "ReflectionRenderer");
+	}
+	if (heatMapRenderer_ && heatMapRenderer_->isVisible()) {
+		ensureInitialized(heatMapRenderer_, "HeatMapRenderer");
+	}
+	if (slicingPlaneRenderer_ && slicingPlaneRenderer_->isVisible()) {
+		ensureInitialized(slicingPlaneRenderer_, "SlicingPlaneRenderer");
+	}
+}
+
+bool RadarGLWidget::ensureFBORenderer() {
+	if (!fboRenderer_) {
+		return false;
+	}
+	if (fboRenderer_->isValid()) {
+		return true;
+	}
+
+	// A pop-out may already have asked for more than the widget size
+	int fboWidth = std::max(width(), fboRenderer_->pendingWidth());
+	int fboHeight = std::max(height(), fboRenderer_->pendingHeight());
+	if (!fboRenderer_->initialize(fboWidth, fboHeight)) {
+		qWarning() << "FBORenderer initialization failed - pop-out windows may not work";
+		fboRenderer_.reset();
+		return false;
+	}
+	return true;
+}
+
+void RadarGLWidget::dumpTelemetry() {
+	// An idle session keeps its last dump instead of rewriting the same window
+	uint64_t frames = telemetry_.sessionSamples(RS::TelemetryMetric::FrameMs);
+	if (frames != telemetryDumpedFrames_) {
+		telemetry_.writeJson(RS::SessionTelemetry::defaultPath());
+		telemetryDumpedFrames_ = frames;
+	}
+	telemetry_.advanceWindow();
+}
+
+void RadarGLWidget::warmUpNextComponent() {
+	if (!glInitialized_ || glCleanedUp_) {
+		return;
+	}
+
+	// One component per tick so no single idle slice compiles everything.
+	// The FBO is left out: its attachments are VRAM a pop-out may never use.
+	makeCurrent();
+	if (reflectionRenderer_ && !reflectionRenderer_->isInitialized()) {
+		ensureInitialized(reflectionRenderer_, "ReflectionRenderer");
+	} else if (heatMapRenderer_ && !heatMapRenderer_->isInitialized()) {
+		ensureInitialized(heatMapRenderer_, "HeatMapRenderer");
+	} else if (slicingPlaneRenderer_ && !slicingPlaneRenderer_->isInitialized()) {
+		ensureInitialized(slicingPlaneRenderer_, "SlicingPlaneRenderer");
+	}
+	bool pending = (reflectionRenderer_ && !reflectionRenderer_->isInitialized()) ||
+				   (heatMapRenderer_ && !heatMapRenderer_->isInitialized()) ||
+				   (slicingPlaneRenderer_ && !slicingPlaneRenderer_->isInitialized());
+	doneCurrent();
+
+	if (pending) {
+		warmUpTimer_.start();
+	}
+}
+
 void RadarGLWidget::setHeatMapVisible(bool visible) {
 	if (heatMapRenderer_) {
 		heatMapRenderer_->setVisible(visible);
@@ -637,12 +1470,12 @@ void RadarGLWidget::setRenderToFBO(bool enable) {
 
 void RadarGLWidget::requestFBOResize(int width, int height) {
 	if (fboRenderer_ && renderToFBO_) {
-		// Only resize if larger than current (don't shrink for main widget)
-		if (width > fboRenderer_->width() || height > fboRenderer_->height()) {
-			makeCurrent();
-			fboRenderer_->resize(width, height);
-			doneCurrent();
-			update();  // Trigger repaint with new FBO size
+		// Only resize if larger than current (don't shrink for main widget).
+		// The reallocation itself is debounced inside FBORenderer.
+		int targetWidth = fboRenderer_->pendingWidth();
+		int targetHeight = fboRenderer_->pendingHeight();
+		if (width > targetWidth || height > targetHeight) {
+			fboRenderer_->resize(std::max(width, targetWidth), std::max(height, targetHeight));
 		}
 	}
 }
@@ -686,6 +1519,13 @@ void RadarGLWidget::setAngles(float theta, float phi) {
 }
 
 void RadarGLWidget::mousePressEvent(QMouseEvent* event) {
+	if (event->button() == Qt::LeftButton) {
+		pressPos_ = event->pos();
+	}
+	// A drag hides the hover label until the cursor rests again
+	hoverPending_ = false;
+	lastPickHover_ = false;
+
 	// Forward to camera controller
 	if (cameraController_) {
 		cameraController_->mousePressEvent(event);
@@ -694,6 +1534,11 @@ void RadarGLWidget::mousePressEvent(QMouseEvent* event) {
 }
 
 void RadarGLWidget::mouseMoveEvent(QMouseEvent* event) {
+	if (hoverPicking_ && event->buttons() == Qt::NoButton) {
+		hoverPos_ = event->pos();
+		hoverPending_ = true;
+		update();
+	}
 	if (cameraController_) {
 		cameraController_->mouseMoveEvent(event);
 		update(); // Request update after state change
@@ -701,6 +1546,13 @@ void RadarGLWidget::mouseMoveEvent(QMouseEvent* event) {
 }
 
 void RadarGLWidget::mouseReleaseEvent(QMouseEvent* event) {
+	// A left click that did not drag the camera picks
+	if (event->button() == Qt::LeftButton &&
+		(event->pos() - pressPos_).manhattanLength() < QApplication::startDragDistance()) {
+		clickPos_ = event->pos();
+		clickPending_ = true;
+		update();
+	}
 	if (cameraController_) {
 		cameraController_->mouseReleaseEvent(event);
 		update(); // Request update after state change
@@ -728,6 +1580,84 @@ void RadarGLWidget::mouseDoubleClickEvent(QMouseEvent* event) {
 	}
 }
 
+void RadarGLWidget::leaveEvent(QEvent* event) {
+	hoverPending_ = false;
+	if (lastPickHover_) {
+		lastPickHover_ = false;
+		update();
+	}
+	QOpenGLWidget::leaveEvent(event);
+}
+
+void RadarGLWidget::setHoverPicking(bool enabled) {
+	hoverPicking_ = enabled;
+	if (!enabled) {
+		hoverPending_ = false;
+		lastPickHover_ = false;
+		update();
+	}
+}
+
+// One pick per frame: the waiting click, else the newest hover position, is
+// unprojected into scene space and traced on the compute thread. The cursor
+// moving on while the job is in flight just leaves the next frame a newer
+// position to query.
+void RadarGLWidget::submitPick(const QMatrix4x4& viewProjection) {
+	if ((!hoverPending_ && !clickPending_) || pickInFlight_ || !rcsThread_ || width() <= 0 || height() <= 0) {
+		return;
+	}
+	bool click = clickPending_;
+	QPoint cursor = click ? clickPos_ : hoverPos_;
+	clickPending_ = false;
+	hoverPending_ = false;
+
+	bool invertible = false;
+	QMatrix4x4 inverse = viewProjection.inverted(&invertible);
+	if (!invertible) {
+		return;
+	}
+	float ndcX = 2.0f * (cursor.x() + 0.5f) / width() - 1.0f;
+	float ndcY = 1.0f - 2.0f * (cursor.y() + 0.5f) / height();
+	QVector3D nearPoint = inverse.map(QVector3D(ndcX, ndcY, -1.0f));
+	QVector3D farPoint = inverse.map(QVector3D(ndcX, ndcY, 1.0f));
+
+	pickInFlight_ = true;
+	rcsThread_->submit([this, nearPoint, direction = farPoint - nearPoint, click, cursor](RCS::RCSCompute& compute) {
+		RCS::PickResult pick = compute.pick(nearPoint, direction, kDebugRayBounces);
+		QMetaObject::invokeMethod(this, [this, pick = std::move(pick), click, cursor]() mutable {
+			pickInFlight_ = false;
+			lastPick_ = std::move(pick);
+			lastPickPos_ = cursor;
+			lastPickHover_ = !click && hoverPicking_;
+			if (click) {
+				emit targetPicked(lastPick_);
+			} else {
+				emit targetHovered(lastPick_);
+			}
+			update();
+		}, Qt::QueuedConnection);
+	});
+}
+
+// Triangle, return and path of the hovered surface, next to the cursor
+void RadarGLWidget::drawPickLabel() {
+	QString surface = lastPick_.primitive ? QString("Primitive %1").arg(lastPick_.triangle)
+	                                      : QString("Triangle %1").arg(lastPick_.triangle);
+	QString info = lastPick_.radarVisible
+		? QString("%1  Return: %2  Bounces: %3").arg(surface)
+			.arg(lastPick_.intensity, 0, 'f', 3)
+			.arg(lastPick_.path.size())
+		: QString("%1  (shadowed)").arg(surface);
+
+	QPainter painter(this);
+	painter.setPen(Qt::white);
+	QFont font = painter.font();
+	font.setPointSize(UI::kPickLabelFontSize);
+	painter.setFont(font);
+	painter.drawText(QPointF(lastPickPos_.x() + UI::kTextOffsetPixels, lastPickPos_.y() - UI::kTextOffsetPixels), info);
+	painter.end();
+}
+
 QVector3D RadarGLWidget::sphericalToCartesian(float r, float thetaDeg, float phiDeg) {
 	float theta = thetaDeg * kDegToRadF;
 	float phi = phiDeg * kDegToRadF;
@@ -836,6 +1766,71 @@ bool RadarGLWidget::isRCSPlaneShowFill() const {
 	return slicingPlaneRenderer_ ? slicingPlaneRenderer_->isShowFill() : true;
 }
 
+void RadarGLWidget::setRCSCoherent(bool coherent) {
+	if (rcsCoherent_ != coherent) {
+		rcsCoherent_ = coherent;
+		applyRCSCoherent();
+		sphereTable_.clear();
+		sphereTableFrame_ = 0;
+		invalidateRCSResults();
+		update();
+	}
+}
+
+void RadarGLWidget::applyRCSCoherent() {
+	// One frequency point; scene units are meters
+	RCS::FrequencySweep sweep;
+	sweep.startHz = sweep.stopHz = Defaults::kRadarFrequencyHz;
+	sweep.points = 1;
+	double waveNumber = kTwoPi * sweep.startHz * sweep.metersPerUnit / kSpeedOfLight;
+
+	if (azimuthSampler_) {
+		azimuthSampler_->setCoherent(rcsCoherent_, waveNumber);
+	}
+	if (elevationSampler_) {
+		elevationSampler_->setCoherent(rcsCoherent_, waveNumber);
+	}
+	overlaySampler_.setCoherent(rcsCoherent_, waveNumber);
+	overlayStale_ = true;
+	if (rcsThread_) {
+		rcsThread_->submit([coherent = rcsCoherent_, sweep](RCS::RCSCompute& compute) {
+			compute.setFrequencySweep(coherent, sweep);
+		});
+	}
+}
+
+void RadarGLWidget::setTriangleHotspots(bool enabled) {
+	if (triangleHotspots_ != enabled) {
+		triangleHotspots_ = enabled;
+		if (rcsThread_) {
+			rcsThread_->submit([enabled](RCS::RCSCompute& compute) { compute.setTriangleHotspots(enabled); });
+		}
+		if (!enabled && wireframeController_ && wireframeController_->getTarget()) {
+			wireframeController_->getTarget()->setHotspotBuffer(0, -1);
+		}
+		rcsTraceStamp_.invalidate();  // Retrace to fill the sums; cached bins stay valid
+		update();
+	}
+}
+
+void RadarGLWidget::setEdgeDiffraction(bool enabled) {
+	if (edgeDiffraction_ != enabled) {
+		edgeDiffraction_ = enabled;
+		if (rcsThread_) {
+			rcsThread_->submit([enabled, waveNumber = edgeWaveNumber()](RCS::RCSCompute& compute) {
+				compute.setEdgeDiffraction(enabled, waveNumber);
+			});
+		}
+		invalidateRCSResults();
+		update();
+	}
+}
+
+float RadarGLWidget::edgeWaveNumber() {
+	// Scene units are meters, as for the coherent cut
+	return static_cast<float>(kTwoPi * Defaults::kRadarFrequencyHz / kSpeedOfLight);
+}
+
 void RadarGLWidget::setDebugRayEnabled(bool enabled) {
 	if (debugRayEnabled_ != enabled) {
 		debugRayEnabled_ = enabled;
@@ -848,19 +1843,224 @@ void RadarGLWidget::setDebugRayEnabled(bool enabled) {
 
 void RadarGLWidget::setRayCount(int count) {
 	// Clamp to valid range
-	count = qBound(100, count, 10000);
+	count = qBound(kMinRayCount, count, kMaxRayCount);
 	if (rayCount_ != count) {
 		rayCount_ = count;
 		update();
 	}
 }
 
+void RadarGLWidget::setRCSFrameBudget(double milliseconds) {
+	framePacer_.setBudgetMs(milliseconds);
+	update();
+}
+
+void RadarGLWidget::setGPUMemoryBudget(double megabytes) {
+	gpuMemoryBudgetMB_ = std::max(megabytes, 0.0);
+	if (!isValid()) {
+		return;  // initializeGL applies it
+	}
+	makeCurrent();
+	applyGPUMemoryBudget();
+	doneCurrent();
+	update();
+}
+
+void RadarGLWidget::applyGPUMemoryBudget() {
+	uint64_t bytes = static_cast<uint64_t>(gpuMemoryBudgetMB_ * 1024.0 * 1024.0);
+	if (bytes == 0 && QOpenGLContext::currentContext()) {
+		bytes = RS::GPUMemory::detectBudgetBytes();
+		if (bytes == 0) {
+			qWarning() << "GPU memory size unknown - GPU memory is tracked without a budget";
+		}
+	}
+	RS::GPUMemory::setBudgetBytes(bytes);
+}
+
+void RadarGLWidget::setProgressiveRefinement(bool enabled) {
+	if (progressiveRefinement_ != enabled) {
+		progressiveRefinement_ = enabled;
+		if (rcsThread_) {
+			rcsThread_->submit([enabled](RCS::RCSCompute& compute) { compute.setProgressive(enabled); });
+		}
+		update();
+	}
+}
+
+void RadarGLWidget::setTemporalReuse(bool enabled) {
+	if (temporalReuse_ != enabled) {
+		temporalReuse_ = enabled;
+		if (rcsThread_) {
+			rcsThread_->submit([enabled](RCS::RCSCompute& compute) { compute.setTemporalReuse(enabled); });
+		}
+		update();  // Hits stay exact and refinement replaces blended bins, so cached results stay valid
+	}
+}
+
+void RadarGLWidget::setResultCaching(bool enabled) {
+	if (resultCaching_ != enabled) {
+		resultCaching_ = enabled;
+		resultCache_.clear();
+		snapshotDue_ = false;
+		update();
+	}
+}
+
+void RadarGLWidget::invalidateRCSResults() {
+	rcsTraceStamp_.invalidate();
+	resultCache_.clear();
+}
+
+void RadarGLWidget::setRaySampling(RCS::RaySampling sampling) {
+	if (raySampling_ != sampling) {
+		raySampling_ = sampling;
+		if (rcsThread_) {
+			rcsThread_->submit([sampling](RCS::RCSCompute& compute) { compute.setRaySampling(sampling); });
+		}
+		invalidateRCSResults();
+		update();
+	}
+}
+
+void RadarGLWidget::setSampleJitter(bool enabled) {
+	if (sampleJitter_ != enabled) {
+		sampleJitter_ = enabled;
+		if (rcsThread_) {
+			rcsThread_->submit([enabled](RCS::RCSCompute& compute) { compute.setSampleJitter(enabled); });
+		}
+		invalidateRCSResults();
+		update();
+	}
+}
+
+void RadarGLWidget::setDecoupledShadows(bool enabled) {
+	if (decoupledShadows_ != enabled) {
+		decoupledShadows_ = enabled;
+		update();
+	}
+}
+
+void RadarGLWidget::updateBeamPattern(float tracedWidthDegrees) {
+	// Rebake the gain table only when the pattern or the cone it spans changes
+	const RadarBeam* beam = beamController_ ? beamController_->getBeam() : nullptr;
+	if (!beam) {
+		return;
+	}
+	BeamPatternKey key{static_cast<int>(beam->getBeamType()), beam->getBeamWidth(), tracedWidthDegrees,
+					   beam->getPatternVersion()};
+	if (key.beamType == beamPatternKey_.beamType && key.beamWidth == beamPatternKey_.beamWidth &&
+		key.tracedWidth == beamPatternKey_.tracedWidth && key.version == beamPatternKey_.version) {
+		return;
+	}
+	beamPatternKey_ = key;
+
+	beam->bakeGainPattern(beamPatternTable_, kBeamPatternAzimuthBins, kBeamPatternOffAxisBins,
+						  0.5f * tracedWidthDegrees * kDegToRadF);
+	rcsThread_->submit([table = beamPatternTable_](RCS::RCSCompute& compute) {
+		compute.setBeamPattern(table, kBeamPatternAzimuthBins, kBeamPatternOffAxisBins);
+	});
+	rcsTraceStamp_.invalidate();
+}
+
+int RadarGLWidget::beamFootprintPixels(const QMatrix4x4& projection, const QMatrix4x4& view,
+									   const QMatrix4x4& model) {
+	// The beam's cap on the far side of the sphere is the widest part of it the
+	// shadow covers; measure its diameter along two axes and keep the larger
+	QVector3D radarPos = sphericalToCartesian(radius_, theta_, phi_);
+	QVector3D axis = -radarPos.normalized();
+	QVector3D center = radarPos + axis * (2.0f * radius_);
+	float capRadius = 2.0f * radius_ * std::tan(0.5f * rcsStatus_.beamWidthRadians);
+	QVector3D side = QVector3D::crossProduct(axis, std::abs(axis.z()) < 0.99f ? QVector3D(0.0f, 0.0f, 1.0f)
+																			  : QVector3D(1.0f, 0.0f, 0.0f)).normalized();
+	QVector3D up = QVector3D::crossProduct(side, axis);
+
+	QPointF c = projectToScreen(center, projection, view, model);
+	QPointF s = projectToScreen(center + side * capRadius, projection, view, model) - c;
+	QPointF u = projectToScreen(center + up * capRadius, projection, view, model) - c;
+	double radius = std::max(std::hypot(s.x(), s.y()), std::hypot(u.x(), u.y())) * devicePixelRatioF();
+	return static_cast<int>(std::clamp(2.0 * radius, 1.0, static_cast<double>(kShadowMapMaxWidth)));
+}
+
+void RadarGLWidget::setReceiverSites(const std::vector<RadarSite>& sites) {
+	receiverSites_.assign(sites.begin(), sites.begin() + std::min<size_t>(sites.size(), kMaxReceivers));
+	if (sites.size() > static_cast<size_t>(kMaxReceivers)) {
+		qWarning() << "RadarGLWidget: Keeping the first" << kMaxReceivers << "of" << sites.size() << "receiver sites";
+	}
+	if (radarSiteRenderer_) {
+		radarSiteRenderer_->setReceivers(receiverSites_);
+	}
+	bistaticDbsm_.clear();
+	bistaticFrame_ = 0;
+	update();
+}
+
+void RadarGLWidget::setOverlayCuts(const std::vector<CutSpec>& cuts) {
+	overlayCuts_.assign(cuts.begin(), cuts.begin() + std::min<size_t>(cuts.size(), kMaxOverlayCuts));
+	if (cuts.size() > static_cast<size_t>(kMaxOverlayCuts)) {
+		qWarning() << "RadarGLWidget: Keeping the first" << kMaxOverlayCuts << "of" << cuts.size() << "overlay cuts";
+	}
+	overlaySampler_.setCuts(overlayCuts_);
+	overlayStale_ = true;
+	if (overlayCuts_.empty()) {
+		overlayCurves_.clear();
+		emit overlayCutsReady(overlayCurves_);
+	} else if (rcsCoherent_) {
+		rcsTraceStamp_.invalidate();  // Coherent overlays bin the trace's hits
+	}
+	update();
+}
+
+void RadarGLWidget::setRCSBounces(int bounces) {
+	bounces = qBound(1, bounces, kMaxRCSBounces);
+	if (rcsBounces_ != bounces) {
+		rcsBounces_ = bounces;
+		if (rcsThread_) {
+			rcsThread_->submit([bounces](RCS::RCSCompute& compute) { compute.setMaxBounces(bounces); });
+		}
+		invalidateRCSResults();
+		update();
+	}
+}
+
+void RadarGLWidget::setBounceTermination(float cutoff, float rouletteThreshold) {
+	cutoff = std::max(cutoff, 0.0f);
+	rouletteThreshold = std::max(rouletteThreshold, 0.0f);
+	if (bounceCutoff_ != cutoff || rouletteThreshold_ != rouletteThreshold) {
+		bounceCutoff_ = cutoff;
+		rouletteThreshold_ = rouletteThreshold;
+		if (rcsThread_) {
+			rcsThread_->submit([cutoff, rouletteThreshold](RCS::RCSCompute& compute) {
+				compute.setBounceTermination(cutoff, rouletteThreshold);
+			});
+		}
+		invalidateRCSResults();
+		update();
+	}
+}
+
 void RadarGLWidget::setRayTraceMode(RCS::RayTraceMode mode) {
 	if (rayTraceMode_ != mode) {
 		rayTraceMode_ = mode;
 		if (bounceRenderer_) {
 			bounceRenderer_->setRayTraceMode(mode);
 		}
+		if (rcsThread_) {
+			rcsThread_->submit([mode](RCS::RCSCompute& compute) {
+				RCS::BounceEffectPipeline bounceEffects;
+				bounceEffects.setMode(mode);
+				compute.setBounceEffects(bounceEffects);
+			});
+		}
+		invalidateRCSResults();
 		update();
 	}
 }
+
+void RadarGLWidget::setTargetMaterial(const RCS::Material& material) {
+	targetMaterial_ = material;
+	if (rcsThread_) {
+		rcsThread_->submit([material](RCS::RCSCompute& compute) { compute.setMaterials({material}); });
+	}
+	invalidateRCSResults();
+	update();
+}
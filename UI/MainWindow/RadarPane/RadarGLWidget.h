@@ -16,15 +16,28 @@
 #include "CameraController.h"
 #include "ModelManager.h"
 #include "WireframeTargetController.h"
-#include "RCSCompute.h"
+#include "RCSComputeThread.h"
+#include "RCSResultCache.h"
 #include "RCSSampler.h"
 #include "AzimuthCutSampler.h"
 #include "ElevationCutSampler.h"
+#include "MultiCutSampler.h"
+#include "SphereRCSTable.h"
 #include "SlicingPlaneRenderer.h"
 #include "ReflectionRenderer.h"
 #include "HeatMapRenderer.h"
 #include "DebugRayRenderer.h"
 #include "BounceRenderer.h"
+#include "LineBatcher.h"
+#include "TransparencyPass.h"
+#include "SceneTarget.h"
+#include "FrameProfiler.h"
+#include "FrameClock.h"
+#include "FramePacer.h"
+#include "RenderScaler.h"
+#include "GPUMemory.h"
+#include "SceneVersions.h"
+#include "SessionTelemetry.h"
 #include "../../../RCS/RayTraceTypes.h"
 
 class FBORenderer;
@@ -72,16 +85,104 @@ public:
     void setRCSPlaneShowFill(bool show);
     bool isRCSPlaneShowFill() const;
 
+    // Coherent cut - the samplers sum complex fields at kRadarFrequencyHz
+    // (a one-point RCSCompute frequency sweep on the GPU) instead of intensities
+    void setRCSCoherent(bool coherent);
+    bool isRCSCoherent() const { return rcsCoherent_; }
+
+    // Crease edges of the target add their diffracted return at
+    // kRadarFrequencyHz to the traced one (RCSCompute::setEdgeDiffraction)
+    void setEdgeDiffraction(bool enabled);
+    bool isEdgeDiffraction() const { return edgeDiffraction_; }
+
+    // Target triangles tinted by the primary RCS return they reflect, straight
+    // from the trace's GPU sums (RCSCompute::setTriangleHotspots)
+    void setTriangleHotspots(bool enabled);
+    bool isTriangleHotspots() const { return triangleHotspots_; }
+
+    // Target picking - a click (a left press released without dragging) and,
+    // with hover picking on, the resting cursor are traced against the
+    // targets' BVHs on the compute thread (RCSCompute::pick). At most one
+    // query per frame; newer cursor positions replace a waiting one.
+    void setHoverPicking(bool enabled);
+    bool isHoverPicking() const { return hoverPicking_; }
+    const RCS::PickResult& getLastPick() const { return lastPick_; }
+
     // Debug ray visualization
     void setDebugRayEnabled(bool enabled);
     bool isDebugRayEnabled() const { return debugRayEnabled_; }
     void setRayCount(int count);
     int getRayCount() const { return rayCount_; }
+
+    // Progressive RCS refinement - a preview trace while inputs change, then
+    // batches accumulate over the following frames (on by default)
+    void setProgressiveRefinement(bool enabled);
+    bool isProgressiveRefinement() const { return progressiveRefinement_; }
+
+    // Rays seeded by the leaves they hit last frame, and the bins of a small
+    // radar move blended with the last frame's (RCSCompute::setTemporalReuse)
+    void setTemporalReuse(bool enabled);
+    bool isTemporalReuse() const { return temporalReuse_; }
+
+    // Settled RCS results kept per quantized configuration (RCSResultCache);
+    // revisiting one restores its polar plot, heat map and lobes without a
+    // trace. On by default, with kResultCacheEntries entries.
+    void setResultCaching(bool enabled);
+    bool isResultCaching() const { return resultCaching_; }
+
+    // GPU milliseconds per frame the RCS trace may use while a control is
+    // being dragged (RS::FramePacer); refinement waits until input is idle
+    void setRCSFrameBudget(double milliseconds);
+    double getRCSFrameBudget() const { return framePacer_.budgetMs(); }
+
+    // GPU memory the renderers and RCS buffers plan within (RS::GPUMemory);
+    // 0 = a share of the detected VRAM. Over it, rebuildable caches are evicted.
+    // Set before the widget is shown, it is applied ahead of the first allocations.
+    void setGPUMemoryBudget(double megabytes);
+    double getGPUMemoryBudget() const { return RS::GPUMemory::budgetBytes() / (1024.0 * 1024.0); }
+
+    // Ray pattern on the beam cone and per-frame Cranley-Patterson jitter
+    // (RCSCompute::setRaySampling); Fibonacci with jitter by default
+    void setRaySampling(RCS::RaySampling sampling);
+    RCS::RaySampling getRaySampling() const { return raySampling_; }
+    void setSampleJitter(bool enabled);
+    bool isSampleJitter() const { return sampleJitter_; }
+
+    // Beam shadow map traced at the footprint's screen resolution, independent
+    // of the RCS ray count (RCSCompute::setShadowResolution); on by default
+    void setDecoupledShadows(bool enabled);
+    bool isDecoupledShadows() const { return decoupledShadows_; }
+
+    // Reflections traced per beam ray for the RCS (1 = single bounce)
+    void setRCSBounces(int bounces);
+    int getRCSBounces() const { return rcsBounces_; }
+    // Return at which a multi-bounce path ends, and under which it plays
+    // Russian roulette (0 = never); RCSCompute::setBounceTermination
+    void setBounceTermination(float cutoff, float rouletteThreshold);
+    float getBounceCutoff() const { return bounceCutoff_; }
+    float getRouletteThreshold() const { return rouletteThreshold_; }
+
+    // Bistatic receivers - the radar stays the transmitter and every receiver
+    // site gets its own return from the same trace (RCSCompute::setReceivers).
+    // bistaticRCSReady reports them in sites' order; at most kMaxReceivers.
+    void setReceiverSites(const std::vector<RadarSite>& sites);
+    const std::vector<RadarSite>& getReceiverSites() const { return receiverSites_; }
+
+    // Multi-cut mode - extra cuts (any mix of types and offsets) drawn over
+    // the primary one from the same trace; overlayCutsReady reports one curve
+    // per cut. Empty turns it off. At most kMaxOverlayCuts.
+    void setOverlayCuts(const std::vector<CutSpec>& cuts);
+    const std::vector<CutSpec>& getOverlayCuts() const { return overlayCuts_; }
     DebugRayRenderer* getDebugRayRenderer() const { return debugRayRenderer_.get(); }
 
     // Ray trace mode control
     void setRayTraceMode(RCS::RayTraceMode mode);
     RCS::RayTraceMode getRayTraceMode() const { return rayTraceMode_; }
+
+    // Surface material of the whole target, e.g. a radar-absorbent coating: a
+    // one-entry table every material ID clamps to. No BVH rebuild.
+    void setTargetMaterial(const RCS::Material& material);
+    const RCS::Material& getTargetMaterial() const { return targetMaterial_; }
     BounceRenderer* getBounceRenderer() const { return bounceRenderer_.get(); }
 
     // FBO rendering support (for pop-out windows)
@@ -89,6 +190,21 @@ public:
     bool isRenderingToFBO() const { return renderToFBO_; }
     FBORenderer* getFBORenderer() const { return fboRenderer_.get(); }
 
+    // Frame profiler - per-stage CPU/GPU timings as an overlay and/or rolling log.
+    // Timing is only recorded while one of the two is active.
+    void setProfilerOverlayVisible(bool visible);
+    bool isProfilerOverlayVisible() const { return profilerOverlayVisible_; }
+    bool startProfilerLog(const QString& path);
+    void stopProfilerLog();
+    bool isProfilerLogging() const { return profiler_ && profiler_->isLogging(); }
+
+    // Dataset view - the polar plot and heat map show stored sweep cuts
+    // (RCSDatasetViewer) and the live RCS trace is paused
+    void setDatasetView(bool enabled);
+    bool isDatasetView() const { return datasetView_; }
+    void showDatasetCut(const std::vector<RCSDataPoint>& cut, float elevationDegrees,
+                        float minDbsm, float maxDbsm);
+
     // Camera controller access (for mouse event forwarding)
     CameraController* getCameraController() const { return cameraController_.get(); }
 
@@ -101,12 +217,17 @@ public:
     void mouseReleaseEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
     void mouseDoubleClickEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
 
 signals:
     void radiusChanged(float radius);
     void anglesChanged(float theta, float phi);
     void polarPlotDataReady(const std::vector<RCSDataPoint>& data);
+    void bistaticRCSReady(const std::vector<float>& dBsm);  // One per receiver site, kDBsmFloor when empty
+    void overlayCutsReady(const std::vector<std::vector<RCSDataPoint>>& curves);  // One per overlay cut
     void popoutRequested();
+    void targetHovered(const RCS::PickResult& pick);  // pick.hit is false off the targets
+    void targetPicked(const RCS::PickResult& pick);
 
 protected:
     // Override OpenGL functions
@@ -127,6 +248,10 @@ private:
     bool glCleanedUp_ = false;  // Prevent double cleanup
     bool glInitialized_ = false;  // Track if initializeGL completed successfully
 
+    // One step per displayed frame for every animation (sphere inertia).
+    // Declared before the components so it outlives their stop() calls.
+    RS::FrameClock frameClock_;
+
     // Component ownership - deleted while GL context is still valid
     std::unique_ptr<SphereRenderer> sphereRenderer_;
     std::unique_ptr<RadarSiteRenderer> radarSiteRenderer_;
@@ -135,11 +260,104 @@ private:
     std::unique_ptr<ModelManager> modelManager_;
     std::unique_ptr<WireframeTargetController> wireframeController_;
 
-    // RCS computation (owned by this widget)
-    std::unique_ptr<RCS::RCSCompute> rcsCompute_;
+    // RCS computation (owned by this widget), run on the compute thread
+    std::unique_ptr<RCS::RCSComputeThread> rcsThread_;
+    RCS::RCSComputeStatus rcsStatus_;          // Polled once per paint
+    uint64_t submittedGeometryVersion_ = 0;    // Target mesh last handed to the compute thread
+    bool targetSubmitted_ = false;
+    bool readbackSettlePaint_ = false;  // True while the catch-up paint for async readback is queued
+    bool datasetView_ = false;          // Stored cuts replace the trace (setDatasetView)
+    bool progressiveRefinement_ = true;
+    bool temporalReuse_ = RS::Constants::Defaults::kTemporalReuse;
+    RCS::RaySampling raySampling_ = RCS::RaySampling::Fibonacci;
+    bool sampleJitter_ = true;
+    bool decoupledShadows_ = RS::Constants::Defaults::kDecoupledShadows;
+    double gpuMemoryBudgetMB_ = RS::Constants::Defaults::kGPUMemoryBudgetMB;
+
+    // Settled results by quantized trace inputs. Once a trace for a cacheable
+    // key settles, a snapshot job copies everything out for the cache; a
+    // later trace on a cached key is replaced by the entry.
+    RCS::RCSResultCache resultCache_{RS::Constants::kResultCacheEntries};
+    bool resultCaching_ = RS::Constants::Defaults::kRCSResultCache;
+    RCS::RCSResultKey traceKey_;     // Per-frame scratch, invalid when the results are not cacheable
+    RCS::RCSResultKey settleKey_;    // Inputs of the last restarted trace, snapshotted once it settles
+    RCS::RCSResultKey snapshotKey_;  // Inputs of the snapshot job in flight
+    bool snapshotDue_ = false;
+    bool restoredFromCache_ = false; // Shown results came from the cache; no refinement until input changes
+    uint64_t traceJobs_ = 0;         // Trace jobs submitted, echoed back in RCSTraceResults::job
+    uint64_t staleTraceJobs_ = 0;    // Results of jobs up to this one predate a restore and are dropped
+
+    // Beam gain table last handed to RCSCompute::setBeamPattern
+    struct BeamPatternKey {
+        int beamType = -1;
+        float beamWidth = 0.0f;
+        float tracedWidth = 0.0f;
+        uint64_t version = 0;
+    } beamPatternKey_;
+    std::vector<float> beamPatternTable_;
+
+    // Bistatic receiver sites and the newest per-receiver returns
+    std::vector<RadarSite> receiverSites_;
+    std::vector<QVector3D> receiverPositions_;  // Per-frame scratch, at radius_
+    std::vector<float> bistaticDbsm_;
+    uint64_t bistaticFrame_ = 0;
+    int rcsBounces_ = RS::Constants::Defaults::kRCSBounces;
+    float bounceCutoff_ = RS::Constants::kBounceCutoffIntensity;
+    float rouletteThreshold_ = RS::Constants::kBounceRouletteThreshold;
+
+    // Trace pacing while inputs change; the idle timer repaints once they
+    // settle so the deferred trace and refinement run
+    RS::FramePacer framePacer_;
+    QTimer rcsIdleTimer_;
+
+    // Offscreen scene at a resolution and MSAA level RenderScaler lowers
+    // while the frame is over its raster budget
+    std::unique_ptr<SceneTarget> sceneTarget_;
+    RS::RenderScaler renderScaler_;
+
+    // Components whose GL setup waits until they are first shown; the warm-up
+    // timer initializes the ones still hidden one per tick after the first frame
+    QTimer warmUpTimer_;
+    bool warmUpStarted_ = false;
+
+    // Scene input versions - the RCS trace (and the lobes, heat map and polar
+    // plot fed from it) only reruns when an input it depends on changed
+    RS::SceneVersions sceneVersions_;
+    RS::StageStamp rcsTraceStamp_{RS::SceneInput::RadarPosition, RS::SceneInput::BeamParams,
+                                  RS::SceneInput::TargetGeometry, RS::SceneInput::TargetTransform,
+                                  RS::SceneInput::RayCount, RS::SceneInput::CutParams,
+                                  RS::SceneInput::Receivers};
+
+    // Diagnostic bounce path shared by the debug ray and bounce renderers.
+    // The revision tells them when to rebuild their line geometry.
+    std::vector<RCS::HitResult> bouncePath_;
+    uint64_t bouncePathRevision_ = 0;
+    RS::StageStamp bouncePathStamp_{RS::SceneInput::RadarPosition, RS::SceneInput::TargetGeometry,
+                                    RS::SceneInput::TargetTransform};
+
+    // Per-frame scratch rebuilt by paintGL. Members so steady-state frames
+    // reuse their capacity instead of allocating.
+    std::vector<QMatrix4x4> instanceModels_;
+    std::vector<RCS::TargetInstance> instances_;
+    std::vector<float> instanceMatrices_;
+    std::vector<RCS::HitResult> debugBounces_;
+
+    // Picking - the cursor positions waiting for a query (logical pixels) and
+    // the newest answer, labelled at the cursor while hovering
+    bool hoverPicking_ = RS::Constants::Defaults::kHoverPicking;
+    bool hoverPending_ = false;
+    bool clickPending_ = false;
+    bool pickInFlight_ = false;
+    QPoint hoverPos_;
+    QPoint clickPos_;
+    QPoint pressPos_;
+    RCS::PickResult lastPick_;
+    QPoint lastPickPos_;
+    bool lastPickHover_ = false;
 
     // Reflection lobe visualization
     std::unique_ptr<ReflectionRenderer> reflectionRenderer_;
+    bool gpuLobeClustering_ = true;  // false = CPU spatial hash over read-back hits
 
     // Heat map visualization
     std::unique_ptr<HeatMapRenderer> heatMapRenderer_;
@@ -152,11 +370,28 @@ private:
     // Bounce visualization
     std::unique_ptr<BounceRenderer> bounceRenderer_;
     RCS::RayTraceMode rayTraceMode_ = RCS::RayTraceMode::PhysicsAccurate;
+    RCS::Material targetMaterial_;
+
+    // One batched draw for the debug ray, bounce path and slicing outlines
+    std::unique_ptr<LineBatcher> lineBatcher_;
+
+    // Weighted blended OIT for the heat map, slicing plane, beam and lobes
+    std::unique_ptr<TransparencyPass> transparencyPass_;
 
     // FBO rendering for pop-out windows
     std::unique_ptr<FBORenderer> fboRenderer_;
     bool renderToFBO_ = false;
 
+    // Frame profiling
+    std::unique_ptr<RS::FrameProfiler> profiler_;
+    bool profilerOverlayVisible_ = false;
+
+    // Session telemetry - rolling percentiles, rewritten to telemetry.json
+    // every kTelemetryDumpIntervalMs while frames are being drawn
+    RS::SessionTelemetry telemetry_;
+    QTimer telemetryTimer_;
+    uint64_t telemetryDumpedFrames_ = 0;
+
     // Slicing plane visualization
     std::unique_ptr<SlicingPlaneRenderer> slicingPlaneRenderer_;
 
@@ -165,11 +400,43 @@ private:
     std::unique_ptr<ElevationCutSampler> elevationSampler_;
     RCSSampler* currentSampler_ = nullptr;  // Points to active sampler
     CutType currentCutType_ = CutType::Azimuth;
+    bool rcsCoherent_ = false;
+    bool edgeDiffraction_ = RS::Constants::Defaults::kEdgeDiffraction;
+    bool triangleHotspots_ = RS::Constants::Defaults::kTriangleHotspots;
+
+    // Incoherent cuts are extracted from a full-sphere table, so moving the
+    // cut plane re-extracts instead of retracing
+    SphereRCSTable sphereTable_;
+    uint64_t sphereTableFrame_ = 0;
+    RCS::BinningSlice sphereCutSlice_;
+    bool sphereCutStale_ = true;
+    std::vector<RCS::PolarBin> sphereCutBins_;
     std::vector<RCSDataPoint> polarPlotData_;
 
+    // Overlay cuts come from the sphere table when incoherent; coherent
+    // overlays bin the trace's hit stream in one fused pass instead
+    std::vector<CutSpec> overlayCuts_;
+    MultiCutSampler overlaySampler_;
+    std::vector<std::vector<RCSDataPoint>> overlayCurves_;
+    bool overlayStale_ = true;
+
     // Helper methods
     QVector3D sphericalToCartesian(float r, float thetaDeg, float phiDeg);
+    void updateBeamPattern(float tracedWidthDegrees);
+    int beamFootprintPixels(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& model);
     void updateBeamPosition();
+    void submitPick(const QMatrix4x4& viewProjection);
+    void drawPickLabel();
+    void applyRCSCoherent();
+    static float edgeWaveNumber();  // k at kRadarFrequencyHz, radians per scene unit
+    void invalidateRCSResults();  // A trace setting outside the cache key changed
+    void applyGPUMemoryBudget();  // Needs the context current (VRAM detection)
+    void updateProfilerEnabled();
+    void initializeVisibleComponents();
+    bool ensureFBORenderer();
+    void warmUpNextComponent();
+    void dumpTelemetry();
+    void drawProfilerOverlay();
     QPointF projectToScreen(const QVector3D& worldPos, const QMatrix4x4& projection,
                             const QMatrix4x4& view, const QMatrix4x4& model);
 };
\ No newline at end of file
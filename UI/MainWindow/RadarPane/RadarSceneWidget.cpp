@@ -25,6 +25,8 @@ RadarSceneWidget::RadarSceneWidget(QWidget* parent)
         this, &RadarSceneWidget::onAnglesChanged);
     connect(radarGLWidget_, &RadarGLWidget::polarPlotDataReady,
         this, &RadarSceneWidget::polarPlotDataReady);
+    connect(radarGLWidget_, &RadarGLWidget::overlayCutsReady,
+        this, &RadarSceneWidget::overlayCutsReady);
     connect(radarGLWidget_, &RadarGLWidget::popoutRequested,
         this, &RadarSceneWidget::popoutRequested);
 
@@ -209,6 +211,22 @@ bool RadarSceneWidget::isRCSPlaneShowFill() const {
     return radarGLWidget_ ? radarGLWidget_->isRCSPlaneShowFill() : true;
 }
 
+void RadarSceneWidget::setRCSCoherent(bool coherent) {
+    if (radarGLWidget_) {
+        radarGLWidget_->setRCSCoherent(coherent);
+    }
+}
+
+bool RadarSceneWidget::isRCSCoherent() const {
+    return radarGLWidget_ ? radarGLWidget_->isRCSCoherent() : false;
+}
+
+void RadarSceneWidget::setOverlayCuts(const std::vector<CutSpec>& cuts) {
+    if (radarGLWidget_) {
+        radarGLWidget_->setOverlayCuts(cuts);
+    }
+}
+
 // Debug ray visualization forwarding methods
 void RadarSceneWidget::setDebugRayEnabled(bool enabled) {
     if (radarGLWidget_) {
@@ -58,6 +58,9 @@ public:
     float getRCSSliceThickness() const;
     void setRCSPlaneShowFill(bool show);
     bool isRCSPlaneShowFill() const;
+    void setRCSCoherent(bool coherent);
+    bool isRCSCoherent() const;
+    void setOverlayCuts(const std::vector<CutSpec>& cuts);  // Multi-cut mode, see RadarGLWidget
 
     // Debug ray visualization
     void setDebugRayEnabled(bool enabled);
@@ -83,6 +86,7 @@ public:
 signals:
     void radarPositionChanged(float radius, float theta, float phi);
     void polarPlotDataReady(const std::vector<RCSDataPoint>& data);
+    void overlayCutsReady(const std::vector<std::vector<RCSDataPoint>>& curves);
     void beamTypeChanged(BeamType type);
     void beamWidthChanged(float width);
     void visibilityOptionChanged(const QString& option, bool visible);
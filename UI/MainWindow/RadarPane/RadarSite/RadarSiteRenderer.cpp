@@ -1,4 +1,4 @@
-// RadarSiteRenderer.cpp - Renders the radar site dot on the sphere
+// RadarSiteRenderer.cpp - Renders the radar site dots (transmitter and bistatic receivers) on the sphere
 
 #include "RadarSiteRenderer.h"
 #include "Constants.h"
@@ -95,12 +95,12 @@ bool RadarSiteRenderer::initialize() {
     // Create shader program
     shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
         qWarning() << "Failed to compile radar site vertex shader:" << shaderProgram_->log();
         return false;
     }
 
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
         qWarning() << "Failed to compile radar site fragment shader:" << shaderProgram_->log();
         return false;
     }
@@ -197,13 +197,6 @@ void RadarSiteRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& v
         return;
     }
 
-    // Calculate dot position in spherical coordinates
-    QVector3D dotPos = sphericalToCartesian(radius, theta_, phi_);
-
-    // Create model matrix for the dot
-    QMatrix4x4 dotModelMatrix = model;
-    dotModelMatrix.translate(dotPos);
-
     // 1. First pass: Draw opaque front-facing parts
     glDisable(GL_BLEND);
     glEnable(GL_DEPTH_TEST);
@@ -213,8 +206,6 @@ void RadarSiteRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& v
     shaderProgram_->bind();
     shaderProgram_->setUniformValue("projection", projection);
     shaderProgram_->setUniformValue("view", view);
-    shaderProgram_->setUniformValue("model", dotModelMatrix);
-    shaderProgram_->setUniformValue("color", color_);
     shaderProgram_->setUniformValue("lightPos", QVector3D(Lighting::kLightPosition[0],
                                                           Lighting::kLightPosition[1],
                                                           Lighting::kLightPosition[2]));
@@ -225,7 +216,7 @@ void RadarSiteRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& v
     // Only draw front-facing polygons
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices_.size() / 6));
+    drawDots(model, radius);
     glDisable(GL_CULL_FACE);
 
     vao_.release();
@@ -241,7 +232,7 @@ void RadarSiteRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& v
 
     // Draw behind other objects
     glDepthFunc(GL_GREATER);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices_.size() / 6));
+    drawDots(model, radius);
 
     // Restore defaults
     glDepthFunc(GL_LESS);
@@ -251,6 +242,22 @@ void RadarSiteRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& v
     shaderProgram_->release();
 }
 
+void RadarSiteRenderer::drawDots(const QMatrix4x4& model, float radius) {
+    // Transmitter first, then each receiver, all from the one dot mesh
+    const GLsizei vertexCount = static_cast<GLsizei>(vertices_.size() / 6);
+    auto drawAt = [&](float theta, float phi, const QVector3D& color) {
+        QMatrix4x4 dotModelMatrix = model;
+        dotModelMatrix.translate(sphericalToCartesian(radius, theta, phi));
+        shaderProgram_->setUniformValue("model", dotModelMatrix);
+        shaderProgram_->setUniformValue("color", color);
+        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    };
+    drawAt(theta_, phi_, color_);
+    for (const RadarSite& receiver : receivers_) {
+        drawAt(receiver.theta, receiver.phi, receiverColor_);
+    }
+}
+
 void RadarSiteRenderer::setPosition(float theta, float phi) {
     theta_ = theta;
     phi_ = phi;
@@ -260,10 +267,18 @@ QVector3D RadarSiteRenderer::getCartesianPosition(float radius) const {
     return sphericalToCartesian(radius, theta_, phi_);
 }
 
+void RadarSiteRenderer::setReceivers(const std::vector<RadarSite>& receivers) {
+    receivers_ = receivers;
+}
+
 void RadarSiteRenderer::setColor(const QVector3D& color) {
     color_ = color;
 }
 
+void RadarSiteRenderer::setReceiverColor(const QVector3D& color) {
+    receiverColor_ = color;
+}
+
 QVector3D RadarSiteRenderer::sphericalToCartesian(float r, float thetaDeg, float phiDeg) const {
     float theta = thetaDeg * kDegToRadF;
     float phi = phiDeg * kDegToRadF;
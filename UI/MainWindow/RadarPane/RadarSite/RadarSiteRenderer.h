@@ -1,4 +1,4 @@
-// RadarSiteRenderer.h - Renders the radar site dot on the sphere
+// RadarSiteRenderer.h - Renders the radar site dots (transmitter and bistatic receivers) on the sphere
 #pragma once
 
 #include <QOpenGLFunctions_4_5_Core>
@@ -11,6 +11,12 @@
 #include <memory>
 #include <string_view>
 
+// A site on the sphere in spherical coordinates (degrees)
+struct RadarSite {
+    float theta = 0.0f;  // Longitude
+    float phi = 0.0f;    // Latitude
+};
+
 class RadarSiteRenderer : protected QOpenGLFunctions_4_5_Core {
 public:
     RadarSiteRenderer();
@@ -30,9 +36,15 @@ public:
     float getPhi() const { return phi_; }
     QVector3D getCartesianPosition(float radius) const;
 
+    // Bistatic receiver sites, drawn alongside the transmitter in their own colour
+    void setReceivers(const std::vector<RadarSite>& receivers);
+    const std::vector<RadarSite>& getReceivers() const { return receivers_; }
+
     // Appearance
     void setColor(const QVector3D& color);
     const QVector3D& getColor() const { return color_; }
+    void setReceiverColor(const QVector3D& color);
+    const QVector3D& getReceiverColor() const { return receiverColor_; }
 
 private:
     bool initialized_ = false;
@@ -46,9 +58,11 @@ private:
     // Position (spherical coordinates)
     float theta_ = 45.0f;  // Longitude in degrees
     float phi_ = 45.0f;    // Latitude in degrees
+    std::vector<RadarSite> receivers_;
 
     // Appearance
     QVector3D color_{1.0f, 0.0f, 0.0f};  // Red default
+    QVector3D receiverColor_{0.2f, 0.6f, 1.0f};  // Blue default
 
     // Shader sources
     std::string_view vertexShaderSource_;
@@ -56,5 +70,6 @@ private:
 
     // Helper methods
     void createDotGeometry();
+    void drawDots(const QMatrix4x4& model, float radius);
     QVector3D sphericalToCartesian(float r, float thetaDeg, float phiDeg) const;
 };
@@ -1,6 +1,7 @@
 // SlicingPlaneRenderer.cpp - Visualizes the RCS slicing plane in 3D scene
 #include "SlicingPlaneRenderer.h"
 #include "Constants.h"
+#include "TransparencyPass.h"
 #include <cmath>
 #include <QDebug>
 
@@ -42,14 +43,6 @@ void SlicingPlaneRenderer::cleanup() {
         glDeleteBuffers(1, &vbo_);
         vbo_ = 0;
     }
-    if (outlineVao_ != 0) {
-        glDeleteVertexArrays(1, &outlineVao_);
-        outlineVao_ = 0;
-    }
-    if (outlineVbo_ != 0) {
-        glDeleteBuffers(1, &outlineVbo_);
-        outlineVbo_ = 0;
-    }
     shaderProgram_.reset();
     initialized_ = false;
 }
@@ -71,21 +64,20 @@ void SlicingPlaneRenderer::createShaders() {
 
     const char* fragmentShaderSource = R"(
         #version 450 core
-        out vec4 FragColor;
-
         uniform vec4 planeColor;
 
         void main() {
-            FragColor = planeColor;
+            writeTransparent(planeColor);
         }
     )";
 
     shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource)) {
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource)) {
         qWarning() << "SlicingPlaneRenderer: Failed to compile vertex shader:" << shaderProgram_->log();
         return;
     }
-    if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource)) {
+    const std::string fragmentSource = TransparencyPass::fragmentShader(fragmentShaderSource);
+    if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentSource.c_str())) {
         qWarning() << "SlicingPlaneRenderer: Failed to compile fragment shader:" << shaderProgram_->log();
         return;
     }
@@ -109,19 +101,6 @@ void SlicingPlaneRenderer::createGeometry() {
 
     glBindVertexArray(0);
 
-    // Outline geometry for thickness boundaries
-    glGenVertexArrays(1, &outlineVao_);
-    glGenBuffers(1, &outlineVbo_);
-
-    glBindVertexArray(outlineVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, outlineVbo_);
-
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindVertexArray(0);
-
     geometryDirty_ = true;
 }
 
@@ -371,16 +350,33 @@ void SlicingPlaneRenderer::updateGeometry() {
     }
 
     vertexCount_ = static_cast<int>(vertices_.size() / 3);
-    outlineVertexCount_ = static_cast<int>(outlineVertices.size() / 3);
+
+    // Outline endpoint pairs for the line batcher: the azimuth circles are
+    // strips, the elevation arcs keep their GL_LINES vertex pairing
+    outlineSegments_.clear();
+    int outlineVertexCount = static_cast<int>(outlineVertices.size() / 3);
+    auto outlinePoint = [&outlineVertices](int i) {
+        return QVector3D(outlineVertices[i * 3], outlineVertices[i * 3 + 1], outlineVertices[i * 3 + 2]);
+    };
+    if (cutType_ == CutType::Azimuth) {
+        int pointsPerCircle = outlineVertexCount / 2;
+        for (int circle = 0; circle < 2; ++circle) {
+            int first = circle * pointsPerCircle;
+            for (int i = first; i + 1 < first + pointsPerCircle; ++i) {
+                outlineSegments_.push_back(outlinePoint(i));
+                outlineSegments_.push_back(outlinePoint(i + 1));
+            }
+        }
+    } else {
+        for (int i = 0; i + 1 < outlineVertexCount; i += 2) {
+            outlineSegments_.push_back(outlinePoint(i));
+            outlineSegments_.push_back(outlinePoint(i + 1));
+        }
+    }
 
     // Upload plane geometry to GPU
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(float), vertices_.data(), GL_DYNAMIC_DRAW);
-
-    // Upload outline geometry to GPU
-    glBindBuffer(GL_ARRAY_BUFFER, outlineVbo_);
-    glBufferData(GL_ARRAY_BUFFER, outlineVertices.size() * sizeof(float), outlineVertices.data(), GL_DYNAMIC_DRAW);
-
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     geometryDirty_ = false;
@@ -428,13 +424,7 @@ void SlicingPlaneRenderer::render(const QMatrix4x4& projection, const QMatrix4x4
         return;
     }
 
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Disable depth write but keep depth test
-    glDepthMask(GL_FALSE);
-
+    // Blending and depth writes belong to the enclosing TransparencyPass.
     // Disable face culling to see both sides
     glDisable(GL_CULL_FACE);
 
@@ -454,34 +444,23 @@ void SlicingPlaneRenderer::render(const QMatrix4x4& projection, const QMatrix4x4
         glBindVertexArray(0);
     }
 
-    // Draw thickness boundary outlines (always visible)
-    if (outlineVertexCount_ > 0) {
-        // Black opaque lines for the boundaries
-        QVector4D outlineColor(0.0f, 0.0f, 0.0f, 1.0f);
-        shaderProgram_->setUniformValue("planeColor", outlineColor);
-
-        // Set line width for visibility
-        glLineWidth(2.0f);
-
-        glBindVertexArray(outlineVao_);
-
-        if (cutType_ == CutType::Azimuth) {
-            // Two circles: draw each as LINE_STRIP
-            int segmentsPerCircle = (outlineVertexCount_ / 2);
-            glDrawArrays(GL_LINE_STRIP, 0, segmentsPerCircle);
-            glDrawArrays(GL_LINE_STRIP, segmentsPerCircle, segmentsPerCircle);
-        } else {
-            // Four vertical lines: draw as GL_LINES (pairs of vertices)
-            glDrawArrays(GL_LINES, 0, outlineVertexCount_);
-        }
+    shaderProgram_->release();
+}
 
-        glBindVertexArray(0);
-        glLineWidth(1.0f);
+void SlicingPlaneRenderer::submitOutline(LineBatcher& batch, const QMatrix4x4& model) {
+    if (!initialized_ || !visible_) {
+        return;
     }
 
-    shaderProgram_->release();
+    if (geometryDirty_) {
+        updateGeometry();
+    }
 
-    // Restore state
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+    // Black opaque lines for the thickness boundaries (always visible)
+    const QVector3D outlineColor(0.0f, 0.0f, 0.0f);
+    const float outlineWidth = 2.0f;  // Pixels
+    for (size_t i = 0; i + 1 < outlineSegments_.size(); i += 2) {
+        batch.addLine(model.map(outlineSegments_[i]), model.map(outlineSegments_[i + 1]),
+                      outlineColor, outlineWidth);
+    }
 }
@@ -6,7 +6,9 @@
 #include <QMatrix4x4>
 #include <QVector3D>
 #include <memory>
+#include <vector>
 #include "RCSSampler.h"  // For CutType enum
+#include "LineBatcher.h"
 
 class SlicingPlaneRenderer : protected QOpenGLFunctions_4_5_Core {
 public:
@@ -14,6 +16,7 @@ public:
     ~SlicingPlaneRenderer();
 
     bool initialize();
+    bool isInitialized() const { return initialized_; }
     void cleanup();
 
     // Configure the plane
@@ -30,9 +33,12 @@ public:
     void setShowFill(bool show) { showFill_ = show; }
     bool isShowFill() const { return showFill_; }
 
-    // Render the translucent plane
+    // Render the translucent plane, between TransparencyPass::begin() and end()
     void render(const QMatrix4x4& projection, const QMatrix4x4& view, const QMatrix4x4& model);
 
+    // Queue the thickness boundary outlines (drawn with the other overlay lines)
+    void submitOutline(LineBatcher& batch, const QMatrix4x4& model);
+
 private:
     void createShaders();
     void createGeometry();
@@ -42,11 +48,6 @@ private:
     GLuint vao_ = 0;
     GLuint vbo_ = 0;
 
-    // OpenGL resources - thickness outline lines
-    GLuint outlineVao_ = 0;
-    GLuint outlineVbo_ = 0;
-    int outlineVertexCount_ = 0;
-
     std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
     bool initialized_ = false;
     bool geometryDirty_ = true;
@@ -64,4 +65,5 @@ private:
     // Geometry data
     std::vector<float> vertices_;
     int vertexCount_ = 0;
+    std::vector<QVector3D> outlineSegments_;  // Line endpoint pairs, model space
 };
@@ -1,8 +1,10 @@
 #include "SphereRenderer.h"
 #include "GLUtils.h"
 #include "Constants.h"
+#include "FrameClock.h"
 #include <QtMath>
-#include <qtimer.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace RS::Constants;
 
@@ -16,10 +18,8 @@ SphereRenderer::SphereRenderer(QObject* parent)
 	// Initialize OpenGL buffer types
 	sphereVBO_(QOpenGLBuffer::VertexBuffer),
 	sphereEBO_(QOpenGLBuffer::IndexBuffer),
-	linesVBO_(QOpenGLBuffer::VertexBuffer),
 	axesVBO_(QOpenGLBuffer::VertexBuffer),
 	// Initialize inertia-related members
-	inertiaTimer_(new QTimer(this)),
 	rotationAxis_(0, 1, 0),
 	rotationVelocity_(0.0f),
 	rotationDecay_(0.95f),
@@ -100,8 +100,69 @@ SphereRenderer::SphereRenderer(QObject* parent)
         }
     )";
 
-	// Connect inertia timer to update slot
-	connect(inertiaTimer_, &QTimer::timeout, this, &SphereRenderer::updateInertia);
+	// Latitude/longitude grid, generated from gl_VertexID/gl_InstanceID (no
+	// vertex buffer). Each instance is one line drawn as GL_LINES segments; the
+	// lines match the old CPU-built grid (latitudes -75..75 and longitudes
+	// 0..345, every 15 degrees) on a unit sphere scaled by the model matrix.
+	gridVertexShaderSource_ = R"(
+		#version 330 core
+		uniform mat4 model;
+		uniform mat4 view;
+		uniform mat4 projection;
+		uniform vec3 color;
+		uniform vec3 meridianColor;
+		uniform int specialPass;      // 0: every line but the equator and prime meridian; 1: just those two
+		uniform int latSegments;
+		uniform int longSegments;
+		uniform float gridRadius;
+
+		out vec3 FragColor;
+		out vec3 Normal;
+		out vec3 FragPos;
+
+		const int kLatitudeLines = 11;
+		const int kEquatorLine = 5;
+		const int kMeridianLine = kLatitudeLines;  // First longitude line (0 degrees)
+		const float kPi = 3.14159265;
+
+		void main() {
+			int line;
+			if (specialPass != 0) {
+				line = (gl_InstanceID == 0) ? kEquatorLine : kMeridianLine;
+			} else {
+				line = gl_InstanceID;
+				if (line >= kEquatorLine) line++;
+				if (line >= kMeridianLine) line++;
+			}
+
+			FragColor = (specialPass != 0 && gl_InstanceID == 1) ? meridianColor : color;
+			Normal = vec3(0.0);  // Lines are unlit apart from the ambient term
+
+			bool latitude = line < kLatitudeLines;
+			int segments = latitude ? latSegments : longSegments;
+			int segment = gl_VertexID / 2;
+			if (segment >= segments) {
+				// Padding of the shorter lines - outside the clip volume
+				FragPos = vec3(0.0);
+				gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+				return;
+			}
+
+			float t = float(segment + (gl_VertexID & 1)) / float(segments);
+			float phi, theta;
+			if (latitude) {
+				phi = radians(-75.0 + 15.0 * float(line));
+				theta = 2.0 * kPi * t;
+			} else {
+				phi = kPi * t - kPi / 2.0;
+				theta = radians(15.0 * float(line - kLatitudeLines));
+			}
+			vec3 p = gridRadius * vec3(cos(phi) * cos(theta), cos(phi) * sin(theta), sin(phi));
+
+			FragPos = vec3(model * vec4(p, 1.0));
+			gl_Position = projection * view * model * vec4(p, 1.0);
+		}
+	)";
 
 	// Start frame timer
 	frameTimer_.start();
@@ -121,6 +182,7 @@ void SphereRenderer::cleanup() {
 		// Still clean up shader programs (safe without context)
 		shaderProgram_.reset();
 		axesShaderProgram_.reset();
+		gridShaderProgram_.reset();
 		return;
 	}
 
@@ -139,9 +201,6 @@ void SphereRenderer::cleanup() {
 	if (linesVAO_.isCreated()) {
 		linesVAO_.destroy();
 	}
-	if (linesVBO_.isCreated()) {
-		linesVBO_.destroy();
-	}
 
 	// Clean up axes resources
 	if (axesVAO_.isCreated()) {
@@ -154,15 +213,14 @@ void SphereRenderer::cleanup() {
 	// Clean up shader programs
 	shaderProgram_.reset();
 	axesShaderProgram_.reset();
+	gridShaderProgram_.reset();
 
 	initialized_ = false;
 }
 
 SphereRenderer::~SphereRenderer() {
-	// Clean up inertia timer (parented to this, but stop it first)
-	if (inertiaTimer_) {
-		inertiaTimer_->stop();
-	}
+	// The clock must not step a renderer that is gone
+	stopInertia();
 	// OpenGL resources should already be cleaned up via cleanup() called from
 	// RadarGLWidget::cleanupGL() before context destruction.
 	// Note: shader pointers should be nullptr at this point
@@ -190,7 +248,7 @@ bool SphereRenderer::initialize() {
 	// Check for errors after shader init
 	GLUtils::checkGLError("SphereRenderer::initialize after shaders");
 
-	// Create geometry
+	// Create unit-radius geometry once; the radius is a model scale
 	createSphere();
 	createGridLines();
 	createAxesLines();
@@ -204,18 +262,19 @@ bool SphereRenderer::initializeShaders() {
 	// Clean up existing shader programs to prevent memory leaks
 	shaderProgram_.reset();
 	axesShaderProgram_.reset();
+	gridShaderProgram_.reset();
 
 	// Create main shader program
 	shaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
 	// Load and compile vertex shader
-	if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
+	if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource_.data())) {
 		qWarning() << "Failed to compile vertex shader:" << shaderProgram_->log();
 		return false;
 	}
 
 	// Load and compile fragment shader
-	if (!shaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+	if (!shaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
 		qWarning() << "Failed to compile fragment shader:" << shaderProgram_->log();
 		return false;
 	}
@@ -230,13 +289,13 @@ bool SphereRenderer::initializeShaders() {
 	axesShaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
 
 	// Load and compile axes vertex shader
-	if (!axesShaderProgram_->addShaderFromSourceCode(QOpenGLShader::Vertex, axesVertexShaderSource_.data())) {
+	if (!axesShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, axesVertexShaderSource_.data())) {
 		qWarning() << "Failed to compile axes vertex shader:" << axesShaderProgram_->log();
 		return false;
 	}
 
 	// Load and compile axes fragment shader
-	if (!axesShaderProgram_->addShaderFromSourceCode(QOpenGLShader::Fragment, axesFragmentShaderSource_.data())) {
+	if (!axesShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, axesFragmentShaderSource_.data())) {
 		qWarning() << "Failed to compile axes fragment shader:" << axesShaderProgram_->log();
 		return false;
 	}
@@ -247,6 +306,24 @@ bool SphereRenderer::initializeShaders() {
 		return false;
 	}
 
+	// Create grid shader program (procedural vertices, main fragment shader)
+	gridShaderProgram_ = std::make_unique<QOpenGLShaderProgram>();
+
+	if (!gridShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, gridVertexShaderSource_.data())) {
+		qWarning() << "Failed to compile grid vertex shader:" << gridShaderProgram_->log();
+		return false;
+	}
+
+	if (!gridShaderProgram_->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShaderSource_.data())) {
+		qWarning() << "Failed to compile grid fragment shader:" << gridShaderProgram_->log();
+		return false;
+	}
+
+	if (!gridShaderProgram_->link()) {
+		qWarning() << "Failed to link grid shader program:" << gridShaderProgram_->log();
+		return false;
+	}
+
 	return true;
 }
 
@@ -257,10 +334,14 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 	// Apply our stored rotation to the model matrix
 	localModel.rotate(rotation_);
 
+	// Sphere, grid and axes are unit-radius meshes scaled here
+	QMatrix4x4 scaledModel = localModel;
+	scaledModel.scale(radius_);
+
 #ifdef QT_DEBUG
 	// Single shader validation check
-	if (!shaderProgram_ || !axesShaderProgram_ ||
-		!shaderProgram_->isLinked() || !axesShaderProgram_->isLinked()) {
+	if (!shaderProgram_ || !axesShaderProgram_ || !gridShaderProgram_ ||
+		!shaderProgram_->isLinked() || !axesShaderProgram_->isLinked() || !gridShaderProgram_->isLinked()) {
 		qCritical() << "ERROR: render called with invalid shaders";
 	}
 #endif
@@ -289,7 +370,7 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 			// Set common uniforms only when binding
 			shaderProgram_->setUniformValue("projection", projection);
 			shaderProgram_->setUniformValue("view", view);
-			shaderProgram_->setUniformValue("model", localModel);  // Use the rotated model
+			shaderProgram_->setUniformValue("model", scaledModel);  // Use the rotated, scaled model
 		}
 
 		// Set sphere-specific uniforms
@@ -309,12 +390,12 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 		glEnable(GL_CULL_FACE);
 		glCullFace(GL_FRONT);  // Cull front faces, draw back faces
 		shaderProgram_->setUniformValue("opacity", 0.20f);
-		glDrawElements(GL_TRIANGLES, sphereIndices_.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, sphereIndexCount_, GL_UNSIGNED_INT, 0);
 
 		// Pass 2: Draw front faces (lighter, less transparent)
 		glCullFace(GL_BACK);  // Cull back faces, draw front faces
 		shaderProgram_->setUniformValue("opacity", 0.35f);
-		glDrawElements(GL_TRIANGLES, sphereIndices_.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, sphereIndexCount_, GL_UNSIGNED_INT, 0);
 
 		glDisable(GL_POLYGON_OFFSET_FILL);
 		sphereVAO_.release();
@@ -324,27 +405,29 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 		glDisable(GL_BLEND);
 	}
 
-	// 2. Draw grid lines if visible
+	// 2. Draw grid lines if visible - one instanced draw for the regular lines
+	// and one for the equator and prime meridian (wider, colored)
 	if (showGridLines_) {
 		// Release any currently bound shader that's not the one we need
-		if (currentShader && currentShader != shaderProgram_.get()) {
+		if (currentShader && currentShader != gridShaderProgram_.get()) {
 			currentShader->release();
 			currentShader = nullptr;
 		}
 
 		// Bind shader if not already bound
-		if (currentShader != shaderProgram_.get()) {
-			shaderProgram_->bind();
-			currentShader = shaderProgram_.get();
-
-			// Set common uniforms only when binding
-			shaderProgram_->setUniformValue("projection", projection);
-			shaderProgram_->setUniformValue("view", view);
-			shaderProgram_->setUniformValue("model", localModel);  // Use the rotated model
+		if (currentShader != gridShaderProgram_.get()) {
+			gridShaderProgram_->bind();
+			currentShader = gridShaderProgram_.get();
 		}
 
-		// Always update light position for grid lines
-		shaderProgram_->setUniformValue("lightPos", QVector3D(Lighting::kLightPosition[0], Lighting::kLightPosition[1], Lighting::kLightPosition[2]));
+		gridShaderProgram_->setUniformValue("projection", projection);
+		gridShaderProgram_->setUniformValue("view", view);
+		gridShaderProgram_->setUniformValue("model", scaledModel);
+		gridShaderProgram_->setUniformValue("lightPos", QVector3D(Lighting::kLightPosition[0], Lighting::kLightPosition[1], Lighting::kLightPosition[2]));
+		gridShaderProgram_->setUniformValue("opacity", 1.0f);
+		gridShaderProgram_->setUniformValue("latSegments", kSphereLatSegments);
+		gridShaderProgram_->setUniformValue("longSegments", kSphereLongSegments);
+		gridShaderProgram_->setUniformValue("gridRadius", kGridRadiusOffset);
 
 		linesVAO_.bind();
 
@@ -355,39 +438,21 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 		// Use LEQUAL depth function to prevent z-fighting with the sphere
 		glDepthFunc(GL_LEQUAL);
 
-		// Regular latitude lines
-		glLineWidth(kGridLineWidthNormal);
-		shaderProgram_->setUniformValue("color", QVector3D(Colors::kGridLineGrey[0], Colors::kGridLineGrey[1], Colors::kGridLineGrey[2]));
-
-		// Draw latitude lines
-		for (int lat = 0; lat < latitudeLineCount_; lat++) {
-			int startIdx = lat * (kSphereLatSegments + 1);
-			if (startIdx == equatorStartIndex_) {
-				continue; // Skip equator, drawn separately
-			}
-			glDrawArrays(GL_LINE_STRIP, startIdx, kSphereLatSegments + 1);
-		}
+		// Every line emits the longer segment count; shorter ones clip the rest
+		const int gridVertexCount = 2 * std::max(kSphereLatSegments, kSphereLongSegments);
 
-		// Draw longitude lines
-		int longitudeStartOffset = latitudeLineCount_ * (kSphereLatSegments + 1);
-		for (int lon = 0; lon < longitudeLineCount_; lon++) {
-			int startIdx = longitudeStartOffset + lon * (kSphereLongSegments + 1);
-			if (startIdx == primeMeridianStartIndex_) {
-				continue; // Skip prime meridian, drawn separately
-			}
-			glDrawArrays(GL_LINE_STRIP, startIdx, kSphereLongSegments + 1);
-		}
+		// Regular latitude and longitude lines
+		glLineWidth(kGridLineWidthNormal);
+		gridShaderProgram_->setUniformValue("specialPass", 0);
+		gridShaderProgram_->setUniformValue("color", QVector3D(Colors::kGridLineGrey[0], Colors::kGridLineGrey[1], Colors::kGridLineGrey[2]));
+		glDrawArraysInstanced(GL_LINES, 0, gridVertexCount, kGridLatitudeLines + kGridLongitudeLines - 2);
 
-		// Special lines (equator and prime meridian)
+		// Special lines: equator (green) and prime meridian
 		glLineWidth(kGridLineWidthSpecial);
-
-		// Equator (green)
-		shaderProgram_->setUniformValue("color", QVector3D(Colors::kEquatorGreen[0], Colors::kEquatorGreen[1], Colors::kEquatorGreen[2]));
-		glDrawArrays(GL_LINE_STRIP, equatorStartIndex_, kSphereLatSegments + 1);
-
-		// Prime Meridian (blue)
-		shaderProgram_->setUniformValue("color", QVector3D(Colors::kPrimeMeridianRed[0], Colors::kPrimeMeridianRed[1], Colors::kPrimeMeridianRed[2]));
-		glDrawArrays(GL_LINE_STRIP, primeMeridianStartIndex_, kSphereLongSegments + 1);
+		gridShaderProgram_->setUniformValue("specialPass", 1);
+		gridShaderProgram_->setUniformValue("color", QVector3D(Colors::kEquatorGreen[0], Colors::kEquatorGreen[1], Colors::kEquatorGreen[2]));
+		gridShaderProgram_->setUniformValue("meridianColor", QVector3D(Colors::kPrimeMeridianRed[0], Colors::kPrimeMeridianRed[1], Colors::kPrimeMeridianRed[2]));
+		glDrawArraysInstanced(GL_LINES, 0, gridVertexCount, 2);
 
 		// Restore default depth function
 		glDepthFunc(GL_LESS);
@@ -411,7 +476,7 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 
 		axesShaderProgram_->setUniformValue("projection", projection);
 		axesShaderProgram_->setUniformValue("view", view);
-		axesShaderProgram_->setUniformValue("model", localModel);  // Use the rotated model
+		axesShaderProgram_->setUniformValue("model", scaledModel);  // Use the rotated, scaled model
 
 		axesVAO_.bind();
 
@@ -456,15 +521,7 @@ void SphereRenderer::render(const QMatrix4x4& projection, const QMatrix4x4& view
 
 void SphereRenderer::setRadius(float radius) {
 	if (radius_ != radius) {
-		radius_ = radius;
-
-		// Only regenerate if already initialized
-		if (initialized_) {
-			// Regenerate geometry
-			createSphere();
-			createGridLines();
-			createAxesLines();
-		}
+		radius_ = radius;  // Applied as a model scale in render() - no geometry work
 
 		emit radiusChanged(radius);
 	}
@@ -486,9 +543,10 @@ void SphereRenderer::createAxesLines() {
 	// Create a local vector to collect all vertices
 	std::vector<float> vertices;
 
-	float axisLength = radius_ * View::kAxisLengthMultiplier;   // Make axes slightly longer than radius
-	float arrowLength = radius_ * 0.06f; // Length of the conical arrowhead
-	float arrowRadius = radius_ * 0.02f; // Radius of the conical arrowhead base
+	// Unit sphere - render() scales by the radius
+	float axisLength = View::kAxisLengthMultiplier;   // Make axes slightly longer than radius
+	float arrowLength = 0.06f; // Length of the conical arrowhead
+	float arrowRadius = 0.02f; // Radius of the conical arrowhead base
 	int segments = kAxisArrowSegments;   // Number of segments for the cone
 
 	// First, create the axis lines
@@ -626,9 +684,6 @@ void SphereRenderer::createAxesLines() {
 	createCone(yTip, QVector3D(0.0f, 1.0f, 0.0f), yBasePoints);
 	createCone(zTip, QVector3D(0.0f, 0.0f, 1.0f), zBasePoints);
 
-	// Now copy the local vertices to the member variable
-	axesVertices_ = vertices;
-
 	// Set up VAO and VBO for axes
 	if (!axesVAO_.isCreated()) {
 		axesVAO_.create();
@@ -639,7 +694,7 @@ void SphereRenderer::createAxesLines() {
 		axesVBO_.create();
 	}
 	axesVBO_.bind();
-	axesVBO_.allocate(axesVertices_.data(), axesVertices_.size() * sizeof(float));
+	axesVBO_.allocate(vertices.data(), static_cast<int>(vertices.size() * sizeof(float)));
 
 	// Position attribute
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -659,9 +714,8 @@ void SphereRenderer::setAxesVisible(bool visible) {
 }
 
 void SphereRenderer::createSphere(int latDivisions, int longDivisions) {
-	// Clear previous data
-	sphereVertices_.clear();
-	sphereIndices_.clear();
+	std::vector<float> sphereVertices;
+	std::vector<unsigned int> sphereIndices;
 
 	// Generate vertices
 	for (int lat = 0; lat <= latDivisions; lat++) {
@@ -674,10 +728,10 @@ void SphereRenderer::createSphere(int latDivisions, int longDivisions) {
 			float sinTheta = sin(theta);
 			float cosTheta = cos(theta);
 
-			// Position (Z-up convention)
-			float x = radius_ * sinPhi * cosTheta;
-			float y = radius_ * sinPhi * sinTheta;  // Y is now horizontal
-			float z = radius_ * cosPhi;             // Z is now vertical
+			// Position on the unit sphere (Z-up convention)
+			float x = sinPhi * cosTheta;
+			float y = sinPhi * sinTheta;  // Y is now horizontal
+			float z = cosPhi;             // Z is now vertical
 
 			// Normal (normalized position for a sphere)
 			float nx = sinPhi * cosTheta;
@@ -685,12 +739,12 @@ void SphereRenderer::createSphere(int latDivisions, int longDivisions) {
 			float nz = cosPhi;             // Z is now vertical
 
 			// Add vertex data
-			sphereVertices_.push_back(x);
-			sphereVertices_.push_back(y);
-			sphereVertices_.push_back(z);
-			sphereVertices_.push_back(nx);
-			sphereVertices_.push_back(ny);
-			sphereVertices_.push_back(nz);
+			sphereVertices.push_back(x);
+			sphereVertices.push_back(y);
+			sphereVertices.push_back(z);
+			sphereVertices.push_back(nx);
+			sphereVertices.push_back(ny);
+			sphereVertices.push_back(nz);
 		}
 	}
 
@@ -701,14 +755,14 @@ void SphereRenderer::createSphere(int latDivisions, int longDivisions) {
 			int second = first + longDivisions + 1;
 
 			// First triangle
-			sphereIndices_.push_back(first);
-			sphereIndices_.push_back(second);
-			sphereIndices_.push_back(first + 1);
+			sphereIndices.push_back(first);
+			sphereIndices.push_back(second);
+			sphereIndices.push_back(first + 1);
 
 			// Second triangle
-			sphereIndices_.push_back(second);
-			sphereIndices_.push_back(second + 1);
-			sphereIndices_.push_back(first + 1);
+			sphereIndices.push_back(second);
+			sphereIndices.push_back(second + 1);
+			sphereIndices.push_back(first + 1);
 		}
 	}
 
@@ -722,13 +776,14 @@ void SphereRenderer::createSphere(int latDivisions, int longDivisions) {
 		sphereVBO_.create();
 	}
 	sphereVBO_.bind();
-	sphereVBO_.allocate(sphereVertices_.data(), sphereVertices_.size() * sizeof(float));
+	sphereVBO_.allocate(sphereVertices.data(), static_cast<int>(sphereVertices.size() * sizeof(float)));
 
 	if (!sphereEBO_.isCreated()) {
 		sphereEBO_.create();
 	}
 	sphereEBO_.bind();
-	sphereEBO_.allocate(sphereIndices_.data(), sphereIndices_.size() * sizeof(unsigned int));
+	sphereEBO_.allocate(sphereIndices.data(), static_cast<int>(sphereIndices.size() * sizeof(unsigned int)));
+	sphereIndexCount_ = static_cast<int>(sphereIndices.size());
 
 
 	// Position attribute
@@ -743,104 +798,11 @@ void SphereRenderer::createSphere(int latDivisions, int longDivisions) {
 }
 
 void SphereRenderer::createGridLines() {
-	// Similar to before, but with a small offset to the grid lines
-	latLongLines_.clear();
-
-	// Constants for grid generation
-	const float degToRad = kDegToRadF;
-	const int latitudeSegments = kSphereLatSegments;  // Higher number for smoother circles
-	const int longitudeSegments = kSphereLongSegments; // Higher number for smoother arcs
-
-	// Add a small radius offset to ensure grid lines render above the sphere surface
-	const float gridRadiusOffset = radius_ * kGridRadiusOffset;
-
-	// Track our progress in the vertex array
-	int vertexOffset = 0;
-
-	// -------------------- LATITUDE LINES --------------------
-	// Reset counter for debugging
-	latitudeLineCount_ = 0;
-
-	// Generate latitude lines one by one
-	for (int phiDeg = -75; phiDeg <= 75; phiDeg += 15) {
-		// Increment counter
-		latitudeLineCount_++;
-
-		// Mark equator for special rendering
-		if (phiDeg == 0) {
-			equatorStartIndex_ = vertexOffset / 3;
-		}
-
-		float phi = phiDeg * degToRad;
-		float z = gridRadiusOffset * sin(phi);  // Z is now vertical
-		float rLat = gridRadiusOffset * cos(phi);  // Use offset radius
-
-		// Create a complete circle for this latitude
-		for (int i = 0; i <= latitudeSegments; i++) {
-			float theta = kTwoPiF * float(i) / float(latitudeSegments);
-			float x = rLat * cos(theta);
-			float y = rLat * sin(theta);  // Y is now horizontal
-
-			// Add vertex
-			latLongLines_.push_back(x);
-			latLongLines_.push_back(y);
-			latLongLines_.push_back(z);
-
-			vertexOffset += 3;
-		}
-	}
-
-	// -------------------- LONGITUDE LINES --------------------
-	// Reset counter for debugging
-	longitudeLineCount_ = 0;
-
-	// Generate longitude lines one by one
-	for (int thetaDeg = 0; thetaDeg <= 345; thetaDeg += 15) {
-		// Increment counter
-		longitudeLineCount_++;
-
-		// Mark prime meridian for special rendering
-		if (thetaDeg == 0) {
-			primeMeridianStartIndex_ = vertexOffset / 3;
-		}
-
-		float theta = thetaDeg * degToRad;
-
-		// Create a line from south pole to north pole
-		for (int i = 0; i <= longitudeSegments; i++) {
-			// Generate points from south pole to north pole
-			float phi = kPiF * float(i) / float(longitudeSegments) - kPiF / 2.0f;
-			float rLat = gridRadiusOffset * cos(phi);  // Use offset radius
-			float z = gridRadiusOffset * sin(phi);  // Z is now vertical
-			float x = rLat * cos(theta);
-			float y = rLat * sin(theta);  // Y is now horizontal
-
-			// Add vertex
-			latLongLines_.push_back(x);
-			latLongLines_.push_back(y);
-			latLongLines_.push_back(z);
-
-			vertexOffset += 3;
-		}
-	}
-
-	// Set up VAO and VBO for lines
+	// The grid shader generates every vertex, but core profile still needs a
+	// VAO bound for the draw
 	if (!linesVAO_.isCreated()) {
 		linesVAO_.create();
 	}
-	linesVAO_.bind();
-
-	if (!linesVBO_.isCreated()) {
-		linesVBO_.create();
-	}
-	linesVBO_.bind();
-	linesVBO_.allocate(latLongLines_.data(), latLongLines_.size() * sizeof(float));
-
-	// Position attribute
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	linesVAO_.release();
 }
 
 void SphereRenderer::startInertia(const QVector3D& axis, float velocity) {
@@ -850,37 +812,37 @@ void SphereRenderer::startInertia(const QVector3D& axis, float velocity) {
 	rotationAxis_ = axis.normalized();
 	rotationVelocity_ = velocity;
 
-	// Start timer if not already running
-	if (!inertiaTimer_->isActive()) {
-		inertiaTimer_->start(kCameraInertiaTimerMs);
+	// Steps with every displayed frame until it comes to rest
+	if (frameClock_ && !frameClock_->isRunning(this)) {
+		frameClock_->start(this, [this](double seconds) { return advanceInertia(seconds); });
 	}
 }
 
 void SphereRenderer::stopInertia() {
-	inertiaTimer_->stop();
+	if (frameClock_) {
+		frameClock_->stop(this);
+	}
 	rotationVelocity_ = 0.0f;
 }
 
-void SphereRenderer::updateInertia() {
-	// Apply rotation based on velocity and time
-	if (rotationVelocity_ > 0.05f) { // Stop when velocity gets very small
-		// Apply rotation based on current velocity
-		QQuaternion inertiaRotation = QQuaternion::fromAxisAndAngle(
-			rotationAxis_, rotationVelocity_);
-
-		// Update the rotation
-		rotation_ = inertiaRotation * rotation_;
+bool SphereRenderer::advanceInertia(double seconds) {
+	// Stop when velocity gets very small
+	if (rotationVelocity_ <= 0.05f) {
+		rotationVelocity_ = 0.0f;
+		return false;
+	}
 
-		// Decay the velocity
-		rotationVelocity_ *= rotationDecay_;
+	// Velocity and decay are per kCameraInertiaStepMs, scaled to the frame's
+	// real length so the spin slows the same at any refresh rate
+	float steps = static_cast<float>(seconds * 1000.0) / kCameraInertiaStepMs;
+	QQuaternion inertiaRotation = QQuaternion::fromAxisAndAngle(
+		rotationAxis_, rotationVelocity_ * steps);
+	rotation_ = inertiaRotation * rotation_;
+	rotationVelocity_ *= std::pow(rotationDecay_, steps);
 
-		// Signal that the view has changed - this will trigger a redraw in the parent
-		emit radiusChanged(radius_); // Reuse existing signal as a view change notification
-	}
-	else {
-		// Stop the timer when velocity is negligible
-		stopInertia();
-	}
+	// The clock repaints; this is only a view change notification
+	emit radiusChanged(radius_);
+	return true;
 }
 
 void SphereRenderer::setInertiaEnabled(bool enabled) {
@@ -14,6 +14,8 @@
 #include <string_view>
 #include <QQuaternion>
 
+namespace RS { class FrameClock; }
+
 class SphereRenderer : public QObject, protected QOpenGLFunctions_4_5_Core {
     Q_OBJECT
 
@@ -44,7 +46,9 @@ public:
     bool areGridLinesVisible() const { return showGridLines_; }
     bool areAxesVisible() const { return showAxes_; }
 
-    // Inertia control
+    // Inertia control. Inertia steps on the widget's frame clock, one step
+    // per displayed frame; without a clock a rotation has no inertia.
+    void setFrameClock(RS::FrameClock* clock) { frameClock_ = clock; }
     void setInertiaEnabled(bool enabled);
     bool isInertiaEnabled() const { return inertiaEnabled_; }
     void setInertiaParameters(float decay, float velocityScale);
@@ -62,27 +66,20 @@ private:
     // OpenGL objects
     std::unique_ptr<QOpenGLShaderProgram> shaderProgram_;
     std::unique_ptr<QOpenGLShaderProgram> axesShaderProgram_;
+    std::unique_ptr<QOpenGLShaderProgram> gridShaderProgram_;
 
-    // Sphere geometry
+    // Sphere geometry (unit radius, static)
     QOpenGLVertexArrayObject sphereVAO_;
     QOpenGLBuffer sphereVBO_;
     QOpenGLBuffer sphereEBO_;
-    std::vector<float> sphereVertices_;
-    std::vector<unsigned int> sphereIndices_;
+    int sphereIndexCount_ = 0;
 
-    // Grid lines geometry
+    // Grid lines - generated in the grid vertex shader, no buffers
     QOpenGLVertexArrayObject linesVAO_;
-    QOpenGLBuffer linesVBO_;
-    std::vector<float> latLongLines_;
-    int equatorStartIndex_ = 0;
-    int primeMeridianStartIndex_ = 0;
-    int latitudeLineCount_ = 0;
-    int longitudeLineCount_ = 0;
-
-    // Axes geometry
+
+    // Axes geometry (unit radius, static)
     QOpenGLVertexArrayObject axesVAO_;
     QOpenGLBuffer axesVBO_;
-    std::vector<float> axesVertices_;
 
     // Properties
     float radius_ = 100.0f;
@@ -95,24 +92,24 @@ private:
     std::string_view fragmentShaderSource_;
     std::string_view axesVertexShaderSource_;
     std::string_view axesFragmentShaderSource_;
+    std::string_view gridVertexShaderSource_;
 
-    // Helper methods
+    // Helper methods - build unit-radius geometry once, in initialize()
     void createSphere(int latDivisions = 64, int longDivisions = 64);
     void createGridLines();
     void createAxesLines();
 
-    // Inertia control
     // Inertia/momentum for rotation
-    QTimer* inertiaTimer_ = nullptr;
+    RS::FrameClock* frameClock_ = nullptr;  // Not owned
     QVector3D rotationAxis_;
-    float rotationVelocity_ = 0.0f;
+    float rotationVelocity_ = 0.0f;  // Degrees per kCameraInertiaStepMs
     float rotationDecay_ = 0.95f;  // Determines how quickly inertia slows down (0.9-0.99)
-    QElapsedTimer frameTimer_;  // Add this line
+    QElapsedTimer frameTimer_;  // Between applyRotation() calls, for the release velocity
     bool inertiaEnabled_ = true;
     QQuaternion rotation_ = QQuaternion(); // Current rotation
 
     // Helper methods for inertia
     void startInertia(const QVector3D& axis, float velocity);
     void stopInertia();
-    void updateInertia();
+    bool advanceInertia(double seconds);  // Frame clock step; false once at rest
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "AppSettings.h"
 #include "PolarRCSPlot.h"
 #include "RCSSampler.h"  // For CutType enum
+#include "RCSDatasetViewer.h"
+#include "RCSTrajectoryPlayer.h"
 #include "Constants.h"
 
 #include <QWidget>
@@ -27,7 +29,11 @@
 #include <QMouseEvent>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QStatusBar>
 #include <QTimer>
+#include <QDebug>
 
 // Constructor
 RadarSim::RadarSim(QWidget* parent)
@@ -150,6 +156,16 @@ void RadarSim::setupMenuBar() {
     // Create menu bar
     QMenuBar* menuBar = this->menuBar();
 
+    // File menu
+    fileMenu_ = menuBar->addMenu("&File");
+
+    // Imported model, shown at the target position
+    loadModelAction_ = new QAction("Load &Model...", this);
+    loadModelAction_->setStatusTip("Import an STL, OBJ or glTF model into the scene, replacing the previous one");
+    loadModelAction_->setShortcut(QKeySequence::Open);
+    connect(loadModelAction_, &QAction::triggered, this, &RadarSim::onLoadModel);
+    fileMenu_->addAction(loadModelAction_);
+
     // View menu
     viewMenu_ = menuBar->addMenu("&View");
 
@@ -164,6 +180,39 @@ void RadarSim::setupMenuBar() {
     showConfigWindowAction_->setStatusTip("Show the configuration window");
     connect(showConfigWindowAction_, &QAction::triggered, this, &RadarSim::onShowConfigurationWindow);
     viewMenu_->addAction(showConfigWindowAction_);
+
+    viewMenu_->addSeparator();
+
+    // Frame profiler overlay (per-stage CPU/GPU timings)
+    profilerOverlayAction_ = new QAction("&Profiler Overlay", this);
+    profilerOverlayAction_->setStatusTip("Show per-stage CPU and GPU frame timings");
+    profilerOverlayAction_->setCheckable(true);
+    profilerOverlayAction_->setShortcut(QKeySequence(Qt::Key_F3));
+    connect(profilerOverlayAction_, &QAction::toggled, this, &RadarSim::onProfilerOverlayToggled);
+    viewMenu_->addAction(profilerOverlayAction_);
+
+    // Rolling profiler log (CSV or JSON lines)
+    profilerLogAction_ = new QAction("Profiler &Log...", this);
+    profilerLogAction_->setStatusTip("Record per-stage frame timings to a CSV or JSON file");
+    profilerLogAction_->setCheckable(true);
+    connect(profilerLogAction_, &QAction::toggled, this, &RadarSim::onProfilerLogToggled);
+    viewMenu_->addAction(profilerLogAction_);
+
+    viewMenu_->addSeparator();
+
+    // Stored sweep cuts, scrubbed with the radar angle controls
+    datasetViewAction_ = new QAction("Sweep &Dataset...", this);
+    datasetViewAction_->setStatusTip("Show the cuts of a .rcsc sweep at the radar angles instead of tracing");
+    datasetViewAction_->setCheckable(true);
+    connect(datasetViewAction_, &QAction::toggled, this, &RadarSim::onDatasetViewToggled);
+    viewMenu_->addAction(datasetViewAction_);
+
+    // Target and radar moved along a recorded timeline
+    trajectoryAction_ = new QAction("Play &Trajectory...", this);
+    trajectoryAction_->setStatusTip("Play a CSV timeline of target poses and radar angles with precomputed RCS");
+    trajectoryAction_->setCheckable(true);
+    connect(trajectoryAction_, &QAction::toggled, this, &RadarSim::onTrajectoryPlaybackToggled);
+    viewMenu_->addAction(trajectoryAction_);
 }
 
 void RadarSim::setupConfigurationWindow() {
@@ -174,6 +223,8 @@ void RadarSim::setupConfigurationWindow() {
     // Connect profile signals
     connect(appSettings_, &RSConfig::AppSettings::profilesChanged,
             this, &RadarSim::onProfilesChanged);
+    connect(appSettings_, &RSConfig::AppSettings::aboutToSaveSession,
+            this, [this]() { readSettingsFromScene(); }, Qt::DirectConnection);
 
     // Populate profile list
     refreshProfileList();
@@ -185,6 +236,12 @@ void RadarSim::connectSignals() {
             this, &RadarSim::onRadarRadiusChanged);
     connect(radarControls_, &RadarControlsWidget::anglesChanged,
             this, &RadarSim::onRadarAnglesChanged);
+    connect(radarControls_, &RadarControlsWidget::receiverChanged,
+            this, &RadarSim::onRadarReceiverChanged);
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        connect(glWidget, &RadarGLWidget::bistaticRCSReady,
+                radarControls_, &RadarControlsWidget::setBistaticRCS);
+    }
 
     // Connect target controls widget
     connect(targetControls_, &TargetControlsWidget::positionChanged,
@@ -193,6 +250,8 @@ void RadarSim::connectSignals() {
             this, &RadarSim::onTargetRotationChanged);
     connect(targetControls_, &TargetControlsWidget::scaleChanged,
             this, &RadarSim::onTargetScaleChanged);
+    connect(targetControls_, &TargetControlsWidget::formationChanged,
+            this, &RadarSim::onTargetFormationChanged);
 
     // Connect RCS plane controls widget
     connect(rcsPlaneControls_, &RCSPlaneControlsWidget::cutTypeChanged,
@@ -203,10 +262,49 @@ void RadarSim::connectSignals() {
             this, &RadarSim::onRCSSliceThicknessChanged);
     connect(rcsPlaneControls_, &RCSPlaneControlsWidget::showFillChanged,
             this, &RadarSim::onRCSPlaneShowFillChanged);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::coherentChanged,
+            this, &RadarSim::onRCSCoherentChanged);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::overlayCutChanged,
+            this, &RadarSim::onRCSOverlayCutChanged);
+
+    // Auto-save the session once the controls have been left alone for a moment
+    using RSConfig::AppSettings;
+    connect(radarControls_, &RadarControlsWidget::radiusChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(radarControls_, &RadarControlsWidget::anglesChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(radarControls_, &RadarControlsWidget::receiverChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(targetControls_, &TargetControlsWidget::positionChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(targetControls_, &TargetControlsWidget::rotationChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(targetControls_, &TargetControlsWidget::scaleChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(targetControls_, &TargetControlsWidget::formationChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::cutTypeChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::planeOffsetChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::sliceThicknessChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::showFillChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::coherentChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(rcsPlaneControls_, &RCSPlaneControlsWidget::overlayCutChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
 
     // Connect polar plot data from radar scene
     connect(radarSceneView_, &RadarSceneWidget::polarPlotDataReady,
             polarRCSPlot_, &PolarRCSPlot::setData);
+    connect(radarSceneView_, &RadarSceneWidget::overlayCutsReady,
+            polarRCSPlot_, &PolarRCSPlot::setOverlayData);
+
+    // Imported model progress and result (File > Load Model)
+    if (ModelManager* models = radarSceneView_->getModelManager()) {
+        connect(models, &ModelManager::modelLoadProgress, this, [this](const QString& filename, int percent) {
+            statusBar()->showMessage(QString("Loading %1... %2%").arg(QFileInfo(filename).fileName()).arg(percent));
+        });
+        connect(models, &ModelManager::modelAdded, this, [this]() {
+            loadModelAction_->setEnabled(true);
+            statusBar()->clearMessage();
+            radarSceneView_->updateScene();
+        });
+        connect(models, &ModelManager::modelLoadFailed, this, [this](const QString& filename, const QString& error) {
+            loadModelAction_->setEnabled(true);
+            statusBar()->clearMessage();
+            QMessageBox::warning(this, "Load Model", "Could not load " + filename + ":\n" + error);
+        });
+    }
 
     // Connect pop-out signals from widgets
     connect(radarSceneView_, &RadarSceneWidget::popoutRequested,
@@ -259,6 +357,32 @@ void RadarSim::connectSignals() {
             this, &RadarSim::onRayTraceModeChanged);
     connect(configWindow_, &ConfigurationWindow::rayCountChanged,
             this, &RadarSim::onRayCountChanged);
+
+    // RCS tracing signals
+    connect(configWindow_, &ConfigurationWindow::temporalReuseChanged,
+            this, &RadarSim::onTemporalReuseChanged);
+    connect(configWindow_, &ConfigurationWindow::temporalReuseChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::decoupledShadowsChanged,
+            this, &RadarSim::onDecoupledShadowsChanged);
+    connect(configWindow_, &ConfigurationWindow::decoupledShadowsChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::resultCachingChanged,
+            this, &RadarSim::onResultCachingChanged);
+    connect(configWindow_, &ConfigurationWindow::resultCachingChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::bouncesChanged,
+            this, &RadarSim::onBouncesChanged);
+    connect(configWindow_, &ConfigurationWindow::bouncesChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::bounceTerminationChanged,
+            this, &RadarSim::onBounceTerminationChanged);
+    connect(configWindow_, &ConfigurationWindow::bounceTerminationChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::frameBudgetChanged,
+            this, &RadarSim::onFrameBudgetChanged);
+    connect(configWindow_, &ConfigurationWindow::frameBudgetChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::targetMaterialChanged,
+            this, &RadarSim::onTargetMaterialChanged);
+    connect(configWindow_, &ConfigurationWindow::targetMaterialChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
+    connect(configWindow_, &ConfigurationWindow::gpuMemoryBudgetChanged,
+            this, &RadarSim::onGPUMemoryBudgetChanged);
+    connect(configWindow_, &ConfigurationWindow::gpuMemoryBudgetChanged, appSettings_, &AppSettings::scheduleLastSessionSave);
 }
 
 // Radar control slots (from RadarControlsWidget)
@@ -270,6 +394,21 @@ void RadarSim::onRadarAnglesChanged(float theta, float phi) {
     radarSceneView_->setAngles(theta, phi);
 }
 
+void RadarSim::onRadarReceiverChanged(bool enabled, float theta, float phi) {
+    auto* glWidget = radarSceneView_->getGLWidget();
+    if (!glWidget) {
+        return;
+    }
+    std::vector<RadarSite> sites;
+    if (enabled) {
+        RadarSite site;
+        site.theta = theta;
+        site.phi = phi;
+        sites.push_back(site);
+    }
+    glWidget->setReceiverSites(sites);
+}
+
 // Target control slots (from TargetControlsWidget)
 void RadarSim::onTargetPositionChanged(float x, float y, float z) {
     if (auto* controller = radarSceneView_->getWireframeController()) {
@@ -292,6 +431,13 @@ void RadarSim::onTargetScaleChanged(float scale) {
     }
 }
 
+void RadarSim::onTargetFormationChanged(int count, float spacing) {
+    if (auto* controller = radarSceneView_->getWireframeController()) {
+        controller->setFormation(count, spacing);
+        radarSceneView_->updateScene();
+    }
+}
+
 // Configuration window slot implementations
 void RadarSim::onShowConfigurationWindow() {
     if (configWindow_) {
@@ -333,6 +479,171 @@ void RadarSim::onHeatMapChanged(bool visible) {
     }
 }
 
+void RadarSim::onProfilerOverlayToggled(bool visible) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setProfilerOverlayVisible(visible);
+    }
+}
+
+void RadarSim::onProfilerLogToggled(bool enabled) {
+    auto* glWidget = radarSceneView_->getGLWidget();
+    if (!glWidget) {
+        return;
+    }
+
+    if (!enabled) {
+        glWidget->stopProfilerLog();
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, "Profiler Log", "radarsim_profile.csv",
+                                                "CSV (*.csv);;JSON Lines (*.jsonl)");
+    if (path.isEmpty() || !glWidget->startProfilerLog(path)) {
+        if (!path.isEmpty()) {
+            QMessageBox::warning(this, "Profiler Log", "Could not open " + path + " for writing.");
+        }
+        QSignalBlocker blocker(profilerLogAction_);
+        profilerLogAction_->setChecked(false);
+    }
+}
+
+void RadarSim::onLoadModel() {
+    ModelManager* models = radarSceneView_->getModelManager();
+    if (!models || models->isLoading()) {
+        return;
+    }
+
+    QString path = QFileDialog::getOpenFileName(this, "Load Model", QString(),
+                                                "Models (*.stl *.obj *.gltf *.glb)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    // Import runs on a worker; the model appears once modelAdded arrives
+    models->clearAllModels();
+    auto* controller = radarSceneView_->getWireframeController();
+    QVector3D position = controller ? controller->getPosition() : QVector3D();
+    if (!models->loadModel(path.toStdString(), position)) {
+        QMessageBox::warning(this, "Load Model", "Could not load " + path + ".");
+        return;
+    }
+    loadModelAction_->setEnabled(false);
+}
+
+void RadarSim::onDatasetViewToggled(bool enabled) {
+    auto* glWidget = radarSceneView_->getGLWidget();
+    if (!glWidget) {
+        return;
+    }
+
+    if (!enabled) {
+        if (datasetViewer_) {
+            datasetViewer_->close();
+        }
+        glWidget->setDatasetView(false);
+        return;
+    }
+
+    // Only one of the viewer and the player drives the plot
+    if (trajectoryAction_->isChecked()) {
+        trajectoryAction_->setChecked(false);
+    }
+
+    if (!datasetViewer_) {
+        datasetViewer_ = new RCS::RCSDatasetViewer(this);
+        connect(glWidget, &RadarGLWidget::anglesChanged, datasetViewer_, &RCS::RCSDatasetViewer::showLook);
+        connect(datasetViewer_, &RCS::RCSDatasetViewer::cutReady, this,
+                [this, glWidget](const std::vector<RCSDataPoint>& cut, float, float elevation) {
+                    glWidget->showDatasetCut(cut, elevation, datasetViewer_->minDbsm(), datasetViewer_->maxDbsm());
+                });
+    }
+
+    QString path = QFileDialog::getOpenFileName(this, "Sweep Dataset", QString(), "RCS sweeps (*.rcsc)");
+    if (path.isEmpty() || !datasetViewer_->open(path)) {
+        if (!path.isEmpty()) {
+            QMessageBox::warning(this, "Sweep Dataset", "Could not open " + path + ":\n" + datasetViewer_->errorString());
+        }
+        QSignalBlocker blocker(datasetViewAction_);
+        datasetViewAction_->setChecked(false);
+        return;
+    }
+    glWidget->setDatasetView(true);
+    datasetViewer_->showLook(glWidget->getTheta(), glWidget->getPhi());
+}
+
+void RadarSim::onTrajectoryPlaybackToggled(bool enabled) {
+    auto* glWidget = radarSceneView_->getGLWidget();
+    auto* controller = radarSceneView_->getWireframeController();
+    if (!glWidget || !controller) {
+        return;
+    }
+
+    if (!enabled) {
+        if (trajectoryPlayer_) {
+            trajectoryPlayer_->stop();
+        }
+        glWidget->setDatasetView(false);
+        return;
+    }
+
+    if (!trajectoryPlayer_) {
+        trajectoryPlayer_ = new RCS::RCSTrajectoryPlayer(this);
+        // Poses go straight to the controller and the radar, not through the
+        // control widgets, so playback costs one scene update per frame
+        connect(trajectoryPlayer_, &RCS::RCSTrajectoryPlayer::frameReady, this,
+                [this, glWidget, controller](const RCS::TrajectoryFrame& frame) {
+                    controller->setPosition(frame.position);
+                    controller->setRotation(frame.rotation);
+                    radarSceneView_->setAngles(frame.azimuth, frame.elevation);
+                    radarSceneView_->updateScene();
+                    glWidget->showDatasetCut(frame.cut, frame.elevation,
+                                             trajectoryPlayer_->minDbsm(), trajectoryPlayer_->maxDbsm());
+                });
+        connect(trajectoryPlayer_, &RCS::RCSTrajectoryPlayer::finished, this, [this]() {
+            trajectoryAction_->setChecked(false);
+        });
+    }
+
+    auto fail = [this](const QString& message) {
+        QMessageBox::warning(this, "Play Trajectory", message);
+        QSignalBlocker blocker(trajectoryAction_);
+        trajectoryAction_->setChecked(false);
+    };
+
+    QString path = QFileDialog::getOpenFileName(this, "Play Trajectory", QString(), "Trajectories (*.csv)");
+    if (path.isEmpty()) {
+        QSignalBlocker blocker(trajectoryAction_);
+        trajectoryAction_->setChecked(false);
+        return;
+    }
+    if (!trajectoryPlayer_->loadTrajectory(path)) {
+        fail(trajectoryPlayer_->errorString());
+        return;
+    }
+
+    if (datasetViewAction_->isChecked()) {
+        datasetViewAction_->setChecked(false);
+    }
+
+    // Traced the way the live view traces, at the current radar distance
+    RCS::TraceSettings settings;
+    settings.sphereRadius = glWidget->getRadius();
+    if (auto* beam = radarSceneView_->getBeamController()) {
+        settings.beamWidthDegrees = beam->getVisualExtentDegrees();
+    }
+    settings.numRays = glWidget->getRayCount();
+    settings.sampling = glWidget->getRaySampling();
+    settings.maxBounces = glWidget->getRCSBounces();
+    settings.bounceCutoff = glWidget->getBounceCutoff();
+    settings.rouletteThreshold = glWidget->getRouletteThreshold();
+    trajectoryPlayer_->setTraceSettings(settings, glWidget->getRCSSliceThickness());
+    if (!trajectoryPlayer_->setTarget(*controller) || !trajectoryPlayer_->start()) {
+        fail(trajectoryPlayer_->errorString());
+        return;
+    }
+    glWidget->setDatasetView(true);
+}
+
 void RadarSim::onBeamVisibilityChanged(bool visible) {
     if (auto* beam = radarSceneView_->getBeamController()) {
         beam->setFootprintOnly(!visible);  // visible = full beam, !visible = footprint only
@@ -384,9 +695,64 @@ void RadarSim::onRayCountChanged(int count) {
     radarSceneView_->updateScene();
 }
 
+// RCS tracing slot implementations (from ConfigurationWindow)
+void RadarSim::onTemporalReuseChanged(bool enabled) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setTemporalReuse(enabled);
+    }
+}
+
+void RadarSim::onDecoupledShadowsChanged(bool enabled) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setDecoupledShadows(enabled);
+    }
+}
+
+void RadarSim::onResultCachingChanged(bool enabled) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setResultCaching(enabled);
+    }
+}
+
+void RadarSim::onBouncesChanged(int bounces) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setRCSBounces(bounces);
+    }
+}
+
+void RadarSim::onBounceTerminationChanged(float cutoff, float rouletteThreshold) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setBounceTermination(cutoff, rouletteThreshold);
+    }
+}
+
+void RadarSim::onFrameBudgetChanged(double milliseconds) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setRCSFrameBudget(milliseconds);
+    }
+}
+
+void RadarSim::onTargetMaterialChanged(const QString& preset) {
+    const RCS::MaterialPreset* material = RCS::findMaterialPreset(preset.toUtf8().constData());
+    if (!material) {
+        qWarning() << "RadarSim: Unknown target material" << preset;
+        return;
+    }
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setTargetMaterial(material->material);
+    }
+}
+
+void RadarSim::onGPUMemoryBudgetChanged(int megabytes) {
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setGPUMemoryBudget(megabytes);
+    }
+}
+
 // RCS plane control slot implementations (from RCSPlaneControlsWidget)
 void RadarSim::onRCSCutTypeChanged(CutType type) {
     radarSceneView_->setRCSCutType(type);
+    updateOverlayCuts();
 }
 
 void RadarSim::onRCSPlaneOffsetChanged(float degrees) {
@@ -395,12 +761,34 @@ void RadarSim::onRCSPlaneOffsetChanged(float degrees) {
 
 void RadarSim::onRCSSliceThicknessChanged(float degrees) {
     radarSceneView_->setRCSSliceThickness(degrees);
+    updateOverlayCuts();
 }
 
 void RadarSim::onRCSPlaneShowFillChanged(bool show) {
     radarSceneView_->setRCSPlaneShowFill(show);
 }
 
+void RadarSim::onRCSCoherentChanged(bool coherent) {
+    radarSceneView_->setRCSCoherent(coherent);
+}
+
+void RadarSim::onRCSOverlayCutChanged(bool) {
+    updateOverlayCuts();
+}
+
+// Overlay the other cut type through the boresight, at the primary cut's thickness
+void RadarSim::updateOverlayCuts() {
+    std::vector<CutSpec> cuts;
+    if (rcsPlaneControls_ && rcsPlaneControls_->isOverlayCutEnabled()) {
+        CutSpec cut;
+        cut.type = rcsPlaneControls_->getCutType() == CutType::Azimuth ? CutType::Elevation : CutType::Azimuth;
+        cut.offsetDegrees = 0.0f;
+        cut.thicknessDegrees = rcsPlaneControls_->getSliceThickness();
+        cuts.push_back(cut);
+    }
+    radarSceneView_->setOverlayCuts(cuts);
+}
+
 // Profile management slot implementations
 void RadarSim::onProfileSelected(int index) {
     if (index < 0 || !configWindow_) {
@@ -516,6 +904,7 @@ void RadarSim::onProfilesChanged() {
 void RadarSim::closeEvent(QCloseEvent* event) {
     readSettingsFromScene();
     appSettings_->saveLastSession();
+    appSettings_->flush();  // The session must be on disk before the process exits
 
     // Close floating windows before main window
     if (controlsWindow_) controlsWindow_->close();
@@ -682,6 +1071,11 @@ void RadarSim::readSettingsFromScene() {
     if (rcsPlaneControls_) {
         rcsPlaneControls_->readSettings(appSettings_->scene);
     }
+
+    // Read RCS tracing settings from the configuration window
+    if (configWindow_) {
+        configWindow_->readTraceSettings(appSettings_->scene);
+    }
 }
 
 void RadarSim::applySettingsToScene() {
@@ -695,6 +1089,8 @@ void RadarSim::applySettingsToScene() {
         // Also update scene directly
         radarSceneView_->setRadius(static_cast<int>(appSettings_->scene.sphereRadius));
         radarSceneView_->setAngles(appSettings_->scene.radarTheta, appSettings_->scene.radarPhi);
+        onRadarReceiverChanged(appSettings_->scene.bistaticReceiver,
+                               appSettings_->scene.receiverTheta, appSettings_->scene.receiverPhi);
     }
 
     // Apply camera settings
@@ -721,6 +1117,7 @@ void RadarSim::applySettingsToScene() {
             appSettings_->target.rotation.z()
         );
         target->setScale(appSettings_->target.scale);
+        target->setFormation(appSettings_->target.formationCount, appSettings_->target.formationSpacing);
         target->setTargetType(static_cast<WireframeType>(appSettings_->target.targetType));
     }
 
@@ -746,6 +1143,23 @@ void RadarSim::applySettingsToScene() {
     radarSceneView_->setRCSPlaneOffset(appSettings_->scene.rcsPlaneOffset);
     radarSceneView_->setRCSSliceThickness(appSettings_->scene.rcsSliceThickness);
     radarSceneView_->setRCSPlaneShowFill(appSettings_->scene.rcsPlaneShowFill);
+    radarSceneView_->setRCSCoherent(appSettings_->scene.rcsCoherent);
+    updateOverlayCuts();
+
+    // Apply RCS tracing settings to the configuration window and scene
+    if (configWindow_) {
+        configWindow_->applyTraceSettings(appSettings_->scene);
+    }
+    if (auto* glWidget = radarSceneView_->getGLWidget()) {
+        glWidget->setTemporalReuse(appSettings_->scene.rcsTemporalReuse);
+        glWidget->setDecoupledShadows(appSettings_->scene.rcsDecoupledShadows);
+        glWidget->setResultCaching(appSettings_->scene.rcsResultCaching);
+        glWidget->setRCSBounces(appSettings_->scene.rcsBounces);
+        glWidget->setBounceTermination(appSettings_->scene.rcsBounceCutoff, appSettings_->scene.rcsRouletteThreshold);
+        glWidget->setRCSFrameBudget(appSettings_->scene.rcsFrameBudgetMs);
+        glWidget->setGPUMemoryBudget(appSettings_->scene.gpuMemoryBudgetMB);
+    }
+    onTargetMaterialChanged(appSettings_->scene.rcsMaterial);
 
     // Sync ConfigurationWindow checkboxes with current scene state
     syncConfigWindowState();
@@ -32,6 +32,7 @@ class QLabel;
 class RadarSceneWidget;
 
 class PolarRCSPlot;
+namespace RCS { class RCSDatasetViewer; class RCSTrajectoryPlayer; }
 
 class RadarSim : public QMainWindow {
     Q_OBJECT
@@ -43,17 +44,21 @@ private slots:
     // Radar control slot (from widget)
     void onRadarRadiusChanged(int radius);
     void onRadarAnglesChanged(float theta, float phi);
+    void onRadarReceiverChanged(bool enabled, float theta, float phi);
 
     // Target control slots (from widget)
     void onTargetPositionChanged(float x, float y, float z);
     void onTargetRotationChanged(float pitch, float yaw, float roll);
     void onTargetScaleChanged(float scale);
+    void onTargetFormationChanged(int count, float spacing);
 
     // RCS plane control slots (from widget)
     void onRCSCutTypeChanged(CutType type);
     void onRCSPlaneOffsetChanged(float degrees);
     void onRCSSliceThicknessChanged(float degrees);
     void onRCSPlaneShowFillChanged(bool show);
+    void onRCSCoherentChanged(bool coherent);
+    void onRCSOverlayCutChanged(bool overlay);
 
     // Profile management slots
     void onProfileSelected(int index);
@@ -85,6 +90,27 @@ private slots:
     void onShowBouncesToggled(bool enabled);
     void onRayTraceModeChanged(RCS::RayTraceMode mode);
     void onRayCountChanged(int count);
+    void onTemporalReuseChanged(bool enabled);
+    void onDecoupledShadowsChanged(bool enabled);
+    void onResultCachingChanged(bool enabled);
+    void onBouncesChanged(int bounces);
+    void onBounceTerminationChanged(float cutoff, float rouletteThreshold);
+    void onTargetMaterialChanged(const QString& preset);
+    void onFrameBudgetChanged(double milliseconds);
+    void onGPUMemoryBudgetChanged(int megabytes);
+
+    // Imported STL/OBJ/glTF model (File menu)
+    void onLoadModel();
+
+    // Profiler slots (View menu)
+    void onProfilerOverlayToggled(bool visible);
+    void onProfilerLogToggled(bool enabled);
+
+    // Sweep dataset viewer (View menu)
+    void onDatasetViewToggled(bool enabled);
+
+    // Precomputed trajectory playback (View menu)
+    void onTrajectoryPlaybackToggled(bool enabled);
 
 protected:
     void closeEvent(QCloseEvent* event) override;
@@ -107,6 +133,7 @@ private:
 
     // UI helper functions
     void syncConfigWindowState();
+    void updateOverlayCuts();
 
     RadarSceneWidget* radarSceneView_;
     PolarRCSPlot* polarRCSPlot_;  // 2D polar RCS plot widget
@@ -133,9 +160,21 @@ private:
     QWidget* controlsPanel_ = nullptr;
 
     // Menu bar
+    QMenu* fileMenu_ = nullptr;
+    QAction* loadModelAction_ = nullptr;
     QMenu* viewMenu_ = nullptr;
     QAction* showConfigWindowAction_ = nullptr;
     QAction* showControlsWindowAction_ = nullptr;
+    QAction* profilerOverlayAction_ = nullptr;
+    QAction* profilerLogAction_ = nullptr;
+    QAction* datasetViewAction_ = nullptr;
+    QAction* trajectoryAction_ = nullptr;
+
+    // Stored sweep cuts shown instead of the live trace
+    RCS::RCSDatasetViewer* datasetViewer_ = nullptr;
+
+    // Target and radar poses from a timeline, RCS traced ahead of the playhead
+    RCS::RCSTrajectoryPlayer* trajectoryPlayer_ = nullptr;
 
     // Floating windows
     ConfigurationWindow* configWindow_ = nullptr;
@@ -1,7 +1,430 @@
 ﻿// ---- main.cpp ----
 
 #include <QApplication>
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
 #include "RadarSim.h"
+#include "RCSSweepRunner.h"
+#include "RCSAutomationServer.h"
+#include "RCSSweepCoordinator.h"
+#include "RCSBenchmark.h"
+#include "SphereValidation.h"
+#include "MeshImporter.h"
+
+namespace {
+
+// Parses "start:end:step" into the three floats; leaves them untouched on error
+bool parseRange(const QString& text, float& start, float& end, float& step) {
+    QStringList parts = text.split(":");
+    if (parts.size() != 3) {
+        return false;
+    }
+    bool ok[3] = {false, false, false};
+    float values[3] = {parts[0].toFloat(&ok[0]), parts[1].toFloat(&ok[1]), parts[2].toFloat(&ok[2])};
+    if (!ok[0] || !ok[1] || !ok[2] || values[2] <= 0.0f) {
+        return false;
+    }
+    start = values[0];
+    end = values[1];
+    step = values[2];
+    return true;
+}
+
+bool hasArgument(int argc, char** argv, const char* name) {
+    for (int i = 1; i < argc; ++i) {
+        if (QString::fromLocal8Bit(argv[i]).startsWith(name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Headless batch sweep: RadarSim --sweep out.csv [options]. No window is created.
+int runHeadlessSweep(QGuiApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("RadarSim headless RCS sweep");
+    parser.addHelpOption();
+    QCommandLineOption sweepOption("sweep", "Write a sweep to <file> (CSV, or binary columns for .rcsc) and exit.", "file");
+    QCommandLineOption targetOption("target", "Target: cube, cylinder, aircraft, sphere, plate, dihedral, trihedral "
+                                    "or a .stl/.obj/.gltf/.glb model file.", "type", "cube");
+    QCommandLineOption azimuthOption("azimuth", "Azimuth range in degrees.", "start:end:step", "0:360:1");
+    QCommandLineOption elevationOption("elevation", "Elevation range in degrees.", "start:end:step", "-90:90:1");
+    QCommandLineOption raysOption("rays", "Rays per radar position.", "count");
+    QCommandLineOption beamWidthOption("beam-width", "Beam width in degrees.", "degrees");
+    QCommandLineOption radiusOption("radius", "Radar sphere radius.", "radius");
+    QCommandLineOption scaleOption("scale", "Target scale.", "scale");
+    QCommandLineOption thicknessOption("slice-thickness", "Azimuth cut half-thickness in degrees.", "degrees");
+    QCommandLineOption fullCutOption("full-cut", "Append the full 360-bin azimuth cut to every row.");
+    QCommandLineOption compressOption("compress", "Compress the column chunks of a .rcsc output.");
+    QCommandLineOption formationOption("formation", "V formation of <count> targets, <spacing> apart.",
+                                       "count[:spacing]");
+    QCommandLineOption traversalOption("traversal", "BVH traversal: stack or stackless.", "mode", "stack");
+    QCommandLineOption bouncesOption("bounces", "Reflections traced per ray (GPU backend).", "count");
+    QCommandLineOption bounceCutoffOption("bounce-cutoff", "Return at which a multi-bounce path ends (GPU backend).",
+                                          "return");
+    QCommandLineOption rouletteOption("roulette", "Return under which a multi-bounce path plays Russian roulette, "
+                                      "0 = never (GPU backend).", "return");
+    QCommandLineOption samplingOption("sampling", "Ray pattern: rings, fibonacci or sobol.", "pattern", "rings");
+    QCommandLineOption bvhOption("bvh", "BVH node layout: binary or wide4.", "layout", "binary");
+    QCommandLineOption bvhBuildOption("bvh-build", "Where mesh BVHs are built: cpu (SAH) or gpu (LBVH from "
+                                      "uploaded geometry, GPU backend).", "builder", "cpu");
+    QCommandLineOption trianglesOption("triangles", "Triangle storage: full or compact (16-bit, GPU backend).",
+                                       "precision", "full");
+    QCommandLineOption reorderOption("reorder", "Sort rays by direction (and bounce rays by origin) before "
+                                     "tracing them (GPU backend).");
+    QCommandLineOption persistentOption("persistent-threads", "Launch only enough groups to fill the GPU and let "
+                                        "every lane pull rays from a shared counter (GPU backend).");
+    QCommandLineOption normalConesOption("normal-cones", "Skip BVH subtrees facing away from the ray; closed "
+                                         "targets only (GPU backend, binary BVH).");
+    QCommandLineOption temporalOption("temporal-reuse", "Start each ray from the leaf it hit in a neighbouring "
+                                      "look (GPU backend, binary BVH).");
+    QCommandLineOption materialsOption("materials", "Material table by imported material ID: comma-separated "
+                                       "pec, ram, dielectric or rough (GPU backend).", "list");
+    QCommandLineOption backendOption("backend", "Tracer: gpu (GL 4.3) or cpu.", "backend", "gpu");
+    QCommandLineOption threadsOption("threads", "CPU backend worker threads (0 = all cores).", "count");
+    QCommandLineOption noCacheOption("no-cache", "Always import model targets; do not read or write the target cache.");
+    QCommandLineOption analyticOption("analytic", "Trace sphere, cylinder, plate, dihedral and trihedral targets "
+                                      "as exact surfaces instead of triangles.");
+    QCommandLineOption workersOption("workers", "Split the sweep over <count> local --serve worker processes.", "count");
+    QCommandLineOption workerOption("worker", "Also run a worker with this command (repeatable), "
+                                    "e.g. \"ssh node2 RadarSim --serve\".", "command");
+    parser.addOptions({sweepOption, targetOption, azimuthOption, elevationOption, raysOption,
+                       beamWidthOption, radiusOption, scaleOption, thicknessOption, fullCutOption, compressOption,
+                       formationOption, traversalOption, samplingOption, bouncesOption, bounceCutoffOption,
+                       rouletteOption, bvhOption, bvhBuildOption,
+                       trianglesOption, reorderOption, persistentOption, normalConesOption, temporalOption,
+                       materialsOption, backendOption, threadsOption, noCacheOption, analyticOption, workersOption, workerOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    RCS::SweepConfig config;
+    config.outputPath = parser.value(sweepOption);
+
+    QString target = parser.value(targetOption).toLower();
+    if (MeshImporter::isSupportedFile(target)) {
+        config.meshPath = parser.value(targetOption);
+    } else if (target == "cube") {
+        config.targetType = WireframeType::Cube;
+    } else if (target == "cylinder") {
+        config.targetType = WireframeType::Cylinder;
+    } else if (target == "aircraft") {
+        config.targetType = WireframeType::Aircraft;
+    } else if (target == "sphere") {
+        config.targetType = WireframeType::Sphere;
+    } else if (target == "plate") {
+        config.targetType = WireframeType::Plate;
+    } else if (target == "dihedral") {
+        config.targetType = WireframeType::Dihedral;
+    } else if (target == "trihedral") {
+        config.targetType = WireframeType::Trihedral;
+    } else {
+        err << "Unknown target type: " << target << "\n";
+        return 1;
+    }
+
+    if (!parseRange(parser.value(azimuthOption), config.azimuthStart, config.azimuthEnd, config.azimuthStep) ||
+        !parseRange(parser.value(elevationOption), config.elevationStart, config.elevationEnd, config.elevationStep)) {
+        err << "Ranges must be start:end:step with a positive step\n";
+        return 1;
+    }
+    if (parser.isSet(raysOption)) {
+        config.numRays = parser.value(raysOption).toInt();
+    }
+    if (parser.isSet(bouncesOption)) {
+        config.maxBounces = parser.value(bouncesOption).toInt();
+    }
+    if (parser.isSet(bounceCutoffOption)) {
+        config.bounceCutoff = parser.value(bounceCutoffOption).toFloat();
+    }
+    if (parser.isSet(rouletteOption)) {
+        config.rouletteThreshold = parser.value(rouletteOption).toFloat();
+    }
+    if (parser.isSet(beamWidthOption)) {
+        config.beamWidthDegrees = parser.value(beamWidthOption).toFloat();
+    }
+    if (parser.isSet(radiusOption)) {
+        config.sphereRadius = parser.value(radiusOption).toFloat();
+    }
+    if (parser.isSet(scaleOption)) {
+        config.targetScale = parser.value(scaleOption).toFloat();
+    }
+    if (parser.isSet(thicknessOption)) {
+        config.sliceThicknessDegrees = parser.value(thicknessOption).toFloat();
+    }
+    config.writeFullCut = parser.isSet(fullCutOption);
+    config.compressOutput = parser.isSet(compressOption);
+    config.useTargetCache = !parser.isSet(noCacheOption);
+    config.analytic = parser.isSet(analyticOption);
+    config.rayReordering = parser.isSet(reorderOption);
+    config.persistentThreads = parser.isSet(persistentOption);
+    config.normalConeCulling = parser.isSet(normalConesOption);
+    config.temporalReuse = parser.isSet(temporalOption);
+    if (parser.isSet(formationOption)) {
+        QStringList parts = parser.value(formationOption).split(":");
+        bool countOk = false;
+        bool spacingOk = true;
+        config.formationCount = parts[0].toInt(&countOk);
+        if (parts.size() > 1) {
+            config.formationSpacing = parts[1].toFloat(&spacingOk);
+        }
+        if (!countOk || !spacingOk || parts.size() > 2 || config.formationCount < 1) {
+            err << "Formation must be count[:spacing] with count >= 1\n";
+            return 1;
+        }
+    }
+
+    QString traversal = parser.value(traversalOption).toLower();
+    if (traversal == "stack") {
+        config.traversal = RCS::TraversalMode::Stack;
+    } else if (traversal == "stackless") {
+        config.traversal = RCS::TraversalMode::Stackless;
+    } else {
+        err << "Unknown traversal mode: " << traversal << "\n";
+        return 1;
+    }
+    QString sampling = parser.value(samplingOption).toLower();
+    if (sampling == "rings") {
+        config.sampling = RCS::RaySampling::Rings;
+    } else if (sampling == "fibonacci") {
+        config.sampling = RCS::RaySampling::Fibonacci;
+    } else if (sampling == "sobol") {
+        config.sampling = RCS::RaySampling::Sobol;
+    } else {
+        err << "Unknown ray sampling: " << sampling << "\n";
+        return 1;
+    }
+    QString layout = parser.value(bvhOption).toLower();
+    if (layout == "binary") {
+        config.bvhLayout = RCS::BVHLayout::Binary;
+    } else if (layout == "wide4") {
+        config.bvhLayout = RCS::BVHLayout::Wide4;
+    } else {
+        err << "Unknown BVH layout: " << layout << "\n";
+        return 1;
+    }
+    QString bvhBuild = parser.value(bvhBuildOption).toLower();
+    if (bvhBuild == "cpu") {
+        config.bvhBuild = RCS::BVHBuild::CPU;
+    } else if (bvhBuild == "gpu") {
+        config.bvhBuild = RCS::BVHBuild::GPU;
+    } else {
+        err << "Unknown BVH build: " << bvhBuild << "\n";
+        return 1;
+    }
+    QString precision = parser.value(trianglesOption).toLower();
+    if (precision == "full") {
+        config.trianglePrecision = RCS::TrianglePrecision::Full;
+    } else if (precision == "compact") {
+        config.trianglePrecision = RCS::TrianglePrecision::Compact;
+    } else {
+        err << "Unknown triangle precision: " << precision << "\n";
+        return 1;
+    }
+
+    if (parser.isSet(materialsOption)) {
+        for (const QString& name : parser.value(materialsOption).toLower().split(",")) {
+            if (!RCS::findMaterialPreset(name.trimmed().toUtf8().constData())) {
+                err << "Unknown material: " << name << "\n";
+                return 1;
+            }
+            config.materials << name.trimmed();
+        }
+    }
+
+    QString backendName = parser.value(backendOption).toLower();
+    RCS::SweepBackend backend;
+    if (backendName == "gpu") {
+        backend = RCS::SweepBackend::GPU;
+    } else if (backendName == "cpu") {
+        backend = RCS::SweepBackend::CPU;
+    } else {
+        err << "Unknown backend: " << backendName << "\n";
+        return 1;
+    }
+    if (parser.isSet(threadsOption)) {
+        config.cpuThreads = parser.value(threadsOption).toInt();
+    }
+
+    // Distributed: this process only coordinates and writes the output
+    if (parser.isSet(workersOption) || parser.isSet(workerOption)) {
+        QStringList commands;
+        if (parser.isSet(workersOption)) {
+            bool ok = false;
+            int count = parser.value(workersOption).toInt(&ok);
+            if (!ok || count < 1) {
+                err << "Workers must be a positive count\n";
+                return 1;
+            }
+            commands = RCS::RCSSweepCoordinator::localWorkerCommands(count, backend);
+        }
+        commands << parser.values(workerOption);
+
+        RCS::RCSSweepCoordinator coordinator;
+        coordinator.setWorkerCommands(commands);
+        QObject::connect(&coordinator, &RCS::RCSSweepCoordinator::progress, [&err](int completed, int total) {
+            err << "\r" << completed << " / " << total << Qt::flush;
+        });
+        bool ok = coordinator.run(config);
+        err << "\n";
+        return ok ? 0 : 1;
+    }
+
+    RCS::RCSSweepRunner runner;
+    if (!runner.initialize(backend)) {
+        err << "Failed to create an OpenGL 4.3 offscreen context (try --backend cpu)\n";
+        return 1;
+    }
+
+    QObject::connect(&runner, &RCS::RCSSweepRunner::progress, [&err](int completed, int total) {
+        err << "\r" << completed << " / " << total << Qt::flush;
+    });
+    bool ok = runner.run(config);
+    err << "\n";
+    return ok ? 0 : 1;
+}
+
+// Timing suite: RadarSim --bench out.json [--compare baseline.json]. Exits 1 on a regression.
+int runBenchmark(QGuiApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("RadarSim RCS benchmarks");
+    parser.addHelpOption();
+    QCommandLineOption benchOption("bench", "Write benchmark results to <file> (JSON) and exit.", "file");
+    QCommandLineOption compareOption("compare", "Fail on cases worse than this earlier --bench output.", "file");
+    QCommandLineOption thresholdOption("threshold", "Regression threshold for --compare in percent.", "percent");
+    QCommandLineOption repeatsOption("repeats", "Timed runs per case (median is reported).", "count");
+    QCommandLineOption backendOption("backend", "gpu (GPU and CPU cases) or cpu (CPU cases only).", "backend", "gpu");
+    QCommandLineOption threadsOption("threads", "CPU tracer worker threads (0 = all cores).", "count");
+    parser.addOptions({benchOption, compareOption, thresholdOption, repeatsOption, backendOption, threadsOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    RCS::BenchmarkConfig config;
+    config.outputPath = parser.value(benchOption);
+    config.baselinePath = parser.value(compareOption);
+    if (parser.isSet(thresholdOption)) {
+        bool ok = false;
+        config.regressionPercent = parser.value(thresholdOption).toFloat(&ok);
+        if (!ok || config.regressionPercent < 0.0f) {
+            err << "Threshold must be a non-negative percentage\n";
+            return 1;
+        }
+    }
+    if (parser.isSet(repeatsOption)) {
+        config.repeats = parser.value(repeatsOption).toInt();
+    }
+    if (parser.isSet(threadsOption)) {
+        config.cpuThreads = parser.value(threadsOption).toInt();
+    }
+    QString backendName = parser.value(backendOption).toLower();
+    if (backendName == "cpu") {
+        config.gpu = false;
+    } else if (backendName != "gpu") {
+        err << "Unknown backend: " << backendName << "\n";
+        return 1;
+    }
+
+    RCS::RCSBenchmark benchmark;
+    return benchmark.run(config) ? 0 : 1;
+}
+
+// Comma-separated integers; false on an empty or malformed entry
+bool parseIntList(const QString& text, std::vector<int>& values) {
+    values.clear();
+    for (const QString& part : text.split(",")) {
+        bool ok = false;
+        values.push_back(part.trimmed().toInt(&ok));
+        if (!ok) {
+            return false;
+        }
+    }
+    return !values.empty();
+}
+
+// Accuracy vs. cost against pi r^2: RadarSim --validate-sphere out.csv [options]
+int runSphereValidation(QGuiApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("RadarSim sphere RCS validation");
+    parser.addHelpOption();
+    QCommandLineOption validateOption("validate-sphere", "Write the validation table to <file> (CSV) and exit.", "file");
+    QCommandLineOption raysOption("rays", "Ray counts to trace.", "n,n,...", "1000,10000,100000,1000000");
+    QCommandLineOption subdivisionsOption("subdivisions", "Sphere subdivision levels.", "n,n,...", "1,2,3,4");
+    QCommandLineOption samplingOption("sampling", "Ray patterns: rings, fibonacci, sobol.", "pattern,...",
+                                      "rings,fibonacci,sobol");
+    QCommandLineOption backendOption("backend", "Tracers: gpu, cpu or both.", "backend", "both");
+    QCommandLineOption threadsOption("threads", "CPU tracer worker threads (0 = all cores).", "count");
+    parser.addOptions({validateOption, raysOption, subdivisionsOption, samplingOption, backendOption, threadsOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    RCS::SphereValidationConfig config;
+    config.outputPath = parser.value(validateOption);
+    if (!parseIntList(parser.value(raysOption), config.rayCounts) ||
+        !parseIntList(parser.value(subdivisionsOption), config.subdivisions)) {
+        err << "Ray counts and subdivision levels must be comma-separated integers\n";
+        return 1;
+    }
+    config.samplings.clear();
+    for (const QString& name : parser.value(samplingOption).toLower().split(",")) {
+        if (name == "rings") {
+            config.samplings.push_back(RCS::RaySampling::Rings);
+        } else if (name == "fibonacci") {
+            config.samplings.push_back(RCS::RaySampling::Fibonacci);
+        } else if (name == "sobol") {
+            config.samplings.push_back(RCS::RaySampling::Sobol);
+        } else {
+            err << "Unknown ray sampling: " << name << "\n";
+            return 1;
+        }
+    }
+    QString backendName = parser.value(backendOption).toLower();
+    if (backendName == "gpu" || backendName == "cpu" || backendName == "both") {
+        config.gpu = backendName != "cpu";
+        config.cpu = backendName != "gpu";
+    } else {
+        err << "Unknown backend: " << backendName << "\n";
+        return 1;
+    }
+    if (parser.isSet(threadsOption)) {
+        config.cpuThreads = parser.value(threadsOption).toInt();
+    }
+
+    RCS::SphereValidation validation;
+    return validation.run(config) ? 0 : 1;
+}
+
+// Automation: RadarSim --serve reads JSON requests on stdin and answers on stdout
+int runAutomationServer(QGuiApplication& app) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("RadarSim RCS automation server (line-delimited JSON on stdin/stdout)");
+    parser.addHelpOption();
+    QCommandLineOption serveOption("serve", "Serve RCS requests on stdin until shutdown or end of input.");
+    QCommandLineOption backendOption("backend", "Tracer: gpu (GL 4.3) or cpu.", "backend", "gpu");
+    parser.addOptions({serveOption, backendOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    QString backendName = parser.value(backendOption).toLower();
+    RCS::SweepBackend backend;
+    if (backendName == "gpu") {
+        backend = RCS::SweepBackend::GPU;
+    } else if (backendName == "cpu") {
+        backend = RCS::SweepBackend::CPU;
+    } else {
+        err << "Unknown backend: " << backendName << "\n";
+        return 1;
+    }
+
+    RCS::RCSAutomationServer server;
+    if (!server.initialize(backend)) {
+        err << "Failed to create an OpenGL 4.3 offscreen context (try --backend cpu)\n";
+        return 1;
+    }
+    server.start();
+    return app.exec();
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
     // MUST be set before QApplication is created - enables texture sharing between contexts
@@ -11,13 +434,32 @@ int main(int argc, char** argv) {
     QSurfaceFormat format;
     format.setDepthBufferSize(24);
     format.setStencilBufferSize(8);
-    format.setSamples(4);  // Enable 4x MSAA for anti-aliased edges
+    format.setSamples(4);  // 4x MSAA for the polar plot; the 3D scene multisamples in SceneTarget
     format.setVersion(4, 6);  // OpenGL 4.6 - latest version, full feature set
     format.setProfile(QSurfaceFormat::CoreProfile);
     format.setOption(QSurfaceFormat::DebugContext);
     QSurfaceFormat::setDefaultFormat(format);
 
     qSetMessagePattern("[%{time}] %{type} %{function}: %{message}");
+
+    // Batch sweeps, benchmarks, validation and the automation server need a GUI application for the offscreen context but no widgets
+    if (hasArgument(argc, argv, "--sweep")) {
+        QGuiApplication app(argc, argv);
+        return runHeadlessSweep(app);
+    }
+    if (hasArgument(argc, argv, "--bench")) {
+        QGuiApplication app(argc, argv);
+        return runBenchmark(app);
+    }
+    if (hasArgument(argc, argv, "--validate-sphere")) {
+        QGuiApplication app(argc, argv);
+        return runSphereValidation(app);
+    }
+    if (hasArgument(argc, argv, "--serve")) {
+        QGuiApplication app(argc, argv);
+        return runAutomationServer(app);
+    }
+
     QApplication a(argc, argv);
 
     RadarSim w;